@@ -40,13 +40,13 @@
 
 A3_INLINE a3ret a3vertexAttribGetElementsPerAttrib(const a3_VertexAttributeType attribType)
 {
-	static const a3byte elementsPerAttrib[] = { 0, 1, 2, 3, 4, 1, 2, 3, 4, 1, 2, 3, 4 };
+	static const a3byte elementsPerAttrib[] = { 0, 1, 2, 3, 4, 1, 2, 3, 4, 1, 2, 3, 4, 2, 4, 2, 4, 4, 4 };
 	return elementsPerAttrib[attribType];
 }
 
 A3_INLINE a3ret a3vertexAttribGetBytesPerElement(const a3_VertexAttributeType attribType)
 {
-	static const a3byte bytesPerElement[] = { 0, 4, 4, 4, 4, 4, 4, 4, 4, 8, 8, 8, 8 };
+	static const a3byte bytesPerElement[] = { 0, 4, 4, 4, 4, 4, 4, 4, 4, 8, 8, 8, 8, 2, 2, 2, 2, 1, 1 };
 	return bytesPerElement[attribType];
 }
 
@@ -48,6 +48,8 @@ extern "C"
 	//	a3buffer_index: store index data in an "index buffer object" (IBO), 
 	//		a.k.a. "element buffer object" (EBO)
 	//	a3buffer_uniform: store uniform data in a "uniform buffer object" (UBO)
+	//	a3buffer_storage: store large or per-instance data for shader access 
+	//		in a "shader storage buffer object" (SSBO)
 	//	NOTE: It is also possible for vertex and index data to coexist in the 
 	//		same buffer; use either a3buffer_vertex or a3buffer_index mode to 
 	//		achieve this; avoid using 'deactivate' function for shared buffer.
@@ -56,6 +58,7 @@ extern "C"
 		a3buffer_vertex,
 		a3buffer_index,
 		a3buffer_uniform,
+		a3buffer_storage,
 	};
 
 
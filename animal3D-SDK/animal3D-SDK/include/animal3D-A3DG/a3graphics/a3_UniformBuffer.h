@@ -44,6 +44,10 @@ extern "C"
 	// A3: Uniform buffer object (UBO) is an alias for generic buffer object.
 	typedef a3_BufferObject					a3_UniformBuffer;
 
+	// A3: Shader storage buffer object (SSBO) is also an alias for generic 
+	//		buffer object; create with type a3buffer_storage.
+	typedef a3_BufferObject					a3_StorageBuffer;
+
 
 //-----------------------------------------------------------------------------
 
@@ -54,6 +58,13 @@ extern "C"
 	//	return: -1 if invalid params or buffer not initialized
 	a3ret a3shaderUniformBufferActivate(const a3_UniformBuffer *buffer, const a3ui32 unifBlockBinding);
 
+	// A3: Bind storage buffer to specified binding slot (programs share this).
+	//	param buffer: non-null pointer to initialized buffer
+	//	param storageBlockBinding: program block binding index for this buffer
+	//	return: 1 if success
+	//	return: -1 if invalid params or buffer not initialized
+	a3ret a3shaderStorageBufferActivate(const a3_StorageBuffer *buffer, const a3ui32 storageBlockBinding);
+
 	// A3: Bind uniform block to specified binding slot in a program.
 	//	param program: non-null pointer to initialized program
 	//	param unifBlockLocation: non-negative location of uniform block in 
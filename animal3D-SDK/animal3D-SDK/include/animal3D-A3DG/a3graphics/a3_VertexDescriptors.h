@@ -123,6 +123,14 @@ extern "C"
 		a3attrib_dvec2,		// 2D double vector
 		a3attrib_dvec3,		// 3D double vector
 		a3attrib_dvec4,		// 4D double vector
+
+		// packed types, converted to float when fetched by shaders
+		a3attrib_half2,		// 2D half-float vector
+		a3attrib_half4,		// 4D half-float vector
+		a3attrib_snorm16x2,	// 2D signed normalized 16-bit vector (e.g. octahedral direction)
+		a3attrib_snorm16x4,	// 4D signed normalized 16-bit vector
+		a3attrib_snorm10x3,	// 3D signed normalized 10-bit vector and 2-bit w, one 32-bit word
+		a3attrib_unorm8x4,	// 4D unsigned normalized 8-bit vector (e.g. color, blend weights)
 	};
 
 
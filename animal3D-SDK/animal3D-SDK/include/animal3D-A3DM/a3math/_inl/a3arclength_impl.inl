@@ -0,0 +1,228 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	animal3D Math (A3DM) SDK
+	By Daniel S. Buckstein
+
+	a3arclength_impl.inl
+	Implementations of arc-length quadrature and uniform tables.
+*/
+
+#ifdef __ANIMAL3D_A3DM_ARCLENGTH_H
+#ifndef __ANIMAL3D_A3DM_ARCLENGTH_IMPL_INL
+#define __ANIMAL3D_A3DM_ARCLENGTH_IMPL_INL
+
+
+A3_BEGIN_IMPL
+
+
+//-----------------------------------------------------------------------------
+// internal helpers
+
+// Gauss-Legendre 5-point nodes and weights on [-1, +1]
+#define a3arclengthInternal_x1		0.538469310105683091f
+#define a3arclengthInternal_x2		0.906179845938663993f
+#define a3arclengthInternal_w0		0.568888888888888889f
+#define a3arclengthInternal_w1		0.478628670099366246f
+#define a3arclengthInternal_w2		0.236926885056189088f
+
+// deepest interval halving and Newton steps per inverted sample
+#define a3arclengthInternal_maxDepth	20
+#define a3arclengthInternal_maxNewton	8
+
+typedef struct a3arclengthInternalInterval
+{
+	a3real a, b, whole, tolerance;
+	a3ui32 depth;
+} a3arclengthInternalInterval;
+
+A3_INLINE a3real a3arclengthInternalGL5(const a3realspeedfunc speedFunc, const void* data, const a3real a, const a3real b)
+{
+	const a3real h = (b - a) * a3real_half, m = (a + b) * a3real_half;
+	const a3real d1 = h * (a3real)a3arclengthInternal_x1, d2 = h * (a3real)a3arclengthInternal_x2;
+	return h * ((a3real)a3arclengthInternal_w0 * speedFunc(data, m)
+		+ (a3real)a3arclengthInternal_w1 * (speedFunc(data, m - d1) + speedFunc(data, m + d1))
+		+ (a3real)a3arclengthInternal_w2 * (speedFunc(data, m - d2) + speedFunc(data, m + d2)));
+}
+
+// solve s0 + integral(a, t) = target for t in [a, b] by safeguarded Newton
+A3_INLINE a3real a3arclengthInternalInvert(const a3realspeedfunc speedFunc, const void* data, const a3real a, const a3real b, const a3real s0, const a3real s1, const a3real target, const a3real tolerance)
+{
+	a3real lo = a, hi = b, t, f, v, tn;
+	a3index k;
+	if (s1 <= s0)
+		return a;
+	t = a + (b - a) * (target - s0) / (s1 - s0);
+	for (k = 0; k < a3arclengthInternal_maxNewton; ++k)
+	{
+		f = s0 + a3arclengthInternalGL5(speedFunc, data, a, t) - target;
+		if (f <= tolerance && f >= -tolerance)
+			break;
+		if (f > a3real_zero)
+			hi = t;
+		else
+			lo = t;
+
+		// bisect where the step leaves the bracket or speed vanishes
+		v = speedFunc(data, t);
+		tn = v > a3real_zero ? t - f / v : lo;
+		t = (tn > lo && tn < hi) ? tn : (lo + hi) * a3real_half;
+	}
+	return t;
+}
+
+// visit accepted intervals left to right, accumulating length; if a table
+//	is given, invert each uniform distance that falls in the current interval
+A3_INLINE a3real a3arclengthInternalWalk(a3real paramTable_out[], const a3count numSamples, const a3real length, const a3realspeedfunc speedFunc, const void* data, const a3count numDivisions, const a3real paramMin, const a3real paramMax, const a3real tolerance)
+{
+	a3arclengthInternalInterval stack[a3arclengthInternal_maxDepth + 2], iv;
+	const a3real step = (paramMax - paramMin) / (a3real)numDivisions;
+	const a3real tolDivision = tolerance / (a3real)numDivisions;
+	const a3real spacing = paramTable_out ? length / (a3real)(numSamples - 1) : a3real_zero;
+	a3f64 s = 0.0;
+	a3real l, r, m, s0, s1, target;
+	a3index d, n, j = 1;
+
+	for (d = 0; d < numDivisions; ++d)
+	{
+		iv.a = paramMin + step * (a3real)d;
+		iv.b = d + 1 < numDivisions ? paramMin + step * (a3real)(d + 1) : paramMax;
+		iv.whole = a3arclengthInternalGL5(speedFunc, data, iv.a, iv.b);
+		iv.tolerance = tolDivision;
+		iv.depth = 0;
+		stack[0] = iv;
+		n = 1;
+		while (n)
+		{
+			iv = stack[--n];
+			m = (iv.a + iv.b) * a3real_half;
+			l = a3arclengthInternalGL5(speedFunc, data, iv.a, m);
+			r = a3arclengthInternalGL5(speedFunc, data, m, iv.b);
+			if (iv.depth < a3arclengthInternal_maxDepth && (l + r - iv.whole > iv.tolerance || iv.whole - l - r > iv.tolerance))
+			{
+				// push right then left so left is accepted first
+				stack[n].a = m;
+				stack[n].b = iv.b;
+				stack[n].whole = r;
+				stack[n].tolerance = iv.tolerance * a3real_half;
+				stack[n].depth = iv.depth + 1;
+				++n;
+				stack[n].a = iv.a;
+				stack[n].b = m;
+				stack[n].whole = l;
+				stack[n].tolerance = iv.tolerance * a3real_half;
+				stack[n].depth = iv.depth + 1;
+				++n;
+				continue;
+			}
+
+			s0 = (a3real)s;
+			s += (a3f64)(l + r);
+			if (paramTable_out)
+			{
+				s1 = (a3real)s;
+				for (target = spacing * (a3real)j; j < numSamples - 1 && target <= s1; target = spacing * (a3real)(++j))
+					paramTable_out[j] = a3arclengthInternalInvert(speedFunc, data, iv.a, iv.b, s0, s1, target, iv.tolerance);
+			}
+		}
+	}
+
+	// entries lost to rounding at the far end
+	if (paramTable_out)
+		for (; j < numSamples - 1; ++j)
+			paramTable_out[j] = paramMax;
+	return (a3real)s;
+}
+
+
+//-----------------------------------------------------------------------------
+
+A3_INLINE a3real a3arclengthIntegrate(const a3realspeedfunc speedFunc, const void* data, const a3count numDivisions, const a3real paramMin, const a3real paramMax, const a3real tolerance)
+{
+	if (speedFunc && numDivisions > 0)
+		return a3arclengthInternalWalk(0, 0, a3real_zero, speedFunc, data, numDivisions, paramMin, paramMax, tolerance);
+	return a3real_zero;
+}
+
+A3_INLINE a3index a3sampleTableGenerateArcLengthUniform(a3real paramTable_out[], a3real* length_out, const a3count numSamples, const a3realspeedfunc speedFunc, const void* data, const a3count numDivisions, const a3real paramMin, const a3real paramMax, const a3real tolerance)
+{
+	a3real length;
+	a3index i;
+	if (paramTable_out && numSamples >= 2 && speedFunc && numDivisions > 0)
+	{
+		// first pass measures, second pass inverts along the same intervals
+		length = a3arclengthInternalWalk(0, 0, a3real_zero, speedFunc, data, numDivisions, paramMin, paramMax, tolerance);
+		if (length > a3real_zero)
+			a3arclengthInternalWalk(paramTable_out, numSamples, length, speedFunc, data, numDivisions, paramMin, paramMax, tolerance);
+		else
+			for (i = 1; i < numSamples - 1; ++i)
+				paramTable_out[i] = paramMin + (paramMax - paramMin) * (a3real)i / (a3real)(numSamples - 1);
+		paramTable_out[0] = paramMin;
+		paramTable_out[numSamples - 1] = paramMax;
+		if (length_out)
+			*length_out = length;
+		return numSamples;
+	}
+	return 0;
+}
+
+A3_INLINE a3real a3sampleTableUniformScale(const a3count numSamples, const a3real length)
+{
+	return (length > a3real_zero ? (a3real)(numSamples - 1) / length : a3real_zero);
+}
+
+A3_INLINE a3index a3sampleTableLerpUniformIndex(const a3count numSamples, const a3real scale, const a3real param, a3real* param_out)
+{
+	const a3real x = param * scale;
+	a3real u = a3real_zero;
+	a3index i = 1;
+	if (x > a3real_zero)
+	{
+		i = (a3index)x;
+		if (i < numSamples - 1)
+		{
+			u = x - (a3real)i;
+			++i;
+		}
+		else
+		{
+			u = a3real_one;
+			i = numSamples - 1;
+		}
+	}
+	if (param_out)
+		*param_out = u;
+	return i;
+}
+
+A3_INLINE a3real a3sampleTableLerpUniform(const a3real valueTable[], const a3count numSamples, const a3real scale, const a3real param)
+{
+	a3real u;
+	const a3index i = a3sampleTableLerpUniformIndex(numSamples, scale, param, &u);
+	return (valueTable[i - 1] + (valueTable[i] - valueTable[i - 1]) * u);
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+A3_END_IMPL
+
+
+#endif	// !__ANIMAL3D_A3DM_ARCLENGTH_IMPL_INL
+#endif	// __ANIMAL3D_A3DM_ARCLENGTH_H
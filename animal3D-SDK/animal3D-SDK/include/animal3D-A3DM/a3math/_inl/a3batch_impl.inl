@@ -0,0 +1,458 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	animal3D Math (A3DM) SDK
+	By Daniel S. Buckstein
+
+	a3batch_impl.inl
+	Implementations of array-batched transform functions.
+*/
+
+#ifdef __ANIMAL3D_A3DM_BATCH_H
+#ifndef __ANIMAL3D_A3DM_BATCH_IMPL_INL
+#define __ANIMAL3D_A3DM_BATCH_IMPL_INL
+
+
+A3_BEGIN_IMPL
+
+
+//-----------------------------------------------------------------------------
+// internal helpers
+
+// address of element i given first element and stride in bytes
+#define a3batchInternalAt(type, base, stride, i)	((type)((a3byte *)(base) + (stride) * (a3size)(i)))
+
+// rotate one vector by quaternion, correct scale:
+//	v' = (v (w^2 - u.u) + 2 u (u.v) + 2 w (u x v)) / |q|^2
+A3_INLINE void a3batchInternalQuatRotate(a3real *v_out, const a3real *q, const a3real *v)
+{
+	const a3real x = v[0], y = v[1], z = v[2];
+	const a3real uu = q[0] * q[0] + q[1] * q[1] + q[2] * q[2], ww = q[3] * q[3];
+	const a3real uv2 = a3real_two * (q[0] * x + q[1] * y + q[2] * z), w2 = a3real_two * q[3];
+	const a3real d = ww - uu, n = ww + uu, nInv = n != a3real_zero ? a3real_one / n : a3real_zero;
+	v_out[0] = (x * d + q[0] * uv2 + w2 * (q[1] * z - q[2] * y)) * nInv;
+	v_out[1] = (y * d + q[1] * uv2 + w2 * (q[2] * x - q[0] * z)) * nInv;
+	v_out[2] = (z * d + q[2] * uv2 + w2 * (q[0] * y - q[1] * x)) * nInv;
+}
+
+
+//-----------------------------------------------------------------------------
+
+A3_INLINE a3real4x4r a3real4x4ProductArray(a3real4x4p m_out, const a3size outStride, const a3real4x4p mL, const a3size lStride, const a3real4x4p mR, const a3size rStride, const a3count count)
+{
+	a3index i;
+#if (A3_SIMD >= A3_SIMD_SSE2)
+	if (lStride == 0)
+	{
+		// shared left matrix (e.g. parent): keep its columns in registers
+		const __m128 l0 = _mm_loadu_ps(mL[0]), l1 = _mm_loadu_ps(mL[1]), l2 = _mm_loadu_ps(mL[2]), l3 = _mm_loadu_ps(mL[3]);
+		a3real4 *o;
+		const a3real4 *r;
+		__m128 r0, r1, r2, r3;
+		for (i = 0; i < count; ++i)
+		{
+			r = a3batchInternalAt(const a3real4 *, mR, rStride, i);
+			o = a3batchInternalAt(a3real4 *, m_out, outStride, i);
+			r0 = _mm_loadu_ps(r[0]);
+			r1 = _mm_loadu_ps(r[1]);
+			r2 = _mm_loadu_ps(r[2]);
+			r3 = _mm_loadu_ps(r[3]);
+			_mm_storeu_ps(o[0], a3simdInternalCombine(l0, l1, l2, l3, r0));
+			_mm_storeu_ps(o[1], a3simdInternalCombine(l0, l1, l2, l3, r1));
+			_mm_storeu_ps(o[2], a3simdInternalCombine(l0, l1, l2, l3, r2));
+			_mm_storeu_ps(o[3], a3simdInternalCombine(l0, l1, l2, l3, r3));
+		}
+		return m_out;
+	}
+#endif	// A3_SIMD
+	for (i = 0; i < count; ++i)
+		a3real4x4ProductSIMD(a3batchInternalAt(a3real4 *, m_out, outStride, i),
+			a3batchInternalAt(a3real4 *, mL, lStride, i), a3batchInternalAt(a3real4 *, mR, rStride, i));
+	return m_out;
+}
+
+A3_INLINE a3real4r a3real4Real4x4ProductArray(a3real4p v_out, const a3size outStride, const a3real4x4p m, const a3real4p v, const a3size vStride, const a3count count)
+{
+	a3index i;
+#if (A3_SIMD >= A3_SIMD_SSE2)
+	// matrix columns stay in registers
+	const __m128 c0 = _mm_loadu_ps(m[0]), c1 = _mm_loadu_ps(m[1]), c2 = _mm_loadu_ps(m[2]), c3 = _mm_loadu_ps(m[3]);
+	for (i = 0; i < count; ++i)
+		_mm_storeu_ps(a3batchInternalAt(a3real *, v_out, outStride, i),
+			a3simdInternalCombine(c0, c1, c2, c3, _mm_loadu_ps(a3batchInternalAt(a3real *, v, vStride, i))));
+#else	// scalar
+	for (i = 0; i < count; ++i)
+		a3real4Real4x4ProductRSIMD(a3batchInternalAt(a3real *, v_out, outStride, i), m, a3batchInternalAt(a3real *, v, vStride, i));
+#endif	// A3_SIMD
+	return v_out;
+}
+
+A3_INLINE a3real3r a3real3Real4x4ProductArray(a3real3p v_out, const a3size outStride, const a3real4x4p m, const a3real3p v, const a3size vStride, const a3real w, const a3count count)
+{
+	const a3real *src;
+	a3real *dst;
+	a3index i;
+#if (A3_SIMD >= A3_SIMD_SSE2)
+	// fold implied w into translation column
+	const __m128 c0 = _mm_loadu_ps(m[0]), c1 = _mm_loadu_ps(m[1]), c2 = _mm_loadu_ps(m[2]);
+	const __m128 c3 = _mm_mul_ps(_mm_loadu_ps(m[3]), _mm_set1_ps(w));
+	__m128 r;
+	for (i = 0; i < count; ++i)
+	{
+		src = a3batchInternalAt(const a3real *, v, vStride, i);
+		dst = a3batchInternalAt(a3real *, v_out, outStride, i);
+		r = a3simdInternalMAdd(c2, _mm_set1_ps(src[2]), a3simdInternalMAdd(c1, _mm_set1_ps(src[1]), a3simdInternalMAdd(c0, _mm_set1_ps(src[0]), c3)));
+		_mm_store_ss(dst + 0, r);
+		_mm_store_ss(dst + 1, a3simdInternalSplat(r, 1));
+		_mm_store_ss(dst + 2, a3simdInternalSplat(r, 2));
+	}
+#else	// scalar
+	a3real x, y, z;
+	for (i = 0; i < count; ++i)
+	{
+		src = a3batchInternalAt(const a3real *, v, vStride, i);
+		dst = a3batchInternalAt(a3real *, v_out, outStride, i);
+		x = src[0];
+		y = src[1];
+		z = src[2];
+		dst[0] = m[0][0] * x + m[1][0] * y + m[2][0] * z + m[3][0] * w;
+		dst[1] = m[0][1] * x + m[1][1] * y + m[2][1] * z + m[3][1] * w;
+		dst[2] = m[0][2] * x + m[1][2] * y + m[2][2] * z + m[3][2] * w;
+	}
+#endif	// A3_SIMD
+	return v_out;
+}
+
+A3_INLINE a3real4x4r a3real4x4TransformInverseIgnoreScaleArray(a3real4x4p m_out, const a3size outStride, const a3real4x4p m, const a3size inStride, const a3count count)
+{
+	a3index i;
+	for (i = 0; i < count; ++i)
+		a3real4x4TransformInverseIgnoreScaleSIMD(a3batchInternalAt(a3real4 *, m_out, outStride, i), a3batchInternalAt(a3real4 *, m, inStride, i));
+	return m_out;
+}
+
+A3_INLINE a3real3r a3quatVec3RotateArray(a3real3p v_out, const a3size outStride, const a3real4p q, const a3size qStride, const a3real3p v, const a3size vStride, const a3count count)
+{
+	a3index i = 0;
+#if (A3_SIMD >= A3_SIMD_SSE2)
+	// four at a time in structure-of-arrays form
+	const __m128 two = _mm_set1_ps(2.0f), zero = _mm_setzero_ps();
+	const a3real *v0, *v1, *v2, *v3;
+	a3real *o;
+	__m128 qx, qy, qz, qw, x, y, z, uu, ww, uv2, w2, d, n, nInv, rx, ry, rz;
+	a3real out[3][4];
+	a3index j;
+	for (; i + 4 <= count; i += 4)
+	{
+		qx = _mm_loadu_ps(a3batchInternalAt(const a3real *, q, qStride, i + 0));
+		qy = _mm_loadu_ps(a3batchInternalAt(const a3real *, q, qStride, i + 1));
+		qz = _mm_loadu_ps(a3batchInternalAt(const a3real *, q, qStride, i + 2));
+		qw = _mm_loadu_ps(a3batchInternalAt(const a3real *, q, qStride, i + 3));
+		_MM_TRANSPOSE4_PS(qx, qy, qz, qw);
+		v0 = a3batchInternalAt(const a3real *, v, vStride, i + 0);
+		v1 = a3batchInternalAt(const a3real *, v, vStride, i + 1);
+		v2 = a3batchInternalAt(const a3real *, v, vStride, i + 2);
+		v3 = a3batchInternalAt(const a3real *, v, vStride, i + 3);
+		x = _mm_set_ps(v3[0], v2[0], v1[0], v0[0]);
+		y = _mm_set_ps(v3[1], v2[1], v1[1], v0[1]);
+		z = _mm_set_ps(v3[2], v2[2], v1[2], v0[2]);
+
+		uu = a3simdInternalMAdd(qz, qz, a3simdInternalMAdd(qy, qy, _mm_mul_ps(qx, qx)));
+		ww = _mm_mul_ps(qw, qw);
+		uv2 = _mm_mul_ps(two, a3simdInternalMAdd(qz, z, a3simdInternalMAdd(qy, y, _mm_mul_ps(qx, x))));
+		w2 = _mm_mul_ps(two, qw);
+		d = _mm_sub_ps(ww, uu);
+		n = _mm_add_ps(ww, uu);
+		nInv = _mm_and_ps(_mm_div_ps(_mm_set1_ps(1.0f), n), _mm_cmpneq_ps(n, zero));
+
+		rx = a3simdInternalMAdd(w2, _mm_sub_ps(_mm_mul_ps(qy, z), _mm_mul_ps(qz, y)), a3simdInternalMAdd(qx, uv2, _mm_mul_ps(x, d)));
+		ry = a3simdInternalMAdd(w2, _mm_sub_ps(_mm_mul_ps(qz, x), _mm_mul_ps(qx, z)), a3simdInternalMAdd(qy, uv2, _mm_mul_ps(y, d)));
+		rz = a3simdInternalMAdd(w2, _mm_sub_ps(_mm_mul_ps(qx, y), _mm_mul_ps(qy, x)), a3simdInternalMAdd(qz, uv2, _mm_mul_ps(z, d)));
+		_mm_storeu_ps(out[0], _mm_mul_ps(rx, nInv));
+		_mm_storeu_ps(out[1], _mm_mul_ps(ry, nInv));
+		_mm_storeu_ps(out[2], _mm_mul_ps(rz, nInv));
+		for (j = 0; j < 4; ++j)
+		{
+			o = a3batchInternalAt(a3real *, v_out, outStride, i + j);
+			o[0] = out[0][j];
+			o[1] = out[1][j];
+			o[2] = out[2][j];
+		}
+	}
+#endif	// A3_SIMD
+	for (; i < count; ++i)
+		a3batchInternalQuatRotate(a3batchInternalAt(a3real *, v_out, outStride, i),
+			a3batchInternalAt(const a3real *, q, qStride, i), a3batchInternalAt(const a3real *, v, vStride, i));
+	return v_out;
+}
+
+
+//-----------------------------------------------------------------------------
+// internal quaternion interpolation
+
+enum a3_BatchInternalQuatInterp
+{
+	a3batchInternalQuat_slerp,
+	a3batchInternalQuat_nlerp,
+	a3batchInternalQuat_slerpFast,
+};
+
+// below this sine of the angle between inputs, slerp weights become lerp
+#define a3batchInternalSlerpEpsilon		((a3real)1.0e-6)
+
+// acos on [0, 1]: Abramowitz & Stegun 4.4.46, |error| <= 2e-8
+A3_INLINE a3real a3batchInternalAcos(const a3real x)
+{
+	return a3sqrt(a3real_one - x) * (((((((
+		(a3real)-0.0012624911 * x + (a3real)0.0066700901) * x - (a3real)0.0170881256) * x + (a3real)0.0308918810) * x
+		- (a3real)0.0501743046) * x + (a3real)0.0889789874) * x - (a3real)0.2145988016) * x + (a3real)1.5707963050);
+}
+
+// sin on [0, pi/2]: Taylor series through x^11, |error| < 6e-8
+A3_INLINE a3real a3batchInternalSin(const a3real x)
+{
+	const a3real x2 = x * x;
+	return x * (((((
+		(a3real)-2.5052108e-8 * x2 + (a3real)2.7557319e-6) * x2 - (a3real)1.9841270e-4) * x2
+		+ (a3real)8.3333333e-3) * x2 - (a3real)1.6666667e-1) * x2 + a3real_one);
+}
+
+// polynomial parameter correction for fast slerp, d = |q0.q1|:
+//	t' = t + t (t - 1/2) (t - 1) (A(d) (t - 1/2)^2 + B(d))
+//	(after A. Kapoulkine, "Approximating slerp", 2015)
+A3_INLINE a3real a3batchInternalSlerpFastParam(const a3real t, const a3real d)
+{
+	const a3real a = (a3real)1.0904 + d * ((a3real)-3.2452 + d * ((a3real)3.55645 - d * (a3real)1.43519));
+	const a3real b = (a3real)0.848013 + d * ((a3real)-1.06021 + d * (a3real)0.215638);
+	const a3real th = t - a3real_half;
+	return t + t * th * (t - a3real_one) * (a * th * th + b);
+}
+
+#if (A3_SIMD >= A3_SIMD_SSE2)
+A3_INLINE __m128 a3batchInternalAcosSSE(const __m128 x)
+{
+	__m128 r = _mm_set1_ps(-0.0012624911f);
+	r = a3simdInternalMAdd(r, x, _mm_set1_ps(+0.0066700901f));
+	r = a3simdInternalMAdd(r, x, _mm_set1_ps(-0.0170881256f));
+	r = a3simdInternalMAdd(r, x, _mm_set1_ps(+0.0308918810f));
+	r = a3simdInternalMAdd(r, x, _mm_set1_ps(-0.0501743046f));
+	r = a3simdInternalMAdd(r, x, _mm_set1_ps(+0.0889789874f));
+	r = a3simdInternalMAdd(r, x, _mm_set1_ps(-0.2145988016f));
+	r = a3simdInternalMAdd(r, x, _mm_set1_ps(+1.5707963050f));
+	return _mm_mul_ps(r, _mm_sqrt_ps(_mm_sub_ps(_mm_set1_ps(1.0f), x)));
+}
+
+A3_INLINE __m128 a3batchInternalSinSSE(const __m128 x)
+{
+	const __m128 x2 = _mm_mul_ps(x, x);
+	__m128 r = _mm_set1_ps(-2.5052108e-8f);
+	r = a3simdInternalMAdd(r, x2, _mm_set1_ps(+2.7557319e-6f));
+	r = a3simdInternalMAdd(r, x2, _mm_set1_ps(-1.9841270e-4f));
+	r = a3simdInternalMAdd(r, x2, _mm_set1_ps(+8.3333333e-3f));
+	r = a3simdInternalMAdd(r, x2, _mm_set1_ps(-1.6666667e-1f));
+	r = a3simdInternalMAdd(r, x2, _mm_set1_ps(1.0f));
+	return _mm_mul_ps(r, x);
+}
+
+A3_INLINE __m128 a3batchInternalSlerpFastParamSSE(const __m128 t, const __m128 d)
+{
+	const __m128 one = _mm_set1_ps(1.0f), th = _mm_sub_ps(t, _mm_set1_ps(0.5f));
+	__m128 a = a3simdInternalMAdd(_mm_set1_ps(-1.43519f), d, _mm_set1_ps(3.55645f));
+	__m128 b = a3simdInternalMAdd(_mm_set1_ps(0.215638f), d, _mm_set1_ps(-1.06021f));
+	a = a3simdInternalMAdd(a, d, _mm_set1_ps(-3.2452f));
+	a = a3simdInternalMAdd(a, d, _mm_set1_ps(1.0904f));
+	b = a3simdInternalMAdd(b, d, _mm_set1_ps(0.848013f));
+	a = a3simdInternalMAdd(a, _mm_mul_ps(th, th), b);
+	return a3simdInternalMAdd(_mm_mul_ps(_mm_mul_ps(t, th), _mm_sub_ps(t, one)), a, t);
+}
+#endif	// A3_SIMD
+
+// interpolate one pair
+A3_INLINE void a3batchInternalQuatInterpOne(a3real* q_out, const a3real* q0, const a3real* q1, a3real t, const a3i32 mode)
+{
+	a3real d, w0, w1, theta, s, n;
+	a3index j;
+	d = q0[0] * q1[0] + q0[1] * q1[1] + q0[2] * q1[2] + q0[3] * q1[3];
+	w1 = d < a3real_zero ? -a3real_one : a3real_one;
+	d = d * w1 < a3real_one ? d * w1 : a3real_one;
+	if (mode == a3batchInternalQuat_slerp)
+	{
+		theta = a3batchInternalAcos(d);
+		s = a3batchInternalSin(theta);
+		if (s > a3batchInternalSlerpEpsilon)
+		{
+			w0 = a3batchInternalSin((a3real_one - t) * theta) / s;
+			w1 *= a3batchInternalSin(t * theta) / s;
+		}
+		else
+		{
+			w0 = a3real_one - t;
+			w1 *= t;
+		}
+		for (j = 0; j < 4; ++j)
+			q_out[j] = w0 * q0[j] + w1 * q1[j];
+	}
+	else
+	{
+		if (mode == a3batchInternalQuat_slerpFast)
+			t = a3batchInternalSlerpFastParam(t, d);
+		w0 = a3real_one - t;
+		w1 *= t;
+		for (j = 0; j < 4; ++j)
+			q_out[j] = w0 * q0[j] + w1 * q1[j];
+		n = q_out[0] * q_out[0] + q_out[1] * q_out[1] + q_out[2] * q_out[2] + q_out[3] * q_out[3];
+		n = n > a3real_zero ? a3real_one / a3sqrt(n) : a3real_zero;
+		for (j = 0; j < 4; ++j)
+			q_out[j] *= n;
+	}
+}
+
+// interpolate four pairs
+A3_INLINE void a3batchInternalQuatInterpBlock(a3real* const q_out[4], const a3real* const q0[4], const a3real* const q1[4], const a3real t[4], const a3i32 mode)
+{
+#if (A3_SIMD >= A3_SIMD_SSE2)
+	const __m128 one = _mm_set1_ps(1.0f), signMask = _mm_set1_ps(-0.0f), half = _mm_set1_ps(0.5f);
+	__m128 ax = _mm_loadu_ps(q0[0]), ay = _mm_loadu_ps(q0[1]), az = _mm_loadu_ps(q0[2]), aw = _mm_loadu_ps(q0[3]);
+	__m128 bx = _mm_loadu_ps(q1[0]), by = _mm_loadu_ps(q1[1]), bz = _mm_loadu_ps(q1[2]), bw = _mm_loadu_ps(q1[3]);
+	__m128 tt = _mm_loadu_ps(t), d, sign, w0, w1, rx, ry, rz, rw, n, r;
+	_MM_TRANSPOSE4_PS(ax, ay, az, aw);
+	_MM_TRANSPOSE4_PS(bx, by, bz, bw);
+
+	// shorter arc: take sign of dot product out, apply to second weight
+	d = a3simdInternalMAdd(aw, bw, a3simdInternalMAdd(az, bz, a3simdInternalMAdd(ay, by, _mm_mul_ps(ax, bx))));
+	sign = _mm_and_ps(d, signMask);
+	d = _mm_min_ps(_mm_xor_ps(d, sign), one);
+
+	if (mode == a3batchInternalQuat_slerp)
+	{
+		// theta = acos(d) in [0, pi/2]; weights sin((1-t)theta)/sin(theta), sin(t theta)/sin(theta)
+		const __m128 theta = a3batchInternalAcosSSE(d);
+		const __m128 s = a3batchInternalSinSSE(theta);
+		const __m128 s0 = a3batchInternalSinSSE(_mm_mul_ps(_mm_sub_ps(one, tt), theta));
+		const __m128 s1 = a3batchInternalSinSSE(_mm_mul_ps(tt, theta));
+		const __m128 valid = _mm_cmpgt_ps(s, _mm_set1_ps(a3batchInternalSlerpEpsilon));
+		const __m128 sInv = _mm_div_ps(one, _mm_or_ps(_mm_and_ps(valid, s), _mm_andnot_ps(valid, one)));
+		w0 = _mm_or_ps(_mm_and_ps(valid, _mm_mul_ps(s0, sInv)), _mm_andnot_ps(valid, _mm_sub_ps(one, tt)));
+		w1 = _mm_or_ps(_mm_and_ps(valid, _mm_mul_ps(s1, sInv)), _mm_andnot_ps(valid, tt));
+	}
+	else
+	{
+		if (mode == a3batchInternalQuat_slerpFast)
+			tt = a3batchInternalSlerpFastParamSSE(tt, d);
+		w0 = _mm_sub_ps(one, tt);
+		w1 = tt;
+	}
+	w1 = _mm_xor_ps(w1, sign);
+
+	rx = a3simdInternalMAdd(w1, bx, _mm_mul_ps(w0, ax));
+	ry = a3simdInternalMAdd(w1, by, _mm_mul_ps(w0, ay));
+	rz = a3simdInternalMAdd(w1, bz, _mm_mul_ps(w0, az));
+	rw = a3simdInternalMAdd(w1, bw, _mm_mul_ps(w0, aw));
+	if (mode != a3batchInternalQuat_slerp)
+	{
+		// normalize: reciprocal square root estimate plus one Newton step
+		n = a3simdInternalMAdd(rw, rw, a3simdInternalMAdd(rz, rz, a3simdInternalMAdd(ry, ry, _mm_mul_ps(rx, rx))));
+		r = _mm_rsqrt_ps(n);
+		r = _mm_mul_ps(_mm_mul_ps(half, r), _mm_sub_ps(_mm_set1_ps(3.0f), _mm_mul_ps(_mm_mul_ps(n, r), r)));
+		r = _mm_and_ps(r, _mm_cmpgt_ps(n, _mm_setzero_ps()));
+		rx = _mm_mul_ps(rx, r);
+		ry = _mm_mul_ps(ry, r);
+		rz = _mm_mul_ps(rz, r);
+		rw = _mm_mul_ps(rw, r);
+	}
+	_MM_TRANSPOSE4_PS(rx, ry, rz, rw);
+	_mm_storeu_ps(q_out[0], rx);
+	_mm_storeu_ps(q_out[1], ry);
+	_mm_storeu_ps(q_out[2], rz);
+	_mm_storeu_ps(q_out[3], rw);
+#else	// scalar
+	a3index i;
+	for (i = 0; i < 4; ++i)
+		a3batchInternalQuatInterpOne(q_out[i], q0[i], q1[i], t[i], mode);
+#endif	// A3_SIMD
+}
+
+// interpolate in blocks of four; unused lanes of the last block read identity and write to scratch
+A3_INLINE a3real4r a3batchInternalQuatInterp(a3real4p q_out, const a3size outStride, const a3real4p q0, const a3size q0Stride, const a3real4p q1, const a3size q1Stride, const a3real* param, const a3size paramStride, const a3count count, const a3i32 mode)
+{
+	const a3real identity[4] = { a3real_zero, a3real_zero, a3real_zero, a3real_one };
+	const a3real *a[4], *b[4];
+	a3real *o[4], t[4], scratch[4];
+	a3index i, j;
+	for (i = 0; i < count; i += 4)
+	{
+		for (j = 0; j < 4; ++j)
+		{
+			if (i + j < count)
+			{
+				a[j] = a3batchInternalAt(const a3real *, q0, q0Stride, i + j);
+				b[j] = a3batchInternalAt(const a3real *, q1, q1Stride, i + j);
+				o[j] = a3batchInternalAt(a3real *, q_out, outStride, i + j);
+				t[j] = *a3batchInternalAt(const a3real *, param, paramStride, i + j);
+			}
+			else
+			{
+				a[j] = b[j] = identity;
+				o[j] = scratch;
+				t[j] = a3real_zero;
+			}
+		}
+		a3batchInternalQuatInterpBlock(o, a, b, t, mode);
+	}
+	return q_out;
+}
+
+
+//-----------------------------------------------------------------------------
+
+A3_INLINE a3real4r a3quatSlerpUnitArray(a3real4p q_out, const a3size outStride, const a3real4p q0, const a3size q0Stride, const a3real4p q1, const a3size q1Stride, const a3real* param, const a3size paramStride, const a3count count)
+{
+	return a3batchInternalQuatInterp(q_out, outStride, q0, q0Stride, q1, q1Stride, param, paramStride, count, a3batchInternalQuat_slerp);
+}
+
+A3_INLINE a3real4r a3quatNlerpArray(a3real4p q_out, const a3size outStride, const a3real4p q0, const a3size q0Stride, const a3real4p q1, const a3size q1Stride, const a3real* param, const a3size paramStride, const a3count count)
+{
+	return a3batchInternalQuatInterp(q_out, outStride, q0, q0Stride, q1, q1Stride, param, paramStride, count, a3batchInternalQuat_nlerp);
+}
+
+A3_INLINE a3real4r a3quatSlerpFastUnitArray(a3real4p q_out, const a3size outStride, const a3real4p q0, const a3size q0Stride, const a3real4p q1, const a3size q1Stride, const a3real* param, const a3size paramStride, const a3count count)
+{
+	return a3batchInternalQuatInterp(q_out, outStride, q0, q0Stride, q1, q1Stride, param, paramStride, count, a3batchInternalQuat_slerpFast);
+}
+
+A3_INLINE a3real4r a3quatNlerp(a3real4p q_out, const a3real4p q0, const a3real4p q1, const a3real param)
+{
+	a3batchInternalQuatInterpOne(q_out, q0, q1, param, a3batchInternalQuat_nlerp);
+	return q_out;
+}
+
+A3_INLINE a3real4r a3quatSlerpFastUnit(a3real4p q_out, const a3real4p q0, const a3real4p q1, const a3real param)
+{
+	a3batchInternalQuatInterpOne(q_out, q0, q1, param, a3batchInternalQuat_slerpFast);
+	return q_out;
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+A3_END_IMPL
+
+
+#endif	// !__ANIMAL3D_A3DM_BATCH_IMPL_INL
+#endif	// __ANIMAL3D_A3DM_BATCH_H
@@ -0,0 +1,414 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	animal3D Math (A3DM) SDK
+	By Daniel S. Buckstein
+
+	a3dualquaternion_impl.inl
+	Implementations of dual quaternion functions.
+*/
+
+#ifdef __ANIMAL3D_A3DM_DUALQUATERNION_H
+#ifndef __ANIMAL3D_A3DM_DUALQUATERNION_IMPL_INL
+#define __ANIMAL3D_A3DM_DUALQUATERNION_IMPL_INL
+
+
+#include "../a3quaternion.h"
+
+
+A3_BEGIN_IMPL
+
+
+//-----------------------------------------------------------------------------
+
+A3_INLINE a3real4x2r a3dualquatSetIdentity(a3real4x2p Q_out)
+{
+	a3quatSetIdentity(Q_out[0]);
+	a3real4Set(Q_out[1], a3real_zero, a3real_zero, a3real_zero, a3real_zero);
+	return Q_out;
+}
+
+A3_INLINE a3real4x2r a3dualquatSet(a3real4x2p Q_out, const a3real4 rotateScaleQuat, const a3real4 dualPartQuat)
+{
+	a3real4SetReal4(Q_out[0], rotateScaleQuat);
+	a3real4SetReal4(Q_out[1], dualPartQuat);
+	return Q_out;
+}
+
+A3_INLINE a3real4x2r a3dualquatSetAxisAngle(a3real4x2p Q_out, const a3real3p unitAxis, const a3real degrees)
+{
+	a3quatSetAxisAngle(Q_out[0], unitAxis, degrees);
+	a3real4Set(Q_out[1], a3real_zero, a3real_zero, a3real_zero, a3real_zero);
+	return Q_out;
+}
+
+A3_INLINE a3real4x2r a3dualquatSetAxisAngleTranslate(a3real4x2p Q_out, const a3real3p unitAxis, const a3real degrees, const a3real3p translate)
+{
+	a3quatSetAxisAngle(Q_out[0], unitAxis, degrees);
+	a3dualquatCalculateDualPart(Q_out[1], Q_out[0], translate);
+	return Q_out;
+}
+
+A3_INLINE a3real4x2r a3dualquatSetEuler(a3real4x2p Q_out, const a3real degrees_x, const a3real degrees_y, const a3real degrees_z, const a3boolean eulerIsXYZ)
+{
+	if (eulerIsXYZ)
+		a3quatSetEulerXYZ(Q_out[0], degrees_x, degrees_y, degrees_z);
+	else
+		a3quatSetEulerZYX(Q_out[0], degrees_x, degrees_y, degrees_z);
+	a3real4Set(Q_out[1], a3real_zero, a3real_zero, a3real_zero, a3real_zero);
+	return Q_out;
+}
+
+A3_INLINE a3real4x2r a3dualquatSetEulerTranslate(a3real4x2p Q_out, const a3real degrees_x, const a3real degrees_y, const a3real degrees_z, const a3boolean eulerIsXYZ, const a3real3p translate)
+{
+	a3dualquatSetEuler(Q_out, degrees_x, degrees_y, degrees_z, eulerIsXYZ);
+	a3dualquatCalculateDualPart(Q_out[1], Q_out[0], translate);
+	return Q_out;
+}
+
+A3_INLINE a3real4x2r a3dualquatSetTranslate(a3real4x2p Q_out, const a3real3p translate)
+{
+	a3quatSetIdentity(Q_out[0]);
+	a3real4Set(Q_out[1], a3real_half * translate[0], a3real_half * translate[1], a3real_half * translate[2], a3real_zero);
+	return Q_out;
+}
+
+A3_INLINE a3real4x2r a3dualquatCopy(a3real4x2p Q_out, const a3real4x2p Q)
+{
+	a3real4SetReal4(Q_out[0], Q[0]);
+	a3real4SetReal4(Q_out[1], Q[1]);
+	return Q_out;
+}
+
+
+A3_INLINE a3real4x2r a3dualquatGetConjugated(a3real4x2p Q_out, const a3real4x2p Q)
+{
+	a3quatGetConjugated(Q_out[0], Q[0]);
+	a3quatGetConjugated(Q_out[1], Q[1]);
+	return Q_out;
+}
+
+A3_INLINE a3real4x2r a3dualquatGetInverseIgnoreScale(a3real4x2p Q_out, const a3real4x2p Q)
+{
+	return a3dualquatGetConjugated(Q_out, Q);
+}
+
+A3_INLINE a3real4x2r a3dualquatConjugate(a3real4x2p Q_inout)
+{
+	return a3dualquatGetConjugated(Q_inout, Q_inout);
+}
+
+A3_INLINE a3real4x2r a3dualquatInvertIgnoreScale(a3real4x2p Q_inout)
+{
+	return a3dualquatGetConjugated(Q_inout, Q_inout);
+}
+
+
+A3_INLINE a3real4x2rk a3dualquatGetAxisAngleIgnoreScale(const a3real4x2p Q, a3real3p unitAxis_out, a3real *degrees_out)
+{
+	a3quatGetAxisAngleIgnoreScale(Q[0], unitAxis_out, degrees_out);
+	return Q;
+}
+
+A3_INLINE a3real4x2rk a3dualquatGetAxisAngleTranslateIgnoreScale(const a3real4x2p Q, a3real3p unitAxis_out, a3real *degrees_out, a3real3p translate_out)
+{
+	a3quatGetAxisAngleIgnoreScale(Q[0], unitAxis_out, degrees_out);
+	a3dualquatCalculateTranslateIgnoreScale(translate_out, Q[0], Q[1]);
+	return Q;
+}
+
+
+A3_INLINE a3real a3dualquatLengthSquared(const a3real4x2p Q)
+{
+	return a3real4LengthSquared(Q[0]);
+}
+
+A3_INLINE a3real a3dualquatLengthSquaredInverse(const a3real4x2p Q)
+{
+	return a3real4LengthSquaredInverse(Q[0]);
+}
+
+A3_INLINE a3real a3dualquatLength(const a3real4x2p Q)
+{
+	return a3real4Length(Q[0]);
+}
+
+A3_INLINE a3real a3dualquatLengthInverse(const a3real4x2p Q)
+{
+	return a3real4LengthInverse(Q[0]);
+}
+
+A3_INLINE a3real4x2r a3dualquatGetUnit(a3real4x2p Q_out, const a3real4x2p Q)
+{
+	const a3real lenInv = a3real4LengthInverse(Q[0]);
+	a3real4ProductS(Q_out[0], Q[0], lenInv);
+	a3real4ProductS(Q_out[1], Q[1], lenInv);
+	return Q_out;
+}
+
+A3_INLINE a3real4x2r a3dualquatGetUnitInvLength(a3real4x2p Q_out, const a3real4x2p Q, a3real *invLength_out)
+{
+	const a3real lenInv = a3real4LengthInverse(Q[0]);
+	a3real4ProductS(Q_out[0], Q[0], lenInv);
+	a3real4ProductS(Q_out[1], Q[1], lenInv);
+	if (invLength_out)
+		*invLength_out = lenInv;
+	return Q_out;
+}
+
+A3_INLINE a3real4x2r a3dualquatNormalize(a3real4x2p Q_inout)
+{
+	return a3dualquatGetUnit(Q_inout, Q_inout);
+}
+
+A3_INLINE a3real4x2r a3dualquatNormalizeGetInvLength(a3real4x2p Q_inout, a3real *invLength_out)
+{
+	return a3dualquatGetUnitInvLength(Q_inout, Q_inout, invLength_out);
+}
+
+
+A3_INLINE a3real4x4r a3dualquatConvertToMat4IgnoreScale(a3real4x4p m_out, const a3real4x2 Q)
+{
+	a3quatConvertToMat4(m_out, Q[0]);
+	a3dualquatCalculateTranslateIgnoreScale(m_out[3], Q[0], Q[1]);
+	return m_out;
+}
+
+
+A3_INLINE a3real4x2r a3dualquatSum(a3real4x2p Q_out, const a3real4x2p QL, const a3real4x2p QR)
+{
+	a3real4Sum(Q_out[0], QL[0], QR[0]);
+	a3real4Sum(Q_out[1], QL[1], QR[1]);
+	return Q_out;
+}
+
+A3_INLINE a3real4x2r a3dualquatDiff(a3real4x2p Q_out, const a3real4x2p QL, const a3real4x2p QR)
+{
+	a3real4Diff(Q_out[0], QL[0], QR[0]);
+	a3real4Diff(Q_out[1], QL[1], QR[1]);
+	return Q_out;
+}
+
+A3_INLINE a3real4x2r a3dualquatProductS(a3real4x2p Q_out, const a3real4x2p Q, const a3real s)
+{
+	a3real4ProductS(Q_out[0], Q[0], s);
+	a3real4ProductS(Q_out[1], Q[1], s);
+	return Q_out;
+}
+
+A3_INLINE a3real4x2r a3dualquatQuotientS(a3real4x2p Q_out, const a3real4x2p Q, const a3real s)
+{
+	return a3dualquatProductS(Q_out, Q, a3real_one / s);
+}
+
+A3_INLINE a3real4x2r a3dualquatAdd(a3real4x2p QL_inout, const a3real4x2p QR)
+{
+	a3real4Add(QL_inout[0], QR[0]);
+	a3real4Add(QL_inout[1], QR[1]);
+	return QL_inout;
+}
+
+A3_INLINE a3real4x2r a3dualquatSub(a3real4x2p QL_inout, const a3real4x2p QR)
+{
+	a3real4Sub(QL_inout[0], QR[0]);
+	a3real4Sub(QL_inout[1], QR[1]);
+	return QL_inout;
+}
+
+A3_INLINE a3real4x2r a3dualquatMulS(a3real4x2p Q_inout, const a3real s)
+{
+	a3real4MulS(Q_inout[0], s);
+	a3real4MulS(Q_inout[1], s);
+	return Q_inout;
+}
+
+A3_INLINE a3real4x2r a3dualquatDivS(a3real4x2p Q_inout, const a3real s)
+{
+	return a3dualquatMulS(Q_inout, a3real_one / s);
+}
+
+
+A3_INLINE a3real4x2r a3dualquatProduct(a3real4x2p Q_out, const a3real4x2p QL, const a3real4x2 QR)
+{
+	// real: rL rR; dual: rL dR + dL rR
+	a3real4x2 tmp;
+	a3real4 t;
+	a3quatProduct(tmp[0], QL[0], QR[0]);
+	a3quatProduct(tmp[1], QL[0], QR[1]);
+	a3real4Add(tmp[1], a3quatProduct(t, QL[1], QR[0]));
+	return a3dualquatCopy(Q_out, tmp);
+}
+
+A3_INLINE a3real4x2r a3dualquatConcatL(a3real4x2p QL_inout, const a3real4x2 QR)
+{
+	return a3dualquatProduct(QL_inout, QL_inout, QR);
+}
+
+A3_INLINE a3real4x2r a3dualquatConcatR(const a3real4x2p QL, a3real4x2 QR_inout)
+{
+	return a3dualquatProduct(QR_inout, QL, QR_inout);
+}
+
+
+A3_INLINE a3real3r a3dualquatVec3GetTransformedIgnoreScale(a3real3p v_out, const a3real3p v, const a3real4x2p Q)
+{
+	a3real3 t;
+	a3dualquatCalculateTranslateIgnoreScale(t, Q[0], Q[1]);
+	a3quatVec3GetRotatedIgnoreScale(v_out, v, Q[0]);
+	return a3real3Add(v_out, t);
+}
+
+A3_INLINE a3real3r a3dualquatVec3TransformIgnoreScale(a3real3p v_inout, const a3real4x2p Q)
+{
+	return a3dualquatVec3GetTransformedIgnoreScale(v_inout, v_inout, Q);
+}
+
+
+A3_INLINE a3real4x2r a3dualquatSclerpUnit(a3real4x2p Q_out, const a3real4x2p Q0, const a3real4x2p Q1, const a3real param)
+{
+	a3real4x2 delta;
+	a3real3 axis, moment, translate;
+	a3real degrees, distance, s, c;
+
+	// delta from Q0 to Q1 the short way around
+	a3dualquatGetConjugated(delta, Q0);
+	if (a3real4Dot(Q0[0], Q1[0]) < a3real_zero)
+	{
+		a3real4x2 Q1n;
+		a3dualquatConcatL(delta, a3dualquatProductS(Q1n, Q1, -a3real_one));
+	}
+	else
+		a3dualquatConcatL(delta, Q1);
+
+	// scale screw motion by param and rebuild
+	a3dualquatCalculateScrewParamsIgnoreScale(delta, axis, moment, translate, &degrees, &distance);
+	degrees *= a3real_half * param;
+	distance *= a3real_half * param;
+	s = a3sind(degrees);
+	c = a3cosd(degrees);
+	a3real4Set(delta[0], axis[0] * s, axis[1] * s, axis[2] * s, c);
+	a3real4Set(delta[1], 
+		moment[0] * s + axis[0] * distance * c, 
+		moment[1] * s + axis[1] * distance * c, 
+		moment[2] * s + axis[2] * distance * c, 
+		-distance * s);
+	return a3dualquatProduct(Q_out, Q0, delta);
+}
+
+A3_INLINE a3real4x2r a3dualquatSclerpUnitIdentityQ0(a3real4x2p Q_out, const a3real4x2p Q1, const a3real param)
+{
+	a3real4x2 Q0;
+	return a3dualquatSclerpUnit(Q_out, a3dualquatSetIdentity(Q0), Q1, param);
+}
+
+A3_INLINE a3real4x2r a3dualquatSclerpUnitIdentityQ1(a3real4x2p Q_out, const a3real4x2p Q0, const a3real param)
+{
+	a3real4x2 Q1;
+	return a3dualquatSclerpUnit(Q_out, Q0, a3dualquatSetIdentity(Q1), param);
+}
+
+A3_INLINE a3real4x2r a3dualquatDLB2(a3real4x2p Q_out, const a3real4x2p Q0, const a3real4x2p Q1)
+{
+	return a3dualquatNormalize(a3dualquatSum(Q_out, Q0, Q1));
+}
+
+A3_INLINE a3real4x2r a3dualquatDLB4(a3real4x2p Q_out, const a3real4x2p Q0, const a3real4x2p Q1, const a3real4x2p Q2, const a3real4x2p Q3)
+{
+	a3dualquatSum(Q_out, Q0, Q1);
+	a3dualquatAdd(Q_out, Q2);
+	a3dualquatAdd(Q_out, Q3);
+	return a3dualquatNormalize(Q_out);
+}
+
+A3_INLINE a3real4x2r a3dualquatDLB(a3real4x2p Q_out, const a3real4x2 Q[], const a3count count)
+{
+	a3index i;
+	if (count <= 0)
+		return a3dualquatSetIdentity(Q_out);
+	a3dualquatCopy(Q_out, Q[0]);
+	for (i = 1; i < count; ++i)
+		a3dualquatAdd(Q_out, Q[i]);
+	return a3dualquatNormalize(Q_out);
+}
+
+
+A3_INLINE a3real4r a3dualquatCalculateDualPart(a3real4p d_out, const a3real4p r, const a3real3p translate)
+{
+	// d = (t / 2) r
+	a3real4 t;
+	a3real4Set(t, a3real_half * translate[0], a3real_half * translate[1], a3real_half * translate[2], a3real_zero);
+	return a3quatProductPureL(d_out, t, r);
+}
+
+A3_INLINE a3real3r a3dualquatCalculateTranslateIgnoreScale(a3real3p translate_out, const a3real4p r, const a3real4p d)
+{
+	// t = 2 d r*
+	a3real4 rc, t;
+	a3quatProduct(t, d, a3quatGetConjugated(rc, r));
+	translate_out[0] = t[0] + t[0];
+	translate_out[1] = t[1] + t[1];
+	translate_out[2] = t[2] + t[2];
+	return translate_out;
+}
+
+
+A3_INLINE a3real4x2rk a3dualquatCalculateScrewParamsIgnoreScale(const a3real4x2p Q, a3real3p unitAxis_out, a3real3p moment_out, a3real3p translate_out, a3real *degrees_out, a3real *distance_out)
+{
+	const a3real w = a3clamp(-a3real_one, a3real_one, Q[0][3]);
+	const a3real a = a3acosd(w);
+	const a3real s = a3sind(a);
+	a3dualquatCalculateTranslateIgnoreScale(translate_out, Q[0], Q[1]);
+	*degrees_out = a3real_two * a;
+	if (s * s > a3real_zero)
+	{
+		// axis from real part, pitch from dual scalar, moment from remainder
+		const a3real sInv = a3real_one / s;
+		a3real3ProductS(unitAxis_out, Q[0], sInv);
+		*distance_out = -a3real_two * Q[1][3] * sInv;
+		moment_out[0] = (Q[1][0] - unitAxis_out[0] * a3real_half * *distance_out * w) * sInv;
+		moment_out[1] = (Q[1][1] - unitAxis_out[1] * a3real_half * *distance_out * w) * sInv;
+		moment_out[2] = (Q[1][2] - unitAxis_out[2] * a3real_half * *distance_out * w) * sInv;
+	}
+	else
+	{
+		// pure translation: slide along translation direction
+		*distance_out = a3real3Length(translate_out);
+		if (*distance_out > a3real_zero)
+			a3real3ProductS(unitAxis_out, translate_out, a3real_one / *distance_out);
+		else
+			a3real3Set(unitAxis_out, a3real_one, a3real_zero, a3real_zero);
+		a3real3Set(moment_out, a3real_zero, a3real_zero, a3real_zero);
+	}
+	return Q;
+}
+
+
+//-----------------------------------------------------------------------------
+
+// constants are static per translation unit (declared extern otherwise)
+A3_GLOBAL const a3dualquat a3dualquat_identity = { { a3real_zero, a3real_zero, a3real_zero, a3real_one, a3real_zero, a3real_zero, a3real_zero, a3real_zero } };
+
+
+//-----------------------------------------------------------------------------
+
+
+A3_END_IMPL
+
+
+#endif	// !__ANIMAL3D_A3DM_DUALQUATERNION_IMPL_INL
+#endif	// __ANIMAL3D_A3DM_DUALQUATERNION_H
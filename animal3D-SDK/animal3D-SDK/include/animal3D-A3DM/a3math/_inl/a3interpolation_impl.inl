@@ -0,0 +1,396 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	animal3D Math (A3DM) SDK
+	By Daniel S. Buckstein
+
+	a3interpolation_impl.inl
+	Implementations of interpolation and sample table functions.
+*/
+
+#ifdef __ANIMAL3D_A3DM_INTERPOLATION_H
+#ifndef __ANIMAL3D_A3DM_INTERPOLATION_IMPL_INL
+#define __ANIMAL3D_A3DM_INTERPOLATION_IMPL_INL
+
+
+A3_BEGIN_IMPL
+
+
+//-----------------------------------------------------------------------------
+// internal helpers
+
+// store sample i of an arc length table and return running arc length
+A3_INLINE a3real a3interpolationInternalArcLengthStore(a3real sampleTable_out[], a3real paramTable_out[], a3real arclenTable_out[], const a3index i, const a3real param, const a3real sample, a3real arclen)
+{
+	a3real d;
+	if (i)
+	{
+		d = sample - sampleTable_out[i - 1];
+		arclen += (d >= a3real_zero ? d : -d);
+	}
+	sampleTable_out[i] = sample;
+	arclenTable_out[i] = arclen;
+	if (paramTable_out)
+		paramTable_out[i] = param;
+	return arclen;
+}
+
+// normalize arc length table (first entry is always zero)
+A3_INLINE void a3interpolationInternalArcLengthNormalize(a3real arclenTable_out[], const a3count numDivisions, const a3real arclen)
+{
+	const a3real arclenInv = arclen != a3real_zero ? a3real_one / arclen : a3real_zero;
+	a3index i;
+	for (i = 1; i <= numDivisions; ++i)
+		arclenTable_out[i] *= arclenInv;
+}
+
+
+//-----------------------------------------------------------------------------
+
+A3_INLINE a3real a3lerpFunc(const a3real n0, const a3real n1, const a3real param)
+{
+	return (n0 + (n1 - n0) * param);
+}
+
+A3_INLINE a3real a3lerpInverse(const a3real n0, const a3real n1, const a3real value)
+{
+	return ((value - n0) / (n1 - n0));
+}
+
+A3_INLINE a3real a3lerpSafeInverse(const a3real n0, const a3real n1, const a3real value)
+{
+	return (n0 != n1 ? a3lerpInverse(n0, n1, value) : a3real_zero);
+}
+
+A3_INLINE a3real a3remapFunc(const a3real n0_new, const a3real n1_new, const a3real n0, const a3real n1, const a3real value)
+{
+	return a3lerpFunc(n0_new, n1_new, a3lerpInverse(n0, n1, value));
+}
+
+A3_INLINE a3real a3remapSafe(const a3real n0_new, const a3real n1_new, const a3real n0, const a3real n1, const a3real value)
+{
+	return a3lerpFunc(n0_new, n1_new, a3lerpSafeInverse(n0, n1, value));
+}
+
+A3_INLINE a3real a3bilerp(const a3real n00, const a3real n01, const a3real n10, const a3real n11, const a3real param0, const a3real param1)
+{
+	return a3lerpFunc(a3lerpFunc(n00, n01, param0), a3lerpFunc(n10, n11, param0), param1);
+}
+
+A3_INLINE a3real a3trilerp(const a3real n000, const a3real n001, const a3real n010, const a3real n011, const a3real n100, const a3real n101, const a3real n110, const a3real n111, const a3real param0, const a3real param1, const a3real param2)
+{
+	return a3lerpFunc(a3bilerp(n000, n001, n010, n011, param0, param1), a3bilerp(n100, n101, n110, n111, param0, param1), param2);
+}
+
+
+A3_INLINE a3real a3CatmullRom(const a3real nPrev, const a3real n0, const a3real n1, const a3real nNext, const a3real param)
+{
+	return (n0 + a3real_half * param * ((n1 - nPrev) + param * ((a3real_two * nPrev - a3real_five * n0 + a3real_four * n1 - nNext) + param * (nNext - nPrev + a3real_three * (n0 - n1)))));
+}
+
+A3_INLINE a3real a3HermiteControl(const a3real n0, const a3real n1, const a3real nControl0, const a3real nControl1, const a3real param)
+{
+	return a3HermiteTangent(n0, n1, nControl0 - n0, nControl1 - n1, param);
+}
+
+A3_INLINE a3real a3HermiteTangent(const a3real n0, const a3real n1, const a3real nTangent0, const a3real nTangent1, const a3real param)
+{
+	return (n0 + param * (nTangent0 + param * ((a3real_three * (n1 - n0) - nTangent1 - a3real_two * nTangent0) + param * (nTangent0 + nTangent1 + a3real_two * (n0 - n1)))));
+}
+
+A3_INLINE a3real a3Bezier0(const a3real n0, const a3real param)
+{
+	return n0;
+}
+
+A3_INLINE a3real a3Bezier1(const a3real n0, const a3real n1, const a3real param)
+{
+	return a3lerpFunc(n0, n1, param);
+}
+
+A3_INLINE a3real a3Bezier2(const a3real n0, const a3real n1, const a3real n2, const a3real param)
+{
+	return a3lerpFunc(a3Bezier1(n0, n1, param), a3Bezier1(n1, n2, param), param);
+}
+
+A3_INLINE a3real a3Bezier3(const a3real n0, const a3real n1, const a3real n2, const a3real n3, const a3real param)
+{
+	return a3lerpFunc(a3Bezier2(n0, n1, n2, param), a3Bezier2(n1, n2, n3, param), param);
+}
+
+A3_INLINE a3real a3BezierN(a3count order_N, const a3real n[], const a3real param)
+{
+	if (order_N)
+	{
+		if (--order_N)
+			return a3lerpFunc(a3BezierN(order_N, n, param), a3BezierN(order_N, n + 1, param), param);
+		return a3lerpFunc(n[0], n[1], param);
+	}
+	return n[0];
+}
+
+
+//-----------------------------------------------------------------------------
+
+A3_INLINE a3real a3calculateArcLengthCatmullRom(a3real sampleTable_out[], a3real paramTable_out[], a3real arclenTable_out[], const a3boolean autoNormalize, const a3count numDivisions, const a3real nPrev, const a3real n0, const a3real n1, const a3real nNext)
+{
+	const a3real dt = a3real_one / (a3real)numDivisions;
+	a3real t, arclen = a3real_zero;
+	a3index i;
+	if (!sampleTable_out || !arclenTable_out || !numDivisions)
+		return a3real_zero;
+	for (i = 0; i <= numDivisions; ++i)
+	{
+		t = (a3real)i * dt;
+		arclen = a3interpolationInternalArcLengthStore(sampleTable_out, paramTable_out, arclenTable_out, i, t, a3CatmullRom(nPrev, n0, n1, nNext, t), arclen);
+	}
+	if (autoNormalize)
+		a3interpolationInternalArcLengthNormalize(arclenTable_out, numDivisions, arclen);
+	return arclen;
+}
+
+A3_INLINE a3real a3calculateArcLengthHermiteControl(a3real sampleTable_out[], a3real paramTable_out[], a3real arclenTable_out[], const a3boolean autoNormalize, const a3count numDivisions, const a3real n0, const a3real n1, const a3real nControl0, const a3real nControl1)
+{
+	return a3calculateArcLengthHermiteTangent(sampleTable_out, paramTable_out, arclenTable_out, autoNormalize, numDivisions, n0, n1, nControl0 - n0, nControl1 - n1);
+}
+
+A3_INLINE a3real a3calculateArcLengthHermiteTangent(a3real sampleTable_out[], a3real paramTable_out[], a3real arclenTable_out[], const a3boolean autoNormalize, const a3count numDivisions, const a3real n0, const a3real n1, const a3real nTangent0, const a3real nTangent1)
+{
+	const a3real dt = a3real_one / (a3real)numDivisions;
+	a3real t, arclen = a3real_zero;
+	a3index i;
+	if (!sampleTable_out || !arclenTable_out || !numDivisions)
+		return a3real_zero;
+	for (i = 0; i <= numDivisions; ++i)
+	{
+		t = (a3real)i * dt;
+		arclen = a3interpolationInternalArcLengthStore(sampleTable_out, paramTable_out, arclenTable_out, i, t, a3HermiteTangent(n0, n1, nTangent0, nTangent1, t), arclen);
+	}
+	if (autoNormalize)
+		a3interpolationInternalArcLengthNormalize(arclenTable_out, numDivisions, arclen);
+	return arclen;
+}
+
+A3_INLINE a3real a3calculateArcLengthBezier0(a3real sampleTable_out[], a3real paramTable_out[], a3real arclenTable_out[], const a3boolean autoNormalize, const a3count numDivisions, const a3real n0)
+{
+	const a3real dt = a3real_one / (a3real)numDivisions;
+	a3index i;
+	if (!sampleTable_out || !arclenTable_out || !numDivisions)
+		return a3real_zero;
+	for (i = 0; i <= numDivisions; ++i)
+		a3interpolationInternalArcLengthStore(sampleTable_out, paramTable_out, arclenTable_out, i, (a3real)i * dt, n0, a3real_zero);
+	return a3real_zero;
+}
+
+A3_INLINE a3real a3calculateArcLengthBezier1(a3real sampleTable_out[], a3real paramTable_out[], a3real arclenTable_out[], const a3boolean autoNormalize, const a3count numDivisions, const a3real n0, const a3real n1)
+{
+	const a3real dt = a3real_one / (a3real)numDivisions;
+	a3real t, arclen = a3real_zero;
+	a3index i;
+	if (!sampleTable_out || !arclenTable_out || !numDivisions)
+		return a3real_zero;
+	for (i = 0; i <= numDivisions; ++i)
+	{
+		t = (a3real)i * dt;
+		arclen = a3interpolationInternalArcLengthStore(sampleTable_out, paramTable_out, arclenTable_out, i, t, a3Bezier1(n0, n1, t), arclen);
+	}
+	if (autoNormalize)
+		a3interpolationInternalArcLengthNormalize(arclenTable_out, numDivisions, arclen);
+	return arclen;
+}
+
+A3_INLINE a3real a3calculateArcLengthBezier2(a3real sampleTable_out[], a3real paramTable_out[], a3real arclenTable_out[], const a3boolean autoNormalize, const a3count numDivisions, const a3real n0, const a3real n1, const a3real n2)
+{
+	const a3real dt = a3real_one / (a3real)numDivisions;
+	a3real t, arclen = a3real_zero;
+	a3index i;
+	if (!sampleTable_out || !arclenTable_out || !numDivisions)
+		return a3real_zero;
+	for (i = 0; i <= numDivisions; ++i)
+	{
+		t = (a3real)i * dt;
+		arclen = a3interpolationInternalArcLengthStore(sampleTable_out, paramTable_out, arclenTable_out, i, t, a3Bezier2(n0, n1, n2, t), arclen);
+	}
+	if (autoNormalize)
+		a3interpolationInternalArcLengthNormalize(arclenTable_out, numDivisions, arclen);
+	return arclen;
+}
+
+A3_INLINE a3real a3calculateArcLengthBezier3(a3real sampleTable_out[], a3real paramTable_out[], a3real arclenTable_out[], const a3boolean autoNormalize, const a3count numDivisions, const a3real n0, const a3real n1, const a3real n2, const a3real n3)
+{
+	const a3real dt = a3real_one / (a3real)numDivisions;
+	a3real t, arclen = a3real_zero;
+	a3index i;
+	if (!sampleTable_out || !arclenTable_out || !numDivisions)
+		return a3real_zero;
+	for (i = 0; i <= numDivisions; ++i)
+	{
+		t = (a3real)i * dt;
+		arclen = a3interpolationInternalArcLengthStore(sampleTable_out, paramTable_out, arclenTable_out, i, t, a3Bezier3(n0, n1, n2, n3, t), arclen);
+	}
+	if (autoNormalize)
+		a3interpolationInternalArcLengthNormalize(arclenTable_out, numDivisions, arclen);
+	return arclen;
+}
+
+A3_INLINE a3real a3calculateArcLengthBezierN(a3real sampleTable_out[], a3real paramTable_out[], a3real arclenTable_out[], const a3boolean autoNormalize, const a3count numDivisions, const a3count order_N, const a3real n[])
+{
+	const a3real dt = a3real_one / (a3real)numDivisions;
+	a3real t, arclen = a3real_zero;
+	a3index i;
+	if (!sampleTable_out || !arclenTable_out || !numDivisions || !n)
+		return a3real_zero;
+	for (i = 0; i <= numDivisions; ++i)
+	{
+		t = (a3real)i * dt;
+		arclen = a3interpolationInternalArcLengthStore(sampleTable_out, paramTable_out, arclenTable_out, i, t, a3BezierN(order_N, n, t), arclen);
+	}
+	if (autoNormalize)
+		a3interpolationInternalArcLengthNormalize(arclenTable_out, numDivisions, arclen);
+	return arclen;
+}
+
+
+//-----------------------------------------------------------------------------
+
+A3_INLINE a3real a3sampleTableLerpIncrement(const a3real valueTable[], const a3real paramTable[], const a3real param, a3index i)
+{
+	a3real u;
+	i = a3sampleTableLerpIncrementIndex(paramTable, param, i, &u);
+	return a3lerpFunc(valueTable[i - 1], valueTable[i], u);
+}
+
+A3_INLINE a3real a3sampleTableLerpDecrement(const a3real valueTable[], const a3real paramTable[], const a3real param, a3index i)
+{
+	a3real u;
+	i = a3sampleTableLerpDecrementIndex(paramTable, param, i, &u);
+	return a3lerpFunc(valueTable[i - 1], valueTable[i], u);
+}
+
+A3_INLINE a3real a3sampleTableLerpIncrementStep(const a3real valueTable[], const a3real paramTable[], const a3real param, const a3count step, a3index i)
+{
+	a3real u;
+	i = a3sampleTableLerpIncrementStepIndex(paramTable, param, step, i, &u);
+	return a3lerpFunc(valueTable[i - step], valueTable[i], u);
+}
+
+A3_INLINE a3real a3sampleTableLerpDecrementStep(const a3real valueTable[], const a3real paramTable[], const a3real param, const a3count step, a3index i)
+{
+	a3real u;
+	i = a3sampleTableLerpDecrementStepIndex(paramTable, param, step, i, &u);
+	return a3lerpFunc(valueTable[i - step], valueTable[i], u);
+}
+
+A3_INLINE a3index a3sampleTableLerpIncrementIndex(const a3real paramTable[], const a3real param, a3index i, a3real *param_out)
+{
+	a3real p0 = paramTable[i++], p1 = paramTable[i];
+	while (param > p1)
+	{
+		p0 = p1;
+		p1 = paramTable[++i];
+	}
+	if (param_out)
+		*param_out = (param - p0) / (p1 - p0);
+	return i;
+}
+
+A3_INLINE a3index a3sampleTableLerpDecrementIndex(const a3real paramTable[], const a3real param, a3index i, a3real *param_out)
+{
+	a3real p0 = paramTable[i++], p1 = paramTable[i];
+	while (param < p1)
+	{
+		p0 = p1;
+		p1 = paramTable[++i];
+	}
+	if (param_out)
+		*param_out = (param - p0) / (p1 - p0);
+	return i;
+}
+
+A3_INLINE a3index a3sampleTableLerpIncrementStepIndex(const a3real paramTable[], const a3real param, const a3count step, a3index i, a3real *param_out)
+{
+	a3real p0 = paramTable[i], p1 = paramTable[i += step];
+	while (param > p1)
+	{
+		p0 = p1;
+		p1 = paramTable[i += step];
+	}
+	if (param_out)
+		*param_out = (param - p0) / (p1 - p0);
+	return i;
+}
+
+A3_INLINE a3index a3sampleTableLerpDecrementStepIndex(const a3real paramTable[], const a3real param, const a3count step, a3index i, a3real *param_out)
+{
+	a3real p0 = paramTable[i], p1 = paramTable[i += step];
+	while (param < p1)
+	{
+		p0 = p1;
+		p1 = paramTable[i += step];
+	}
+	if (param_out)
+		*param_out = (param - p0) / (p1 - p0);
+	return i;
+}
+
+A3_INLINE a3index a3sampleTableGenerate(a3real sampleTable_out[], a3real paramTable_out[], const a3count numDivisions, const a3count numSubdivisions, const a3real paramMin, const a3real paramMax, const a3realfunc func)
+{
+	const a3count n = numDivisions * numSubdivisions;
+	const a3real dp = n ? (paramMax - paramMin) / (a3real)n : a3real_zero;
+	a3real p = paramMin;
+	a3index i;
+	if (!n || dp == a3real_zero || !func || !sampleTable_out || !paramTable_out)
+		return 0;
+	for (i = 0; i <= n; ++i, p += dp)
+	{
+		sampleTable_out[i] = func(p);
+		paramTable_out[i] = p;
+	}
+	return (n + 1);
+}
+
+A3_INLINE a3index a3sampleTableGenerateArcLength(a3real sampleTable_out[], a3real paramTable_out[], a3real arclenTable_out[], const a3boolean autoNormalize, const a3count numDivisions, const a3count numSubdivisions, const a3real paramMin, const a3real paramMax, const a3realfunc func)
+{
+	const a3count n = numDivisions * numSubdivisions;
+	const a3real dp = n ? (paramMax - paramMin) / (a3real)n : a3real_zero;
+	a3real p = paramMin, arclen = a3real_zero;
+	a3index i;
+	if (!n || dp == a3real_zero || !func || !sampleTable_out || !arclenTable_out)
+		return 0;
+	for (i = 0; i <= n; ++i, p += dp)
+		arclen = a3interpolationInternalArcLengthStore(sampleTable_out, paramTable_out, arclenTable_out, i, p, func(p), arclen);
+	if (autoNormalize)
+		a3interpolationInternalArcLengthNormalize(arclenTable_out, n, arclen);
+	return (n + 1);
+}
+
+A3_INLINE a3index a3sampleTableGenerateNumSamplesRequired(const a3index numDivisions, const a3count numSubdivisions)
+{
+	return (numDivisions * numSubdivisions + 1);
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+A3_END_IMPL
+
+
+#endif	// !__ANIMAL3D_A3DM_INTERPOLATION_IMPL_INL
+#endif	// __ANIMAL3D_A3DM_INTERPOLATION_H
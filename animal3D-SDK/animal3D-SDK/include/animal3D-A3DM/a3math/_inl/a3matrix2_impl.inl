@@ -0,0 +1,299 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	animal3D Math (A3DM) SDK
+	By Daniel S. Buckstein
+
+	a3matrix2_impl.inl
+	Implementations of 2D matrix functions.
+*/
+
+#ifdef __ANIMAL3D_A3DM_MATRIX_H
+#ifndef __ANIMAL3D_A3DM_MATRIX2_IMPL_INL
+#define __ANIMAL3D_A3DM_MATRIX2_IMPL_INL
+
+
+A3_BEGIN_IMPL
+
+
+//-----------------------------------------------------------------------------
+
+A3_INLINE a3real2x2r a3real2x2SetIdentity(a3real2x2p m_out)
+{
+	m_out[0][0] = a3real_one;
+	m_out[0][1] = a3real_zero;
+	m_out[1][0] = a3real_zero;
+	m_out[1][1] = a3real_one;
+	return m_out;
+}
+
+A3_INLINE a3real2x2r a3real2x2Set(a3real2x2p m_out, const a3real x0, const a3real y0, const a3real x1, const a3real y1)
+{
+	m_out[0][0] = x0;
+	m_out[0][1] = y0;
+	m_out[1][0] = x1;
+	m_out[1][1] = y1;
+	return m_out;
+}
+
+A3_INLINE a3real2x2r a3real2x2SetMajors(a3real2x2p m_out, const a3real2p v0, const a3real2p v1)
+{
+	m_out[0][0] = v0[0];
+	m_out[0][1] = v0[1];
+	m_out[1][0] = v1[0];
+	m_out[1][1] = v1[1];
+	return m_out;
+}
+
+A3_INLINE a3real2x2r a3real2x2SetMinors(a3real2x2p m_out, const a3real2p v0, const a3real2p v1)
+{
+	m_out[0][0] = v0[0];
+	m_out[0][1] = v1[0];
+	m_out[1][0] = v0[1];
+	m_out[1][1] = v1[1];
+	return m_out;
+}
+
+A3_INLINE a3real2x2r a3real2x2SetReal2x2(a3real2x2p m_out, const a3real2x2p m)
+{
+	m_out[0][0] = m[0][0];
+	m_out[0][1] = m[0][1];
+	m_out[1][0] = m[1][0];
+	m_out[1][1] = m[1][1];
+	return m_out;
+}
+
+A3_INLINE a3real2x2r a3real2x2SetReal3x3(a3real2x2p m_out, const a3real3x3p m)
+{
+	m_out[0][0] = m[0][0];
+	m_out[0][1] = m[0][1];
+	m_out[1][0] = m[1][0];
+	m_out[1][1] = m[1][1];
+	return m_out;
+}
+
+A3_INLINE a3real2x2r a3real2x2SetReal4x4(a3real2x2p m_out, const a3real4x4p m)
+{
+	m_out[0][0] = m[0][0];
+	m_out[0][1] = m[0][1];
+	m_out[1][0] = m[1][0];
+	m_out[1][1] = m[1][1];
+	return m_out;
+}
+
+
+A3_INLINE a3real a3real2x2Determinant(const a3real2x2p m)
+{
+	return (m[0][0] * m[1][1] - m[1][0] * m[0][1]);
+}
+
+A3_INLINE a3real a3real2x2DeterminantInverse(const a3real2x2p m)
+{
+	return (a3real_one / a3real2x2Determinant(m));
+}
+
+A3_INLINE a3real2x2r a3real2x2GetNegative(a3real2x2p m_out, const a3real2x2p m)
+{
+	a3real2GetNegative(m_out[0], m[0]);
+	a3real2GetNegative(m_out[1], m[1]);
+	return m_out;
+}
+
+A3_INLINE a3real2x2r a3real2x2GetTransposed(a3real2x2p m_out, const a3real2x2p m)
+{
+	a3real2x2 tmp;
+	tmp[0][0] = m[0][0];
+	tmp[0][1] = m[1][0];
+	tmp[1][0] = m[0][1];
+	tmp[1][1] = m[1][1];
+	return a3real2x2SetReal2x2(m_out, tmp);
+}
+
+A3_INLINE a3real2x2r a3real2x2GetInverse(a3real2x2p m_out, const a3real2x2p m)
+{
+	a3real2x2 tmp;
+	const a3real detInv = a3real2x2DeterminantInverse(m);
+	tmp[0][0] = m[1][1] * detInv;
+	tmp[0][1] = -m[0][1] * detInv;
+	tmp[1][0] = -m[1][0] * detInv;
+	tmp[1][1] = m[0][0] * detInv;
+	return a3real2x2SetReal2x2(m_out, tmp);
+}
+
+A3_INLINE a3real2x2r a3real2x2Negate(a3real2x2p m_inout)
+{
+	return a3real2x2GetNegative(m_inout, m_inout);
+}
+
+A3_INLINE a3real2x2r a3real2x2Transpose(a3real2x2p m_inout)
+{
+	return a3real2x2GetTransposed(m_inout, m_inout);
+}
+
+A3_INLINE a3real2x2r a3real2x2Invert(a3real2x2p m_inout)
+{
+	return a3real2x2GetInverse(m_inout, m_inout);
+}
+
+
+A3_INLINE a3real2x2r a3real2x2Sum(a3real2x2p m_out, const a3real2x2p mL, const a3real2x2p mR)
+{
+	a3real2Sum(m_out[0], mL[0], mR[0]);
+	a3real2Sum(m_out[1], mL[1], mR[1]);
+	return m_out;
+}
+
+A3_INLINE a3real2x2r a3real2x2Diff(a3real2x2p m_out, const a3real2x2p mL, const a3real2x2p mR)
+{
+	a3real2Diff(m_out[0], mL[0], mR[0]);
+	a3real2Diff(m_out[1], mL[1], mR[1]);
+	return m_out;
+}
+
+A3_INLINE a3real2x2r a3real2x2ProductS(a3real2x2p m_out, const a3real2x2p m, const a3real s)
+{
+	a3real2ProductS(m_out[0], m[0], s);
+	a3real2ProductS(m_out[1], m[1], s);
+	return m_out;
+}
+
+A3_INLINE a3real2x2r a3real2x2QuotientS(a3real2x2p m_out, const a3real2x2p m, const a3real s)
+{
+	const a3real sInv = a3real_one / s;
+	a3real2ProductS(m_out[0], m[0], sInv);
+	a3real2ProductS(m_out[1], m[1], sInv);
+	return m_out;
+}
+
+A3_INLINE a3real2x2r a3real2x2Add(a3real2x2p mL_inout, const a3real2x2p mR)
+{
+	a3real2Add(mL_inout[0], mR[0]);
+	a3real2Add(mL_inout[1], mR[1]);
+	return mL_inout;
+}
+
+A3_INLINE a3real2x2r a3real2x2Sub(a3real2x2p mL_inout, const a3real2x2p mR)
+{
+	a3real2Sub(mL_inout[0], mR[0]);
+	a3real2Sub(mL_inout[1], mR[1]);
+	return mL_inout;
+}
+
+A3_INLINE a3real2x2r a3real2x2MulS(a3real2x2p m_inout, const a3real s)
+{
+	a3real2MulS(m_inout[0], s);
+	a3real2MulS(m_inout[1], s);
+	return m_inout;
+}
+
+A3_INLINE a3real2x2r a3real2x2DivS(a3real2x2p m_inout, const a3real s)
+{
+	const a3real sInv = a3real_one / s;
+	a3real2MulS(m_inout[0], sInv);
+	a3real2MulS(m_inout[1], sInv);
+	return m_inout;
+}
+
+
+A3_INLINE a3real2r a3real2Real2x2ProductL(a3real2p v_out, const a3real2p v, const a3real2x2p m)
+{
+	a3real2 tmp;
+	tmp[0] = a3real2Dot(v, m[0]);
+	tmp[1] = a3real2Dot(v, m[1]);
+	return a3real2SetReal2(v_out, tmp);
+}
+
+A3_INLINE a3real2r a3real2Real2x2ProductR(a3real2p v_out, const a3real2x2p m, const a3real2p v)
+{
+	a3real2 tmp;
+	tmp[0] = m[0][0] * v[0] + m[1][0] * v[1];
+	tmp[1] = m[0][1] * v[0] + m[1][1] * v[1];
+	return a3real2SetReal2(v_out, tmp);
+}
+
+A3_INLINE a3real2r a3real2Real2x2MulL(a3real2p v_inout, const a3real2x2p m)
+{
+	return a3real2Real2x2ProductL(v_inout, v_inout, m);
+}
+
+A3_INLINE a3real2r a3real2Real2x2MulR(const a3real2x2p m, a3real2p v_inout)
+{
+	return a3real2Real2x2ProductR(v_inout, m, v_inout);
+}
+
+A3_INLINE a3real2x2r a3real2x2Product(a3real2x2p m_out, const a3real2x2p mL, const a3real2x2p mR)
+{
+	a3real2x2 tmp;
+	a3real2Real2x2ProductR(tmp[0], mL, mR[0]);
+	a3real2Real2x2ProductR(tmp[1], mL, mR[1]);
+	return a3real2x2SetReal2x2(m_out, tmp);
+}
+
+A3_INLINE a3real2x2r a3real2x2ConcatL(a3real2x2p mL_inout, const a3real2x2p mR)
+{
+	return a3real2x2Product(mL_inout, mL_inout, mR);
+}
+
+A3_INLINE a3real2x2r a3real2x2ConcatR(const a3real2x2p mL, a3real2x2p mR_inout)
+{
+	return a3real2x2Product(mR_inout, mL, mR_inout);
+}
+
+
+A3_INLINE a3real2x2r a3real2x2SetScale(a3real2x2p m_out, const a3real s)
+{
+	a3real2x2SetIdentity(m_out);
+	m_out[0][0] = s;
+	m_out[1][1] = s;
+	return m_out;
+}
+
+A3_INLINE a3real2x2r a3real2x2SetNonUnif(a3real2x2p m_out, const a3real sx, const a3real sy)
+{
+	a3real2x2SetIdentity(m_out);
+	m_out[0][0] = sx;
+	m_out[1][1] = sy;
+	return m_out;
+}
+
+A3_INLINE a3real2x2r a3real2x2SetRotate(a3real2x2p m_out, const a3real degrees)
+{
+	const a3real s = a3sind(degrees), c = a3cosd(degrees);
+	a3real2x2SetIdentity(m_out);
+	m_out[0][0] = c;
+	m_out[0][1] = s;
+	m_out[1][0] = -s;
+	m_out[1][1] = c;
+	return m_out;
+}
+
+
+//-----------------------------------------------------------------------------
+
+// constants are static per translation unit (declared extern otherwise)
+A3_GLOBAL const a3mat2 a3mat2_identity = { { a3real_one, a3real_zero, a3real_zero, a3real_one } };
+
+
+//-----------------------------------------------------------------------------
+
+
+A3_END_IMPL
+
+
+#endif	// !__ANIMAL3D_A3DM_MATRIX2_IMPL_INL
+#endif	// __ANIMAL3D_A3DM_MATRIX_H
@@ -0,0 +1,459 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	animal3D Math (A3DM) SDK
+	By Daniel S. Buckstein
+
+	a3matrix3_impl.inl
+	Implementations of 3D matrix functions.
+*/
+
+#ifdef __ANIMAL3D_A3DM_MATRIX_H
+#ifndef __ANIMAL3D_A3DM_MATRIX3_IMPL_INL
+#define __ANIMAL3D_A3DM_MATRIX3_IMPL_INL
+
+
+#include "../a3trig.h"
+
+
+A3_BEGIN_IMPL
+
+
+//-----------------------------------------------------------------------------
+
+A3_INLINE a3real3x3r a3real3x3SetIdentity(a3real3x3p m_out)
+{
+	m_out[0][0] = a3real_one;
+	m_out[0][1] = a3real_zero;
+	m_out[0][2] = a3real_zero;
+	m_out[1][0] = a3real_zero;
+	m_out[1][1] = a3real_one;
+	m_out[1][2] = a3real_zero;
+	m_out[2][0] = a3real_zero;
+	m_out[2][1] = a3real_zero;
+	m_out[2][2] = a3real_one;
+	return m_out;
+}
+
+A3_INLINE a3real3x3r a3real3x3Set(a3real3x3p m_out, const a3real x0, const a3real y0, const a3real z0, const a3real x1, const a3real y1, const a3real z1, const a3real x2, const a3real y2, const a3real z2)
+{
+	m_out[0][0] = x0;
+	m_out[0][1] = y0;
+	m_out[0][2] = z0;
+	m_out[1][0] = x1;
+	m_out[1][1] = y1;
+	m_out[1][2] = z1;
+	m_out[2][0] = x2;
+	m_out[2][1] = y2;
+	m_out[2][2] = z2;
+	return m_out;
+}
+
+A3_INLINE a3real3x3r a3real3x3SetMajors(a3real3x3p m_out, const a3real3p v0, const a3real3p v1, const a3real3p v2)
+{
+	m_out[0][0] = v0[0];
+	m_out[0][1] = v0[1];
+	m_out[0][2] = v0[2];
+	m_out[1][0] = v1[0];
+	m_out[1][1] = v1[1];
+	m_out[1][2] = v1[2];
+	m_out[2][0] = v2[0];
+	m_out[2][1] = v2[1];
+	m_out[2][2] = v2[2];
+	return m_out;
+}
+
+A3_INLINE a3real3x3r a3real3x3SetMinors(a3real3x3p m_out, const a3real3p v0, const a3real3p v1, const a3real3p v2)
+{
+	m_out[0][0] = v0[0];
+	m_out[0][1] = v1[0];
+	m_out[0][2] = v2[0];
+	m_out[1][0] = v0[1];
+	m_out[1][1] = v1[1];
+	m_out[1][2] = v2[1];
+	m_out[2][0] = v0[2];
+	m_out[2][1] = v1[2];
+	m_out[2][2] = v2[2];
+	return m_out;
+}
+
+A3_INLINE a3real3x3r a3real3x3SetReal2x2(a3real3x3p m_out, const a3real2x2p m)
+{
+	m_out[0][0] = m[0][0];
+	m_out[0][1] = m[0][1];
+	m_out[0][2] = a3real_zero;
+	m_out[1][0] = m[1][0];
+	m_out[1][1] = m[1][1];
+	m_out[1][2] = a3real_zero;
+	m_out[2][0] = a3real_zero;
+	m_out[2][1] = a3real_zero;
+	m_out[2][2] = a3real_one;
+	return m_out;
+}
+
+A3_INLINE a3real3x3r a3real3x3SetReal3x3(a3real3x3p m_out, const a3real3x3p m)
+{
+	m_out[0][0] = m[0][0];
+	m_out[0][1] = m[0][1];
+	m_out[0][2] = m[0][2];
+	m_out[1][0] = m[1][0];
+	m_out[1][1] = m[1][1];
+	m_out[1][2] = m[1][2];
+	m_out[2][0] = m[2][0];
+	m_out[2][1] = m[2][1];
+	m_out[2][2] = m[2][2];
+	return m_out;
+}
+
+A3_INLINE a3real3x3r a3real3x3SetReal4x4(a3real3x3p m_out, const a3real4x4p m)
+{
+	m_out[0][0] = m[0][0];
+	m_out[0][1] = m[0][1];
+	m_out[0][2] = m[0][2];
+	m_out[1][0] = m[1][0];
+	m_out[1][1] = m[1][1];
+	m_out[1][2] = m[1][2];
+	m_out[2][0] = m[2][0];
+	m_out[2][1] = m[2][1];
+	m_out[2][2] = m[2][2];
+	return m_out;
+}
+
+
+A3_INLINE a3real a3real3x3Determinant(const a3real3x3p m)
+{
+	a3real3 c;
+	return a3real3Dot(m[0], a3real3Cross(c, m[1], m[2]));
+}
+
+A3_INLINE a3real a3real3x3DeterminantInverse(const a3real3x3p m)
+{
+	return (a3real_one / a3real3x3Determinant(m));
+}
+
+A3_INLINE a3real3x3r a3real3x3GetNegative(a3real3x3p m_out, const a3real3x3p m)
+{
+	a3real3GetNegative(m_out[0], m[0]);
+	a3real3GetNegative(m_out[1], m[1]);
+	a3real3GetNegative(m_out[2], m[2]);
+	return m_out;
+}
+
+A3_INLINE a3real3x3r a3real3x3GetTransposed(a3real3x3p m_out, const a3real3x3p m)
+{
+	a3real3x3 tmp;
+	tmp[0][0] = m[0][0];
+	tmp[0][1] = m[1][0];
+	tmp[0][2] = m[2][0];
+	tmp[1][0] = m[0][1];
+	tmp[1][1] = m[1][1];
+	tmp[1][2] = m[2][1];
+	tmp[2][0] = m[0][2];
+	tmp[2][1] = m[1][2];
+	tmp[2][2] = m[2][2];
+	return a3real3x3SetReal3x3(m_out, tmp);
+}
+
+A3_INLINE a3real3x3r a3real3x3GetInverse(a3real3x3p m_out, const a3real3x3p m)
+{
+	a3real3x3 tmp;
+	a3real3 c0, c1, c2;
+	a3real detInv;
+	
+	// rows of inverse are cross products of columns
+	a3real3Cross(c0, m[1], m[2]);
+	a3real3Cross(c1, m[2], m[0]);
+	a3real3Cross(c2, m[0], m[1]);
+	detInv = a3real_one / a3real3Dot(m[0], c0);
+	tmp[0][0] = c0[0] * detInv;
+	tmp[0][1] = c1[0] * detInv;
+	tmp[0][2] = c2[0] * detInv;
+	tmp[1][0] = c0[1] * detInv;
+	tmp[1][1] = c1[1] * detInv;
+	tmp[1][2] = c2[1] * detInv;
+	tmp[2][0] = c0[2] * detInv;
+	tmp[2][1] = c1[2] * detInv;
+	tmp[2][2] = c2[2] * detInv;
+	return a3real3x3SetReal3x3(m_out, tmp);
+}
+
+A3_INLINE a3real3x3r a3real3x3Negate(a3real3x3p m_inout)
+{
+	return a3real3x3GetNegative(m_inout, m_inout);
+}
+
+A3_INLINE a3real3x3r a3real3x3Transpose(a3real3x3p m_inout)
+{
+	return a3real3x3GetTransposed(m_inout, m_inout);
+}
+
+A3_INLINE a3real3x3r a3real3x3Invert(a3real3x3p m_inout)
+{
+	return a3real3x3GetInverse(m_inout, m_inout);
+}
+
+
+A3_INLINE a3real3x3r a3real3x3Sum(a3real3x3p m_out, const a3real3x3p mL, const a3real3x3p mR)
+{
+	a3real3Sum(m_out[0], mL[0], mR[0]);
+	a3real3Sum(m_out[1], mL[1], mR[1]);
+	a3real3Sum(m_out[2], mL[2], mR[2]);
+	return m_out;
+}
+
+A3_INLINE a3real3x3r a3real3x3Diff(a3real3x3p m_out, const a3real3x3p mL, const a3real3x3p mR)
+{
+	a3real3Diff(m_out[0], mL[0], mR[0]);
+	a3real3Diff(m_out[1], mL[1], mR[1]);
+	a3real3Diff(m_out[2], mL[2], mR[2]);
+	return m_out;
+}
+
+A3_INLINE a3real3x3r a3real3x3ProductS(a3real3x3p m_out, const a3real3x3p m, const a3real s)
+{
+	a3real3ProductS(m_out[0], m[0], s);
+	a3real3ProductS(m_out[1], m[1], s);
+	a3real3ProductS(m_out[2], m[2], s);
+	return m_out;
+}
+
+A3_INLINE a3real3x3r a3real3x3QuotientS(a3real3x3p m_out, const a3real3x3p m, const a3real s)
+{
+	const a3real sInv = a3real_one / s;
+	a3real3ProductS(m_out[0], m[0], sInv);
+	a3real3ProductS(m_out[1], m[1], sInv);
+	a3real3ProductS(m_out[2], m[2], sInv);
+	return m_out;
+}
+
+A3_INLINE a3real3x3r a3real3x3Add(a3real3x3p mL_inout, const a3real3x3p mR)
+{
+	a3real3Add(mL_inout[0], mR[0]);
+	a3real3Add(mL_inout[1], mR[1]);
+	a3real3Add(mL_inout[2], mR[2]);
+	return mL_inout;
+}
+
+A3_INLINE a3real3x3r a3real3x3Sub(a3real3x3p mL_inout, const a3real3x3p mR)
+{
+	a3real3Sub(mL_inout[0], mR[0]);
+	a3real3Sub(mL_inout[1], mR[1]);
+	a3real3Sub(mL_inout[2], mR[2]);
+	return mL_inout;
+}
+
+A3_INLINE a3real3x3r a3real3x3MulS(a3real3x3p m_inout, const a3real s)
+{
+	a3real3MulS(m_inout[0], s);
+	a3real3MulS(m_inout[1], s);
+	a3real3MulS(m_inout[2], s);
+	return m_inout;
+}
+
+A3_INLINE a3real3x3r a3real3x3DivS(a3real3x3p m_inout, const a3real s)
+{
+	const a3real sInv = a3real_one / s;
+	a3real3MulS(m_inout[0], sInv);
+	a3real3MulS(m_inout[1], sInv);
+	a3real3MulS(m_inout[2], sInv);
+	return m_inout;
+}
+
+
+A3_INLINE a3real3r a3real3Real3x3ProductL(a3real3p v_out, const a3real3p v, const a3real3x3p m)
+{
+	a3real3 tmp;
+	tmp[0] = a3real3Dot(v, m[0]);
+	tmp[1] = a3real3Dot(v, m[1]);
+	tmp[2] = a3real3Dot(v, m[2]);
+	return a3real3SetReal3(v_out, tmp);
+}
+
+A3_INLINE a3real3r a3real3Real3x3ProductR(a3real3p v_out, const a3real3x3p m, const a3real3p v)
+{
+	a3real3 tmp;
+	tmp[0] = m[0][0] * v[0] + m[1][0] * v[1] + m[2][0] * v[2];
+	tmp[1] = m[0][1] * v[0] + m[1][1] * v[1] + m[2][1] * v[2];
+	tmp[2] = m[0][2] * v[0] + m[1][2] * v[1] + m[2][2] * v[2];
+	return a3real3SetReal3(v_out, tmp);
+}
+
+A3_INLINE a3real3r a3real3Real3x3MulL(a3real3p v_inout, const a3real3x3p m)
+{
+	return a3real3Real3x3ProductL(v_inout, v_inout, m);
+}
+
+A3_INLINE a3real3r a3real3Real3x3MulR(const a3real3x3p m, a3real3p v_inout)
+{
+	return a3real3Real3x3ProductR(v_inout, m, v_inout);
+}
+
+A3_INLINE a3real3x3r a3real3x3Product(a3real3x3p m_out, const a3real3x3p mL, const a3real3x3p mR)
+{
+	a3real3x3 tmp;
+	a3real3Real3x3ProductR(tmp[0], mL, mR[0]);
+	a3real3Real3x3ProductR(tmp[1], mL, mR[1]);
+	a3real3Real3x3ProductR(tmp[2], mL, mR[2]);
+	return a3real3x3SetReal3x3(m_out, tmp);
+}
+
+A3_INLINE a3real3x3r a3real3x3ConcatL(a3real3x3p mL_inout, const a3real3x3p mR)
+{
+	return a3real3x3Product(mL_inout, mL_inout, mR);
+}
+
+A3_INLINE a3real3x3r a3real3x3ConcatR(const a3real3x3p mL, a3real3x3p mR_inout)
+{
+	return a3real3x3Product(mR_inout, mL, mR_inout);
+}
+
+
+A3_INLINE a3real3x3r a3real3x3SetScale(a3real3x3p m_out, const a3real s)
+{
+	a3real3x3SetIdentity(m_out);
+	m_out[0][0] = s;
+	m_out[1][1] = s;
+	m_out[2][2] = s;
+	return m_out;
+}
+
+A3_INLINE a3real3x3r a3real3x3SetNonUnif(a3real3x3p m_out, const a3real sx, const a3real sy, const a3real sz)
+{
+	a3real3x3SetIdentity(m_out);
+	m_out[0][0] = sx;
+	m_out[1][1] = sy;
+	m_out[2][2] = sz;
+	return m_out;
+}
+
+A3_INLINE a3real3x3r a3real3x3SetRotateX(a3real3x3p m_out, const a3real degrees)
+{
+	const a3real s = a3sind(degrees), c = a3cosd(degrees);
+	a3real3x3SetIdentity(m_out);
+	m_out[1][1] = c;
+	m_out[1][2] = s;
+	m_out[2][1] = -s;
+	m_out[2][2] = c;
+	return m_out;
+}
+
+A3_INLINE a3real3x3r a3real3x3SetRotateY(a3real3x3p m_out, const a3real degrees)
+{
+	const a3real s = a3sind(degrees), c = a3cosd(degrees);
+	a3real3x3SetIdentity(m_out);
+	m_out[2][2] = c;
+	m_out[2][0] = s;
+	m_out[0][2] = -s;
+	m_out[0][0] = c;
+	return m_out;
+}
+
+A3_INLINE a3real3x3r a3real3x3SetRotateZ(a3real3x3p m_out, const a3real degrees)
+{
+	const a3real s = a3sind(degrees), c = a3cosd(degrees);
+	a3real3x3SetIdentity(m_out);
+	m_out[0][0] = c;
+	m_out[0][1] = s;
+	m_out[1][0] = -s;
+	m_out[1][1] = c;
+	return m_out;
+}
+
+A3_INLINE a3real3x3r a3real3x3SetRotateXYZ(a3real3x3p m_out, const a3real degrees_x, const a3real degrees_y, const a3real degrees_z)
+{
+	const a3real sx = a3sind(degrees_x), cx = a3cosd(degrees_x);
+	const a3real sy = a3sind(degrees_y), cy = a3cosd(degrees_y);
+	const a3real sz = a3sind(degrees_z), cz = a3cosd(degrees_z);
+	m_out[0][0] = cy * cz;
+	m_out[0][1] = cx * sz + sx * sy * cz;
+	m_out[0][2] = sx * sz - cx * sy * cz;
+	m_out[1][0] = -cy * sz;
+	m_out[1][1] = cx * cz - sx * sy * sz;
+	m_out[1][2] = sx * cz + cx * sy * sz;
+	m_out[2][0] = sy;
+	m_out[2][1] = -sx * cy;
+	m_out[2][2] = cx * cy;
+	return m_out;
+}
+
+A3_INLINE a3real3x3r a3real3x3SetRotateZYX(a3real3x3p m_out, const a3real degrees_x, const a3real degrees_y, const a3real degrees_z)
+{
+	const a3real sx = a3sind(degrees_x), cx = a3cosd(degrees_x);
+	const a3real sy = a3sind(degrees_y), cy = a3cosd(degrees_y);
+	const a3real sz = a3sind(degrees_z), cz = a3cosd(degrees_z);
+	m_out[0][0] = cz * cy;
+	m_out[0][1] = sz * cy;
+	m_out[0][2] = -sy;
+	m_out[1][0] = cz * sy * sx - sz * cx;
+	m_out[1][1] = cz * cx + sz * sy * sx;
+	m_out[1][2] = cy * sx;
+	m_out[2][0] = sz * sx + cz * sy * cx;
+	m_out[2][1] = sz * sy * cx - cz * sx;
+	m_out[2][2] = cy * cx;
+	return m_out;
+}
+
+A3_INLINE a3real3x3rk a3real3x3GetEulerXYZIgnoreScale(const a3real3x3p m, a3real *degrees_x_out, a3real *degrees_y_out, a3real *degrees_z_out)
+{
+	*degrees_x_out = a3atan2d(-m[2][1], m[2][2]);
+	*degrees_y_out = a3asind(m[2][0]);
+	*degrees_z_out = a3atan2d(-m[1][0], m[0][0]);
+	return m;
+}
+
+A3_INLINE a3real3x3rk a3real3x3GetEulerZYXIgnoreScale(const a3real3x3p m, a3real *degrees_x_out, a3real *degrees_y_out, a3real *degrees_z_out)
+{
+	*degrees_x_out = a3atan2d(m[1][2], m[2][2]);
+	*degrees_y_out = a3asind(-m[0][2]);
+	*degrees_z_out = a3atan2d(m[0][1], m[0][0]);
+	return m;
+}
+
+
+
+//-----------------------------------------------------------------------------
+
+A3_INLINE a3real3x3r a3real3x3MakeLookAt(a3real3x3p m_out, a3real3x3p mInv_out_opt, const a3real3p eyePos, const a3real3p targetPos, const a3real3p worldUpVec)
+{
+	a3real3 x, y, z;
+	
+	// camera looks down its own negative Z axis
+	a3real3Normalize(a3real3Diff(z, eyePos, targetPos));
+	a3real3CrossUnit(x, worldUpVec, z);
+	a3real3Cross(y, z, x);
+	a3real3x3SetMajors(m_out, x, y, z);
+	if (mInv_out_opt)
+		a3real3x3SetMinors(mInv_out_opt, x, y, z);
+	return m_out;
+}
+
+
+//-----------------------------------------------------------------------------
+
+// constants are static per translation unit (declared extern otherwise)
+A3_GLOBAL const a3mat3 a3mat3_identity = { { a3real_one, a3real_zero, a3real_zero A3PAD0, a3real_zero, a3real_one, a3real_zero A3PAD0, a3real_zero, a3real_zero, a3real_one A3PAD0 } };
+
+
+//-----------------------------------------------------------------------------
+
+
+A3_END_IMPL
+
+
+#endif	// !__ANIMAL3D_A3DM_MATRIX3_IMPL_INL
+#endif	// __ANIMAL3D_A3DM_MATRIX_H
@@ -0,0 +1,888 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	animal3D Math (A3DM) SDK
+	By Daniel S. Buckstein
+
+	a3matrix4_impl.inl
+	Implementations of 4D matrix functions.
+*/
+
+#ifdef __ANIMAL3D_A3DM_MATRIX_H
+#ifndef __ANIMAL3D_A3DM_MATRIX4_IMPL_INL
+#define __ANIMAL3D_A3DM_MATRIX4_IMPL_INL
+
+
+#include "../a3trig.h"
+
+
+A3_BEGIN_IMPL
+
+
+//-----------------------------------------------------------------------------
+
+A3_INLINE a3real4x4r a3real4x4SetIdentity(a3real4x4p m_out)
+{
+	m_out[0][0] = a3real_one;
+	m_out[0][1] = a3real_zero;
+	m_out[0][2] = a3real_zero;
+	m_out[0][3] = a3real_zero;
+	m_out[1][0] = a3real_zero;
+	m_out[1][1] = a3real_one;
+	m_out[1][2] = a3real_zero;
+	m_out[1][3] = a3real_zero;
+	m_out[2][0] = a3real_zero;
+	m_out[2][1] = a3real_zero;
+	m_out[2][2] = a3real_one;
+	m_out[2][3] = a3real_zero;
+	m_out[3][0] = a3real_zero;
+	m_out[3][1] = a3real_zero;
+	m_out[3][2] = a3real_zero;
+	m_out[3][3] = a3real_one;
+	return m_out;
+}
+
+A3_INLINE a3real4x4r a3real4x4Set(a3real4x4p m_out, const a3real x0, const a3real y0, const a3real z0, const a3real w0, const a3real x1, const a3real y1, const a3real z1, const a3real w1, const a3real x2, const a3real y2, const a3real z2, const a3real w2, const a3real x3, const a3real y3, const a3real z3, const a3real w3)
+{
+	m_out[0][0] = x0;
+	m_out[0][1] = y0;
+	m_out[0][2] = z0;
+	m_out[0][3] = w0;
+	m_out[1][0] = x1;
+	m_out[1][1] = y1;
+	m_out[1][2] = z1;
+	m_out[1][3] = w1;
+	m_out[2][0] = x2;
+	m_out[2][1] = y2;
+	m_out[2][2] = z2;
+	m_out[2][3] = w2;
+	m_out[3][0] = x3;
+	m_out[3][1] = y3;
+	m_out[3][2] = z3;
+	m_out[3][3] = w3;
+	return m_out;
+}
+
+A3_INLINE a3real4x4r a3real4x4SetMajors(a3real4x4p m_out, const a3real4p v0, const a3real4p v1, const a3real4p v2, const a3real4p v3)
+{
+	m_out[0][0] = v0[0];
+	m_out[0][1] = v0[1];
+	m_out[0][2] = v0[2];
+	m_out[0][3] = v0[3];
+	m_out[1][0] = v1[0];
+	m_out[1][1] = v1[1];
+	m_out[1][2] = v1[2];
+	m_out[1][3] = v1[3];
+	m_out[2][0] = v2[0];
+	m_out[2][1] = v2[1];
+	m_out[2][2] = v2[2];
+	m_out[2][3] = v2[3];
+	m_out[3][0] = v3[0];
+	m_out[3][1] = v3[1];
+	m_out[3][2] = v3[2];
+	m_out[3][3] = v3[3];
+	return m_out;
+}
+
+A3_INLINE a3real4x4r a3real4x4SetMinors(a3real4x4p m_out, const a3real4p v0, const a3real4p v1, const a3real4p v2, const a3real4p v3)
+{
+	m_out[0][0] = v0[0];
+	m_out[0][1] = v1[0];
+	m_out[0][2] = v2[0];
+	m_out[0][3] = v3[0];
+	m_out[1][0] = v0[1];
+	m_out[1][1] = v1[1];
+	m_out[1][2] = v2[1];
+	m_out[1][3] = v3[1];
+	m_out[2][0] = v0[2];
+	m_out[2][1] = v1[2];
+	m_out[2][2] = v2[2];
+	m_out[2][3] = v3[2];
+	m_out[3][0] = v0[3];
+	m_out[3][1] = v1[3];
+	m_out[3][2] = v2[3];
+	m_out[3][3] = v3[3];
+	return m_out;
+}
+
+A3_INLINE a3real4x4r a3real4x4SetReal2x2(a3real4x4p m_out, const a3real2x2p m)
+{
+	m_out[0][0] = m[0][0];
+	m_out[0][1] = m[0][1];
+	m_out[0][2] = a3real_zero;
+	m_out[0][3] = a3real_zero;
+	m_out[1][0] = m[1][0];
+	m_out[1][1] = m[1][1];
+	m_out[1][2] = a3real_zero;
+	m_out[1][3] = a3real_zero;
+	m_out[2][0] = a3real_zero;
+	m_out[2][1] = a3real_zero;
+	m_out[2][2] = a3real_one;
+	m_out[2][3] = a3real_zero;
+	m_out[3][0] = a3real_zero;
+	m_out[3][1] = a3real_zero;
+	m_out[3][2] = a3real_zero;
+	m_out[3][3] = a3real_one;
+	return m_out;
+}
+
+A3_INLINE a3real4x4r a3real4x4SetReal3x3(a3real4x4p m_out, const a3real3x3p m)
+{
+	m_out[0][0] = m[0][0];
+	m_out[0][1] = m[0][1];
+	m_out[0][2] = m[0][2];
+	m_out[0][3] = a3real_zero;
+	m_out[1][0] = m[1][0];
+	m_out[1][1] = m[1][1];
+	m_out[1][2] = m[1][2];
+	m_out[1][3] = a3real_zero;
+	m_out[2][0] = m[2][0];
+	m_out[2][1] = m[2][1];
+	m_out[2][2] = m[2][2];
+	m_out[2][3] = a3real_zero;
+	m_out[3][0] = a3real_zero;
+	m_out[3][1] = a3real_zero;
+	m_out[3][2] = a3real_zero;
+	m_out[3][3] = a3real_one;
+	return m_out;
+}
+
+A3_INLINE a3real4x4r a3real4x4SetReal4x4(a3real4x4p m_out, const a3real4x4p m)
+{
+	m_out[0][0] = m[0][0];
+	m_out[0][1] = m[0][1];
+	m_out[0][2] = m[0][2];
+	m_out[0][3] = m[0][3];
+	m_out[1][0] = m[1][0];
+	m_out[1][1] = m[1][1];
+	m_out[1][2] = m[1][2];
+	m_out[1][3] = m[1][3];
+	m_out[2][0] = m[2][0];
+	m_out[2][1] = m[2][1];
+	m_out[2][2] = m[2][2];
+	m_out[2][3] = m[2][3];
+	m_out[3][0] = m[3][0];
+	m_out[3][1] = m[3][1];
+	m_out[3][2] = m[3][2];
+	m_out[3][3] = m[3][3];
+	return m_out;
+}
+
+
+A3_INLINE a3real a3real4x4Determinant(const a3real4x4p m)
+{
+	const a3real s0 = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+	const a3real s1 = m[0][0] * m[1][2] - m[1][0] * m[0][2];
+	const a3real s2 = m[0][0] * m[1][3] - m[1][0] * m[0][3];
+	const a3real s3 = m[0][1] * m[1][2] - m[1][1] * m[0][2];
+	const a3real s4 = m[0][1] * m[1][3] - m[1][1] * m[0][3];
+	const a3real s5 = m[0][2] * m[1][3] - m[1][2] * m[0][3];
+	const a3real c0 = m[2][0] * m[3][1] - m[3][0] * m[2][1];
+	const a3real c1 = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+	const a3real c2 = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+	const a3real c3 = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+	const a3real c4 = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+	const a3real c5 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+	return (s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0);
+}
+
+A3_INLINE a3real a3real4x4DeterminantInverse(const a3real4x4p m)
+{
+	return (a3real_one / a3real4x4Determinant(m));
+}
+
+A3_INLINE a3real4x4r a3real4x4GetNegative(a3real4x4p m_out, const a3real4x4p m)
+{
+	a3real4GetNegative(m_out[0], m[0]);
+	a3real4GetNegative(m_out[1], m[1]);
+	a3real4GetNegative(m_out[2], m[2]);
+	a3real4GetNegative(m_out[3], m[3]);
+	return m_out;
+}
+
+A3_INLINE a3real4x4r a3real4x4GetTransposed(a3real4x4p m_out, const a3real4x4p m)
+{
+	a3real4x4 tmp;
+	tmp[0][0] = m[0][0];
+	tmp[0][1] = m[1][0];
+	tmp[0][2] = m[2][0];
+	tmp[0][3] = m[3][0];
+	tmp[1][0] = m[0][1];
+	tmp[1][1] = m[1][1];
+	tmp[1][2] = m[2][1];
+	tmp[1][3] = m[3][1];
+	tmp[2][0] = m[0][2];
+	tmp[2][1] = m[1][2];
+	tmp[2][2] = m[2][2];
+	tmp[2][3] = m[3][2];
+	tmp[3][0] = m[0][3];
+	tmp[3][1] = m[1][3];
+	tmp[3][2] = m[2][3];
+	tmp[3][3] = m[3][3];
+	return a3real4x4SetReal4x4(m_out, tmp);
+}
+
+A3_INLINE a3real4x4r a3real4x4GetInverse(a3real4x4p m_out, const a3real4x4p m)
+{
+	a3real4x4 tmp;
+	const a3real s0 = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+	const a3real s1 = m[0][0] * m[1][2] - m[1][0] * m[0][2];
+	const a3real s2 = m[0][0] * m[1][3] - m[1][0] * m[0][3];
+	const a3real s3 = m[0][1] * m[1][2] - m[1][1] * m[0][2];
+	const a3real s4 = m[0][1] * m[1][3] - m[1][1] * m[0][3];
+	const a3real s5 = m[0][2] * m[1][3] - m[1][2] * m[0][3];
+	const a3real c0 = m[2][0] * m[3][1] - m[3][0] * m[2][1];
+	const a3real c1 = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+	const a3real c2 = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+	const a3real c3 = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+	const a3real c4 = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+	const a3real c5 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+	const a3real detInv = a3real_one / (s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0);
+	
+	// adjugate from 2x2 sub-determinants of upper and lower halves
+	tmp[0][0] = (m[1][1] * c5 - m[1][2] * c4 + m[1][3] * c3) * detInv;
+	tmp[0][1] = (-m[0][1] * c5 + m[0][2] * c4 - m[0][3] * c3) * detInv;
+	tmp[0][2] = (m[3][1] * s5 - m[3][2] * s4 + m[3][3] * s3) * detInv;
+	tmp[0][3] = (-m[2][1] * s5 + m[2][2] * s4 - m[2][3] * s3) * detInv;
+	tmp[1][0] = (-m[1][0] * c5 + m[1][2] * c2 - m[1][3] * c1) * detInv;
+	tmp[1][1] = (m[0][0] * c5 - m[0][2] * c2 + m[0][3] * c1) * detInv;
+	tmp[1][2] = (-m[3][0] * s5 + m[3][2] * s2 - m[3][3] * s1) * detInv;
+	tmp[1][3] = (m[2][0] * s5 - m[2][2] * s2 + m[2][3] * s1) * detInv;
+	tmp[2][0] = (m[1][0] * c4 - m[1][1] * c2 + m[1][3] * c0) * detInv;
+	tmp[2][1] = (-m[0][0] * c4 + m[0][1] * c2 - m[0][3] * c0) * detInv;
+	tmp[2][2] = (m[3][0] * s4 - m[3][1] * s2 + m[3][3] * s0) * detInv;
+	tmp[2][3] = (-m[2][0] * s4 + m[2][1] * s2 - m[2][3] * s0) * detInv;
+	tmp[3][0] = (-m[1][0] * c3 + m[1][1] * c1 - m[1][2] * c0) * detInv;
+	tmp[3][1] = (m[0][0] * c3 - m[0][1] * c1 + m[0][2] * c0) * detInv;
+	tmp[3][2] = (-m[3][0] * s3 + m[3][1] * s1 - m[3][2] * s0) * detInv;
+	tmp[3][3] = (m[2][0] * s3 - m[2][1] * s1 + m[2][2] * s0) * detInv;
+	return a3real4x4SetReal4x4(m_out, tmp);
+}
+
+A3_INLINE a3real4x4r a3real4x4Negate(a3real4x4p m_inout)
+{
+	return a3real4x4GetNegative(m_inout, m_inout);
+}
+
+A3_INLINE a3real4x4r a3real4x4Transpose(a3real4x4p m_inout)
+{
+	return a3real4x4GetTransposed(m_inout, m_inout);
+}
+
+A3_INLINE a3real4x4r a3real4x4Invert(a3real4x4p m_inout)
+{
+	return a3real4x4GetInverse(m_inout, m_inout);
+}
+
+
+A3_INLINE a3real4x4r a3real4x4Sum(a3real4x4p m_out, const a3real4x4p mL, const a3real4x4p mR)
+{
+	a3real4Sum(m_out[0], mL[0], mR[0]);
+	a3real4Sum(m_out[1], mL[1], mR[1]);
+	a3real4Sum(m_out[2], mL[2], mR[2]);
+	a3real4Sum(m_out[3], mL[3], mR[3]);
+	return m_out;
+}
+
+A3_INLINE a3real4x4r a3real4x4Diff(a3real4x4p m_out, const a3real4x4p mL, const a3real4x4p mR)
+{
+	a3real4Diff(m_out[0], mL[0], mR[0]);
+	a3real4Diff(m_out[1], mL[1], mR[1]);
+	a3real4Diff(m_out[2], mL[2], mR[2]);
+	a3real4Diff(m_out[3], mL[3], mR[3]);
+	return m_out;
+}
+
+A3_INLINE a3real4x4r a3real4x4ProductS(a3real4x4p m_out, const a3real4x4p m, const a3real s)
+{
+	a3real4ProductS(m_out[0], m[0], s);
+	a3real4ProductS(m_out[1], m[1], s);
+	a3real4ProductS(m_out[2], m[2], s);
+	a3real4ProductS(m_out[3], m[3], s);
+	return m_out;
+}
+
+A3_INLINE a3real4x4r a3real4x4QuotientS(a3real4x4p m_out, const a3real4x4p m, const a3real s)
+{
+	const a3real sInv = a3real_one / s;
+	a3real4ProductS(m_out[0], m[0], sInv);
+	a3real4ProductS(m_out[1], m[1], sInv);
+	a3real4ProductS(m_out[2], m[2], sInv);
+	a3real4ProductS(m_out[3], m[3], sInv);
+	return m_out;
+}
+
+A3_INLINE a3real4x4r a3real4x4Add(a3real4x4p mL_inout, const a3real4x4p mR)
+{
+	a3real4Add(mL_inout[0], mR[0]);
+	a3real4Add(mL_inout[1], mR[1]);
+	a3real4Add(mL_inout[2], mR[2]);
+	a3real4Add(mL_inout[3], mR[3]);
+	return mL_inout;
+}
+
+A3_INLINE a3real4x4r a3real4x4Sub(a3real4x4p mL_inout, const a3real4x4p mR)
+{
+	a3real4Sub(mL_inout[0], mR[0]);
+	a3real4Sub(mL_inout[1], mR[1]);
+	a3real4Sub(mL_inout[2], mR[2]);
+	a3real4Sub(mL_inout[3], mR[3]);
+	return mL_inout;
+}
+
+A3_INLINE a3real4x4r a3real4x4MulS(a3real4x4p m_inout, const a3real s)
+{
+	a3real4MulS(m_inout[0], s);
+	a3real4MulS(m_inout[1], s);
+	a3real4MulS(m_inout[2], s);
+	a3real4MulS(m_inout[3], s);
+	return m_inout;
+}
+
+A3_INLINE a3real4x4r a3real4x4DivS(a3real4x4p m_inout, const a3real s)
+{
+	const a3real sInv = a3real_one / s;
+	a3real4MulS(m_inout[0], sInv);
+	a3real4MulS(m_inout[1], sInv);
+	a3real4MulS(m_inout[2], sInv);
+	a3real4MulS(m_inout[3], sInv);
+	return m_inout;
+}
+
+
+A3_INLINE a3real4r a3real4Real4x4ProductL(a3real4p v_out, const a3real4p v, const a3real4x4p m)
+{
+	a3real4 tmp;
+	tmp[0] = a3real4Dot(v, m[0]);
+	tmp[1] = a3real4Dot(v, m[1]);
+	tmp[2] = a3real4Dot(v, m[2]);
+	tmp[3] = a3real4Dot(v, m[3]);
+	return a3real4SetReal4(v_out, tmp);
+}
+
+A3_INLINE a3real4r a3real4Real4x4ProductR(a3real4p v_out, const a3real4x4p m, const a3real4p v)
+{
+	a3real4 tmp;
+	tmp[0] = m[0][0] * v[0] + m[1][0] * v[1] + m[2][0] * v[2] + m[3][0] * v[3];
+	tmp[1] = m[0][1] * v[0] + m[1][1] * v[1] + m[2][1] * v[2] + m[3][1] * v[3];
+	tmp[2] = m[0][2] * v[0] + m[1][2] * v[1] + m[2][2] * v[2] + m[3][2] * v[3];
+	tmp[3] = m[0][3] * v[0] + m[1][3] * v[1] + m[2][3] * v[2] + m[3][3] * v[3];
+	return a3real4SetReal4(v_out, tmp);
+}
+
+A3_INLINE a3real4r a3real4Real4x4MulL(a3real4p v_inout, const a3real4x4p m)
+{
+	return a3real4Real4x4ProductL(v_inout, v_inout, m);
+}
+
+A3_INLINE a3real4r a3real4Real4x4MulR(const a3real4x4p m, a3real4p v_inout)
+{
+	return a3real4Real4x4ProductR(v_inout, m, v_inout);
+}
+
+A3_INLINE a3real4x4r a3real4x4Product(a3real4x4p m_out, const a3real4x4p mL, const a3real4x4p mR)
+{
+	a3real4x4 tmp;
+	a3real4Real4x4ProductR(tmp[0], mL, mR[0]);
+	a3real4Real4x4ProductR(tmp[1], mL, mR[1]);
+	a3real4Real4x4ProductR(tmp[2], mL, mR[2]);
+	a3real4Real4x4ProductR(tmp[3], mL, mR[3]);
+	return a3real4x4SetReal4x4(m_out, tmp);
+}
+
+A3_INLINE a3real4x4r a3real4x4ConcatL(a3real4x4p mL_inout, const a3real4x4p mR)
+{
+	return a3real4x4Product(mL_inout, mL_inout, mR);
+}
+
+A3_INLINE a3real4x4r a3real4x4ConcatR(const a3real4x4p mL, a3real4x4p mR_inout)
+{
+	return a3real4x4Product(mR_inout, mL, mR_inout);
+}
+
+
+A3_INLINE a3real4x4r a3real4x4SetScale(a3real4x4p m_out, const a3real s)
+{
+	a3real4x4SetIdentity(m_out);
+	m_out[0][0] = s;
+	m_out[1][1] = s;
+	m_out[2][2] = s;
+	return m_out;
+}
+
+A3_INLINE a3real4x4r a3real4x4SetNonUnif(a3real4x4p m_out, const a3real sx, const a3real sy, const a3real sz)
+{
+	a3real4x4SetIdentity(m_out);
+	m_out[0][0] = sx;
+	m_out[1][1] = sy;
+	m_out[2][2] = sz;
+	return m_out;
+}
+
+A3_INLINE a3real4x4r a3real4x4SetRotateX(a3real4x4p m_out, const a3real degrees)
+{
+	const a3real s = a3sind(degrees), c = a3cosd(degrees);
+	a3real4x4SetIdentity(m_out);
+	m_out[1][1] = c;
+	m_out[1][2] = s;
+	m_out[2][1] = -s;
+	m_out[2][2] = c;
+	return m_out;
+}
+
+A3_INLINE a3real4x4r a3real4x4SetRotateY(a3real4x4p m_out, const a3real degrees)
+{
+	const a3real s = a3sind(degrees), c = a3cosd(degrees);
+	a3real4x4SetIdentity(m_out);
+	m_out[2][2] = c;
+	m_out[2][0] = s;
+	m_out[0][2] = -s;
+	m_out[0][0] = c;
+	return m_out;
+}
+
+A3_INLINE a3real4x4r a3real4x4SetRotateZ(a3real4x4p m_out, const a3real degrees)
+{
+	const a3real s = a3sind(degrees), c = a3cosd(degrees);
+	a3real4x4SetIdentity(m_out);
+	m_out[0][0] = c;
+	m_out[0][1] = s;
+	m_out[1][0] = -s;
+	m_out[1][1] = c;
+	return m_out;
+}
+
+A3_INLINE a3real4x4r a3real4x4SetRotateXYZ(a3real4x4p m_out, const a3real degrees_x, const a3real degrees_y, const a3real degrees_z)
+{
+	const a3real sx = a3sind(degrees_x), cx = a3cosd(degrees_x);
+	const a3real sy = a3sind(degrees_y), cy = a3cosd(degrees_y);
+	const a3real sz = a3sind(degrees_z), cz = a3cosd(degrees_z);
+	a3real4x4SetIdentity(m_out);
+	m_out[0][0] = cy * cz;
+	m_out[0][1] = cx * sz + sx * sy * cz;
+	m_out[0][2] = sx * sz - cx * sy * cz;
+	m_out[1][0] = -cy * sz;
+	m_out[1][1] = cx * cz - sx * sy * sz;
+	m_out[1][2] = sx * cz + cx * sy * sz;
+	m_out[2][0] = sy;
+	m_out[2][1] = -sx * cy;
+	m_out[2][2] = cx * cy;
+	return m_out;
+}
+
+A3_INLINE a3real4x4r a3real4x4SetRotateZYX(a3real4x4p m_out, const a3real degrees_x, const a3real degrees_y, const a3real degrees_z)
+{
+	const a3real sx = a3sind(degrees_x), cx = a3cosd(degrees_x);
+	const a3real sy = a3sind(degrees_y), cy = a3cosd(degrees_y);
+	const a3real sz = a3sind(degrees_z), cz = a3cosd(degrees_z);
+	a3real4x4SetIdentity(m_out);
+	m_out[0][0] = cz * cy;
+	m_out[0][1] = sz * cy;
+	m_out[0][2] = -sy;
+	m_out[1][0] = cz * sy * sx - sz * cx;
+	m_out[1][1] = cz * cx + sz * sy * sx;
+	m_out[1][2] = cy * sx;
+	m_out[2][0] = sz * sx + cz * sy * cx;
+	m_out[2][1] = sz * sy * cx - cz * sx;
+	m_out[2][2] = cy * cx;
+	return m_out;
+}
+
+A3_INLINE a3real4x4rk a3real4x4GetEulerXYZIgnoreScale(const a3real4x4p m, a3real *degrees_x_out, a3real *degrees_y_out, a3real *degrees_z_out)
+{
+	*degrees_x_out = a3atan2d(-m[2][1], m[2][2]);
+	*degrees_y_out = a3asind(m[2][0]);
+	*degrees_z_out = a3atan2d(-m[1][0], m[0][0]);
+	return m;
+}
+
+A3_INLINE a3real4x4rk a3real4x4GetEulerZYXIgnoreScale(const a3real4x4p m, a3real *degrees_x_out, a3real *degrees_y_out, a3real *degrees_z_out)
+{
+	*degrees_x_out = a3atan2d(m[1][2], m[2][2]);
+	*degrees_y_out = a3asind(-m[0][2]);
+	*degrees_z_out = a3atan2d(m[0][1], m[0][0]);
+	return m;
+}
+
+A3_INLINE a3real4x4rk a3real4x4GetEulerXYZTranslateIgnoreScale(const a3real4x4p m, a3real *degrees_x_out, a3real *degrees_y_out, a3real *degrees_z_out, a3real3p translate_out)
+{
+	*degrees_x_out = a3atan2d(-m[2][1], m[2][2]);
+	*degrees_y_out = a3asind(m[2][0]);
+	*degrees_z_out = a3atan2d(-m[1][0], m[0][0]);
+	a3real3SetReal4(translate_out, m[3]);
+	return m;
+}
+
+A3_INLINE a3real4x4rk a3real4x4GetEulerZYXTranslateIgnoreScale(const a3real4x4p m, a3real *degrees_x_out, a3real *degrees_y_out, a3real *degrees_z_out, a3real3p translate_out)
+{
+	*degrees_x_out = a3atan2d(m[1][2], m[2][2]);
+	*degrees_y_out = a3asind(-m[0][2]);
+	*degrees_z_out = a3atan2d(m[0][1], m[0][0]);
+	a3real3SetReal4(translate_out, m[3]);
+	return m;
+}
+
+
+//-----------------------------------------------------------------------------
+
+A3_INLINE a3real4r a3real4ProductTransform(a3real4p v_out, const a3real4p v, const a3real4x4p m)
+{
+	a3real4 tmp;
+	tmp[0] = a3real4Dot(v, m[0]);
+	tmp[1] = a3real4Dot(v, m[1]);
+	tmp[2] = a3real4Dot(v, m[2]);
+	tmp[3] = v[3];
+	return a3real4SetReal4(v_out, tmp);
+}
+
+A3_INLINE a3real4r a3real4TransformProduct(a3real4p v_out, const a3real4x4p m, const a3real4p v)
+{
+	a3real4 tmp;
+	tmp[0] = m[0][0] * v[0] + m[1][0] * v[1] + m[2][0] * v[2] + m[3][0] * v[3];
+	tmp[1] = m[0][1] * v[0] + m[1][1] * v[1] + m[2][1] * v[2] + m[3][1] * v[3];
+	tmp[2] = m[0][2] * v[0] + m[1][2] * v[1] + m[2][2] * v[2] + m[3][2] * v[3];
+	tmp[3] = v[3];
+	return a3real4SetReal4(v_out, tmp);
+}
+
+A3_INLINE a3real4r a3real4MulTransform(a3real4p v_inout, const a3real4x4p m)
+{
+	return a3real4ProductTransform(v_inout, v_inout, m);
+}
+
+A3_INLINE a3real4r a3real4TransformMul(const a3real4x4p m, a3real4p v_inout)
+{
+	return a3real4TransformProduct(v_inout, m, v_inout);
+}
+
+A3_INLINE a3real4x4r a3real4x4ProductTransform(a3real4x4p m_out, const a3real4x4p mL, const a3real4x4p mR)
+{
+	a3real4x4 tmp;
+	a3real4TransformProduct(tmp[0], mL, mR[0]);
+	a3real4TransformProduct(tmp[1], mL, mR[1]);
+	a3real4TransformProduct(tmp[2], mL, mR[2]);
+	a3real4TransformProduct(tmp[3], mL, mR[3]);
+	return a3real4x4SetReal4x4(m_out, tmp);
+}
+
+A3_INLINE a3real4x4r a3real4x4MulTransform(a3real4x4p mL_inout, const a3real4x4p mR)
+{
+	return a3real4x4ProductTransform(mL_inout, mL_inout, mR);
+}
+
+A3_INLINE a3real4x4r a3real4x4TransformMul(const a3real4x4p mL, a3real4x4p mR_inout)
+{
+	return a3real4x4ProductTransform(mR_inout, mL, mR_inout);
+}
+
+
+A3_INLINE a3real4x4r a3real4x4TransformInverse(a3real4x4p m_out, const a3real4x4p m)
+{
+	a3real4x4 tmp;
+	const a3real s0 = a3real3LengthSquaredInverse(m[0]);
+	const a3real s1 = a3real3LengthSquaredInverse(m[1]);
+	const a3real s2 = a3real3LengthSquaredInverse(m[2]);
+	
+	// rotation part is transpose, scaled by inverse squared scale
+	tmp[0][0] = m[0][0] * s0;
+	tmp[0][1] = m[1][0] * s1;
+	tmp[0][2] = m[2][0] * s2;
+	tmp[1][0] = m[0][1] * s0;
+	tmp[1][1] = m[1][1] * s1;
+	tmp[1][2] = m[2][1] * s2;
+	tmp[2][0] = m[0][2] * s0;
+	tmp[2][1] = m[1][2] * s1;
+	tmp[2][2] = m[2][2] * s2;
+	tmp[0][3] = tmp[1][3] = tmp[2][3] = a3real_zero;
+	
+	// translation is negative rotated translation
+	tmp[3][0] = -(tmp[0][0] * m[3][0] + tmp[1][0] * m[3][1] + tmp[2][0] * m[3][2]);
+	tmp[3][1] = -(tmp[0][1] * m[3][0] + tmp[1][1] * m[3][1] + tmp[2][1] * m[3][2]);
+	tmp[3][2] = -(tmp[0][2] * m[3][0] + tmp[1][2] * m[3][1] + tmp[2][2] * m[3][2]);
+	tmp[3][3] = a3real_one;
+	return a3real4x4SetReal4x4(m_out, tmp);
+}
+
+A3_INLINE a3real4x4r a3real4x4TransformInverseIgnoreScale(a3real4x4p m_out, const a3real4x4p m)
+{
+	a3real4x4 tmp;
+	
+	// rotation part is transpose
+	tmp[0][0] = m[0][0];
+	tmp[0][1] = m[1][0];
+	tmp[0][2] = m[2][0];
+	tmp[1][0] = m[0][1];
+	tmp[1][1] = m[1][1];
+	tmp[1][2] = m[2][1];
+	tmp[2][0] = m[0][2];
+	tmp[2][1] = m[1][2];
+	tmp[2][2] = m[2][2];
+	tmp[0][3] = tmp[1][3] = tmp[2][3] = a3real_zero;
+	
+	// translation is negative rotated translation
+	tmp[3][0] = -(tmp[0][0] * m[3][0] + tmp[1][0] * m[3][1] + tmp[2][0] * m[3][2]);
+	tmp[3][1] = -(tmp[0][1] * m[3][0] + tmp[1][1] * m[3][1] + tmp[2][1] * m[3][2]);
+	tmp[3][2] = -(tmp[0][2] * m[3][0] + tmp[1][2] * m[3][1] + tmp[2][2] * m[3][2]);
+	tmp[3][3] = a3real_one;
+	return a3real4x4SetReal4x4(m_out, tmp);
+}
+
+A3_INLINE a3real4x4r a3real4x4TransformInverseUniformScale(a3real4x4p m_out, const a3real4x4p m)
+{
+	a3real4x4 tmp;
+	const a3real s0 = a3real3LengthSquaredInverse(m[0]);
+	
+	// rotation part is transpose, scaled by inverse squared scale
+	tmp[0][0] = m[0][0] * s0;
+	tmp[0][1] = m[1][0] * s0;
+	tmp[0][2] = m[2][0] * s0;
+	tmp[1][0] = m[0][1] * s0;
+	tmp[1][1] = m[1][1] * s0;
+	tmp[1][2] = m[2][1] * s0;
+	tmp[2][0] = m[0][2] * s0;
+	tmp[2][1] = m[1][2] * s0;
+	tmp[2][2] = m[2][2] * s0;
+	tmp[0][3] = tmp[1][3] = tmp[2][3] = a3real_zero;
+	
+	// translation is negative rotated translation
+	tmp[3][0] = -(tmp[0][0] * m[3][0] + tmp[1][0] * m[3][1] + tmp[2][0] * m[3][2]);
+	tmp[3][1] = -(tmp[0][1] * m[3][0] + tmp[1][1] * m[3][1] + tmp[2][1] * m[3][2]);
+	tmp[3][2] = -(tmp[0][2] * m[3][0] + tmp[1][2] * m[3][1] + tmp[2][2] * m[3][2]);
+	tmp[3][3] = a3real_one;
+	return a3real4x4SetReal4x4(m_out, tmp);
+}
+
+A3_INLINE a3real4x4r a3real4x4TransformInvert(a3real4x4p m_inout)
+{
+	return a3real4x4TransformInverse(m_inout, m_inout);
+}
+
+A3_INLINE a3real4x4r a3real4x4TransformInvertIgnoreScale(a3real4x4p m_inout)
+{
+	return a3real4x4TransformInverseIgnoreScale(m_inout, m_inout);
+}
+
+A3_INLINE a3real4x4r a3real4x4TransformInvertUniformScale(a3real4x4p m_inout)
+{
+	return a3real4x4TransformInverseUniformScale(m_inout, m_inout);
+}
+
+A3_INLINE a3real4x4r a3real4x4MakeLookAt(a3real4x4p m_out, a3real4x4p mInv_out_opt, const a3real3p eyePos, const a3real3p targetPos, const a3real3p worldUpVec)
+{
+	a3real3 x, y, z;
+	
+	// camera looks down its own negative Z axis
+	a3real3Normalize(a3real3Diff(z, eyePos, targetPos));
+	a3real3CrossUnit(x, worldUpVec, z);
+	a3real3Cross(y, z, x);
+	a3real4SetReal3W(m_out[0], x, a3real_zero);
+	a3real4SetReal3W(m_out[1], y, a3real_zero);
+	a3real4SetReal3W(m_out[2], z, a3real_zero);
+	a3real4SetReal3W(m_out[3], eyePos, a3real_one);
+	if (mInv_out_opt)
+		a3real4x4TransformInverseIgnoreScale(mInv_out_opt, m_out);
+	return m_out;
+}
+
+
+A3_INLINE a3real4x4r a3real4x4MakePerspectiveProjection(a3real4x4p m_out, a3real4x4p mInv_out_opt, const a3real fovyDegrees, const a3real aspect, const a3real nearDist, const a3real farDist)
+{
+	a3real4x4SetIdentity(m_out);
+	if (mInv_out_opt)
+		a3real4x4SetIdentity(mInv_out_opt);
+	if (fovyDegrees > a3real_zero && fovyDegrees < a3real_oneeighty && aspect != a3real_zero && nearDist > a3real_zero && farDist > nearDist)
+	{
+		const a3real nf = a3real_one / (nearDist - farDist);
+		m_out[1][1] = a3cotd(a3real_half * fovyDegrees);
+		m_out[0][0] = m_out[1][1] / aspect;
+		m_out[2][2] = (nearDist + farDist) * nf;
+		m_out[2][3] = -a3real_one;
+		m_out[3][2] = a3real_two * nearDist * farDist * nf;
+		m_out[3][3] = a3real_zero;
+		if (mInv_out_opt)
+		{
+			const a3real q = a3real_half / (nearDist * farDist);
+			mInv_out_opt[1][1] = a3real_one / m_out[1][1];
+			mInv_out_opt[0][0] = mInv_out_opt[1][1] * aspect;
+			mInv_out_opt[2][2] = a3real_zero;
+			mInv_out_opt[2][3] = (nearDist - farDist) * q;
+			mInv_out_opt[3][2] = -a3real_one;
+			mInv_out_opt[3][3] = (nearDist + farDist) * q;
+		}
+	}
+	return m_out;
+}
+
+A3_INLINE a3real4x4r a3real4x4MakePerspectiveProjectionPlanes(a3real4x4p m_out, a3real4x4p mInv_out_opt, const a3real rightDist, const a3real leftDist, const a3real topDist, const a3real bottomDist, const a3real nearDist, const a3real farDist)
+{
+	a3real4x4SetIdentity(m_out);
+	if (mInv_out_opt)
+		a3real4x4SetIdentity(mInv_out_opt);
+	if (rightDist != leftDist && topDist != bottomDist && nearDist > a3real_zero && farDist > nearDist)
+	{
+		const a3real rl = a3real_one / (rightDist - leftDist), tb = a3real_one / (topDist - bottomDist), nf = a3real_one / (nearDist - farDist);
+		const a3real n2 = a3real_two * nearDist;
+		m_out[0][0] = n2 * rl;
+		m_out[1][1] = n2 * tb;
+		m_out[2][0] = (rightDist + leftDist) * rl;
+		m_out[2][1] = (topDist + bottomDist) * tb;
+		m_out[2][2] = (nearDist + farDist) * nf;
+		m_out[2][3] = -a3real_one;
+		m_out[3][2] = n2 * farDist * nf;
+		m_out[3][3] = a3real_zero;
+		if (mInv_out_opt)
+		{
+			const a3real n2Inv = a3real_one / n2, q = a3real_half / (nearDist * farDist);
+			mInv_out_opt[0][0] = (rightDist - leftDist) * n2Inv;
+			mInv_out_opt[1][1] = (topDist - bottomDist) * n2Inv;
+			mInv_out_opt[2][2] = a3real_zero;
+			mInv_out_opt[2][3] = (nearDist - farDist) * q;
+			mInv_out_opt[3][0] = (rightDist + leftDist) * n2Inv;
+			mInv_out_opt[3][1] = (topDist + bottomDist) * n2Inv;
+			mInv_out_opt[3][2] = -a3real_one;
+			mInv_out_opt[3][3] = (nearDist + farDist) * q;
+		}
+	}
+	return m_out;
+}
+
+
+A3_INLINE a3real4x4r a3real4x4MakeOrthographicProjection(a3real4x4p m_out, a3real4x4p mInv_out_opt, const a3real width, const a3real height, const a3real nearDist, const a3real farDist)
+{
+	const a3real halfWidth = a3real_half * width, halfHeight = a3real_half * height;
+	return a3real4x4MakeOrthographicProjectionPlanes(m_out, mInv_out_opt, halfWidth, -halfWidth, halfHeight, -halfHeight, nearDist, farDist);
+}
+
+A3_INLINE a3real4x4r a3real4x4MakeOrthographicProjectionPlanes(a3real4x4p m_out, a3real4x4p mInv_out_opt, const a3real rightDist, const a3real leftDist, const a3real topDist, const a3real bottomDist, const a3real nearDist, const a3real farDist)
+{
+	a3real4x4SetIdentity(m_out);
+	if (mInv_out_opt)
+		a3real4x4SetIdentity(mInv_out_opt);
+	if (rightDist != leftDist && topDist != bottomDist && nearDist != farDist)
+	{
+		const a3real rl = a3real_one / (rightDist - leftDist), tb = a3real_one / (topDist - bottomDist), nf = a3real_one / (nearDist - farDist);
+		m_out[0][0] = a3real_two * rl;
+		m_out[1][1] = a3real_two * tb;
+		m_out[2][2] = a3real_two * nf;
+		m_out[3][0] = -(rightDist + leftDist) * rl;
+		m_out[3][1] = -(topDist + bottomDist) * tb;
+		m_out[3][2] = (nearDist + farDist) * nf;
+		if (mInv_out_opt)
+		{
+			mInv_out_opt[0][0] = a3real_half * (rightDist - leftDist);
+			mInv_out_opt[1][1] = a3real_half * (topDist - bottomDist);
+			mInv_out_opt[2][2] = a3real_half * (nearDist - farDist);
+			mInv_out_opt[3][0] = a3real_half * (rightDist + leftDist);
+			mInv_out_opt[3][1] = a3real_half * (topDist + bottomDist);
+			mInv_out_opt[3][2] = -a3real_half * (nearDist + farDist);
+		}
+	}
+	return m_out;
+}
+
+
+A3_INLINE a3real4x4r a3real4x4ConvertProjectionToStereo(a3real4x4p mL_out, a3real4x4p mR_out, a3real4x4p mInvL_out_opt, a3real4x4p mInvR_out_opt, const a3real4x4p mono, const a3real4x4p monoInv_opt, const a3real interocularDist, const a3real convergenceDist)
+{
+	a3real4x4SetReal4x4(mL_out, mono);
+	a3real4x4SetReal4x4(mR_out, mono);
+	if (mInvL_out_opt)
+		monoInv_opt ? a3real4x4SetReal4x4(mInvL_out_opt, monoInv_opt) : a3real4x4GetInverse(mInvL_out_opt, mono);
+	if (mInvR_out_opt)
+		monoInv_opt ? a3real4x4SetReal4x4(mInvR_out_opt, monoInv_opt) : a3real4x4GetInverse(mInvR_out_opt, mono);
+	if (interocularDist >= a3real_zero && convergenceDist > a3real_zero)
+	{
+		// shift each eye sideways, skewed so that both agree at convergence
+		const a3real shift = a3real_half * interocularDist * mono[0][0];
+		const a3real skew = shift / convergenceDist;
+		mL_out[2][0] += skew;
+		mL_out[3][0] += shift;
+		mR_out[2][0] -= skew;
+		mR_out[3][0] -= shift;
+		if (mInvL_out_opt || mInvR_out_opt)
+		{
+			const a3real h = a3real_half * interocularDist, hs = h / convergenceDist;
+			if (mInvL_out_opt)
+			{
+				mInvL_out_opt[2][0] -= hs * mInvL_out_opt[2][2] + h * mInvL_out_opt[2][3];
+				mInvL_out_opt[3][0] -= hs * mInvL_out_opt[3][2] + h * mInvL_out_opt[3][3];
+			}
+			if (mInvR_out_opt)
+			{
+				mInvR_out_opt[2][0] += hs * mInvR_out_opt[2][2] + h * mInvR_out_opt[2][3];
+				mInvR_out_opt[3][0] += hs * mInvR_out_opt[3][2] + h * mInvR_out_opt[3][3];
+			}
+		}
+	}
+	else
+	{
+		a3real4x4SetIdentity(mL_out);
+		a3real4x4SetIdentity(mR_out);
+		if (mInvL_out_opt)
+			a3real4x4SetIdentity(mInvL_out_opt);
+		if (mInvR_out_opt)
+			a3real4x4SetIdentity(mInvR_out_opt);
+	}
+	return mR_out;
+}
+
+
+A3_INLINE a3boolean a3real4x4CheckPerspective(const a3real4x4p m)
+{
+	return ((m[0][2] + m[0][3] + m[1][2] + m[1][3] + m[3][3]) == a3real_zero);
+}
+
+A3_INLINE a3boolean a3real4x4CheckOrthographic(const a3real4x4p m)
+{
+	return ((m[0][2] + m[0][3] + m[1][2] + m[1][3] + m[2][3]) == a3real_zero);
+}
+
+A3_INLINE a3boolean a3real4x4CheckStereo(const a3real4x4p m)
+{
+	return ((m[2][0] * m[3][0]) != a3real_zero);
+}
+
+
+A3_INLINE a3integer a3real4x4CheckPerspectiveStereo(const a3real4x4p m)
+{
+	if (!a3real4x4CheckPerspective(m))
+		return 0;
+	return (a3real4x4CheckStereo(m) ? 1 : -1);
+}
+
+A3_INLINE a3integer a3real4x4CheckOrthographicStereo(const a3real4x4p m)
+{
+	if (!a3real4x4CheckOrthographic(m))
+		return 0;
+	return (a3real4x4CheckStereo(m) ? 1 : -1);
+}
+
+
+//-----------------------------------------------------------------------------
+
+// constants are static per translation unit (declared extern otherwise)
+A3_GLOBAL const a3mat4 a3mat4_identity = { { a3real_one, a3real_zero, a3real_zero, a3real_zero, a3real_zero, a3real_one, a3real_zero, a3real_zero, a3real_zero, a3real_zero, a3real_one, a3real_zero, a3real_zero, a3real_zero, a3real_zero, a3real_one } };
+
+
+//-----------------------------------------------------------------------------
+
+
+A3_END_IMPL
+
+
+#endif	// !__ANIMAL3D_A3DM_MATRIX4_IMPL_INL
+#endif	// __ANIMAL3D_A3DM_MATRIX_H
@@ -0,0 +1,668 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	animal3D Math (A3DM) SDK
+	By Daniel S. Buckstein
+
+	a3quaternion_impl.inl
+	Implementations of quaternion functions.
+*/
+
+#ifdef __ANIMAL3D_A3DM_QUATERNION_H
+#ifndef __ANIMAL3D_A3DM_QUATERNION_IMPL_INL
+#define __ANIMAL3D_A3DM_QUATERNION_IMPL_INL
+
+
+#include "../a3sqrt.h"
+#include "../a3trig.h"
+
+
+A3_BEGIN_IMPL
+
+
+//-----------------------------------------------------------------------------
+// internal helpers
+
+// Euler angles in XYZ order; ratios make the angles independent of scale, 
+//	only the sine needs the inverse squared length
+A3_INLINE void a3quatInternalGetEulerXYZ(const a3real4p q, const a3real lenSqInv, a3real *degrees_x_out, a3real *degrees_y_out, a3real *degrees_z_out)
+{
+	const a3real ww = q[3] * q[3], xx = q[0] * q[0], yy = q[1] * q[1], zz = q[2] * q[2];
+	*degrees_x_out = a3atan2d(a3real_two * (q[3] * q[0] - q[1] * q[2]), ww - xx - yy + zz);
+	*degrees_y_out = a3asind(a3clamp(-a3real_one, a3real_one, a3real_two * (q[3] * q[1] + q[0] * q[2]) * lenSqInv));
+	*degrees_z_out = a3atan2d(a3real_two * (q[3] * q[2] - q[0] * q[1]), ww + xx - yy - zz);
+}
+
+// Euler angles in ZYX order
+A3_INLINE void a3quatInternalGetEulerZYX(const a3real4p q, const a3real lenSqInv, a3real *degrees_x_out, a3real *degrees_y_out, a3real *degrees_z_out)
+{
+	const a3real ww = q[3] * q[3], xx = q[0] * q[0], yy = q[1] * q[1], zz = q[2] * q[2];
+	*degrees_x_out = a3atan2d(a3real_two * (q[3] * q[0] + q[1] * q[2]), ww - xx - yy + zz);
+	*degrees_y_out = a3asind(a3clamp(-a3real_one, a3real_one, a3real_two * (q[3] * q[1] - q[0] * q[2]) * lenSqInv));
+	*degrees_z_out = a3atan2d(a3real_two * (q[3] * q[2] + q[0] * q[1]), ww + xx - yy - zz);
+}
+
+// axis and angle of quaternion with known inverse length
+A3_INLINE void a3quatInternalGetAxisAngle(const a3real4p q, const a3real lenInv, a3real3p unitAxis_out, a3real *degrees_out)
+{
+	const a3real w = a3clamp(-a3real_one, a3real_one, q[3] * lenInv);
+	const a3real a = a3acosd(w);
+	const a3real s = a3sind(a);
+	*degrees_out = a3real_two * a;
+	if (s != a3real_zero)
+		a3real3ProductS(unitAxis_out, q, lenInv / s);
+	else
+		a3real3Set(unitAxis_out, a3real_one, a3real_zero, a3real_zero);
+}
+
+// spherical interpolation given normalized dot product; takes the short way
+A3_INLINE a3real4r a3quatInternalSlerp(a3real4p q_out, const a3real4p q0, const a3real4p q1, a3real d, const a3real param)
+{
+	a3real a, s, s0, s1;
+	a3real4 q1n;
+	if (d < a3real_zero)
+	{
+		a3real4GetNegative(q1n, q1);
+		d = -d;
+	}
+	else
+		a3real4SetReal4(q1n, q1);
+
+	if (d < a3real_one)
+	{
+		a = a3acosd(d);
+		s = a3cscd(a);
+		s0 = a3sind((a3real_one - param) * a) * s;
+		s1 = a3sind(param * a) * s;
+		q_out[0] = q0[0] * s0 + q1n[0] * s1;
+		q_out[1] = q0[1] * s0 + q1n[1] * s1;
+		q_out[2] = q0[2] * s0 + q1n[2] * s1;
+		q_out[3] = q0[3] * s0 + q1n[3] * s1;
+		return q_out;
+	}
+	else if (d > a3real_one)
+		return a3real4NLerp(q_out, q0, q1n, param);
+	return a3real4SetReal4(q_out, q0);
+}
+
+// 3x3 part of matrix to quaternion using the trace; assumes trace > -1
+A3_INLINE a3real4r a3quatInternalConvertFromMat(a3real4p q_out, const a3real m00, const a3real m01, const a3real m02, const a3real m10, const a3real m11, const a3real m12, const a3real m20, const a3real m21, const a3real m22)
+{
+	const a3real w = a3real_half * a3sqrt(a3real_one + m00 + m11 + m22);
+	const a3real k = a3real_quarter / w;
+	q_out[0] = (m12 - m21) * k;
+	q_out[1] = (m20 - m02) * k;
+	q_out[2] = (m01 - m10) * k;
+	q_out[3] = w;
+	return q_out;
+}
+
+// 3x3 part of matrix to quaternion using the largest diagonal term
+A3_INLINE a3real4r a3quatInternalConvertFromMatSafe(a3real4p q_out, const a3real m00, const a3real m01, const a3real m02, const a3real m10, const a3real m11, const a3real m12, const a3real m20, const a3real m21, const a3real m22)
+{
+	const a3real tr = m00 + m11 + m22;
+	a3real r, k;
+	if (tr > a3real_zero)
+		return a3quatInternalConvertFromMat(q_out, m00, m01, m02, m10, m11, m12, m20, m21, m22);
+	if (m00 >= m11 && m00 >= m22)
+	{
+		r = a3sqrt(a3real_one + m00 - m11 - m22);
+		k = a3real_half / r;
+		q_out[0] = a3real_half * r;
+		q_out[1] = (m01 + m10) * k;
+		q_out[2] = (m20 + m02) * k;
+		q_out[3] = (m12 - m21) * k;
+	}
+	else if (m11 >= m22)
+	{
+		r = a3sqrt(a3real_one - m00 + m11 - m22);
+		k = a3real_half / r;
+		q_out[0] = (m01 + m10) * k;
+		q_out[1] = a3real_half * r;
+		q_out[2] = (m12 + m21) * k;
+		q_out[3] = (m20 - m02) * k;
+	}
+	else
+	{
+		r = a3sqrt(a3real_one - m00 - m11 + m22);
+		k = a3real_half / r;
+		q_out[0] = (m20 + m02) * k;
+		q_out[1] = (m12 + m21) * k;
+		q_out[2] = a3real_half * r;
+		q_out[3] = (m01 - m10) * k;
+	}
+	return q_out;
+}
+
+// quaternion to upper 3x3 of matrix with any column stride
+#define a3quatInternalConvertToMat(m_out, q)	{\
+	const a3real x2 = q[0] + q[0], y2 = q[1] + q[1], z2 = q[2] + q[2];\
+	const a3real xx = q[0] * q[0], yy = q[1] * q[1], zz = q[2] * q[2], ww = q[3] * q[3];\
+	const a3real xy2 = q[0] * y2, xz2 = q[0] * z2, yz2 = q[1] * z2;\
+	const a3real wx2 = q[3] * x2, wy2 = q[3] * y2, wz2 = q[3] * z2;\
+	m_out[0][0] = ww + xx - yy - zz;\
+	m_out[0][1] = xy2 + wz2;\
+	m_out[0][2] = xz2 - wy2;\
+	m_out[1][0] = xy2 - wz2;\
+	m_out[1][1] = ww - xx + yy - zz;\
+	m_out[1][2] = yz2 + wx2;\
+	m_out[2][0] = xz2 + wy2;\
+	m_out[2][1] = yz2 - wx2;\
+	m_out[2][2] = ww - xx - yy + zz;\
+}
+
+
+//-----------------------------------------------------------------------------
+
+A3_INLINE a3real4r a3quatSetIdentity(a3real4p q_out)
+{
+	q_out[0] = q_out[1] = q_out[2] = a3real_zero;
+	q_out[3] = a3real_one;
+	return q_out;
+}
+
+A3_INLINE a3real4r a3quatSet(a3real4p q_out, const a3real x, const a3real y, const a3real z, const a3real w)
+{
+	q_out[0] = x;
+	q_out[1] = y;
+	q_out[2] = z;
+	q_out[3] = w;
+	return q_out;
+}
+
+A3_INLINE a3real4r a3quatSetReal4(a3real4p q_out, const a3real4p v)
+{
+	q_out[0] = v[0];
+	q_out[1] = v[1];
+	q_out[2] = v[2];
+	q_out[3] = v[3];
+	return q_out;
+}
+
+A3_INLINE a3real4r a3quatSetAxisAngle(a3real4p q_out, const a3real3p unitAxis, const a3real degrees)
+{
+	const a3real a = a3real_half * degrees, s = a3sind(a);
+	q_out[0] = unitAxis[0] * s;
+	q_out[1] = unitAxis[1] * s;
+	q_out[2] = unitAxis[2] * s;
+	q_out[3] = a3cosd(a);
+	return q_out;
+}
+
+A3_INLINE a3real4r a3quatSetEulerX(a3real4p q_out, const a3real degrees_x)
+{
+	const a3real a = a3real_half * degrees_x;
+	return a3quatSet(q_out, a3sind(a), a3real_zero, a3real_zero, a3cosd(a));
+}
+
+A3_INLINE a3real4r a3quatSetEulerY(a3real4p q_out, const a3real degrees_y)
+{
+	const a3real a = a3real_half * degrees_y;
+	return a3quatSet(q_out, a3real_zero, a3sind(a), a3real_zero, a3cosd(a));
+}
+
+A3_INLINE a3real4r a3quatSetEulerZ(a3real4p q_out, const a3real degrees_z)
+{
+	const a3real a = a3real_half * degrees_z;
+	return a3quatSet(q_out, a3real_zero, a3real_zero, a3sind(a), a3cosd(a));
+}
+
+A3_INLINE a3real4r a3quatSetEulerXYZ(a3real4p q_out, const a3real degrees_x, const a3real degrees_y, const a3real degrees_z)
+{
+	// qx * qy * qz
+	const a3real ax = a3real_half * degrees_x, ay = a3real_half * degrees_y, az = a3real_half * degrees_z;
+	const a3real sx = a3sind(ax), cx = a3cosd(ax), sy = a3sind(ay), cy = a3cosd(ay), sz = a3sind(az), cz = a3cosd(az);
+	q_out[0] = sx * cy * cz + cx * sy * sz;
+	q_out[1] = cx * sy * cz - sx * cy * sz;
+	q_out[2] = cx * cy * sz + sx * sy * cz;
+	q_out[3] = cx * cy * cz - sx * sy * sz;
+	return q_out;
+}
+
+A3_INLINE a3real4r a3quatSetEulerZYX(a3real4p q_out, const a3real degrees_x, const a3real degrees_y, const a3real degrees_z)
+{
+	// qz * qy * qx
+	const a3real ax = a3real_half * degrees_x, ay = a3real_half * degrees_y, az = a3real_half * degrees_z;
+	const a3real sx = a3sind(ax), cx = a3cosd(ax), sy = a3sind(ay), cy = a3cosd(ay), sz = a3sind(az), cz = a3cosd(az);
+	q_out[0] = sx * cy * cz - cx * sy * sz;
+	q_out[1] = cx * sy * cz + sx * cy * sz;
+	q_out[2] = cx * cy * sz - sx * sy * cz;
+	q_out[3] = cx * cy * cz + sx * sy * sz;
+	return q_out;
+}
+
+A3_INLINE a3real4r a3quatSetVectorDelta(a3real4p q_out, const a3real3p unitV0, const a3real3p unitV1)
+{
+	// half-vector method: rotation by twice the angle between v0 and h
+	a3real3 h;
+	a3real3Sum(h, unitV0, unitV1);
+	if (a3real3LengthSquared(h) > a3real_zero)
+	{
+		a3real3Normalize(h);
+		a3real3Cross(q_out, unitV0, h);
+		q_out[3] = a3real3Dot(unitV0, h);
+		return q_out;
+	}
+
+	// opposite vectors: half turn about any perpendicular axis
+	if (unitV0[0] * unitV0[0] < a3real_half)
+		a3real3Set(h, a3real_one, a3real_zero, a3real_zero);
+	else
+		a3real3Set(h, a3real_zero, a3real_one, a3real_zero);
+	a3real3CrossUnit(q_out, unitV0, h);
+	q_out[3] = a3real_zero;
+	return q_out;
+}
+
+A3_INLINE a3real4r a3quatSetAxisAngleScale(a3real4p q_out, const a3real3p unitAxis, const a3real degrees, const a3real s)
+{
+	return a3real4MulS(a3quatSetAxisAngle(q_out, unitAxis, degrees), a3sqrt(s));
+}
+
+A3_INLINE a3real4r a3quatSetEulerXScale(a3real4p q_out, const a3real degrees_x, const a3real s)
+{
+	return a3real4MulS(a3quatSetEulerX(q_out, degrees_x), a3sqrt(s));
+}
+
+A3_INLINE a3real4r a3quatSetEulerYScale(a3real4p q_out, const a3real degrees_y, const a3real s)
+{
+	return a3real4MulS(a3quatSetEulerY(q_out, degrees_y), a3sqrt(s));
+}
+
+A3_INLINE a3real4r a3quatSetEulerZScale(a3real4p q_out, const a3real degrees_z, const a3real s)
+{
+	return a3real4MulS(a3quatSetEulerZ(q_out, degrees_z), a3sqrt(s));
+}
+
+A3_INLINE a3real4r a3quatSetEulerXYZScale(a3real4p q_out, const a3real degrees_x, const a3real degrees_y, const a3real degrees_z, const a3real s)
+{
+	return a3real4MulS(a3quatSetEulerXYZ(q_out, degrees_x, degrees_y, degrees_z), a3sqrt(s));
+}
+
+A3_INLINE a3real4r a3quatSetEulerZYXScale(a3real4p q_out, const a3real degrees_x, const a3real degrees_y, const a3real degrees_z, const a3real s)
+{
+	return a3real4MulS(a3quatSetEulerZYX(q_out, degrees_x, degrees_y, degrees_z), a3sqrt(s));
+}
+
+A3_INLINE a3real4r a3quatSetVectorDeltaScale(a3real4p q_out, const a3real3p unitV0, const a3real3p unitV1, const a3real s)
+{
+	return a3real4MulS(a3quatSetVectorDelta(q_out, unitV0, unitV1), a3sqrt(s));
+}
+
+A3_INLINE a3real4r a3quatSetScale(a3real4p q_out, const a3real s)
+{
+	q_out[0] = q_out[1] = q_out[2] = a3real_zero;
+	q_out[3] = a3sqrt(s);
+	return q_out;
+}
+
+
+A3_INLINE a3real4r a3quatGetConjugated(a3real4p q_out, const a3real4p q)
+{
+	q_out[0] = -q[0];
+	q_out[1] = -q[1];
+	q_out[2] = -q[2];
+	q_out[3] = q[3];
+	return q_out;
+}
+
+A3_INLINE a3real4r a3quatGetInverse(a3real4p q_out, const a3real4p q)
+{
+	const a3real lenSqInv = a3real4LengthSquaredInverse(q);
+	q_out[0] = -q[0] * lenSqInv;
+	q_out[1] = -q[1] * lenSqInv;
+	q_out[2] = -q[2] * lenSqInv;
+	q_out[3] = q[3] * lenSqInv;
+	return q_out;
+}
+
+A3_INLINE a3real4r a3quatGetInverseGetScale(a3real4p q_out, a3real *s_out, const a3real4p q)
+{
+	*s_out = a3real4LengthSquared(q);
+	return a3quatGetInverse(q_out, q);
+}
+
+A3_INLINE a3real4r a3quatGetInverseIgnoreScale(a3real4p q_out, const a3real4p q)
+{
+	return a3quatGetConjugated(q_out, q);
+}
+
+A3_INLINE a3real4r a3quatConjugate(a3real4p q_inout)
+{
+	return a3quatGetConjugated(q_inout, q_inout);
+}
+
+A3_INLINE a3real4r a3quatInvert(a3real4p q_inout)
+{
+	return a3quatGetInverse(q_inout, q_inout);
+}
+
+A3_INLINE a3real4r a3quatInvertGetScale(a3real4p q_inout, a3real *s_out)
+{
+	return a3quatGetInverseGetScale(q_inout, s_out, q_inout);
+}
+
+A3_INLINE a3real4r a3quatInvertIgnoreScale(a3real4p q_inout)
+{
+	return a3quatGetConjugated(q_inout, q_inout);
+}
+
+A3_INLINE a3real4rk a3quatGetAxisAngle(const a3real4p q, a3real3p unitAxis_out, a3real *degrees_out)
+{
+	a3quatInternalGetAxisAngle(q, a3real4LengthInverse(q), unitAxis_out, degrees_out);
+	return q;
+}
+
+A3_INLINE a3real4rk a3quatGetAxisAngleScale(const a3real4p q, a3real3p unitAxis_out, a3real *degrees_out, a3real *s_out)
+{
+	const a3real lenSq = a3real4LengthSquared(q);
+	*s_out = lenSq;
+	a3quatInternalGetAxisAngle(q, a3sqrtInverse(lenSq), unitAxis_out, degrees_out);
+	return q;
+}
+
+A3_INLINE a3real4rk a3quatGetAxisAngleIgnoreScale(const a3real4p q, a3real3p unitAxis_out, a3real *degrees_out)
+{
+	a3quatInternalGetAxisAngle(q, a3real_one, unitAxis_out, degrees_out);
+	return q;
+}
+
+A3_INLINE a3real4rk a3quatGetEulerXYZ(const a3real4p q, a3real *degrees_x_out, a3real *degrees_y_out, a3real *degrees_z_out)
+{
+	a3quatInternalGetEulerXYZ(q, a3real4LengthSquaredInverse(q), degrees_x_out, degrees_y_out, degrees_z_out);
+	return q;
+}
+
+A3_INLINE a3real4rk a3quatGetEulerZYX(const a3real4p q, a3real *degrees_x_out, a3real *degrees_y_out, a3real *degrees_z_out)
+{
+	a3quatInternalGetEulerZYX(q, a3real4LengthSquaredInverse(q), degrees_x_out, degrees_y_out, degrees_z_out);
+	return q;
+}
+
+A3_INLINE a3real4rk a3quatGetEulerXYZScale(const a3real4p q, a3real *degrees_x_out, a3real *degrees_y_out, a3real *degrees_z_out, a3real *s_out)
+{
+	const a3real lenSq = a3real4LengthSquared(q);
+	*s_out = lenSq;
+	a3quatInternalGetEulerXYZ(q, a3real_one / lenSq, degrees_x_out, degrees_y_out, degrees_z_out);
+	return q;
+}
+
+A3_INLINE a3real4rk a3quatGetEulerZYXScale(const a3real4p q, a3real *degrees_x_out, a3real *degrees_y_out, a3real *degrees_z_out, a3real *s_out)
+{
+	const a3real lenSq = a3real4LengthSquared(q);
+	*s_out = lenSq;
+	a3quatInternalGetEulerZYX(q, a3real_one / lenSq, degrees_x_out, degrees_y_out, degrees_z_out);
+	return q;
+}
+
+A3_INLINE a3real4rk a3quatGetEulerXYZIgnoreScale(const a3real4p q, a3real *degrees_x_out, a3real *degrees_y_out, a3real *degrees_z_out)
+{
+	a3quatInternalGetEulerXYZ(q, a3real_one, degrees_x_out, degrees_y_out, degrees_z_out);
+	return q;
+}
+
+A3_INLINE a3real4rk a3quatGetEulerZYXIgnoreScale(const a3real4p q, a3real *degrees_x_out, a3real *degrees_y_out, a3real *degrees_z_out)
+{
+	a3quatInternalGetEulerZYX(q, a3real_one, degrees_x_out, degrees_y_out, degrees_z_out);
+	return q;
+}
+
+A3_INLINE a3real4rk a3quatGetScale(const a3real4p q, a3real *s_out)
+{
+	*s_out = a3real4LengthSquared(q);
+	return q;
+}
+
+
+A3_INLINE a3real3x3r a3quatConvertToMat3(a3real3x3p m_out, const a3real4p q)
+{
+	a3quatInternalConvertToMat(m_out, q);
+	return m_out;
+}
+
+A3_INLINE a3real4x4r a3quatConvertToMat4(a3real4x4p m_out, const a3real4p q)
+{
+	a3quatInternalConvertToMat(m_out, q);
+	m_out[0][3] = m_out[1][3] = m_out[2][3] = a3real_zero;
+	m_out[3][0] = m_out[3][1] = m_out[3][2] = a3real_zero;
+	m_out[3][3] = a3real_one;
+	return m_out;
+}
+
+A3_INLINE a3real4x4r a3quatConvertToMat4Translate(a3real4x4p m_out, const a3real4p q, const a3real3p translate)
+{
+	a3quatConvertToMat4(m_out, q);
+	m_out[3][0] = translate[0];
+	m_out[3][1] = translate[1];
+	m_out[3][2] = translate[2];
+	return m_out;
+}
+
+A3_INLINE a3real4r a3quatConvertFromMat3(a3real4p q_out, const a3real3x3p m)
+{
+	return a3quatInternalConvertFromMat(q_out, m[0][0], m[0][1], m[0][2], m[1][0], m[1][1], m[1][2], m[2][0], m[2][1], m[2][2]);
+}
+
+A3_INLINE a3real4r a3quatConvertFromMat4(a3real4p q_out, const a3real4x4p m)
+{
+	return a3quatInternalConvertFromMat(q_out, m[0][0], m[0][1], m[0][2], m[1][0], m[1][1], m[1][2], m[2][0], m[2][1], m[2][2]);
+}
+
+A3_INLINE a3real4r a3quatConvertFromMat4Translate(a3real4p q_out, a3real3p translate_out, const a3real4x4p m)
+{
+	a3real3SetReal4(translate_out, m[3]);
+	return a3quatConvertFromMat4(q_out, m);
+}
+
+A3_INLINE a3real4r a3quatConvertFromMat3Safe(a3real4p q_out, const a3real3x3p m)
+{
+	return a3quatInternalConvertFromMatSafe(q_out, m[0][0], m[0][1], m[0][2], m[1][0], m[1][1], m[1][2], m[2][0], m[2][1], m[2][2]);
+}
+
+A3_INLINE a3real4r a3quatConvertFromMat4Safe(a3real4p q_out, const a3real4x4p m)
+{
+	return a3quatInternalConvertFromMatSafe(q_out, m[0][0], m[0][1], m[0][2], m[1][0], m[1][1], m[1][2], m[2][0], m[2][1], m[2][2]);
+}
+
+A3_INLINE a3real4r a3quatConvertFromMat4SafeTranslate(a3real4p q_out, a3real3p translate_out, const a3real4x4p m)
+{
+	a3real3SetReal4(translate_out, m[3]);
+	return a3quatConvertFromMat4Safe(q_out, m);
+}
+
+
+A3_INLINE a3real4r a3quatProduct(a3real4p q_out, const a3real4p qL, const a3real4p qR)
+{
+	a3real4 tmp;
+	tmp[0] = qL[3] * qR[0] + qL[0] * qR[3] + qL[1] * qR[2] - qL[2] * qR[1];
+	tmp[1] = qL[3] * qR[1] - qL[0] * qR[2] + qL[1] * qR[3] + qL[2] * qR[0];
+	tmp[2] = qL[3] * qR[2] + qL[0] * qR[1] - qL[1] * qR[0] + qL[2] * qR[3];
+	tmp[3] = qL[3] * qR[3] - qL[0] * qR[0] - qL[1] * qR[1] - qL[2] * qR[2];
+	return a3quatSetReal4(q_out, tmp);
+}
+
+A3_INLINE a3real4r a3quatConcatL(a3real4p qL_inout, const a3real4p qR)
+{
+	return a3quatProduct(qL_inout, qL_inout, qR);
+}
+
+A3_INLINE a3real4r a3quatConcatR(const a3real4p qL, a3real4p qR_inout)
+{
+	return a3quatProduct(qR_inout, qL, qR_inout);
+}
+
+
+A3_INLINE a3real3r a3quatVec3GetRotatedIgnoreScale(a3real3p v_out, const a3real3p v, const a3real4p q)
+{
+	// v + 2w(q x v) + 2q x (q x v)
+	a3real3 t, u;
+	a3real3Cross(t, q, v);
+	a3real3Add(t, t);
+	a3real3Cross(u, q, t);
+	v_out[0] = v[0] + q[3] * t[0] + u[0];
+	v_out[1] = v[1] + q[3] * t[1] + u[1];
+	v_out[2] = v[2] + q[3] * t[2] + u[2];
+	return v_out;
+}
+
+A3_INLINE a3real3r a3quatVec3GetRotatedScaled(a3real3p v_out, const a3real3p v, const a3real4p q)
+{
+	// q v q*: rotation and scale by squared length
+	const a3real a = q[3] * q[3] - a3real3LengthSquared(q), b = a3real_two * a3real3Dot(q, v), c = q[3] + q[3];
+	a3real3 t;
+	a3real3Cross(t, q, v);
+	v_out[0] = a * v[0] + b * q[0] + c * t[0];
+	v_out[1] = a * v[1] + b * q[1] + c * t[1];
+	v_out[2] = a * v[2] + b * q[2] + c * t[2];
+	return v_out;
+}
+
+A3_INLINE a3real3r a3quatVec3GetRotated(a3real3p v_out, const a3real3p v, const a3real4p q)
+{
+	return a3real3MulS(a3quatVec3GetRotatedScaled(v_out, v, q), a3real4LengthSquaredInverse(q));
+}
+
+A3_INLINE a3real3r a3quatVec3RotateIgnoreScale(a3real3p v_inout, const a3real4p q)
+{
+	return a3quatVec3GetRotatedIgnoreScale(v_inout, v_inout, q);
+}
+
+A3_INLINE a3real3r a3quatVec3RotateScale(a3real3p v_inout, const a3real4p q)
+{
+	return a3quatVec3GetRotatedScaled(v_inout, v_inout, q);
+}
+
+A3_INLINE a3real3r a3quatVec3Rotate(a3real3p v_inout, const a3real4p q)
+{
+	return a3quatVec3GetRotated(v_inout, v_inout, q);
+}
+
+
+A3_INLINE a3real4r a3quatProductPureL(a3real4p q_out, const a3real4p qPureL, const a3real4p qR)
+{
+	a3real4 tmp;
+	tmp[0] = qPureL[0] * qR[3] + qPureL[1] * qR[2] - qPureL[2] * qR[1];
+	tmp[1] = -qPureL[0] * qR[2] + qPureL[1] * qR[3] + qPureL[2] * qR[0];
+	tmp[2] = qPureL[0] * qR[1] - qPureL[1] * qR[0] + qPureL[2] * qR[3];
+	tmp[3] = -qPureL[0] * qR[0] - qPureL[1] * qR[1] - qPureL[2] * qR[2];
+	return a3quatSetReal4(q_out, tmp);
+}
+
+A3_INLINE a3real4r a3quatProductPureR(a3real4p q_out, const a3real4p qL, const a3real4p qPureR)
+{
+	a3real4 tmp;
+	tmp[0] = qL[3] * qPureR[0] + qL[1] * qPureR[2] - qL[2] * qPureR[1];
+	tmp[1] = qL[3] * qPureR[1] - qL[0] * qPureR[2] + qL[2] * qPureR[0];
+	tmp[2] = qL[3] * qPureR[2] + qL[0] * qPureR[1] - qL[1] * qPureR[0];
+	tmp[3] = -qL[0] * qPureR[0] - qL[1] * qPureR[1] - qL[2] * qPureR[2];
+	return a3quatSetReal4(q_out, tmp);
+}
+
+A3_INLINE a3real4r a3quatConcatLPureL(a3real4p qPureL_inout, const a3real4p qR)
+{
+	return a3quatProductPureL(qPureL_inout, qPureL_inout, qR);
+}
+
+A3_INLINE a3real4r a3quatConcatRPureL(const a3real4p qPureL, a3real4p qR_inout)
+{
+	return a3quatProductPureL(qR_inout, qPureL, qR_inout);
+}
+
+A3_INLINE a3real4r a3quatConcatLPureR(a3real4p qL_inout, const a3real4p qPureR)
+{
+	return a3quatProductPureR(qL_inout, qL_inout, qPureR);
+}
+
+A3_INLINE a3real4r a3quatConcatRPureR(const a3real4p qL, a3real4p qPureR_inout)
+{
+	return a3quatProductPureR(qPureR_inout, qL, qPureR_inout);
+}
+
+
+A3_INLINE a3real4r a3quatSlerp(a3real4p q_out, const a3real4p q0, const a3real4p q1, const a3real param)
+{
+	const a3real d = a3real4Dot(q0, q1) * a3sqrtInverse(a3real4LengthSquared(q0) * a3real4LengthSquared(q1));
+	return a3quatInternalSlerp(q_out, q0, q1, d, param);
+}
+
+A3_INLINE a3real4r a3quatSlerpUnit(a3real4p q_out, const a3real4p q0, const a3real4p q1, const a3real param)
+{
+	return a3quatInternalSlerp(q_out, q0, q1, a3real4Dot(q0, q1), param);
+}
+
+A3_INLINE a3real4r a3quatSlerpIdentityQ0(a3real4p q_out, const a3real4p q1, const a3real param)
+{
+	a3real4 q0;
+	return a3quatSlerp(q_out, a3quatSetIdentity(q0), q1, param);
+}
+
+A3_INLINE a3real4r a3quatSlerpIdentityQ1(a3real4p q_out, const a3real4p q0, const a3real param)
+{
+	a3real4 q1;
+	return a3quatSlerp(q_out, q0, a3quatSetIdentity(q1), param);
+}
+
+A3_INLINE a3real4r a3quatSlerpUnitIdentityQ0(a3real4p q_out, const a3real4p q1, const a3real param)
+{
+	a3real4 q0;
+	return a3quatSlerpUnit(q_out, a3quatSetIdentity(q0), q1, param);
+}
+
+A3_INLINE a3real4r a3quatSlerpUnitIdentityQ1(a3real4p q_out, const a3real4p q0, const a3real param)
+{
+	a3real4 q1;
+	return a3quatSlerpUnit(q_out, q0, a3quatSetIdentity(q1), param);
+}
+
+
+A3_INLINE a3real4r a3quatGramSchmidtOrtho4(a3real4p q0_out, a3real4p q1_out, a3real4p q2_out, a3real4p q3_out, const a3real4p q0, const a3real4p q1, const a3real4p q2, const a3real4p q3, const a3real4p qBase)
+{
+	a3real4 p;
+	a3real4Diff(q0_out, q0, a3real4Projected(p, q0, qBase));
+	a3real4Diff(q1_out, q1, a3real4Projected(p, q1, qBase));
+	a3real4Sub(q1_out, a3real4Projected(p, q1, q0_out));
+	a3real4Diff(q2_out, q2, a3real4Projected(p, q2, qBase));
+	a3real4Sub(q2_out, a3real4Projected(p, q2, q0_out));
+	a3real4Sub(q2_out, a3real4Projected(p, q2, q1_out));
+	a3real4Diff(q3_out, q3, a3real4Projected(p, q3, qBase));
+	a3real4Sub(q3_out, a3real4Projected(p, q3, q0_out));
+	a3real4Sub(q3_out, a3real4Projected(p, q3, q1_out));
+	a3real4Sub(q3_out, a3real4Projected(p, q3, q2_out));
+	return q3_out;
+}
+
+A3_INLINE a3real4r a3quatGramSchmidt4(a3real4p q0_inout, a3real4p q1_inout, a3real4p q2_inout, a3real4p q3_inout, const a3real4p qBase)
+{
+	return a3quatGramSchmidtOrtho4(q0_inout, q1_inout, q2_inout, q3_inout, q0_inout, q1_inout, q2_inout, q3_inout, qBase);
+}
+
+
+//-----------------------------------------------------------------------------
+
+// constants are static per translation unit (declared extern otherwise)
+A3_GLOBAL const a3quat a3quat_identity = { { a3real_zero, a3real_zero, a3real_zero, a3real_one } };
+
+
+//-----------------------------------------------------------------------------
+
+
+A3_END_IMPL
+
+
+#endif	// !__ANIMAL3D_A3DM_QUATERNION_IMPL_INL
+#endif	// __ANIMAL3D_A3DM_QUATERNION_H
@@ -0,0 +1,118 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	animal3D Math (A3DM) SDK
+	By Daniel S. Buckstein
+
+	a3random_impl.inl
+	Implementations of global-seed random number functions.
+*/
+
+#ifdef __ANIMAL3D_A3DM_RANDOM_H
+#ifndef __ANIMAL3D_A3DM_RANDOM_IMPL_INL
+#define __ANIMAL3D_A3DM_RANDOM_IMPL_INL
+
+
+A3_BEGIN_IMPL
+
+
+//-----------------------------------------------------------------------------
+// internal helpers
+
+// linear congruential generator parameters
+#define a3randomInternal_mul	141
+#define a3randomInternal_add	28411
+#define a3randomInternal_max	134456
+
+// one seed shared by every translation unit
+A3_SHARED a3integer a3_randseed = 1235;
+
+
+//-----------------------------------------------------------------------------
+
+A3_INLINE a3integer a3randomGetMax()
+{
+	return a3randomInternal_max;
+}
+
+A3_INLINE a3integer a3randomGetSeed()
+{
+	return a3_randseed;
+}
+
+A3_INLINE a3integer a3randomSetSeed(const a3integer seed)
+{
+	const a3integer ret = a3_randseed;
+	a3_randseed = seed;
+	return ret;
+}
+
+
+A3_INLINE a3integer a3randomInt()
+{
+	a3_randseed = (a3_randseed * a3randomInternal_mul + a3randomInternal_add) % a3randomInternal_max;
+	return a3_randseed;
+}
+
+A3_INLINE a3real a3random()
+{
+	return (a3real)a3randomInt();
+}
+
+A3_INLINE a3real a3randomNormalized()
+{
+	return (a3random() * (a3real_one / (a3real)a3randomInternal_max));
+}
+
+A3_INLINE a3real a3randomSymmetric()
+{
+	return (a3real_two * a3randomNormalized() - a3real_one);
+}
+
+
+A3_INLINE a3real a3randomMax(const a3real nMax)
+{
+	return (a3randomNormalized() * nMax);
+}
+
+A3_INLINE a3integer a3randomMaxInt(const a3integer nMax)
+{
+	return (a3randomInt() % nMax);
+}
+
+
+A3_INLINE a3real a3randomRange(const a3real nMin, const a3real nMax)
+{
+	return (nMin + (nMax - nMin) * a3randomNormalized());
+}
+
+A3_INLINE a3integer a3randomRangeInt(const a3integer nMin, const a3integer nMax)
+{
+	return (a3randomInt() % (nMax - nMin) + nMin);
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+A3_END_IMPL
+
+
+#endif	// !__ANIMAL3D_A3DM_RANDOM_IMPL_INL
+#endif	// __ANIMAL3D_A3DM_RANDOM_H
@@ -0,0 +1,337 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	animal3D Math (A3DM) SDK
+	By Daniel S. Buckstein
+
+	a3randomstream_impl.inl
+	Implementations of random number streams.
+*/
+
+#ifdef __ANIMAL3D_A3DM_RANDOMSTREAM_H
+#ifndef __ANIMAL3D_A3DM_RANDOMSTREAM_IMPL_INL
+#define __ANIMAL3D_A3DM_RANDOMSTREAM_IMPL_INL
+
+
+A3_BEGIN_IMPL
+
+
+//-----------------------------------------------------------------------------
+// internal helpers
+
+// golden ratio increment for key derivation
+#define a3randomStreamInternal_gamma	0x9e3779b97f4a7c15ull
+
+// scale from top 24 bits to [0, 1)
+#define a3randomStreamInternal_unit		(1.0f / 16777216.0f)
+
+// normal fill works through a local buffer of uniforms
+#define a3randomStreamInternal_chunk	64
+
+// splitmix64: advance and mix
+A3_INLINE a3ui64 a3randomStreamInternalMix(a3ui64* x_inout)
+{
+	a3ui64 z = (*x_inout += a3randomStreamInternal_gamma);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+	return (z ^ (z >> 31));
+}
+
+// xoshiro128+ step of all four generators into buffer
+A3_INLINE void a3randomStreamInternalStep(a3_RandomStream* stream)
+{
+#if (A3_SIMD >= A3_SIMD_SSE2)
+	__m128i s0 = _mm_loadu_si128((const __m128i*)stream->state[0]), s1 = _mm_loadu_si128((const __m128i*)stream->state[1]);
+	__m128i s2 = _mm_loadu_si128((const __m128i*)stream->state[2]), s3 = _mm_loadu_si128((const __m128i*)stream->state[3]);
+	const __m128i t = _mm_slli_epi32(s1, 9);
+	_mm_storeu_si128((__m128i*)stream->buffer, _mm_add_epi32(s0, s3));
+	s2 = _mm_xor_si128(s2, s0);
+	s3 = _mm_xor_si128(s3, s1);
+	s1 = _mm_xor_si128(s1, s2);
+	s0 = _mm_xor_si128(s0, s3);
+	s2 = _mm_xor_si128(s2, t);
+	s3 = _mm_or_si128(_mm_slli_epi32(s3, 11), _mm_srli_epi32(s3, 21));
+	_mm_storeu_si128((__m128i*)stream->state[0], s0);
+	_mm_storeu_si128((__m128i*)stream->state[1], s1);
+	_mm_storeu_si128((__m128i*)stream->state[2], s2);
+	_mm_storeu_si128((__m128i*)stream->state[3], s3);
+#else	// scalar
+	a3ui32* const s0 = stream->state[0], * const s1 = stream->state[1];
+	a3ui32* const s2 = stream->state[2], * const s3 = stream->state[3];
+	a3ui32 t;
+	a3index i;
+	for (i = 0; i < 4; ++i)
+	{
+		stream->buffer[i] = s0[i] + s3[i];
+		t = s1[i] << 9;
+		s2[i] ^= s0[i];
+		s3[i] ^= s1[i];
+		s1[i] ^= s2[i];
+		s0[i] ^= s3[i];
+		s2[i] ^= t;
+		s3[i] = (s3[i] << 11) | (s3[i] >> 21);
+	}
+#endif	// A3_SIMD
+}
+
+// next value from buffer, stepping all generators when it runs out
+A3_INLINE a3ui32 a3randomStreamInternalNext(a3_RandomStream* stream)
+{
+	const a3ui32 lane = stream->lane;
+	if (!lane)
+		a3randomStreamInternalStep(stream);
+	stream->lane = (lane + 1) & 3;
+	return stream->buffer[lane];
+}
+
+A3_INLINE a3real a3randomStreamInternalUnit(const a3ui32 x)
+{
+	// top bits are the strongest in xoshiro128+
+	return ((a3real)(x >> 8) * (a3real)a3randomStreamInternal_unit);
+}
+
+// natural log for x in (0, 1] (Cephes logf)
+A3_INLINE a3f32 a3randomStreamInternalLog(const a3f32 x)
+{
+	union { a3f32 f; a3ui32 i; } u;
+	a3f32 m, z, y, e;
+	u.f = x;
+	e = (a3f32)((a3i32)((u.i >> 23) & 0xff) - 126);
+	u.i = (u.i & 0x007fffff) | 0x3f000000;
+	m = u.f;
+	if (m < 0.707106781186547524f)
+	{
+		e -= 1.0f;
+		m = m + m - 1.0f;
+	}
+	else
+		m = m - 1.0f;
+	z = m * m;
+	y = ((((((((7.0376836292e-2f * m - 1.1514610310e-1f) * m + 1.1676998740e-1f) * m - 1.2420140846e-1f) * m
+		+ 1.4249322787e-1f) * m - 1.6668057665e-1f) * m + 2.0000714765e-1f) * m - 2.4999993993e-1f) * m + 3.3333331174e-1f) * m * z;
+	return (m + (y - 2.12194440e-4f * e - 0.5f * z) + 0.693359375f * e);
+}
+
+// Box-Muller on block of eight uniforms: [0, 4) radius, [4, 8) angle
+A3_INLINE void a3randomStreamInternalNormalBlock(a3real* values_inout, const a3real mean, const a3real stddev)
+{
+#if (A3_SIMD >= A3_SIMD_SSE2)
+	const __m128i mantissa = _mm_set1_epi32(0x007fffff), half = _mm_set1_epi32(0x3f000000);
+	const __m128 one = _mm_set1_ps(1.0f);
+	__m128 x = _mm_sub_ps(one, _mm_loadu_ps(values_inout));
+	__m128 m, z, y, e, r, s, c, small;
+	__m128i xi = _mm_castps_si128(x);
+
+	// log(1 - u), same steps as scalar
+	e = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_and_si128(_mm_srli_epi32(xi, 23), _mm_set1_epi32(0xff)), _mm_set1_epi32(126)));
+	m = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(xi, mantissa), half));
+	small = _mm_cmplt_ps(m, _mm_set1_ps(0.707106781186547524f));
+	e = _mm_sub_ps(e, _mm_and_ps(small, one));
+	m = _mm_sub_ps(_mm_add_ps(m, _mm_and_ps(small, m)), one);
+	z = _mm_mul_ps(m, m);
+	y = a3simdInternalMAdd(_mm_set1_ps(7.0376836292e-2f), m, _mm_set1_ps(-1.1514610310e-1f));
+	y = a3simdInternalMAdd(y, m, _mm_set1_ps(1.1676998740e-1f));
+	y = a3simdInternalMAdd(y, m, _mm_set1_ps(-1.2420140846e-1f));
+	y = a3simdInternalMAdd(y, m, _mm_set1_ps(1.4249322787e-1f));
+	y = a3simdInternalMAdd(y, m, _mm_set1_ps(-1.6668057665e-1f));
+	y = a3simdInternalMAdd(y, m, _mm_set1_ps(2.0000714765e-1f));
+	y = a3simdInternalMAdd(y, m, _mm_set1_ps(-2.4999993993e-1f));
+	y = a3simdInternalMAdd(y, m, _mm_set1_ps(3.3333331174e-1f));
+	y = _mm_mul_ps(_mm_mul_ps(y, m), z);
+	y = _mm_sub_ps(_mm_sub_ps(y, _mm_mul_ps(_mm_set1_ps(2.12194440e-4f), e)), _mm_mul_ps(_mm_set1_ps(0.5f), z));
+	x = _mm_add_ps(_mm_add_ps(m, y), _mm_mul_ps(_mm_set1_ps(0.693359375f), e));
+
+	r = _mm_mul_ps(_mm_sqrt_ps(_mm_mul_ps(_mm_set1_ps(-2.0f), x)), _mm_set1_ps(stddev));
+	s = a3sincosInternalDegreesSSE(_mm_mul_ps(_mm_loadu_ps(values_inout + 4), _mm_set1_ps(360.0f)), &c);
+	_mm_storeu_ps(values_inout + 0, a3simdInternalMAdd(r, c, _mm_set1_ps(mean)));
+	_mm_storeu_ps(values_inout + 4, a3simdInternalMAdd(r, s, _mm_set1_ps(mean)));
+#else	// scalar
+	a3real r, s, c;
+	a3index i;
+	for (i = 0; i < 4; ++i)
+	{
+		r = a3sqrt((a3real)-2 * (a3real)a3randomStreamInternalLog((a3f32)(a3real_one - values_inout[i]))) * stddev;
+		s = a3sincosInternalDegrees(values_inout[i + 4] * (a3real)360, &c);
+		values_inout[i + 0] = mean + r * c;
+		values_inout[i + 4] = mean + r * s;
+	}
+#endif	// A3_SIMD
+}
+
+// fill with (offset + scale * unit) or raw integers
+A3_INLINE void a3randomStreamInternalFill(a3_RandomStream* stream, void* values_out, const a3count count, const a3real offset, const a3real scale, const a3boolean integer)
+{
+	a3ui32* const ui = (a3ui32*)values_out;
+	a3real* const f = (a3real*)values_out;
+	a3index i = 0;
+
+	// drain buffer
+	for (; i < count && stream->lane; ++i)
+		if (integer)
+			ui[i] = a3randomStreamInternalNext(stream);
+		else
+			f[i] = offset + scale * a3randomStreamInternalUnit(a3randomStreamInternalNext(stream));
+
+#if (A3_SIMD >= A3_SIMD_SSE2)
+	if (i + 4 <= count)
+	{
+		__m128i s0 = _mm_loadu_si128((const __m128i*)stream->state[0]), s1 = _mm_loadu_si128((const __m128i*)stream->state[1]);
+		__m128i s2 = _mm_loadu_si128((const __m128i*)stream->state[2]), s3 = _mm_loadu_si128((const __m128i*)stream->state[3]);
+		__m128i result, t;
+		const __m128 o = _mm_set1_ps(offset), k = _mm_set1_ps(scale * a3randomStreamInternal_unit);
+		for (; i + 4 <= count; i += 4)
+		{
+			result = _mm_add_epi32(s0, s3);
+			t = _mm_slli_epi32(s1, 9);
+			s2 = _mm_xor_si128(s2, s0);
+			s3 = _mm_xor_si128(s3, s1);
+			s1 = _mm_xor_si128(s1, s2);
+			s0 = _mm_xor_si128(s0, s3);
+			s2 = _mm_xor_si128(s2, t);
+			s3 = _mm_or_si128(_mm_slli_epi32(s3, 11), _mm_srli_epi32(s3, 21));
+			if (integer)
+				_mm_storeu_si128((__m128i*)(ui + i), result);
+			else
+				_mm_storeu_ps(f + i, a3simdInternalMAdd(_mm_cvtepi32_ps(_mm_srli_epi32(result, 8)), k, o));
+		}
+		_mm_storeu_si128((__m128i*)stream->state[0], s0);
+		_mm_storeu_si128((__m128i*)stream->state[1], s1);
+		_mm_storeu_si128((__m128i*)stream->state[2], s2);
+		_mm_storeu_si128((__m128i*)stream->state[3], s3);
+	}
+#endif	// A3_SIMD
+
+	// remainder (or everything without SIMD)
+	for (; i < count; ++i)
+		if (integer)
+			ui[i] = a3randomStreamInternalNext(stream);
+		else
+			f[i] = offset + scale * a3randomStreamInternalUnit(a3randomStreamInternalNext(stream));
+}
+
+
+//-----------------------------------------------------------------------------
+
+A3_INLINE a3_RandomStream* a3randomStreamInit(a3_RandomStream* stream_out, const a3ui64 key)
+{
+	a3ui64 x = key, v;
+	a3index i;
+	for (i = 0; i < 16; i += 2)
+	{
+		v = a3randomStreamInternalMix(&x);
+		stream_out->state[i >> 2][i & 3] = (a3ui32)v;
+		stream_out->state[i >> 2][(i & 3) + 1] = (a3ui32)(v >> 32);
+	}
+	stream_out->buffer[0] = stream_out->buffer[1] = stream_out->buffer[2] = stream_out->buffer[3] = 0;
+	stream_out->key = key;
+	stream_out->lane = 0;
+	return stream_out;
+}
+
+A3_INLINE a3_RandomStream* a3randomStreamSplit(a3_RandomStream* stream_out, const a3_RandomStream* parent, const a3index index)
+{
+	a3ui64 x = parent->key ^ ((a3ui64)(index + 1) * a3randomStreamInternal_gamma);
+	return a3randomStreamInit(stream_out, a3randomStreamInternalMix(&x));
+}
+
+A3_INLINE a3ui32 a3randomStreamUInt(a3_RandomStream* stream)
+{
+	return a3randomStreamInternalNext(stream);
+}
+
+A3_INLINE a3real a3randomStreamUnit(a3_RandomStream* stream)
+{
+	return a3randomStreamInternalUnit(a3randomStreamInternalNext(stream));
+}
+
+A3_INLINE a3real a3randomStreamSymmetric(a3_RandomStream* stream)
+{
+	return (a3real_two * a3randomStreamInternalUnit(a3randomStreamInternalNext(stream)) - a3real_one);
+}
+
+A3_INLINE a3real a3randomStreamRange(a3_RandomStream* stream, const a3real nMin, const a3real nMax)
+{
+	return (nMin + (nMax - nMin) * a3randomStreamInternalUnit(a3randomStreamInternalNext(stream)));
+}
+
+A3_INLINE a3integer a3randomStreamRangeInt(a3_RandomStream* stream, const a3integer nMin, const a3integer nMax)
+{
+	// multiply-shift maps full range onto [0, span)
+	const a3ui32 span = (a3ui32)(nMax - nMin);
+	return (nMin + (a3integer)(((a3ui64)a3randomStreamInternalNext(stream) * span) >> 32));
+}
+
+A3_INLINE a3real a3randomStreamNormal(a3_RandomStream* stream, const a3real mean, const a3real stddev)
+{
+	const a3real u0 = a3randomStreamInternalUnit(a3randomStreamInternalNext(stream));
+	const a3real u1 = a3randomStreamInternalUnit(a3randomStreamInternalNext(stream));
+	a3real c;
+	a3sincosInternalDegrees(u1 * (a3real)360, &c);
+	return (mean + stddev * c * a3sqrt((a3real)-2 * (a3real)a3randomStreamInternalLog((a3f32)(a3real_one - u0))));
+}
+
+A3_INLINE a3ui32* a3randomStreamFillUInt(a3_RandomStream* stream, a3ui32* values_out, const a3count count)
+{
+	a3randomStreamInternalFill(stream, values_out, count, a3real_zero, a3real_one, 1);
+	return values_out;
+}
+
+A3_INLINE a3real* a3randomStreamFillUnit(a3_RandomStream* stream, a3real* values_out, const a3count count)
+{
+	a3randomStreamInternalFill(stream, values_out, count, a3real_zero, a3real_one, 0);
+	return values_out;
+}
+
+A3_INLINE a3real* a3randomStreamFillSymmetric(a3_RandomStream* stream, a3real* values_out, const a3count count)
+{
+	a3randomStreamInternalFill(stream, values_out, count, -a3real_one, a3real_two, 0);
+	return values_out;
+}
+
+A3_INLINE a3real* a3randomStreamFillRange(a3_RandomStream* stream, a3real* values_out, const a3count count, const a3real nMin, const a3real nMax)
+{
+	a3randomStreamInternalFill(stream, values_out, count, nMin, nMax - nMin, 0);
+	return values_out;
+}
+
+A3_INLINE a3real* a3randomStreamFillNormal(a3_RandomStream* stream, a3real* values_out, const a3count count, const a3real mean, const a3real stddev)
+{
+	a3real buffer[a3randomStreamInternal_chunk];
+	a3index i, j, n;
+	for (i = 0; i < count; i += n)
+	{
+		// whole blocks of eight uniforms, copy out what is needed
+		n = count - i < a3randomStreamInternal_chunk ? count - i : a3randomStreamInternal_chunk;
+		a3randomStreamInternalFill(stream, buffer, (n + 7) & ~7u, a3real_zero, a3real_one, 0);
+		for (j = 0; j < n; j += 8)
+			a3randomStreamInternalNormalBlock(buffer + j, mean, stddev);
+		for (j = 0; j < n; ++j)
+			values_out[i + j] = buffer[j];
+	}
+	return values_out;
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+A3_END_IMPL
+
+
+#endif	// !__ANIMAL3D_A3DM_RANDOMSTREAM_IMPL_INL
+#endif	// __ANIMAL3D_A3DM_RANDOMSTREAM_H
@@ -0,0 +1,387 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	animal3D Math (A3DM) SDK
+	By Daniel S. Buckstein
+
+	a3simd_impl.inl
+	Implementations of SIMD matrix and vector functions.
+*/
+
+#ifdef __ANIMAL3D_A3DM_SIMD_H
+#ifndef __ANIMAL3D_A3DM_SIMD_IMPL_INL
+#define __ANIMAL3D_A3DM_SIMD_IMPL_INL
+
+
+A3_BEGIN_IMPL
+
+
+//-----------------------------------------------------------------------------
+// internal helpers
+
+#if (A3_SIMD >= A3_SIMD_SSE2)
+
+// multiply-add
+#if (A3_SIMD >= A3_SIMD_AVX2 && defined __FMA__)
+#define a3simdInternalMAdd(a, b, c)		_mm_fmadd_ps(a, b, c)
+#define a3simdInternalMAdd8(a, b, c)	_mm256_fmadd_ps(a, b, c)
+#else	// no fused multiply-add
+#define a3simdInternalMAdd(a, b, c)		_mm_add_ps(_mm_mul_ps(a, b), c)
+#define a3simdInternalMAdd8(a, b, c)	_mm256_add_ps(_mm256_mul_ps(a, b), c)
+#endif	// A3_SIMD_AVX2 && __FMA__
+
+// broadcast lane
+#define a3simdInternalSplat(v, i)		_mm_shuffle_ps(v, v, _MM_SHUFFLE(i, i, i, i))
+
+// clear w lane
+#define a3simdInternalMaskXYZ()			_mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1))
+
+// linear combination of columns: c0 * v.x + c1 * v.y + c2 * v.z + c3 * v.w
+A3_INLINE __m128 a3simdInternalCombine(const __m128 c0, const __m128 c1, const __m128 c2, const __m128 c3, const __m128 v)
+{
+	return a3simdInternalMAdd(c3, a3simdInternalSplat(v, 3),
+		a3simdInternalMAdd(c2, a3simdInternalSplat(v, 2),
+			a3simdInternalMAdd(c1, a3simdInternalSplat(v, 1),
+				_mm_mul_ps(c0, a3simdInternalSplat(v, 0)))));
+}
+
+// 3D cross product; w lane is zero
+A3_INLINE __m128 a3simdInternalCross(const __m128 a, const __m128 b)
+{
+	const __m128 a_yzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+	const __m128 b_yzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+	const __m128 c = _mm_sub_ps(_mm_mul_ps(a, b_yzx), _mm_mul_ps(a_yzx, b));
+	return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+}
+
+// sum of lanes, broadcast
+A3_INLINE __m128 a3simdInternalSum(const __m128 v)
+{
+	const __m128 s = _mm_add_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+	return _mm_add_ps(s, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 0, 3, 2)));
+}
+
+// inverse of 3x3 part given rows of inverse, then translation
+A3_INLINE void a3simdInternalStoreTransformInverse(a3real4x4p m_out, const __m128 r0, const __m128 r1, const __m128 r2, const __m128 t)
+{
+	__m128 c0 = r0, c1 = r1, c2 = r2, c3 = _mm_setzero_ps();
+	_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+	c3 = _mm_sub_ps(_mm_setzero_ps(), a3simdInternalMAdd(c2, a3simdInternalSplat(t, 2),
+		a3simdInternalMAdd(c1, a3simdInternalSplat(t, 1), _mm_mul_ps(c0, a3simdInternalSplat(t, 0)))));
+	c3 = _mm_or_ps(_mm_and_ps(c3, a3simdInternalMaskXYZ()), _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f));
+	_mm_storeu_ps(m_out[0], c0);
+	_mm_storeu_ps(m_out[1], c1);
+	_mm_storeu_ps(m_out[2], c2);
+	_mm_storeu_ps(m_out[3], c3);
+}
+
+#else	// scalar
+
+// inverse of 3x3 part given rows of inverse, then translation
+A3_INLINE void a3simdInternalStoreTransformInverse(a3real4x4p m_out, const a3real r[3][3], const a3real t[3])
+{
+	a3index i;
+	for (i = 0; i < 3; ++i)
+	{
+		m_out[i][0] = r[0][i];
+		m_out[i][1] = r[1][i];
+		m_out[i][2] = r[2][i];
+		m_out[i][3] = a3real_zero;
+	}
+	for (i = 0; i < 3; ++i)
+		m_out[3][i] = -(r[i][0] * t[0] + r[i][1] * t[1] + r[i][2] * t[2]);
+	m_out[3][3] = a3real_one;
+}
+
+#endif	// A3_SIMD
+
+
+//-----------------------------------------------------------------------------
+
+A3_INLINE a3real4x4r a3real4x4ProductSIMD(a3real4x4p m_out, const a3real4x4p mL, const a3real4x4p mR)
+{
+#if (A3_SIMD >= A3_SIMD_AVX2)
+	// two output columns per step
+	const __m128 l0 = _mm_loadu_ps(mL[0]), l1 = _mm_loadu_ps(mL[1]), l2 = _mm_loadu_ps(mL[2]), l3 = _mm_loadu_ps(mL[3]);
+	const __m256 L0 = _mm256_insertf128_ps(_mm256_castps128_ps256(l0), l0, 1);
+	const __m256 L1 = _mm256_insertf128_ps(_mm256_castps128_ps256(l1), l1, 1);
+	const __m256 L2 = _mm256_insertf128_ps(_mm256_castps128_ps256(l2), l2, 1);
+	const __m256 L3 = _mm256_insertf128_ps(_mm256_castps128_ps256(l3), l3, 1);
+	const __m256 r01 = _mm256_loadu_ps(mR[0]), r23 = _mm256_loadu_ps(mR[2]);
+	_mm256_storeu_ps(m_out[0], a3simdInternalMAdd8(L3, _mm256_shuffle_ps(r01, r01, 0xFF), a3simdInternalMAdd8(L2, _mm256_shuffle_ps(r01, r01, 0xAA),
+		a3simdInternalMAdd8(L1, _mm256_shuffle_ps(r01, r01, 0x55), _mm256_mul_ps(L0, _mm256_shuffle_ps(r01, r01, 0x00))))));
+	_mm256_storeu_ps(m_out[2], a3simdInternalMAdd8(L3, _mm256_shuffle_ps(r23, r23, 0xFF), a3simdInternalMAdd8(L2, _mm256_shuffle_ps(r23, r23, 0xAA),
+		a3simdInternalMAdd8(L1, _mm256_shuffle_ps(r23, r23, 0x55), _mm256_mul_ps(L0, _mm256_shuffle_ps(r23, r23, 0x00))))));
+#elif (A3_SIMD >= A3_SIMD_SSE2)
+	// each output column combines left columns
+	const __m128 l0 = _mm_loadu_ps(mL[0]), l1 = _mm_loadu_ps(mL[1]), l2 = _mm_loadu_ps(mL[2]), l3 = _mm_loadu_ps(mL[3]);
+	const __m128 r0 = _mm_loadu_ps(mR[0]), r1 = _mm_loadu_ps(mR[1]), r2 = _mm_loadu_ps(mR[2]), r3 = _mm_loadu_ps(mR[3]);
+	_mm_storeu_ps(m_out[0], a3simdInternalCombine(l0, l1, l2, l3, r0));
+	_mm_storeu_ps(m_out[1], a3simdInternalCombine(l0, l1, l2, l3, r1));
+	_mm_storeu_ps(m_out[2], a3simdInternalCombine(l0, l1, l2, l3, r2));
+	_mm_storeu_ps(m_out[3], a3simdInternalCombine(l0, l1, l2, l3, r3));
+#else	// scalar
+	a3real4x4 tmp;
+	a3index c, r;
+	for (c = 0; c < 4; ++c)
+		for (r = 0; r < 4; ++r)
+			tmp[c][r] = mL[0][r] * mR[c][0] + mL[1][r] * mR[c][1] + mL[2][r] * mR[c][2] + mL[3][r] * mR[c][3];
+	for (c = 0; c < 4; ++c)
+		for (r = 0; r < 4; ++r)
+			m_out[c][r] = tmp[c][r];
+#endif	// A3_SIMD
+	return m_out;
+}
+
+A3_INLINE a3real4x4r a3real4x4ConcatLSIMD(a3real4x4p mL_inout, const a3real4x4p mR)
+{
+	return a3real4x4ProductSIMD(mL_inout, mL_inout, mR);
+}
+
+A3_INLINE a3real4x4r a3real4x4ConcatRSIMD(const a3real4x4p mL, a3real4x4p mR_inout)
+{
+	return a3real4x4ProductSIMD(mR_inout, mL, mR_inout);
+}
+
+A3_INLINE a3real4x4r a3real4x4ProductTransformSIMD(a3real4x4p m_out, const a3real4x4p mL, const a3real4x4p mR)
+{
+#if (A3_SIMD >= A3_SIMD_SSE2)
+	// right w terms are 0, 0, 0, 1: skip three products
+	const __m128 l0 = _mm_loadu_ps(mL[0]), l1 = _mm_loadu_ps(mL[1]), l2 = _mm_loadu_ps(mL[2]), l3 = _mm_loadu_ps(mL[3]);
+	const __m128 r0 = _mm_loadu_ps(mR[0]), r1 = _mm_loadu_ps(mR[1]), r2 = _mm_loadu_ps(mR[2]), r3 = _mm_loadu_ps(mR[3]);
+	_mm_storeu_ps(m_out[0], a3simdInternalMAdd(l2, a3simdInternalSplat(r0, 2), a3simdInternalMAdd(l1, a3simdInternalSplat(r0, 1), _mm_mul_ps(l0, a3simdInternalSplat(r0, 0)))));
+	_mm_storeu_ps(m_out[1], a3simdInternalMAdd(l2, a3simdInternalSplat(r1, 2), a3simdInternalMAdd(l1, a3simdInternalSplat(r1, 1), _mm_mul_ps(l0, a3simdInternalSplat(r1, 0)))));
+	_mm_storeu_ps(m_out[2], a3simdInternalMAdd(l2, a3simdInternalSplat(r2, 2), a3simdInternalMAdd(l1, a3simdInternalSplat(r2, 1), _mm_mul_ps(l0, a3simdInternalSplat(r2, 0)))));
+	_mm_storeu_ps(m_out[3], _mm_add_ps(l3, a3simdInternalMAdd(l2, a3simdInternalSplat(r3, 2), a3simdInternalMAdd(l1, a3simdInternalSplat(r3, 1), _mm_mul_ps(l0, a3simdInternalSplat(r3, 0))))));
+	return m_out;
+#else	// scalar
+	return a3real4x4ProductSIMD(m_out, mL, mR);
+#endif	// A3_SIMD
+}
+
+
+//-----------------------------------------------------------------------------
+
+A3_INLINE a3real4r a3real4Real4x4ProductLSIMD(a3real4p v_out, const a3real4p v, const a3real4x4p m)
+{
+#if (A3_SIMD >= A3_SIMD_SSE41)
+	// dot with each column, one lane each
+	const __m128 x = _mm_loadu_ps(v);
+	_mm_storeu_ps(v_out, _mm_or_ps(
+		_mm_or_ps(_mm_dp_ps(x, _mm_loadu_ps(m[0]), 0xF1), _mm_dp_ps(x, _mm_loadu_ps(m[1]), 0xF2)),
+		_mm_or_ps(_mm_dp_ps(x, _mm_loadu_ps(m[2]), 0xF4), _mm_dp_ps(x, _mm_loadu_ps(m[3]), 0xF8))));
+#elif (A3_SIMD >= A3_SIMD_SSE2)
+	// transpose then combine
+	__m128 c0 = _mm_loadu_ps(m[0]), c1 = _mm_loadu_ps(m[1]), c2 = _mm_loadu_ps(m[2]), c3 = _mm_loadu_ps(m[3]);
+	_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+	_mm_storeu_ps(v_out, a3simdInternalCombine(c0, c1, c2, c3, _mm_loadu_ps(v)));
+#else	// scalar
+	const a3real x = v[0], y = v[1], z = v[2], w = v[3];
+	a3index c;
+	for (c = 0; c < 4; ++c)
+		v_out[c] = x * m[c][0] + y * m[c][1] + z * m[c][2] + w * m[c][3];
+#endif	// A3_SIMD
+	return v_out;
+}
+
+A3_INLINE a3real4r a3real4Real4x4ProductRSIMD(a3real4p v_out, const a3real4x4p m, const a3real4p v)
+{
+#if (A3_SIMD >= A3_SIMD_SSE2)
+	_mm_storeu_ps(v_out, a3simdInternalCombine(_mm_loadu_ps(m[0]), _mm_loadu_ps(m[1]), _mm_loadu_ps(m[2]), _mm_loadu_ps(m[3]), _mm_loadu_ps(v)));
+#else	// scalar
+	const a3real x = v[0], y = v[1], z = v[2], w = v[3];
+	a3index r;
+	for (r = 0; r < 4; ++r)
+		v_out[r] = m[0][r] * x + m[1][r] * y + m[2][r] * z + m[3][r] * w;
+#endif	// A3_SIMD
+	return v_out;
+}
+
+A3_INLINE a3real4r a3real4Real4x4MulLSIMD(a3real4p v_inout, const a3real4x4p m)
+{
+	return a3real4Real4x4ProductLSIMD(v_inout, v_inout, m);
+}
+
+A3_INLINE a3real4r a3real4Real4x4MulRSIMD(const a3real4x4p m, a3real4p v_inout)
+{
+	return a3real4Real4x4ProductRSIMD(v_inout, m, v_inout);
+}
+
+
+//-----------------------------------------------------------------------------
+
+A3_INLINE a3real4x4r a3real4x4GetTransposedSIMD(a3real4x4p m_out, const a3real4x4p m)
+{
+#if (A3_SIMD >= A3_SIMD_SSE2)
+	__m128 c0 = _mm_loadu_ps(m[0]), c1 = _mm_loadu_ps(m[1]), c2 = _mm_loadu_ps(m[2]), c3 = _mm_loadu_ps(m[3]);
+	_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+	_mm_storeu_ps(m_out[0], c0);
+	_mm_storeu_ps(m_out[1], c1);
+	_mm_storeu_ps(m_out[2], c2);
+	_mm_storeu_ps(m_out[3], c3);
+#else	// scalar
+	a3real tmp;
+	a3index c, r;
+	for (c = 0; c < 4; ++c)
+	{
+		m_out[c][c] = m[c][c];
+		for (r = c + 1; r < 4; ++r)
+		{
+			tmp = m[c][r];
+			m_out[c][r] = m[r][c];
+			m_out[r][c] = tmp;
+		}
+	}
+#endif	// A3_SIMD
+	return m_out;
+}
+
+A3_INLINE a3real4x4r a3real4x4TransposeSIMD(a3real4x4p m_inout)
+{
+	return a3real4x4GetTransposedSIMD(m_inout, m_inout);
+}
+
+A3_INLINE a3real a3real4x4DeterminantSIMD(const a3real4x4p m)
+{
+#if (A3_SIMD >= A3_SIMD_SSE2)
+	// Laplace expansion over 2x2 minors of columns (a, b) and (c, d)
+	const __m128 a = _mm_loadu_ps(m[0]), b = _mm_loadu_ps(m[1]), c = _mm_loadu_ps(m[2]), d = _mm_loadu_ps(m[3]);
+
+	// ab: [01, 02, 03, 12], [13, 23, -, -]
+	const __m128 ab0 = _mm_sub_ps(
+		_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 0, 0, 0)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 2, 1))),
+		_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 2, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 0, 0))));
+	const __m128 ab1 = _mm_sub_ps(
+		_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 2, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 0, 3, 3))),
+		_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 0, 2, 1))));
+
+	// cd: [23, 13, 12, 03], [02, 01, -, -]
+	const __m128 cd0 = _mm_sub_ps(
+		_mm_mul_ps(_mm_shuffle_ps(c, c, _MM_SHUFFLE(0, 1, 1, 2)), _mm_shuffle_ps(d, d, _MM_SHUFFLE(3, 2, 3, 3))),
+		_mm_mul_ps(_mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 2, 3, 3)), _mm_shuffle_ps(d, d, _MM_SHUFFLE(0, 1, 1, 2))));
+	const __m128 cd1 = _mm_sub_ps(
+		_mm_mul_ps(_mm_shuffle_ps(c, c, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(d, d, _MM_SHUFFLE(0, 0, 1, 2))),
+		_mm_mul_ps(_mm_shuffle_ps(c, c, _MM_SHUFFLE(0, 0, 1, 2)), _mm_shuffle_ps(d, d, _MM_SHUFFLE(0, 0, 0, 0))));
+
+	// signs: + - + + | - + (unused lanes zeroed)
+	const __m128 s = _mm_add_ps(
+		_mm_mul_ps(_mm_mul_ps(ab0, cd0), _mm_set_ps(+1.0f, +1.0f, -1.0f, +1.0f)),
+		_mm_mul_ps(_mm_mul_ps(ab1, cd1), _mm_set_ps(0.0f, 0.0f, +1.0f, -1.0f)));
+	return _mm_cvtss_f32(a3simdInternalSum(s));
+#else	// scalar
+	const a3real s0 = m[0][0] * m[1][1] - m[0][1] * m[1][0], s1 = m[0][0] * m[1][2] - m[0][2] * m[1][0];
+	const a3real s2 = m[0][0] * m[1][3] - m[0][3] * m[1][0], s3 = m[0][1] * m[1][2] - m[0][2] * m[1][1];
+	const a3real s4 = m[0][1] * m[1][3] - m[0][3] * m[1][1], s5 = m[0][2] * m[1][3] - m[0][3] * m[1][2];
+	const a3real c5 = m[2][2] * m[3][3] - m[2][3] * m[3][2], c4 = m[2][1] * m[3][3] - m[2][3] * m[3][1];
+	const a3real c3 = m[2][1] * m[3][2] - m[2][2] * m[3][1], c2 = m[2][0] * m[3][3] - m[2][3] * m[3][0];
+	const a3real c1 = m[2][0] * m[3][2] - m[2][2] * m[3][0], c0 = m[2][0] * m[3][1] - m[2][1] * m[3][0];
+	return (s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0);
+#endif	// A3_SIMD
+}
+
+
+//-----------------------------------------------------------------------------
+
+A3_INLINE a3real4x4r a3real4x4TransformInverseSIMD(a3real4x4p m_out, const a3real4x4p m)
+{
+#if (A3_SIMD >= A3_SIMD_SSE2)
+	// rows of inverse 3x3 are cross products of columns over determinant
+	const __m128 mask = a3simdInternalMaskXYZ();
+	const __m128 x = _mm_and_ps(_mm_loadu_ps(m[0]), mask), y = _mm_and_ps(_mm_loadu_ps(m[1]), mask), z = _mm_and_ps(_mm_loadu_ps(m[2]), mask);
+	const __m128 r0 = a3simdInternalCross(y, z), r1 = a3simdInternalCross(z, x), r2 = a3simdInternalCross(x, y);
+	const __m128 det = a3simdInternalSum(_mm_mul_ps(x, r0));
+	const __m128 detInv = _mm_cvtss_f32(det) != 0.0f ? _mm_div_ps(_mm_set1_ps(1.0f), det) : _mm_setzero_ps();
+	a3simdInternalStoreTransformInverse(m_out, _mm_mul_ps(r0, detInv), _mm_mul_ps(r1, detInv), _mm_mul_ps(r2, detInv), _mm_loadu_ps(m[3]));
+#else	// scalar
+	const a3real t[3] = { m[3][0], m[3][1], m[3][2] };
+	a3real r[3][3], det;
+	a3index i;
+	r[0][0] = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+	r[0][1] = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+	r[0][2] = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+	r[1][0] = m[2][1] * m[0][2] - m[2][2] * m[0][1];
+	r[1][1] = m[2][2] * m[0][0] - m[2][0] * m[0][2];
+	r[1][2] = m[2][0] * m[0][1] - m[2][1] * m[0][0];
+	r[2][0] = m[0][1] * m[1][2] - m[0][2] * m[1][1];
+	r[2][1] = m[0][2] * m[1][0] - m[0][0] * m[1][2];
+	r[2][2] = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+	det = m[0][0] * r[0][0] + m[0][1] * r[0][1] + m[0][2] * r[0][2];
+	det = det != a3real_zero ? a3real_one / det : a3real_zero;
+	for (i = 0; i < 3; ++i)
+	{
+		r[i][0] *= det;
+		r[i][1] *= det;
+		r[i][2] *= det;
+	}
+	a3simdInternalStoreTransformInverse(m_out, r, t);
+#endif	// A3_SIMD
+	return m_out;
+}
+
+A3_INLINE a3real4x4r a3real4x4TransformInverseIgnoreScaleSIMD(a3real4x4p m_out, const a3real4x4p m)
+{
+#if (A3_SIMD >= A3_SIMD_SSE2)
+	// rotation inverse is its transpose
+	const __m128 mask = a3simdInternalMaskXYZ();
+	a3simdInternalStoreTransformInverse(m_out,
+		_mm_and_ps(_mm_loadu_ps(m[0]), mask), _mm_and_ps(_mm_loadu_ps(m[1]), mask), _mm_and_ps(_mm_loadu_ps(m[2]), mask),
+		_mm_loadu_ps(m[3]));
+#else	// scalar
+	const a3real t[3] = { m[3][0], m[3][1], m[3][2] };
+	const a3real r[3][3] = {
+		{ m[0][0], m[0][1], m[0][2] },
+		{ m[1][0], m[1][1], m[1][2] },
+		{ m[2][0], m[2][1], m[2][2] },
+	};
+	a3simdInternalStoreTransformInverse(m_out, r, t);
+#endif	// A3_SIMD
+	return m_out;
+}
+
+A3_INLINE a3real4x4r a3real4x4TransformInverseUniformScaleSIMD(a3real4x4p m_out, const a3real4x4p m)
+{
+#if (A3_SIMD >= A3_SIMD_SSE2)
+	// transpose over squared scale
+	const __m128 mask = a3simdInternalMaskXYZ();
+	const __m128 x = _mm_and_ps(_mm_loadu_ps(m[0]), mask), y = _mm_and_ps(_mm_loadu_ps(m[1]), mask), z = _mm_and_ps(_mm_loadu_ps(m[2]), mask);
+	const __m128 sq = a3simdInternalSum(_mm_mul_ps(x, x));
+	const __m128 sqInv = _mm_cvtss_f32(sq) != 0.0f ? _mm_div_ps(_mm_set1_ps(1.0f), sq) : _mm_setzero_ps();
+	a3simdInternalStoreTransformInverse(m_out, _mm_mul_ps(x, sqInv), _mm_mul_ps(y, sqInv), _mm_mul_ps(z, sqInv), _mm_loadu_ps(m[3]));
+#else	// scalar
+	const a3real t[3] = { m[3][0], m[3][1], m[3][2] };
+	const a3real sq = m[0][0] * m[0][0] + m[0][1] * m[0][1] + m[0][2] * m[0][2];
+	const a3real s = sq != a3real_zero ? a3real_one / sq : a3real_zero;
+	const a3real r[3][3] = {
+		{ m[0][0] * s, m[0][1] * s, m[0][2] * s },
+		{ m[1][0] * s, m[1][1] * s, m[1][2] * s },
+		{ m[2][0] * s, m[2][1] * s, m[2][2] * s },
+	};
+	a3simdInternalStoreTransformInverse(m_out, r, t);
+#endif	// A3_SIMD
+	return m_out;
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+A3_END_IMPL
+
+
+#endif	// !__ANIMAL3D_A3DM_SIMD_IMPL_INL
+#endif	// __ANIMAL3D_A3DM_SIMD_H
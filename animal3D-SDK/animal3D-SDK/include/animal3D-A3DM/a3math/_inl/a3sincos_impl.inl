@@ -0,0 +1,327 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	animal3D Math (A3DM) SDK
+	By Daniel S. Buckstein
+
+	a3sincos_impl.inl
+	Implementations of polynomial sine and cosine.
+*/
+
+#ifdef __ANIMAL3D_A3DM_SINCOS_H
+#ifndef __ANIMAL3D_A3DM_SINCOS_IMPL_INL
+#define __ANIMAL3D_A3DM_SINCOS_IMPL_INL
+
+
+A3_BEGIN_IMPL
+
+
+//-----------------------------------------------------------------------------
+// internal helpers
+
+// minimax coefficients on [-pi/4, +pi/4] (Cephes sinf/cosf)
+#define a3sincosInternal_s1		-1.6666654611e-1f
+#define a3sincosInternal_s2		+8.3321608736e-3f
+#define a3sincosInternal_s3		-1.9515295891e-4f
+#define a3sincosInternal_c1		+4.166664568298827e-2f
+#define a3sincosInternal_c2		-1.388731625493765e-3f
+#define a3sincosInternal_c3		+2.443315711809948e-5f
+
+// pi/2 split so that k * part1 is exact for |k| < 2^15 (Cody-Waite)
+#define a3sincosInternal_pio2_1	1.5703125f
+#define a3sincosInternal_pio2_2	4.837512969970703125e-4f
+#define a3sincosInternal_pio2_3	7.54978995489188216e-8f
+#define a3sincosInternal_2opi	0.636619772367581343f
+#define a3sincosInternal_d2r	0.0174532925199432958f
+
+// nearest integer
+A3_INLINE a3i32 a3sincosInternalRound(const a3real x)
+{
+#if (A3_SIMD >= A3_SIMD_SSE2)
+	return _mm_cvtss_si32(_mm_set_ss(x));
+#else	// scalar
+	return (a3i32)(x >= a3real_zero ? x + a3real_half : x - a3real_half);
+#endif	// A3_SIMD
+}
+
+// evaluate reduced argument r in [-pi/4, +pi/4] at quadrant k
+A3_INLINE a3real a3sincosInternalEval(const a3real r, const a3i32 k, a3real* cos_out)
+{
+	// quadrant selects and signs by index, no branches on k
+	const a3real z = r * r;
+	a3real sc[2];
+	sc[0] = r + r * z * ((a3real)a3sincosInternal_s1 + z * ((a3real)a3sincosInternal_s2 + z * (a3real)a3sincosInternal_s3));
+	sc[1] = a3real_one - a3real_half * z + z * z * ((a3real)a3sincosInternal_c1 + z * ((a3real)a3sincosInternal_c2 + z * (a3real)a3sincosInternal_c3));
+	if (cos_out)
+		*cos_out = sc[(k + 1) & 1] * (a3real)(1 - ((k + 1) & 2));
+	return sc[k & 1] * (a3real)(1 - (k & 2));
+}
+
+A3_INLINE a3real a3sincosInternalDegrees(const a3real x, a3real* cos_out)
+{
+	// reduction by multiples of 90 degrees is exact
+	const a3i32 k = a3sincosInternalRound(x * (a3real)(1.0 / 90.0));
+	return a3sincosInternalEval((x - (a3real)k * (a3real)90) * (a3real)a3sincosInternal_d2r, k, cos_out);
+}
+
+A3_INLINE a3real a3sincosInternalRadians(const a3real x, a3real* cos_out)
+{
+	const a3i32 k = a3sincosInternalRound(x * (a3real)a3sincosInternal_2opi);
+	const a3real kr = (a3real)k;
+	return a3sincosInternalEval(((x - kr * (a3real)a3sincosInternal_pio2_1) - kr * (a3real)a3sincosInternal_pio2_2) - kr * (a3real)a3sincosInternal_pio2_3, k, cos_out);
+}
+
+#if (A3_SIMD >= A3_SIMD_SSE2)
+// select a where mask is set, otherwise b
+A3_INLINE __m128 a3sincosInternalSelectSSE(const __m128 mask, const __m128 a, const __m128 b)
+{
+#if (A3_SIMD >= A3_SIMD_SSE41)
+	return _mm_blendv_ps(b, a, mask);
+#else	// SSE2
+	return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+#endif	// A3_SIMD
+}
+
+A3_INLINE __m128 a3sincosInternalEvalSSE(const __m128 r, const __m128i k, __m128* cos_out)
+{
+	const __m128 z = _mm_mul_ps(r, r);
+	const __m128i one = _mm_set1_epi32(1), two = _mm_set1_epi32(2);
+	__m128 ps = a3simdInternalMAdd(_mm_set1_ps(a3sincosInternal_s3), z, _mm_set1_ps(a3sincosInternal_s2));
+	__m128 pc = a3simdInternalMAdd(_mm_set1_ps(a3sincosInternal_c3), z, _mm_set1_ps(a3sincosInternal_c2));
+	__m128 s, c, swap;
+	ps = a3simdInternalMAdd(ps, z, _mm_set1_ps(a3sincosInternal_s1));
+	pc = a3simdInternalMAdd(pc, z, _mm_set1_ps(a3sincosInternal_c1));
+	s = a3simdInternalMAdd(_mm_mul_ps(r, z), ps, r);
+	c = a3simdInternalMAdd(_mm_mul_ps(z, z), pc, _mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(_mm_set1_ps(0.5f), z)));
+
+	// odd quadrants swap; sign bits from quadrant bits
+	swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(k, one), one));
+	*cos_out = _mm_xor_ps(a3sincosInternalSelectSSE(swap, s, c), _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(k, one), two), 30)));
+	return _mm_xor_ps(a3sincosInternalSelectSSE(swap, c, s), _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(k, two), 30)));
+}
+
+A3_INLINE __m128 a3sincosInternalDegreesSSE(const __m128 x, __m128* cos_out)
+{
+	const __m128i k = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(1.0f / 90.0f)));
+	const __m128 r = a3simdInternalMAdd(_mm_cvtepi32_ps(k), _mm_set1_ps(-90.0f), x);
+	return a3sincosInternalEvalSSE(_mm_mul_ps(r, _mm_set1_ps(a3sincosInternal_d2r)), k, cos_out);
+}
+
+A3_INLINE __m128 a3sincosInternalRadiansSSE(const __m128 x, __m128* cos_out)
+{
+	const __m128i k = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(a3sincosInternal_2opi)));
+	const __m128 kr = _mm_cvtepi32_ps(k);
+	__m128 r = a3simdInternalMAdd(kr, _mm_set1_ps(-a3sincosInternal_pio2_1), x);
+	r = a3simdInternalMAdd(kr, _mm_set1_ps(-a3sincosInternal_pio2_2), r);
+	r = a3simdInternalMAdd(kr, _mm_set1_ps(-a3sincosInternal_pio2_3), r);
+	return a3sincosInternalEvalSSE(r, k, cos_out);
+}
+#endif	// A3_SIMD
+
+A3_INLINE a3real* a3sincosInternalArray(a3real* sin_out, a3real* cos_out, const a3real* x, const a3count count, const a3boolean degrees)
+{
+	a3index i = 0;
+#if (A3_SIMD >= A3_SIMD_SSE2)
+	a3real xt[4], st[4], ct[4];
+	a3index j, n;
+	__m128 s, c;
+	for (; i < count; i += 4)
+	{
+		// last partial block goes through local storage
+		n = count - i;
+		if (n >= 4)
+			s = degrees ? a3sincosInternalDegreesSSE(_mm_loadu_ps(x + i), &c) : a3sincosInternalRadiansSSE(_mm_loadu_ps(x + i), &c);
+		else
+		{
+			for (j = 0; j < 4; ++j)
+				xt[j] = j < n ? x[i + j] : a3real_zero;
+			s = degrees ? a3sincosInternalDegreesSSE(_mm_loadu_ps(xt), &c) : a3sincosInternalRadiansSSE(_mm_loadu_ps(xt), &c);
+		}
+		if (n >= 4)
+		{
+			if (sin_out)
+				_mm_storeu_ps(sin_out + i, s);
+			if (cos_out)
+				_mm_storeu_ps(cos_out + i, c);
+		}
+		else
+		{
+			_mm_storeu_ps(st, s);
+			_mm_storeu_ps(ct, c);
+			for (j = 0; j < n; ++j)
+			{
+				if (sin_out)
+					sin_out[i + j] = st[j];
+				if (cos_out)
+					cos_out[i + j] = ct[j];
+			}
+		}
+	}
+#else	// scalar
+	a3real s, c;
+	for (; i < count; ++i)
+	{
+		s = degrees ? a3sincosInternalDegrees(x[i], &c) : a3sincosInternalRadians(x[i], &c);
+		if (sin_out)
+			sin_out[i] = s;
+		if (cos_out)
+			cos_out[i] = c;
+	}
+#endif	// A3_SIMD
+	return sin_out;
+}
+
+// sines and cosines of three angles in degrees, scaled first (half angles for quaternions)
+A3_INLINE void a3sincosInternalEuler(a3real s_out[4], a3real c_out[4], const a3real degrees_x, const a3real degrees_y, const a3real degrees_z, const a3real scale)
+{
+#if (A3_SIMD >= A3_SIMD_SSE2)
+	__m128 c;
+	_mm_storeu_ps(s_out, a3sincosInternalDegreesSSE(_mm_mul_ps(_mm_set_ps(0.0f, degrees_z, degrees_y, degrees_x), _mm_set1_ps(scale)), &c));
+	_mm_storeu_ps(c_out, c);
+#else	// scalar
+	s_out[0] = a3sincosInternalDegrees(degrees_x * scale, c_out + 0);
+	s_out[1] = a3sincosInternalDegrees(degrees_y * scale, c_out + 1);
+	s_out[2] = a3sincosInternalDegrees(degrees_z * scale, c_out + 2);
+#endif	// A3_SIMD
+}
+
+// zero translation and projection parts of rotation matrix
+A3_INLINE void a3sincosInternalRotationBorder(a3real4x4p m_out)
+{
+	m_out[0][3] = m_out[1][3] = m_out[2][3] = a3real_zero;
+	m_out[3][0] = m_out[3][1] = m_out[3][2] = a3real_zero;
+	m_out[3][3] = a3real_one;
+}
+
+
+//-----------------------------------------------------------------------------
+
+A3_INLINE a3real a3sindPoly(const a3real x)
+{
+	return a3sincosInternalDegrees(x, 0);
+}
+
+A3_INLINE a3real a3cosdPoly(const a3real x)
+{
+	a3real c;
+	a3sincosInternalDegrees(x, &c);
+	return c;
+}
+
+A3_INLINE a3real a3sincosdPoly(const a3real x, a3real* cos_out)
+{
+	return a3sincosInternalDegrees(x, cos_out);
+}
+
+A3_INLINE a3real a3sinrPoly(const a3real x)
+{
+	return a3sincosInternalRadians(x, 0);
+}
+
+A3_INLINE a3real a3cosrPoly(const a3real x)
+{
+	a3real c;
+	a3sincosInternalRadians(x, &c);
+	return c;
+}
+
+A3_INLINE a3real a3sincosrPoly(const a3real x, a3real* cos_out)
+{
+	return a3sincosInternalRadians(x, cos_out);
+}
+
+A3_INLINE a3real* a3sincosdArray(a3real* sin_out, a3real* cos_out, const a3real* x, const a3count count)
+{
+	return a3sincosInternalArray(sin_out, cos_out, x, count, 1);
+}
+
+A3_INLINE a3real* a3sincosrArray(a3real* sin_out, a3real* cos_out, const a3real* x, const a3count count)
+{
+	return a3sincosInternalArray(sin_out, cos_out, x, count, 0);
+}
+
+
+//-----------------------------------------------------------------------------
+
+A3_INLINE a3real4x4r a3real4x4SetRotateXYZPoly(a3real4x4p m_out, const a3real degrees_x, const a3real degrees_y, const a3real degrees_z)
+{
+	a3real s[4], c[4];
+	a3sincosInternalEuler(s, c, degrees_x, degrees_y, degrees_z, a3real_one);
+	m_out[0][0] = c[1] * c[2];
+	m_out[0][1] = c[0] * s[2] + s[0] * s[1] * c[2];
+	m_out[0][2] = s[0] * s[2] - c[0] * s[1] * c[2];
+	m_out[1][0] = -c[1] * s[2];
+	m_out[1][1] = c[0] * c[2] - s[0] * s[1] * s[2];
+	m_out[1][2] = s[0] * c[2] + c[0] * s[1] * s[2];
+	m_out[2][0] = s[1];
+	m_out[2][1] = -s[0] * c[1];
+	m_out[2][2] = c[0] * c[1];
+	a3sincosInternalRotationBorder(m_out);
+	return m_out;
+}
+
+A3_INLINE a3real4x4r a3real4x4SetRotateZYXPoly(a3real4x4p m_out, const a3real degrees_x, const a3real degrees_y, const a3real degrees_z)
+{
+	a3real s[4], c[4];
+	a3sincosInternalEuler(s, c, degrees_x, degrees_y, degrees_z, a3real_one);
+	m_out[0][0] = c[2] * c[1];
+	m_out[0][1] = s[2] * c[1];
+	m_out[0][2] = -s[1];
+	m_out[1][0] = c[2] * s[1] * s[0] - s[2] * c[0];
+	m_out[1][1] = c[2] * c[0] + s[2] * s[1] * s[0];
+	m_out[1][2] = c[1] * s[0];
+	m_out[2][0] = s[2] * s[0] + c[2] * s[1] * c[0];
+	m_out[2][1] = s[2] * s[1] * c[0] - c[2] * s[0];
+	m_out[2][2] = c[1] * c[0];
+	a3sincosInternalRotationBorder(m_out);
+	return m_out;
+}
+
+A3_INLINE a3real4r a3quatSetEulerXYZPoly(a3real4p q_out, const a3real degrees_x, const a3real degrees_y, const a3real degrees_z)
+{
+	// qx * qy * qz from half angles
+	a3real s[4], c[4];
+	a3sincosInternalEuler(s, c, degrees_x, degrees_y, degrees_z, a3real_half);
+	q_out[0] = s[0] * c[1] * c[2] + c[0] * s[1] * s[2];
+	q_out[1] = c[0] * s[1] * c[2] - s[0] * c[1] * s[2];
+	q_out[2] = c[0] * c[1] * s[2] + s[0] * s[1] * c[2];
+	q_out[3] = c[0] * c[1] * c[2] - s[0] * s[1] * s[2];
+	return q_out;
+}
+
+A3_INLINE a3real4r a3quatSetEulerZYXPoly(a3real4p q_out, const a3real degrees_x, const a3real degrees_y, const a3real degrees_z)
+{
+	// qz * qy * qx from half angles
+	a3real s[4], c[4];
+	a3sincosInternalEuler(s, c, degrees_x, degrees_y, degrees_z, a3real_half);
+	q_out[0] = s[0] * c[1] * c[2] - c[0] * s[1] * s[2];
+	q_out[1] = c[0] * s[1] * c[2] + s[0] * c[1] * s[2];
+	q_out[2] = c[0] * c[1] * s[2] - s[0] * s[1] * c[2];
+	q_out[3] = c[0] * c[1] * c[2] + s[0] * s[1] * s[2];
+	return q_out;
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+A3_END_IMPL
+
+
+#endif	// !__ANIMAL3D_A3DM_SINCOS_IMPL_INL
+#endif	// __ANIMAL3D_A3DM_SINCOS_H
@@ -0,0 +1,84 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	animal3D Math (A3DM) SDK
+	By Daniel S. Buckstein
+
+	a3sqrt_impl.inl
+	Implementations of square root functions.
+*/
+
+#ifdef __ANIMAL3D_A3DM_SQRT_H
+#ifndef __ANIMAL3D_A3DM_SQRT_IMPL_INL
+#define __ANIMAL3D_A3DM_SQRT_IMPL_INL
+
+
+#include <math.h>
+
+
+A3_BEGIN_IMPL
+
+
+//-----------------------------------------------------------------------------
+
+A3_INLINE a3f32 a3sqrtf0xInverse(const a3f32 x)
+{
+	// reinterpret bits through union to stay clear of aliasing rules
+	union { a3f32 f; a3i32 i; } y;
+	y.f = x;
+	y.i = 0x5f3759df - (y.i >> 1);
+	y.f *= 1.5f - 0.5f * x * y.f * y.f;
+	return y.f;
+}
+
+A3_INLINE a3f32 a3sqrtf0x(const a3f32 x)
+{
+	return (x * a3sqrtf0xInverse(x));
+}
+
+
+A3_INLINE a3f32 a3sqrtf(const a3f32 x)
+{
+	return sqrtf(x);
+}
+
+A3_INLINE a3f64 a3sqrtd(const a3f64 x)
+{
+	return sqrt(x);
+}
+
+A3_INLINE a3f32 a3sqrtfInverse(const a3f32 x)
+{
+	return (1.0f / sqrtf(x));
+}
+
+A3_INLINE a3f64 a3sqrtdInverse(const a3f64 x)
+{
+	return (1.0 / sqrt(x));
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+A3_END_IMPL
+
+
+#endif	// !__ANIMAL3D_A3DM_SQRT_IMPL_INL
+#endif	// __ANIMAL3D_A3DM_SQRT_H
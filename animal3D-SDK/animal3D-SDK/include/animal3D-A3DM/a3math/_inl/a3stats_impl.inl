@@ -0,0 +1,165 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	animal3D Math (A3DM) SDK
+	By Daniel S. Buckstein
+
+	a3stats_impl.inl
+	Implementations of statistics functions.
+*/
+
+#ifdef __ANIMAL3D_A3DM_STATS_H
+#ifndef __ANIMAL3D_A3DM_STATS_IMPL_INL
+#define __ANIMAL3D_A3DM_STATS_IMPL_INL
+
+
+#include "../a3sqrt.h"
+
+
+A3_BEGIN_IMPL
+
+
+//-----------------------------------------------------------------------------
+
+// median assumes data set is sorted
+A3_INLINE a3real a3median(const a3real data[], const a3count n)
+{
+	const a3count i = n / 2;
+	if (!n)
+		return a3real_zero;
+	return (n % 2) ? data[i] : a3real_half * (data[i] + data[i - 1]);
+}
+
+A3_INLINE a3real a3medianInt(const a3integer data[], const a3count n)
+{
+	const a3count i = n / 2;
+	if (!n)
+		return a3real_zero;
+	return (n % 2) ? (a3real)data[i] : a3real_half * (a3real)(data[i] + data[i - 1]);
+}
+
+
+A3_INLINE a3real a3mean(const a3real data[], const a3count n)
+{
+	a3real sum = a3real_zero;
+	a3index i;
+	if (!n)
+		return sum;
+	for (i = 0; i < n; ++i)
+		sum += data[i];
+	return (sum / (a3real)n);
+}
+
+A3_INLINE a3real a3meanInt(const a3integer data[], const a3count n)
+{
+	a3biginteger sum = 0;
+	a3index i;
+	if (!n)
+		return a3real_zero;
+	for (i = 0; i < n; ++i)
+		sum += data[i];
+	return ((a3real)sum / (a3real)n);
+}
+
+
+A3_INLINE a3real a3variance(const a3real data[], const a3count n, a3real *mean_out)
+{
+	const a3real mean = a3mean(data, n);
+	a3real sum = a3real_zero, d;
+	a3index i;
+	for (i = 0; i < n; ++i)
+	{
+		d = data[i] - mean;
+		sum += d * d;
+	}
+	if (mean_out)
+		*mean_out = mean;
+	return (n ? sum / (a3real)n : a3real_zero);
+}
+
+A3_INLINE a3real a3varianceInt(const a3integer data[], const a3count n, a3real *mean_out)
+{
+	const a3real mean = a3meanInt(data, n);
+	a3real sum = a3real_zero, d;
+	a3index i;
+	for (i = 0; i < n; ++i)
+	{
+		d = (a3real)data[i] - mean;
+		sum += d * d;
+	}
+	if (mean_out)
+		*mean_out = mean;
+	return (n ? sum / (a3real)n : a3real_zero);
+}
+
+
+A3_INLINE a3real a3standardDeviation(const a3real data[], const a3count n, a3real *mean_out)
+{
+	return a3sqrt(a3variance(data, n, mean_out));
+}
+
+A3_INLINE a3real a3standardDeviationInt(const a3integer data[], const a3count n, a3real *mean_out)
+{
+	return a3sqrt(a3varianceInt(data, n, mean_out));
+}
+
+
+A3_INLINE a3biginteger a3factorial(a3bigcount n)
+{
+	a3biginteger ret = 1;
+	while (n > 1)
+		ret *= (a3biginteger)(n--);
+	return ret;
+}
+
+A3_INLINE a3biginteger a3permutations(const a3bigcount n, const a3bigindex k)
+{
+	// n! / (n - k)! without computing either factorial
+	a3biginteger ret = 1;
+	a3bigcount i;
+	if (k > n)
+		return 0;
+	for (i = n - k + 1; i <= n; ++i)
+		ret *= (a3biginteger)i;
+	return ret;
+}
+
+A3_INLINE a3biginteger a3combinations(const a3bigcount n, const a3bigindex k)
+{
+	// multiplicative form stays exact: every partial product is itself 
+	//	a binomial coefficient
+	const a3bigindex r = (k < n - k) ? k : n - k;
+	a3biginteger ret = 1;
+	a3bigindex i;
+	if (k > n)
+		return 0;
+	for (i = 1; i <= r; ++i)
+		ret = ret * (a3biginteger)(n - r + i) / (a3biginteger)i;
+	return ret;
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+A3_END_IMPL
+
+
+#endif	// !__ANIMAL3D_A3DM_STATS_IMPL_INL
+#endif	// __ANIMAL3D_A3DM_STATS_H
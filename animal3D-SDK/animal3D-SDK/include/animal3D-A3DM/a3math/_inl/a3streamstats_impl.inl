@@ -0,0 +1,280 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	animal3D Math (A3DM) SDK
+	By Daniel S. Buckstein
+
+	a3streamstats_impl.inl
+	Implementations of online statistics.
+*/
+
+#ifdef __ANIMAL3D_A3DM_STREAMSTATS_H
+#ifndef __ANIMAL3D_A3DM_STREAMSTATS_IMPL_INL
+#define __ANIMAL3D_A3DM_STREAMSTATS_IMPL_INL
+
+
+A3_BEGIN_IMPL
+
+
+//-----------------------------------------------------------------------------
+// internal helpers
+
+// insertion sort for the first few quantile samples
+A3_INLINE void a3streamStatsInternalSort(a3f64* values, const a3count count)
+{
+	a3f64 v;
+	a3index i, j;
+	for (i = 1; i < count; ++i)
+	{
+		v = values[i];
+		for (j = i; j > 0 && values[j - 1] > v; --j)
+			values[j] = values[j - 1];
+		values[j] = v;
+	}
+}
+
+// P-squared marker adjustment: parabolic, falling back to linear
+A3_INLINE a3f64 a3streamStatsInternalAdjust(const a3_StreamQuantile* quantile, const a3index i, const a3f64 d)
+{
+	const a3f64* const q = quantile->height;
+	const a3f64* const n = quantile->pos;
+	const a3f64 qp = q[i] + d / (n[i + 1] - n[i - 1]) *
+		((n[i] - n[i - 1] + d) * (q[i + 1] - q[i]) / (n[i + 1] - n[i]) +
+		(n[i + 1] - n[i] - d) * (q[i] - q[i - 1]) / (n[i] - n[i - 1]));
+	if (q[i - 1] < qp && qp < q[i + 1])
+		return qp;
+	return (d > 0.0 ? q[i] + (q[i + 1] - q[i]) / (n[i + 1] - n[i]) : q[i] - (q[i - 1] - q[i]) / (n[i - 1] - n[i]));
+}
+
+
+//-----------------------------------------------------------------------------
+
+A3_INLINE a3_StreamStats* a3streamStatsInit(a3_StreamStats* stats_out)
+{
+	stats_out->count = 0;
+	stats_out->mean = stats_out->m2 = 0.0;
+	stats_out->min = stats_out->max = 0.0;
+	return stats_out;
+}
+
+A3_INLINE a3_StreamStats* a3streamStatsAdd(a3_StreamStats* stats, const a3f64 x)
+{
+	// Welford: update mean, then sum of squares with old and new deviation
+	const a3f64 d = x - stats->mean;
+	if (stats->count++)
+	{
+		stats->min = x < stats->min ? x : stats->min;
+		stats->max = x > stats->max ? x : stats->max;
+	}
+	else
+		stats->min = stats->max = x;
+	stats->mean += d / (a3f64)stats->count;
+	stats->m2 += d * (x - stats->mean);
+	return stats;
+}
+
+A3_INLINE a3_StreamStats* a3streamStatsMerge(a3_StreamStats* stats_out, const a3_StreamStats* stats)
+{
+	a3f64 d, n;
+	if (stats->count)
+	{
+		if (stats_out->count)
+		{
+			n = (a3f64)(stats_out->count + stats->count);
+			d = stats->mean - stats_out->mean;
+			stats_out->m2 += stats->m2 + d * d * (a3f64)stats_out->count * (a3f64)stats->count / n;
+			stats_out->mean += d * (a3f64)stats->count / n;
+			stats_out->count += stats->count;
+			stats_out->min = stats->min < stats_out->min ? stats->min : stats_out->min;
+			stats_out->max = stats->max > stats_out->max ? stats->max : stats_out->max;
+		}
+		else
+			*stats_out = *stats;
+	}
+	return stats_out;
+}
+
+A3_INLINE a3f64 a3streamStatsVariance(const a3_StreamStats* stats, const a3boolean sample)
+{
+	const a3bigcount n = sample ? stats->count - 1 : stats->count;
+	return (stats->count > (a3bigcount)(sample ? 1 : 0) ? stats->m2 / (a3f64)n : 0.0);
+}
+
+A3_INLINE a3f64 a3streamStatsStandardDeviation(const a3_StreamStats* stats, const a3boolean sample)
+{
+	return a3sqrtd(a3streamStatsVariance(stats, sample));
+}
+
+
+//-----------------------------------------------------------------------------
+
+A3_INLINE a3_StreamQuantile* a3streamQuantileInit(a3_StreamQuantile* quantile_out, const a3f64 p)
+{
+	const a3f64 pc = p < 0.0 ? 0.0 : p > 1.0 ? 1.0 : p;
+	a3index i;
+	quantile_out->p = pc;
+	quantile_out->count = 0;
+	for (i = 0; i < 5; ++i)
+		quantile_out->height[i] = quantile_out->pos[i] = 0.0;
+	quantile_out->posDesired[0] = 0.0;
+	quantile_out->posDesired[1] = 2.0 * pc;
+	quantile_out->posDesired[2] = 4.0 * pc;
+	quantile_out->posDesired[3] = 2.0 + 2.0 * pc;
+	quantile_out->posDesired[4] = 4.0;
+	return quantile_out;
+}
+
+A3_INLINE a3_StreamQuantile* a3streamQuantileAdd(a3_StreamQuantile* quantile, const a3f64 x)
+{
+	a3f64* const q = quantile->height;
+	a3f64* const n = quantile->pos;
+	a3f64* const np = quantile->posDesired;
+	const a3f64 p = quantile->p;
+	a3f64 d;
+	a3index i, k;
+
+	// first five samples are the markers
+	if (quantile->count < 5)
+	{
+		q[quantile->count++] = x;
+		if (quantile->count == 5)
+		{
+			a3streamStatsInternalSort(q, 5);
+			for (i = 0; i < 5; ++i)
+				n[i] = (a3f64)i;
+		}
+		return quantile;
+	}
+
+	// find cell holding sample, extending ends if needed
+	if (x < q[0])
+	{
+		q[0] = x;
+		k = 0;
+	}
+	else if (x >= q[4])
+	{
+		q[4] = x;
+		k = 3;
+	}
+	else
+		for (k = 0; k < 3 && x >= q[k + 1]; ++k);
+
+	// shift positions above cell, advance desired positions
+	for (i = k + 1; i < 5; ++i)
+		n[i] += 1.0;
+	np[1] += p * 0.5;
+	np[2] += p;
+	np[3] += (1.0 + p) * 0.5;
+	np[4] += 1.0;
+	++quantile->count;
+
+	// move interior markers that drifted a whole position
+	for (i = 1; i < 4; ++i)
+	{
+		d = np[i] - n[i];
+		if ((d >= 1.0 && n[i + 1] - n[i] > 1.0) || (d <= -1.0 && n[i - 1] - n[i] < -1.0))
+		{
+			d = d > 0.0 ? 1.0 : -1.0;
+			q[i] = a3streamStatsInternalAdjust(quantile, i, d);
+			n[i] += d;
+		}
+	}
+	return quantile;
+}
+
+A3_INLINE a3f64 a3streamQuantileGet(const a3_StreamQuantile* quantile)
+{
+	a3f64 v[5];
+	a3index i;
+	if (quantile->count >= 5)
+		return quantile->height[2];
+	if (quantile->count == 0)
+		return 0.0;
+
+	// too few for markers: exact quantile of what was seen
+	for (i = 0; i < quantile->count; ++i)
+		v[i] = quantile->height[i];
+	a3streamStatsInternalSort(v, (a3count)quantile->count);
+	return v[(a3index)(quantile->p * (a3f64)(quantile->count - 1) + 0.5)];
+}
+
+
+//-----------------------------------------------------------------------------
+
+A3_INLINE a3_StreamHistogram* a3streamHistogramInit(a3_StreamHistogram* histogram_out, a3bigcount bin[], const a3count binCount, const a3f64 lo, const a3f64 hi)
+{
+	if (histogram_out && bin && binCount && hi > lo)
+	{
+		histogram_out->bin = bin;
+		histogram_out->binCount = binCount;
+		histogram_out->lo = lo;
+		histogram_out->hi = hi;
+		histogram_out->binsPerUnit = (a3f64)binCount / (hi - lo);
+		return a3streamHistogramReset(histogram_out);
+	}
+	return 0;
+}
+
+A3_INLINE a3_StreamHistogram* a3streamHistogramReset(a3_StreamHistogram* histogram)
+{
+	a3index i;
+	for (i = 0; i < histogram->binCount; ++i)
+		histogram->bin[i] = 0;
+	histogram->under = histogram->over = histogram->count = 0;
+	return histogram;
+}
+
+A3_INLINE a3_StreamHistogram* a3streamHistogramAdd(a3_StreamHistogram* histogram, const a3f64 x)
+{
+	const a3f64 b = (x - histogram->lo) * histogram->binsPerUnit;
+	if (b < 0.0)
+		++histogram->under;
+	else if (b >= (a3f64)histogram->binCount)
+		++histogram->over;
+	else
+		++histogram->bin[(a3index)b];
+	++histogram->count;
+	return histogram;
+}
+
+A3_INLINE a3f64 a3streamHistogramQuantile(const a3_StreamHistogram* histogram, const a3f64 p)
+{
+	const a3f64 target = (p < 0.0 ? 0.0 : p > 1.0 ? 1.0 : p) * (a3f64)histogram->count;
+	a3f64 sum = (a3f64)histogram->under, next;
+	a3index i;
+	if (histogram->count == 0 || target <= sum)
+		return histogram->lo;
+	for (i = 0; i < histogram->binCount; ++i, sum = next)
+	{
+		next = sum + (a3f64)histogram->bin[i];
+		if (target <= next)
+			return (histogram->lo + ((a3f64)i + (target - sum) / (next - sum)) / histogram->binsPerUnit);
+	}
+	return histogram->hi;
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+A3_END_IMPL
+
+
+#endif	// !__ANIMAL3D_A3DM_STREAMSTATS_IMPL_INL
+#endif	// __ANIMAL3D_A3DM_STREAMSTATS_H
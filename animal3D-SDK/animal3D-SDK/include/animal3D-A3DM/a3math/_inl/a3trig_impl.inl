@@ -0,0 +1,454 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	animal3D Math (A3DM) SDK
+	By Daniel S. Buckstein
+
+	a3trig_impl.inl
+	Implementations of table-based and Taylor series trigonometry.
+*/
+
+#ifdef __ANIMAL3D_A3DM_TRIG_H
+#ifndef __ANIMAL3D_A3DM_TRIG_IMPL_INL
+#define __ANIMAL3D_A3DM_TRIG_IMPL_INL
+
+
+#include "../a3interpolation.h"
+#include "../a3sqrt.h"
+
+
+A3_BEGIN_IMPL
+
+
+//-----------------------------------------------------------------------------
+// internal helpers
+
+// size of each inverse index table; one entry per 1/360 in [-1, +1]
+#define a3trigInternal_indexTableSize	768
+
+// table state shared by every translation unit; set by a3trigInit
+A3_SHARED a3index a3_trigSamplesPerDegree = 0;
+A3_SHARED const a3real *a3_trigParamTablePtr = 0, *a3_trigSinSampleTablePtr = 0, *a3_trigCosSampleTablePtr = 0;
+A3_SHARED const a3index *a3_asinIndexTable = 0, *a3_acosIndexTable = 0;
+A3_SHARED a3index a3_TaylorItrs = 20;
+
+// index of last table sample at or below degree input in [-360, +360]
+A3_INLINE a3index a3trigInternalIndex(const a3real x)
+{
+	const a3index i = (a3index)((x + a3real_threesixty) * (a3real)a3_trigSamplesPerDegree);
+	const a3index iMax = a3_trigSamplesPerDegree * 720 - 1;
+	return (i < iMax ? i : iMax);
+}
+
+// index into inverse index tables for input in [-1, +1]
+A3_INLINE a3index a3trigInternalInverseIndex(const a3real x)
+{
+	const a3index i = (a3index)((x + a3real_one) * a3real_oneeighty);
+	return (i < 720 ? i : 720);
+}
+
+A3_INLINE void a3trigInternalSetTables(const a3index samplesPerDegree, const a3real table[])
+{
+	const a3index n = samplesPerDegree * 720 + 1;
+	a3_trigSamplesPerDegree = samplesPerDegree;
+	a3_trigParamTablePtr = table;
+	a3_trigSinSampleTablePtr = a3_trigParamTablePtr + n;
+	a3_trigCosSampleTablePtr = a3_trigSinSampleTablePtr + n;
+	a3_asinIndexTable = (const a3index*)(a3_trigCosSampleTablePtr + n);
+	a3_acosIndexTable = a3_asinIndexTable + a3trigInternal_indexTableSize;
+}
+
+
+//-----------------------------------------------------------------------------
+
+A3_INLINE a3index a3trigInit(const a3index samplesPerDegree, a3real table_out[])
+{
+	const a3index n = samplesPerDegree * 720 + 1;
+	a3real *param, *sinTable, *cosTable;
+	a3index *asinIndex, *acosIndex;
+	a3index k, j, idx, jMax;
+	a3i32 i;
+	a3real x;
+
+	if (!samplesPerDegree || !table_out)
+		return 0;
+
+	param = table_out;
+	sinTable = param + n;
+	cosTable = sinTable + n;
+	asinIndex = (a3index*)(cosTable + n);
+	acosIndex = asinIndex + a3trigInternal_indexTableSize;
+
+	// samples in [-360, +360); multiples of 90 are set exactly so that 
+	//	inverse searches always find their end points
+	for (i = -360, k = 0; i < 360; ++i)
+		for (j = 0; j < samplesPerDegree; ++j, ++k)
+		{
+			param[k] = (a3real)i + (a3real)j / (a3real)samplesPerDegree;
+			if (!j && !(i % 90))
+			{
+				const a3i32 q = (i / 90 + 4) % 4;
+				sinTable[k] = (a3real)(q == 1 ? 1 : q == 3 ? -1 : 0);
+				cosTable[k] = (a3real)(q == 0 ? 1 : q == 2 ? -1 : 0);
+			}
+			else
+				a3trigTaylor_sind_cosd(param[k], sinTable + k, cosTable + k);
+		}
+	param[k] = a3real_threesixty;
+	sinTable[k] = sinTable[0];
+	cosTable[k] = cosTable[0];
+
+	// inverse index tables: sine rises monotonically over [-90, +90]
+	idx = samplesPerDegree * 270;
+	jMax = samplesPerDegree * 450;
+	for (i = -360, j = idx + 1; i <= 360; ++i)
+	{
+		x = (a3real)i / a3real_threesixty;
+		while (j < jMax && x > sinTable[j])
+			idx = j++;
+		asinIndex[i + 360] = idx;
+		acosIndex[i + 360] = idx - samplesPerDegree * 90;
+	}
+
+	a3trigInternalSetTables(samplesPerDegree, table_out);
+	return a3trigInitSamplesRequired(samplesPerDegree);
+}
+
+A3_INLINE a3index a3trigInitSetTables(const a3index samplesPerDegree, const a3real table[])
+{
+	if (!samplesPerDegree || !table)
+		return 0;
+	a3trigInternalSetTables(samplesPerDegree, table);
+	return a3trigInitSamplesRequired(samplesPerDegree);
+}
+
+A3_INLINE a3index a3trigInitSamplesRequired(const a3index samplesPerDegree)
+{
+	// three tables of samples plus two index tables stored as reals
+	const a3index n = samplesPerDegree * 720 + 1;
+	return (n * 3 + a3trigInternal_indexTableSize * 2);
+}
+
+A3_INLINE a3index a3trigFree()
+{
+	if (a3_trigSamplesPerDegree)
+	{
+		a3_trigSamplesPerDegree = 0;
+		a3_trigParamTablePtr = a3_trigSinSampleTablePtr = a3_trigCosSampleTablePtr = 0;
+		a3_asinIndexTable = a3_acosIndexTable = 0;
+		return 1;
+	}
+	return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+
+A3_INLINE a3real a3trigValid_sind(a3real x)
+{
+	while (x <= -a3real_threesixty)
+		x += a3real_threesixty;
+	while (x >= a3real_threesixty)
+		x -= a3real_threesixty;
+	return x;
+}
+
+A3_INLINE a3real a3trigValid_sinr(a3real x)
+{
+	while (x <= -a3real_twopi)
+		x += a3real_twopi;
+	while (x >= a3real_twopi)
+		x -= a3real_twopi;
+	return x;
+}
+
+A3_INLINE a3real a3trigValid_asin(a3real x)
+{
+	return a3clamp(-a3real_one, a3real_one, x);
+}
+
+A3_INLINE a3real a3trigValid_atan(a3real x)
+{
+	return a3clamp(-a3real_halfpi, a3real_halfpi, x);
+}
+
+
+//-----------------------------------------------------------------------------
+
+A3_INLINE a3real a3sind(const a3real x)
+{
+	return a3sampleTableLerpIncrement(a3_trigSinSampleTablePtr, a3_trigParamTablePtr, x, a3trigInternalIndex(x));
+}
+
+A3_INLINE a3real a3cosd(const a3real x)
+{
+	return a3sampleTableLerpIncrement(a3_trigCosSampleTablePtr, a3_trigParamTablePtr, x, a3trigInternalIndex(x));
+}
+
+A3_INLINE a3real a3tand(const a3real x)
+{
+	// one search for both tables
+	a3real u;
+	const a3index i = a3sampleTableLerpIncrementIndex(a3_trigParamTablePtr, x, a3trigInternalIndex(x), &u);
+	return (a3lerpFunc(a3_trigSinSampleTablePtr[i - 1], a3_trigSinSampleTablePtr[i], u) / a3lerpFunc(a3_trigCosSampleTablePtr[i - 1], a3_trigCosSampleTablePtr[i], u));
+}
+
+A3_INLINE a3real a3sinr(const a3real x)
+{
+	return a3sind(x * a3real_rad2deg);
+}
+
+A3_INLINE a3real a3cosr(const a3real x)
+{
+	return a3cosd(x * a3real_rad2deg);
+}
+
+A3_INLINE a3real a3tanr(const a3real x)
+{
+	return a3tand(x * a3real_rad2deg);
+}
+
+A3_INLINE a3real a3asind(const a3real x)
+{
+	return a3sampleTableLerpIncrement(a3_trigParamTablePtr, a3_trigSinSampleTablePtr, x, a3_asinIndexTable[a3trigInternalInverseIndex(x)]);
+}
+
+A3_INLINE a3real a3acosd(const a3real x)
+{
+	// cosine rises over [-180, 0]
+	return -a3sampleTableLerpIncrement(a3_trigParamTablePtr, a3_trigCosSampleTablePtr, x, a3_acosIndexTable[a3trigInternalInverseIndex(x)]);
+}
+
+A3_INLINE a3real a3atand(const a3real x)
+{
+	return a3asind(x * a3sqrtInverse(x * x + a3real_one));
+}
+
+A3_INLINE a3real a3asinr(const a3real x)
+{
+	return (a3asind(x) * a3real_deg2rad);
+}
+
+A3_INLINE a3real a3acosr(const a3real x)
+{
+	return (a3acosd(x) * a3real_deg2rad);
+}
+
+A3_INLINE a3real a3atanr(const a3real x)
+{
+	return (a3atand(x) * a3real_deg2rad);
+}
+
+A3_INLINE a3real a3cscd(const a3real x)
+{
+	return (a3real_one / a3sind(x));
+}
+
+A3_INLINE a3real a3secd(const a3real x)
+{
+	return (a3real_one / a3cosd(x));
+}
+
+A3_INLINE a3real a3cotd(const a3real x)
+{
+	return (a3real_one / a3tand(x));
+}
+
+A3_INLINE a3real a3cscr(const a3real x)
+{
+	return (a3real_one / a3sinr(x));
+}
+
+A3_INLINE a3real a3secr(const a3real x)
+{
+	return (a3real_one / a3cosr(x));
+}
+
+A3_INLINE a3real a3cotr(const a3real x)
+{
+	return (a3real_one / a3tanr(x));
+}
+
+A3_INLINE a3real a3acscd(const a3real x)
+{
+	return a3asind(a3real_one / x);
+}
+
+A3_INLINE a3real a3asecd(const a3real x)
+{
+	return a3acosd(a3real_one / x);
+}
+
+A3_INLINE a3real a3acotd(const a3real x)
+{
+	return a3atand(a3real_one / x);
+}
+
+A3_INLINE a3real a3acscr(const a3real x)
+{
+	return a3asinr(a3real_one / x);
+}
+
+A3_INLINE a3real a3asecr(const a3real x)
+{
+	return a3acosr(a3real_one / x);
+}
+
+A3_INLINE a3real a3acotr(const a3real x)
+{
+	return a3atanr(a3real_one / x);
+}
+
+A3_INLINE a3real a3atan2d(const a3real y, const a3real x)
+{
+	if (x > a3real_zero)
+		return a3atand(y / x);
+	if (x < a3real_zero)
+		return (a3atand(y / x) + (y >= a3real_zero ? a3real_oneeighty : -a3real_oneeighty));
+	return (y > a3real_zero ? a3real_ninety : y < a3real_zero ? -a3real_ninety : a3real_zero);
+}
+
+A3_INLINE a3real a3atan2r(const a3real y, const a3real x)
+{
+	if (x > a3real_zero)
+		return a3atanr(y / x);
+	if (x < a3real_zero)
+		return (a3atanr(y / x) + (y >= a3real_zero ? a3real_pi : -a3real_pi));
+	return (y > a3real_zero ? a3real_halfpi : y < a3real_zero ? -a3real_halfpi : a3real_zero);
+}
+
+
+//-----------------------------------------------------------------------------
+
+A3_INLINE a3index a3trigSetTaylorIterations(const a3index n)
+{
+	const a3index ret = a3_TaylorItrs;
+	a3_TaylorItrs = n;
+	return ret;
+}
+
+A3_INLINE a3index a3trigGetTaylorIterations()
+{
+	return a3_TaylorItrs;
+}
+
+A3_INLINE a3real a3sindTaylor(const a3real x)
+{
+	return a3sinrTaylor(x * a3real_deg2rad);
+}
+
+A3_INLINE a3real a3cosdTaylor(const a3real x)
+{
+	return a3cosrTaylor(x * a3real_deg2rad);
+}
+
+A3_INLINE a3real a3tandTaylor(const a3real x)
+{
+	return a3tanrTaylor(x * a3real_deg2rad);
+}
+
+A3_INLINE a3real a3sinrTaylor(const a3real x)
+{
+	// accumulate in double; alternating factorial carries the sign
+	const a3f64 x2 = (a3f64)x * (a3f64)x;
+	a3f64 term = (a3f64)x, sum = (a3f64)x, fact = 1.0, n = 1.0;
+	a3index i;
+	for (i = 0; i < a3_TaylorItrs; ++i)
+	{
+		fact *= -(n + 1.0) * (n + 2.0);
+		n += 2.0;
+		term *= x2;
+		sum += term / fact;
+	}
+	return (a3real)sum;
+}
+
+A3_INLINE a3real a3cosrTaylor(const a3real x)
+{
+	a3real s, c;
+	a3trigTaylor_sinr_cosr(x, &s, &c);
+	return c;
+}
+
+A3_INLINE a3real a3tanrTaylor(const a3real x)
+{
+	a3real s, c;
+	a3trigTaylor_sinr_cosr(x, &s, &c);
+	return (s / c);
+}
+
+A3_INLINE a3real a3trigTaylor_sind_cosd(const a3real x, a3real *sin_out, a3real *cos_out)
+{
+	a3trigTaylor_sinr_cosr(x * a3real_deg2rad, sin_out, cos_out);
+	return x;
+}
+
+A3_INLINE a3real a3trigTaylor_sinr_cosr(const a3real x, a3real *sin_out, a3real *cos_out)
+{
+	const a3f64 xd = (a3f64)x;
+	a3f64 term = xd, s = xd, c = 1.0, fact = 1.0, n = 1.0;
+	a3index i;
+	for (i = 0; i < a3_TaylorItrs; ++i)
+	{
+		n += 1.0;
+		fact *= -n;
+		term *= xd;
+		c += term / fact;
+		n += 1.0;
+		fact *= n;
+		term *= xd;
+		s += term / fact;
+	}
+	*sin_out = (a3real)s;
+	*cos_out = (a3real)c;
+	return x;
+}
+
+
+//-----------------------------------------------------------------------------
+
+A3_INLINE a3real a3trigPointToEdgeRatio(const a3real totalAzimuth, const a3count numSlices)
+{
+	return a3cosd(a3real_half * (numSlices ? totalAzimuth / (a3real)numSlices : a3real_zero));
+}
+
+A3_INLINE a3real a3trigEdgeToPointRatio(const a3real totalAzimuth, const a3count numSlices)
+{
+	return (a3real_one / a3trigPointToEdgeRatio(totalAzimuth, numSlices));
+}
+
+A3_INLINE a3real a3trigPointToFaceRatio(const a3real totalAzimuth, const a3real totalElevation, const a3count numSlices, const a3count numStacks)
+{
+	return (a3trigPointToEdgeRatio(totalAzimuth, numSlices) * a3trigPointToEdgeRatio(totalElevation, numStacks));
+}
+
+A3_INLINE a3real a3trigFaceToPointRatio(const a3real totalAzimuth, const a3real totalElevation, const a3count numSlices, const a3count numStacks)
+{
+	return (a3real_one / a3trigPointToFaceRatio(totalAzimuth, totalElevation, numSlices, numStacks));
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+A3_END_IMPL
+
+
+#endif	// !__ANIMAL3D_A3DM_TRIG_IMPL_INL
+#endif	// __ANIMAL3D_A3DM_TRIG_H
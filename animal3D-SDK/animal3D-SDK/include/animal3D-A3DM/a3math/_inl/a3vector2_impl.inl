@@ -0,0 +1,670 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	animal3D Math (A3DM) SDK
+	By Daniel S. Buckstein
+
+	a3vector2_impl.inl
+	Implementations of 2D vector functions.
+*/
+
+#ifdef __ANIMAL3D_A3DM_VECTOR_H
+#ifndef __ANIMAL3D_A3DM_VECTOR2_IMPL_INL
+#define __ANIMAL3D_A3DM_VECTOR2_IMPL_INL
+
+
+#include "../a3interpolation.h"
+#include "../a3sqrt.h"
+#include "../a3trig.h"
+
+
+A3_BEGIN_IMPL
+
+
+//-----------------------------------------------------------------------------
+// internal helpers
+
+// store sample i of an arc length table and return running arc length
+A3_INLINE a3real a3real2InternalArcLengthStore(a3real2 sampleTable_out[], a3real paramTable_out[], a3real arclenTable_out[], const a3index i, const a3real param, const a3real2p sample, a3real arclen)
+{
+	if (i)
+		arclen += a3real2Distance(sample, sampleTable_out[i - 1]);
+	a3real2SetReal2(sampleTable_out[i], sample);
+	arclenTable_out[i] = arclen;
+	if (paramTable_out)
+		paramTable_out[i] = param;
+	return arclen;
+}
+
+// normalize arc length table (first entry is always zero)
+A3_INLINE void a3real2InternalArcLengthNormalize(a3real arclenTable_out[], const a3count numDivisions, const a3real arclen)
+{
+	const a3real arclenInv = arclen != a3real_zero ? a3real_one / arclen : a3real_zero;
+	a3index i;
+	for (i = 1; i <= numDivisions; ++i)
+		arclenTable_out[i] *= arclenInv;
+}
+
+
+//-----------------------------------------------------------------------------
+
+A3_INLINE a3real2r a3real2Set(a3real2p v_out, const a3real x, const a3real y)
+{
+	v_out[0] = x;
+	v_out[1] = y;
+	return v_out;
+}
+
+A3_INLINE a3real2r a3real2SetReal2(a3real2p v_out, const a3real2p v)
+{
+	v_out[0] = v[0];
+	v_out[1] = v[1];
+	return v_out;
+}
+
+A3_INLINE a3real2r a3real2SetReal3(a3real2p v_out, const a3real3p v)
+{
+	v_out[0] = v[0];
+	v_out[1] = v[1];
+	return v_out;
+}
+
+A3_INLINE a3real2r a3real2SetReal4(a3real2p v_out, const a3real4p v)
+{
+	v_out[0] = v[0];
+	v_out[1] = v[1];
+	return v_out;
+}
+
+
+A3_INLINE a3real a3real2LengthSquared(const a3real2p v)
+{
+	return (v[0] * v[0] + v[1] * v[1]);
+}
+
+A3_INLINE a3real a3real2LengthSquaredInverse(const a3real2p v)
+{
+	return (a3real_one / a3real2LengthSquared(v));
+}
+
+A3_INLINE a3real a3real2Length(const a3real2p v)
+{
+	return a3sqrt(a3real2LengthSquared(v));
+}
+
+A3_INLINE a3real a3real2LengthInverse(const a3real2p v)
+{
+	return a3sqrtInverse(a3real2LengthSquared(v));
+}
+
+A3_INLINE a3real2r a3real2GetUnit(a3real2p v_out, const a3real2p v)
+{
+	const a3real lenInv = a3real2LengthInverse(v);
+	v_out[0] = v[0] * lenInv;
+	v_out[1] = v[1] * lenInv;
+	return v_out;
+}
+
+A3_INLINE a3real2r a3real2Normalize(a3real2p v_inout)
+{
+	return a3real2GetUnit(v_inout, v_inout);
+}
+
+A3_INLINE a3real2r a3real2GetUnitInvLength(a3real2p v_out, const a3real2p v, a3real *invLength_out)
+{
+	const a3real lenInv = a3real2LengthInverse(v);
+	v_out[0] = v[0] * lenInv;
+	v_out[1] = v[1] * lenInv;
+	if (invLength_out)
+		*invLength_out = lenInv;
+	return v_out;
+}
+
+A3_INLINE a3real2r a3real2NormalizeGetInvLength(a3real2p v_inout, a3real *invLength_out)
+{
+	return a3real2GetUnitInvLength(v_inout, v_inout, invLength_out);
+}
+
+A3_INLINE a3real2r a3real2GetNegative(a3real2p v_out, const a3real2p v)
+{
+	v_out[0] = -v[0];
+	v_out[1] = -v[1];
+	return v_out;
+}
+
+A3_INLINE a3real2r a3real2Negate(a3real2p v_inout)
+{
+	v_inout[0] = -v_inout[0];
+	v_inout[1] = -v_inout[1];
+	return v_inout;
+}
+
+
+A3_INLINE a3real a3real2Dot(const a3real2p vL, const a3real2p vR)
+{
+	return (vL[0] * vR[0] + vL[1] * vR[1]);
+}
+
+A3_INLINE a3real a3real2DistanceSquared(const a3real2p v0, const a3real2p v1)
+{
+	a3real2 d;
+	return a3real2LengthSquared(a3real2Diff(d, v1, v0));
+}
+
+A3_INLINE a3real a3real2Distance(const a3real2p v0, const a3real2p v1)
+{
+	return a3sqrt(a3real2DistanceSquared(v0, v1));
+}
+
+A3_INLINE a3real a3real2ProjRatio(const a3real2p v, const a3real2p vBase)
+{
+	return (a3real2Dot(v, vBase) / a3real2LengthSquared(vBase));
+}
+
+A3_INLINE a3real2r a3real2Projected(a3real2p v_out, const a3real2p v, const a3real2p vBase)
+{
+	return a3real2ProductS(v_out, vBase, a3real2ProjRatio(v, vBase));
+}
+
+A3_INLINE a3real2r a3real2Proj(a3real2p v_inout, const a3real2p vBase)
+{
+	return a3real2Projected(v_inout, v_inout, vBase);
+}
+
+A3_INLINE a3real2r a3real2ProjectedGetRatio(a3real2p v_out, const a3real2p v, const a3real2p vBase, a3real *ratio_out)
+{
+	const a3real ratio = a3real2ProjRatio(v, vBase);
+	if (ratio_out)
+		*ratio_out = ratio;
+	return a3real2ProductS(v_out, vBase, ratio);
+}
+
+A3_INLINE a3real2r a3real2ProjGetRatio(a3real2p v_inout, const a3real2p vBase, a3real *ratio_out)
+{
+	return a3real2ProjectedGetRatio(v_inout, v_inout, vBase, ratio_out);
+}
+
+A3_INLINE a3real2r a3real2Sum(a3real2p v_out, const a3real2p vL, const a3real2p vR)
+{
+	v_out[0] = vL[0] + vR[0];
+	v_out[1] = vL[1] + vR[1];
+	return v_out;
+}
+
+A3_INLINE a3real2r a3real2Diff(a3real2p v_out, const a3real2p vL, const a3real2p vR)
+{
+	v_out[0] = vL[0] - vR[0];
+	v_out[1] = vL[1] - vR[1];
+	return v_out;
+}
+
+A3_INLINE a3real2r a3real2ProductS(a3real2p v_out, const a3real2p v, const a3real s)
+{
+	v_out[0] = v[0] * s;
+	v_out[1] = v[1] * s;
+	return v_out;
+}
+
+A3_INLINE a3real2r a3real2QuotientS(a3real2p v_out, const a3real2p v, const a3real s)
+{
+	return a3real2ProductS(v_out, v, a3real_one / s);
+}
+
+A3_INLINE a3real2r a3real2ProductComp(a3real2p v_out, const a3real2p vL, const a3real2p vR)
+{
+	v_out[0] = vL[0] * vR[0];
+	v_out[1] = vL[1] * vR[1];
+	return v_out;
+}
+
+A3_INLINE a3real2r a3real2QuotientComp(a3real2p v_out, const a3real2p vL, const a3real2p vR)
+{
+	v_out[0] = vL[0] / vR[0];
+	v_out[1] = vL[1] / vR[1];
+	return v_out;
+}
+
+A3_INLINE a3real2r a3real2Add(a3real2p vL_inout, const a3real2p vR)
+{
+	vL_inout[0] += vR[0];
+	vL_inout[1] += vR[1];
+	return vL_inout;
+}
+
+A3_INLINE a3real2r a3real2Sub(a3real2p vL_inout, const a3real2p vR)
+{
+	vL_inout[0] -= vR[0];
+	vL_inout[1] -= vR[1];
+	return vL_inout;
+}
+
+A3_INLINE a3real2r a3real2MulS(a3real2p v_inout, const a3real s)
+{
+	v_inout[0] *= s;
+	v_inout[1] *= s;
+	return v_inout;
+}
+
+A3_INLINE a3real2r a3real2DivS(a3real2p v_inout, const a3real s)
+{
+	return a3real2MulS(v_inout, a3real_one / s);
+}
+
+A3_INLINE a3real2r a3real2MulComp(a3real2p vL_inout, const a3real2p vR)
+{
+	vL_inout[0] *= vR[0];
+	vL_inout[1] *= vR[1];
+	return vL_inout;
+}
+
+A3_INLINE a3real2r a3real2DivComp(a3real2p vL_inout, const a3real2p vR)
+{
+	vL_inout[0] /= vR[0];
+	vL_inout[1] /= vR[1];
+	return vL_inout;
+}
+
+
+A3_INLINE a3real2r a3real2Lerp(a3real2p v_out, const a3real2p v0, const a3real2p v1, const a3real param)
+{
+	v_out[0] = a3lerpFunc(v0[0], v1[0], param);
+	v_out[1] = a3lerpFunc(v0[1], v1[1], param);
+	return v_out;
+}
+
+A3_INLINE a3real2r a3real2NLerp(a3real2p v_out, const a3real2p v0, const a3real2p v1, const a3real param)
+{
+	return a3real2Normalize(a3real2Lerp(v_out, v0, v1, param));
+}
+
+A3_INLINE a3real2r a3real2Bilerp(a3real2p v_out, const a3real2p v00, const a3real2p v01, const a3real2p v10, const a3real2p v11, const a3real param0, const a3real param1)
+{
+	v_out[0] = a3bilerp(v00[0], v01[0], v10[0], v11[0], param0, param1);
+	v_out[1] = a3bilerp(v00[1], v01[1], v10[1], v11[1], param0, param1);
+	return v_out;
+}
+
+A3_INLINE a3real2r a3real2Trilerp(a3real2p v_out, const a3real2p v000, const a3real2p v001, const a3real2p v010, const a3real2p v011, const a3real2p v100, const a3real2p v101, const a3real2p v110, const a3real2p v111, const a3real param0, const a3real param1, const a3real param2)
+{
+	v_out[0] = a3trilerp(v000[0], v001[0], v010[0], v011[0], v100[0], v101[0], v110[0], v111[0], param0, param1, param2);
+	v_out[1] = a3trilerp(v000[1], v001[1], v010[1], v011[1], v100[1], v101[1], v110[1], v111[1], param0, param1, param2);
+	return v_out;
+}
+
+A3_INLINE a3real2r a3real2CatmullRom(a3real2p v_out, const a3real2p vPrev, const a3real2p v0, const a3real2p v1, const a3real2p vNext, const a3real param)
+{
+	v_out[0] = a3CatmullRom(vPrev[0], v0[0], v1[0], vNext[0], param);
+	v_out[1] = a3CatmullRom(vPrev[1], v0[1], v1[1], vNext[1], param);
+	return v_out;
+}
+
+A3_INLINE a3real2r a3real2HermiteControl(a3real2p v_out, const a3real2p v0, const a3real2p v1, const a3real2p vControl0, const a3real2p vControl1, const a3real param)
+{
+	v_out[0] = a3HermiteControl(v0[0], v1[0], vControl0[0], vControl1[0], param);
+	v_out[1] = a3HermiteControl(v0[1], v1[1], vControl0[1], vControl1[1], param);
+	return v_out;
+}
+
+A3_INLINE a3real2r a3real2HermiteTangent(a3real2p v_out, const a3real2p v0, const a3real2p v1, const a3real2p vTangent0, const a3real2p vTangent1, const a3real param)
+{
+	v_out[0] = a3HermiteTangent(v0[0], v1[0], vTangent0[0], vTangent1[0], param);
+	v_out[1] = a3HermiteTangent(v0[1], v1[1], vTangent0[1], vTangent1[1], param);
+	return v_out;
+}
+
+A3_INLINE a3real2r a3real2Bezier0(a3real2p v_out, const a3real2p v0, const a3real param)
+{
+	return a3real2SetReal2(v_out, v0);
+}
+
+A3_INLINE a3real2r a3real2Bezier1(a3real2p v_out, const a3real2p v0, const a3real2p v1, const a3real param)
+{
+	return a3real2Lerp(v_out, v0, v1, param);
+}
+
+A3_INLINE a3real2r a3real2Bezier2(a3real2p v_out, const a3real2p v0, const a3real2p v1, const a3real2p v2, const a3real param)
+{
+	v_out[0] = a3Bezier2(v0[0], v1[0], v2[0], param);
+	v_out[1] = a3Bezier2(v0[1], v1[1], v2[1], param);
+	return v_out;
+}
+
+A3_INLINE a3real2r a3real2Bezier3(a3real2p v_out, const a3real2p v0, const a3real2p v1, const a3real2p v2, const a3real2p v3, const a3real param)
+{
+	v_out[0] = a3Bezier3(v0[0], v1[0], v2[0], v3[0], param);
+	v_out[1] = a3Bezier3(v0[1], v1[1], v2[1], v3[1], param);
+	return v_out;
+}
+
+A3_INLINE a3real2r a3real2BezierN(a3real2p v_out, a3count order_N, const a3real2 v[], const a3real param)
+{
+	a3real2 n0, n1;
+	if (order_N)
+	{
+		if (--order_N)
+			return a3real2Lerp(v_out, a3real2BezierN(n0, order_N, v, param), a3real2BezierN(n1, order_N, v + 1, param), param);
+		return a3real2Lerp(v_out, v[0], v[1], param);
+	}
+	return a3real2SetReal2(v_out, v[0]);
+}
+
+A3_INLINE a3real2r a3real2Slerp(a3real2p v_out, const a3real2p v0, const a3real2p v1, const a3real param)
+{
+	const a3real d = a3real2Dot(v0, v1) * a3sqrtInverse(a3real2LengthSquared(v0) * a3real2LengthSquared(v1));
+	a3real a, s, s0, s1;
+	if (d > -a3real_one && d < a3real_one)
+	{
+		a = a3acosd(d);
+		s = a3cscd(a);
+		s0 = a3sind((a3real_one - param) * a) * s;
+		s1 = a3sind(param * a) * s;
+		v_out[0] = v0[0] * s0 + v1[0] * s1;
+		v_out[1] = v0[1] * s0 + v1[1] * s1;
+		return v_out;
+	}
+	return a3real2SetReal2(v_out, v0);
+}
+
+A3_INLINE a3real2r a3real2SlerpUnit(a3real2p v_out, const a3real2p v0, const a3real2p v1, const a3real param)
+{
+	const a3real d = a3real2Dot(v0, v1);
+	a3real a, s, s0, s1;
+	if (d > -a3real_one && d < a3real_one)
+	{
+		a = a3acosd(d);
+		s = a3cscd(a);
+		s0 = a3sind((a3real_one - param) * a) * s;
+		s1 = a3sind(param * a) * s;
+		v_out[0] = v0[0] * s0 + v1[0] * s1;
+		v_out[1] = v0[1] * s0 + v1[1] * s1;
+		return v_out;
+	}
+	return a3real2SetReal2(v_out, v0);
+}
+
+A3_INLINE a3real a3real2CalculateArcLengthCatmullRom(a3real2 sampleTable_out[], a3real paramTable_out[], a3real arclenTable_out[], const a3boolean autoNormalize, const a3count numDivisions, const a3real2p vPrev, const a3real2p v0, const a3real2p v1, const a3real2p vNext)
+{
+	const a3real dt = a3real_one / (a3real)numDivisions;
+	a3real t, arclen = a3real_zero;
+	a3real2 sample;
+	a3index i;
+	if (!sampleTable_out || !arclenTable_out || !numDivisions)
+		return a3real_zero;
+	for (i = 0; i <= numDivisions; ++i)
+	{
+		t = (a3real)i * dt;
+		a3real2CatmullRom(sample, vPrev, v0, v1, vNext, t);
+		arclen = a3real2InternalArcLengthStore(sampleTable_out, paramTable_out, arclenTable_out, i, t, sample, arclen);
+	}
+	if (autoNormalize)
+		a3real2InternalArcLengthNormalize(arclenTable_out, numDivisions, arclen);
+	return arclen;
+}
+
+A3_INLINE a3real a3real2CalculateArcLengthHermiteControl(a3real2 sampleTable_out[], a3real paramTable_out[], a3real arclenTable_out[], const a3boolean autoNormalize, const a3count numDivisions, const a3real2p v0, const a3real2p v1, const a3real2p vControl0, const a3real2p vControl1)
+{
+	const a3real dt = a3real_one / (a3real)numDivisions;
+	a3real t, arclen = a3real_zero;
+	a3real2 sample;
+	a3index i;
+	if (!sampleTable_out || !arclenTable_out || !numDivisions)
+		return a3real_zero;
+	for (i = 0; i <= numDivisions; ++i)
+	{
+		t = (a3real)i * dt;
+		a3real2HermiteControl(sample, v0, v1, vControl0, vControl1, t);
+		arclen = a3real2InternalArcLengthStore(sampleTable_out, paramTable_out, arclenTable_out, i, t, sample, arclen);
+	}
+	if (autoNormalize)
+		a3real2InternalArcLengthNormalize(arclenTable_out, numDivisions, arclen);
+	return arclen;
+}
+
+A3_INLINE a3real a3real2CalculateArcLengthHermiteTangent(a3real2 sampleTable_out[], a3real paramTable_out[], a3real arclenTable_out[], const a3boolean autoNormalize, const a3count numDivisions, const a3real2p v0, const a3real2p v1, const a3real2p vTangent0, const a3real2p vTangent1)
+{
+	const a3real dt = a3real_one / (a3real)numDivisions;
+	a3real t, arclen = a3real_zero;
+	a3real2 sample;
+	a3index i;
+	if (!sampleTable_out || !arclenTable_out || !numDivisions)
+		return a3real_zero;
+	for (i = 0; i <= numDivisions; ++i)
+	{
+		t = (a3real)i * dt;
+		a3real2HermiteTangent(sample, v0, v1, vTangent0, vTangent1, t);
+		arclen = a3real2InternalArcLengthStore(sampleTable_out, paramTable_out, arclenTable_out, i, t, sample, arclen);
+	}
+	if (autoNormalize)
+		a3real2InternalArcLengthNormalize(arclenTable_out, numDivisions, arclen);
+	return arclen;
+}
+
+A3_INLINE a3real a3real2CalculateArcLengthBezier0(a3real2 sampleTable_out[], a3real paramTable_out[], a3real arclenTable_out[], const a3boolean autoNormalize, const a3count numDivisions, const a3real2p v0)
+{
+	const a3real dt = a3real_one / (a3real)numDivisions;
+	a3real t, arclen = a3real_zero;
+	a3real2 sample;
+	a3index i;
+	if (!sampleTable_out || !arclenTable_out || !numDivisions)
+		return a3real_zero;
+	for (i = 0; i <= numDivisions; ++i)
+	{
+		t = (a3real)i * dt;
+		a3real2Bezier0(sample, v0, t);
+		arclen = a3real2InternalArcLengthStore(sampleTable_out, paramTable_out, arclenTable_out, i, t, sample, arclen);
+	}
+	if (autoNormalize)
+		a3real2InternalArcLengthNormalize(arclenTable_out, numDivisions, arclen);
+	return arclen;
+}
+
+A3_INLINE a3real a3real2CalculateArcLengthBezier1(a3real2 sampleTable_out[], a3real paramTable_out[], a3real arclenTable_out[], const a3boolean autoNormalize, const a3count numDivisions, const a3real2p v0, const a3real2p v1)
+{
+	const a3real dt = a3real_one / (a3real)numDivisions;
+	a3real t, arclen = a3real_zero;
+	a3real2 sample;
+	a3index i;
+	if (!sampleTable_out || !arclenTable_out || !numDivisions)
+		return a3real_zero;
+	for (i = 0; i <= numDivisions; ++i)
+	{
+		t = (a3real)i * dt;
+		a3real2Bezier1(sample, v0, v1, t);
+		arclen = a3real2InternalArcLengthStore(sampleTable_out, paramTable_out, arclenTable_out, i, t, sample, arclen);
+	}
+	if (autoNormalize)
+		a3real2InternalArcLengthNormalize(arclenTable_out, numDivisions, arclen);
+	return arclen;
+}
+
+A3_INLINE a3real a3real2CalculateArcLengthBezier2(a3real2 sampleTable_out[], a3real paramTable_out[], a3real arclenTable_out[], const a3boolean autoNormalize, const a3count numDivisions, const a3real2p v0, const a3real2p v1, const a3real2p v2)
+{
+	const a3real dt = a3real_one / (a3real)numDivisions;
+	a3real t, arclen = a3real_zero;
+	a3real2 sample;
+	a3index i;
+	if (!sampleTable_out || !arclenTable_out || !numDivisions)
+		return a3real_zero;
+	for (i = 0; i <= numDivisions; ++i)
+	{
+		t = (a3real)i * dt;
+		a3real2Bezier2(sample, v0, v1, v2, t);
+		arclen = a3real2InternalArcLengthStore(sampleTable_out, paramTable_out, arclenTable_out, i, t, sample, arclen);
+	}
+	if (autoNormalize)
+		a3real2InternalArcLengthNormalize(arclenTable_out, numDivisions, arclen);
+	return arclen;
+}
+
+A3_INLINE a3real a3real2CalculateArcLengthBezier3(a3real2 sampleTable_out[], a3real paramTable_out[], a3real arclenTable_out[], const a3boolean autoNormalize, const a3count numDivisions, const a3real2p v0, const a3real2p v1, const a3real2p v2, const a3real2p v3)
+{
+	const a3real dt = a3real_one / (a3real)numDivisions;
+	a3real t, arclen = a3real_zero;
+	a3real2 sample;
+	a3index i;
+	if (!sampleTable_out || !arclenTable_out || !numDivisions)
+		return a3real_zero;
+	for (i = 0; i <= numDivisions; ++i)
+	{
+		t = (a3real)i * dt;
+		a3real2Bezier3(sample, v0, v1, v2, v3, t);
+		arclen = a3real2InternalArcLengthStore(sampleTable_out, paramTable_out, arclenTable_out, i, t, sample, arclen);
+	}
+	if (autoNormalize)
+		a3real2InternalArcLengthNormalize(arclenTable_out, numDivisions, arclen);
+	return arclen;
+}
+
+A3_INLINE a3real a3real2CalculateArcLengthBezierN(a3real2 sampleTable_out[], a3real paramTable_out[], a3real arclenTable_out[], const a3boolean autoNormalize, const a3count numDivisions, const a3count order_N, const a3real2 v[])
+{
+	const a3real dt = a3real_one / (a3real)numDivisions;
+	a3real t, arclen = a3real_zero;
+	a3real2 sample;
+	a3index i;
+	if (!sampleTable_out || !arclenTable_out || !numDivisions)
+		return a3real_zero;
+	for (i = 0; i <= numDivisions; ++i)
+	{
+		t = (a3real)i * dt;
+		a3real2BezierN(sample, order_N, v, t);
+		arclen = a3real2InternalArcLengthStore(sampleTable_out, paramTable_out, arclenTable_out, i, t, sample, arclen);
+	}
+	if (autoNormalize)
+		a3real2InternalArcLengthNormalize(arclenTable_out, numDivisions, arclen);
+	return arclen;
+}
+
+A3_INLINE a3real a3real2CalculateArcLengthSlerp(a3real2 sampleTable_out[], a3real paramTable_out[], a3real arclenTable_out[], const a3boolean autoNormalize, const a3count numDivisions, const a3real2p v0, const a3real2p v1)
+{
+	const a3real dt = a3real_one / (a3real)numDivisions;
+	a3real t, arclen = a3real_zero;
+	a3real2 sample;
+	a3index i;
+	if (!sampleTable_out || !arclenTable_out || !numDivisions)
+		return a3real_zero;
+	for (i = 0; i <= numDivisions; ++i)
+	{
+		t = (a3real)i * dt;
+		a3real2Slerp(sample, v0, v1, t);
+		arclen = a3real2InternalArcLengthStore(sampleTable_out, paramTable_out, arclenTable_out, i, t, sample, arclen);
+	}
+	if (autoNormalize)
+		a3real2InternalArcLengthNormalize(arclenTable_out, numDivisions, arclen);
+	return arclen;
+}
+
+A3_INLINE a3real a3real2CalculateArcLengthSlerpUnit(a3real2 sampleTable_out[], a3real paramTable_out[], a3real arclenTable_out[], const a3boolean autoNormalize, const a3count numDivisions, const a3real2p v0, const a3real2p v1)
+{
+	const a3real dt = a3real_one / (a3real)numDivisions;
+	a3real t, arclen = a3real_zero;
+	a3real2 sample;
+	a3index i;
+	if (!sampleTable_out || !arclenTable_out || !numDivisions)
+		return a3real_zero;
+	for (i = 0; i <= numDivisions; ++i)
+	{
+		t = (a3real)i * dt;
+		a3real2SlerpUnit(sample, v0, v1, t);
+		arclen = a3real2InternalArcLengthStore(sampleTable_out, paramTable_out, arclenTable_out, i, t, sample, arclen);
+	}
+	if (autoNormalize)
+		a3real2InternalArcLengthNormalize(arclenTable_out, numDivisions, arclen);
+	return arclen;
+}
+
+
+A3_INLINE a3real2r a3real2GramSchmidtOrtho(a3real2p v_out, const a3real2p v, const a3real2p vBase)
+{
+	const a3real ratio = a3real2ProjRatio(v, vBase);
+	v_out[0] = v[0] - vBase[0] * ratio;
+	v_out[1] = v[1] - vBase[1] * ratio;
+	return v_out;
+}
+
+A3_INLINE a3real2r a3real2GramSchmidt(a3real2p v_inout, const a3real2p vBase)
+{
+	return a3real2GramSchmidtOrtho(v_inout, v_inout, vBase);
+}
+
+
+A3_INLINE a3real a3real2CrossZ(const a3real2p vL, const a3real2p vR)
+{
+	return (vL[0] * vR[1] - vL[1] * vR[0]);
+}
+
+A3_INLINE a3real a3real2TriangleAreaDoubled(const a3real2p v0, const a3real2p v1, const a3real2p v2)
+{
+	return ((v1[0] - v0[0]) * (v2[1] - v0[1]) - (v1[1] - v0[1]) * (v2[0] - v0[0]));
+}
+
+A3_INLINE a3real a3real2TriangleAreaSquared(const a3real2p v0, const a3real2p v1, const a3real2p v2)
+{
+	const a3real a2 = a3real2TriangleAreaDoubled(v0, v1, v2);
+	return (a2 * a2 * a3real_quarter);
+}
+
+A3_INLINE a3real a3real2TriangleArea(const a3real2p v0, const a3real2p v1, const a3real2p v2)
+{
+	return (a3real2TriangleAreaDoubled(v0, v1, v2) * a3real_half);
+}
+
+
+A3_INLINE a3boolean a3real2PointIsInTriangle(const a3real2p p, const a3real2p v0, const a3real2p v1, const a3real2p v2)
+{
+	a3real param0, param1, param2;
+	return a3real2PointIsInTriangleBarycentric(p, v0, v1, v2, &param0, &param1, &param2);
+}
+
+A3_INLINE a3boolean a3real2PointIsInTriangleBarycentric(const a3real2p p, const a3real2p v0, const a3real2p v1, const a3real2p v2, a3real *param0, a3real *param1, a3real *param2)
+{
+	// barycentric coordinates from edge dot products
+	a3real2 e1, e2, ep;
+	a3real d11, d12, d22, dp1, dp2, denomInv;
+	a3real2Diff(e1, v1, v0);
+	a3real2Diff(e2, v2, v0);
+	a3real2Diff(ep, p, v0);
+	d11 = a3real2Dot(e1, e1);
+	d12 = a3real2Dot(e1, e2);
+	d22 = a3real2Dot(e2, e2);
+	dp1 = a3real2Dot(ep, e1);
+	dp2 = a3real2Dot(ep, e2);
+	denomInv = a3real_one / (d11 * d22 - d12 * d12);
+	*param1 = (d22 * dp1 - d12 * dp2) * denomInv;
+	*param2 = (d11 * dp2 - d12 * dp1) * denomInv;
+	*param0 = a3real_one - *param1 - *param2;
+	return (*param0 >= a3real_zero && *param1 >= a3real_zero && *param2 >= a3real_zero);
+}
+
+
+//-----------------------------------------------------------------------------
+
+// constants are static per translation unit (declared extern otherwise)
+A3_GLOBAL const a3vec2 a3vec2_zero = { { a3real_zero, a3real_zero } };
+A3_GLOBAL const a3vec2 a3vec2_one = { { a3real_one, a3real_one } };
+A3_GLOBAL const a3vec2 a3vec2_x = { { a3real_one, a3real_zero } };
+A3_GLOBAL const a3vec2 a3vec2_y = { { a3real_zero, a3real_one } };
+
+
+//-----------------------------------------------------------------------------
+
+
+A3_END_IMPL
+
+
+#endif	// !__ANIMAL3D_A3DM_VECTOR2_IMPL_INL
+#endif	// __ANIMAL3D_A3DM_VECTOR_H
@@ -0,0 +1,784 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	animal3D Math (A3DM) SDK
+	By Daniel S. Buckstein
+
+	a3vector3_impl.inl
+	Implementations of 3D vector functions.
+*/
+
+#ifdef __ANIMAL3D_A3DM_VECTOR_H
+#ifndef __ANIMAL3D_A3DM_VECTOR3_IMPL_INL
+#define __ANIMAL3D_A3DM_VECTOR3_IMPL_INL
+
+
+#include "../a3interpolation.h"
+#include "../a3sqrt.h"
+#include "../a3trig.h"
+
+
+A3_BEGIN_IMPL
+
+
+//-----------------------------------------------------------------------------
+// internal helpers
+
+// store sample i of an arc length table and return running arc length
+A3_INLINE a3real a3real3InternalArcLengthStore(a3real3 sampleTable_out[], a3real paramTable_out[], a3real arclenTable_out[], const a3index i, const a3real param, const a3real3p sample, a3real arclen)
+{
+	if (i)
+		arclen += a3real3Distance(sample, sampleTable_out[i - 1]);
+	a3real3SetReal3(sampleTable_out[i], sample);
+	arclenTable_out[i] = arclen;
+	if (paramTable_out)
+		paramTable_out[i] = param;
+	return arclen;
+}
+
+// normalize arc length table (first entry is always zero)
+A3_INLINE void a3real3InternalArcLengthNormalize(a3real arclenTable_out[], const a3count numDivisions, const a3real arclen)
+{
+	const a3real arclenInv = arclen != a3real_zero ? a3real_one / arclen : a3real_zero;
+	a3index i;
+	for (i = 1; i <= numDivisions; ++i)
+		arclenTable_out[i] *= arclenInv;
+}
+
+
+//-----------------------------------------------------------------------------
+
+A3_INLINE a3real3r a3real3Set(a3real3p v_out, const a3real x, const a3real y, const a3real z)
+{
+	v_out[0] = x;
+	v_out[1] = y;
+	v_out[2] = z;
+	return v_out;
+}
+
+A3_INLINE a3real3r a3real3SetReal2(a3real3p v_out, const a3real2p v)
+{
+	v_out[0] = v[0];
+	v_out[1] = v[1];
+	v_out[2] = a3real_zero;
+	return v_out;
+}
+
+A3_INLINE a3real3r a3real3SetReal2Z(a3real3p v_out, const a3real2p v, const a3real z)
+{
+	v_out[0] = v[0];
+	v_out[1] = v[1];
+	v_out[2] = z;
+	return v_out;
+}
+
+A3_INLINE a3real3r a3real3SetReal3(a3real3p v_out, const a3real3p v)
+{
+	v_out[0] = v[0];
+	v_out[1] = v[1];
+	v_out[2] = v[2];
+	return v_out;
+}
+
+A3_INLINE a3real3r a3real3SetReal4(a3real3p v_out, const a3real4p v)
+{
+	v_out[0] = v[0];
+	v_out[1] = v[1];
+	v_out[2] = v[2];
+	return v_out;
+}
+
+
+A3_INLINE a3real a3real3LengthSquared(const a3real3p v)
+{
+	return (v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+}
+
+A3_INLINE a3real a3real3LengthSquaredInverse(const a3real3p v)
+{
+	return (a3real_one / a3real3LengthSquared(v));
+}
+
+A3_INLINE a3real a3real3Length(const a3real3p v)
+{
+	return a3sqrt(a3real3LengthSquared(v));
+}
+
+A3_INLINE a3real a3real3LengthInverse(const a3real3p v)
+{
+	return a3sqrtInverse(a3real3LengthSquared(v));
+}
+
+A3_INLINE a3real3r a3real3GetUnit(a3real3p v_out, const a3real3p v)
+{
+	const a3real lenInv = a3real3LengthInverse(v);
+	v_out[0] = v[0] * lenInv;
+	v_out[1] = v[1] * lenInv;
+	v_out[2] = v[2] * lenInv;
+	return v_out;
+}
+
+A3_INLINE a3real3r a3real3Normalize(a3real3p v_inout)
+{
+	return a3real3GetUnit(v_inout, v_inout);
+}
+
+A3_INLINE a3real3r a3real3GetUnitInvLength(a3real3p v_out, const a3real3p v, a3real *invLength_out)
+{
+	const a3real lenInv = a3real3LengthInverse(v);
+	v_out[0] = v[0] * lenInv;
+	v_out[1] = v[1] * lenInv;
+	v_out[2] = v[2] * lenInv;
+	if (invLength_out)
+		*invLength_out = lenInv;
+	return v_out;
+}
+
+A3_INLINE a3real3r a3real3NormalizeGetInvLength(a3real3p v_inout, a3real *invLength_out)
+{
+	return a3real3GetUnitInvLength(v_inout, v_inout, invLength_out);
+}
+
+A3_INLINE a3real3r a3real3GetNegative(a3real3p v_out, const a3real3p v)
+{
+	v_out[0] = -v[0];
+	v_out[1] = -v[1];
+	v_out[2] = -v[2];
+	return v_out;
+}
+
+A3_INLINE a3real3r a3real3Negate(a3real3p v_inout)
+{
+	v_inout[0] = -v_inout[0];
+	v_inout[1] = -v_inout[1];
+	v_inout[2] = -v_inout[2];
+	return v_inout;
+}
+
+
+A3_INLINE a3real a3real3Dot(const a3real3p vL, const a3real3p vR)
+{
+	return (vL[0] * vR[0] + vL[1] * vR[1] + vL[2] * vR[2]);
+}
+
+A3_INLINE a3real a3real3DistanceSquared(const a3real3p v0, const a3real3p v1)
+{
+	a3real3 d;
+	return a3real3LengthSquared(a3real3Diff(d, v1, v0));
+}
+
+A3_INLINE a3real a3real3Distance(const a3real3p v0, const a3real3p v1)
+{
+	return a3sqrt(a3real3DistanceSquared(v0, v1));
+}
+
+A3_INLINE a3real a3real3ProjRatio(const a3real3p v, const a3real3p vBase)
+{
+	return (a3real3Dot(v, vBase) / a3real3LengthSquared(vBase));
+}
+
+A3_INLINE a3real3r a3real3Projected(a3real3p v_out, const a3real3p v, const a3real3p vBase)
+{
+	return a3real3ProductS(v_out, vBase, a3real3ProjRatio(v, vBase));
+}
+
+A3_INLINE a3real3r a3real3Proj(a3real3p v_inout, const a3real3p vBase)
+{
+	return a3real3Projected(v_inout, v_inout, vBase);
+}
+
+A3_INLINE a3real3r a3real3ProjectedGetRatio(a3real3p v_out, const a3real3p v, const a3real3p vBase, a3real *ratio_out)
+{
+	const a3real ratio = a3real3ProjRatio(v, vBase);
+	if (ratio_out)
+		*ratio_out = ratio;
+	return a3real3ProductS(v_out, vBase, ratio);
+}
+
+A3_INLINE a3real3r a3real3ProjGetRatio(a3real3p v_inout, const a3real3p vBase, a3real *ratio_out)
+{
+	return a3real3ProjectedGetRatio(v_inout, v_inout, vBase, ratio_out);
+}
+
+A3_INLINE a3real3r a3real3Sum(a3real3p v_out, const a3real3p vL, const a3real3p vR)
+{
+	v_out[0] = vL[0] + vR[0];
+	v_out[1] = vL[1] + vR[1];
+	v_out[2] = vL[2] + vR[2];
+	return v_out;
+}
+
+A3_INLINE a3real3r a3real3Diff(a3real3p v_out, const a3real3p vL, const a3real3p vR)
+{
+	v_out[0] = vL[0] - vR[0];
+	v_out[1] = vL[1] - vR[1];
+	v_out[2] = vL[2] - vR[2];
+	return v_out;
+}
+
+A3_INLINE a3real3r a3real3ProductS(a3real3p v_out, const a3real3p v, const a3real s)
+{
+	v_out[0] = v[0] * s;
+	v_out[1] = v[1] * s;
+	v_out[2] = v[2] * s;
+	return v_out;
+}
+
+A3_INLINE a3real3r a3real3QuotientS(a3real3p v_out, const a3real3p v, const a3real s)
+{
+	return a3real3ProductS(v_out, v, a3real_one / s);
+}
+
+A3_INLINE a3real3r a3real3ProductComp(a3real3p v_out, const a3real3p vL, const a3real3p vR)
+{
+	v_out[0] = vL[0] * vR[0];
+	v_out[1] = vL[1] * vR[1];
+	v_out[2] = vL[2] * vR[2];
+	return v_out;
+}
+
+A3_INLINE a3real3r a3real3QuotientComp(a3real3p v_out, const a3real3p vL, const a3real3p vR)
+{
+	v_out[0] = vL[0] / vR[0];
+	v_out[1] = vL[1] / vR[1];
+	v_out[2] = vL[2] / vR[2];
+	return v_out;
+}
+
+A3_INLINE a3real3r a3real3Add(a3real3p vL_inout, const a3real3p vR)
+{
+	vL_inout[0] += vR[0];
+	vL_inout[1] += vR[1];
+	vL_inout[2] += vR[2];
+	return vL_inout;
+}
+
+A3_INLINE a3real3r a3real3Sub(a3real3p vL_inout, const a3real3p vR)
+{
+	vL_inout[0] -= vR[0];
+	vL_inout[1] -= vR[1];
+	vL_inout[2] -= vR[2];
+	return vL_inout;
+}
+
+A3_INLINE a3real3r a3real3MulS(a3real3p v_inout, const a3real s)
+{
+	v_inout[0] *= s;
+	v_inout[1] *= s;
+	v_inout[2] *= s;
+	return v_inout;
+}
+
+A3_INLINE a3real3r a3real3DivS(a3real3p v_inout, const a3real s)
+{
+	return a3real3MulS(v_inout, a3real_one / s);
+}
+
+A3_INLINE a3real3r a3real3MulComp(a3real3p vL_inout, const a3real3p vR)
+{
+	vL_inout[0] *= vR[0];
+	vL_inout[1] *= vR[1];
+	vL_inout[2] *= vR[2];
+	return vL_inout;
+}
+
+A3_INLINE a3real3r a3real3DivComp(a3real3p vL_inout, const a3real3p vR)
+{
+	vL_inout[0] /= vR[0];
+	vL_inout[1] /= vR[1];
+	vL_inout[2] /= vR[2];
+	return vL_inout;
+}
+
+
+A3_INLINE a3real3r a3real3Lerp(a3real3p v_out, const a3real3p v0, const a3real3p v1, const a3real param)
+{
+	v_out[0] = a3lerpFunc(v0[0], v1[0], param);
+	v_out[1] = a3lerpFunc(v0[1], v1[1], param);
+	v_out[2] = a3lerpFunc(v0[2], v1[2], param);
+	return v_out;
+}
+
+A3_INLINE a3real3r a3real3NLerp(a3real3p v_out, const a3real3p v0, const a3real3p v1, const a3real param)
+{
+	return a3real3Normalize(a3real3Lerp(v_out, v0, v1, param));
+}
+
+A3_INLINE a3real3r a3real3Bilerp(a3real3p v_out, const a3real3p v00, const a3real3p v01, const a3real3p v10, const a3real3p v11, const a3real param0, const a3real param1)
+{
+	v_out[0] = a3bilerp(v00[0], v01[0], v10[0], v11[0], param0, param1);
+	v_out[1] = a3bilerp(v00[1], v01[1], v10[1], v11[1], param0, param1);
+	v_out[2] = a3bilerp(v00[2], v01[2], v10[2], v11[2], param0, param1);
+	return v_out;
+}
+
+A3_INLINE a3real3r a3real3Trilerp(a3real3p v_out, const a3real3p v000, const a3real3p v001, const a3real3p v010, const a3real3p v011, const a3real3p v100, const a3real3p v101, const a3real3p v110, const a3real3p v111, const a3real param0, const a3real param1, const a3real param2)
+{
+	v_out[0] = a3trilerp(v000[0], v001[0], v010[0], v011[0], v100[0], v101[0], v110[0], v111[0], param0, param1, param2);
+	v_out[1] = a3trilerp(v000[1], v001[1], v010[1], v011[1], v100[1], v101[1], v110[1], v111[1], param0, param1, param2);
+	v_out[2] = a3trilerp(v000[2], v001[2], v010[2], v011[2], v100[2], v101[2], v110[2], v111[2], param0, param1, param2);
+	return v_out;
+}
+
+A3_INLINE a3real3r a3real3CatmullRom(a3real3p v_out, const a3real3p vPrev, const a3real3p v0, const a3real3p v1, const a3real3p vNext, const a3real param)
+{
+	v_out[0] = a3CatmullRom(vPrev[0], v0[0], v1[0], vNext[0], param);
+	v_out[1] = a3CatmullRom(vPrev[1], v0[1], v1[1], vNext[1], param);
+	v_out[2] = a3CatmullRom(vPrev[2], v0[2], v1[2], vNext[2], param);
+	return v_out;
+}
+
+A3_INLINE a3real3r a3real3HermiteControl(a3real3p v_out, const a3real3p v0, const a3real3p v1, const a3real3p vControl0, const a3real3p vControl1, const a3real param)
+{
+	v_out[0] = a3HermiteControl(v0[0], v1[0], vControl0[0], vControl1[0], param);
+	v_out[1] = a3HermiteControl(v0[1], v1[1], vControl0[1], vControl1[1], param);
+	v_out[2] = a3HermiteControl(v0[2], v1[2], vControl0[2], vControl1[2], param);
+	return v_out;
+}
+
+A3_INLINE a3real3r a3real3HermiteTangent(a3real3p v_out, const a3real3p v0, const a3real3p v1, const a3real3p vTangent0, const a3real3p vTangent1, const a3real param)
+{
+	v_out[0] = a3HermiteTangent(v0[0], v1[0], vTangent0[0], vTangent1[0], param);
+	v_out[1] = a3HermiteTangent(v0[1], v1[1], vTangent0[1], vTangent1[1], param);
+	v_out[2] = a3HermiteTangent(v0[2], v1[2], vTangent0[2], vTangent1[2], param);
+	return v_out;
+}
+
+A3_INLINE a3real3r a3real3Bezier0(a3real3p v_out, const a3real3p v0, const a3real param)
+{
+	return a3real3SetReal3(v_out, v0);
+}
+
+A3_INLINE a3real3r a3real3Bezier1(a3real3p v_out, const a3real3p v0, const a3real3p v1, const a3real param)
+{
+	return a3real3Lerp(v_out, v0, v1, param);
+}
+
+A3_INLINE a3real3r a3real3Bezier2(a3real3p v_out, const a3real3p v0, const a3real3p v1, const a3real3p v2, const a3real param)
+{
+	v_out[0] = a3Bezier2(v0[0], v1[0], v2[0], param);
+	v_out[1] = a3Bezier2(v0[1], v1[1], v2[1], param);
+	v_out[2] = a3Bezier2(v0[2], v1[2], v2[2], param);
+	return v_out;
+}
+
+A3_INLINE a3real3r a3real3Bezier3(a3real3p v_out, const a3real3p v0, const a3real3p v1, const a3real3p v2, const a3real3p v3, const a3real param)
+{
+	v_out[0] = a3Bezier3(v0[0], v1[0], v2[0], v3[0], param);
+	v_out[1] = a3Bezier3(v0[1], v1[1], v2[1], v3[1], param);
+	v_out[2] = a3Bezier3(v0[2], v1[2], v2[2], v3[2], param);
+	return v_out;
+}
+
+A3_INLINE a3real3r a3real3BezierN(a3real3p v_out, a3count order_N, const a3real3 v[], const a3real param)
+{
+	a3real3 n0, n1;
+	if (order_N)
+	{
+		if (--order_N)
+			return a3real3Lerp(v_out, a3real3BezierN(n0, order_N, v, param), a3real3BezierN(n1, order_N, v + 1, param), param);
+		return a3real3Lerp(v_out, v[0], v[1], param);
+	}
+	return a3real3SetReal3(v_out, v[0]);
+}
+
+A3_INLINE a3real3r a3real3Slerp(a3real3p v_out, const a3real3p v0, const a3real3p v1, const a3real param)
+{
+	const a3real d = a3real3Dot(v0, v1) * a3sqrtInverse(a3real3LengthSquared(v0) * a3real3LengthSquared(v1));
+	a3real a, s, s0, s1;
+	if (d > -a3real_one && d < a3real_one)
+	{
+		a = a3acosd(d);
+		s = a3cscd(a);
+		s0 = a3sind((a3real_one - param) * a) * s;
+		s1 = a3sind(param * a) * s;
+		v_out[0] = v0[0] * s0 + v1[0] * s1;
+		v_out[1] = v0[1] * s0 + v1[1] * s1;
+		v_out[2] = v0[2] * s0 + v1[2] * s1;
+		return v_out;
+	}
+	return a3real3SetReal3(v_out, v0);
+}
+
+A3_INLINE a3real3r a3real3SlerpUnit(a3real3p v_out, const a3real3p v0, const a3real3p v1, const a3real param)
+{
+	const a3real d = a3real3Dot(v0, v1);
+	a3real a, s, s0, s1;
+	if (d > -a3real_one && d < a3real_one)
+	{
+		a = a3acosd(d);
+		s = a3cscd(a);
+		s0 = a3sind((a3real_one - param) * a) * s;
+		s1 = a3sind(param * a) * s;
+		v_out[0] = v0[0] * s0 + v1[0] * s1;
+		v_out[1] = v0[1] * s0 + v1[1] * s1;
+		v_out[2] = v0[2] * s0 + v1[2] * s1;
+		return v_out;
+	}
+	return a3real3SetReal3(v_out, v0);
+}
+
+A3_INLINE a3real a3real3CalculateArcLengthCatmullRom(a3real3 sampleTable_out[], a3real paramTable_out[], a3real arclenTable_out[], const a3boolean autoNormalize, const a3count numDivisions, const a3real3p vPrev, const a3real3p v0, const a3real3p v1, const a3real3p vNext)
+{
+	const a3real dt = a3real_one / (a3real)numDivisions;
+	a3real t, arclen = a3real_zero;
+	a3real3 sample;
+	a3index i;
+	if (!sampleTable_out || !arclenTable_out || !numDivisions)
+		return a3real_zero;
+	for (i = 0; i <= numDivisions; ++i)
+	{
+		t = (a3real)i * dt;
+		a3real3CatmullRom(sample, vPrev, v0, v1, vNext, t);
+		arclen = a3real3InternalArcLengthStore(sampleTable_out, paramTable_out, arclenTable_out, i, t, sample, arclen);
+	}
+	if (autoNormalize)
+		a3real3InternalArcLengthNormalize(arclenTable_out, numDivisions, arclen);
+	return arclen;
+}
+
+A3_INLINE a3real a3real3CalculateArcLengthHermiteControl(a3real3 sampleTable_out[], a3real paramTable_out[], a3real arclenTable_out[], const a3boolean autoNormalize, const a3count numDivisions, const a3real3p v0, const a3real3p v1, const a3real3p vControl0, const a3real3p vControl1)
+{
+	const a3real dt = a3real_one / (a3real)numDivisions;
+	a3real t, arclen = a3real_zero;
+	a3real3 sample;
+	a3index i;
+	if (!sampleTable_out || !arclenTable_out || !numDivisions)
+		return a3real_zero;
+	for (i = 0; i <= numDivisions; ++i)
+	{
+		t = (a3real)i * dt;
+		a3real3HermiteControl(sample, v0, v1, vControl0, vControl1, t);
+		arclen = a3real3InternalArcLengthStore(sampleTable_out, paramTable_out, arclenTable_out, i, t, sample, arclen);
+	}
+	if (autoNormalize)
+		a3real3InternalArcLengthNormalize(arclenTable_out, numDivisions, arclen);
+	return arclen;
+}
+
+A3_INLINE a3real a3real3CalculateArcLengthHermiteTangent(a3real3 sampleTable_out[], a3real paramTable_out[], a3real arclenTable_out[], const a3boolean autoNormalize, const a3count numDivisions, const a3real3p v0, const a3real3p v1, const a3real3p vTangent0, const a3real3p vTangent1)
+{
+	const a3real dt = a3real_one / (a3real)numDivisions;
+	a3real t, arclen = a3real_zero;
+	a3real3 sample;
+	a3index i;
+	if (!sampleTable_out || !arclenTable_out || !numDivisions)
+		return a3real_zero;
+	for (i = 0; i <= numDivisions; ++i)
+	{
+		t = (a3real)i * dt;
+		a3real3HermiteTangent(sample, v0, v1, vTangent0, vTangent1, t);
+		arclen = a3real3InternalArcLengthStore(sampleTable_out, paramTable_out, arclenTable_out, i, t, sample, arclen);
+	}
+	if (autoNormalize)
+		a3real3InternalArcLengthNormalize(arclenTable_out, numDivisions, arclen);
+	return arclen;
+}
+
+A3_INLINE a3real a3real3CalculateArcLengthBezier0(a3real3 sampleTable_out[], a3real paramTable_out[], a3real arclenTable_out[], const a3boolean autoNormalize, const a3count numDivisions, const a3real3p v0)
+{
+	const a3real dt = a3real_one / (a3real)numDivisions;
+	a3real t, arclen = a3real_zero;
+	a3real3 sample;
+	a3index i;
+	if (!sampleTable_out || !arclenTable_out || !numDivisions)
+		return a3real_zero;
+	for (i = 0; i <= numDivisions; ++i)
+	{
+		t = (a3real)i * dt;
+		a3real3Bezier0(sample, v0, t);
+		arclen = a3real3InternalArcLengthStore(sampleTable_out, paramTable_out, arclenTable_out, i, t, sample, arclen);
+	}
+	if (autoNormalize)
+		a3real3InternalArcLengthNormalize(arclenTable_out, numDivisions, arclen);
+	return arclen;
+}
+
+A3_INLINE a3real a3real3CalculateArcLengthBezier1(a3real3 sampleTable_out[], a3real paramTable_out[], a3real arclenTable_out[], const a3boolean autoNormalize, const a3count numDivisions, const a3real3p v0, const a3real3p v1)
+{
+	const a3real dt = a3real_one / (a3real)numDivisions;
+	a3real t, arclen = a3real_zero;
+	a3real3 sample;
+	a3index i;
+	if (!sampleTable_out || !arclenTable_out || !numDivisions)
+		return a3real_zero;
+	for (i = 0; i <= numDivisions; ++i)
+	{
+		t = (a3real)i * dt;
+		a3real3Bezier1(sample, v0, v1, t);
+		arclen = a3real3InternalArcLengthStore(sampleTable_out, paramTable_out, arclenTable_out, i, t, sample, arclen);
+	}
+	if (autoNormalize)
+		a3real3InternalArcLengthNormalize(arclenTable_out, numDivisions, arclen);
+	return arclen;
+}
+
+A3_INLINE a3real a3real3CalculateArcLengthBezier2(a3real3 sampleTable_out[], a3real paramTable_out[], a3real arclenTable_out[], const a3boolean autoNormalize, const a3count numDivisions, const a3real3p v0, const a3real3p v1, const a3real3p v2)
+{
+	const a3real dt = a3real_one / (a3real)numDivisions;
+	a3real t, arclen = a3real_zero;
+	a3real3 sample;
+	a3index i;
+	if (!sampleTable_out || !arclenTable_out || !numDivisions)
+		return a3real_zero;
+	for (i = 0; i <= numDivisions; ++i)
+	{
+		t = (a3real)i * dt;
+		a3real3Bezier2(sample, v0, v1, v2, t);
+		arclen = a3real3InternalArcLengthStore(sampleTable_out, paramTable_out, arclenTable_out, i, t, sample, arclen);
+	}
+	if (autoNormalize)
+		a3real3InternalArcLengthNormalize(arclenTable_out, numDivisions, arclen);
+	return arclen;
+}
+
+A3_INLINE a3real a3real3CalculateArcLengthBezier3(a3real3 sampleTable_out[], a3real paramTable_out[], a3real arclenTable_out[], const a3boolean autoNormalize, const a3count numDivisions, const a3real3p v0, const a3real3p v1, const a3real3p v2, const a3real3p v3)
+{
+	const a3real dt = a3real_one / (a3real)numDivisions;
+	a3real t, arclen = a3real_zero;
+	a3real3 sample;
+	a3index i;
+	if (!sampleTable_out || !arclenTable_out || !numDivisions)
+		return a3real_zero;
+	for (i = 0; i <= numDivisions; ++i)
+	{
+		t = (a3real)i * dt;
+		a3real3Bezier3(sample, v0, v1, v2, v3, t);
+		arclen = a3real3InternalArcLengthStore(sampleTable_out, paramTable_out, arclenTable_out, i, t, sample, arclen);
+	}
+	if (autoNormalize)
+		a3real3InternalArcLengthNormalize(arclenTable_out, numDivisions, arclen);
+	return arclen;
+}
+
+A3_INLINE a3real a3real3CalculateArcLengthBezierN(a3real3 sampleTable_out[], a3real paramTable_out[], a3real arclenTable_out[], const a3boolean autoNormalize, const a3count numDivisions, const a3count order_N, const a3real3 v[])
+{
+	const a3real dt = a3real_one / (a3real)numDivisions;
+	a3real t, arclen = a3real_zero;
+	a3real3 sample;
+	a3index i;
+	if (!sampleTable_out || !arclenTable_out || !numDivisions)
+		return a3real_zero;
+	for (i = 0; i <= numDivisions; ++i)
+	{
+		t = (a3real)i * dt;
+		a3real3BezierN(sample, order_N, v, t);
+		arclen = a3real3InternalArcLengthStore(sampleTable_out, paramTable_out, arclenTable_out, i, t, sample, arclen);
+	}
+	if (autoNormalize)
+		a3real3InternalArcLengthNormalize(arclenTable_out, numDivisions, arclen);
+	return arclen;
+}
+
+A3_INLINE a3real a3real3CalculateArcLengthSlerp(a3real3 sampleTable_out[], a3real paramTable_out[], a3real arclenTable_out[], const a3boolean autoNormalize, const a3count numDivisions, const a3real3p v0, const a3real3p v1)
+{
+	const a3real dt = a3real_one / (a3real)numDivisions;
+	a3real t, arclen = a3real_zero;
+	a3real3 sample;
+	a3index i;
+	if (!sampleTable_out || !arclenTable_out || !numDivisions)
+		return a3real_zero;
+	for (i = 0; i <= numDivisions; ++i)
+	{
+		t = (a3real)i * dt;
+		a3real3Slerp(sample, v0, v1, t);
+		arclen = a3real3InternalArcLengthStore(sampleTable_out, paramTable_out, arclenTable_out, i, t, sample, arclen);
+	}
+	if (autoNormalize)
+		a3real3InternalArcLengthNormalize(arclenTable_out, numDivisions, arclen);
+	return arclen;
+}
+
+A3_INLINE a3real a3real3CalculateArcLengthSlerpUnit(a3real3 sampleTable_out[], a3real paramTable_out[], a3real arclenTable_out[], const a3boolean autoNormalize, const a3count numDivisions, const a3real3p v0, const a3real3p v1)
+{
+	const a3real dt = a3real_one / (a3real)numDivisions;
+	a3real t, arclen = a3real_zero;
+	a3real3 sample;
+	a3index i;
+	if (!sampleTable_out || !arclenTable_out || !numDivisions)
+		return a3real_zero;
+	for (i = 0; i <= numDivisions; ++i)
+	{
+		t = (a3real)i * dt;
+		a3real3SlerpUnit(sample, v0, v1, t);
+		arclen = a3real3InternalArcLengthStore(sampleTable_out, paramTable_out, arclenTable_out, i, t, sample, arclen);
+	}
+	if (autoNormalize)
+		a3real3InternalArcLengthNormalize(arclenTable_out, numDivisions, arclen);
+	return arclen;
+}
+
+
+A3_INLINE a3real3r a3real3GramSchmidtOrtho(a3real3p v_out, const a3real3p v, const a3real3p vBase)
+{
+	const a3real ratio = a3real3ProjRatio(v, vBase);
+	v_out[0] = v[0] - vBase[0] * ratio;
+	v_out[1] = v[1] - vBase[1] * ratio;
+	v_out[2] = v[2] - vBase[2] * ratio;
+	return v_out;
+}
+
+A3_INLINE a3real3r a3real3GramSchmidtOrtho2(a3real3p v0_out, a3real3p v1_out, const a3real3p v0, const a3real3p v1, const a3real3p vBase)
+{
+	a3real ratio0, ratio1;
+	a3real3GramSchmidtOrtho(v0_out, v0, vBase);
+	ratio0 = a3real3ProjRatio(v1, vBase);
+	ratio1 = a3real3ProjRatio(v1, v0_out);
+	v1_out[0] = v1[0] - vBase[0] * ratio0 - v0_out[0] * ratio1;
+	v1_out[1] = v1[1] - vBase[1] * ratio0 - v0_out[1] * ratio1;
+	v1_out[2] = v1[2] - vBase[2] * ratio0 - v0_out[2] * ratio1;
+	return v1_out;
+}
+
+A3_INLINE a3real3r a3real3GramSchmidt(a3real3p v_inout, const a3real3p vBase)
+{
+	return a3real3GramSchmidtOrtho(v_inout, v_inout, vBase);
+}
+
+A3_INLINE a3real3r a3real3GramSchmidt2(a3real3p v0_inout, a3real3p v1_inout, const a3real3p vBase)
+{
+	return a3real3GramSchmidtOrtho2(v0_inout, v1_inout, v0_inout, v1_inout, vBase);
+}
+
+
+A3_INLINE a3real3r a3real3Cross(a3real3p v_out, const a3real3p vL, const a3real3p vR)
+{
+	const a3real x = vL[1] * vR[2] - vL[2] * vR[1];
+	const a3real y = vL[2] * vR[0] - vL[0] * vR[2];
+	const a3real z = vL[0] * vR[1] - vL[1] * vR[0];
+	return a3real3Set(v_out, x, y, z);
+}
+
+A3_INLINE a3real3r a3real3CrossUnit(a3real3p v_out, const a3real3p vL, const a3real3p vR)
+{
+	return a3real3Normalize(a3real3Cross(v_out, vL, vR));
+}
+
+A3_INLINE a3real3r a3real3TriangleNormal(a3real3p n_out, const a3real3p v0, const a3real3p v1, const a3real3p v2)
+{
+	a3real3 e0, e1;
+	a3real3Diff(e0, v1, v0);
+	a3real3Diff(e1, v2, v0);
+	return a3real3Cross(n_out, e0, e1);
+}
+
+A3_INLINE a3real3r a3real3TriangleNormalUnit(a3real3p n_out, const a3real3p v0, const a3real3p v1, const a3real3p v2)
+{
+	return a3real3Normalize(a3real3TriangleNormal(n_out, v0, v1, v2));
+}
+
+A3_INLINE a3real a3real3TriangleAreaDoubledNormal(a3real3p n_out, const a3real3p v0, const a3real3p v1, const a3real3p v2)
+{
+	return a3real3Length(a3real3TriangleNormal(n_out, v0, v1, v2));
+}
+
+A3_INLINE a3real a3real3TriangleAreaSquaredNormal(a3real3p n_out, const a3real3p v0, const a3real3p v1, const a3real3p v2)
+{
+	return (a3real3LengthSquared(a3real3TriangleNormal(n_out, v0, v1, v2)) * a3real_quarter);
+}
+
+A3_INLINE a3real a3real3TriangleAreaNormal(a3real3p n_out, const a3real3p v0, const a3real3p v1, const a3real3p v2)
+{
+	return (a3real3Length(a3real3TriangleNormal(n_out, v0, v1, v2)) * a3real_half);
+}
+
+A3_INLINE a3real a3real3TriangleAreaDoubledNormalUnit(a3real3p n_out, const a3real3p v0, const a3real3p v1, const a3real3p v2)
+{
+	a3real lenInv;
+	a3real3NormalizeGetInvLength(a3real3TriangleNormal(n_out, v0, v1, v2), &lenInv);
+	return (a3real_one / lenInv);
+}
+
+A3_INLINE a3real a3real3TriangleAreaSquaredNormalUnit(a3real3p n_out, const a3real3p v0, const a3real3p v1, const a3real3p v2)
+{
+	a3real lenInv;
+	a3real3NormalizeGetInvLength(a3real3TriangleNormal(n_out, v0, v1, v2), &lenInv);
+	return (a3real_quarter / (lenInv * lenInv));
+}
+
+A3_INLINE a3real a3real3TriangleAreaNormalUnit(a3real3p n_out, const a3real3p v0, const a3real3p v1, const a3real3p v2)
+{
+	a3real lenInv;
+	a3real3NormalizeGetInvLength(a3real3TriangleNormal(n_out, v0, v1, v2), &lenInv);
+	return (a3real_half / lenInv);
+}
+
+A3_INLINE a3real a3real3TriangleAreaDoubled(const a3real3p v0, const a3real3p v1, const a3real3p v2)
+{
+	a3real3 n;
+	return a3real3TriangleAreaDoubledNormal(n, v0, v1, v2);
+}
+
+A3_INLINE a3real a3real3TriangleAreaSquared(const a3real3p v0, const a3real3p v1, const a3real3p v2)
+{
+	a3real3 n;
+	return a3real3TriangleAreaSquaredNormal(n, v0, v1, v2);
+}
+
+A3_INLINE a3real a3real3TriangleArea(const a3real3p v0, const a3real3p v1, const a3real3p v2)
+{
+	a3real3 n;
+	return a3real3TriangleAreaNormal(n, v0, v1, v2);
+}
+
+
+A3_INLINE a3boolean a3real3PointIsInTriangle(const a3real3p p, const a3real3p v0, const a3real3p v1, const a3real3p v2)
+{
+	a3real param0, param1, param2;
+	return a3real3PointIsInTriangleBarycentric(p, v0, v1, v2, &param0, &param1, &param2);
+}
+
+A3_INLINE a3boolean a3real3PointIsInTriangleBarycentric(const a3real3p p, const a3real3p v0, const a3real3p v1, const a3real3p v2, a3real *param0, a3real *param1, a3real *param2)
+{
+	// barycentric coordinates from edge dot products
+	a3real3 e1, e2, ep;
+	a3real d11, d12, d22, dp1, dp2, denomInv;
+	a3real3Diff(e1, v1, v0);
+	a3real3Diff(e2, v2, v0);
+	a3real3Diff(ep, p, v0);
+	d11 = a3real3Dot(e1, e1);
+	d12 = a3real3Dot(e1, e2);
+	d22 = a3real3Dot(e2, e2);
+	dp1 = a3real3Dot(ep, e1);
+	dp2 = a3real3Dot(ep, e2);
+	denomInv = a3real_one / (d11 * d22 - d12 * d12);
+	*param1 = (d22 * dp1 - d12 * dp2) * denomInv;
+	*param2 = (d11 * dp2 - d12 * dp1) * denomInv;
+	*param0 = a3real_one - *param1 - *param2;
+	return (*param0 >= a3real_zero && *param1 >= a3real_zero && *param2 >= a3real_zero);
+}
+
+
+//-----------------------------------------------------------------------------
+
+// constants are static per translation unit (declared extern otherwise)
+A3_GLOBAL const a3vec3 a3vec3_zero = { { a3real_zero, a3real_zero, a3real_zero } };
+A3_GLOBAL const a3vec3 a3vec3_one = { { a3real_one, a3real_one, a3real_one } };
+A3_GLOBAL const a3vec3 a3vec3_x = { { a3real_one, a3real_zero, a3real_zero } };
+A3_GLOBAL const a3vec3 a3vec3_y = { { a3real_zero, a3real_one, a3real_zero } };
+A3_GLOBAL const a3vec3 a3vec3_z = { { a3real_zero, a3real_zero, a3real_one } };
+
+
+//-----------------------------------------------------------------------------
+
+
+A3_END_IMPL
+
+
+#endif	// !__ANIMAL3D_A3DM_VECTOR3_IMPL_INL
+#endif	// __ANIMAL3D_A3DM_VECTOR_H
@@ -0,0 +1,118 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	animal3D Math (A3DM) SDK
+	By Daniel S. Buckstein
+
+	a3arclength.h
+	Arc length by adaptive Gauss-Legendre quadrature and inverse arc-length
+		tables sampled at uniform distances.
+
+	The sample tables in a3interpolation.h store arc length at uniform
+		parameter steps, so finding the parameter at a distance means
+		stepping through the table (a3sampleTableLerpIncrement). The tables
+		generated here store the parameter at uniform arc-length steps
+		instead, so the same lookup is a direct index and one lerp.
+
+	Curves are described by their speed (magnitude of the derivative with
+		respect to the parameter); for a scalar function f this is |f'|, for
+		a vector curve it is the length of the tangent.
+*/
+
+#ifndef __ANIMAL3D_A3DM_ARCLENGTH_H
+#define __ANIMAL3D_A3DM_ARCLENGTH_H
+
+
+#include "a3interpolation.h"
+
+
+A3_BEGIN_DECL
+
+
+//-----------------------------------------------------------------------------
+
+// A3: Speed function: magnitude of curve derivative at parameter.
+//	param data: user data describing the curve
+//	param param: curve parameter
+//	return: speed at param (non-negative)
+typedef a3real(*a3realspeedfunc)(const void* data, const a3real param);
+
+
+//-----------------------------------------------------------------------------
+
+// A3: Integrate speed to get arc length using adaptive Gauss-Legendre
+//		quadrature (5 points); intervals are halved until the two halves
+//		agree with the whole to within their share of the tolerance.
+//	param speedFunc: pointer to speed function
+//	param data: user data passed to speed function
+//	param numDivisions: number of uniform intervals to start from; put
+//		breaks at known kinks (e.g. one per spline segment)
+//	param paramMin: start parameter
+//	param paramMax: end parameter
+//	param tolerance: absolute error allowed for the whole range
+//	return: arc length from paramMin to paramMax
+A3_INLINE a3real a3arclengthIntegrate(const a3realspeedfunc speedFunc, const void* data, const a3count numDivisions, const a3real paramMin, const a3real paramMax, const a3real tolerance);
+
+// A3: Generate inverse arc-length table: parameter at uniform arc-length
+//		steps, so that entry i holds the parameter at distance
+//		i * length / (numSamples - 1); first and last entries are exactly
+//		paramMin and paramMax.
+//	param paramTable_out: array of numSamples parameters
+//	param length_out: optional pointer to store total arc length
+//	param numSamples: number of table entries (at least 2)
+//	param speedFunc, data, numDivisions, paramMin, paramMax, tolerance:
+//		same as a3arclengthIntegrate
+//	return: numSamples if success; zero if invalid params
+A3_INLINE a3index a3sampleTableGenerateArcLengthUniform(a3real paramTable_out[], a3real* length_out, const a3count numSamples, const a3realspeedfunc speedFunc, const void* data, const a3count numDivisions, const a3real paramMin, const a3real paramMax, const a3real tolerance);
+
+// A3: Get scale from distance to table position: (numSamples - 1) / length.
+//	param numSamples: number of table entries
+//	param length: total arc length stored with table
+//	return: table positions per unit distance; zero if length is zero
+A3_INLINE a3real a3sampleTableUniformScale(const a3count numSamples, const a3real length);
+
+// A3: Look up uniformly sampled table in constant time; input is clamped
+//		to the table range.
+//	param valueTable: table sampled at uniform steps (e.g. inverse arc length)
+//	param numSamples: number of table entries
+//	param scale: table positions per unit input (a3sampleTableUniformScale)
+//	param param: input value to look up (e.g. distance along curve)
+//	return: value interpolated from the two surrounding entries
+A3_INLINE a3real a3sampleTableLerpUniform(const a3real valueTable[], const a3count numSamples, const a3real scale, const a3real param);
+
+// A3: Find index of surrounding entries in uniformly sampled table in
+//		constant time; returns the same index as a3sampleTableLerpIncrementIndex
+//		(that of 'n1'; index-1 is 'n0') without searching.
+//	param numSamples: number of table entries
+//	param scale: table positions per unit input (a3sampleTableUniformScale)
+//	param param: input value to look up
+//	param param_out: optional pointer to capture interpolation param
+//	return: index of goal/end value in table
+A3_INLINE a3index a3sampleTableLerpUniformIndex(const a3count numSamples, const a3real scale, const a3real param, a3real* param_out);
+
+
+//-----------------------------------------------------------------------------
+
+
+A3_END_DECL
+
+
+#include "_inl/a3arclength_impl.inl"
+
+
+#endif	// !__ANIMAL3D_A3DM_ARCLENGTH_H
@@ -0,0 +1,149 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	animal3D Math (A3DM) SDK
+	By Daniel S. Buckstein
+
+	a3batch.h
+	Array-batched transform functions with strided inputs and outputs.
+
+	Every array is described by a pointer to its first element and a
+		stride in bytes between consecutive elements, so the functions run
+		directly over arrays of structures (e.g. the model matrices of an
+		array of scene objects) or interleaved vertex buffers. A stride of
+		zero on an input repeats the same element for the whole batch.
+*/
+
+#ifndef __ANIMAL3D_A3DM_BATCH_H
+#define __ANIMAL3D_A3DM_BATCH_H
+
+
+#include "a3simd.h"
+#include "a3sqrt.h"
+#include "a3quaternion.h"
+
+
+A3_BEGIN_DECL
+
+
+//-----------------------------------------------------------------------------
+
+// A3: Calculate matrix products (mL[i] * mR[i]) for a batch.
+//	param m_out: first output matrix; may alias either input
+//	param outStride: bytes between output matrices
+//	param mL, mR: first left and right input matrices
+//	param lStride, rStride: bytes between input matrices; zero repeats
+//	param count: number of products
+//	return: m_out
+A3_INLINE a3real4x4r a3real4x4ProductArray(a3real4x4p m_out, const a3size outStride, const a3real4x4p mL, const a3size lStride, const a3real4x4p mR, const a3size rStride, const a3count count);
+
+// A3: Transform a batch of 4D vectors by one matrix (m * v[i]).
+//	param v_out: first output vector; may alias input
+//	param outStride: bytes between output vectors
+//	param m: transformation matrix
+//	param v: first input vector
+//	param vStride: bytes between input vectors
+//	param count: number of vectors
+//	return: v_out
+A3_INLINE a3real4r a3real4Real4x4ProductArray(a3real4p v_out, const a3size outStride, const a3real4x4p m, const a3real4p v, const a3size vStride, const a3count count);
+
+// A3: Transform a batch of 3D vectors by one matrix with implied w; only
+//		three components are read and written, so this is safe on tightly
+//		packed or interleaved position and normal attributes.
+//	param v_out: first output vector; may alias input
+//	param outStride: bytes between output vectors
+//	param m: transformation matrix
+//	param v: first input vector
+//	param vStride: bytes between input vectors
+//	param w: implied fourth component (one for points, zero for directions)
+//	param count: number of vectors
+//	return: v_out
+A3_INLINE a3real3r a3real3Real4x4ProductArray(a3real3p v_out, const a3size outStride, const a3real4x4p m, const a3real3p v, const a3size vStride, const a3real w, const a3count count);
+
+// A3: Calculate inverse of a batch of rigid transforms.
+//	param m_out: first output matrix; may alias input
+//	param outStride: bytes between output matrices
+//	param m: first input matrix
+//	param inStride: bytes between input matrices
+//	param count: number of matrices
+//	return: m_out
+A3_INLINE a3real4x4r a3real4x4TransformInverseIgnoreScaleArray(a3real4x4p m_out, const a3size outStride, const a3real4x4p m, const a3size inStride, const a3count count);
+
+// A3: Rotate a batch of 3D vectors by quaternions, correct scale.
+//	param v_out: first output vector; may alias input
+//	param outStride: bytes between output vectors
+//	param q: first quaternion
+//	param qStride: bytes between quaternions; zero repeats
+//	param v: first input vector
+//	param vStride: bytes between input vectors
+//	param count: number of vectors
+//	return: v_out
+A3_INLINE a3real3r a3quatVec3RotateArray(a3real3p v_out, const a3size outStride, const a3real4p q, const a3size qStride, const a3real3p v, const a3size vStride, const a3count count);
+
+
+//-----------------------------------------------------------------------------
+// A3: Quaternion interpolation; all variants take the shorter arc (q1 is
+//	negated when the pair is more than 180 degrees apart). Batches process
+//	four pairs at a time, so results do not depend on batch size or
+//	position; single-pair forms are scalar and may differ in the last bit.
+
+// A3: Spherical linear interpolation ("SLERP") for a batch of assumed unit
+//		quaternion pairs; angular error from exact SLERP is below 1e-6 rad.
+//	param q_out: first output quaternion; may alias either input
+//	param outStride: bytes between output quaternions
+//	param q0, q1: first initial and goal quaternions
+//	param q0Stride, q1Stride: bytes between input quaternions; zero repeats
+//	param param: first interpolation parameter (t)
+//	param paramStride: bytes between parameters; zero repeats
+//	param count: number of pairs
+//	return: q_out
+A3_INLINE a3real4r a3quatSlerpUnitArray(a3real4p q_out, const a3size outStride, const a3real4p q0, const a3size q0Stride, const a3real4p q1, const a3size q1Stride, const a3real* param, const a3size paramStride, const a3count count);
+
+// A3: Normalized linear interpolation ("NLERP") for a batch of quaternion
+//		pairs; constant speed is not preserved (angular error up to about
+//		0.14 rad at 180 degrees apart, t=0.25).
+//	params: same as a3quatSlerpUnitArray
+//	return: q_out
+A3_INLINE a3real4r a3quatNlerpArray(a3real4p q_out, const a3size outStride, const a3real4p q0, const a3size q0Stride, const a3real4p q1, const a3size q1Stride, const a3real* param, const a3size paramStride, const a3count count);
+
+// A3: Fast approximate SLERP for a batch of assumed unit quaternion pairs:
+//		NLERP with the parameter corrected by a polynomial in t and |q0.q1|;
+//		maximum angular error from exact SLERP is below 8e-4 rad (0.05 deg).
+//	params: same as a3quatSlerpUnitArray
+//	return: q_out
+A3_INLINE a3real4r a3quatSlerpFastUnitArray(a3real4p q_out, const a3size outStride, const a3real4p q0, const a3size q0Stride, const a3real4p q1, const a3size q1Stride, const a3real* param, const a3size paramStride, const a3count count);
+
+// A3: Normalized linear interpolation ("NLERP") for a single pair.
+//	return: q_out
+A3_INLINE a3real4r a3quatNlerp(a3real4p q_out, const a3real4p q0, const a3real4p q1, const a3real param);
+
+// A3: Fast approximate SLERP for a single pair of unit quaternions.
+//	return: q_out
+A3_INLINE a3real4r a3quatSlerpFastUnit(a3real4p q_out, const a3real4p q0, const a3real4p q1, const a3real param);
+
+
+//-----------------------------------------------------------------------------
+
+
+A3_END_DECL
+
+
+#include "_inl/a3batch_impl.inl"
+
+
+#endif	// !__ANIMAL3D_A3DM_BATCH_H
@@ -0,0 +1,174 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	animal3D Math (A3DM) SDK
+	By Daniel S. Buckstein
+
+	a3randomstream.h
+	Random number streams with explicit state, for use on any thread.
+
+	Unlike the functions in a3random.h, which share one global seed, every
+		stream owns its state, so threads never contend as long as each uses
+		its own stream. A stream runs four interleaved xoshiro128+ generators;
+		value i of a stream comes from generator (i % 4), so all four
+		step together with SSE; single draws read from a block of four,
+		and bulk fills yield exactly the same sequence as repeated single
+		draws.
+
+	Streams are seeded from a 64-bit key. a3randomStreamSplit derives a
+		child stream from a parent's key and an index only, so the child is
+		the same no matter how much the parent has been used; give each
+		worker, particle system or crowd agent its own index for independent,
+		reproducible variation.
+*/
+
+#ifndef __ANIMAL3D_A3DM_RANDOMSTREAM_H
+#define __ANIMAL3D_A3DM_RANDOMSTREAM_H
+
+
+#include "a3simd.h"
+#include "a3sqrt.h"
+#include "a3sincos.h"
+
+
+A3_BEGIN_DECL
+
+
+#ifndef __cplusplus
+typedef struct a3_RandomStream		a3_RandomStream;
+#endif	// !__cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+// A3: Random number stream.
+//	member state: generator state, four words for each of four generators
+//		stored word-major so one word of every generator loads together
+//	member buffer: last output of all four generators
+//	member key: key the stream was seeded with; used to derive sub-streams
+//	member lane: next buffered value for single draws; zero when empty
+struct a3_RandomStream
+{
+	a3ui32 state[4][4];
+	a3ui32 buffer[4];
+	a3ui64 key;
+	a3ui32 lane;
+};
+
+
+//-----------------------------------------------------------------------------
+
+// A3: Initialize stream from key; equal keys give equal sequences.
+//	param stream_out: pointer to stream to initialize
+//	param key: seed key
+//	return: stream_out
+A3_INLINE a3_RandomStream* a3randomStreamInit(a3_RandomStream* stream_out, const a3ui64 key);
+
+// A3: Initialize stream as indexed sub-stream of another; depends only on
+//		the parent's key and the index, not on the parent's current state.
+//	param stream_out: pointer to stream to initialize; may be parent
+//	param parent: pointer to parent stream
+//	param index: sub-stream index (e.g. thread or system index)
+//	return: stream_out
+A3_INLINE a3_RandomStream* a3randomStreamSplit(a3_RandomStream* stream_out, const a3_RandomStream* parent, const a3index index);
+
+
+// A3: Generate random 32-bit integer.
+//	param stream: pointer to stream
+//	return: random integer in [0, 2^32)
+A3_INLINE a3ui32 a3randomStreamUInt(a3_RandomStream* stream);
+
+// A3: Generate non-negative normalized random decimal number.
+//	param stream: pointer to stream
+//	return: random real number in [0, 1)
+A3_INLINE a3real a3randomStreamUnit(a3_RandomStream* stream);
+
+// A3: Generate symmetric normalized random decimal number.
+//	param stream: pointer to stream
+//	return: random real number in [-1, 1)
+A3_INLINE a3real a3randomStreamSymmetric(a3_RandomStream* stream);
+
+// A3: Generate ranged random decimal number.
+//	param stream: pointer to stream
+//	param nMin: minimum real number in range
+//	param nMax: maximum real number in range
+//	return: random real number in [nMin, nMax)
+A3_INLINE a3real a3randomStreamRange(a3_RandomStream* stream, const a3real nMin, const a3real nMax);
+
+// A3: Generate ranged random integer without modulo bias.
+//	param stream: pointer to stream
+//	param nMin: minimum integer in range
+//	param nMax: maximum integer in range
+//	return: random integer in [nMin, nMax)
+A3_INLINE a3integer a3randomStreamRangeInt(a3_RandomStream* stream, const a3integer nMin, const a3integer nMax);
+
+// A3: Generate normally distributed random number (Box-Muller); uses two
+//		values from the stream.
+//	param stream: pointer to stream
+//	param mean: mean of distribution
+//	param stddev: standard deviation of distribution
+//	return: random real number
+A3_INLINE a3real a3randomStreamNormal(a3_RandomStream* stream, const a3real mean, const a3real stddev);
+
+
+//-----------------------------------------------------------------------------
+// A3: Bulk fills; four values per step with SSE. Integer and uniform fills
+//	give the same values as the same number of single draws.
+
+// A3: Fill array with random 32-bit integers.
+//	param stream: pointer to stream
+//	param values_out: array to fill
+//	param count: number of values
+//	return: values_out
+A3_INLINE a3ui32* a3randomStreamFillUInt(a3_RandomStream* stream, a3ui32* values_out, const a3count count);
+
+// A3: Fill array with random numbers in [0, 1).
+//	params: same as a3randomStreamFillUInt
+//	return: values_out
+A3_INLINE a3real* a3randomStreamFillUnit(a3_RandomStream* stream, a3real* values_out, const a3count count);
+
+// A3: Fill array with random numbers in [-1, 1).
+//	params: same as a3randomStreamFillUInt
+//	return: values_out
+A3_INLINE a3real* a3randomStreamFillSymmetric(a3_RandomStream* stream, a3real* values_out, const a3count count);
+
+// A3: Fill array with random numbers in [nMin, nMax).
+//	params: same as a3randomStreamFillUInt, plus range as a3randomStreamRange
+//	return: values_out
+A3_INLINE a3real* a3randomStreamFillRange(a3_RandomStream* stream, a3real* values_out, const a3count count, const a3real nMin, const a3real nMax);
+
+// A3: Fill array with normally distributed random numbers; uses both
+//		Box-Muller outputs, so consumes one stream value per output
+//		(rounded up to a multiple of eight) and differs from repeated
+//		a3randomStreamNormal calls.
+//	params: same as a3randomStreamFillUInt, plus distribution as
+//		a3randomStreamNormal
+//	return: values_out
+A3_INLINE a3real* a3randomStreamFillNormal(a3_RandomStream* stream, a3real* values_out, const a3count count, const a3real mean, const a3real stddev);
+
+
+//-----------------------------------------------------------------------------
+
+
+A3_END_DECL
+
+
+#include "_inl/a3randomstream_impl.inl"
+
+
+#endif	// !__ANIMAL3D_A3DM_RANDOMSTREAM_H
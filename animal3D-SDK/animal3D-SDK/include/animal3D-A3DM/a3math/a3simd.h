@@ -0,0 +1,185 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	animal3D Math (A3DM) SDK
+	By Daniel S. Buckstein
+
+	a3simd.h
+	Open-source SIMD implementations of hot 4x4 matrix and 4D vector
+		functions, selectable at compile time (scalar, SSE2, SSE4.1, AVX2).
+
+	Including this header redirects the matching a3matrix.h names to the
+		implementations here; define A3_SIMD_NO_OVERRIDE before including
+		to keep the precompiled versions and call the *SIMD names directly.
+	Define A3_SIMD as one of the A3_SIMD_* levels to force a level;
+		otherwise the best level enabled by the compiler is used.
+*/
+
+#ifndef __ANIMAL3D_A3DM_SIMD_H
+#define __ANIMAL3D_A3DM_SIMD_H
+
+
+#include "animal3D/a3/a3config.h"
+#include "animal3D/a3/a3macros.h"
+#include "animal3D/a3/a3types_integer.h"
+#include "animal3D/a3/a3types_real.h"
+
+#include "a3matrix.h"
+
+
+//-----------------------------------------------------------------------------
+// A3: SIMD level selection.
+
+#define A3_SIMD_SCALAR	0
+#define A3_SIMD_SSE2	1
+#define A3_SIMD_SSE41	2
+#define A3_SIMD_AVX2	3
+
+#ifndef A3_SIMD
+#if (defined __AVX2__)
+#define A3_SIMD			A3_SIMD_AVX2
+#elif (defined __SSE4_1__ || defined __AVX__)
+#define A3_SIMD			A3_SIMD_SSE41
+#elif (defined __SSE2__ || defined _M_X64 || defined _M_AMD64 || (defined _M_IX86_FP && _M_IX86_FP >= 2))
+#define A3_SIMD			A3_SIMD_SSE2
+#else	// scalar
+#define A3_SIMD			A3_SIMD_SCALAR
+#endif	// A3_SIMD auto
+#endif	// !A3_SIMD
+
+// vector paths are single-precision only
+#if (defined A3_REAL_F64 || defined A3_REAL_F128)
+#undef A3_SIMD
+#define A3_SIMD			A3_SIMD_SCALAR
+#endif	// A3_REAL_F64 || A3_REAL_F128
+
+#if (A3_SIMD >= A3_SIMD_AVX2)
+#include <immintrin.h>
+#elif (A3_SIMD >= A3_SIMD_SSE41)
+#include <smmintrin.h>
+#elif (A3_SIMD >= A3_SIMD_SSE2)
+#include <emmintrin.h>
+#endif	// A3_SIMD
+
+// name of selected level
+#if (A3_SIMD == A3_SIMD_AVX2)
+#define A3_SIMD_NAME	"AVX2"
+#elif (A3_SIMD == A3_SIMD_SSE41)
+#define A3_SIMD_NAME	"SSE4.1"
+#elif (A3_SIMD == A3_SIMD_SSE2)
+#define A3_SIMD_NAME	"SSE2"
+#else	// scalar
+#define A3_SIMD_NAME	"scalar"
+#endif	// A3_SIMD
+
+
+A3_BEGIN_DECL
+
+
+//-----------------------------------------------------------------------------
+// A3: Matrices are column-major (m[column][row]) as in a3matrix.h; all
+//	functions allow outputs to alias inputs.
+
+// A3: Calculate matrix product (mL * mR).
+//	return: m_out
+A3_INLINE a3real4x4r a3real4x4ProductSIMD(a3real4x4p m_out, const a3real4x4p mL, const a3real4x4p mR);
+
+// A3: Concatenate matrices, left-handed (mL = mL * mR).
+//	return: mL_inout
+A3_INLINE a3real4x4r a3real4x4ConcatLSIMD(a3real4x4p mL_inout, const a3real4x4p mR);
+
+// A3: Concatenate matrices, right-handed (mR = mL * mR).
+//	return: mR_inout
+A3_INLINE a3real4x4r a3real4x4ConcatRSIMD(const a3real4x4p mL, a3real4x4p mR_inout);
+
+// A3: Calculate product of affine transforms (bottom row is 0, 0, 0, 1).
+//	return: m_out
+A3_INLINE a3real4x4r a3real4x4ProductTransformSIMD(a3real4x4p m_out, const a3real4x4p mL, const a3real4x4p mR);
+
+// A3: Calculate transformed vector, left-handed (v * m).
+//	return: v_out
+A3_INLINE a3real4r a3real4Real4x4ProductLSIMD(a3real4p v_out, const a3real4p v, const a3real4x4p m);
+
+// A3: Calculate transformed vector, right-handed (m * v).
+//	return: v_out
+A3_INLINE a3real4r a3real4Real4x4ProductRSIMD(a3real4p v_out, const a3real4x4p m, const a3real4p v);
+
+// A3: Transform vector, left-handed.
+//	return: v_inout
+A3_INLINE a3real4r a3real4Real4x4MulLSIMD(a3real4p v_inout, const a3real4x4p m);
+
+// A3: Transform vector, right-handed.
+//	return: v_inout
+A3_INLINE a3real4r a3real4Real4x4MulRSIMD(const a3real4x4p m, a3real4p v_inout);
+
+// A3: Get transpose of matrix.
+//	return: m_out
+A3_INLINE a3real4x4r a3real4x4GetTransposedSIMD(a3real4x4p m_out, const a3real4x4p m);
+
+// A3: Transpose matrix.
+//	return: m_inout
+A3_INLINE a3real4x4r a3real4x4TransposeSIMD(a3real4x4p m_inout);
+
+// A3: Calculate matrix determinant.
+//	return: |m|
+A3_INLINE a3real a3real4x4DeterminantSIMD(const a3real4x4p m);
+
+// A3: Calculate inverse of affine transform with any scale or shear.
+//	return: m_out
+A3_INLINE a3real4x4r a3real4x4TransformInverseSIMD(a3real4x4p m_out, const a3real4x4p m);
+
+// A3: Calculate inverse of rigid transform (rotation and translation).
+//	return: m_out
+A3_INLINE a3real4x4r a3real4x4TransformInverseIgnoreScaleSIMD(a3real4x4p m_out, const a3real4x4p m);
+
+// A3: Calculate inverse of transform with uniform scale.
+//	return: m_out
+A3_INLINE a3real4x4r a3real4x4TransformInverseUniformScaleSIMD(a3real4x4p m_out, const a3real4x4p m);
+
+
+//-----------------------------------------------------------------------------
+// A3: Redirect existing names.
+
+#ifndef A3_SIMD_NO_OVERRIDE
+#define a3real4x4Product						a3real4x4ProductSIMD
+#define a3real4x4ConcatL						a3real4x4ConcatLSIMD
+#define a3real4x4ConcatR						a3real4x4ConcatRSIMD
+#define a3real4x4ProductTransform				a3real4x4ProductTransformSIMD
+#define a3real4Real4x4ProductL					a3real4Real4x4ProductLSIMD
+#define a3real4Real4x4ProductR					a3real4Real4x4ProductRSIMD
+#define a3real4Real4x4MulL						a3real4Real4x4MulLSIMD
+#define a3real4Real4x4MulR						a3real4Real4x4MulRSIMD
+#define a3real4x4GetTransposed					a3real4x4GetTransposedSIMD
+#define a3real4x4Transpose						a3real4x4TransposeSIMD
+#define a3real4x4Determinant					a3real4x4DeterminantSIMD
+#define a3real4x4TransformInverse				a3real4x4TransformInverseSIMD
+#define a3real4x4TransformInverseIgnoreScale	a3real4x4TransformInverseIgnoreScaleSIMD
+#define a3real4x4TransformInverseUniformScale	a3real4x4TransformInverseUniformScaleSIMD
+#endif	// !A3_SIMD_NO_OVERRIDE
+
+
+//-----------------------------------------------------------------------------
+
+
+A3_END_DECL
+
+
+#include "_inl/a3simd_impl.inl"
+
+
+#endif	// !__ANIMAL3D_A3DM_SIMD_H
@@ -0,0 +1,139 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	animal3D Math (A3DM) SDK
+	By Daniel S. Buckstein
+
+	a3sincos.h
+	Table-free sine and cosine by polynomial, for single values and arrays,
+		and Euler rotation setters built on them.
+
+	Arguments are reduced to a quarter turn about the nearest multiple of
+		90 degrees (exact in degrees, three-part pi/2 in radians), then
+		evaluated with minimax polynomials on [-45, +45] degrees.
+	Measured against double-precision libm, absolute error is below 1e-7
+		for degrees in [-3600, +3600] and radians in [-1000, +1000]; no
+		call to a3trigInit is required.
+
+	Including this header redirects a3real4x4SetRotateXYZ/ZYX and
+		a3quatSetEulerXYZ/ZYX to the versions here; define
+		A3_SINCOS_NO_OVERRIDE before including to keep the table versions.
+*/
+
+#ifndef __ANIMAL3D_A3DM_SINCOS_H
+#define __ANIMAL3D_A3DM_SINCOS_H
+
+
+#include "a3simd.h"
+#include "a3quaternion.h"
+
+
+A3_BEGIN_DECL
+
+
+//-----------------------------------------------------------------------------
+
+// A3: Sine with degree input by polynomial.
+//	param x: input in degrees
+//	return: sin(x)
+A3_INLINE a3real a3sindPoly(const a3real x);
+
+// A3: Cosine with degree input by polynomial.
+//	param x: input in degrees
+//	return: cos(x)
+A3_INLINE a3real a3cosdPoly(const a3real x);
+
+// A3: Sine and cosine with degree input by polynomial.
+//	param x: input in degrees
+//	param cos_out: pointer to store cos(x)
+//	return: sin(x)
+A3_INLINE a3real a3sincosdPoly(const a3real x, a3real* cos_out);
+
+// A3: Sine with radian input by polynomial.
+//	param x: input in radians
+//	return: sin(x)
+A3_INLINE a3real a3sinrPoly(const a3real x);
+
+// A3: Cosine with radian input by polynomial.
+//	param x: input in radians
+//	return: cos(x)
+A3_INLINE a3real a3cosrPoly(const a3real x);
+
+// A3: Sine and cosine with radian input by polynomial.
+//	param x: input in radians
+//	param cos_out: pointer to store cos(x)
+//	return: sin(x)
+A3_INLINE a3real a3sincosrPoly(const a3real x, a3real* cos_out);
+
+// A3: Sine and cosine of an array of degree inputs, four at a time.
+//	param sin_out: array to store sines; may be null or alias input
+//	param cos_out: array to store cosines; may be null or alias input
+//	param x: array of inputs in degrees
+//	param count: number of inputs
+//	return: sin_out
+A3_INLINE a3real* a3sincosdArray(a3real* sin_out, a3real* cos_out, const a3real* x, const a3count count);
+
+// A3: Sine and cosine of an array of radian inputs, four at a time.
+//	params: same as a3sincosdArray with inputs in radians
+//	return: sin_out
+A3_INLINE a3real* a3sincosrArray(a3real* sin_out, a3real* cos_out, const a3real* x, const a3count count);
+
+
+//-----------------------------------------------------------------------------
+// A3: Euler rotation setters; same conventions as a3matrix.h and
+//	a3quaternion.h (XYZ is Rx * Ry * Rz, ZYX is Rz * Ry * Rx), with all
+//	three sine/cosine pairs evaluated together.
+
+// A3: Set matrix to represent rotation given Euler angles in XYZ order.
+//	return: m_out
+A3_INLINE a3real4x4r a3real4x4SetRotateXYZPoly(a3real4x4p m_out, const a3real degrees_x, const a3real degrees_y, const a3real degrees_z);
+
+// A3: Set matrix to represent rotation given Euler angles in ZYX order.
+//	return: m_out
+A3_INLINE a3real4x4r a3real4x4SetRotateZYXPoly(a3real4x4p m_out, const a3real degrees_x, const a3real degrees_y, const a3real degrees_z);
+
+// A3: Set quaternion to represent rotation given Euler angles in XYZ order.
+//	return: q_out
+A3_INLINE a3real4r a3quatSetEulerXYZPoly(a3real4p q_out, const a3real degrees_x, const a3real degrees_y, const a3real degrees_z);
+
+// A3: Set quaternion to represent rotation given Euler angles in ZYX order.
+//	return: q_out
+A3_INLINE a3real4r a3quatSetEulerZYXPoly(a3real4p q_out, const a3real degrees_x, const a3real degrees_y, const a3real degrees_z);
+
+
+//-----------------------------------------------------------------------------
+// A3: Redirect existing names.
+
+#ifndef A3_SINCOS_NO_OVERRIDE
+#define a3real4x4SetRotateXYZ	a3real4x4SetRotateXYZPoly
+#define a3real4x4SetRotateZYX	a3real4x4SetRotateZYXPoly
+#define a3quatSetEulerXYZ		a3quatSetEulerXYZPoly
+#define a3quatSetEulerZYX		a3quatSetEulerZYXPoly
+#endif	// !A3_SINCOS_NO_OVERRIDE
+
+
+//-----------------------------------------------------------------------------
+
+
+A3_END_DECL
+
+
+#include "_inl/a3sincos_impl.inl"
+
+
+#endif	// !__ANIMAL3D_A3DM_SINCOS_H
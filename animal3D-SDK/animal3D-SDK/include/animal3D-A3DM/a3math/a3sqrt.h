@@ -51,25 +51,33 @@ A3_INLINE a3f32 a3sqrtf0x(const a3f32 x);
 A3_INLINE a3f32 a3sqrtf0xInverse(const a3f32 x);
 
 
+// A3: Precise square roots are exported by the precompiled library; 
+//	open-source builds inline them like everything else.
+#ifdef A3_OPEN_SOURCE
+#define A3_SQRT_DECL	A3_INLINE
+#else	// !A3_OPEN_SOURCE
+#define A3_SQRT_DECL	extern
+#endif	// A3_OPEN_SOURCE
+
 // A3: Fast and precise square root for floats.
 //	param x: number to square root
 //	return: square root of x
-extern a3f32 a3sqrtf(const a3f32 x);
+A3_SQRT_DECL a3f32 a3sqrtf(const a3f32 x);
 
 // A3: Fast and precise square root for doubles.
 //	param x: number to square root
 //	return: square root of x
-extern a3f64 a3sqrtd(const a3f64 x);
+A3_SQRT_DECL a3f64 a3sqrtd(const a3f64 x);
 
 // A3: Fast and precise inverse square root for floats.
 //	param x: number to square root
 //	return: square root of x
-extern a3f32 a3sqrtfInverse(const a3f32 x);
+A3_SQRT_DECL a3f32 a3sqrtfInverse(const a3f32 x);
 
 // A3: Fast and precise inverse square root for doubles.
 //	param x: number to square root
 //	return: square root of x
-extern a3f64 a3sqrtdInverse(const a3f64 x);
+A3_SQRT_DECL a3f64 a3sqrtdInverse(const a3f64 x);
 
 
 // A3: Macros for generalizing square root based on active real type.
@@ -0,0 +1,193 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	animal3D Math (A3DM) SDK
+	By Daniel S. Buckstein
+
+	a3streamstats.h
+	Online statistics that absorb one sample at a time in constant memory.
+
+	The functions in a3stats.h need the whole data set; the accumulators
+		here never store samples, so they can follow frame times or other
+		measurements indefinitely:
+		- running stats: count, mean and variance (Welford), min and max;
+			two accumulators can be merged (e.g. one per thread)
+		- quantile: single quantile estimated by the P-squared algorithm
+			(five markers, no sample storage)
+		- histogram: fixed bins over a range in caller-provided storage,
+			with under/overflow counts and quantile lookup
+	Accumulators work in double precision.
+*/
+
+#ifndef __ANIMAL3D_A3DM_STREAMSTATS_H
+#define __ANIMAL3D_A3DM_STREAMSTATS_H
+
+
+#include "animal3D/a3/a3config.h"
+#include "animal3D/a3/a3types_integer.h"
+#include "animal3D/a3/a3types_real.h"
+
+#include "a3sqrt.h"
+
+
+A3_BEGIN_DECL
+
+
+#ifndef __cplusplus
+typedef struct a3_StreamStats		a3_StreamStats;
+typedef struct a3_StreamQuantile	a3_StreamQuantile;
+typedef struct a3_StreamHistogram	a3_StreamHistogram;
+#endif	// !__cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+// A3: Running count, mean, variance and range.
+//	member count: number of samples added
+//	member mean: running mean
+//	member m2: running sum of squared differences from mean
+//	member min, max: smallest and largest samples
+struct a3_StreamStats
+{
+	a3bigcount count;
+	a3f64 mean, m2;
+	a3f64 min, max;
+};
+
+// A3: P-squared estimator of one quantile.
+//	member p: quantile estimated, in [0, 1]
+//	member height: marker heights; height[2] is the estimate
+//	member pos: actual marker positions
+//	member posDesired: desired marker positions
+//	member count: number of samples added
+struct a3_StreamQuantile
+{
+	a3f64 p;
+	a3f64 height[5];
+	a3f64 pos[5], posDesired[5];
+	a3bigcount count;
+};
+
+// A3: Fixed-range histogram.
+//	member bin: caller-provided array of bin counts
+//	member binCount: number of bins
+//	member lo, hi: range covered by bins
+//	member binsPerUnit: binCount / (hi - lo)
+//	member under, over: samples below lo and at or above hi
+//	member count: number of samples added
+struct a3_StreamHistogram
+{
+	a3bigcount* bin;
+	a3count binCount;
+	a3f64 lo, hi, binsPerUnit;
+	a3bigcount under, over, count;
+};
+
+
+//-----------------------------------------------------------------------------
+
+// A3: Reset running stats.
+//	param stats_out: pointer to accumulator
+//	return: stats_out
+A3_INLINE a3_StreamStats* a3streamStatsInit(a3_StreamStats* stats_out);
+
+// A3: Add sample to running stats.
+//	param stats: pointer to accumulator
+//	param x: sample
+//	return: stats
+A3_INLINE a3_StreamStats* a3streamStatsAdd(a3_StreamStats* stats, const a3f64 x);
+
+// A3: Merge running stats (Chan et al.), as if all samples from both had
+//		been added to one.
+//	param stats_out: pointer to accumulator to merge into
+//	param stats: pointer to accumulator to merge from
+//	return: stats_out
+A3_INLINE a3_StreamStats* a3streamStatsMerge(a3_StreamStats* stats_out, const a3_StreamStats* stats);
+
+// A3: Get variance of samples added.
+//	param stats: pointer to accumulator
+//	param sample: non-zero for sample variance (divide by count - 1),
+//		zero for population variance (divide by count)
+//	return: variance; zero if too few samples
+A3_INLINE a3f64 a3streamStatsVariance(const a3_StreamStats* stats, const a3boolean sample);
+
+// A3: Get standard deviation of samples added.
+//	params: same as a3streamStatsVariance
+//	return: standard deviation
+A3_INLINE a3f64 a3streamStatsStandardDeviation(const a3_StreamStats* stats, const a3boolean sample);
+
+
+//-----------------------------------------------------------------------------
+
+// A3: Reset quantile estimator.
+//	param quantile_out: pointer to estimator
+//	param p: quantile to estimate, in [0, 1] (e.g. 0.95 for 95th percentile)
+//	return: quantile_out
+A3_INLINE a3_StreamQuantile* a3streamQuantileInit(a3_StreamQuantile* quantile_out, const a3f64 p);
+
+// A3: Add sample to quantile estimator.
+//	param quantile: pointer to estimator
+//	param x: sample
+//	return: quantile
+A3_INLINE a3_StreamQuantile* a3streamQuantileAdd(a3_StreamQuantile* quantile, const a3f64 x);
+
+// A3: Get quantile estimate; exact while fewer than five samples added.
+//	param quantile: pointer to estimator
+//	return: estimated quantile; zero if no samples
+A3_INLINE a3f64 a3streamQuantileGet(const a3_StreamQuantile* quantile);
+
+
+//-----------------------------------------------------------------------------
+
+// A3: Initialize histogram and clear bins.
+//	param histogram_out: pointer to histogram
+//	param bin: array of binCount counts owned by caller
+//	param binCount: number of bins
+//	param lo, hi: range covered by bins (hi > lo)
+//	return: histogram_out if success; null if invalid params
+A3_INLINE a3_StreamHistogram* a3streamHistogramInit(a3_StreamHistogram* histogram_out, a3bigcount bin[], const a3count binCount, const a3f64 lo, const a3f64 hi);
+
+// A3: Clear histogram counts, keeping bins and range.
+//	param histogram: pointer to histogram
+//	return: histogram
+A3_INLINE a3_StreamHistogram* a3streamHistogramReset(a3_StreamHistogram* histogram);
+
+// A3: Add sample to histogram.
+//	param histogram: pointer to histogram
+//	param x: sample
+//	return: histogram
+A3_INLINE a3_StreamHistogram* a3streamHistogramAdd(a3_StreamHistogram* histogram, const a3f64 x);
+
+// A3: Get quantile from histogram by interpolating within the bin that
+//		holds it; samples outside the range count at lo and hi.
+//	param histogram: pointer to histogram
+//	param p: quantile, in [0, 1]
+//	return: estimated quantile; lo if no samples
+A3_INLINE a3f64 a3streamHistogramQuantile(const a3_StreamHistogram* histogram, const a3f64 p);
+
+
+//-----------------------------------------------------------------------------
+
+
+A3_END_DECL
+
+
+#include "_inl/a3streamstats_impl.inl"
+
+
+#endif	// !__ANIMAL3D_A3DM_STREAMSTATS_H
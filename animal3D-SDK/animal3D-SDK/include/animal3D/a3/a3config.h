@@ -54,12 +54,21 @@
 
 
 // inline declaration
+//	open-source: everything is compiled into each translation unit, so 
+//	functions and constants are static; mutable state shared by all units 
+//	(e.g. trig tables, random seed) is declared A3_SHARED and merged at link
 #ifdef A3_OPEN_SOURCE
 #define A3_INLINE	static inline
 #define A3_GLOBAL	static
+#ifdef _MSC_VER
+#define A3_SHARED	__declspec(selectany)
+#else	// !_MSC_VER
+#define A3_SHARED	__attribute__((weak))
+#endif	// _MSC_VER
 #else	// !A3_OPEN_SOURCE
 #define A3_INLINE	inline
 #define A3_GLOBAL
+#define A3_SHARED
 #endif	// A3_OPEN_SOURCE
 
 
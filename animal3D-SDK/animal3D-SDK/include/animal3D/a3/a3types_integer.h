@@ -34,6 +34,7 @@ A3_BEGIN
 
 //-----------------------------------------------------------------------------
 
+#ifdef _MSC_VER
 // signed integer types: 
 typedef __int8				a3i8;
 typedef __int16				a3i16;
@@ -45,6 +46,19 @@ typedef unsigned __int8		a3ui8;
 typedef unsigned __int16	a3ui16;
 typedef unsigned __int32	a3ui32;
 typedef unsigned __int64	a3ui64;
+#else	// !_MSC_VER
+// signed integer types (GCC/Clang: LP64 and ILP32): 
+typedef signed char			a3i8;
+typedef short				a3i16;
+typedef int					a3i32;
+typedef long long			a3i64;
+
+// unsigned integer types: 
+typedef unsigned char		a3ui8;
+typedef unsigned short		a3ui16;
+typedef unsigned int		a3ui32;
+typedef unsigned long long	a3ui64;
+#endif	// _MSC_VER
 
 
 // aliases for integer types: 
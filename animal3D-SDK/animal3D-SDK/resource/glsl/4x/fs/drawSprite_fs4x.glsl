@@ -0,0 +1,39 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	drawSprite_fs4x.glsl
+	Output atlas texture sample multiplied by sprite tint.
+*/
+
+#version 450
+
+uniform sampler2D uTex_dm;
+
+in vec2 vTexcoord;
+flat in vec4 vColor;
+
+layout (location = 0) out vec4 rtFragColor;
+
+void main()
+{
+	rtFragColor = texture(uTex_dm, vTexcoord) * vColor;
+	if (rtFragColor.a <= 0.0)
+		discard;
+}
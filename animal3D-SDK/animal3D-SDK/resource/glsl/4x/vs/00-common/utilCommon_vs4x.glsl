@@ -22,3 +22,28 @@
 	Common utilities for vertex shaders.
 */
 
+
+// packed vertex attributes: half, snorm and unorm types are converted to 
+//	float by the vertex fetch, so only octahedral directions need decoding
+//	(see a3_DemoVertexPacking.h)
+
+// sign with zero counted as positive, matching the encoder
+vec2 signNotZero(in vec2 v)
+{
+	return vec2(v.x >= 0.0 ? +1.0 : -1.0, v.y >= 0.0 ? +1.0 : -1.0);
+}
+
+// octahedral direction (snorm16x2 attribute) to unit vector
+vec3 decodeOctahedral(in vec2 e)
+{
+	vec3 v = vec3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+	if (v.z < 0.0)
+		v.xy = (1.0 - abs(v.yx)) * signNotZero(v.xy);
+	return normalize(v);
+}
+
+// quantized direction (snorm10x3 or snorm16x4 attribute) to unit vector
+vec3 decodeDirection(in vec4 d)
+{
+	return normalize(d.xyz);
+}
@@ -0,0 +1,80 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	passSprite_transform_instanced_vs4x.glsl
+	Transform unit quad for each sprite in batch and pass atlas texture 
+		coordinate and tint down the pipeline.
+*/
+
+#version 450
+
+#define MAX_CELLS 256
+
+layout (location = 0) in vec4 aPosition;
+layout (location = 8) in vec4 aTexcoord;
+
+// per-sprite data, packed by sprite batch
+struct sSpriteInstance
+{
+	vec3 position;
+	float rotation;
+	vec2 size;
+	uint cell;
+	uint tint;
+};
+layout (std430, binding = 0) readonly buffer ssSpriteInstance
+{
+	sSpriteInstance uSprite[];
+};
+
+// atlas cells: texture offset and size, local offset (fraction of size)
+struct sSpriteCell
+{
+	vec4 texOffsetSize;
+	vec4 localOffset;
+};
+layout (std140, binding = 4) uniform ubSpriteCell
+{
+	sSpriteCell uCell[MAX_CELLS];
+};
+
+uniform mat4 uMV;	// view matrix (world -> view)
+uniform mat4 uP;	// projection matrix (view -> clip)
+
+out vec2 vTexcoord;
+flat out vec4 vColor;
+
+void main()
+{
+	sSpriteInstance sprite = uSprite[gl_InstanceID];
+	sSpriteCell cell = uCell[sprite.cell];
+
+	// billboard corner in view space, scaled, offset and rotated
+	vec2 corner = (aPosition.xy + cell.localOffset.xy) * sprite.size;
+	float c = cos(sprite.rotation), s = sin(sprite.rotation);
+	corner = vec2(c * corner.x - s * corner.y, s * corner.x + c * corner.y);
+
+	vec4 posView = uMV * vec4(sprite.position, 1.0);
+	posView.xy += corner;
+	gl_Position = uP * posView;
+
+	vTexcoord = cell.texOffsetSize.xy + aTexcoord.xy * cell.texOffsetSize.zw;
+	vColor = unpackUnorm4x8(sprite.tint);
+}
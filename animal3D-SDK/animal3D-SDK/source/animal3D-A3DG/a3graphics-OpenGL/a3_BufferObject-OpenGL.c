@@ -35,13 +35,13 @@
 
 inline a3ui16 a3bufferInternalFlag(const a3_BufferObjectType bufferType)
 {
-	static const a3ui16 bufferBindings[] = { GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER, GL_UNIFORM_BUFFER, };
+	static const a3ui16 bufferBindings[] = { GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER, GL_UNIFORM_BUFFER, GL_SHADER_STORAGE_BUFFER, };
 	return bufferBindings[bufferType];
 }
 
 inline a3ui16 a3bufferInternalFillHint(const a3_BufferObjectType bufferType)
 {
-	static const a3ui16 bufferFillHint[] = { GL_STATIC_DRAW, GL_STATIC_DRAW, GL_DYNAMIC_DRAW, };
+	static const a3ui16 bufferFillHint[] = { GL_STATIC_DRAW, GL_STATIC_DRAW, GL_DYNAMIC_DRAW, GL_STREAM_DRAW, };
 	return bufferFillHint[bufferType];
 }
 
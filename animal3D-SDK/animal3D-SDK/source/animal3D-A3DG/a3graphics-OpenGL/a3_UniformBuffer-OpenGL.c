@@ -46,6 +46,21 @@ a3ret a3shaderUniformBufferActivate(const a3_UniformBuffer *buffer, const a3ui32
 	return -1;
 }
 
+a3ret a3shaderStorageBufferActivate(const a3_StorageBuffer *buffer, const a3ui32 storageBlockBinding)
+{
+	a3ui32 handle;
+	if (buffer)
+	{
+		handle = buffer->handle->handle;
+		if (handle)
+		{
+			glBindBufferBase(GL_SHADER_STORAGE_BUFFER, storageBlockBinding, handle);
+			return 1;
+		}
+	}
+	return -1;
+}
+
 a3ret a3shaderUniformBlockBind(const a3_ShaderProgram *program, const a3i32 unifBlockLocation, const a3ui32 unifBlockBinding)
 {
 	a3ui32 pHandle;
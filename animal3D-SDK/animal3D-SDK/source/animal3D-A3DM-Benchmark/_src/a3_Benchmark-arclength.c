@@ -0,0 +1,126 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_Benchmark-arclength.c
+	Parameter at distance: stepping through a forward arc-length table
+		versus direct lookup in a uniform inverse table.
+*/
+
+#include "../a3_Benchmark.h"
+
+#include "animal3D-A3DM/a3math/a3arclength.h"
+
+#include <stdlib.h>
+
+
+//-----------------------------------------------------------------------------
+
+// table sizes: forward table is divisions * subdivisions + 1 samples
+#define a3benchmarkInternal_arclenDivisions		32
+#define a3benchmarkInternal_arclenSubdivisions	8
+#define a3benchmarkInternal_arclenSamples		257
+
+typedef struct a3_BenchmarkArcLengthData
+{
+	a3real* distance;
+	a3real* param_out;
+	a3real sampleTable[a3benchmarkInternal_arclenSamples];
+	a3real paramTable[a3benchmarkInternal_arclenSamples];
+	a3real arclenTable[a3benchmarkInternal_arclenSamples];
+	a3real inverseTable[a3benchmarkInternal_arclenSamples];
+	a3real inverseScale;
+} a3_BenchmarkArcLengthData;
+
+
+// monotonic easing curve and its speed
+a3real a3benchmarkInternalArcLengthFunc(a3real t)
+{
+	return (t * t * ((a3real)3 - a3real_two * t));
+}
+
+a3real a3benchmarkInternalArcLengthSpeed(const void* data, const a3real t)
+{
+	return ((a3real)6 * t * (a3real_one - t));
+}
+
+
+void a3benchmarkInternalArcLengthIncrement(void* data, a3count count)
+{
+	a3_BenchmarkArcLengthData* const d = (a3_BenchmarkArcLengthData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		d->param_out[i] = a3sampleTableLerpIncrement(d->paramTable, d->arclenTable, d->distance[i], 0);
+}
+
+void a3benchmarkInternalArcLengthUniform(void* data, a3count count)
+{
+	a3_BenchmarkArcLengthData* const d = (a3_BenchmarkArcLengthData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		d->param_out[i] = a3sampleTableLerpUniform(d->inverseTable, a3benchmarkInternal_arclenSamples, d->inverseScale, d->distance[i]);
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3i32 a3benchmarkSuite_arclength(a3count const count, a3count const repeats)
+{
+	// first case is the reference for speedup
+	a3_BenchmarkCase const benchCase[] = {
+		{ "a3sampleTableLerpIncrement", a3benchmarkInternalArcLengthIncrement },
+		{ "a3sampleTableLerpUniform", a3benchmarkInternalArcLengthUniform },
+	};
+	a3count const caseCount = sizeof(benchCase) / sizeof(*benchCase);
+	a3_BenchmarkResult result[sizeof(benchCase) / sizeof(*benchCase)];
+	a3_BenchmarkArcLengthData* data;
+	a3real length;
+	a3ui32 seed = 0x0a3da1e7;
+	a3index i;
+
+	if (count <= 0)
+		return -1;
+
+	data = (a3_BenchmarkArcLengthData*)malloc(sizeof(a3_BenchmarkArcLengthData) + count * 2 * sizeof(a3real));
+	if (!data)
+		return -1;
+	data->distance = (a3real*)(data + 1);
+	data->param_out = data->distance + count;
+
+	// both tables normalized to unit length
+	a3sampleTableGenerateArcLength(data->sampleTable, data->paramTable, data->arclenTable, 1,
+		a3benchmarkInternal_arclenDivisions, a3benchmarkInternal_arclenSubdivisions, a3real_zero, a3real_one, a3benchmarkInternalArcLengthFunc);
+	a3sampleTableGenerateArcLengthUniform(data->inverseTable, &length, a3benchmarkInternal_arclenSamples,
+		a3benchmarkInternalArcLengthSpeed, 0, 1, a3real_zero, a3real_one, (a3real)1.0e-6);
+	data->inverseScale = a3sampleTableUniformScale(a3benchmarkInternal_arclenSamples, length);
+	a3benchmarkFillReal(data->distance, count, a3real_zero, length, &seed);
+
+	a3benchmarkPrintHeader("arc-length lookup");
+	for (i = 0; i < caseCount; ++i)
+	{
+		a3benchmarkRun(result + i, benchCase + i, data, count, repeats);
+		a3benchmarkPrintResult(result + i, result);
+	}
+
+	free(data);
+	return caseCount;
+}
+
+
+//-----------------------------------------------------------------------------
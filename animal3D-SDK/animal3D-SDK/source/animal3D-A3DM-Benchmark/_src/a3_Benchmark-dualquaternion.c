@@ -0,0 +1,208 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_Benchmark-dualquaternion.c
+	Common a3quaternion.h and a3dualquaternion.h operations on random 
+		rotations and rigid transforms, one call per element.
+*/
+
+#include "../a3_Benchmark.h"
+
+#include <stdlib.h>
+
+
+//-----------------------------------------------------------------------------
+
+typedef struct a3_BenchmarkDualQuatData
+{
+	a3real4* q0;
+	a3real4* q1;
+	a3real4* q_out;
+	a3real4x2* Q0;
+	a3real4x2* Q1;
+	a3real4x2* Q_out;
+	a3real4x4* m_out;
+	a3real4* v;
+	a3real4* v_out;
+	a3real* param;
+} a3_BenchmarkDualQuatData;
+
+
+void a3benchmarkInternalQuatProduct(void* data, a3count count)
+{
+	a3_BenchmarkDualQuatData* const d = (a3_BenchmarkDualQuatData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		a3quatProduct(d->q_out[i], d->q0[i], d->q1[i]);
+}
+
+void a3benchmarkInternalQuatRotate(void* data, a3count count)
+{
+	a3_BenchmarkDualQuatData* const d = (a3_BenchmarkDualQuatData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		a3quatVec3GetRotated(d->v_out[i], d->v[i], d->q0[i]);
+}
+
+void a3benchmarkInternalQuatInverse(void* data, a3count count)
+{
+	a3_BenchmarkDualQuatData* const d = (a3_BenchmarkDualQuatData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		a3quatGetInverse(d->q_out[i], d->q0[i]);
+}
+
+void a3benchmarkInternalQuatToMat4(void* data, a3count count)
+{
+	a3_BenchmarkDualQuatData* const d = (a3_BenchmarkDualQuatData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		a3quatConvertToMat4(d->m_out[i], d->q0[i]);
+}
+
+void a3benchmarkInternalQuatFromMat4(void* data, a3count count)
+{
+	a3_BenchmarkDualQuatData* const d = (a3_BenchmarkDualQuatData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		a3quatConvertFromMat4(d->q_out[i], d->m_out[i]);
+}
+
+void a3benchmarkInternalDualQuatProduct(void* data, a3count count)
+{
+	a3_BenchmarkDualQuatData* const d = (a3_BenchmarkDualQuatData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		a3dualquatProduct(d->Q_out[i], d->Q0[i], d->Q1[i]);
+}
+
+void a3benchmarkInternalDualQuatTransform(void* data, a3count count)
+{
+	a3_BenchmarkDualQuatData* const d = (a3_BenchmarkDualQuatData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		a3dualquatVec3GetTransformedIgnoreScale(d->v_out[i], d->v[i], d->Q0[i]);
+}
+
+void a3benchmarkInternalDualQuatInverse(void* data, a3count count)
+{
+	a3_BenchmarkDualQuatData* const d = (a3_BenchmarkDualQuatData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		a3dualquatGetInverseIgnoreScale(d->Q_out[i], d->Q0[i]);
+}
+
+void a3benchmarkInternalDualQuatToMat4(void* data, a3count count)
+{
+	a3_BenchmarkDualQuatData* const d = (a3_BenchmarkDualQuatData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		a3dualquatConvertToMat4IgnoreScale(d->m_out[i], d->Q0[i]);
+}
+
+void a3benchmarkInternalDualQuatSclerp(void* data, a3count count)
+{
+	a3_BenchmarkDualQuatData* const d = (a3_BenchmarkDualQuatData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		a3dualquatSclerpUnit(d->Q_out[i], d->Q0[i], d->Q1[i], d->param[i]);
+}
+
+void a3benchmarkInternalDualQuatDLB4(void* data, a3count count)
+{
+	a3_BenchmarkDualQuatData* const d = (a3_BenchmarkDualQuatData*)data;
+	a3index i;
+
+	// four neighboring transforms per blend
+	for (i = 0; i < count; ++i)
+		a3dualquatDLB4(d->Q_out[i], d->Q0[i], d->Q1[i], d->Q0[count - 1 - i], d->Q1[count - 1 - i]);
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3i32 a3benchmarkSuite_dualquaternion(a3count const count, a3count const repeats)
+{
+	a3_BenchmarkCase const benchCase[] = {
+		{ "a3quatProduct", a3benchmarkInternalQuatProduct },
+		{ "a3quatVec3GetRotated", a3benchmarkInternalQuatRotate },
+		{ "a3quatGetInverse", a3benchmarkInternalQuatInverse },
+		{ "a3quatConvertToMat4", a3benchmarkInternalQuatToMat4 },
+		{ "a3quatConvertFromMat4", a3benchmarkInternalQuatFromMat4 },
+		{ "a3dualquatProduct", a3benchmarkInternalDualQuatProduct },
+		{ "a3dualquatVec3GetTransformedIgnoreScale", a3benchmarkInternalDualQuatTransform },
+		{ "a3dualquatGetInverseIgnoreScale", a3benchmarkInternalDualQuatInverse },
+		{ "a3dualquatConvertToMat4IgnoreScale", a3benchmarkInternalDualQuatToMat4 },
+		{ "a3dualquatSclerpUnit", a3benchmarkInternalDualQuatSclerp },
+		{ "a3dualquatDLB4", a3benchmarkInternalDualQuatDLB4 },
+	};
+	a3count const caseCount = sizeof(benchCase) / sizeof(*benchCase);
+	a3_BenchmarkResult result[sizeof(benchCase) / sizeof(*benchCase)];
+	a3_BenchmarkDualQuatData data;
+	a3real* translate;
+	a3ui32 seed = 0x0a3d0003;
+	a3index i;
+
+	if (count <= 0)
+		return -1;
+
+	data.q0 = (a3real4*)malloc(count * (3 * sizeof(a3real4) + 3 * sizeof(a3real4x2) + sizeof(a3real4x4) + 2 * sizeof(a3real4) + 7 * sizeof(a3real)));
+	if (!data.q0)
+		return -1;
+	data.q1 = data.q0 + count;
+	data.q_out = data.q1 + count;
+	data.Q0 = (a3real4x2*)(data.q_out + count);
+	data.Q1 = data.Q0 + count;
+	data.Q_out = data.Q1 + count;
+	data.m_out = (a3real4x4*)(data.Q_out + count);
+	data.v = (a3real4*)(data.m_out + count);
+	data.v_out = data.v + count;
+	data.param = (a3real*)(data.v_out + count);
+	translate = data.param + count;
+
+	// unit rotations, rigid transforms from the same rotations
+	a3benchmarkFillQuat(data.q0, count, &seed);
+	a3benchmarkFillQuat(data.q1, count, &seed);
+	a3benchmarkFillReal(translate, count * 6, (a3real)-10, (a3real)+10, &seed);
+	for (i = 0; i < count; ++i)
+	{
+		a3real4SetReal4(data.Q0[i][0], data.q0[i]);
+		a3real4SetReal4(data.Q1[i][0], data.q1[i]);
+		a3dualquatCalculateDualPart(data.Q0[i][1], data.Q0[i][0], translate + i * 6 + 0);
+		a3dualquatCalculateDualPart(data.Q1[i][1], data.Q1[i][0], translate + i * 6 + 3);
+		a3quatConvertToMat4(data.m_out[i], data.q0[i]);
+	}
+	a3benchmarkFillReal(*data.v, count * 4, -a3real_one, a3real_one, &seed);
+	a3benchmarkFillReal(data.param, count, a3real_zero, a3real_one, &seed);
+
+	// no reference: each case measures a different function
+	a3benchmarkPrintHeader("quat, dual quat");
+	for (i = 0; i < caseCount; ++i)
+	{
+		a3benchmarkRun(result + i, benchCase + i, &data, count, repeats);
+		a3benchmarkPrintResult(result + i, 0);
+	}
+
+	free(data.q0);
+	return caseCount;
+}
+
+
+//-----------------------------------------------------------------------------
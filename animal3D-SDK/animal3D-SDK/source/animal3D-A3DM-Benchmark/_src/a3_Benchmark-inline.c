@@ -0,0 +1,171 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_Benchmark-inline.c
+	Vector-heavy loops with A3DM calls made through function pointers, as 
+		they are when linking the precompiled library, versus direct calls, 
+		which are inlined and vectorized when built with A3_OPEN_SOURCE.
+*/
+
+#include "../a3_Benchmark.h"
+
+#include <stdlib.h>
+
+
+//-----------------------------------------------------------------------------
+
+typedef a3real3r(*a3_BenchmarkReal3Op)(a3real3p v_out, const a3real3p vL, const a3real3p vR);
+typedef a3real3r(*a3_BenchmarkReal3Scale)(a3real3p v_out, const a3real3p v, const a3real s);
+typedef a3real3r(*a3_BenchmarkReal3Unary)(a3real3p v_inout);
+typedef a3real3r(*a3_BenchmarkReal3Accum)(a3real3p vL_inout, const a3real3p vR);
+
+typedef struct a3_BenchmarkInlineData
+{
+	a3real3* pos;
+	a3real3* vel;
+	a3real3* acc;
+	a3real3* normal_out;
+	a3real dt;
+
+	// filled at run time so the compiler cannot see through them
+	a3_BenchmarkReal3Op diff, cross;
+	a3_BenchmarkReal3Scale productS;
+	a3_BenchmarkReal3Unary normalize;
+	a3_BenchmarkReal3Accum add;
+} a3_BenchmarkInlineData;
+
+
+// face normal of triangle (i, i + 1, i + 2)
+void a3benchmarkInternalNormalCallThrough(void* data, a3count count)
+{
+	a3_BenchmarkInlineData* const d = (a3_BenchmarkInlineData*)data;
+	a3real3 e0, e1;
+	a3index i;
+	for (i = 0; i < count; ++i)
+	{
+		d->diff(e0, d->pos[i + 1], d->pos[i]);
+		d->diff(e1, d->pos[i + 2], d->pos[i]);
+		d->cross(d->normal_out[i], e0, e1);
+		d->normalize(d->normal_out[i]);
+	}
+}
+
+void a3benchmarkInternalNormalInline(void* data, a3count count)
+{
+	a3_BenchmarkInlineData* const d = (a3_BenchmarkInlineData*)data;
+	a3real3 e0, e1;
+	a3index i;
+	for (i = 0; i < count; ++i)
+	{
+		a3real3Diff(e0, d->pos[i + 1], d->pos[i]);
+		a3real3Diff(e1, d->pos[i + 2], d->pos[i]);
+		a3real3Cross(d->normal_out[i], e0, e1);
+		a3real3Normalize(d->normal_out[i]);
+	}
+}
+
+// explicit Euler particle step
+void a3benchmarkInternalParticleCallThrough(void* data, a3count count)
+{
+	a3_BenchmarkInlineData* const d = (a3_BenchmarkInlineData*)data;
+	a3real3 delta;
+	a3index i;
+	for (i = 0; i < count; ++i)
+	{
+		d->add(d->vel[i], d->productS(delta, d->acc[i], d->dt));
+		d->add(d->pos[i], d->productS(delta, d->vel[i], d->dt));
+	}
+}
+
+void a3benchmarkInternalParticleInline(void* data, a3count count)
+{
+	a3_BenchmarkInlineData* const d = (a3_BenchmarkInlineData*)data;
+	a3real3 delta;
+	a3index i;
+	for (i = 0; i < count; ++i)
+	{
+		a3real3Add(d->vel[i], a3real3ProductS(delta, d->acc[i], d->dt));
+		a3real3Add(d->pos[i], a3real3ProductS(delta, d->vel[i], d->dt));
+	}
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3i32 a3benchmarkSuite_inline(a3count const count, a3count const repeats)
+{
+	// first case of each pair is the reference for speedup
+	a3_BenchmarkCase const benchCase[] = {
+		{ "triangle normals, call-through", a3benchmarkInternalNormalCallThrough },
+		{ "triangle normals, direct", a3benchmarkInternalNormalInline },
+		{ "particle step, call-through", a3benchmarkInternalParticleCallThrough },
+		{ "particle step, direct", a3benchmarkInternalParticleInline },
+	};
+	a3count const caseCount = sizeof(benchCase) / sizeof(*benchCase);
+	a3_BenchmarkResult result[sizeof(benchCase) / sizeof(*benchCase)];
+	a3_BenchmarkInlineData data;
+	a3ui32 seed = 0x0a3d;
+	a3index i;
+
+	if (count <= 0)
+		return -1;
+
+	data.pos = (a3real3*)malloc((count + 2) * sizeof(a3real3));
+	data.vel = (a3real3*)malloc(count * sizeof(a3real3));
+	data.acc = (a3real3*)malloc(count * sizeof(a3real3));
+	data.normal_out = (a3real3*)malloc(count * sizeof(a3real3));
+	if (!data.pos || !data.vel || !data.acc || !data.normal_out)
+	{
+		free(data.pos);
+		free(data.vel);
+		free(data.acc);
+		free(data.normal_out);
+		return -1;
+	}
+	a3benchmarkFillReal(*data.pos, (count + 2) * 3, -a3real_one, a3real_one, &seed);
+	a3benchmarkFillReal(*data.vel, count * 3, -a3real_one, a3real_one, &seed);
+	a3benchmarkFillReal(*data.acc, count * 3, -a3real_one, a3real_one, &seed);
+	data.dt = (a3real)(1.0 / 60.0);
+	data.diff = a3real3Diff;
+	data.cross = a3real3Cross;
+	data.productS = a3real3ProductS;
+	data.normalize = a3real3Normalize;
+	data.add = a3real3Add;
+
+#ifdef A3_OPEN_SOURCE
+	a3benchmarkPrintHeader("inline (A3_OPEN_SOURCE)");
+#else	// !A3_OPEN_SOURCE
+	a3benchmarkPrintHeader("inline (precompiled library)");
+#endif	// A3_OPEN_SOURCE
+	for (i = 0; i < caseCount; ++i)
+	{
+		a3benchmarkRun(result + i, benchCase + i, &data, count, repeats);
+		a3benchmarkPrintResult(result + i, result + (i & ~1));
+	}
+
+	free(data.pos);
+	free(data.vel);
+	free(data.acc);
+	free(data.normal_out);
+	return caseCount;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,187 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_Benchmark-interpolation.c
+	Scalar and vector curves from a3interpolation.h and a3vector.h, one 
+		evaluation per element.
+*/
+
+#include "../a3_Benchmark.h"
+
+#include <stdlib.h>
+
+
+//-----------------------------------------------------------------------------
+
+typedef struct a3_BenchmarkInterpolationData
+{
+	a3real* n;			// 8 per op
+	a3real* param;		// 3 per op
+	a3real* s_out;
+	a3real4* v;			// 4 per op
+	a3real4* v_out;
+} a3_BenchmarkInterpolationData;
+
+
+void a3benchmarkInternalInterpRemap(void* data, a3count count)
+{
+	a3_BenchmarkInterpolationData* const d = (a3_BenchmarkInterpolationData*)data;
+	a3real const* n;
+	a3index i;
+	for (i = 0, n = d->n; i < count; ++i, n += 8)
+		d->s_out[i] = a3remapFunc(n[0], n[1], n[2], n[3], d->param[i * 3]);
+}
+
+void a3benchmarkInternalInterpBilerp(void* data, a3count count)
+{
+	a3_BenchmarkInterpolationData* const d = (a3_BenchmarkInterpolationData*)data;
+	a3real const* n, * t;
+	a3index i;
+	for (i = 0, n = d->n, t = d->param; i < count; ++i, n += 8, t += 3)
+		d->s_out[i] = a3bilerp(n[0], n[1], n[2], n[3], t[0], t[1]);
+}
+
+void a3benchmarkInternalInterpTrilerp(void* data, a3count count)
+{
+	a3_BenchmarkInterpolationData* const d = (a3_BenchmarkInterpolationData*)data;
+	a3real const* n, * t;
+	a3index i;
+	for (i = 0, n = d->n, t = d->param; i < count; ++i, n += 8, t += 3)
+		d->s_out[i] = a3trilerp(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7], t[0], t[1], t[2]);
+}
+
+void a3benchmarkInternalInterpCatmullRom(void* data, a3count count)
+{
+	a3_BenchmarkInterpolationData* const d = (a3_BenchmarkInterpolationData*)data;
+	a3real const* n;
+	a3index i;
+	for (i = 0, n = d->n; i < count; ++i, n += 8)
+		d->s_out[i] = a3CatmullRom(n[0], n[1], n[2], n[3], d->param[i * 3]);
+}
+
+void a3benchmarkInternalInterpHermite(void* data, a3count count)
+{
+	a3_BenchmarkInterpolationData* const d = (a3_BenchmarkInterpolationData*)data;
+	a3real const* n;
+	a3index i;
+	for (i = 0, n = d->n; i < count; ++i, n += 8)
+		d->s_out[i] = a3HermiteTangent(n[0], n[1], n[2], n[3], d->param[i * 3]);
+}
+
+void a3benchmarkInternalInterpBezier(void* data, a3count count)
+{
+	a3_BenchmarkInterpolationData* const d = (a3_BenchmarkInterpolationData*)data;
+	a3real const* n;
+	a3index i;
+	for (i = 0, n = d->n; i < count; ++i, n += 8)
+		d->s_out[i] = a3Bezier3(n[0], n[1], n[2], n[3], d->param[i * 3]);
+}
+
+void a3benchmarkInternalInterpCatmullRom3(void* data, a3count count)
+{
+	a3_BenchmarkInterpolationData* const d = (a3_BenchmarkInterpolationData*)data;
+	a3real4 const* v;
+	a3index i;
+	for (i = 0, v = d->v; i < count; ++i, v += 4)
+		a3real3CatmullRom(d->v_out[i], v[0], v[1], v[2], v[3], d->param[i * 3]);
+}
+
+void a3benchmarkInternalInterpHermite3(void* data, a3count count)
+{
+	a3_BenchmarkInterpolationData* const d = (a3_BenchmarkInterpolationData*)data;
+	a3real4 const* v;
+	a3index i;
+	for (i = 0, v = d->v; i < count; ++i, v += 4)
+		a3real3HermiteTangent(d->v_out[i], v[0], v[1], v[2], v[3], d->param[i * 3]);
+}
+
+void a3benchmarkInternalInterpBezier3(void* data, a3count count)
+{
+	a3_BenchmarkInterpolationData* const d = (a3_BenchmarkInterpolationData*)data;
+	a3real4 const* v;
+	a3index i;
+	for (i = 0, v = d->v; i < count; ++i, v += 4)
+		a3real3Bezier3(d->v_out[i], v[0], v[1], v[2], v[3], d->param[i * 3]);
+}
+
+void a3benchmarkInternalInterpSlerp3(void* data, a3count count)
+{
+	a3_BenchmarkInterpolationData* const d = (a3_BenchmarkInterpolationData*)data;
+	a3real4 const* v;
+	a3index i;
+	for (i = 0, v = d->v; i < count; ++i, v += 4)
+		a3real3Slerp(d->v_out[i], v[0], v[1], d->param[i * 3]);
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3i32 a3benchmarkSuite_interpolation(a3count const count, a3count const repeats)
+{
+	a3_BenchmarkCase const benchCase[] = {
+		{ "a3remapFunc", a3benchmarkInternalInterpRemap },
+		{ "a3bilerp", a3benchmarkInternalInterpBilerp },
+		{ "a3trilerp", a3benchmarkInternalInterpTrilerp },
+		{ "a3CatmullRom", a3benchmarkInternalInterpCatmullRom },
+		{ "a3HermiteTangent", a3benchmarkInternalInterpHermite },
+		{ "a3Bezier3", a3benchmarkInternalInterpBezier },
+		{ "a3real3CatmullRom", a3benchmarkInternalInterpCatmullRom3 },
+		{ "a3real3HermiteTangent", a3benchmarkInternalInterpHermite3 },
+		{ "a3real3Bezier3", a3benchmarkInternalInterpBezier3 },
+		{ "a3real3Slerp", a3benchmarkInternalInterpSlerp3 },
+	};
+	a3count const caseCount = sizeof(benchCase) / sizeof(*benchCase);
+	a3_BenchmarkResult result[sizeof(benchCase) / sizeof(*benchCase)];
+	a3_BenchmarkInterpolationData data;
+	a3ui32 seed = 0x0a3d0004;
+	a3index i;
+
+	if (count <= 0)
+		return -1;
+
+	data.v = (a3real4*)malloc(count * (5 * sizeof(a3real4) + 12 * sizeof(a3real)));
+	if (!data.v)
+		return -1;
+	data.v_out = data.v + count * 4;
+	data.n = (a3real*)(data.v_out + count);
+	data.param = data.n + count * 8;
+	data.s_out = data.param + count * 3;
+
+	// remap ranges are never empty: endpoints in separate intervals
+	a3benchmarkFillReal(*data.v, count * 4 * 4, -a3real_one, a3real_one, &seed);
+	a3benchmarkFillReal(data.n, count * 8, a3real_one, a3real_two, &seed);
+	for (i = 0; i < count; ++i)
+		data.n[i * 8 + 2] -= a3real_two;
+	a3benchmarkFillReal(data.param, count * 3, a3real_zero, a3real_one, &seed);
+
+	// no reference: each case measures a different function
+	a3benchmarkPrintHeader("interpolation");
+	for (i = 0; i < caseCount; ++i)
+	{
+		a3benchmarkRun(result + i, benchCase + i, &data, count, repeats);
+		a3benchmarkPrintResult(result + i, 0);
+	}
+
+	free(data.v);
+	return caseCount;
+}
+
+
+//-----------------------------------------------------------------------------
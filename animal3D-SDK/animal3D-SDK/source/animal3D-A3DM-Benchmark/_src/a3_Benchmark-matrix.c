@@ -0,0 +1,197 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_Benchmark-matrix.c
+	Common a3matrix.h operations on random rigid/scaled transforms, one 
+		call per element.
+*/
+
+#include "../a3_Benchmark.h"
+
+#include <stdlib.h>
+
+
+//-----------------------------------------------------------------------------
+
+typedef struct a3_BenchmarkMatrixData
+{
+	a3real4x4* m0;
+	a3real4x4* m1;
+	a3real4x4* m_out;
+	a3real3x3* m3_0;
+	a3real3x3* m3_1;
+	a3real3x3* m3_out;
+	a3real4* v;
+	a3real4* v_out;
+	a3real* angle;
+	a3real* s_out;
+} a3_BenchmarkMatrixData;
+
+
+void a3benchmarkInternalMatrixProduct4(void* data, a3count count)
+{
+	a3_BenchmarkMatrixData* const d = (a3_BenchmarkMatrixData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		a3real4x4Product(d->m_out[i], d->m0[i], d->m1[i]);
+}
+
+void a3benchmarkInternalMatrixProductTransform(void* data, a3count count)
+{
+	a3_BenchmarkMatrixData* const d = (a3_BenchmarkMatrixData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		a3real4x4ProductTransform(d->m_out[i], d->m0[i], d->m1[i]);
+}
+
+void a3benchmarkInternalMatrixProductVec(void* data, a3count count)
+{
+	a3_BenchmarkMatrixData* const d = (a3_BenchmarkMatrixData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		a3real4Real4x4ProductR(d->v_out[i], d->m0[i], d->v[i]);
+}
+
+void a3benchmarkInternalMatrixTransposed(void* data, a3count count)
+{
+	a3_BenchmarkMatrixData* const d = (a3_BenchmarkMatrixData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		a3real4x4GetTransposed(d->m_out[i], d->m0[i]);
+}
+
+void a3benchmarkInternalMatrixDeterminant(void* data, a3count count)
+{
+	a3_BenchmarkMatrixData* const d = (a3_BenchmarkMatrixData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		d->s_out[i] = a3real4x4Determinant(d->m0[i]);
+}
+
+void a3benchmarkInternalMatrixInverse4(void* data, a3count count)
+{
+	a3_BenchmarkMatrixData* const d = (a3_BenchmarkMatrixData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		a3real4x4GetInverse(d->m_out[i], d->m0[i]);
+}
+
+void a3benchmarkInternalMatrixTransformInverse(void* data, a3count count)
+{
+	a3_BenchmarkMatrixData* const d = (a3_BenchmarkMatrixData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		a3real4x4TransformInverse(d->m_out[i], d->m0[i]);
+}
+
+void a3benchmarkInternalMatrixSetRotate(void* data, a3count count)
+{
+	a3_BenchmarkMatrixData* const d = (a3_BenchmarkMatrixData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		a3real4x4SetRotateXYZ(d->m_out[i], d->angle[i * 3 + 0], d->angle[i * 3 + 1], d->angle[i * 3 + 2]);
+}
+
+void a3benchmarkInternalMatrixProduct3(void* data, a3count count)
+{
+	a3_BenchmarkMatrixData* const d = (a3_BenchmarkMatrixData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		a3real3x3Product(d->m3_out[i], d->m3_0[i], d->m3_1[i]);
+}
+
+void a3benchmarkInternalMatrixInverse3(void* data, a3count count)
+{
+	a3_BenchmarkMatrixData* const d = (a3_BenchmarkMatrixData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		a3real3x3GetInverse(d->m3_out[i], d->m3_0[i]);
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3i32 a3benchmarkSuite_matrix(a3count const count, a3count const repeats)
+{
+	a3_BenchmarkCase const benchCase[] = {
+		{ "a3real4x4Product", a3benchmarkInternalMatrixProduct4 },
+		{ "a3real4x4ProductTransform", a3benchmarkInternalMatrixProductTransform },
+		{ "a3real4Real4x4ProductR", a3benchmarkInternalMatrixProductVec },
+		{ "a3real4x4GetTransposed", a3benchmarkInternalMatrixTransposed },
+		{ "a3real4x4Determinant", a3benchmarkInternalMatrixDeterminant },
+		{ "a3real4x4GetInverse", a3benchmarkInternalMatrixInverse4 },
+		{ "a3real4x4TransformInverse", a3benchmarkInternalMatrixTransformInverse },
+		{ "a3real4x4SetRotateXYZ", a3benchmarkInternalMatrixSetRotate },
+		{ "a3real3x3Product", a3benchmarkInternalMatrixProduct3 },
+		{ "a3real3x3GetInverse", a3benchmarkInternalMatrixInverse3 },
+	};
+	a3count const caseCount = sizeof(benchCase) / sizeof(*benchCase);
+	a3_BenchmarkResult result[sizeof(benchCase) / sizeof(*benchCase)];
+	a3_BenchmarkMatrixData data;
+	a3real* translate;
+	a3ui32 seed = 0x0a3d0002;
+	a3index i;
+
+	if (count <= 0)
+		return -1;
+
+	data.m0 = (a3real4x4*)malloc(count * (3 * sizeof(a3real4x4) + 3 * sizeof(a3real3x3) + 2 * sizeof(a3real4) + 10 * sizeof(a3real)));
+	if (!data.m0)
+		return -1;
+	data.m1 = data.m0 + count;
+	data.m_out = data.m1 + count;
+	data.m3_0 = (a3real3x3*)(data.m_out + count);
+	data.m3_1 = data.m3_0 + count;
+	data.m3_out = data.m3_1 + count;
+	data.v = (a3real4*)(data.m3_out + count);
+	data.v_out = data.v + count;
+	data.angle = (a3real*)(data.v_out + count);
+	data.s_out = data.angle + count * 3;
+	translate = data.s_out + count;
+
+	// transforms: rotation, translation and scale in [0.5, 2)
+	a3benchmarkFillReal(data.angle, count * 3, (a3real)-180, (a3real)+180, &seed);
+	a3benchmarkFillReal(translate, count * 3, (a3real)-10, (a3real)+10, &seed);
+	for (i = 0; i < count; ++i)
+	{
+		a3real4x4SetRotateXYZ(data.m0[i], data.angle[i * 3 + 0], data.angle[i * 3 + 1], data.angle[i * 3 + 2]);
+		a3real3MulS(data.m0[i][0], (a3real)1.25 + data.angle[i * 3 + 0] / (a3real)240);
+		a3real3SetReal3(data.m0[i][3], translate + i * 3);
+		a3real4x4SetRotateZYX(data.m1[i], data.angle[i * 3 + 2], data.angle[i * 3 + 0], data.angle[i * 3 + 1]);
+		a3real3SetReal3(data.m1[i][3], translate + (count - 1 - i) * 3);
+		a3real3x3SetReal4x4(data.m3_0[i], data.m0[i]);
+		a3real3x3SetReal4x4(data.m3_1[i], data.m1[i]);
+	}
+	a3benchmarkFillReal(*data.v, count * 4, -a3real_one, a3real_one, &seed);
+
+	// no reference: each case measures a different function
+	a3benchmarkPrintHeader("matrix");
+	for (i = 0; i < caseCount; ++i)
+	{
+		a3benchmarkRun(result + i, benchCase + i, &data, count, repeats);
+		a3benchmarkPrintResult(result + i, 0);
+	}
+
+	free(data.m0);
+	return caseCount;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,191 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_Benchmark-matrixstack.c
+	Demo model matrix stack: the unfused sequence of seven calls versus
+		the fused batch update; objects cycle through rigid, rigid,
+		uniform-scale and non-uniform-scale transforms. Also reports worst
+		difference between fused and unfused results.
+*/
+
+#include "../a3_Benchmark.h"
+
+// matrix stack is plain A3DM, so the demo header can be used directly
+#include "../../animal3D-DemoPlugin/A3_DEMO/_a3_demo_utilities/a3_DemoSceneObject.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+
+//-----------------------------------------------------------------------------
+
+typedef struct a3_BenchmarkMatrixStackData
+{
+	a3mat4 projectionMat, viewerMat, viewerMatInv;
+	a3mat4* modelMat;
+	a3_DemoModelMatrixStack* stack_out;
+} a3_BenchmarkMatrixStackData;
+
+
+// rotation matrix from unit quaternion, then scale columns
+void a3benchmarkInternalMakeTransform(a3real4x4p m_out, a3real4p const q, a3real3p const t, a3real3p const s)
+{
+	a3real const x = q[0], y = q[1], z = q[2], w = q[3];
+	m_out[0][0] = (a3real_one - a3real_two * (y * y + z * z)) * s[0];
+	m_out[0][1] = (a3real_two * (x * y + w * z)) * s[0];
+	m_out[0][2] = (a3real_two * (x * z - w * y)) * s[0];
+	m_out[1][0] = (a3real_two * (x * y - w * z)) * s[1];
+	m_out[1][1] = (a3real_one - a3real_two * (x * x + z * z)) * s[1];
+	m_out[1][2] = (a3real_two * (y * z + w * x)) * s[1];
+	m_out[2][0] = (a3real_two * (x * z + w * y)) * s[2];
+	m_out[2][1] = (a3real_two * (y * z - w * x)) * s[2];
+	m_out[2][2] = (a3real_one - a3real_two * (x * x + y * y)) * s[2];
+	m_out[0][3] = m_out[1][3] = m_out[2][3] = a3real_zero;
+	m_out[3][0] = t[0];
+	m_out[3][1] = t[1];
+	m_out[3][2] = t[2];
+	m_out[3][3] = a3real_one;
+}
+
+// current demo sequence (a3demo_updateModelMatrixStack)
+void a3benchmarkInternalMatrixStackUnfused(void* data, a3count count)
+{
+	a3_BenchmarkMatrixStackData* const d = (a3_BenchmarkMatrixStackData*)data;
+	a3_DemoModelMatrixStack* model;
+	a3index i;
+	for (i = 0; i < count; ++i)
+	{
+		model = d->stack_out + i;
+		a3real4x4SetReal4x4(model->modelMat.m, d->modelMat[i].m);
+		a3real4x4TransformInverse(model->modelMatInverse.m, d->modelMat[i].m);
+		a3real4x4GetTransposed(model->modelMatInverseTranspose.m, model->modelMatInverse.m);
+		model->modelMatInverseTranspose.m[0][3] = model->modelMatInverseTranspose.m[1][3] = model->modelMatInverseTranspose.m[2][3] = model->modelMatInverseTranspose.m[3][3] = a3real_zero;
+		a3real4x4ProductTransform(model->modelViewMat.m, d->viewerMatInv.m, d->modelMat[i].m);
+		a3real4x4ProductTransform(model->modelViewMatInverse.m, model->modelMatInverse.m, d->viewerMat.m);
+		a3real4x4GetTransposed(model->modelViewMatInverseTranspose.m, model->modelViewMatInverse.m);
+		model->modelViewMatInverseTranspose.m[0][3] = model->modelViewMatInverseTranspose.m[1][3] = model->modelViewMatInverseTranspose.m[2][3] = model->modelViewMatInverseTranspose.m[3][3] = a3real_zero;
+		a3real4x4Product(model->modelViewProjectionMat.m, d->projectionMat.m, model->modelViewMat.m);
+		a3real4x4SetReal4x4(model->atlasMat.m, a3mat4_identity.m);
+	}
+}
+
+void a3benchmarkInternalMatrixStackArray(void* data, a3count count)
+{
+	a3_BenchmarkMatrixStackData* const d = (a3_BenchmarkMatrixStackData*)data;
+	a3demo_updateModelMatrixStackArray(d->stack_out, count,
+		d->projectionMat.m, d->viewerMat.m, d->viewerMatInv.m, d->modelMat->m, sizeof(a3mat4), a3mat4_identity.m, 0);
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3i32 a3benchmarkSuite_matrixstack(a3count const count, a3count const repeats)
+{
+	// first case is the reference for speedup
+	a3_BenchmarkCase const benchCase[] = {
+		{ "unfused sequence (7 calls)", a3benchmarkInternalMatrixStackUnfused },
+		{ "a3demo_updateModelMatrixStackArray", a3benchmarkInternalMatrixStackArray },
+	};
+	a3count const caseCount = sizeof(benchCase) / sizeof(*benchCase);
+	a3_BenchmarkResult result[sizeof(benchCase) / sizeof(*benchCase)];
+	a3_BenchmarkMatrixStackData data;
+	a3_DemoModelMatrixStack* reference;
+	a3real4* q;
+	a3real* v;
+	a3real3 s;
+	a3real err, errMax = a3real_zero;
+	a3ui32 seed = 0x0a3d;
+	a3index i, j;
+
+	if (count <= 0)
+		return -1;
+
+	data.modelMat = (a3mat4*)malloc(count * sizeof(a3mat4));
+	data.stack_out = (a3_DemoModelMatrixStack*)malloc(count * sizeof(a3_DemoModelMatrixStack));
+	reference = (a3_DemoModelMatrixStack*)malloc(count * sizeof(a3_DemoModelMatrixStack));
+	q = (a3real4*)malloc((count + 1) * sizeof(a3real4));
+	v = (a3real*)malloc((count + 1) * 6 * sizeof(a3real));
+	if (!data.modelMat || !data.stack_out || !reference || !q || !v)
+	{
+		free(data.modelMat);
+		free(data.stack_out);
+		free(reference);
+		free(q);
+		free(v);
+		return -1;
+	}
+
+	// rigid viewer and perspective projection
+	a3benchmarkFillQuat(q, count + 1, &seed);
+	a3benchmarkFillReal(v, (count + 1) * 6, a3real_one / a3real_two, a3real_two, &seed);
+	s[0] = s[1] = s[2] = a3real_one;
+	a3benchmarkInternalMakeTransform(data.viewerMat.m, q[count], v + count * 6, s);
+	a3real4x4TransformInverseIgnoreScale(data.viewerMatInv.m, data.viewerMat.m);
+	a3real4x4MakePerspectiveProjection(data.projectionMat.m, 0, (a3real)60.0, a3real_one, (a3real)0.1, (a3real)100.0);
+
+	// objects: rigid, rigid, uniform scale, non-uniform scale
+	for (i = 0; i < count; ++i)
+	{
+		switch (i % 4)
+		{
+		case 2:
+			s[0] = s[1] = s[2] = v[i * 6 + 3];
+			break;
+		case 3:
+			s[0] = v[i * 6 + 3];
+			s[1] = v[i * 6 + 4];
+			s[2] = v[i * 6 + 5];
+			break;
+		default:
+			s[0] = s[1] = s[2] = a3real_one;
+		}
+		a3benchmarkInternalMakeTransform(data.modelMat[i].m, q[i], v + i * 6, s);
+	}
+
+	a3benchmarkPrintHeader("matrix stack");
+	for (i = 0; i < caseCount; ++i)
+	{
+		a3benchmarkRun(result + i, benchCase + i, &data, count, repeats);
+		a3benchmarkPrintResult(result + i, result);
+
+		// keep unfused results, compare fused against them
+		if (i == 0)
+			for (j = 0; j < count; ++j)
+				reference[j] = data.stack_out[j];
+		else
+			for (j = 0; j < count * sizeof(a3_DemoModelMatrixStack) / sizeof(a3real); ++j)
+			{
+				err = ((a3real const*)data.stack_out)[j] - ((a3real const*)reference)[j];
+				err = err < a3real_zero ? -err : err;
+				errMax = err > errMax ? err : errMax;
+			}
+	}
+	printf("max abs difference vs unfused: %.3g\n", (a3f64)errMax);
+
+	free(data.modelMat);
+	free(data.stack_out);
+	free(reference);
+	free(q);
+	free(v);
+	return caseCount;
+}
+
+
+//-----------------------------------------------------------------------------
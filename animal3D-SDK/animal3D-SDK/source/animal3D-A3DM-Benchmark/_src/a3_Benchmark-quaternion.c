@@ -0,0 +1,199 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_Benchmark-quaternion.c
+	Quaternion interpolation: per-call library functions versus batches, 
+		with a plain libm slerp as the baseline.
+*/
+
+#include "../a3_Benchmark.h"
+
+#include "animal3D-A3DM/a3math/a3batch.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+
+typedef struct a3_BenchmarkQuatData
+{
+	a3real4* q0;
+	a3real4* q1;
+	a3real4* q_out;
+	a3real* param;
+} a3_BenchmarkQuatData;
+
+
+// slerp of unit quaternions with libm acosf and sinf (radians), the way 
+//	it is usually written; shortest path, lerp where nearly parallel
+void a3benchmarkInternalQuatSlerpLibmOne(a3real4p q_out, const a3real4p q0, const a3real4p q1, const a3real param)
+{
+	float d = (float)(q0[0] * q1[0] + q0[1] * q1[1] + q0[2] * q1[2] + q0[3] * q1[3]);
+	float const sign = d < 0.0f ? -1.0f : 1.0f;
+	float a, s, s0, s1;
+	d *= sign;
+	if (d < 0.9995f)
+	{
+		a = acosf(d);
+		s = 1.0f / sinf(a);
+		s0 = sinf((1.0f - (float)param) * a) * s;
+		s1 = sinf((float)param * a) * s * sign;
+	}
+	else
+	{
+		s0 = 1.0f - (float)param;
+		s1 = (float)param * sign;
+	}
+	q_out[0] = (a3real)(q0[0] * s0 + q1[0] * s1);
+	q_out[1] = (a3real)(q0[1] * s0 + q1[1] * s1);
+	q_out[2] = (a3real)(q0[2] * s0 + q1[2] * s1);
+	q_out[3] = (a3real)(q0[3] * s0 + q1[3] * s1);
+}
+
+void a3benchmarkInternalQuatSlerpLibm(void* data, a3count count)
+{
+	a3_BenchmarkQuatData* const d = (a3_BenchmarkQuatData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		a3benchmarkInternalQuatSlerpLibmOne(d->q_out[i], d->q0[i], d->q1[i], d->param[i]);
+}
+
+void a3benchmarkInternalQuatSlerpUnit(void* data, a3count count)
+{
+	a3_BenchmarkQuatData* const d = (a3_BenchmarkQuatData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		a3quatSlerpUnit(d->q_out[i], d->q0[i], d->q1[i], d->param[i]);
+}
+
+void a3benchmarkInternalQuatSlerpUnitArray(void* data, a3count count)
+{
+	a3_BenchmarkQuatData* const d = (a3_BenchmarkQuatData*)data;
+	a3quatSlerpUnitArray(*d->q_out, sizeof(a3real4), *d->q0, sizeof(a3real4), *d->q1, sizeof(a3real4), d->param, sizeof(a3real), count);
+}
+
+void a3benchmarkInternalQuatNlerp(void* data, a3count count)
+{
+	a3_BenchmarkQuatData* const d = (a3_BenchmarkQuatData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		a3quatNlerp(d->q_out[i], d->q0[i], d->q1[i], d->param[i]);
+}
+
+void a3benchmarkInternalQuatNlerpArray(void* data, a3count count)
+{
+	a3_BenchmarkQuatData* const d = (a3_BenchmarkQuatData*)data;
+	a3quatNlerpArray(*d->q_out, sizeof(a3real4), *d->q0, sizeof(a3real4), *d->q1, sizeof(a3real4), d->param, sizeof(a3real), count);
+}
+
+void a3benchmarkInternalQuatSlerpFastUnit(void* data, a3count count)
+{
+	a3_BenchmarkQuatData* const d = (a3_BenchmarkQuatData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		a3quatSlerpFastUnit(d->q_out[i], d->q0[i], d->q1[i], d->param[i]);
+}
+
+void a3benchmarkInternalQuatSlerpFastUnitArray(void* data, a3count count)
+{
+	a3_BenchmarkQuatData* const d = (a3_BenchmarkQuatData*)data;
+	a3quatSlerpFastUnitArray(*d->q_out, sizeof(a3real4), *d->q0, sizeof(a3real4), *d->q1, sizeof(a3real4), d->param, sizeof(a3real), count);
+}
+
+
+// worst component difference of table and fast slerp from libm slerp
+void a3benchmarkInternalQuatError(a3_BenchmarkQuatData const* d, a3count const count, a3f64* tableError_out, a3f64* fastError_out)
+{
+	a3f64 e, et = 0.0, ef = 0.0;
+	a3real4 ref, q;
+	a3index i, j;
+	for (i = 0; i < count; ++i)
+	{
+		a3benchmarkInternalQuatSlerpLibmOne(ref, d->q0[i], d->q1[i], d->param[i]);
+		a3quatSlerpUnit(q, d->q0[i], d->q1[i], d->param[i]);
+		for (j = 0; j < 4; ++j)
+		{
+			e = fabs((a3f64)q[j] - (a3f64)ref[j]);
+			et = e > et ? e : et;
+		}
+		a3quatSlerpFastUnit(q, d->q0[i], d->q1[i], d->param[i]);
+		for (j = 0; j < 4; ++j)
+		{
+			e = fabs((a3f64)q[j] - (a3f64)ref[j]);
+			ef = e > ef ? e : ef;
+		}
+	}
+	*tableError_out = et;
+	*fastError_out = ef;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3i32 a3benchmarkSuite_quaternion(a3count const count, a3count const repeats)
+{
+	// first case is the reference for speedup
+	a3_BenchmarkCase const benchCase[] = {
+		{ "slerp with libm acosf, sinf", a3benchmarkInternalQuatSlerpLibm },
+		{ "a3quatSlerpUnit (per call)", a3benchmarkInternalQuatSlerpUnit },
+		{ "a3quatSlerpUnitArray", a3benchmarkInternalQuatSlerpUnitArray },
+		{ "a3quatNlerp (per call)", a3benchmarkInternalQuatNlerp },
+		{ "a3quatNlerpArray", a3benchmarkInternalQuatNlerpArray },
+		{ "a3quatSlerpFastUnit (per call)", a3benchmarkInternalQuatSlerpFastUnit },
+		{ "a3quatSlerpFastUnitArray", a3benchmarkInternalQuatSlerpFastUnitArray },
+	};
+	a3count const caseCount = sizeof(benchCase) / sizeof(*benchCase);
+	a3_BenchmarkResult result[sizeof(benchCase) / sizeof(*benchCase)];
+	a3_BenchmarkQuatData data;
+	a3f64 tableError, fastError;
+	a3ui32 seed = 0x0a3d0a3d;
+	a3index i;
+
+	if (count <= 0)
+		return -1;
+
+	data.q0 = (a3real4*)malloc(count * (3 * sizeof(a3real4) + sizeof(a3real)));
+	if (!data.q0)
+		return -1;
+	data.q1 = data.q0 + count;
+	data.q_out = data.q1 + count;
+	data.param = (a3real*)(data.q_out + count);
+	a3benchmarkFillQuat(data.q0, count, &seed);
+	a3benchmarkFillQuat(data.q1, count, &seed);
+	a3benchmarkFillReal(data.param, count, a3real_zero, a3real_one, &seed);
+
+	a3benchmarkPrintHeader("quaternion interpolation");
+	for (i = 0; i < caseCount; ++i)
+	{
+		a3benchmarkRun(result + i, benchCase + i, &data, count, repeats);
+		a3benchmarkPrintResult(result + i, result);
+	}
+
+	a3benchmarkInternalQuatError(&data, count, &tableError, &fastError);
+	printf("max abs error vs libm slerp: a3quatSlerpUnit %.3g, a3quatSlerpFastUnit %.3g\n", tableError, fastError);
+
+	free(data.q0);
+	return caseCount;
+}
+
+
+//-----------------------------------------------------------------------------
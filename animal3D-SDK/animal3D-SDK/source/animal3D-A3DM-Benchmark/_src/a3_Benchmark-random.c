@@ -0,0 +1,117 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_Benchmark-random.c
+	Random numbers: global-seed library generator versus streams.
+*/
+
+#include "../a3_Benchmark.h"
+
+#include "animal3D-A3DM/a3math/a3random.h"
+#include "animal3D-A3DM/a3math/a3randomstream.h"
+
+#include <stdlib.h>
+
+
+//-----------------------------------------------------------------------------
+
+typedef struct a3_BenchmarkRandomData
+{
+	a3_RandomStream stream[1];
+	a3real* values_out;
+} a3_BenchmarkRandomData;
+
+
+void a3benchmarkInternalRandomNormalized(void* data, a3count count)
+{
+	a3_BenchmarkRandomData* const d = (a3_BenchmarkRandomData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		d->values_out[i] = a3randomNormalized();
+}
+
+void a3benchmarkInternalRandomStreamUnit(void* data, a3count count)
+{
+	a3_BenchmarkRandomData* const d = (a3_BenchmarkRandomData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		d->values_out[i] = a3randomStreamUnit(d->stream);
+}
+
+void a3benchmarkInternalRandomStreamFillUnit(void* data, a3count count)
+{
+	a3_BenchmarkRandomData* const d = (a3_BenchmarkRandomData*)data;
+	a3randomStreamFillUnit(d->stream, d->values_out, count);
+}
+
+void a3benchmarkInternalRandomStreamNormal(void* data, a3count count)
+{
+	a3_BenchmarkRandomData* const d = (a3_BenchmarkRandomData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		d->values_out[i] = a3randomStreamNormal(d->stream, a3real_zero, a3real_one);
+}
+
+void a3benchmarkInternalRandomStreamFillNormal(void* data, a3count count)
+{
+	a3_BenchmarkRandomData* const d = (a3_BenchmarkRandomData*)data;
+	a3randomStreamFillNormal(d->stream, d->values_out, count, a3real_zero, a3real_one);
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3i32 a3benchmarkSuite_random(a3count const count, a3count const repeats)
+{
+	// first case is the reference for speedup
+	a3_BenchmarkCase const benchCase[] = {
+		{ "a3randomNormalized (global seed)", a3benchmarkInternalRandomNormalized },
+		{ "a3randomStreamUnit (per call)", a3benchmarkInternalRandomStreamUnit },
+		{ "a3randomStreamFillUnit", a3benchmarkInternalRandomStreamFillUnit },
+		{ "a3randomStreamNormal (per call)", a3benchmarkInternalRandomStreamNormal },
+		{ "a3randomStreamFillNormal", a3benchmarkInternalRandomStreamFillNormal },
+	};
+	a3count const caseCount = sizeof(benchCase) / sizeof(*benchCase);
+	a3_BenchmarkResult result[sizeof(benchCase) / sizeof(*benchCase)];
+	a3_BenchmarkRandomData data;
+	a3index i;
+
+	if (count <= 0)
+		return -1;
+
+	data.values_out = (a3real*)malloc(count * sizeof(a3real));
+	if (!data.values_out)
+		return -1;
+	a3randomSetSeed(0x0a3d);
+	a3randomStreamInit(data.stream, 0x0a3d);
+
+	a3benchmarkPrintHeader("random numbers");
+	for (i = 0; i < caseCount; ++i)
+	{
+		a3benchmarkRun(result + i, benchCase + i, &data, count, repeats);
+		a3benchmarkPrintResult(result + i, result);
+	}
+
+	free(data.values_out);
+	return caseCount;
+}
+
+
+//-----------------------------------------------------------------------------
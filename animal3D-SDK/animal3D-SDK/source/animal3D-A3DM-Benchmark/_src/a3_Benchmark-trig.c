@@ -0,0 +1,190 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_Benchmark-trig.c
+	Sine and cosine: lookup table versus polynomial, including the Euler
+		rotation setters that use them; also reports worst error of each
+		against double-precision libm.
+*/
+
+#include "../a3_Benchmark.h"
+
+// keep library names pointing at the table versions for comparison
+#define A3_SINCOS_NO_OVERRIDE
+#include "animal3D-A3DM/a3math/a3sincos.h"
+#include "animal3D-A3DM/a3math/a3trig.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+
+typedef struct a3_BenchmarkTrigData
+{
+	a3real* angle;		// 3 per op, degrees
+	a3real* sin_out;
+	a3real* cos_out;
+	a3real4x4* m_out;
+	a3real4* q_out;
+} a3_BenchmarkTrigData;
+
+
+void a3benchmarkInternalTrigTable(void* data, a3count count)
+{
+	a3_BenchmarkTrigData* const d = (a3_BenchmarkTrigData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+	{
+		d->sin_out[i] = a3sind(d->angle[i]);
+		d->cos_out[i] = a3cosd(d->angle[i]);
+	}
+}
+
+void a3benchmarkInternalTrigPoly(void* data, a3count count)
+{
+	a3_BenchmarkTrigData* const d = (a3_BenchmarkTrigData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		d->sin_out[i] = a3sincosdPoly(d->angle[i], d->cos_out + i);
+}
+
+void a3benchmarkInternalTrigPolyArray(void* data, a3count count)
+{
+	a3_BenchmarkTrigData* const d = (a3_BenchmarkTrigData*)data;
+	a3sincosdArray(d->sin_out, d->cos_out, d->angle, count);
+}
+
+void a3benchmarkInternalTrigRotateZYX(void* data, a3count count)
+{
+	a3_BenchmarkTrigData* const d = (a3_BenchmarkTrigData*)data;
+	a3real const* a = d->angle;
+	a3index i;
+	for (i = 0; i < count; ++i, a += 3)
+		a3real4x4SetRotateZYX(d->m_out[i], a[0], a[1], a[2]);
+}
+
+void a3benchmarkInternalTrigRotateZYXPoly(void* data, a3count count)
+{
+	a3_BenchmarkTrigData* const d = (a3_BenchmarkTrigData*)data;
+	a3real const* a = d->angle;
+	a3index i;
+	for (i = 0; i < count; ++i, a += 3)
+		a3real4x4SetRotateZYXPoly(d->m_out[i], a[0], a[1], a[2]);
+}
+
+void a3benchmarkInternalTrigEulerZYX(void* data, a3count count)
+{
+	a3_BenchmarkTrigData* const d = (a3_BenchmarkTrigData*)data;
+	a3real const* a = d->angle;
+	a3index i;
+	for (i = 0; i < count; ++i, a += 3)
+		a3quatSetEulerZYX(d->q_out[i], a[0], a[1], a[2]);
+}
+
+void a3benchmarkInternalTrigEulerZYXPoly(void* data, a3count count)
+{
+	a3_BenchmarkTrigData* const d = (a3_BenchmarkTrigData*)data;
+	a3real const* a = d->angle;
+	a3index i;
+	for (i = 0; i < count; ++i, a += 3)
+		a3quatSetEulerZYXPoly(d->q_out[i], a[0], a[1], a[2]);
+}
+
+
+// worst absolute error of sine and cosine against libm over table domain
+void a3benchmarkInternalTrigError(a3f64* tableError_out, a3f64* polyError_out)
+{
+	a3count const n = 720 * 64;
+	a3f64 const deg2rad = 3.14159265358979323846 / 180.0;
+	a3f64 s, c, e, et = 0.0, ep = 0.0;
+	a3real x, pc;
+	a3index i;
+	for (i = 0; i <= n; ++i)
+	{
+		x = (a3real)(-360.0 + 720.0 * (a3f64)i / (a3f64)n);
+		s = sin((a3f64)x * deg2rad);
+		c = cos((a3f64)x * deg2rad);
+		e = fabs((a3f64)a3sind(x) - s);
+		et = e > et ? e : et;
+		e = fabs((a3f64)a3cosd(x) - c);
+		et = e > et ? e : et;
+		e = fabs((a3f64)a3sincosdPoly(x, &pc) - s);
+		ep = e > ep ? e : ep;
+		e = fabs((a3f64)pc - c);
+		ep = e > ep ? e : ep;
+	}
+	*tableError_out = et;
+	*polyError_out = ep;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3i32 a3benchmarkSuite_trig(a3count const count, a3count const repeats)
+{
+	// first case is the reference for speedup
+	a3_BenchmarkCase const benchCase[] = {
+		{ "a3sind + a3cosd (table)", a3benchmarkInternalTrigTable },
+		{ "a3sincosdPoly (per call)", a3benchmarkInternalTrigPoly },
+		{ "a3sincosdArray", a3benchmarkInternalTrigPolyArray },
+		{ "a3real4x4SetRotateZYX (table)", a3benchmarkInternalTrigRotateZYX },
+		{ "a3real4x4SetRotateZYXPoly", a3benchmarkInternalTrigRotateZYXPoly },
+		{ "a3quatSetEulerZYX (table)", a3benchmarkInternalTrigEulerZYX },
+		{ "a3quatSetEulerZYXPoly", a3benchmarkInternalTrigEulerZYXPoly },
+	};
+	a3count const caseCount = sizeof(benchCase) / sizeof(*benchCase);
+	a3_BenchmarkResult result[sizeof(benchCase) / sizeof(*benchCase)];
+	a3_BenchmarkTrigData data;
+	a3f64 tableError, polyError;
+	a3ui32 seed = 0x0a3d7a1e;
+	a3index i;
+
+	if (count <= 0)
+		return -1;
+
+	data.m_out = (a3real4x4*)malloc(count * (sizeof(a3real4x4) + sizeof(a3real4) + 5 * sizeof(a3real)));
+	if (!data.m_out)
+		return -1;
+	data.q_out = (a3real4*)(data.m_out + count);
+	data.angle = (a3real*)(data.q_out + count);
+	data.sin_out = data.angle + count * 3;
+	data.cos_out = data.sin_out + count;
+
+	// tables initialized at start (main); domain is one turn either way
+	a3benchmarkFillReal(data.angle, count * 3, (a3real)-360, (a3real)+360, &seed);
+
+	a3benchmarkPrintHeader("trigonometry");
+	for (i = 0; i < caseCount; ++i)
+	{
+		a3benchmarkRun(result + i, benchCase + i, &data, count, repeats);
+		a3benchmarkPrintResult(result + i, result);
+	}
+
+	a3benchmarkInternalTrigError(&tableError, &polyError);
+	printf("max abs error vs libm: table %.3g, polynomial %.3g\n", tableError, polyError);
+
+	free(data.m_out);
+	return caseCount;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,175 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_Benchmark-vector.c
+	Common a3vector.h operations, one call per element.
+*/
+
+#include "../a3_Benchmark.h"
+
+#include <stdlib.h>
+
+
+//-----------------------------------------------------------------------------
+
+typedef struct a3_BenchmarkVectorData
+{
+	a3real4* v0;
+	a3real4* v1;
+	a3real4* v2;
+	a3real4* p;
+	a3real4* v_out;
+	a3real* param;
+	a3real* s_out;
+} a3_BenchmarkVectorData;
+
+
+void a3benchmarkInternalVectorSum(void* data, a3count count)
+{
+	a3_BenchmarkVectorData* const d = (a3_BenchmarkVectorData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		a3real3Sum(d->v_out[i], d->v0[i], d->v1[i]);
+}
+
+void a3benchmarkInternalVectorDot(void* data, a3count count)
+{
+	a3_BenchmarkVectorData* const d = (a3_BenchmarkVectorData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		d->s_out[i] = a3real3Dot(d->v0[i], d->v1[i]);
+}
+
+void a3benchmarkInternalVectorLength(void* data, a3count count)
+{
+	a3_BenchmarkVectorData* const d = (a3_BenchmarkVectorData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		d->s_out[i] = a3real3Length(d->v0[i]);
+}
+
+void a3benchmarkInternalVectorCross(void* data, a3count count)
+{
+	a3_BenchmarkVectorData* const d = (a3_BenchmarkVectorData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		a3real3Cross(d->v_out[i], d->v0[i], d->v1[i]);
+}
+
+void a3benchmarkInternalVectorNormalize3(void* data, a3count count)
+{
+	a3_BenchmarkVectorData* const d = (a3_BenchmarkVectorData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		a3real3GetUnit(d->v_out[i], d->v0[i]);
+}
+
+void a3benchmarkInternalVectorNormalize4(void* data, a3count count)
+{
+	a3_BenchmarkVectorData* const d = (a3_BenchmarkVectorData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		a3real4GetUnit(d->v_out[i], d->v0[i]);
+}
+
+void a3benchmarkInternalVectorLerp(void* data, a3count count)
+{
+	a3_BenchmarkVectorData* const d = (a3_BenchmarkVectorData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		a3real3Lerp(d->v_out[i], d->v0[i], d->v1[i], d->param[i]);
+}
+
+void a3benchmarkInternalVectorProjected(void* data, a3count count)
+{
+	a3_BenchmarkVectorData* const d = (a3_BenchmarkVectorData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		a3real3Projected(d->v_out[i], d->v0[i], d->v1[i]);
+}
+
+void a3benchmarkInternalVectorTriangleNormal(void* data, a3count count)
+{
+	a3_BenchmarkVectorData* const d = (a3_BenchmarkVectorData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		a3real3TriangleNormalUnit(d->v_out[i], d->v0[i], d->v1[i], d->v2[i]);
+}
+
+void a3benchmarkInternalVectorPointInTriangle(void* data, a3count count)
+{
+	a3_BenchmarkVectorData* const d = (a3_BenchmarkVectorData*)data;
+	a3index i;
+	for (i = 0; i < count; ++i)
+		d->s_out[i] = (a3real)a3real3PointIsInTriangle(d->p[i], d->v0[i], d->v1[i], d->v2[i]);
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3i32 a3benchmarkSuite_vector(a3count const count, a3count const repeats)
+{
+	a3_BenchmarkCase const benchCase[] = {
+		{ "a3real3Sum", a3benchmarkInternalVectorSum },
+		{ "a3real3Dot", a3benchmarkInternalVectorDot },
+		{ "a3real3Length", a3benchmarkInternalVectorLength },
+		{ "a3real3Cross", a3benchmarkInternalVectorCross },
+		{ "a3real3GetUnit", a3benchmarkInternalVectorNormalize3 },
+		{ "a3real4GetUnit", a3benchmarkInternalVectorNormalize4 },
+		{ "a3real3Lerp", a3benchmarkInternalVectorLerp },
+		{ "a3real3Projected", a3benchmarkInternalVectorProjected },
+		{ "a3real3TriangleNormalUnit", a3benchmarkInternalVectorTriangleNormal },
+		{ "a3real3PointIsInTriangle", a3benchmarkInternalVectorPointInTriangle },
+	};
+	a3count const caseCount = sizeof(benchCase) / sizeof(*benchCase);
+	a3_BenchmarkResult result[sizeof(benchCase) / sizeof(*benchCase)];
+	a3_BenchmarkVectorData data;
+	a3ui32 seed = 0x0a3d0001;
+	a3index i;
+
+	if (count <= 0)
+		return -1;
+
+	data.v0 = (a3real4*)malloc(count * (5 * sizeof(a3real4) + 2 * sizeof(a3real)));
+	if (!data.v0)
+		return -1;
+	data.v1 = data.v0 + count;
+	data.v2 = data.v1 + count;
+	data.p = data.v2 + count;
+	data.v_out = data.p + count;
+	data.param = (a3real*)(data.v_out + count);
+	data.s_out = data.param + count;
+	a3benchmarkFillReal(*data.v0, count * 5 * 4, -a3real_one, a3real_one, &seed);
+	a3benchmarkFillReal(data.param, count, a3real_zero, a3real_one, &seed);
+
+	// no reference: each case measures a different function
+	a3benchmarkPrintHeader("vector");
+	for (i = 0; i < caseCount; ++i)
+	{
+		a3benchmarkRun(result + i, benchCase + i, &data, count, repeats);
+		a3benchmarkPrintResult(result + i, 0);
+	}
+
+	free(data.v0);
+	return caseCount;
+}
+
+
+//-----------------------------------------------------------------------------
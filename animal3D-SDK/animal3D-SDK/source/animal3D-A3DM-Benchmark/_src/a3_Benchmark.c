@@ -0,0 +1,291 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_Benchmark.c
+	Timing, repetition and reporting for benchmark cases.
+*/
+
+// sched_setaffinity
+#ifndef _WIN32
+#define _GNU_SOURCE
+#endif	// !_WIN32
+
+#include "../a3_Benchmark.h"
+
+#include "animal3D-A3DM/a3math/a3simd.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else	// !_WIN32
+#include <time.h>
+#include <sched.h>
+#endif	// _WIN32
+
+
+//-----------------------------------------------------------------------------
+
+// maximum timed repeats kept for median
+#define a3benchmarkInternal_maxRepeats	64
+
+// maximum results recorded for report
+#define a3benchmarkInternal_maxRecords	256
+
+// maximum report line length
+#define a3benchmarkInternal_maxLine		256
+
+// result with the suite it belongs to
+typedef struct a3_BenchmarkRecord
+{
+	a3byte const* suiteName;
+	a3_BenchmarkResult result;
+} a3_BenchmarkRecord;
+
+a3_BenchmarkRecord a3benchmarkInternalRecord[a3benchmarkInternal_maxRecords];
+a3count a3benchmarkInternalRecordCount;
+a3byte const* a3benchmarkInternalSuiteName;
+
+inline a3ui32 a3benchmarkInternalRandom(a3ui32* seed_inout)
+{
+	// xorshift32
+	a3ui32 x = *seed_inout;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	return (*seed_inout = x);
+}
+
+inline a3real a3benchmarkInternalRandomUnit(a3ui32* seed_inout)
+{
+	return (a3real)(a3benchmarkInternalRandom(seed_inout) >> 8) * (a3real)(1.0 / 16777216.0);
+}
+
+int a3benchmarkInternalCompare(void const* a, void const* b)
+{
+	a3f64 const da = *(a3f64 const*)a, db = *(a3f64 const*)b;
+	return (da > db) - (da < db);
+}
+
+// split report line in place: suite, case, best, median; false if not a row
+a3boolean a3benchmarkInternalParseRow(char* line, char** suite_out, char** case_out, a3f64* median_out)
+{
+	char* field[4];
+	a3index i;
+	if (line[0] == '#' || strncmp(line, "suite\t", 6) == 0)
+		return 0;
+	field[0] = line;
+	for (i = 1; i < 4; ++i)
+	{
+		field[i] = strchr(field[i - 1], '\t');
+		if (!field[i])
+			return 0;
+		*(field[i]++) = 0;
+	}
+	*suite_out = field[0];
+	*case_out = field[1];
+	*median_out = strtod(field[3], 0);
+	return (*median_out > 0.0);
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3f64 a3benchmarkTime()
+{
+#ifdef _WIN32
+	static a3f64 secondsPerCount = 0.0;
+	LARGE_INTEGER c;
+	if (secondsPerCount == 0.0)
+	{
+		QueryPerformanceFrequency(&c);
+		secondsPerCount = 1.0 / (a3f64)c.QuadPart;
+	}
+	QueryPerformanceCounter(&c);
+	return (a3f64)c.QuadPart * secondsPerCount;
+#else	// !_WIN32
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (a3f64)t.tv_sec + (a3f64)t.tv_nsec * 1.0e-9;
+#endif	// _WIN32
+}
+
+a3i32 a3benchmarkRun(a3_BenchmarkResult* result_out, a3_BenchmarkCase const* benchCase, void* data, a3count const count, a3count const repeats)
+{
+	if (result_out && benchCase && benchCase->func && count > 0 && repeats > 0)
+	{
+		a3f64 sample[a3benchmarkInternal_maxRepeats];
+		a3count const n = repeats < a3benchmarkInternal_maxRepeats ? repeats : a3benchmarkInternal_maxRepeats;
+		a3f64 t0;
+		a3index i;
+
+		// warm caches and branch predictors
+		benchCase->func(data, count);
+
+		for (i = 0; i < n; ++i)
+		{
+			t0 = a3benchmarkTime();
+			benchCase->func(data, count);
+			sample[i] = (a3benchmarkTime() - t0) * 1.0e9 / (a3f64)count;
+		}
+		qsort(sample, n, sizeof(*sample), a3benchmarkInternalCompare);
+
+		result_out->name = benchCase->name;
+		result_out->nsPerOpBest = sample[0];
+		result_out->nsPerOpMedian = sample[n / 2];
+		result_out->opsPerRepeat = count;
+		result_out->repeats = n;
+		return 1;
+	}
+	return -1;
+}
+
+void a3benchmarkPrintHeader(a3byte const* suiteName)
+{
+	a3benchmarkInternalSuiteName = suiteName;
+	printf("\n[%s]\n%-40s %12s %12s %10s\n", suiteName, "case", "best ns/op", "median ns/op", "speedup");
+}
+
+void a3benchmarkPrintResult(a3_BenchmarkResult const* result, a3_BenchmarkResult const* reference)
+{
+	if (result)
+	{
+		if (a3benchmarkInternalRecordCount < a3benchmarkInternal_maxRecords)
+		{
+			a3benchmarkInternalRecord[a3benchmarkInternalRecordCount].suiteName = a3benchmarkInternalSuiteName;
+			a3benchmarkInternalRecord[a3benchmarkInternalRecordCount].result = *result;
+			++a3benchmarkInternalRecordCount;
+		}
+		if (reference && result->nsPerOpMedian > 0.0)
+			printf("%-40s %12.3f %12.3f %9.2fx\n", result->name, result->nsPerOpBest, result->nsPerOpMedian,
+				reference->nsPerOpMedian / result->nsPerOpMedian);
+		else
+			printf("%-40s %12.3f %12.3f %10s\n", result->name, result->nsPerOpBest, result->nsPerOpMedian, "-");
+	}
+}
+
+a3i32 a3benchmarkPinThread(a3index const cpu)
+{
+#ifdef _WIN32
+	if (cpu < 8 * sizeof(DWORD_PTR) && SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cpu))
+	{
+		SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_HIGHEST);
+		return 1;
+	}
+#else	// !_WIN32
+	cpu_set_t set;
+	if (cpu < CPU_SETSIZE)
+	{
+		CPU_ZERO(&set);
+		CPU_SET(cpu, &set);
+		if (sched_setaffinity(0, sizeof(set), &set) == 0)
+			return 1;
+	}
+#endif	// _WIN32
+	return -1;
+}
+
+a3i32 a3benchmarkWriteReport(a3byte const* filePath, a3count const count, a3count const repeats)
+{
+	FILE* fp = filePath ? fopen((char const*)filePath, "w") : 0;
+	a3_BenchmarkRecord const* record;
+	a3index i;
+	if (fp)
+	{
+		fprintf(fp, "# animal3D A3DM benchmark report\n");
+		fprintf(fp, "# simd\t%s\n# ops\t%d\n# repeats\t%d\n", A3_SIMD_NAME, count, repeats);
+		fprintf(fp, "suite\tcase\tbest_ns\tmedian_ns\n");
+		for (i = 0, record = a3benchmarkInternalRecord; i < a3benchmarkInternalRecordCount; ++i, ++record)
+			fprintf(fp, "%s\t%s\t%.4f\t%.4f\n", record->suiteName, record->result.name,
+				record->result.nsPerOpBest, record->result.nsPerOpMedian);
+		fclose(fp);
+		return a3benchmarkInternalRecordCount;
+	}
+	return -1;
+}
+
+a3i32 a3benchmarkCompareBaseline(a3byte const* filePath, a3f64 const threshold)
+{
+	FILE* fp = filePath ? fopen((char const*)filePath, "r") : 0;
+	a3_BenchmarkRecord const* record;
+	char line[a3benchmarkInternal_maxLine], * suite, * name, * end;
+	a3f64 median, change;
+	a3i32 regressions = 0, matched = 0;
+	a3index i;
+	if (fp)
+	{
+		printf("\n[baseline: %s, threshold %.1f%%]\n%-61s %12s %12s %9s\n",
+			filePath, threshold * 100.0, "suite/case", "base ns/op", "median ns/op", "change");
+		while (fgets(line, sizeof(line), fp))
+		{
+			if ((end = strpbrk(line, "\r\n")) != 0)
+				*end = 0;
+			if (!a3benchmarkInternalParseRow(line, &suite, &name, &median))
+				continue;
+
+			// only cases run this time are compared
+			for (i = 0, record = a3benchmarkInternalRecord; i < a3benchmarkInternalRecordCount; ++i, ++record)
+				if (strcmp((char const*)record->suiteName, suite) == 0 && strcmp((char const*)record->result.name, name) == 0)
+				{
+					change = record->result.nsPerOpMedian / median - 1.0;
+					printf("%-20.20s %-40.40s %12.3f %12.3f %+8.1f%%%s\n", suite, name,
+						median, record->result.nsPerOpMedian, change * 100.0, change > threshold ? "  REGRESSION" : "");
+					regressions += (change > threshold);
+					++matched;
+					break;
+				}
+		}
+		fclose(fp);
+		printf("%d of %d cases compared; %d regression(s)\n", matched, a3benchmarkInternalRecordCount, regressions);
+		return regressions;
+	}
+	return -1;
+}
+
+void a3benchmarkFillReal(a3real* values_out, a3count const count, a3real const lo, a3real const hi, a3ui32* seed_inout)
+{
+	a3index i;
+	for (i = 0; i < count; ++i)
+		values_out[i] = lo + (hi - lo) * a3benchmarkInternalRandomUnit(seed_inout);
+}
+
+void a3benchmarkFillQuat(a3real4* values_out, a3count const count, a3ui32* seed_inout)
+{
+	a3real n;
+	a3index i, j;
+	for (i = 0; i < count; ++i)
+	{
+		// rejection sample inside unit 4-ball, then project onto sphere
+		do
+		{
+			for (j = 0; j < 4; ++j)
+				values_out[i][j] = a3real_two * a3benchmarkInternalRandomUnit(seed_inout) - a3real_one;
+			n = values_out[i][0] * values_out[i][0] + values_out[i][1] * values_out[i][1] + values_out[i][2] * values_out[i][2] + values_out[i][3] * values_out[i][3];
+		} while (n > a3real_one || n < (a3real)0.0001);
+		n = a3real_one / a3sqrt(n);
+		for (j = 0; j < 4; ++j)
+			values_out[i][j] *= n;
+	}
+}
+
+
+//-----------------------------------------------------------------------------
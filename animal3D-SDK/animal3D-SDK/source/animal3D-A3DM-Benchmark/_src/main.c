@@ -0,0 +1,137 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	main.c
+	A3DM benchmark entry point.
+
+	Usage: animal3D-A3DM-Benchmark [count] [repeats] [options]
+		-suite name			run only suites whose name contains 'name'
+		-cpu index			pin to logical CPU (default 0; -1 to not pin)
+		-report file		write tab-separated report of all results
+		-baseline file		compare against earlier report; exit code 1 if 
+								any case regressed
+		-threshold percent	slowdown flagged as regression (default 10)
+	Inputs use fixed seeds, so reports from the same build and machine 
+		are directly comparable.
+*/
+
+#include "../a3_Benchmark.h"
+
+#include "animal3D-A3DM/a3math/a3simd.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+//-----------------------------------------------------------------------------
+
+typedef a3i32(*a3_BenchmarkSuite)(a3count const count, a3count const repeats);
+
+typedef struct a3_BenchmarkSuiteEntry
+{
+	char const* name;
+	a3_BenchmarkSuite suite;
+} a3_BenchmarkSuiteEntry;
+
+
+//-----------------------------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+	a3_BenchmarkSuiteEntry const suite[] = {
+		{ "vector", a3benchmarkSuite_vector },
+		{ "matrix", a3benchmarkSuite_matrix },
+		{ "dualquaternion", a3benchmarkSuite_dualquaternion },
+		{ "interpolation", a3benchmarkSuite_interpolation },
+		{ "quaternion", a3benchmarkSuite_quaternion },
+		{ "trig", a3benchmarkSuite_trig },
+		{ "arclength", a3benchmarkSuite_arclength },
+		{ "random", a3benchmarkSuite_random },
+		{ "matrixstack", a3benchmarkSuite_matrixstack },
+		{ "inline", a3benchmarkSuite_inline },
+	};
+	a3count const suiteCount = sizeof(suite) / sizeof(*suite);
+	a3count count = 4096, repeats = 31;
+	a3i32 cpu = 0, regressions = 0, positional = 0;
+	a3f64 threshold = 0.1;
+	char const* suiteFilter = 0, * reportPath = 0, * baselinePath = 0;
+	a3real* trigTable;
+	a3index i;
+
+	for (i = 1; i < (a3index)argc; ++i)
+	{
+		if (argv[i][0] == '-' && i + 1 < (a3index)argc)
+		{
+			if (strcmp(argv[i], "-suite") == 0)
+				suiteFilter = argv[++i];
+			else if (strcmp(argv[i], "-cpu") == 0)
+				cpu = atoi(argv[++i]);
+			else if (strcmp(argv[i], "-report") == 0)
+				reportPath = argv[++i];
+			else if (strcmp(argv[i], "-baseline") == 0)
+				baselinePath = argv[++i];
+			else if (strcmp(argv[i], "-threshold") == 0)
+				threshold = atof(argv[++i]) * 0.01;
+			else
+			{
+				printf("unknown option '%s'\n", argv[i]);
+				return -1;
+			}
+		}
+		else if (positional++ == 0)
+			count = atoi(argv[i]);
+		else
+			repeats = atoi(argv[i]);
+	}
+
+	trigTable = (a3real*)malloc(a3trigInitSamplesRequired(a3benchmark_trigSamplesPerDegree) * sizeof(a3real));
+	if (!trigTable)
+		return -1;
+	a3trigInit(a3benchmark_trigSamplesPerDegree, trigTable);
+
+	printf("animal3D A3DM benchmark: %d ops x %d repeats, SIMD level %s\n", count, repeats, A3_SIMD_NAME);
+	if (cpu >= 0)
+		printf(a3benchmarkPinThread(cpu) > 0 ? "pinned to CPU %d\n" : "could not pin to CPU %d\n", cpu);
+
+	for (i = 0; i < suiteCount; ++i)
+		if (!suiteFilter || strstr(suite[i].name, suiteFilter))
+			suite[i].suite(count, repeats);
+
+	if (reportPath)
+	{
+		if (a3benchmarkWriteReport((a3byte const*)reportPath, count, repeats) >= 0)
+			printf("\nreport written to %s\n", reportPath);
+		else
+			printf("\ncould not write report to %s\n", reportPath);
+	}
+	if (baselinePath)
+	{
+		regressions = a3benchmarkCompareBaseline((a3byte const*)baselinePath, threshold);
+		if (regressions < 0)
+			printf("\ncould not read baseline %s\n", baselinePath);
+	}
+
+	free(trigTable);
+	return (regressions != 0);
+}
+
+
+//-----------------------------------------------------------------------------
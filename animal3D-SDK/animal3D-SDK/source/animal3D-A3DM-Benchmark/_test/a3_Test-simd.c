@@ -0,0 +1,455 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_Test-simd.c
+	Equivalence test of every a3simd.h function against the a3matrix.h
+		function it replaces, at the SIMD level this file is built with.
+
+	Usage: animal3D-A3DM-Test-simd [count]
+	Each function runs on 'count' inputs from fixed seeds (general
+		matrices, or the affine, rigid or uniformly scaled transforms the
+		function expects); in-place forms are also run with aliased
+		arguments. The reference affine inverse assumes orthogonal axes,
+		so sheared transforms are checked against the general inverse.
+		Largest error relative to max(1, |reference|) must stay within
+		the function's tolerance; transposes must match exactly. Exit code
+		is the number of functions that failed.
+*/
+
+// keep reference names; SIMD versions are called by their own names
+#define A3_SIMD_NO_OVERRIDE
+
+#include "../a3_Benchmark.h"
+
+#include "animal3D-A3DM/a3math/a3simd.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+//-----------------------------------------------------------------------------
+
+// inputs shared by all cases
+typedef struct a3_TestSimdData
+{
+	a3real4x4* general0;						// entries in [-1, 1)
+	a3real4x4* general1;
+	a3real4x4* affine;							// rotation, scale, translation
+	a3real4x4* sheared;							// affine with shear
+	a3real4x4* rigid;							// rotation, translation
+	a3real4x4* uniform;							// rotation, uniform scale, translation
+	a3real4* v;
+	a3count count;
+} a3_TestSimdData;
+
+// one function compared
+typedef struct a3_TestSimdCase
+{
+	a3byte const* name;
+	a3f64(*test)(a3_TestSimdData const* data);	// largest relative error
+	a3f64 tolerance;
+} a3_TestSimdCase;
+
+
+a3f64 a3testInternalError(a3real const* values, a3real const* reference, a3count const count, a3f64 error)
+{
+	a3f64 diff, scale;
+	a3index i;
+	for (i = 0; i < count; ++i)
+	{
+		diff = (a3f64)values[i] - (a3f64)reference[i];
+		diff = diff < 0.0 ? -diff : diff;
+		scale = reference[i] < a3real_zero ? -(a3f64)reference[i] : (a3f64)reference[i];
+		scale = scale > 1.0 ? scale : 1.0;
+		// NaN never passes
+		if (!(diff <= 0.0) && !(diff / scale < 1.0e30))
+			return 1.0e30;
+		error = diff / scale > error ? diff / scale : error;
+	}
+	return error;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3f64 a3testInternalProduct(a3_TestSimdData const* d)
+{
+	a3real4x4 ref, out;
+	a3f64 error = 0.0;
+	a3index i;
+	for (i = 0; i < d->count; ++i)
+	{
+		a3real4x4Product(ref, d->general0[i], d->general1[i]);
+		a3real4x4ProductSIMD(out, d->general0[i], d->general1[i]);
+		error = a3testInternalError(*out, *ref, 16, error);
+
+		// output aliases left, then right input
+		a3real4x4SetReal4x4(out, d->general0[i]);
+		a3real4x4ProductSIMD(out, out, d->general1[i]);
+		error = a3testInternalError(*out, *ref, 16, error);
+		a3real4x4SetReal4x4(out, d->general1[i]);
+		a3real4x4ProductSIMD(out, d->general0[i], out);
+		error = a3testInternalError(*out, *ref, 16, error);
+	}
+	return error;
+}
+
+a3f64 a3testInternalConcatL(a3_TestSimdData const* d)
+{
+	a3real4x4 ref, out;
+	a3f64 error = 0.0;
+	a3index i;
+	for (i = 0; i < d->count; ++i)
+	{
+		a3real4x4SetReal4x4(ref, d->general0[i]);
+		a3real4x4SetReal4x4(out, d->general0[i]);
+		a3real4x4ConcatL(ref, d->general1[i]);
+		a3real4x4ConcatLSIMD(out, d->general1[i]);
+		error = a3testInternalError(*out, *ref, 16, error);
+	}
+	return error;
+}
+
+a3f64 a3testInternalConcatR(a3_TestSimdData const* d)
+{
+	a3real4x4 ref, out;
+	a3f64 error = 0.0;
+	a3index i;
+	for (i = 0; i < d->count; ++i)
+	{
+		a3real4x4SetReal4x4(ref, d->general1[i]);
+		a3real4x4SetReal4x4(out, d->general1[i]);
+		a3real4x4ConcatR(d->general0[i], ref);
+		a3real4x4ConcatRSIMD(d->general0[i], out);
+		error = a3testInternalError(*out, *ref, 16, error);
+	}
+	return error;
+}
+
+a3f64 a3testInternalProductTransform(a3_TestSimdData const* d)
+{
+	a3real4x4 ref, out;
+	a3f64 error = 0.0;
+	a3index i;
+	for (i = 0; i < d->count; ++i)
+	{
+		a3real4x4ProductTransform(ref, d->sheared[i], d->rigid[i]);
+		a3real4x4ProductTransformSIMD(out, d->sheared[i], d->rigid[i]);
+		error = a3testInternalError(*out, *ref, 16, error);
+		a3real4x4SetReal4x4(out, d->sheared[i]);
+		a3real4x4ProductTransformSIMD(out, out, d->rigid[i]);
+		error = a3testInternalError(*out, *ref, 16, error);
+	}
+	return error;
+}
+
+a3f64 a3testInternalProductL(a3_TestSimdData const* d)
+{
+	a3real4 ref, out;
+	a3f64 error = 0.0;
+	a3index i;
+	for (i = 0; i < d->count; ++i)
+	{
+		a3real4Real4x4ProductL(ref, d->v[i], d->general0[i]);
+		a3real4Real4x4ProductLSIMD(out, d->v[i], d->general0[i]);
+		error = a3testInternalError(out, ref, 4, error);
+	}
+	return error;
+}
+
+a3f64 a3testInternalProductR(a3_TestSimdData const* d)
+{
+	a3real4 ref, out;
+	a3f64 error = 0.0;
+	a3index i;
+	for (i = 0; i < d->count; ++i)
+	{
+		a3real4Real4x4ProductR(ref, d->general0[i], d->v[i]);
+		a3real4Real4x4ProductRSIMD(out, d->general0[i], d->v[i]);
+		error = a3testInternalError(out, ref, 4, error);
+	}
+	return error;
+}
+
+a3f64 a3testInternalMulL(a3_TestSimdData const* d)
+{
+	a3real4 ref, out;
+	a3f64 error = 0.0;
+	a3index i;
+	for (i = 0; i < d->count; ++i)
+	{
+		a3real4SetReal4(ref, d->v[i]);
+		a3real4SetReal4(out, d->v[i]);
+		a3real4Real4x4MulL(ref, d->general0[i]);
+		a3real4Real4x4MulLSIMD(out, d->general0[i]);
+		error = a3testInternalError(out, ref, 4, error);
+	}
+	return error;
+}
+
+a3f64 a3testInternalMulR(a3_TestSimdData const* d)
+{
+	a3real4 ref, out;
+	a3f64 error = 0.0;
+	a3index i;
+	for (i = 0; i < d->count; ++i)
+	{
+		a3real4SetReal4(ref, d->v[i]);
+		a3real4SetReal4(out, d->v[i]);
+		a3real4Real4x4MulR(d->general0[i], ref);
+		a3real4Real4x4MulRSIMD(d->general0[i], out);
+		error = a3testInternalError(out, ref, 4, error);
+	}
+	return error;
+}
+
+a3f64 a3testInternalGetTransposed(a3_TestSimdData const* d)
+{
+	a3real4x4 ref, out;
+	a3f64 error = 0.0;
+	a3index i;
+	for (i = 0; i < d->count; ++i)
+	{
+		a3real4x4GetTransposed(ref, d->general0[i]);
+		a3real4x4GetTransposedSIMD(out, d->general0[i]);
+		error = a3testInternalError(*out, *ref, 16, error);
+		a3real4x4SetReal4x4(out, d->general0[i]);
+		a3real4x4GetTransposedSIMD(out, out);
+		error = a3testInternalError(*out, *ref, 16, error);
+	}
+	return error;
+}
+
+a3f64 a3testInternalTranspose(a3_TestSimdData const* d)
+{
+	a3real4x4 ref, out;
+	a3f64 error = 0.0;
+	a3index i;
+	for (i = 0; i < d->count; ++i)
+	{
+		a3real4x4SetReal4x4(ref, d->general0[i]);
+		a3real4x4SetReal4x4(out, d->general0[i]);
+		a3real4x4Transpose(ref);
+		a3real4x4TransposeSIMD(out);
+		error = a3testInternalError(*out, *ref, 16, error);
+	}
+	return error;
+}
+
+a3f64 a3testInternalDeterminant(a3_TestSimdData const* d)
+{
+	a3real ref, out;
+	a3f64 error = 0.0;
+	a3index i;
+	for (i = 0; i < d->count; ++i)
+	{
+		ref = a3real4x4Determinant(d->general0[i]);
+		out = a3real4x4DeterminantSIMD(d->general0[i]);
+		error = a3testInternalError(&out, &ref, 1, error);
+		ref = a3real4x4Determinant(d->sheared[i]);
+		out = a3real4x4DeterminantSIMD(d->sheared[i]);
+		error = a3testInternalError(&out, &ref, 1, error);
+	}
+	return error;
+}
+
+a3f64 a3testInternalTransformInverse(a3_TestSimdData const* d)
+{
+	a3real4x4 ref, out;
+	a3f64 error = 0.0;
+	a3index i;
+	for (i = 0; i < d->count; ++i)
+	{
+		a3real4x4TransformInverse(ref, d->affine[i]);
+		a3real4x4TransformInverseSIMD(out, d->affine[i]);
+		error = a3testInternalError(*out, *ref, 16, error);
+		a3real4x4SetReal4x4(out, d->affine[i]);
+		a3real4x4TransformInverseSIMD(out, out);
+		error = a3testInternalError(*out, *ref, 16, error);
+	}
+	return error;
+}
+
+a3f64 a3testInternalTransformInverseShear(a3_TestSimdData const* d)
+{
+	// reference assumes orthogonal axes; general inverse covers shear
+	a3real4x4 ref, out;
+	a3f64 error = 0.0;
+	a3index i;
+	for (i = 0; i < d->count; ++i)
+	{
+		a3real4x4GetInverse(ref, d->sheared[i]);
+		a3real4x4TransformInverseSIMD(out, d->sheared[i]);
+		error = a3testInternalError(*out, *ref, 16, error);
+	}
+	return error;
+}
+
+a3f64 a3testInternalTransformInverseIgnoreScale(a3_TestSimdData const* d)
+{
+	a3real4x4 ref, out;
+	a3f64 error = 0.0;
+	a3index i;
+	for (i = 0; i < d->count; ++i)
+	{
+		a3real4x4TransformInverseIgnoreScale(ref, d->rigid[i]);
+		a3real4x4TransformInverseIgnoreScaleSIMD(out, d->rigid[i]);
+		error = a3testInternalError(*out, *ref, 16, error);
+		a3real4x4SetReal4x4(out, d->rigid[i]);
+		a3real4x4TransformInverseIgnoreScaleSIMD(out, out);
+		error = a3testInternalError(*out, *ref, 16, error);
+	}
+	return error;
+}
+
+a3f64 a3testInternalTransformInverseUniformScale(a3_TestSimdData const* d)
+{
+	a3real4x4 ref, out;
+	a3f64 error = 0.0;
+	a3index i;
+	for (i = 0; i < d->count; ++i)
+	{
+		a3real4x4TransformInverseUniformScale(ref, d->uniform[i]);
+		a3real4x4TransformInverseUniformScaleSIMD(out, d->uniform[i]);
+		error = a3testInternalError(*out, *ref, 16, error);
+		a3real4x4SetReal4x4(out, d->uniform[i]);
+		a3real4x4TransformInverseUniformScaleSIMD(out, out);
+		error = a3testInternalError(*out, *ref, 16, error);
+	}
+	return error;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3i32 a3testInternalSupported()
+{
+	// built for a level the machine may not run
+#if (defined __GNUC__ && (defined __x86_64__ || defined __i386__))
+#if (A3_SIMD >= A3_SIMD_AVX2)
+	return __builtin_cpu_supports("avx2");
+#elif (A3_SIMD >= A3_SIMD_SSE41)
+	return __builtin_cpu_supports("sse4.1");
+#endif	// A3_SIMD
+#endif	// __GNUC__ && x86
+	return 1;
+}
+
+int main(int argc, char** argv)
+{
+	// products and vector transforms round like the reference;
+	//	determinant and inverses add a few more steps
+	a3_TestSimdCase const testCase[] = {
+		{ "a3real4x4Product", a3testInternalProduct, 1.0e-5 },
+		{ "a3real4x4ConcatL", a3testInternalConcatL, 1.0e-5 },
+		{ "a3real4x4ConcatR", a3testInternalConcatR, 1.0e-5 },
+		{ "a3real4x4ProductTransform", a3testInternalProductTransform, 1.0e-5 },
+		{ "a3real4Real4x4ProductL", a3testInternalProductL, 1.0e-5 },
+		{ "a3real4Real4x4ProductR", a3testInternalProductR, 1.0e-5 },
+		{ "a3real4Real4x4MulL", a3testInternalMulL, 1.0e-5 },
+		{ "a3real4Real4x4MulR", a3testInternalMulR, 1.0e-5 },
+		{ "a3real4x4GetTransposed", a3testInternalGetTransposed, 0.0 },
+		{ "a3real4x4Transpose", a3testInternalTranspose, 0.0 },
+		{ "a3real4x4Determinant", a3testInternalDeterminant, 1.0e-4 },
+		{ "a3real4x4TransformInverse", a3testInternalTransformInverse, 1.0e-4 },
+		{ "a3real4x4TransformInverse (shear)", a3testInternalTransformInverseShear, 1.0e-4 },
+		{ "a3real4x4TransformInverseIgnoreScale", a3testInternalTransformInverseIgnoreScale, 1.0e-5 },
+		{ "a3real4x4TransformInverseUniformScale", a3testInternalTransformInverseUniformScale, 1.0e-5 },
+	};
+	a3count const caseCount = sizeof(testCase) / sizeof(*testCase);
+	a3_TestSimdData data;
+	a3real* trigTable, * param;
+	a3ui32 seed = 0x0a3d0051;
+	a3i32 failed = 0;
+	a3f64 error;
+	a3count count = argc > 1 ? atoi(argv[1]) : 10000;
+	a3index i;
+
+	printf("animal3D A3DM SIMD test: %d inputs, SIMD level %s\n", count, A3_SIMD_NAME);
+	if (!a3testInternalSupported())
+	{
+		printf("  skipped: level not supported by this CPU\n");
+		return 0;
+	}
+	if (count <= 0)
+		return -1;
+
+	trigTable = (a3real*)malloc(a3trigInitSamplesRequired(a3benchmark_trigSamplesPerDegree) * sizeof(a3real));
+	data.general0 = (a3real4x4*)malloc(count * (6 * sizeof(a3real4x4) + sizeof(a3real4) + 10 * sizeof(a3real)));
+	if (!trigTable || !data.general0)
+		return -1;
+	a3trigInit(a3benchmark_trigSamplesPerDegree, trigTable);
+	data.general1 = data.general0 + count;
+	data.affine = data.general1 + count;
+	data.rigid = data.affine + count;
+	data.uniform = data.rigid + count;
+	data.sheared = data.uniform + count;
+	data.v = (a3real4*)(data.sheared + count);
+	data.count = count;
+	param = (a3real*)(data.v + count);
+
+	// params per input: three angles, three scales, translation, shear
+	a3benchmarkFillReal(**data.general0, count * 32, -a3real_one, a3real_one, &seed);
+	a3benchmarkFillReal(*data.v, count * 4, -a3real_one, a3real_one, &seed);
+	a3benchmarkFillReal(param, count * 3, (a3real)-180, (a3real)+180, &seed);
+	a3benchmarkFillReal(param + count * 3, count * 3, a3real_half, a3real_two, &seed);
+	a3benchmarkFillReal(param + count * 6, count * 3, (a3real)-10, (a3real)+10, &seed);
+	a3benchmarkFillReal(param + count * 9, count, (a3real)-0.5, (a3real)+0.5, &seed);
+	for (i = 0; i < count; ++i)
+	{
+		a3real const* const angle = param + i * 3, * const scale = param + (count + i) * 3;
+		a3real const* const translate = param + (count * 2 + i) * 3, shear = param[count * 9 + i];
+
+		a3real4x4SetRotateXYZ(data.rigid[i], angle[0], angle[1], angle[2]);
+		a3real3SetReal3(data.rigid[i][3], translate);
+
+		a3real4x4SetReal4x4(data.uniform[i], data.rigid[i]);
+		a3real3MulS(data.uniform[i][0], scale[0]);
+		a3real3MulS(data.uniform[i][1], scale[0]);
+		a3real3MulS(data.uniform[i][2], scale[0]);
+
+		a3real4x4SetReal4x4(data.affine[i], data.rigid[i]);
+		a3real3MulS(data.affine[i][0], scale[0]);
+		a3real3MulS(data.affine[i][1], scale[1]);
+		a3real3MulS(data.affine[i][2], scale[2]);
+
+		a3real4x4SetReal4x4(data.sheared[i], data.affine[i]);
+		a3real3Add(data.sheared[i][1], a3real3ProductS(data.sheared[i][3], data.sheared[i][0], shear));
+		a3real3SetReal3(data.sheared[i][3], translate);
+	}
+
+	for (i = 0; i < caseCount; ++i)
+	{
+		error = testCase[i].test(&data);
+		if (error > testCase[i].tolerance)
+			++failed;
+		printf("  %-40s  error %.3e  tolerance %.1e  %s\n", testCase[i].name, error, testCase[i].tolerance,
+			error > testCase[i].tolerance ? "FAILED" : "ok");
+	}
+	printf("%d of %d functions failed\n", failed, caseCount);
+
+	free(data.general0);
+	free(trigTable);
+	return failed;
+}
+
+
+//-----------------------------------------------------------------------------
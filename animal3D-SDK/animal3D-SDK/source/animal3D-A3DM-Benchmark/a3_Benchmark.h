@@ -0,0 +1,134 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_Benchmark.h
+	Throughput measurement for A3DM functions.
+
+	Every result printed is also recorded, so a run can be written as a 
+		tab-separated report and compared against an earlier report used as 
+		baseline; cases slower than the baseline by more than a threshold 
+		are flagged as regressions.
+*/
+
+#ifndef __ANIMAL3D_BENCHMARK_H
+#define __ANIMAL3D_BENCHMARK_H
+
+
+#include "animal3D-A3DM/animal3D-A3DM.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef struct a3_BenchmarkCase		a3_BenchmarkCase;
+	typedef struct a3_BenchmarkResult	a3_BenchmarkResult;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// trig table resolution used by the demo; tables are initialized once 
+	//	before any suite runs, since several A3DM functions sample them
+#define a3benchmark_trigSamplesPerDegree	4
+
+	// function under test: performs 'count' operations on suite data
+	typedef void(*a3_BenchmarkFunc)(void* data, a3count count);
+
+	// named case
+	struct a3_BenchmarkCase
+	{
+		a3byte const* name;						// display name
+		a3_BenchmarkFunc func;					// operation loop
+	};
+
+	// measurement of one case
+	struct a3_BenchmarkResult
+	{
+		a3byte const* name;						// display name (from case)
+		a3f64 nsPerOpBest;						// fastest repeat
+		a3f64 nsPerOpMedian;					// median repeat
+		a3count opsPerRepeat;					// operations per repeat
+		a3count repeats;						// number of timed repeats
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// high-resolution time in seconds from arbitrary origin
+	a3f64 a3benchmarkTime();
+
+	// run case: one untimed warm-up, then 'repeats' timed calls of 'count' operations
+	a3i32 a3benchmarkRun(a3_BenchmarkResult* result_out, a3_BenchmarkCase const* benchCase, void* data, a3count const count, a3count const repeats);
+
+	// print header for result table; results that follow belong to suite
+	void a3benchmarkPrintHeader(a3byte const* suiteName);
+
+	// print one result row and record it for report; speedup is relative 
+	//	to reference if provided
+	void a3benchmarkPrintResult(a3_BenchmarkResult const* result, a3_BenchmarkResult const* reference);
+
+	// pin calling thread to one logical CPU to reduce migration noise
+	//	return: 1 if pinned, -1 if not supported or failed
+	a3i32 a3benchmarkPinThread(a3index const cpu);
+
+	// write all results recorded so far as tab-separated report
+	//	return: number of results written, -1 if file could not be opened
+	a3i32 a3benchmarkWriteReport(a3byte const* filePath, a3count const count, a3count const repeats);
+
+	// compare recorded results against baseline report by median ns/op; 
+	//	prints comparison table
+	//	param threshold: relative slowdown flagged (e.g. 0.1 for 10%)
+	//	return: number of regressions, -1 if file could not be opened
+	a3i32 a3benchmarkCompareBaseline(a3byte const* filePath, a3f64 const threshold);
+
+	// fill buffer with uniform values in [lo, hi) from fixed seed
+	void a3benchmarkFillReal(a3real* values_out, a3count const count, a3real const lo, a3real const hi, a3ui32* seed_inout);
+
+	// fill buffer with random unit quaternions from fixed seed
+	void a3benchmarkFillQuat(a3real4* values_out, a3count const count, a3ui32* seed_inout);
+
+
+//-----------------------------------------------------------------------------
+
+	// suites: return number of cases run or -1 on failure
+	a3i32 a3benchmarkSuite_quaternion(a3count const count, a3count const repeats);
+	a3i32 a3benchmarkSuite_trig(a3count const count, a3count const repeats);
+	a3i32 a3benchmarkSuite_arclength(a3count const count, a3count const repeats);
+	a3i32 a3benchmarkSuite_random(a3count const count, a3count const repeats);
+	a3i32 a3benchmarkSuite_matrixstack(a3count const count, a3count const repeats);
+	a3i32 a3benchmarkSuite_inline(a3count const count, a3count const repeats);
+	a3i32 a3benchmarkSuite_vector(a3count const count, a3count const repeats);
+	a3i32 a3benchmarkSuite_matrix(a3count const count, a3count const repeats);
+	a3i32 a3benchmarkSuite_dualquaternion(a3count const count, a3count const repeats);
+	a3i32 a3benchmarkSuite_interpolation(a3count const count, a3count const repeats);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_BENCHMARK_H
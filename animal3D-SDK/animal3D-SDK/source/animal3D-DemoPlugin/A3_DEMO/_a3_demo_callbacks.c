@@ -34,6 +34,7 @@
 
 #include "_a3_demo_utilities/a3_DemoMacros.h"
 #include "_a3_demo_utilities/a3_DemoRenderUtils.h"
+#include "_a3_demo_utilities/a3_DemoMemory.h"
 
 
 #include <stdio.h>
@@ -100,6 +101,7 @@ void a3demo_render(a3_DemoState const* demoState, a3f64 const dt);
 void a3demo_loadGeometry(a3_DemoState* demoState);
 void a3demo_loadShaders(a3_DemoState* demoState);
 void a3demo_loadTextures(a3_DemoState* demoState);
+void a3demo_loadSprites(a3_DemoState* demoState);
 void a3demo_loadFramebuffers(a3_DemoState* demoState);
 void a3demo_loadValidate(a3_DemoState* demoState);
 
@@ -107,6 +109,7 @@ void a3demo_loadValidate(a3_DemoState* demoState);
 void a3demo_unloadGeometry(a3_DemoState* demoState);
 void a3demo_unloadShaders(a3_DemoState* demoState);
 void a3demo_unloadTextures(a3_DemoState* demoState);
+void a3demo_unloadSprites(a3_DemoState* demoState);
 void a3demo_unloadFramebuffers(a3_DemoState* demoState);
 void a3demo_unloadValidate(a3_DemoState const* demoState);
 
@@ -134,6 +137,9 @@ void a3demo_load(a3_DemoState* demoState)
 	// textures
 	a3demo_loadTextures(demoState);
 
+	// sprites
+	a3demo_loadSprites(demoState);
+
 
 	// set flags
 	demoState->displayGrid = a3true;
@@ -141,11 +147,14 @@ void a3demo_load(a3_DemoState* demoState)
 	demoState->displayObjectAxes = a3true;
 	demoState->displayTangentBases = a3false;
 	demoState->displayWireframe = a3false;
+	demoState->displaySprites = a3true;
 	demoState->displaySkybox = a3true;
 	demoState->displayHiddenVolumes = a3true;
 	demoState->updateAnimation = a3true;
 	demoState->stencilTest = a3false;
 	demoState->skipIntermediatePasses = a3false;
+	demoState->cullMeshlets = a3true;
+	demoState->morphTeapot = a3false;
 
 
 	// demo modes
@@ -158,6 +167,7 @@ void a3demo_unload(a3_DemoState* demoState)
 {
 	a3demo_unloadGeometry(demoState);
 	a3demo_unloadShaders(demoState);
+	a3demo_unloadSprites(demoState);
 	a3demo_unloadTextures(demoState);
 	a3demo_unloadFramebuffers(demoState);
 }
@@ -249,6 +259,10 @@ A3DYLIBSYMBOL a3_DemoState *a3demoCB_load(a3_DemoState *demoState, a3boolean hot
 		// enable asset streaming between loads
 		//demoState->streaming = a3true;
 
+		// pack vertex attributes on load
+		//	(less vertex memory, reduced precision)
+		//demoState->packing = a3true;
+
 
 		// create directory for data
 		a3fileStreamMakeDirectory("./data");
@@ -324,6 +338,7 @@ A3DYLIBSYMBOL a3i32 a3demoCB_idle(a3_DemoState *demoState)
 		{
 			// render timer ticked, update demo state and draw
 			a3f64 const dt = demoState->timer_display->secondsPerTick;
+			a3_DemoMemoryCounters const heap = *a3demo_getMemoryCounters();
 
 			// track updates
 			if (demoState->timer->totalTime > 2.0)
@@ -332,6 +347,10 @@ A3DYLIBSYMBOL a3i32 a3demoCB_idle(a3_DemoState *demoState)
 				demoState->dt_timer = demoState->timer_display->totalTime - demoState->t_timer;
 				demoState->dt_timer_tot += demoState->dt_timer;
 				demoState->t_timer = demoState->timer_display->totalTime;
+				a3streamStatsAdd(demoState->dt_timer_stats, demoState->dt_timer);
+				a3streamQuantileAdd(demoState->dt_timer_quantile + 0, demoState->dt_timer);
+				a3streamQuantileAdd(demoState->dt_timer_quantile + 1, demoState->dt_timer);
+				a3streamQuantileAdd(demoState->dt_timer_quantile + 2, demoState->dt_timer);
 			}
 			else
 			{
@@ -339,6 +358,10 @@ A3DYLIBSYMBOL a3i32 a3demoCB_idle(a3_DemoState *demoState)
 				demoState->dt_timer = demoState->timer_display->totalTime;
 				demoState->dt_timer_tot = 0.0;
 				demoState->t_timer = demoState->timer_display->totalTime;
+				a3streamStatsInit(demoState->dt_timer_stats);
+				a3streamQuantileInit(demoState->dt_timer_quantile + 0, 0.50);
+				a3streamQuantileInit(demoState->dt_timer_quantile + 1, 0.95);
+				a3streamQuantileInit(demoState->dt_timer_quantile + 2, 0.99);
 			}
 
 			// main idle loop
@@ -346,6 +369,11 @@ A3DYLIBSYMBOL a3i32 a3demoCB_idle(a3_DemoState *demoState)
 			a3demo_update(demoState, dt);
 			a3demo_render(demoState, dt);
 
+			// steady-state frames should not touch the heap
+			demoState->n_heap_frame = a3demo_getMemoryCallsSince(&heap);
+			if (demoState->n_heap_frame)
+				++demoState->n_heap_frames;
+
 			// update input
 			a3mouseUpdate(demoState->mouse);
 			a3keyboardUpdate(demoState->keyboard);
@@ -0,0 +1,291 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoSceneObject.inl
+	Fused matrix stack inline definitions.
+*/
+
+#ifdef __ANIMAL3D_DEMOSCENEOBJECT_H
+#ifndef __ANIMAL3D_DEMOSCENEOBJECT_INL
+#define __ANIMAL3D_DEMOSCENEOBJECT_INL
+
+
+//-----------------------------------------------------------------------------
+// MATRIX STACK UTILITIES
+
+// relative tolerance for transform type detection (squared lengths and dots)
+#define a3demo_transformTypeTolerance_internal	((a3real)1.0e-4)
+
+// inverse-transpose of 3x3 part of uniform-scale transform: basis over
+//	squared scale; translation and bottom row zero, as from
+//	a3demo_quickTransposedZeroBottomRow
+inline a3real4x4r a3demo_quickScaledZeroBottomRow_internal(a3real4x4p m_out, const a3real4x4p m_in, const a3real s)
+{
+	m_out[0][0] = m_in[0][0] * s;	m_out[0][1] = m_in[0][1] * s;	m_out[0][2] = m_in[0][2] * s;	m_out[0][3] = a3real_zero;
+	m_out[1][0] = m_in[1][0] * s;	m_out[1][1] = m_in[1][1] * s;	m_out[1][2] = m_in[1][2] * s;	m_out[1][3] = a3real_zero;
+	m_out[2][0] = m_in[2][0] * s;	m_out[2][1] = m_in[2][1] * s;	m_out[2][2] = m_in[2][2] * s;	m_out[2][3] = a3real_zero;
+	m_out[3][0] = m_out[3][1] = m_out[3][2] = m_out[3][3] = a3real_zero;
+	return m_out;
+}
+
+// transposed 3x3 part of general inverse; same as
+//	a3demo_quickTransposedZeroBottomRow without the render utilities
+inline a3real4x4r a3demo_quickTransposedZeroBottomRow_internal(a3real4x4p m_out, const a3real4x4p m_in)
+{
+	m_out[0][0] = m_in[0][0];	m_out[0][1] = m_in[1][0];	m_out[0][2] = m_in[2][0];	m_out[0][3] = a3real_zero;
+	m_out[1][0] = m_in[0][1];	m_out[1][1] = m_in[1][1];	m_out[1][2] = m_in[2][1];	m_out[1][3] = a3real_zero;
+	m_out[2][0] = m_in[0][2];	m_out[2][1] = m_in[1][2];	m_out[2][2] = m_in[2][2];	m_out[2][3] = a3real_zero;
+	m_out[3][0] = m_out[3][1] = m_out[3][2] = m_out[3][3] = a3real_zero;
+	return m_out;
+}
+
+#if (A3_SIMD >= A3_SIMD_SSE2)
+// store inverse and inverse-transpose of affine transform given columns 
+//	of both 3x3 parts and translation of the original; returns translation 
+//	column of inverse
+inline __m128 a3demo_storeInverse_internal(a3real4x4p inv_out, a3real4x4p invT_out, __m128 const i0, __m128 const i1, __m128 const i2, __m128 const t0, __m128 const t1, __m128 const t2, __m128 const t)
+{
+	__m128 const i3 = _mm_sub_ps(_mm_set_ps(a3real_one, a3real_zero, a3real_zero, a3real_zero), _mm_add_ps(_mm_add_ps(
+		_mm_mul_ps(i0, _mm_shuffle_ps(t, t, 0x00)), _mm_mul_ps(i1, _mm_shuffle_ps(t, t, 0x55))), _mm_mul_ps(i2, _mm_shuffle_ps(t, t, 0xAA))));
+	_mm_storeu_ps(inv_out[0], i0);
+	_mm_storeu_ps(inv_out[1], i1);
+	_mm_storeu_ps(inv_out[2], i2);
+	_mm_storeu_ps(inv_out[3], i3);
+	_mm_storeu_ps(invT_out[0], t0);
+	_mm_storeu_ps(invT_out[1], t1);
+	_mm_storeu_ps(invT_out[2], t2);
+	_mm_storeu_ps(invT_out[3], _mm_setzero_ps());
+	return i3;
+}
+
+// cross product of 3D parts; w is zero if inputs' w are zero
+inline __m128 a3demo_cross_internal(__m128 const a, __m128 const b)
+{
+	__m128 const c = _mm_sub_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, 0xC9)), _mm_mul_ps(_mm_shuffle_ps(a, a, 0xC9), b));
+	return _mm_shuffle_ps(c, c, 0xC9);
+}
+#endif	// A3_SIMD
+
+// fused stack update; if the viewer is rigid, model-view has the same type 
+//	and scale as model
+inline void a3demo_updateModelMatrixStackFused_internal(a3_DemoModelMatrixStack* model, a3real4x4p const projectionMat_viewer, a3real4x4p const modelMat_viewer, a3real4x4p const modelMatInv_viewer, a3boolean const viewerRigid, a3real4x4p const modelMat, a3real4x4p const atlasMat)
+{
+#if (A3_SIMD >= A3_SIMD_SSE2)
+	// everything stays in registers: model-view is not reloaded, and the 
+	//	transpose used to detect the type is the rigid inverse
+	__m128 const mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+	__m128 const m0 = _mm_and_ps(_mm_loadu_ps(modelMat[0]), mask), m1 = _mm_and_ps(_mm_loadu_ps(modelMat[1]), mask), m2 = _mm_and_ps(_mm_loadu_ps(modelMat[2]), mask), m3 = _mm_loadu_ps(modelMat[3]);
+	__m128 v0 = _mm_loadu_ps(modelMatInv_viewer[0]), v1 = _mm_loadu_ps(modelMatInv_viewer[1]), v2 = _mm_loadu_ps(modelMatInv_viewer[2]), v3 = _mm_loadu_ps(modelMatInv_viewer[3]);
+	__m128 const p0 = _mm_loadu_ps(projectionMat_viewer[0]), p1 = _mm_loadu_ps(projectionMat_viewer[1]), p2 = _mm_loadu_ps(projectionMat_viewer[2]), p3 = _mm_loadu_ps(projectionMat_viewer[3]);
+	__m128 r0 = m0, r1 = m1, r2 = m2, r3 = _mm_setzero_ps();
+	__m128 mv0, mv1, mv2, mv3, c0, c1, c2, d, sq, s, t;
+	a3real4* out;
+
+	// model-view and model-view-projection
+	mv0 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(v0, _mm_shuffle_ps(m0, m0, 0x00)), _mm_mul_ps(v1, _mm_shuffle_ps(m0, m0, 0x55))), _mm_mul_ps(v2, _mm_shuffle_ps(m0, m0, 0xAA)));
+	mv1 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(v0, _mm_shuffle_ps(m1, m1, 0x00)), _mm_mul_ps(v1, _mm_shuffle_ps(m1, m1, 0x55))), _mm_mul_ps(v2, _mm_shuffle_ps(m1, m1, 0xAA)));
+	mv2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(v0, _mm_shuffle_ps(m2, m2, 0x00)), _mm_mul_ps(v1, _mm_shuffle_ps(m2, m2, 0x55))), _mm_mul_ps(v2, _mm_shuffle_ps(m2, m2, 0xAA)));
+	mv3 = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(v0, _mm_shuffle_ps(m3, m3, 0x00)), _mm_mul_ps(v1, _mm_shuffle_ps(m3, m3, 0x55))), _mm_mul_ps(v2, _mm_shuffle_ps(m3, m3, 0xAA))), v3);
+	out = model->modelViewProjectionMat.m;
+	_mm_storeu_ps(out[0], _mm_add_ps(_mm_add_ps(_mm_mul_ps(p0, _mm_shuffle_ps(mv0, mv0, 0x00)), _mm_mul_ps(p1, _mm_shuffle_ps(mv0, mv0, 0x55))), _mm_mul_ps(p2, _mm_shuffle_ps(mv0, mv0, 0xAA))));
+	_mm_storeu_ps(out[1], _mm_add_ps(_mm_add_ps(_mm_mul_ps(p0, _mm_shuffle_ps(mv1, mv1, 0x00)), _mm_mul_ps(p1, _mm_shuffle_ps(mv1, mv1, 0x55))), _mm_mul_ps(p2, _mm_shuffle_ps(mv1, mv1, 0xAA))));
+	_mm_storeu_ps(out[2], _mm_add_ps(_mm_add_ps(_mm_mul_ps(p0, _mm_shuffle_ps(mv2, mv2, 0x00)), _mm_mul_ps(p1, _mm_shuffle_ps(mv2, mv2, 0x55))), _mm_mul_ps(p2, _mm_shuffle_ps(mv2, mv2, 0xAA))));
+	_mm_storeu_ps(out[3], _mm_add_ps(_mm_add_ps(_mm_mul_ps(p0, _mm_shuffle_ps(mv3, mv3, 0x00)), _mm_mul_ps(p1, _mm_shuffle_ps(mv3, mv3, 0x55))), _mm_add_ps(_mm_mul_ps(p2, _mm_shuffle_ps(mv3, mv3, 0xAA)), p3)));
+	out = model->modelViewMat.m;
+	_mm_storeu_ps(out[0], mv0);
+	_mm_storeu_ps(out[1], mv1);
+	_mm_storeu_ps(out[2], mv2);
+	_mm_storeu_ps(out[3], mv3);
+	out = model->modelMat.m;
+	_mm_storeu_ps(out[0], m0);
+	_mm_storeu_ps(out[1], m1);
+	_mm_storeu_ps(out[2], m2);
+	_mm_storeu_ps(out[3], m3);
+	out = model->atlasMat.m;
+	_mm_storeu_ps(out[0], _mm_loadu_ps(atlasMat[0]));
+	_mm_storeu_ps(out[1], _mm_loadu_ps(atlasMat[1]));
+	_mm_storeu_ps(out[2], _mm_loadu_ps(atlasMat[2]));
+	_mm_storeu_ps(out[3], _mm_loadu_ps(atlasMat[3]));
+
+	// type from rows of 3x3 part: lanes of squares give (xx, yy, zz), 
+	//	lanes of rotated products give (x.y, y.z, z.x)
+	_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+	sq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, r0), _mm_mul_ps(r1, r1)), _mm_mul_ps(r2, r2));
+	d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, _mm_shuffle_ps(r0, r0, 0xC9)), _mm_mul_ps(r1, _mm_shuffle_ps(r1, r1, 0xC9))), _mm_mul_ps(r2, _mm_shuffle_ps(r2, r2, 0xC9)));
+	s = _mm_shuffle_ps(sq, sq, 0x00);
+	t = _mm_mul_ps(s, _mm_set1_ps(a3demo_transformTypeTolerance_internal));
+	sq = _mm_sub_ps(sq, s);
+	if (!(_mm_movemask_ps(_mm_or_ps(
+		_mm_or_ps(_mm_cmpgt_ps(sq, t), _mm_cmplt_ps(sq, _mm_sub_ps(_mm_setzero_ps(), t))),
+		_mm_or_ps(_mm_cmpgt_ps(d, t), _mm_cmplt_ps(d, _mm_sub_ps(_mm_setzero_ps(), t))))) & 0x7) && _mm_cvtss_f32(s) > a3real_zero)
+	{
+		// rigid or uniform scale: inverse is transpose over squared scale, 
+		//	inverse-transpose is the basis over squared scale
+		s = _mm_div_ps(_mm_set1_ps(a3real_one), s);
+		r0 = _mm_mul_ps(r0, s);
+		r1 = _mm_mul_ps(r1, s);
+		r2 = _mm_mul_ps(r2, s);
+		r3 = a3demo_storeInverse_internal(model->modelMatInverse.m, model->modelMatInverseTranspose.m,
+			r0, r1, r2, _mm_mul_ps(m0, s), _mm_mul_ps(m1, s), _mm_mul_ps(m2, s), m3);
+		if (viewerRigid)
+		{
+			c0 = _mm_and_ps(mv0, mask);
+			c1 = _mm_and_ps(mv1, mask);
+			c2 = _mm_and_ps(mv2, mask);
+			r0 = c0;
+			r1 = c1;
+			r2 = c2;
+			r3 = _mm_setzero_ps();
+			_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+			a3demo_storeInverse_internal(model->modelViewMatInverse.m, model->modelViewMatInverseTranspose.m,
+				_mm_mul_ps(r0, s), _mm_mul_ps(r1, s), _mm_mul_ps(r2, s), _mm_mul_ps(c0, s), _mm_mul_ps(c1, s), _mm_mul_ps(c2, s), mv3);
+			return;
+		}
+	}
+	else
+	{
+		// general: rows of inverse are cofactors over determinant
+		c0 = a3demo_cross_internal(m1, m2);
+		c1 = a3demo_cross_internal(m2, m0);
+		c2 = a3demo_cross_internal(m0, m1);
+		d = _mm_mul_ps(m0, c0);
+		d = _mm_add_ps(_mm_add_ps(_mm_shuffle_ps(d, d, 0x00), _mm_shuffle_ps(d, d, 0x55)), _mm_shuffle_ps(d, d, 0xAA));
+		d = _mm_cvtss_f32(d) != a3real_zero ? _mm_div_ps(_mm_set1_ps(a3real_one), d) : _mm_setzero_ps();
+		c0 = _mm_mul_ps(c0, d);
+		c1 = _mm_mul_ps(c1, d);
+		c2 = _mm_mul_ps(c2, d);
+		r0 = c0;
+		r1 = c1;
+		r2 = c2;
+		r3 = _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+		r3 = a3demo_storeInverse_internal(model->modelMatInverse.m, model->modelMatInverseTranspose.m,
+			r0, r1, r2, c0, c1, c2, m3);
+	}
+
+	// general model or viewer: model-view inverse is model inverse times 
+	//	viewer, computed from the inverse still in registers
+	v0 = _mm_loadu_ps(modelMat_viewer[0]);
+	v1 = _mm_loadu_ps(modelMat_viewer[1]);
+	v2 = _mm_loadu_ps(modelMat_viewer[2]);
+	v3 = _mm_loadu_ps(modelMat_viewer[3]);
+	c0 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, _mm_shuffle_ps(v0, v0, 0x00)), _mm_mul_ps(r1, _mm_shuffle_ps(v0, v0, 0x55))), _mm_mul_ps(r2, _mm_shuffle_ps(v0, v0, 0xAA)));
+	c1 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, _mm_shuffle_ps(v1, v1, 0x00)), _mm_mul_ps(r1, _mm_shuffle_ps(v1, v1, 0x55))), _mm_mul_ps(r2, _mm_shuffle_ps(v1, v1, 0xAA)));
+	c2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, _mm_shuffle_ps(v2, v2, 0x00)), _mm_mul_ps(r1, _mm_shuffle_ps(v2, v2, 0x55))), _mm_mul_ps(r2, _mm_shuffle_ps(v2, v2, 0xAA)));
+	t = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, _mm_shuffle_ps(v3, v3, 0x00)), _mm_mul_ps(r1, _mm_shuffle_ps(v3, v3, 0x55))), _mm_mul_ps(r2, _mm_shuffle_ps(v3, v3, 0xAA))), r3);
+	out = model->modelViewMatInverse.m;
+	_mm_storeu_ps(out[0], c0);
+	_mm_storeu_ps(out[1], c1);
+	_mm_storeu_ps(out[2], c2);
+	_mm_storeu_ps(out[3], t);
+	r3 = _mm_setzero_ps();
+	_MM_TRANSPOSE4_PS(c0, c1, c2, r3);
+	out = model->modelViewMatInverseTranspose.m;
+	_mm_storeu_ps(out[0], c0);
+	_mm_storeu_ps(out[1], c1);
+	_mm_storeu_ps(out[2], c2);
+	_mm_storeu_ps(out[3], _mm_setzero_ps());
+#else	// !A3_SIMD
+	a3real s;
+	a3_DemoTransformType const type = a3demo_getTransformType(modelMat, &s);
+
+	a3real4x4SetReal4x4(model->modelMat.m, modelMat);
+	a3real4x4ProductTransform(model->modelViewMat.m, modelMatInv_viewer, modelMat);
+	a3real4x4Product(model->modelViewProjectionMat.m, projectionMat_viewer, model->modelViewMat.m);
+	a3real4x4SetReal4x4(model->atlasMat.m, atlasMat);
+
+	if (type != demoTransform_general)
+	{
+		// inverse is transpose over squared scale
+		a3real4x4TransformInverseUniformScale(model->modelMatInverse.m, modelMat);
+		a3demo_quickScaledZeroBottomRow_internal(model->modelMatInverseTranspose.m, modelMat, s);
+		if (viewerRigid)
+		{
+			a3real4x4TransformInverseUniformScale(model->modelViewMatInverse.m, model->modelViewMat.m);
+			a3demo_quickScaledZeroBottomRow_internal(model->modelViewMatInverseTranspose.m, model->modelViewMat.m, s);
+			return;
+		}
+	}
+	else
+	{
+		a3real4x4TransformInverse(model->modelMatInverse.m, modelMat);
+		a3demo_quickTransposedZeroBottomRow_internal(model->modelMatInverseTranspose.m, model->modelMatInverse.m);
+	}
+
+	// general model or viewer: same products as the unfused update
+	a3real4x4ProductTransform(model->modelViewMatInverse.m, model->modelMatInverse.m, modelMat_viewer);
+	a3demo_quickTransposedZeroBottomRow_internal(model->modelViewMatInverseTranspose.m, model->modelViewMatInverse.m);
+#endif	// A3_SIMD
+}
+
+
+//-----------------------------------------------------------------------------
+
+inline a3_DemoTransformType a3demo_getTransformType(a3real4x4p const m, a3real* scaleSqInv_out)
+{
+	// compare squared lengths and dot products of basis vectors
+	a3real const xx = m[0][0] * m[0][0] + m[0][1] * m[0][1] + m[0][2] * m[0][2];
+	a3real const yy = m[1][0] * m[1][0] + m[1][1] * m[1][1] + m[1][2] * m[1][2];
+	a3real const zz = m[2][0] * m[2][0] + m[2][1] * m[2][1] + m[2][2] * m[2][2];
+	a3real const xy = m[0][0] * m[1][0] + m[0][1] * m[1][1] + m[0][2] * m[1][2];
+	a3real const yz = m[1][0] * m[2][0] + m[1][1] * m[2][1] + m[1][2] * m[2][2];
+	a3real const zx = m[2][0] * m[0][0] + m[2][1] * m[0][1] + m[2][2] * m[0][2];
+	a3real const tol = xx * a3demo_transformTypeTolerance_internal;
+	a3real const dy = yy - xx, dz = zz - xx, d1 = xx - a3real_one;
+	a3real s = a3real_zero;
+	a3_DemoTransformType type = demoTransform_general;
+
+	if (xx > a3real_zero &&
+		dy <= tol && dy >= -tol && dz <= tol && dz >= -tol &&
+		xy <= tol && xy >= -tol && yz <= tol && yz >= -tol && zx <= tol && zx >= -tol)
+	{
+		if (d1 <= a3demo_transformTypeTolerance_internal && d1 >= -a3demo_transformTypeTolerance_internal)
+		{
+			s = a3real_one;
+			type = demoTransform_rigid;
+		}
+		else
+		{
+			s = a3real_one / xx;
+			type = demoTransform_uniformScale;
+		}
+	}
+	if (scaleSqInv_out)
+		*scaleSqInv_out = s;
+	return type;
+}
+
+inline void a3demo_updateModelMatrixStackArray(a3_DemoModelMatrixStack* model, a3count const count, a3real4x4p const projectionMat_viewer, a3real4x4p const modelMat_viewer, a3real4x4p const modelMatInv_viewer, a3real4x4p const modelMat, a3size const modelMatStride, a3real4x4p const atlasMat, a3size const atlasMatStride)
+{
+	a3boolean const viewerRigid = a3demo_getTransformType(modelMat_viewer, 0) == demoTransform_rigid;
+	a3byte const* modelMatPtr = (a3byte const*)modelMat;
+	a3byte const* atlasMatPtr = (a3byte const*)atlasMat;
+	a3index i;
+	for (i = 0; i < count; ++i, modelMatPtr += modelMatStride, atlasMatPtr += atlasMatStride)
+		a3demo_updateModelMatrixStackFused_internal(model + i, projectionMat_viewer, modelMat_viewer, modelMatInv_viewer, viewerRigid,
+			(a3real4 const*)modelMatPtr, (a3real4 const*)atlasMatPtr);
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+#endif	// !__ANIMAL3D_DEMOSCENEOBJECT_INL
+#endif	// __ANIMAL3D_DEMOSCENEOBJECT_H
@@ -0,0 +1,154 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoFileMap.c
+	File mapping implementation.
+*/
+
+#include "../a3_DemoFileMap.h"
+#include "../a3_DemoMemory.h"
+
+#include "animal3D/a3/a3macros.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else	// !_WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif	// _WIN32
+
+
+//-----------------------------------------------------------------------------
+
+// fallback: read whole file into heap block
+static a3ret a3demo_internalReadFile(a3_DemoFileMap* map_out, a3byte const* filePath)
+{
+	FILE* fp = fopen(filePath, "rb");
+	a3byte* data = 0;
+	long size = 0;
+	if (fp)
+	{
+		if (fseek(fp, 0, SEEK_END) == 0 && (size = ftell(fp)) > 0 && fseek(fp, 0, SEEK_SET) == 0)
+			if ((data = (a3byte*)a3demo_alloc((size_t)size)) && fread(data, 1, (size_t)size, fp) != (size_t)size)
+			{
+				a3demo_release(data);
+				data = 0;
+			}
+		fclose(fp);
+	}
+	if (data)
+	{
+		map_out->data = data;
+		map_out->size = (a3size)size;
+		map_out->mapped = a3false;
+		return 1;
+	}
+	return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_mapFile(a3_DemoFileMap* map_out, a3byte const* filePath)
+{
+	if (map_out && !map_out->data && filePath && *filePath)
+	{
+#ifdef _WIN32
+		LARGE_INTEGER size;
+		HANDLE const file = CreateFileA(filePath, GENERIC_READ, FILE_SHARE_READ, 0,
+			OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, 0);
+		HANDLE mapping = 0;
+		void const* view = 0;
+		if (file != INVALID_HANDLE_VALUE)
+		{
+			if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+				if (mapping = CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0))
+					if (!(view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)))
+						CloseHandle(mapping);
+			if (view)
+			{
+				map_out->data = (a3byte const*)view;
+				map_out->size = (a3size)size.QuadPart;
+				map_out->handle[0] = file;
+				map_out->handle[1] = mapping;
+				map_out->mapped = a3true;
+				return 1;
+			}
+			CloseHandle(file);
+		}
+#else	// !_WIN32
+		struct stat info;
+		int const file = open(filePath, O_RDONLY);
+		void* view = MAP_FAILED;
+		if (file >= 0)
+		{
+			if (fstat(file, &info) == 0 && info.st_size > 0)
+				view = mmap(0, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+			close(file);
+			if (view != MAP_FAILED)
+			{
+				madvise(view, (size_t)info.st_size, MADV_SEQUENTIAL);
+				map_out->data = (a3byte const*)view;
+				map_out->size = (a3size)info.st_size;
+				map_out->mapped = a3true;
+				return 1;
+			}
+		}
+#endif	// _WIN32
+		return a3demo_internalReadFile(map_out, filePath);
+	}
+	return -1;
+}
+
+a3ret a3demo_unmapFile(a3_DemoFileMap* map)
+{
+	if (map)
+	{
+		if (map->data)
+		{
+			if (map->mapped)
+			{
+#ifdef _WIN32
+				UnmapViewOfFile(map->data);
+				CloseHandle((HANDLE)map->handle[1]);
+				CloseHandle((HANDLE)map->handle[0]);
+#else	// !_WIN32
+				munmap((void*)map->data, (size_t)map->size);
+#endif	// _WIN32
+			}
+			else
+				a3demo_release((void*)map->data);
+		}
+		map->data = 0;
+		map->size = 0;
+		map->handle[0] = map->handle[1] = 0;
+		map->mapped = a3false;
+		return 1;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
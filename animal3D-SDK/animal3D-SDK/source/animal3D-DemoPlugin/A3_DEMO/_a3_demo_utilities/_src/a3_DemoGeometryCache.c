@@ -0,0 +1,518 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoGeometryCache.c
+	Geometry cache implementation.
+
+	When only stale shapes were rebuilt, their blobs are appended to the
+		file after the mapping is released and the header and contents are
+		written over the old ones last; until then the old contents still
+		describe the file, and an interrupted append leaves a size mismatch
+		that is caught on open. Otherwise (shapes added or dropped, or most
+		of the file taken by replaced blobs) a new file is written next to
+		the old one and swapped in after the old mapping is released, so a
+		failed write never destroys a good cache and fetched geometry stays
+		valid while the file is written.
+*/
+
+#include "../a3_DemoGeometryCache.h"
+#include "../a3_DemoMemory.h"
+
+#include "animal3D/a3/a3macros.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+//-----------------------------------------------------------------------------
+
+// absent stream
+#define a3demo_geomCacheNone	0xffffffffu
+
+// geometry streams: one or two vertex attributes stored back to back
+static const struct {
+	a3_GeometryVertexAttributeName geomName;
+	a3_VertexAttributeName name, nameSecond;
+} a3demo_geomCacheStream[] = {
+	{ a3attrib_geomPosition, a3attrib_position, a3attrib_position },
+	{ a3attrib_geomNormal, a3attrib_normal, a3attrib_normal },
+	{ a3attrib_geomColor, a3attrib_color, a3attrib_color },
+	{ a3attrib_geomTexcoord, a3attrib_texcoord, a3attrib_texcoord },
+	{ a3attrib_geomTangent, a3attrib_tangent, a3attrib_bitangent },
+	{ a3attrib_geomBlending, a3attrib_blendWeights, a3attrib_blendIndices },
+};
+
+
+//-----------------------------------------------------------------------------
+
+// bytes in stream for all vertices
+static a3ui64 a3demo_internalStreamSize(a3_VertexFormatDescriptor const* format, a3ui32 const k, a3ui32 const vertexCount)
+{
+	a3ui64 size = format->attribSize[a3demo_geomCacheStream[k].name];
+	if (a3demo_geomCacheStream[k].nameSecond != a3demo_geomCacheStream[k].name)
+		size += format->attribSize[a3demo_geomCacheStream[k].nameSecond];
+	return size * vertexCount;
+}
+
+// round up to blob alignment
+static a3ui64 a3demo_internalAlign(a3ui64 const offset)
+{
+	return (offset + a3demoGeometryCache_align - 1) / a3demoGeometryCache_align * a3demoGeometryCache_align;
+}
+
+// check that entry and its streams lie inside file
+static a3boolean a3demo_internalEntryValid(a3_DemoGeometryCacheEntry const* entry, a3ui64 const fileSize)
+{
+	a3ui32 k;
+	if (entry->name[a3demoGeometryCache_nameMax - 1] || entry->offset % a3demoGeometryCache_align ||
+		entry->offset > fileSize || entry->size > fileSize - entry->offset)
+		return a3false;
+	for (k = 0; k < sizeof(a3demo_geomCacheStream) / sizeof(*a3demo_geomCacheStream); ++k)
+		if (entry->attribOffset[k] != a3demo_geomCacheNone &&
+			entry->attribOffset[k] + a3demo_internalStreamSize(entry->vertexFormat, k, entry->numVertices) > entry->size)
+			return a3false;
+	if (entry->indexOffset != a3demo_geomCacheNone &&
+		entry->indexOffset + (a3ui64)entry->indexFormat->indexSize * entry->numIndices > entry->size)
+		return a3false;
+	if (entry->extraOffset != a3demo_geomCacheNone &&
+		(a3ui64)entry->extraOffset + entry->extraSize > entry->size)
+		return a3false;
+	return a3true;
+}
+
+// add or replace named item
+static a3ret a3demo_internalRecord(a3_DemoGeometryCache* cache, a3_GeometryData const* geom, a3byte const* name, a3ui64 const key,
+	void const* extra, a3ui32 const extraSize, a3boolean const fetched)
+{
+	a3ui32 i;
+	for (i = 0; i < cache->itemCount; ++i)
+		if (!strncmp(cache->item[i].name, name, a3demoGeometryCache_nameMax))
+			break;
+	if (i == cache->itemCount)
+	{
+		if (i == a3demoGeometryCache_entryMax)
+			return 0;
+		++cache->itemCount;
+	}
+	strncpy(cache->item[i].name, name, a3demoGeometryCache_nameMax - 1);
+	cache->item[i].name[a3demoGeometryCache_nameMax - 1] = 0;
+	cache->item[i].key = key;
+	cache->item[i].geom = geom;
+	cache->item[i].extra = extraSize ? extra : 0;
+	cache->item[i].extraSize = extraSize;
+	cache->item[i].fetched = fetched;
+	return 1;
+}
+
+// lay out item's blob in entry at offset: streams in attribute order, 
+//	indices, extra block; returns aligned offset after blob
+static a3ui64 a3demo_internalLayout(a3_DemoGeometryCacheEntry* entry, a3_DemoGeometryCacheItem const* item, a3ui64 const offset)
+{
+	a3_GeometryData const* geom = item->geom;
+	a3ui64 size;
+	a3ui32 k;
+	memcpy(entry->name, item->name, a3demoGeometryCache_nameMax);
+	entry->key = item->key;
+	*entry->vertexFormat = *geom->vertexFormat;
+	*entry->indexFormat = *geom->indexFormat;
+	entry->primType = (a3ui32)geom->primType;
+	entry->numVertices = geom->numVertices;
+	entry->numIndices = geom->numIndices;
+	for (k = 0, size = 0; k < a3attrib_geomNameMax; ++k)
+		entry->attribOffset[k] = a3demo_geomCacheNone;
+	for (k = 0; k < sizeof(a3demo_geomCacheStream) / sizeof(*a3demo_geomCacheStream); ++k)
+		if (geom->attribData[a3demo_geomCacheStream[k].geomName])
+		{
+			entry->attribOffset[k] = (a3ui32)size;
+			size += a3demo_internalStreamSize(geom->vertexFormat, k, geom->numVertices);
+		}
+	entry->indexOffset = a3demo_geomCacheNone;
+	if (geom->indexData)
+	{
+		entry->indexOffset = (a3ui32)size;
+		size += a3pad4((a3ui64)geom->indexFormat->indexSize * geom->numIndices);
+	}
+	entry->extraOffset = a3demo_geomCacheNone;
+	entry->extraSize = item->extraSize;
+	if (entry->extraSize)
+	{
+		entry->extraOffset = (a3ui32)size;
+		size += a3pad4((a3ui64)entry->extraSize);
+	}
+	entry->offset = offset;
+	entry->size = size;
+	return a3demo_internalAlign(offset + size);
+}
+
+// write zero padding from file position 'offset' up to 'end'
+static a3boolean a3demo_internalPad(FILE* fp, a3ui64 offset, a3ui64 const end)
+{
+	static const a3ubyte zero[a3demoGeometryCache_align] = { 0 };
+	a3ui64 size;
+	for (; offset < end; offset += size)
+	{
+		size = end - offset < a3demoGeometryCache_align ? end - offset : a3demoGeometryCache_align;
+		if (fwrite(zero, (size_t)size, 1, fp) != 1)
+			return a3false;
+	}
+	return a3true;
+}
+
+// write item's blob at file position 'offset', padding up to entry first; 
+//	returns offset after blob or 0 if write failed
+static a3ui64 a3demo_internalWriteBlob(FILE* fp, a3_DemoGeometryCacheEntry const* entry, a3_DemoGeometryCacheItem const* item, a3ui64 const offset)
+{
+	a3_GeometryData const* geom = item->geom;
+	a3ui64 size;
+	a3ui32 k;
+	a3boolean ok = a3demo_internalPad(fp, offset, entry->offset);
+	for (k = 0; ok && k < sizeof(a3demo_geomCacheStream) / sizeof(*a3demo_geomCacheStream); ++k)
+		if (entry->attribOffset[k] != a3demo_geomCacheNone && (size = a3demo_internalStreamSize(geom->vertexFormat, k, geom->numVertices)))
+			ok = fwrite(geom->attribData[a3demo_geomCacheStream[k].geomName], (size_t)size, 1, fp) == 1;
+	if (ok && entry->indexOffset != a3demo_geomCacheNone && (size = (a3ui64)geom->indexFormat->indexSize * geom->numIndices))
+		ok = fwrite(geom->indexData, (size_t)size, 1, fp) == 1 && a3demo_internalPad(fp, size, a3pad4(size));
+	if (ok && entry->extraOffset != a3demo_geomCacheNone && (size = entry->extraSize))
+		ok = fwrite(item->extra, (size_t)size, 1, fp) == 1 && a3demo_internalPad(fp, size, a3pad4(size));
+	return ok ? entry->offset + entry->size : 0;
+}
+
+// fill in header for contents
+static void a3demo_internalHeader(a3_DemoGeometryCacheHeader* header, a3_DemoGeometryCacheEntry const* toc, a3ui32 const entryCount, a3ui64 const fileSize)
+{
+	memset(header, 0, sizeof(a3_DemoGeometryCacheHeader));
+	header->magic = a3demoGeometryCache_magic;
+	header->version = a3demoGeometryCache_version;
+	header->entryCount = entryCount;
+	header->entrySize = sizeof(a3_DemoGeometryCacheEntry);
+	header->fileSize = fileSize;
+	header->tocHash = a3demo_hashGeometryKey(a3demoGeometryCache_keyStart, toc, entryCount * sizeof(a3_DemoGeometryCacheEntry));
+}
+
+// write all items to new file
+static a3boolean a3demo_internalWrite(a3_DemoGeometryCache const* cache, a3byte const* filePath)
+{
+	a3_DemoGeometryCacheHeader header[1];
+	a3_DemoGeometryCacheEntry* toc;
+	a3ui64 offset;
+	a3ui32 i;
+	a3boolean ok;
+	FILE* fp;
+
+	if (!(toc = (a3_DemoGeometryCacheEntry*)a3demo_allocZero((size_t)cache->itemCount * sizeof(a3_DemoGeometryCacheEntry))))
+		return a3false;
+
+	// lay out blobs after contents
+	offset = a3demo_internalAlign(sizeof(header) + cache->itemCount * sizeof(a3_DemoGeometryCacheEntry));
+	for (i = 0; i < cache->itemCount; ++i)
+		offset = a3demo_internalLayout(toc + i, cache->item + i, offset);
+	a3demo_internalHeader(header, toc, cache->itemCount, offset);
+
+	// write header, contents and blobs with zero padding between
+	ok = (fp = fopen(filePath, "wb")) != 0;
+	if (ok)
+	{
+		ok = fwrite(header, sizeof(header), 1, fp) == 1 &&
+			fwrite(toc, sizeof(a3_DemoGeometryCacheEntry), cache->itemCount, fp) == cache->itemCount;
+		offset = sizeof(header) + cache->itemCount * sizeof(a3_DemoGeometryCacheEntry);
+		for (i = 0; ok && i < cache->itemCount; ++i)
+			ok = (offset = a3demo_internalWriteBlob(fp, toc + i, cache->item + i, offset)) != 0;
+		ok = ok && a3demo_internalPad(fp, offset, header->fileSize);
+		ok = (fclose(fp) == 0) && ok;
+	}
+	a3demo_release(toc);
+	return ok;
+}
+
+// lay out patch of open file when it holds exactly the recorded names: 
+//	rebuilt blobs go after the end of the file, fetched entries stay as 
+//	they are; returns new contents (slot holds each item's entry index) 
+//	or null if the file must be rewritten instead, which is also done 
+//	when replaced blobs would make up most of the file
+static a3_DemoGeometryCacheEntry* a3demo_internalPatchLayout(a3_DemoGeometryCache const* cache, a3ui32* slot_out, a3ui64* fileSize_out)
+{
+	a3_DemoGeometryCacheEntry* toc;
+	a3ui64 const count = cache->header->entryCount;
+	a3ui64 offset = cache->header->fileSize, used;
+	a3ui32 i, j;
+
+	if (count != cache->itemCount || !(toc = (a3_DemoGeometryCacheEntry*)a3demo_alloc((size_t)count * sizeof(a3_DemoGeometryCacheEntry))))
+		return 0;
+	memcpy(toc, cache->toc, (size_t)count * sizeof(a3_DemoGeometryCacheEntry));
+	for (i = 0; i < cache->itemCount; ++i)
+	{
+		for (j = 0; j < count; ++j)
+			if (!strncmp(toc[j].name, cache->item[i].name, a3demoGeometryCache_nameMax))
+				break;
+		if (j == count)
+		{
+			a3demo_release(toc);
+			return 0;
+		}
+		slot_out[i] = j;
+		if (!cache->item[i].fetched)
+			offset = a3demo_internalLayout(toc + j, cache->item + i, offset);
+	}
+	used = a3demo_internalAlign(sizeof(a3_DemoGeometryCacheHeader) + count * sizeof(a3_DemoGeometryCacheEntry));
+	for (j = 0; j < count; ++j)
+		used += a3demo_internalAlign(toc[j].size);
+	if (offset > used * 2)
+	{
+		a3demo_release(toc);
+		return 0;
+	}
+	*fileSize_out = offset;
+	return toc;
+}
+
+// append rebuilt blobs to file, then replace header and contents; the 
+//	old contents still describe the file until the very last write
+static a3boolean a3demo_internalPatch(a3_DemoGeometryCache const* cache, a3_DemoGeometryCacheEntry const* toc, a3ui32 const* slot,
+	a3ui64 offset, a3ui64 const fileSize)
+{
+	a3_DemoGeometryCacheHeader header[1];
+	a3ui32 i;
+	a3boolean ok;
+	FILE* fp;
+
+	a3demo_internalHeader(header, toc, cache->itemCount, fileSize);
+	ok = (fp = fopen(cache->filePath, "r+b")) != 0;
+	if (ok)
+	{
+		ok = fseek(fp, (long)offset, SEEK_SET) == 0;
+		for (i = 0; ok && i < cache->itemCount; ++i)
+			if (!cache->item[i].fetched)
+				ok = (offset = a3demo_internalWriteBlob(fp, toc + slot[i], cache->item + i, offset)) != 0;
+		ok = ok && a3demo_internalPad(fp, offset, fileSize) && fflush(fp) == 0 &&
+			fseek(fp, 0, SEEK_SET) == 0 &&
+			fwrite(header, sizeof(header), 1, fp) == 1 &&
+			fwrite(toc, sizeof(a3_DemoGeometryCacheEntry), cache->itemCount, fp) == cache->itemCount;
+		ok = (fclose(fp) == 0) && ok;
+	}
+	return ok;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ui64 a3demo_hashGeometryKey(a3ui64 const key, void const* data, a3size const size)
+{
+	a3ubyte const* itr = (a3ubyte const*)data, * const end = itr + size;
+	a3ui64 hash = key;
+	while (itr < end)
+		hash = (hash ^ *(itr++)) * 0x100000001b3ull;
+	return hash;
+}
+
+a3ret a3demo_hashGeometrySource(a3ui64* key_inout, a3byte const* filePath)
+{
+	a3_DemoFileMap map[1] = { 0 };
+	if (key_inout && filePath)
+	{
+		if (a3demo_mapFile(map, filePath) > 0)
+		{
+			*key_inout = a3demo_hashGeometryKey(*key_inout, map->data, map->size);
+			*key_inout = a3demo_hashGeometryKey(*key_inout, &map->size, sizeof(map->size));
+			a3demo_unmapFile(map);
+			return 1;
+		}
+
+		// unreadable source never matches a key made while it was readable
+		*key_inout = a3demo_hashGeometryKey(~*key_inout, filePath, strlen(filePath));
+		return 0;
+	}
+	return -1;
+}
+
+a3ret a3demo_openGeometryCache(a3_DemoGeometryCache* cache, a3byte const* filePath)
+{
+	a3_DemoGeometryCacheHeader const* header;
+	a3_DemoGeometryCacheEntry const* toc;
+	a3ui64 size;
+	a3ui32 i;
+	if (cache && filePath && *filePath && strlen(filePath) < sizeof(cache->filePath))
+	{
+		memset(cache, 0, sizeof(a3_DemoGeometryCache));
+		strcpy(cache->filePath, filePath);
+		if (a3demo_mapFile(cache->map, filePath) > 0)
+		{
+			// accept only current version with intact contents
+			header = (a3_DemoGeometryCacheHeader const*)cache->map->data;
+			toc = (a3_DemoGeometryCacheEntry const*)(header + 1);
+			size = (a3ui64)cache->map->size;
+			if (size >= sizeof(a3_DemoGeometryCacheHeader) &&
+				header->magic == a3demoGeometryCache_magic && header->version == a3demoGeometryCache_version &&
+				header->entrySize == sizeof(a3_DemoGeometryCacheEntry) && header->fileSize == size &&
+				header->entryCount <= a3demoGeometryCache_entryMax &&
+				sizeof(a3_DemoGeometryCacheHeader) + header->entryCount * sizeof(a3_DemoGeometryCacheEntry) <= size &&
+				header->tocHash == a3demo_hashGeometryKey(a3demoGeometryCache_keyStart, toc, header->entryCount * sizeof(a3_DemoGeometryCacheEntry)))
+			{
+				for (i = 0; i < header->entryCount; ++i)
+					if (!a3demo_internalEntryValid(toc + i, header->fileSize))
+						break;
+				if (i == header->entryCount)
+				{
+					cache->header = header;
+					cache->toc = toc;
+					return 1;
+				}
+			}
+			printf("\n A3 Warning: Geometry cache '%s' is outdated or damaged; rebuilding.", filePath);
+			a3demo_unmapFile(cache->map);
+		}
+		return 0;
+	}
+	return -1;
+}
+
+a3ret a3demo_fetchGeometryCache(a3_DemoGeometryCache* cache, a3_GeometryData* geom_out, a3byte const* name, a3ui64 const key,
+	void* extra_out_opt, a3ui32 const extraSize)
+{
+	a3_DemoGeometryCacheEntry const* entry;
+	a3ubyte const* blob;
+	a3ui32 i, k;
+	if (cache && geom_out && name)
+	{
+		for (i = 0; cache->header && i < cache->header->entryCount; ++i)
+		{
+			entry = cache->toc + i;
+			blob = (a3ubyte const*)cache->map->data + entry->offset;
+			if (entry->key == key && !strncmp(entry->name, name, a3demoGeometryCache_nameMax) &&
+				entry->extraSize == extraSize && (!extraSize || extra_out_opt) &&
+				a3demo_internalRecord(cache, geom_out, name, key, extraSize ? blob + entry->extraOffset : 0, extraSize, a3true))
+			{
+				memset(geom_out, 0, sizeof(a3_GeometryData));
+				geom_out->data = (void*)blob;
+				*geom_out->vertexFormat = *entry->vertexFormat;
+				*geom_out->indexFormat = *entry->indexFormat;
+				geom_out->primType = (a3_VertexPrimitiveType)entry->primType;
+				geom_out->numVertices = entry->numVertices;
+				geom_out->numIndices = entry->numIndices;
+				for (k = 0; k < sizeof(a3demo_geomCacheStream) / sizeof(*a3demo_geomCacheStream); ++k)
+					if (entry->attribOffset[k] != a3demo_geomCacheNone)
+						geom_out->attribData[a3demo_geomCacheStream[k].geomName] = blob + entry->attribOffset[k];
+				if (entry->indexOffset != a3demo_geomCacheNone)
+					geom_out->indexData = blob + entry->indexOffset;
+				if (extraSize)
+					memcpy(extra_out_opt, blob + entry->extraOffset, extraSize);
+				++cache->fetchCount;
+				return 1;
+			}
+		}
+		return 0;
+	}
+	return -1;
+}
+
+a3ret a3demo_storeGeometryCache(a3_DemoGeometryCache* cache, a3_GeometryData const* geom, a3byte const* name, a3ui64 const key,
+	void const* extra_opt, a3ui32 const extraSize)
+{
+	if (cache && geom && name && (extra_opt || !extraSize))
+	{
+		if (cache->filePath[0] && geom->numVertices && a3demo_internalRecord(cache, geom, name, key, extra_opt, extraSize, a3false))
+		{
+			++cache->rebuildCount;
+			return 1;
+		}
+		return 0;
+	}
+	return -1;
+}
+
+a3ret a3demo_isGeometryCached(a3_DemoGeometryCache const* cache, a3_GeometryData const* geom)
+{
+	a3ui32 i;
+	if (cache && geom)
+	{
+		for (i = 0; i < cache->itemCount; ++i)
+			if (cache->item[i].geom == geom)
+				return cache->item[i].fetched;
+		return 0;
+	}
+	return -1;
+}
+
+a3ret a3demo_closeGeometryCache(a3_DemoGeometryCache* cache)
+{
+	a3byte tmpPath[sizeof(cache->filePath) + 4];
+	a3_DemoGeometryCacheEntry* patch = 0;
+	a3ui32 slot[a3demoGeometryCache_entryMax];
+	a3ui64 offset = 0, fileSize = 0;
+	a3ret result = 0;
+	if (cache)
+	{
+		// write if anything changed; unchanged means every entry fetched; 
+		//	if only stale shapes were rebuilt, just they and the contents 
+		//	are written, otherwise the whole file
+		if (cache->filePath[0] && cache->itemCount &&
+			(cache->rebuildCount || !cache->header || cache->header->entryCount != cache->itemCount))
+		{
+			if (cache->header && (patch = a3demo_internalPatchLayout(cache, slot, &fileSize)))
+				offset = cache->header->fileSize;
+			else
+			{
+				sprintf(tmpPath, "%s.tmp", cache->filePath);
+				result = a3demo_internalWrite(cache, tmpPath) ? 1 : -1;
+			}
+		}
+		a3demo_unmapFile(cache->map);
+		cache->header = 0;
+		cache->toc = 0;
+
+		// patch file in place now that it is no longer mapped
+		if (patch)
+		{
+			result = a3demo_internalPatch(cache, patch, slot, offset, fileSize) ? 1 : -1;
+			a3demo_release(patch);
+			if (result < 0)
+				printf("\n A3 Warning: Geometry cache '%s' could not be written.", cache->filePath);
+			return result;
+		}
+
+		// swap in new file now that old one is no longer mapped
+		if (result > 0)
+		{
+#ifdef _WIN32
+			// rename does not replace existing files here
+			remove(cache->filePath);
+#endif	// _WIN32
+			if (rename(tmpPath, cache->filePath) != 0)
+				result = -1;
+		}
+		if (result < 0)
+		{
+			printf("\n A3 Warning: Geometry cache '%s' could not be written.", cache->filePath);
+			remove(tmpPath);
+		}
+		return result;
+	}
+	return -1;
+}
+
+void a3demo_printGeometryCache(a3_DemoGeometryCache const* cache)
+{
+	if (cache && cache->filePath[0])
+		printf("\n A3 geometry cache '%s': %u shapes, %u mapped (%.1f KiB), %u rebuilt \n",
+			cache->filePath, cache->itemCount, cache->fetchCount,
+			(a3f64)cache->map->size / 1024.0, cache->rebuildCount);
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,594 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoGeometryLOD.c
+	Level of detail chain implementation.
+
+	Simplification runs in passes until the level's triangle count is met:
+		1. topology: directed edges are counted on welded positions, so
+			vertices split only by attributes count as one; an edge with no
+			twin is a border, an edge used twice in one direction makes its
+			vertices locked, as do seams and border corners
+		2. candidates: every vertex that may move picks its cheapest
+			neighbor by quadric error at the neighbor's position, plus the
+			attribute change weighted by the vertex's surface area
+		3. collapse: candidates are applied cheapest first; a collapse is
+			skipped if it would flip a triangle, pinch the surface (more
+			shared neighbors than the edge has triangles) or touch a vertex
+			already changed in this pass, which keeps the adjacency built
+			for the pass valid without updating it
+	Positions are scaled into a unit box first so attribute weights do not
+		depend on model size; errors are scaled back when reported.
+*/
+
+#include "../a3_DemoGeometryLOD.h"
+#include "../a3_DemoMemory.h"
+#include "../a3_DemoPlatform.h"
+
+#include "animal3D/a3/a3macros.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+
+// vertex kinds
+enum
+{
+	a3demo_lodManifold,						// may collapse to any neighbor
+	a3demo_lodBorder,						// may collapse along border only
+	a3demo_lodLocked,						// never moves
+};
+
+// weight of border planes against face planes
+#define a3demo_lodBorderWeight	10.0
+
+// area-weighted sum of plane quadrics
+typedef struct a3_DemoLODQuadric
+{
+	a3f64 a2, ab, ac, ad, b2, bc, bd, c2, cd, d2;
+	a3f64 w;								// summed area
+} a3_DemoLODQuadric;
+
+// cheapest collapse of one vertex
+typedef struct a3_DemoLODCollapse
+{
+	a3ui32 v, t;
+	a3f32 cost;
+} a3_DemoLODCollapse;
+
+// directed edge counts on welded positions
+typedef struct a3_DemoLODEdgeTable
+{
+	a3ui64* key;
+	a3ui32* count;
+	a3ui32 mask;
+} a3_DemoLODEdgeTable;
+
+
+//-----------------------------------------------------------------------------
+// utilities
+
+static void a3demo_lodCross(a3f64* v_out, a3f64 const* a, a3f64 const* b)
+{
+	v_out[0] = a[1] * b[2] - a[2] * b[1];
+	v_out[1] = a[2] * b[0] - a[0] * b[2];
+	v_out[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+// normal of triangle (length is twice area)
+static void a3demo_lodTriangleNormal(a3f64* n_out, a3f32 const* p0, a3f32 const* p1, a3f32 const* p2)
+{
+	a3f64 const e1[3] = { (a3f64)p1[0] - p0[0], (a3f64)p1[1] - p0[1], (a3f64)p1[2] - p0[2] };
+	a3f64 const e2[3] = { (a3f64)p2[0] - p0[0], (a3f64)p2[1] - p0[1], (a3f64)p2[2] - p0[2] };
+	a3demo_lodCross(n_out, e1, e2);
+}
+
+// add plane (unit normal n, point p) with weight
+static void a3demo_lodQuadricAdd(a3_DemoLODQuadric* q, a3f64 const* n, a3f32 const* p, a3f64 const w)
+{
+	a3f64 const d = -(n[0] * p[0] + n[1] * p[1] + n[2] * p[2]);
+	q->a2 += w * n[0] * n[0], q->ab += w * n[0] * n[1], q->ac += w * n[0] * n[2], q->ad += w * n[0] * d;
+	q->b2 += w * n[1] * n[1], q->bc += w * n[1] * n[2], q->bd += w * n[1] * d;
+	q->c2 += w * n[2] * n[2], q->cd += w * n[2] * d;
+	q->d2 += w * d * d;
+	q->w += w;
+}
+
+static void a3demo_lodQuadricMerge(a3_DemoLODQuadric* q, a3_DemoLODQuadric const* r)
+{
+	q->a2 += r->a2, q->ab += r->ab, q->ac += r->ac, q->ad += r->ad;
+	q->b2 += r->b2, q->bc += r->bc, q->bd += r->bd;
+	q->c2 += r->c2, q->cd += r->cd;
+	q->d2 += r->d2;
+	q->w += r->w;
+}
+
+// weighted squared distance of point from planes
+static a3f64 a3demo_lodQuadricEval(a3_DemoLODQuadric const* q, a3f32 const* p)
+{
+	a3f64 const x = p[0], y = p[1], z = p[2];
+	a3f64 const e = q->a2 * x * x + q->b2 * y * y + q->c2 * z * z +
+		2.0 * (q->ab * x * y + q->ac * x * z + q->bc * y * z + q->ad * x + q->bd * y + q->cd * z) + q->d2;
+	return e > 0.0 ? e : 0.0;
+}
+
+static a3ui32 a3demo_lodHash(a3ui64 const key)
+{
+	a3ui64 h = key * 0x9e3779b97f4a7c15ull;
+	return (a3ui32)(h ^ (h >> 29));
+}
+
+// count every directed edge of live triangles
+static void a3demo_lodBuildEdges(a3_DemoLODEdgeTable* table, a3ui32 const* index, a3ui32 const triangleCount, a3ui32 const* wedge)
+{
+	a3ui32 t, k, slot;
+	a3ui64 key;
+	memset(table->key, 0xff, ((size_t)table->mask + 1) * sizeof(a3ui64));
+	memset(table->count, 0, ((size_t)table->mask + 1) * sizeof(a3ui32));
+	for (t = 0; t < triangleCount; ++t)
+		for (k = 0; k < 3; ++k)
+		{
+			key = (a3ui64)wedge[index[t * 3 + k]] << 32 | wedge[index[t * 3 + (k + 1) % 3]];
+			for (slot = a3demo_lodHash(key) & table->mask; table->key[slot] != key && table->key[slot] != ~0ull; slot = (slot + 1) & table->mask);
+			table->key[slot] = key;
+			table->count[slot]++;
+		}
+}
+
+static a3ui32 a3demo_lodEdgeCount(a3_DemoLODEdgeTable const* table, a3ui32 const a, a3ui32 const b)
+{
+	a3ui64 const key = (a3ui64)a << 32 | b;
+	a3ui32 slot;
+	for (slot = a3demo_lodHash(key) & table->mask; table->key[slot] != ~0ull; slot = (slot + 1) & table->mask)
+		if (table->key[slot] == key)
+			return table->count[slot];
+	return 0;
+}
+
+static int a3demo_lodCollapseCompare(void const* a, void const* b)
+{
+	a3_DemoLODCollapse const* const x = (a3_DemoLODCollapse const*)a, * const y = (a3_DemoLODCollapse const*)b;
+	return x->cost < y->cost ? -1 : x->cost > y->cost ? +1 : x->v < y->v ? -1 : x->v > y->v ? +1 : 0;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_generateGeometryLOD(a3_GeometryData* geom, a3_DemoGeometryLOD* lod_out, a3f32 const* ratios, a3ui32 const ratioCount,
+	a3f32 const attribWeight, a3_DemoGeometryLODStats* stats_out_opt)
+{
+	a3_DemoGeometryLOD lod = { 0 };
+	a3_DemoGeometryLODStats stats = { 0 };
+	a3_DemoLODEdgeTable edges[1] = { 0 };
+	a3_DemoLODQuadric* quadric = 0;
+	a3_DemoLODCollapse* collapse = 0;
+	a3f32* pos = 0;
+	a3f32 const* normal = 0, * texcoord = 0, * position;
+	a3ui32* index = 0, * chain = 0, * wedge = 0, * adjFirst = 0, * adjList = 0, * stamp = 0, * mark = 0, * best = 0;
+	a3f32* bestCost = 0;
+	a3ubyte* kind = 0, * seam = 0, * dead = 0;
+	a3byte* data = 0;
+	a3ui32 vertexCount, triangleCount, baseCount, chainCount, target, candidateCount, applied, level, pass = 0, linkStamp = 0;
+	a3ui32 positionStride, normalStride = 0, texcoordStride = 0, indexSize, vertexBytes;
+	a3ui32 i, j, k, s, t, v, a, b, c;
+	a3f64 n[3], n1[3], len, scale, cost, error = 0.0, timeStart;
+	a3f32 lo[3], hi[3];
+	a3ret result = 0;
+
+	if (!geom || !lod_out || !ratios || ratioCount >= a3demoGeometryLOD_max)
+		return -1;
+	timeStart = a3demo_getTime();
+	vertexCount = geom->numVertices;
+	triangleCount = baseCount = geom->numIndices / 3;
+	indexSize = geom->indexFormat->indexSize;
+
+	// indexed triangle lists with float positions only, indices after
+	//	vertex streams in the same block
+	if (geom->primType != a3prim_triangles || !geom->data || !geom->indexData || !triangleCount || geom->numIndices % 3 ||
+		(indexSize != 1 && indexSize != 2 && indexSize != 4) || (a3byte const*)geom->indexData < (a3byte const*)geom->data ||
+		!geom->attribData[a3attrib_geomPosition] || geom->vertexFormat->attribSize[a3attrib_position] < 3 * sizeof(a3f32))
+		goto done;
+	position = (a3f32 const*)geom->attribData[a3attrib_geomPosition];
+	positionStride = geom->vertexFormat->attribSize[a3attrib_position] / sizeof(a3f32);
+	if (geom->attribData[a3attrib_geomNormal] && geom->vertexFormat->attribSize[a3attrib_normal] >= 3 * sizeof(a3f32))
+	{
+		normal = (a3f32 const*)geom->attribData[a3attrib_geomNormal];
+		normalStride = geom->vertexFormat->attribSize[a3attrib_normal] / sizeof(a3f32);
+	}
+	if (geom->attribData[a3attrib_geomTexcoord] && geom->vertexFormat->attribSize[a3attrib_texcoord] >= 2 * sizeof(a3f32))
+	{
+		texcoord = (a3f32 const*)geom->attribData[a3attrib_geomTexcoord];
+		texcoordStride = geom->vertexFormat->attribSize[a3attrib_texcoord] / sizeof(a3f32);
+	}
+
+	for (k = 1; k < baseCount * 6 || k < vertexCount * 2; k *= 2);
+	edges->mask = k - 1;
+	edges->key = (a3ui64*)a3demo_alloc((size_t)k * sizeof(a3ui64));
+	edges->count = (a3ui32*)a3demo_alloc((size_t)k * sizeof(a3ui32));
+	quadric = (a3_DemoLODQuadric*)a3demo_allocZero((size_t)vertexCount * sizeof(a3_DemoLODQuadric));
+	collapse = (a3_DemoLODCollapse*)a3demo_alloc((size_t)vertexCount * sizeof(a3_DemoLODCollapse));
+	pos = (a3f32*)a3demo_alloc((size_t)vertexCount * 3 * sizeof(a3f32));
+	bestCost = (a3f32*)a3demo_alloc((size_t)vertexCount * sizeof(a3f32));
+	index = (a3ui32*)a3demo_alloc((size_t)baseCount * 3 * sizeof(a3ui32));
+	chain = (a3ui32*)a3demo_alloc((size_t)baseCount * 3 * (ratioCount + 1) * sizeof(a3ui32));
+	wedge = (a3ui32*)a3demo_alloc((size_t)vertexCount * 6 * sizeof(a3ui32) + sizeof(a3ui32));
+	adjList = (a3ui32*)a3demo_alloc((size_t)baseCount * 3 * sizeof(a3ui32));
+	kind = (a3ubyte*)a3demo_alloc((size_t)vertexCount * 2 + baseCount);
+	if (!edges->key || !edges->count || !quadric || !collapse || !pos || !bestCost || !index || !chain || !wedge || !adjList || !kind)
+		goto done;
+	adjFirst = wedge + vertexCount;			// vertex count + 1
+	stamp = adjFirst + vertexCount + 1;
+	mark = stamp + vertexCount;
+	best = mark + vertexCount;
+	seam = kind + vertexCount;
+	dead = seam + vertexCount;
+
+	// widen indices
+	for (i = 0; i < baseCount * 3; ++i)
+	{
+		switch (indexSize)
+		{
+		case 1: index[i] = ((a3ubyte const*)geom->indexData)[i]; break;
+		case 2: index[i] = ((a3ui16 const*)geom->indexData)[i]; break;
+		default: index[i] = ((a3ui32 const*)geom->indexData)[i]; break;
+		}
+		if (index[i] >= vertexCount)
+			goto done;
+	}
+	memcpy(chain, index, (size_t)baseCount * 3 * sizeof(a3ui32));
+	chainCount = baseCount * 3;
+
+	// positions in unit box
+	for (k = 0; k < 3; ++k)
+		lo[k] = hi[k] = position[k];
+	for (v = 0; v < vertexCount; ++v)
+		for (k = 0; k < 3; ++k)
+		{
+			lo[k] = position[v * positionStride + k] < lo[k] ? position[v * positionStride + k] : lo[k];
+			hi[k] = position[v * positionStride + k] > hi[k] ? position[v * positionStride + k] : hi[k];
+		}
+	scale = hi[0] - lo[0];
+	scale = hi[1] - lo[1] > scale ? hi[1] - lo[1] : scale;
+	scale = hi[2] - lo[2] > scale ? hi[2] - lo[2] : scale;
+	scale = scale > 0.0 ? scale : 1.0;
+	for (v = 0; v < vertexCount; ++v)
+		for (k = 0; k < 3; ++k)
+			pos[v * 3 + k] = (a3f32)((position[v * positionStride + k] - lo[k]) / scale);
+
+	// weld vertices at the same position (edge table slots reused as a
+	//	position hash); welded copies are seams and stay fixed
+	memset(edges->key, 0xff, ((size_t)edges->mask + 1) * sizeof(a3ui64));
+	memset(kind, a3demo_lodManifold, vertexCount);
+	for (v = 0; v < vertexCount; ++v)
+	{
+		a3ui32 const* const bits = (a3ui32 const*)(pos + v * 3);
+		a3ui64 const key = (a3ui64)bits[0] * 0x9e3779b1u ^ (a3ui64)bits[1] * 0x85ebca77u ^ (a3ui64)bits[2] * 0xc2b2ae3du;
+		for (s = a3demo_lodHash(key) & edges->mask; edges->key[s] != ~0ull; s = (s + 1) & edges->mask)
+			if (!memcmp(pos + edges->key[s] * 3, pos + v * 3, 3 * sizeof(a3f32)))
+				break;
+		if (edges->key[s] == ~0ull)
+		{
+			edges->key[s] = v;
+			wedge[v] = v;
+		}
+		else
+		{
+			wedge[v] = (a3ui32)edges->key[s];
+			kind[v] = kind[wedge[v]] = a3demo_lodLocked;
+		}
+	}
+	memcpy(seam, kind, vertexCount);		// kept across passes
+
+	// face quadrics on welded positions
+	for (t = 0; t < baseCount; ++t)
+	{
+		a = index[t * 3 + 0], b = index[t * 3 + 1], c = index[t * 3 + 2];
+		a3demo_lodTriangleNormal(n, pos + a * 3, pos + b * 3, pos + c * 3);
+		len = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+		if (len > 0.0)
+		{
+			n[0] /= len, n[1] /= len, n[2] /= len;
+			a3demo_lodQuadricAdd(quadric + wedge[a], n, pos + a * 3, len * 0.5);
+			a3demo_lodQuadricAdd(quadric + wedge[b], n, pos + a * 3, len * 0.5);
+			a3demo_lodQuadricAdd(quadric + wedge[c], n, pos + a * 3, len * 0.5);
+		}
+	}
+
+	// border planes: perpendicular to face through border edge
+	a3demo_lodBuildEdges(edges, index, baseCount, wedge);
+	for (t = 0; t < baseCount; ++t)
+		for (k = 0; k < 3; ++k)
+		{
+			a = index[t * 3 + k], b = index[t * 3 + (k + 1) % 3], c = index[t * 3 + (k + 2) % 3];
+			if (!a3demo_lodEdgeCount(edges, wedge[b], wedge[a]))
+			{
+				a3f64 const e[3] = { (a3f64)pos[b * 3 + 0] - pos[a * 3 + 0], (a3f64)pos[b * 3 + 1] - pos[a * 3 + 1], (a3f64)pos[b * 3 + 2] - pos[a * 3 + 2] };
+				a3demo_lodTriangleNormal(n1, pos + a * 3, pos + b * 3, pos + c * 3);
+				a3demo_lodCross(n, e, n1);
+				len = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+				if (len > 0.0)
+				{
+					n[0] /= len, n[1] /= len, n[2] /= len;
+					len = (e[0] * e[0] + e[1] * e[1] + e[2] * e[2]) * a3demo_lodBorderWeight;
+					a3demo_lodQuadricAdd(quadric + wedge[a], n, pos + a * 3, len);
+					a3demo_lodQuadricAdd(quadric + wedge[b], n, pos + a * 3, len);
+				}
+			}
+		}
+
+	lod.levelCount = 1;
+	lod.count[0] = baseCount * 3;
+	memset(stamp, 0, (size_t)vertexCount * sizeof(a3ui32));
+	memset(mark, 0, (size_t)vertexCount * sizeof(a3ui32));
+	for (level = 0; level < ratioCount; ++level)
+	{
+		target = (a3ui32)((a3f64)ratios[level] * (a3f64)baseCount);
+		target = target ? target : 1;
+		if (target >= triangleCount)
+			break;
+
+		while (triangleCount > target)
+		{
+			++pass;
+
+			// 1. topology of current triangles
+			a3demo_lodBuildEdges(edges, index, triangleCount, wedge);
+			for (v = 0; v < vertexCount; ++v)
+				kind[v] = seam[v] ? a3demo_lodLocked : a3demo_lodManifold;
+			memset(mark, 0, (size_t)vertexCount * sizeof(a3ui32));
+			for (t = 0; t < triangleCount; ++t)
+				for (k = 0; k < 3; ++k)
+				{
+					a = wedge[index[t * 3 + k]], b = wedge[index[t * 3 + (k + 1) % 3]];
+					if (a3demo_lodEdgeCount(edges, a, b) > 1 || a3demo_lodEdgeCount(edges, b, a) > 1)
+						kind[a] = kind[b] = a3demo_lodLocked;
+					else if (!a3demo_lodEdgeCount(edges, b, a))
+						++mark[a], ++mark[b];
+				}
+			for (v = 0; v < vertexCount; ++v)
+				if (mark[v] && kind[v] != a3demo_lodLocked)
+					kind[v] = mark[v] == 2 ? a3demo_lodBorder : a3demo_lodLocked;
+			memset(mark, 0, (size_t)vertexCount * sizeof(a3ui32));
+
+			// triangles around every vertex
+			memset(adjFirst, 0, ((size_t)vertexCount + 1) * sizeof(a3ui32));
+			for (i = 0; i < triangleCount * 3; ++i)
+				++adjFirst[index[i] + 1];
+			for (v = 0; v < vertexCount; ++v)
+				adjFirst[v + 1] += adjFirst[v];
+			for (i = 0; i < triangleCount * 3; ++i)
+				adjList[adjFirst[index[i]]++] = i / 3;
+			for (v = vertexCount; v > 0; --v)
+				adjFirst[v] = adjFirst[v - 1];
+			adjFirst[0] = 0;
+
+			// 2. cheapest collapse of every vertex that may move
+			for (v = 0; v < vertexCount; ++v)
+				best[v] = ~0u;
+			for (t = 0; t < triangleCount; ++t)
+				for (k = 0; k < 6; ++k)
+				{
+					v = index[t * 3 + k % 3];
+					s = index[t * 3 + (k % 3 + (k < 3 ? 1 : 2)) % 3];
+					if (kind[v] == a3demo_lodLocked || (kind[v] == a3demo_lodBorder &&
+						a3demo_lodEdgeCount(edges, wedge[v], wedge[s]) && a3demo_lodEdgeCount(edges, wedge[s], wedge[v])))
+						continue;
+					cost = a3demo_lodQuadricEval(quadric + v, pos + s * 3);
+					if (attribWeight > 0.0f)
+					{
+						a3f64 d = 0.0, x;
+						if (normal)
+							for (j = 0; j < 3; ++j)
+								x = (a3f64)normal[v * normalStride + j] - normal[s * normalStride + j], d += x * x;
+						if (texcoord)
+							for (j = 0; j < 2; ++j)
+								x = (a3f64)texcoord[v * texcoordStride + j] - texcoord[s * texcoordStride + j], d += x * x;
+						cost += d * attribWeight * quadric[v].w;
+					}
+					if (best[v] == ~0u || (a3f32)cost < bestCost[v] || ((a3f32)cost == bestCost[v] && s < best[v]))
+					{
+						best[v] = s;
+						bestCost[v] = (a3f32)cost;
+					}
+				}
+			for (v = 0, candidateCount = 0; v < vertexCount; ++v)
+				if (best[v] != ~0u)
+				{
+					collapse[candidateCount].v = v;
+					collapse[candidateCount].t = best[v];
+					collapse[candidateCount++].cost = bestCost[v];
+				}
+			qsort(collapse, candidateCount, sizeof(a3_DemoLODCollapse), a3demo_lodCollapseCompare);
+
+			// 3. apply cheapest first
+			memset(dead, 0, triangleCount);
+			for (i = 0, applied = 0; i < candidateCount && triangleCount > target; ++i)
+			{
+				a3ui32 const cv = collapse[i].v, ct = collapse[i].t, cw = wedge[ct];
+				a3ui32 common = 0, removed = 0;
+				a3boolean ok = stamp[cv] != pass && stamp[ct] != pass && stamp[cw] != pass;
+
+				// link condition: shared neighbors are the edge's own triangles
+				linkStamp += 2;
+				for (j = adjFirst[cv]; ok && j < adjFirst[cv + 1]; ++j)
+					for (k = 0; k < 3; ++k)
+						mark[wedge[index[adjList[j] * 3 + k]]] = linkStamp;
+				for (j = adjFirst[ct]; ok && j < adjFirst[ct + 1]; ++j)
+					for (k = 0; k < 3; ++k)
+					{
+						s = wedge[index[adjList[j] * 3 + k]];
+						if (mark[s] == linkStamp && s != cw && s != wedge[cv])
+						{
+							mark[s] = linkStamp + 1;
+							++common;
+						}
+					}
+				ok = ok && common <= (kind[cv] == a3demo_lodBorder ? 1u : 2u);
+
+				// no flipped or collapsed triangles
+				for (j = adjFirst[cv]; ok && j < adjFirst[cv + 1]; ++j)
+				{
+					a3ui32 const* const tri = index + adjList[j] * 3;
+					if (wedge[tri[0]] == cw || wedge[tri[1]] == cw || wedge[tri[2]] == cw)
+						continue;
+					a3demo_lodTriangleNormal(n, pos + tri[0] * 3, pos + tri[1] * 3, pos + tri[2] * 3);
+					a3demo_lodTriangleNormal(n1,
+						pos + (tri[0] == cv ? ct : tri[0]) * 3, pos + (tri[1] == cv ? ct : tri[1]) * 3, pos + (tri[2] == cv ? ct : tri[2]) * 3);
+					ok = n[0] * n1[0] + n[1] * n1[1] + n[2] * n1[2] > 0.0;
+				}
+				if (!ok)
+					continue;
+
+				// collapse
+				cost = a3demo_lodQuadricEval(quadric + cv, pos + ct * 3);
+				if (quadric[cv].w > 0.0 && cost / quadric[cv].w > error)
+					error = cost / quadric[cv].w;
+				for (j = adjFirst[cv]; j < adjFirst[cv + 1]; ++j)
+				{
+					a3ui32* const tri = index + adjList[j] * 3;
+					for (k = 0; k < 3; ++k)
+						stamp[tri[k]] = stamp[wedge[tri[k]]] = pass;
+					if (wedge[tri[0]] == cw || wedge[tri[1]] == cw || wedge[tri[2]] == cw)
+					{
+						dead[adjList[j]] = 1;
+						++removed;
+					}
+					else
+						for (k = 0; k < 3; ++k)
+							tri[k] = tri[k] == cv ? ct : tri[k];
+				}
+				a3demo_lodQuadricMerge(quadric + cw, quadric + cv);
+				stamp[ct] = stamp[cw] = pass;
+				triangleCount -= removed;
+				++applied;
+			}
+
+			// drop collapsed triangles, keeping order
+			for (t = 0, j = 0; j < adjFirst[vertexCount] / 3; ++j)
+				if (!dead[j])
+				{
+					if (t != j)
+						memcpy(index + t * 3, index + j * 3, 3 * sizeof(a3ui32));
+					++t;
+				}
+			if (!applied)
+				break;
+		}
+
+		// keep level only if it removed something
+		if (triangleCount * 3 >= lod.count[lod.levelCount - 1])
+			break;
+		lod.first[lod.levelCount] = chainCount;
+		lod.count[lod.levelCount] = triangleCount * 3;
+		lod.error[lod.levelCount] = (a3f32)(sqrt(error) * scale);
+		memcpy(chain + chainCount, index, (size_t)triangleCount * 3 * sizeof(a3ui32));
+		chainCount += triangleCount * 3;
+		++lod.levelCount;
+	}
+
+	// rebuild block: vertex streams unchanged, then all levels (plain 
+	//	malloc, released with free by a3geometryReleaseData)
+	vertexBytes = (a3ui32)((a3byte const*)geom->indexData - (a3byte const*)geom->data);
+	if (!(data = (a3byte*)malloc((size_t)vertexBytes + (size_t)a3indexFormatGetStorageSpaceRequired(geom->indexFormat, chainCount))))
+		goto done;
+	memcpy(data, geom->data, vertexBytes);
+	for (i = 0; i < chainCount; ++i)
+		switch (indexSize)
+		{
+		case 1: ((a3ubyte*)(data + vertexBytes))[i] = (a3ubyte)chain[i]; break;
+		case 2: ((a3ui16*)(data + vertexBytes))[i] = (a3ui16)chain[i]; break;
+		default: ((a3ui32*)(data + vertexBytes))[i] = chain[i]; break;
+		}
+	for (k = 0; k < a3attrib_geomNameMax; ++k)
+		if (geom->attribData[k])
+			geom->attribData[k] = data + ((a3byte const*)geom->attribData[k] - (a3byte const*)geom->data);
+	free(geom->data);
+	geom->data = data;
+	geom->indexData = data + vertexBytes;
+	geom->numIndices = chainCount;
+	data = 0;
+	*lod_out = lod;
+	result = lod.levelCount;
+
+done:
+	if (stats_out_opt)
+	{
+		stats.levelCount = lod.levelCount;
+		for (k = 0; k < lod.levelCount; ++k)
+		{
+			stats.triangleCount[k] = lod.count[k] / 3;
+			stats.error[k] = lod.error[k];
+		}
+		stats.passCount = pass;
+		stats.time = a3demo_getTime() - timeStart;
+		*stats_out_opt = stats;
+	}
+	a3demo_release(edges->key);
+	a3demo_release(edges->count);
+	a3demo_release(quadric);
+	a3demo_release(collapse);
+	a3demo_release(pos);
+	a3demo_release(bestCost);
+	a3demo_release(index);
+	a3demo_release(chain);
+	a3demo_release(wedge);
+	a3demo_release(adjList);
+	a3demo_release(kind);
+	return result;
+}
+
+
+a3f32 a3demo_projectGeometryLODScale(a3real const* mvp, a3ui32 const viewportWidth, a3ui32 const viewportHeight)
+{
+	// clip-space w of origin; rows of x and y give the largest change of
+	//	clip position per object unit in any direction
+	a3f64 const w = (a3f64)mvp[15];
+	a3f64 const x = sqrt((a3f64)mvp[0] * mvp[0] + (a3f64)mvp[4] * mvp[4] + (a3f64)mvp[8] * mvp[8]) * 0.5 * viewportWidth;
+	a3f64 const y = sqrt((a3f64)mvp[1] * mvp[1] + (a3f64)mvp[5] * mvp[5] + (a3f64)mvp[9] * mvp[9]) * 0.5 * viewportHeight;
+	return w > 0.0 ? (a3f32)((x > y ? x : y) / w) : 0.0f;
+}
+
+a3ui32 a3demo_selectGeometryLOD(a3_DemoGeometryLOD const* lod, a3f32 const pixelScale, a3f32 const pixelError)
+{
+	a3ui32 level = 0;
+	if (lod && pixelScale > 0.0f)
+		while (level + 1 < lod->levelCount && lod->error[level + 1] * pixelScale <= pixelError)
+			++level;
+	return level;
+}
+
+void a3demo_printGeometryLODStats(a3_DemoGeometryLODStats const* stats, a3byte const* name)
+{
+	a3ui32 k;
+	if (stats)
+	{
+		printf("\n A3 LOD chain '%s': %u levels in %.2f ms (%u passes) \n",
+			name ? name : (a3byte const*)"", stats->levelCount, stats->time * 1000.0, stats->passCount);
+		for (k = 0; k < stats->levelCount; ++k)
+			printf("    level %u: %u triangles, error %g \n", k, stats->triangleCount[k], stats->error[k]);
+	}
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,439 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoGeometryOptimize.c
+	Geometry optimization implementation.
+
+	The cache is modelled as FIFO with time stamps: a vertex is resident
+		if fewer than cacheSize vertices were inserted after it; advancing
+		time by more than cacheSize empties the cache.
+*/
+
+#include "../a3_DemoGeometryOptimize.h"
+#include "../a3_DemoMemory.h"
+
+#include "animal3D/a3/a3macros.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+
+// no vertex
+#define a3demo_geomOptNone	0xffffffffu
+
+// range of triangles drawn together
+typedef struct a3_DemoGeometryCluster
+{
+	a3ui32 first, count;
+	a3f32 sortKey;
+} a3_DemoGeometryCluster;
+
+
+//-----------------------------------------------------------------------------
+
+// count miss and insert vertex if not resident
+static a3ui32 a3demo_internalCacheAccess(a3ui32* stamp, a3ui32* time, a3ui32 const v, a3ui32 const cacheSize)
+{
+	if (*time - stamp[v] > cacheSize)
+	{
+		stamp[v] = (*time)++;
+		return 1;
+	}
+	return 0;
+}
+
+// misses of run of triangles starting with empty cache
+static a3ui32 a3demo_internalClusterMisses(a3ui32 const* index, a3ui32 const* order, a3ui32 const count, a3ui32* stamp, a3ui32* time, a3ui32 const cacheSize)
+{
+	a3ui32 i, misses = 0;
+	*time += cacheSize + 1;
+	for (i = 0; i < count; ++i)
+	{
+		misses += a3demo_internalCacheAccess(stamp, time, index[order[i] * 3 + 0], cacheSize);
+		misses += a3demo_internalCacheAccess(stamp, time, index[order[i] * 3 + 1], cacheSize);
+		misses += a3demo_internalCacheAccess(stamp, time, index[order[i] * 3 + 2], cacheSize);
+	}
+	return misses;
+}
+
+
+// Tipsify: fan around a vertex, then continue from the candidate that is
+//	still in cache and will not be evicted by its own remaining triangles;
+//	triangles that start with a cold cache are hard cluster boundaries
+static void a3demo_internalTipsify(a3ui32* order_out, a3ubyte* hardBoundary_out, a3ubyte* emitted,
+	a3ui32 const* index, a3ui32 const triangleCount, a3ui32 const vertexCount, a3ui32 const cacheSize, a3ui32* scratch)
+{
+	a3ui32* const offset = scratch;
+	a3ui32* const live = offset + vertexCount + 1;
+	a3ui32* const stamp = live + vertexCount;
+	a3ui32* const adjacency = stamp + vertexCount;
+	a3ui32* const deadEnd = adjacency + triangleCount * 3;
+	a3ui32* const candidate = deadEnd + triangleCount * 3;
+	a3ui32 time = cacheSize + 1, cursor = 0, deadEndCount = 0, candidateCount, emittedCount = 0;
+	a3ui32 i, j, t, v, f, best;
+	a3i32 priority, bestPriority;
+	a3boolean cold;
+
+	// triangles around each vertex
+	memset(live, 0, vertexCount * sizeof(a3ui32));
+	for (i = 0; i < triangleCount * 3; ++i)
+		++live[index[i]];
+	for (v = 0, offset[0] = 0; v < vertexCount; ++v)
+		offset[v + 1] = offset[v] + live[v];
+	memcpy(stamp, offset, vertexCount * sizeof(a3ui32));
+	for (i = 0; i < triangleCount * 3; ++i)
+		adjacency[stamp[index[i]]++] = i / 3;
+	memset(stamp, 0, vertexCount * sizeof(a3ui32));
+	memset(emitted, 0, triangleCount);
+	memset(hardBoundary_out, 0, triangleCount);
+
+	for (f = a3demo_geomOptNone; ; f = best)
+	{
+		// no candidate: next vertex in input order
+		cold = (f == a3demo_geomOptNone);
+		if (cold)
+		{
+			while (cursor < vertexCount && !live[cursor])
+				++cursor;
+			if (cursor == vertexCount)
+				break;
+			f = cursor;
+		}
+
+		// emit fan
+		candidateCount = 0;
+		for (i = offset[f]; i < offset[f + 1]; ++i)
+		{
+			t = adjacency[i];
+			if (emitted[t])
+				continue;
+			for (j = 0; j < 3; ++j)
+			{
+				v = index[t * 3 + j];
+				deadEnd[deadEndCount++] = v;
+				candidate[candidateCount++] = v;
+				--live[v];
+				a3demo_internalCacheAccess(stamp, &time, v, cacheSize);
+			}
+			emitted[t] = 1;
+			hardBoundary_out[emittedCount] = (a3ubyte)cold;
+			order_out[emittedCount++] = t;
+			cold = a3false;
+		}
+
+		// best candidate: oldest one still resident after its fan
+		best = a3demo_geomOptNone;
+		bestPriority = -1;
+		for (i = 0; i < candidateCount; ++i)
+		{
+			v = candidate[i];
+			if (live[v])
+			{
+				priority = 0;
+				if (time - stamp[v] + 2 * live[v] <= cacheSize)
+					priority = (a3i32)(time - stamp[v]);
+				if (priority > bestPriority)
+				{
+					best = v;
+					bestPriority = priority;
+				}
+			}
+		}
+
+		// dead end: most recently used vertex that still has triangles
+		while (best == a3demo_geomOptNone && deadEndCount)
+			if (live[deadEnd[--deadEndCount]])
+				best = deadEnd[deadEndCount];
+	}
+}
+
+// cluster sort: larger key draws first
+static int a3demo_internalClusterCompare(void const* a, void const* b)
+{
+	a3_DemoGeometryCluster const* const ca = (a3_DemoGeometryCluster const*)a;
+	a3_DemoGeometryCluster const* const cb = (a3_DemoGeometryCluster const*)b;
+	if (ca->sortKey != cb->sortKey)
+		return ca->sortKey > cb->sortKey ? -1 : +1;
+	return ca->first < cb->first ? -1 : ca->first > cb->first;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ui32 a3demo_measureVertexCache(a3ui32 const* index, a3ui32 const indexCount, a3ui32 const vertexCount, a3ui32 const cacheSize,
+	a3f64* acmr_out_opt, a3f64* atvr_out_opt)
+{
+	a3ui32* const stamp = (a3ui32*)a3demo_allocZero(((size_t)vertexCount + 1) * sizeof(a3ui32));
+	a3ui32 time = cacheSize + 1, misses = 0, i;
+	if (stamp && index)
+	{
+		for (i = 0; i < indexCount; ++i)
+			if (index[i] < vertexCount)
+				misses += a3demo_internalCacheAccess(stamp, &time, index[i], cacheSize);
+	}
+	a3demo_release(stamp);
+	if (acmr_out_opt)
+		*acmr_out_opt = indexCount >= 3 ? (a3f64)misses / (a3f64)(indexCount / 3) : 0.0;
+	if (atvr_out_opt)
+		*atvr_out_opt = vertexCount ? (a3f64)misses / (a3f64)vertexCount : 0.0;
+	return misses;
+}
+
+
+a3ret a3demo_optimizeGeometry(a3_GeometryData* geom, a3ui32 const cacheSize, a3f32 const overdrawThreshold,
+	a3_DemoGeometryOptimizeStats* stats_out_opt)
+{
+	// planar attribute streams: data, then second array following the first
+	struct {
+		a3_GeometryVertexAttributeName geomName;
+		a3_VertexAttributeName name, nameSecond;
+	} const stream[] = {
+		{ a3attrib_geomPosition, a3attrib_position, a3attrib_position },
+		{ a3attrib_geomNormal, a3attrib_normal, a3attrib_normal },
+		{ a3attrib_geomColor, a3attrib_color, a3attrib_color },
+		{ a3attrib_geomTexcoord, a3attrib_texcoord, a3attrib_texcoord },
+		{ a3attrib_geomTangent, a3attrib_tangent, a3attrib_bitangent },
+		{ a3attrib_geomBlending, a3attrib_blendWeights, a3attrib_blendIndices },
+	};
+
+	a3_DemoGeometryOptimizeStats stats = { 0 };
+	a3_DemoGeometryCluster* cluster = 0;
+	a3ui32* index = 0, * order = 0, * scratch = 0, * remap;
+	a3ubyte* boundary = 0, * src, * dst, * copy = 0;
+	a3ui32 vertexCount, triangleCount, clusterCount = 0;
+	a3ui32 i, j, k, s, t, size, time, misses, first;
+	a3f64 acmr;
+	a3f32 const* p[3], * position = 0;
+	a3ui32 positionStride = 0;
+	a3f32 e1[3], e2[3], n[3], c[3], area, meshCentroid[3] = { 0.0f }, meshArea = 0.0f;
+	a3ret result = 0;
+
+	if (!geom || !cacheSize)
+		return -1;
+	vertexCount = geom->numVertices;
+	triangleCount = geom->numIndices / 3;
+
+	// indexed triangle lists only
+	if (geom->primType != a3prim_triangles || !geom->data || !geom->indexData || !triangleCount || geom->numIndices % 3 ||
+		(geom->indexFormat->indexSize != 1 && geom->indexFormat->indexSize != 2 && geom->indexFormat->indexSize != 4))
+		goto done;
+
+	index = (a3ui32*)a3demo_alloc((size_t)triangleCount * 3 * sizeof(a3ui32));
+	order = (a3ui32*)a3demo_alloc((size_t)triangleCount * 2 * sizeof(a3ui32));
+	boundary = (a3ubyte*)a3demo_alloc((size_t)triangleCount * 2);
+	cluster = (a3_DemoGeometryCluster*)a3demo_alloc((size_t)triangleCount * sizeof(a3_DemoGeometryCluster));
+	scratch = (a3ui32*)a3demo_alloc(((size_t)vertexCount * 3 + 1 + (size_t)triangleCount * 9) * sizeof(a3ui32));
+	if (!index || !order || !boundary || !cluster || !scratch)
+		goto done;
+
+	// widen indices
+	for (i = 0; i < triangleCount * 3; ++i)
+	{
+		switch (geom->indexFormat->indexSize)
+		{
+		case 1: index[i] = ((a3ubyte const*)geom->indexData)[i]; break;
+		case 2: index[i] = ((a3ui16 const*)geom->indexData)[i]; break;
+		default: index[i] = ((a3ui32 const*)geom->indexData)[i]; break;
+		}
+		if (index[i] >= vertexCount)
+			goto done;
+	}
+	a3demo_measureVertexCache(index, triangleCount * 3, vertexCount, cacheSize, &stats.acmrBefore, &stats.atvrBefore);
+
+	// 1. vertex cache
+	a3demo_internalTipsify(order, boundary, boundary + triangleCount, index, triangleCount, vertexCount, cacheSize, scratch);
+
+	// 2. overdraw: split hard clusters where running ACMR is close enough
+	//	to the hard cluster's own, then sort clusters outside-in
+	if (geom->attribData[a3attrib_geomPosition] && geom->vertexFormat->attribSize[a3attrib_position] >= 3 * sizeof(a3f32))
+	{
+		position = (a3f32 const*)geom->attribData[a3attrib_geomPosition];
+		positionStride = geom->vertexFormat->attribSize[a3attrib_position] / sizeof(a3f32);
+	}
+	time = 0;
+	memset(scratch, 0, (size_t)vertexCount * sizeof(a3ui32));
+	for (i = 0; i < triangleCount; i = j)
+	{
+		for (j = i + 1; j < triangleCount && !boundary[j]; ++j);
+		if (overdrawThreshold > 0.0f && position)
+		{
+			acmr = (a3f64)a3demo_internalClusterMisses(index, order + i, j - i, scratch, &time, cacheSize) / (a3f64)(j - i);
+			time += cacheSize + 1;
+			for (first = i, misses = 0, k = i; k < j; ++k)
+			{
+				misses += a3demo_internalCacheAccess(scratch, &time, index[order[k] * 3 + 0], cacheSize);
+				misses += a3demo_internalCacheAccess(scratch, &time, index[order[k] * 3 + 1], cacheSize);
+				misses += a3demo_internalCacheAccess(scratch, &time, index[order[k] * 3 + 2], cacheSize);
+				if (k + 1 < j && (a3f64)misses <= (a3f64)overdrawThreshold * acmr * (a3f64)(k + 1 - first))
+				{
+					cluster[clusterCount].first = first;
+					cluster[clusterCount++].count = k + 1 - first;
+					first = k + 1;
+					misses = 0;
+					time += cacheSize + 1;
+				}
+			}
+			cluster[clusterCount].first = first;
+			cluster[clusterCount++].count = j - first;
+		}
+		else
+		{
+			cluster[clusterCount].first = i;
+			cluster[clusterCount++].count = j - i;
+		}
+	}
+
+	// sort key: distance of cluster centroid from mesh centroid along
+	//	cluster's average normal; all sums area-weighted
+	if (clusterCount > 1 && position)
+	{
+		a3f32* const clusterSum = (a3f32*)scratch;
+		for (k = 0; k < clusterCount; ++k)
+		{
+			a3f32* const sum = clusterSum + k * 7;
+			memset(sum, 0, 7 * sizeof(a3f32));
+			for (t = cluster[k].first; t < cluster[k].first + cluster[k].count; ++t)
+			{
+				for (s = 0; s < 3; ++s)
+					p[s] = position + index[order[t] * 3 + s] * positionStride;
+				for (s = 0; s < 3; ++s)
+				{
+					e1[s] = p[1][s] - p[0][s];
+					e2[s] = p[2][s] - p[0][s];
+				}
+				n[0] = e1[1] * e2[2] - e1[2] * e2[1];
+				n[1] = e1[2] * e2[0] - e1[0] * e2[2];
+				n[2] = e1[0] * e2[1] - e1[1] * e2[0];
+				area = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+				for (s = 0; s < 3; ++s)
+				{
+					c[s] = (p[0][s] + p[1][s] + p[2][s]) * area;
+					sum[s] += c[s];
+					sum[s + 3] += n[s];
+					meshCentroid[s] += c[s];
+				}
+				sum[6] += area;
+				meshArea += area;
+			}
+		}
+		for (s = 0; s < 3 && meshArea > 0.0f; ++s)
+			meshCentroid[s] /= meshArea;
+		for (k = 0; k < clusterCount; ++k)
+		{
+			a3f32 const* const sum = clusterSum + k * 7;
+			area = sqrtf(sum[3] * sum[3] + sum[4] * sum[4] + sum[5] * sum[5]);
+			cluster[k].sortKey = (area > 0.0f && sum[6] > 0.0f) ?
+				((sum[0] / sum[6] - meshCentroid[0]) * sum[3] +
+				(sum[1] / sum[6] - meshCentroid[1]) * sum[4] +
+				(sum[2] / sum[6] - meshCentroid[2]) * sum[5]) / area : 0.0f;
+		}
+		qsort(cluster, clusterCount, sizeof(a3_DemoGeometryCluster), a3demo_internalClusterCompare);
+	}
+	for (k = 0, t = 0; k < clusterCount; ++k)
+		for (i = 0; i < cluster[k].count; ++i)
+			order[triangleCount + t++] = order[cluster[k].first + i];
+
+	// 3. vertex fetch: number vertices by first use, unused ones last
+	remap = scratch;
+	for (i = 0; i < vertexCount; ++i)
+		remap[i] = a3demo_geomOptNone;
+	for (t = 0, k = 0; t < triangleCount; ++t)
+		for (s = 0; s < 3; ++s)
+		{
+			i = index[order[triangleCount + t] * 3 + s];
+			if (remap[i] == a3demo_geomOptNone)
+				remap[i] = k++;
+		}
+	for (i = 0; i < vertexCount; ++i)
+		if (remap[i] == a3demo_geomOptNone)
+			remap[i] = k++;
+
+	// permute every stream through one copy buffer
+	for (k = 0, size = 0; k < sizeof(stream) / sizeof(*stream); ++k)
+		if (geom->vertexFormat->attribSize[stream[k].name] > size)
+			size = geom->vertexFormat->attribSize[stream[k].name];
+	if (!(copy = (a3ubyte*)a3demo_alloc((size_t)vertexCount * size)))
+		goto done;
+	for (k = 0; k < sizeof(stream) / sizeof(*stream); ++k)
+	{
+		dst = (a3ubyte*)geom->attribData[stream[k].geomName];
+		if (!dst || !(size = geom->vertexFormat->attribSize[stream[k].name]))
+			continue;
+		for (j = 0; j < (stream[k].nameSecond != stream[k].name ? 2u : 1u); ++j)
+		{
+			src = copy;
+			memcpy(src, dst, (size_t)vertexCount * size);
+			for (i = 0; i < vertexCount; ++i)
+				memcpy(dst + (size_t)remap[i] * size, src + (size_t)i * size, size);
+			dst += (size_t)vertexCount * size;
+			size = geom->vertexFormat->attribSize[stream[k].nameSecond];
+		}
+	}
+
+	// write new indices in original size
+	for (t = 0; t < triangleCount; ++t)
+		for (s = 0; s < 3; ++s)
+			scratch[vertexCount + t * 3 + s] = remap[index[order[triangleCount + t] * 3 + s]];
+	memcpy(index, scratch + vertexCount, (size_t)triangleCount * 3 * sizeof(a3ui32));
+	for (i = 0; i < triangleCount * 3; ++i)
+		switch (geom->indexFormat->indexSize)
+		{
+		case 1: ((a3ubyte*)geom->indexData)[i] = (a3ubyte)index[i]; break;
+		case 2: ((a3ui16*)geom->indexData)[i] = (a3ui16)index[i]; break;
+		default: ((a3ui32*)geom->indexData)[i] = index[i]; break;
+		}
+	a3demo_measureVertexCache(index, triangleCount * 3, vertexCount, cacheSize, &stats.acmrAfter, &stats.atvrAfter);
+	stats.clusterCount = clusterCount;
+	stats.optimized = a3true;
+	result = 1;
+
+done:
+	if (stats_out_opt)
+	{
+		stats.vertexCount = geom ? geom->numVertices : 0;
+		stats.triangleCount = geom ? geom->numIndices / 3 : 0;
+		*stats_out_opt = stats;
+	}
+	a3demo_release(index);
+	a3demo_release(order);
+	a3demo_release(boundary);
+	a3demo_release(cluster);
+	a3demo_release(scratch);
+	a3demo_release(copy);
+	return result;
+}
+
+
+void a3demo_printGeometryOptimizeStats(a3_DemoGeometryOptimizeStats const* stats, a3byte const* name)
+{
+	if (stats && stats->optimized)
+		printf("\n A3 optimized '%s': %u triangles, %u vertices, %u clusters; ACMR %.3f -> %.3f, ATVR %.3f -> %.3f \n",
+			name ? name : (a3byte const*)"", stats->triangleCount, stats->vertexCount, stats->clusterCount,
+			stats->acmrBefore, stats->acmrAfter, stats->atvrBefore, stats->atvrAfter);
+	else if (stats)
+		printf("\n A3 optimize '%s': skipped (not an indexed triangle list) \n", name ? name : (a3byte const*)"");
+}
+
+
+//-----------------------------------------------------------------------------
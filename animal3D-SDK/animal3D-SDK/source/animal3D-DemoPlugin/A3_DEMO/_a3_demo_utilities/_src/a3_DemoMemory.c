@@ -0,0 +1,150 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoMemory.c
+	Counted allocator implementation.
+*/
+
+#include "../a3_DemoMemory.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif	// _WIN32
+
+
+//-----------------------------------------------------------------------------
+
+// block header stored just before aligned start
+typedef struct a3_DemoMemoryHeader
+{
+	void* base;
+	a3size size;
+} a3_DemoMemoryHeader;
+
+static a3_DemoMemoryCounters a3demo_memoryCounters;
+
+
+// counters are updated from any thread
+static void a3demo_internalMemoryCount(a3i64 volatile* count, a3i64 volatile* bytes, a3i64 const size)
+{
+#ifdef _WIN32
+	a3i64 const inUse = InterlockedExchangeAdd64(bytes, size) + size;
+	a3i64 peak = a3demo_memoryCounters.bytesPeak, seen;
+	InterlockedIncrement64(count);
+	while (peak < inUse && (seen = InterlockedCompareExchange64(&a3demo_memoryCounters.bytesPeak, inUse, peak)) != peak)
+		peak = seen;
+#else	// !_WIN32
+	a3i64 const inUse = __atomic_add_fetch(bytes, size, __ATOMIC_RELAXED);
+	a3i64 peak = __atomic_load_n(&a3demo_memoryCounters.bytesPeak, __ATOMIC_RELAXED);
+	__atomic_add_fetch(count, 1, __ATOMIC_RELAXED);
+	while (peak < inUse && !__atomic_compare_exchange_n(&a3demo_memoryCounters.bytesPeak, &peak, inUse, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+#endif	// _WIN32
+}
+
+
+//-----------------------------------------------------------------------------
+
+void* a3demo_allocAligned(a3size const size, a3size const alignment)
+{
+	a3size const align = alignment > (a3size)sizeof(a3_DemoMemoryHeader) ? alignment : (a3size)sizeof(a3_DemoMemoryHeader);
+	a3_DemoMemoryHeader* header;
+	void* base;
+	a3address start;
+
+	// alignment must be a power of two
+	if (size > 0 && alignment > 0 && !(alignment & (alignment - 1)))
+	{
+		// over-allocate so there is room for header before aligned start
+		base = malloc(size + align + sizeof(a3_DemoMemoryHeader));
+		if (base)
+		{
+			start = (a3address)a3demo_alignSize((a3address)base + sizeof(a3_DemoMemoryHeader), (a3address)align);
+			header = (a3_DemoMemoryHeader*)start - 1;
+			header->base = base;
+			header->size = size;
+
+			a3demo_internalMemoryCount(&a3demo_memoryCounters.allocCount, &a3demo_memoryCounters.bytesInUse, (a3i64)size);
+			return (void*)start;
+		}
+	}
+	return 0;
+}
+
+a3i32 a3demo_releaseAligned(void* block)
+{
+	a3_DemoMemoryHeader* header;
+	if (block)
+	{
+		header = (a3_DemoMemoryHeader*)block - 1;
+		a3demo_internalMemoryCount(&a3demo_memoryCounters.releaseCount, &a3demo_memoryCounters.bytesInUse, -(a3i64)header->size);
+		free(header->base);
+		return 1;
+	}
+	return -1;
+}
+
+void* a3demo_alloc(a3size const size)
+{
+	return a3demo_allocAligned(size ? size : 1, sizeof(a3_DemoMemoryHeader));
+}
+
+void* a3demo_allocZero(a3size const size)
+{
+	void* const block = a3demo_alloc(size);
+	if (block)
+		memset(block, 0, size);
+	return block;
+}
+
+void* a3demo_resize(void* block, a3size const size)
+{
+	void* const resized = a3demo_alloc(size);
+	a3size keep;
+	if (resized && block)
+	{
+		keep = ((a3_DemoMemoryHeader*)block - 1)->size;
+		memcpy(resized, block, keep < size ? keep : size);
+		a3demo_releaseAligned(block);
+	}
+	return resized;
+}
+
+a3i32 a3demo_release(void* block)
+{
+	return a3demo_releaseAligned(block);
+}
+
+a3_DemoMemoryCounters const* a3demo_getMemoryCounters(void)
+{
+	return &a3demo_memoryCounters;
+}
+
+a3i64 a3demo_getMemoryCallsSince(a3_DemoMemoryCounters const* snapshot)
+{
+	if (snapshot)
+		return (a3demo_memoryCounters.allocCount - snapshot->allocCount) + (a3demo_memoryCounters.releaseCount - snapshot->releaseCount);
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,589 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoMeshlet.c
+	Meshlet implementation.
+
+	Meshlets are made in two separate steps so that only the first needs
+		to run before geometry is cached:
+		1. order: triangles are regrouped into runs that fit the limits;
+			a run grows by the unused triangle around its vertices that
+			adds fewest new ones and turns least from the run's average
+			normal, or else by the next unused triangle in existing
+			order, and ends when that one does not fit
+		2. describe: ordered triangles are split again the same way,
+			taking each while it fits, which gives back the same runs;
+			each gets a local vertex list, local indices and bounds
+	Bounds follow the usual meshlet tests: the sphere is centered on the
+		meshlet's box; the cone axis is the average unit face normal, its
+		cutoff is the sine of the widest angle between a face normal and
+		the axis, and its apex is the point on the axis behind every face.
+		A meshlet is facing away when either
+			dot(apex - viewer, axis) >= cutoff * |apex - viewer|
+			dot(center - viewer, axis) >= cutoff * |center - viewer| + radius
+		Meshlets whose normals spread past a right angle never cull.
+*/
+
+#include "../a3_DemoMeshlet.h"
+#include "../a3_DemoMemory.h"
+#include "../a3_DemoPlatform.h"
+
+#include "animal3D/a3/a3macros.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+// utilities
+
+// widen first indices of geometry; returns null if memory ran out or an
+//	index is out of range
+static a3ui32* a3demo_internalMeshletIndices(a3_GeometryData const* geom, a3ui32 const count)
+{
+	a3ui32* const index = (a3ui32*)a3demo_alloc((size_t)count * sizeof(a3ui32) + 1);
+	a3ui32 i;
+	if (index)
+		for (i = 0; i < count; ++i)
+		{
+			switch (geom->indexFormat->indexSize)
+			{
+			case 1: index[i] = ((a3ubyte const*)geom->indexData)[i]; break;
+			case 2: index[i] = ((a3ui16 const*)geom->indexData)[i]; break;
+			default: index[i] = ((a3ui32 const*)geom->indexData)[i]; break;
+			}
+			if (index[i] >= geom->numVertices)
+			{
+				a3demo_release(index);
+				return 0;
+			}
+		}
+	return index;
+}
+
+// vertices of triangle not yet in current meshlet (marked with stamp)
+static a3ui32 a3demo_internalMeshletNewCount(a3ui32 const* tri, a3ui32 const* mark, a3ui32 const stamp)
+{
+	return (mark[tri[0]] != stamp) +
+		(mark[tri[1]] != stamp && tri[1] != tri[0]) +
+		(mark[tri[2]] != stamp && tri[2] != tri[0] && tri[2] != tri[1]);
+}
+
+// split ordered triangles into meshlets, taking each while it fits;
+//	counts only if set is null, otherwise fills meshlet ranges, vertex
+//	list and local indices; returns meshlet count
+static a3ui32 a3demo_internalMeshletSplit(a3_DemoMeshletSet* set_opt, a3ui32* vertexTotal_out, a3ui32 const* index, a3ui32 const triangleCount,
+	a3ui32* mark, a3ui32* local, a3ui32 const maxVertices, a3ui32 const maxTriangles)
+{
+	a3_DemoMeshlet* meshlet = 0;
+	a3ui32 const* tri;
+	a3ui32 meshletCount = 0, vertexTotal = 0, vertexCount = 0, count = 0, t, j, v, l;
+
+	for (t = 0; t < triangleCount; ++t)
+	{
+		tri = index + t * 3;
+		if (!meshletCount || count == maxTriangles ||
+			vertexCount + a3demo_internalMeshletNewCount(tri, mark, meshletCount) > maxVertices)
+		{
+			// new meshlet; stamp is its number
+			++meshletCount;
+			vertexCount = count = 0;
+			if (set_opt)
+			{
+				meshlet = set_opt->meshlet + meshletCount - 1;
+				meshlet->vertexOffset = vertexTotal;
+				meshlet->triangleOffset = t;
+			}
+		}
+		for (j = 0; j < 3; ++j)
+		{
+			v = tri[j];
+			if (mark[v] != meshletCount)
+			{
+				mark[v] = meshletCount;
+				local[v] = vertexCount++;
+				if (set_opt)
+					set_opt->vertex[vertexTotal] = v;
+				++vertexTotal;
+			}
+			if (set_opt)
+			{
+				l = t * 3 + j;
+				switch (set_opt->localIndexFormat->indexSize)
+				{
+				case 1: ((a3ubyte*)set_opt->localIndex)[l] = (a3ubyte)local[v]; break;
+				case 2: ((a3ui16*)set_opt->localIndex)[l] = (a3ui16)local[v]; break;
+				default: ((a3ui32*)set_opt->localIndex)[l] = local[v]; break;
+				}
+			}
+		}
+		++count;
+		if (meshlet)
+		{
+			meshlet->vertexCount = vertexCount;
+			meshlet->triangleCount = count;
+		}
+	}
+	*vertexTotal_out = vertexTotal;
+	return meshletCount;
+}
+
+// bounding sphere and normal cone of meshlet
+static void a3demo_internalMeshletBounds(a3_DemoMeshlet* meshlet, a3_DemoMeshletSet const* set, a3ui32 const* index,
+	a3f32 const* position, a3ui32 const positionStride)
+{
+	a3f32 const* p0, * p1, * p2;
+	a3f32 lo[3], hi[3], e1[3], e2[3], n[3], axis[3] = { 0.0f }, len, d, minDot = 1.0f, apexDist = 0.0f;
+	a3ui32 i, k, t, faceCount = 0;
+
+	// sphere around box
+	p0 = position + set->vertex[meshlet->vertexOffset] * positionStride;
+	for (k = 0; k < 3; ++k)
+		lo[k] = hi[k] = p0[k];
+	for (i = 1; i < meshlet->vertexCount; ++i)
+	{
+		p0 = position + set->vertex[meshlet->vertexOffset + i] * positionStride;
+		for (k = 0; k < 3; ++k)
+		{
+			lo[k] = p0[k] < lo[k] ? p0[k] : lo[k];
+			hi[k] = p0[k] > hi[k] ? p0[k] : hi[k];
+		}
+	}
+	for (k = 0; k < 3; ++k)
+		meshlet->center[k] = (lo[k] + hi[k]) * 0.5f;
+	meshlet->radius = 0.0f;
+	for (i = 0; i < meshlet->vertexCount; ++i)
+	{
+		p0 = position + set->vertex[meshlet->vertexOffset + i] * positionStride;
+		d = (p0[0] - meshlet->center[0]) * (p0[0] - meshlet->center[0]) +
+			(p0[1] - meshlet->center[1]) * (p0[1] - meshlet->center[1]) +
+			(p0[2] - meshlet->center[2]) * (p0[2] - meshlet->center[2]);
+		meshlet->radius = d > meshlet->radius ? d : meshlet->radius;
+	}
+	meshlet->radius = sqrtf(meshlet->radius);
+
+	// cone: average unit normal, then widest angle from it
+	for (i = 0; i < 2; ++i)
+	{
+		for (t = meshlet->triangleOffset; t < meshlet->triangleOffset + meshlet->triangleCount; ++t)
+		{
+			p0 = position + index[t * 3 + 0] * positionStride;
+			p1 = position + index[t * 3 + 1] * positionStride;
+			p2 = position + index[t * 3 + 2] * positionStride;
+			for (k = 0; k < 3; ++k)
+			{
+				e1[k] = p1[k] - p0[k];
+				e2[k] = p2[k] - p0[k];
+			}
+			n[0] = e1[1] * e2[2] - e1[2] * e2[1];
+			n[1] = e1[2] * e2[0] - e1[0] * e2[2];
+			n[2] = e1[0] * e2[1] - e1[1] * e2[0];
+			len = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+			if (len <= 0.0f)
+				continue;
+			if (i == 0)
+			{
+				for (k = 0; k < 3; ++k)
+					axis[k] += n[k] / len;
+				++faceCount;
+			}
+			else
+			{
+				// apex: farthest point back along axis from center that is
+				//	behind every face plane
+				d = n[0] * axis[0] + n[1] * axis[1] + n[2] * axis[2];
+				minDot = d / len < minDot ? d / len : minDot;
+				if (d > 0.0f)
+				{
+					d = ((meshlet->center[0] - p0[0]) * n[0] + (meshlet->center[1] - p0[1]) * n[1] + (meshlet->center[2] - p0[2]) * n[2]) / d;
+					apexDist = d > apexDist ? d : apexDist;
+				}
+			}
+		}
+		if (i == 0)
+		{
+			len = sqrtf(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+			if (!faceCount || len <= 0.0f)
+			{
+				minDot = 0.0f;
+				break;
+			}
+			for (k = 0; k < 3; ++k)
+				axis[k] /= len;
+		}
+	}
+	for (k = 0; k < 3; ++k)
+	{
+		meshlet->coneAxis[k] = axis[k];
+		meshlet->coneApex[k] = meshlet->center[k] - axis[k] * apexDist;
+	}
+	meshlet->coneCutoff = minDot > 0.0f ? sqrtf(1.0f - minDot * minDot) : 1.0f;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_orderGeometryMeshlets(a3_GeometryData* geom, a3ui32 const indexCount, a3ui32 const maxVertices, a3ui32 const maxTriangles, a3f32 const coneWeight)
+{
+	a3ui32* index = 0, * order = 0, * adjFirst = 0, * adjList = 0, * mark = 0, * vertex = 0;
+	a3f32* faceNormal = 0;
+	a3ubyte* used = 0;
+	a3ui32 const* tri;
+	a3f32 const* position, * p0, * p1, * p2;
+	a3f32 cone[3], e1[3], e2[3], len, score, bestScore;
+	a3ui32 triangleCount, vertexCount, positionStride, meshletCount = 0, placed = 0, next = 0;
+	a3ui32 vc = 0, tc = 0, best, bestNew, n, t, i, j, k, v;
+	a3ret result = 0;
+
+	if (!geom || maxVertices < 3 || !maxTriangles)
+		return -1;
+	triangleCount = (indexCount ? indexCount : geom->numIndices) / 3;
+	vertexCount = geom->numVertices;
+	if (geom->primType != a3prim_triangles || !geom->data || !geom->indexData || !triangleCount ||
+		triangleCount * 3 > geom->numIndices || (indexCount % 3) ||
+		!geom->attribData[a3attrib_geomPosition] || geom->vertexFormat->attribSize[a3attrib_position] < 3 * sizeof(a3f32))
+		return 0;
+	position = (a3f32 const*)geom->attribData[a3attrib_geomPosition];
+	positionStride = geom->vertexFormat->attribSize[a3attrib_position] / sizeof(a3f32);
+
+	// unit face normals and triangles around each vertex
+	index = a3demo_internalMeshletIndices(geom, triangleCount * 3);
+	order = (a3ui32*)a3demo_alloc((size_t)triangleCount * 3 * sizeof(a3ui32) + 1);
+	adjFirst = (a3ui32*)a3demo_allocZero(((size_t)vertexCount + 1) * sizeof(a3ui32));
+	adjList = (a3ui32*)a3demo_alloc((size_t)triangleCount * 3 * sizeof(a3ui32) + 1);
+	mark = (a3ui32*)a3demo_allocZero(((size_t)vertexCount + 1) * sizeof(a3ui32));
+	vertex = (a3ui32*)a3demo_alloc((size_t)maxVertices * sizeof(a3ui32));
+	used = (a3ubyte*)a3demo_allocZero((size_t)triangleCount + 1);
+	faceNormal = (a3f32*)a3demo_alloc((size_t)triangleCount * 3 * sizeof(a3f32) + 1);
+	if (!index || !order || !adjFirst || !adjList || !mark || !vertex || !used || !faceNormal)
+		goto done;
+	for (t = 0; t < triangleCount; ++t)
+	{
+		p0 = position + index[t * 3 + 0] * positionStride;
+		p1 = position + index[t * 3 + 1] * positionStride;
+		p2 = position + index[t * 3 + 2] * positionStride;
+		for (k = 0; k < 3; ++k)
+		{
+			e1[k] = p1[k] - p0[k];
+			e2[k] = p2[k] - p0[k];
+		}
+		faceNormal[t * 3 + 0] = e1[1] * e2[2] - e1[2] * e2[1];
+		faceNormal[t * 3 + 1] = e1[2] * e2[0] - e1[0] * e2[2];
+		faceNormal[t * 3 + 2] = e1[0] * e2[1] - e1[1] * e2[0];
+		len = sqrtf(faceNormal[t * 3 + 0] * faceNormal[t * 3 + 0] + faceNormal[t * 3 + 1] * faceNormal[t * 3 + 1] + faceNormal[t * 3 + 2] * faceNormal[t * 3 + 2]);
+		len = len > 0.0f ? 1.0f / len : 0.0f;
+		for (k = 0; k < 3; ++k)
+			faceNormal[t * 3 + k] *= len;
+	}
+	for (i = 0; i < triangleCount * 3; ++i)
+		++adjFirst[index[i] + 1];
+	for (v = 0; v < vertexCount; ++v)
+		adjFirst[v + 1] += adjFirst[v];
+	for (i = 0; i < triangleCount * 3; ++i)
+		adjList[adjFirst[index[i]]++] = i / 3;
+	for (v = vertexCount; v > 0; --v)
+		adjFirst[v] = adjFirst[v - 1];
+	adjFirst[0] = 0;
+
+	// grow meshlets; stamp of current meshlet is its number
+	while (placed < triangleCount)
+	{
+		best = triangleCount;
+		bestNew = 4;
+		if (tc)
+		{
+			// neighbor adding fewest vertices, plus weighted turn away
+			//	from meshlet's average normal; first found on ties
+			len = sqrtf(cone[0] * cone[0] + cone[1] * cone[1] + cone[2] * cone[2]);
+			len = len > 0.0f ? coneWeight / len : 0.0f;
+			bestScore = 4.0f + coneWeight * 2.0f;
+			for (i = 0; i < vc; ++i)
+				for (j = adjFirst[vertex[i]]; j < adjFirst[vertex[i] + 1]; ++j)
+				{
+					t = adjList[j];
+					if (used[t] || vc + (n = a3demo_internalMeshletNewCount(index + t * 3, mark, meshletCount)) > maxVertices)
+						continue;
+					score = (a3f32)n + coneWeight - len *
+						(faceNormal[t * 3 + 0] * cone[0] + faceNormal[t * 3 + 1] * cone[1] + faceNormal[t * 3 + 2] * cone[2]);
+					if (score < bestScore)
+					{
+						best = t;
+						bestNew = n;
+						bestScore = score;
+					}
+				}
+		}
+		if (best == triangleCount)
+		{
+			// next unused triangle in existing order
+			while (used[next])
+				++next;
+			best = next;
+			bestNew = a3demo_internalMeshletNewCount(index + best * 3, mark, meshletCount);
+		}
+		if (!tc || vc + bestNew > maxVertices)
+		{
+			++meshletCount;
+			vc = tc = 0;
+			cone[0] = cone[1] = cone[2] = 0.0f;
+		}
+
+		// add triangle
+		tri = index + best * 3;
+		for (j = 0; j < 3; ++j)
+			if (mark[tri[j]] != meshletCount)
+			{
+				mark[tri[j]] = meshletCount;
+				vertex[vc++] = tri[j];
+			}
+		memcpy(order + placed * 3, tri, 3 * sizeof(a3ui32));
+		for (k = 0; k < 3; ++k)
+			cone[k] += faceNormal[best * 3 + k];
+		used[best] = 1;
+		++placed;
+		if (++tc == maxTriangles)
+			tc = 0;
+	}
+
+	// write back in index size
+	for (i = 0; i < triangleCount * 3; ++i)
+		switch (geom->indexFormat->indexSize)
+		{
+		case 1: ((a3ubyte*)geom->indexData)[i] = (a3ubyte)order[i]; break;
+		case 2: ((a3ui16*)geom->indexData)[i] = (a3ui16)order[i]; break;
+		default: ((a3ui32*)geom->indexData)[i] = order[i]; break;
+		}
+	result = meshletCount;
+
+done:
+	a3demo_release(index);
+	a3demo_release(order);
+	a3demo_release(adjFirst);
+	a3demo_release(adjList);
+	a3demo_release(mark);
+	a3demo_release(vertex);
+	a3demo_release(used);
+	a3demo_release(faceNormal);
+	return result;
+}
+
+
+a3ret a3demo_createGeometryMeshlets(a3_DemoMeshletSet* set_out, a3_GeometryData const* geom, a3ui32 const indexCount,
+	a3ui32 const maxVertices, a3ui32 const maxTriangles, a3_IndexFormatDescriptor const* drawIndexFormat_opt, a3_DemoMeshletStats* stats_out_opt)
+{
+	a3_DemoMeshletSet set[1] = { 0 };
+	a3_DemoMeshletStats stats = { 0 };
+	a3ui32* index = 0, * mark = 0, * local = 0;
+	a3f32 const* position;
+	a3ui32 triangleCount, vertexTotal, positionStride, i;
+	size_t meshletBytes, vertexBytes, localBytes;
+	a3f64 const timeStart = a3demo_getTime();
+	a3ret result = 0;
+
+	if (!set_out || !geom || set_out->data || maxVertices < 3 || !maxTriangles)
+		return -1;
+	triangleCount = (indexCount ? indexCount : geom->numIndices) / 3;
+	if (geom->primType != a3prim_triangles || !geom->indexData || !triangleCount ||
+		triangleCount * 3 > geom->numIndices || (indexCount % 3) ||
+		!geom->attribData[a3attrib_geomPosition] || geom->vertexFormat->attribSize[a3attrib_position] < 3 * sizeof(a3f32))
+		return 0;
+	position = (a3f32 const*)geom->attribData[a3attrib_geomPosition];
+	positionStride = geom->vertexFormat->attribSize[a3attrib_position] / sizeof(a3f32);
+
+	// count, then fill one block: meshlets, ranges, vertex list, local indices
+	index = a3demo_internalMeshletIndices(geom, triangleCount * 3);
+	mark = (a3ui32*)a3demo_allocZero(((size_t)geom->numVertices + 1) * sizeof(a3ui32));
+	local = (a3ui32*)a3demo_alloc((size_t)geom->numVertices * sizeof(a3ui32) + 1);
+	if (!index || !mark || !local)
+		goto done;
+	set->meshletCount = a3demo_internalMeshletSplit(0, &vertexTotal, index, triangleCount, mark, local, maxVertices, maxTriangles);
+	set->vertexCount = vertexTotal;
+	set->triangleCount = triangleCount;
+	set->drawIndexSize = (drawIndexFormat_opt ? drawIndexFormat_opt : geom->indexFormat)->indexSize;
+	a3geometryCreateIndexFormat(set->localIndexFormat, maxVertices);
+	meshletBytes = (size_t)set->meshletCount * (sizeof(a3_DemoMeshlet) + 2 * sizeof(a3ui32));
+	vertexBytes = (size_t)vertexTotal * sizeof(a3ui32);
+	localBytes = (size_t)triangleCount * 3 * set->localIndexFormat->indexSize;
+	if (!(set->data = a3demo_alloc(meshletBytes + vertexBytes + localBytes)))
+		goto done;
+	set->meshlet = (a3_DemoMeshlet*)set->data;
+	set->range = (a3ui32*)(set->meshlet + set->meshletCount);
+	set->vertex = set->range + set->meshletCount * 2;
+	set->localIndex = set->vertex + vertexTotal;
+	memset(mark, 0, (size_t)geom->numVertices * sizeof(a3ui32));
+	a3demo_internalMeshletSplit(set, &vertexTotal, index, triangleCount, mark, local, maxVertices, maxTriangles);
+	for (i = 0; i < set->meshletCount; ++i)
+		a3demo_internalMeshletBounds(set->meshlet + i, set, index, position, positionStride);
+
+	*set_out = *set;
+	stats.meshletCount = set->meshletCount;
+	stats.triangleCount = triangleCount;
+	stats.vertexCount = vertexTotal;
+	stats.localIndexSize = set->localIndexFormat->indexSize;
+	stats.fillVertex = (a3f32)vertexTotal / (a3f32)(set->meshletCount * maxVertices);
+	stats.fillTriangle = (a3f32)triangleCount / (a3f32)(set->meshletCount * maxTriangles);
+	result = set->meshletCount;
+
+done:
+	if (stats_out_opt)
+	{
+		stats.time = a3demo_getTime() - timeStart;
+		*stats_out_opt = stats;
+	}
+	a3demo_release(index);
+	a3demo_release(mark);
+	a3demo_release(local);
+	return result;
+}
+
+
+a3ret a3demo_releaseGeometryMeshlets(a3_DemoMeshletSet* set)
+{
+	if (set)
+	{
+		a3demo_release(set->data);
+		memset(set, 0, sizeof(a3_DemoMeshletSet));
+		return 1;
+	}
+	return -1;
+}
+
+
+a3ret a3demo_cullGeometryMeshlets(a3_DemoMeshletSet* set, a3real const* mvp, a3real const* viewPosition, a3_DemoMeshletCullStats* stats_out_opt)
+{
+	a3_DemoMeshletCullStats stats = { 0 };
+	a3_DemoMeshlet const* meshlet;
+	a3f32 const* c;
+	a3f32 plane[6][4], d[3], dist, len;
+	a3ui32 i, k, first, count, rangeCount = 0;
+
+	if (!set || !mvp || !viewPosition)
+		return -1;
+
+	// frustum planes in object space from rows of column-major matrix
+	//	(w + x, w - x, w + y, w - y, w + z, w - z), unit normals
+	for (i = 0; i < 6; ++i)
+	{
+		for (k = 0; k < 4; ++k)
+			plane[i][k] = (a3f32)(mvp[k * 4 + 3] + (i & 1 ? -mvp[k * 4 + i / 2] : mvp[k * 4 + i / 2]));
+		len = sqrtf(plane[i][0] * plane[i][0] + plane[i][1] * plane[i][1] + plane[i][2] * plane[i][2]);
+		len = len > 0.0f ? 1.0f / len : 0.0f;
+		for (k = 0; k < 4; ++k)
+			plane[i][k] *= len;
+	}
+
+	for (i = 0, meshlet = set->meshlet; i < set->meshletCount; ++i, ++meshlet)
+	{
+		// outside any plane
+		for (k = 0; k < 6; ++k)
+			if (plane[k][0] * meshlet->center[0] + plane[k][1] * meshlet->center[1] + plane[k][2] * meshlet->center[2] + plane[k][3] < -meshlet->radius)
+				break;
+		if (k < 6)
+		{
+			++stats.frustumCount;
+			continue;
+		}
+
+		// every face turned away from viewer: viewer inside cone behind
+		//	apex, or behind the sphere in the cone grown by the radius
+		for (k = 0; k < 2; ++k)
+		{
+			c = k ? meshlet->center : meshlet->coneApex;
+			d[0] = c[0] - (a3f32)viewPosition[0];
+			d[1] = c[1] - (a3f32)viewPosition[1];
+			d[2] = c[2] - (a3f32)viewPosition[2];
+			dist = sqrtf(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+			if (d[0] * meshlet->coneAxis[0] + d[1] * meshlet->coneAxis[1] + d[2] * meshlet->coneAxis[2] >= meshlet->coneCutoff * dist + (k ? meshlet->radius : 0.0f))
+				break;
+		}
+		if (k < 2)
+		{
+			++stats.coneCount;
+			continue;
+		}
+
+		// visible: join with previous range if it ends here
+		first = meshlet->triangleOffset * 3;
+		count = meshlet->triangleCount * 3;
+		if (rangeCount && set->range[rangeCount * 2 - 2] + set->range[rangeCount * 2 - 1] == first)
+			set->range[rangeCount * 2 - 1] += count;
+		else
+		{
+			set->range[rangeCount * 2 + 0] = first;
+			set->range[rangeCount * 2 + 1] = count;
+			++rangeCount;
+		}
+		stats.triangleCount += meshlet->triangleCount;
+	}
+
+	if (stats_out_opt)
+	{
+		stats.meshletCount = set->meshletCount;
+		stats.rangeCount = rangeCount;
+		stats.triangleTotal = set->triangleCount;
+		*stats_out_opt = stats;
+	}
+	return rangeCount;
+}
+
+
+a3ret a3demo_renderGeometryMeshlets(a3_DemoMeshletSet const* set, a3_VertexDrawable const* drawable, a3ui32 const rangeCount)
+{
+	a3_VertexDrawable range[1];
+	a3ui32 i;
+
+	if (!set || !drawable || !drawable->indexType || rangeCount > set->meshletCount)
+		return -1;
+
+	// copy of drawable is active while its range changes, then the
+	//	original is made active again
+	*range = *drawable;
+	a3vertexDrawableActivate(range);
+	for (i = 0; i < rangeCount; ++i)
+	{
+		range->indexing = (a3byte const*)drawable->indexing + set->range[i * 2] * set->drawIndexSize;
+		range->count = set->range[i * 2 + 1];
+		a3vertexDrawableRenderActive();
+	}
+	a3vertexDrawableActivate(drawable);
+	return rangeCount;
+}
+
+
+void a3demo_printMeshletStats(a3_DemoMeshletStats const* stats, a3byte const* name)
+{
+	if (stats)
+		printf("\n A3 meshlets '%s': %u triangles in %u meshlets (%u vertices, %u-byte local indices) in %.2f ms; %.0f%% of vertex limit, %.0f%% of triangle limit used \n",
+			name ? name : (a3byte const*)"", stats->triangleCount, stats->meshletCount, stats->vertexCount, stats->localIndexSize,
+			stats->time * 1000.0, stats->fillVertex * 100.0f, stats->fillTriangle * 100.0f);
+}
+
+void a3demo_printMeshletCullStats(a3_DemoMeshletCullStats const* stats, a3byte const* name)
+{
+	if (stats)
+		printf("\n A3 meshlet cull '%s': %u of %u triangles in %u ranges; %u of %u meshlets outside frustum, %u facing away \n",
+			name ? name : (a3byte const*)"", stats->triangleCount, stats->triangleTotal, stats->rangeCount,
+			stats->frustumCount, stats->meshletCount, stats->coneCount);
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,843 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoModelLoader.c
+	Parallel OBJ loader implementation.
+
+	Loading runs in three steps:
+		1. count: every chunk counts its 'v', 'vt', 'vn' and 'f' records;
+			prefix sums give each chunk the number of records before it
+		2. parse: every chunk parses its records straight into the shared
+			attribute arrays at its own offset, so attributes need no merge;
+			negative (relative) indices resolve against the counts before
+			the chunk; faces are fan-triangulated into chunk-local lists
+		3. merge: triangle lists are walked in chunk order and corners are
+			welded by hash into unique vertices, so the result does not
+			depend on the number of threads
+*/
+
+#include "../a3_DemoModelLoader.h"
+#include "../a3_DemoFileMap.h"
+#include "../a3_DemoTangentBasis.h"
+#include "../a3_DemoMemory.h"
+#include "../a3_DemoPlatform.h"
+
+#include "animal3D/a3/a3macros.h"
+#include "animal3D/a3utility/a3_Thread.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+
+// corner component not given
+#define a3demo_objNone		(-1)
+
+// corner component out of range
+#define a3demo_objInvalid	(-2)
+
+// loader flag bits the library only names in combination: tangents (8) and 
+//	vertex normals (16) are what each flag adds to the one below it
+#define a3demo_objFlagTangents	(a3model_calculateFaceTangents ^ a3model_calculateFaceNormals_loadTexcoords)
+#define a3demo_objFlagVertex	(a3model_calculateVertexNormals ^ a3model_calculateFaceNormals)
+
+// record kinds
+typedef enum a3_DemoOBJRecord
+{
+	a3demoOBJ_other,
+	a3demoOBJ_position,
+	a3demoOBJ_texcoord,
+	a3demoOBJ_normal,
+	a3demoOBJ_face,
+} a3_DemoOBJRecord;
+
+// record counts
+typedef struct a3_DemoOBJCount
+{
+	a3ui32 position, texcoord, normal, face;
+} a3_DemoOBJCount;
+
+// data shared by all chunks
+typedef struct a3_DemoOBJShared
+{
+	a3f32* position;						// 3 per 'v'
+	a3f32* texcoord;						// 2 per 'vt'
+	a3f32* normal;							// 3 per 'vn'
+	a3f32 const* transform;					// column-major position transform
+	a3f32 normalTransform[9];				// column-major normal transform
+	a3_DemoOBJCount total;					// records in file
+} a3_DemoOBJShared;
+
+// one line-aligned piece of the file
+typedef struct a3_DemoOBJChunk
+{
+	a3byte const* begin;
+	a3byte const* end;
+	a3_DemoOBJShared* shared;
+	a3_DemoOBJCount count;					// records in chunk
+	a3_DemoOBJCount base;					// records before chunk
+	a3i32* corner;							// (v, vt, vn) per corner, three corners per triangle
+	a3ui32* polygon;						// chunk-local polygon per triangle
+	a3i32* scratch;							// corners of polygon being read
+	a3ui32 triangleCount, triangleCapacity, scratchCapacity;
+	a3ui32 polygonCount, ngonCount;
+	a3boolean error;
+	a3boolean launched;						// parsed on its own thread
+	a3_Thread thread[1];
+} a3_DemoOBJChunk;
+
+
+// exact powers of ten for float parsing
+static a3f64 const a3demo_objPow10[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+
+//-----------------------------------------------------------------------------
+// utilities
+
+static void a3demo_internalCross(a3f32* v_out, a3f32 const* a, a3f32 const* b)
+{
+	v_out[0] = a[1] * b[2] - a[2] * b[1];
+	v_out[1] = a[2] * b[0] - a[0] * b[2];
+	v_out[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+static a3f32 a3demo_internalNormalize(a3f32* v)
+{
+	a3f32 const lenSq = v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+	a3f32 lenInv;
+	if (lenSq > 0.0f)
+	{
+		lenInv = 1.0f / sqrtf(lenSq);
+		v[0] *= lenInv;
+		v[1] *= lenInv;
+		v[2] *= lenInv;
+	}
+	return lenSq;
+}
+
+
+//-----------------------------------------------------------------------------
+// parsing
+
+static a3boolean a3demo_objIsSpace(a3byte const c)
+{
+	return (c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f');
+}
+
+static a3byte const* a3demo_objSkipSpace(a3byte const* c, a3byte const* const end)
+{
+	while (c < end && a3demo_objIsSpace(*c))
+		++c;
+	return c;
+}
+
+// record kind from line start; c points past keyword on return
+static a3_DemoOBJRecord a3demo_objRecord(a3byte const** c_inout, a3byte const* const end)
+{
+	a3byte const* c = *c_inout;
+	a3_DemoOBJRecord record = a3demoOBJ_other;
+	a3size n = 0;
+	if (c < end)
+	{
+		if (c[0] == 'v')
+		{
+			if (c + 1 < end && a3demo_objIsSpace(c[1]))
+				record = a3demoOBJ_position, n = 1;
+			else if (c + 2 < end && a3demo_objIsSpace(c[2]))
+			{
+				if (c[1] == 't')
+					record = a3demoOBJ_texcoord, n = 2;
+				else if (c[1] == 'n')
+					record = a3demoOBJ_normal, n = 2;
+			}
+		}
+		else if (c[0] == 'f' && c + 1 < end && a3demo_objIsSpace(c[1]))
+			record = a3demoOBJ_face, n = 1;
+	}
+	*c_inout = c + n;
+	return record;
+}
+
+// decimal number with optional sign, fraction and exponent; returns c if none
+static a3byte const* a3demo_objParseFloat(a3byte const* const c, a3byte const* const end, a3f32* value_out)
+{
+	a3byte const* p = c;
+	a3byte const* exponentStart;
+	a3ui64 mantissa = 0;
+	a3i32 exponent = 0, exponentValue = 0, digits = 0;
+	a3boolean negative = a3false, negativeExponent = a3false;
+	a3f64 value;
+	a3ui32 d;
+
+	if (p < end && (*p == '-' || *p == '+'))
+		negative = (*p++ == '-');
+
+	// keep 17 significant digits; further integer digits only scale
+	for (; p < end && (d = (a3ui32)(*p - '0')) < 10; ++p, ++digits)
+		if (mantissa < 100000000000000000ull)
+			mantissa = mantissa * 10 + d;
+		else
+			++exponent;
+	if (p < end && *p == '.')
+		for (++p; p < end && (d = (a3ui32)(*p - '0')) < 10; ++p, ++digits)
+			if (mantissa < 100000000000000000ull)
+			{
+				mantissa = mantissa * 10 + d;
+				--exponent;
+			}
+	if (!digits)
+		return c;
+
+	if (p < end && (*p == 'e' || *p == 'E'))
+	{
+		exponentStart = p++;
+		if (p < end && (*p == '-' || *p == '+'))
+			negativeExponent = (*p++ == '-');
+		if (p < end && (a3ui32)(*p - '0') < 10)
+		{
+			for (; p < end && (d = (a3ui32)(*p - '0')) < 10; ++p)
+				if (exponentValue < 1000)
+					exponentValue = exponentValue * 10 + d;
+			exponent += negativeExponent ? -exponentValue : exponentValue;
+		}
+		else
+			p = exponentStart;
+	}
+
+	// exact for up to 15 digits within the table; float output hides the rest
+	value = (a3f64)mantissa;
+	if (exponent < 0)
+		value = exponent >= -22 ? value / a3demo_objPow10[-exponent] : value * pow(10.0, exponent);
+	else if (exponent > 0)
+		value = exponent <= 22 ? value * a3demo_objPow10[exponent] : value * pow(10.0, exponent);
+	*value_out = (a3f32)(negative ? -value : value);
+	return p;
+}
+
+// integer with optional sign; returns c if none
+static a3byte const* a3demo_objParseInt(a3byte const* const c, a3byte const* const end, a3i32* value_out)
+{
+	a3byte const* p = c;
+	a3i64 value = 0;
+	a3boolean negative = a3false;
+	a3ui32 d;
+	if (p < end && (*p == '-' || *p == '+'))
+		negative = (*p++ == '-');
+	if (p == end || (a3ui32)(*p - '0') >= 10)
+		return c;
+	for (; p < end && (d = (a3ui32)(*p - '0')) < 10; ++p)
+		if (value < 0x80000000ll)
+			value = value * 10 + d;
+	*value_out = (a3i32)(negative ? -value : value);
+	return p;
+}
+
+// parse up to n floats into values_out; missing values are zero
+static a3byte const* a3demo_objParseFloats(a3byte const* c, a3byte const* const end, a3f32* values_out, a3ui32 const n)
+{
+	a3ui32 i;
+	for (i = 0; i < n; ++i)
+	{
+		values_out[i] = 0.0f;
+		c = a3demo_objSkipSpace(c, end);
+		c = a3demo_objParseFloat(c, end, values_out + i);
+	}
+	return c;
+}
+
+// OBJ index (1-based or negative relative) to 0-based index
+static a3i32 a3demo_objResolve(a3i32 const index, a3ui32 const seen, a3ui32 const total)
+{
+	a3i32 const i = index > 0 ? index - 1 : (a3i32)seen + index;
+	return (index != 0 && i >= 0 && (a3ui32)i < total) ? i : a3demo_objInvalid;
+}
+
+
+// flag chunk as failed
+static a3ret a3demo_objChunkFail(a3_DemoOBJChunk* chunk)
+{
+	chunk->error = a3true;
+	return 0;
+}
+
+// step 1: count records
+static a3ret a3demo_objCountChunk(a3_DemoOBJChunk* chunk)
+{
+	a3byte const* const end = chunk->end;
+	a3byte const* c, * line, * lineEnd;
+	a3ui32 count[5] = { 0 };
+	for (line = chunk->begin; line < end; line = lineEnd + 1)
+	{
+		lineEnd = (a3byte const*)memchr(line, '\n', (size_t)(end - line));
+		if (!lineEnd)
+			lineEnd = end;
+		c = a3demo_objSkipSpace(line, lineEnd);
+		++count[a3demo_objRecord(&c, lineEnd)];
+	}
+	chunk->count.position = count[a3demoOBJ_position];
+	chunk->count.texcoord = count[a3demoOBJ_texcoord];
+	chunk->count.normal = count[a3demoOBJ_normal];
+	chunk->count.face = count[a3demoOBJ_face];
+	return 1;
+}
+
+// grow chunk-local arrays; false if out of memory
+static a3boolean a3demo_objReserveTriangles(a3_DemoOBJChunk* chunk, a3ui32 const triangleCount)
+{
+	a3ui32 capacity = chunk->triangleCapacity;
+	a3i32* corner;
+	a3ui32* polygon;
+	if (triangleCount <= capacity)
+		return a3true;
+	while (capacity < triangleCount)
+		capacity = capacity ? capacity * 2 : 1024;
+	corner = (a3i32*)a3demo_resize(chunk->corner, (size_t)capacity * 9 * sizeof(a3i32));
+	if (corner)
+		chunk->corner = corner;
+	polygon = (a3ui32*)a3demo_resize(chunk->polygon, (size_t)capacity * sizeof(a3ui32));
+	if (polygon)
+		chunk->polygon = polygon;
+	if (!corner || !polygon)
+		return a3false;
+	chunk->triangleCapacity = capacity;
+	return a3true;
+}
+
+// read corners of one face into scratch; returns corner count, -1 if malformed
+static a3i32 a3demo_objParseFace(a3_DemoOBJChunk* chunk, a3byte const* c, a3byte const* const end, a3_DemoOBJCount const* seen)
+{
+	a3_DemoOBJCount const* const total = &chunk->shared->total;
+	a3byte const* next;
+	a3i32* corner, * scratch;
+	a3i32 index;
+	a3i32 n = 0;
+
+	for (c = a3demo_objSkipSpace(c, end); c < end && *c != '#'; c = a3demo_objSkipSpace(c, end))
+	{
+		if ((a3ui32)n == chunk->scratchCapacity)
+		{
+			scratch = (a3i32*)a3demo_resize(chunk->scratch, (size_t)(n * 2 + 16) * 3 * sizeof(a3i32));
+			if (!scratch)
+				return -1;
+			chunk->scratch = scratch;
+			chunk->scratchCapacity = n * 2 + 16;
+		}
+		corner = chunk->scratch + n * 3;
+		corner[1] = corner[2] = a3demo_objNone;
+
+		// v[/[vt][/vn]]
+		next = a3demo_objParseInt(c, end, &index);
+		if (next == c)
+			return -1;
+		corner[0] = a3demo_objResolve(index, seen->position, total->position);
+		c = next;
+		if (c < end && *c == '/')
+		{
+			next = a3demo_objParseInt(++c, end, &index);
+			if (next != c)
+				corner[1] = a3demo_objResolve(index, seen->texcoord, total->texcoord);
+			c = next;
+			if (c < end && *c == '/')
+			{
+				next = a3demo_objParseInt(++c, end, &index);
+				if (next != c)
+					corner[2] = a3demo_objResolve(index, seen->normal, total->normal);
+				c = next;
+			}
+		}
+		if (corner[0] == a3demo_objInvalid || corner[1] == a3demo_objInvalid || corner[2] == a3demo_objInvalid)
+			return -1;
+		++n;
+
+		// anything else glued to the corner is malformed
+		if (c < end && !a3demo_objIsSpace(*c) && *c != '#')
+			return -1;
+	}
+	return n;
+}
+
+// step 2: parse records
+static a3ret a3demo_objParseChunk(a3_DemoOBJChunk* chunk)
+{
+	a3_DemoOBJShared const* const shared = chunk->shared;
+	a3f32 const* const m = shared->transform;
+	a3f32 const* const nm = shared->normalTransform;
+	a3byte const* const end = chunk->end;
+	a3byte const* c, * line, * lineEnd;
+	a3_DemoOBJCount seen = chunk->base;
+	a3f32 v[3], * out;
+	a3i32* triangle;
+	a3i32 n, i;
+
+	if (!a3demo_objReserveTriangles(chunk, chunk->count.face * 2))
+		return a3demo_objChunkFail(chunk);
+
+	for (line = chunk->begin; line < end; line = lineEnd + 1)
+	{
+		lineEnd = (a3byte const*)memchr(line, '\n', (size_t)(end - line));
+		if (!lineEnd)
+			lineEnd = end;
+		c = a3demo_objSkipSpace(line, lineEnd);
+		switch (a3demo_objRecord(&c, lineEnd))
+		{
+		case a3demoOBJ_position:
+			a3demo_objParseFloats(c, lineEnd, v, 3);
+			out = shared->position + seen.position++ * 3;
+			if (m)
+			{
+				out[0] = m[0] * v[0] + m[4] * v[1] + m[8] * v[2] + m[12];
+				out[1] = m[1] * v[0] + m[5] * v[1] + m[9] * v[2] + m[13];
+				out[2] = m[2] * v[0] + m[6] * v[1] + m[10] * v[2] + m[14];
+			}
+			else
+				out[0] = v[0], out[1] = v[1], out[2] = v[2];
+			break;
+		case a3demoOBJ_texcoord:
+			a3demo_objParseFloats(c, lineEnd, shared->texcoord + seen.texcoord++ * 2, 2);
+			break;
+		case a3demoOBJ_normal:
+			a3demo_objParseFloats(c, lineEnd, v, 3);
+			out = shared->normal + seen.normal++ * 3;
+			if (m)
+			{
+				out[0] = nm[0] * v[0] + nm[3] * v[1] + nm[6] * v[2];
+				out[1] = nm[1] * v[0] + nm[4] * v[1] + nm[7] * v[2];
+				out[2] = nm[2] * v[0] + nm[5] * v[1] + nm[8] * v[2];
+			}
+			else
+				out[0] = v[0], out[1] = v[1], out[2] = v[2];
+			a3demo_internalNormalize(out);
+			break;
+		case a3demoOBJ_face:
+			n = a3demo_objParseFace(chunk, c, lineEnd, &seen);
+			if (n < 0)
+				return a3demo_objChunkFail(chunk);
+
+			// fan: (0, i, i + 1)
+			if (n >= 3)
+			{
+				if (!a3demo_objReserveTriangles(chunk, chunk->triangleCount + (a3ui32)n - 2))
+					return a3demo_objChunkFail(chunk);
+				for (i = 1; i + 1 < n; ++i)
+				{
+					triangle = chunk->corner + chunk->triangleCount * 9;
+					memcpy(triangle + 0, chunk->scratch, 3 * sizeof(a3i32));
+					memcpy(triangle + 3, chunk->scratch + i * 3, 6 * sizeof(a3i32));
+					chunk->polygon[chunk->triangleCount++] = chunk->polygonCount;
+				}
+				++chunk->polygonCount;
+				chunk->ngonCount += (n > 4);
+			}
+			break;
+		default:
+			break;
+		}
+	}
+	return 1;
+}
+
+
+//-----------------------------------------------------------------------------
+// threading
+
+// run function on every chunk; first chunk runs on calling thread
+static void a3demo_objRunChunks(a3_DemoOBJChunk* chunk, a3ui32 const chunkCount, a3ret(*func)(a3_DemoOBJChunk*))
+{
+	a3ui32 i;
+	for (i = 1; i < chunkCount; ++i)
+	{
+		memset(chunk[i].thread, 0, sizeof(a3_Thread));
+		chunk[i].launched = a3threadLaunch(chunk[i].thread, (a3_threadfunc)func, chunk + i, "a3demo_loadModelOBJ") > 0;
+	}
+	func(chunk);
+
+	// chunks whose thread did not start run here
+	for (i = 1; i < chunkCount; ++i)
+		if (chunk[i].launched)
+			a3threadWait(chunk[i].thread);
+		else
+			func(chunk + i);
+}
+
+
+//-----------------------------------------------------------------------------
+// merge
+
+// hash of welded corner key
+static a3ui32 a3demo_objHashKey(a3i32 const* key)
+{
+	a3ui32 h = (a3ui32)key[0] * 0x9e3779b1u;
+	h ^= (a3ui32)key[1] * 0x85ebca77u + (h << 6) + (h >> 2);
+	h ^= (a3ui32)key[2] * 0xc2b2ae3du + (h << 6) + (h >> 2);
+	return h ^ (h >> 15);
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_loadModelOBJ(a3_GeometryData* geom_out, a3byte const* filePath, a3_ModelLoaderFlag const flags, a3f32 const* transform_opt,
+	a3ui32 const threadCount, a3_DemoModelLoadStats* stats_out_opt)
+{
+	// normal source
+	enum {
+		normalNone,
+		normalLoad,
+		normalFace,
+		normalVertex,
+	};
+
+	a3_DemoFileMap map[1] = { 0 };
+	a3_DemoOBJShared shared[1] = { 0 };
+	a3_DemoOBJChunk* chunk = 0;
+	a3_DemoOBJCount base = { 0 };
+	a3_DemoModelLoadStats stats = { 0 };
+	a3_DemoTangentBasisStats tangentStats[1] = { 0 };
+	a3_GeometryVertexAttributeName attribs[4];
+	a3ui32 attribCount = 0;
+
+	a3i32* key = 0;
+	a3ui32* table = 0, * index = 0;
+	a3f32* normalAccum = 0;
+	a3ui32 tableMask, slot, vertexCount = 0, triangleCount = 0, polygonCount = 0, cornerCount = 0;
+	a3ui32 chunkCount, i, j, k, t;
+	a3i32 corner[3];
+	a3i32 const* src;
+	a3f64 timeStart, timeParse;
+	a3ret result = 0;
+
+	a3f32* position = 0, * normal = 0, * texcoord = 0, * tangent = 0, * bitangent = 0;
+	a3f32 const* p[3];
+	a3f32 e1[3], e2[3], n[3];
+	a3ui32 vertexStorage, indexStorage;
+	a3size offset;
+	a3byte* data = 0, * indexData;
+
+	a3boolean const loadTexcoords = (flags & a3model_loadTexcoords) != 0;
+	a3boolean loadTangents = (flags & a3demo_objFlagTangents) != 0;
+	a3i32 normalMode = (flags & a3model_calculateFaceNormals) ? ((flags & a3demo_objFlagVertex) ? normalVertex : normalFace)
+		: (flags & a3model_loadNormals) ? normalLoad : normalNone;
+
+	if (!geom_out || geom_out->data || !filePath || !*filePath)
+		return -1;
+
+	// map file and split into line-aligned chunks
+	timeStart = a3demo_getTime();
+	if (a3demo_mapFile(map, filePath) <= 0)
+	{
+		printf("\n A3 ERROR: could not open OBJ file '%s' \n", filePath);
+		return 0;
+	}
+	chunkCount = threadCount ? threadCount : a3demo_getHardwareThreadCount();
+	chunkCount = chunkCount < a3demoModelLoader_threadMax ? chunkCount : a3demoModelLoader_threadMax;
+	i = (a3ui32)(map->size / a3demoModelLoader_chunkMin);
+	chunkCount = chunkCount < i ? chunkCount : i;
+	chunkCount = chunkCount ? chunkCount : 1;
+	chunk = (a3_DemoOBJChunk*)a3demo_allocZero((size_t)chunkCount * sizeof(a3_DemoOBJChunk));
+	if (!chunk)
+		goto done;
+	for (i = 0; i < chunkCount; ++i)
+	{
+		chunk[i].shared = shared;
+		chunk[i].begin = i ? chunk[i - 1].end : map->data;
+		chunk[i].end = map->data + map->size * (i + 1) / chunkCount;
+		if (chunk[i].end < chunk[i].begin)
+			chunk[i].end = chunk[i].begin;
+		while (chunk[i].end < map->data + map->size && chunk[i].end[-1] != '\n')
+			++chunk[i].end;
+	}
+
+	// step 1: count, then offsets from prefix sums
+	a3demo_objRunChunks(chunk, chunkCount, a3demo_objCountChunk);
+	for (i = 0; i < chunkCount; ++i)
+	{
+		chunk[i].base = base;
+		base.position += chunk[i].count.position;
+		base.texcoord += chunk[i].count.texcoord;
+		base.normal += chunk[i].count.normal;
+		base.face += chunk[i].count.face;
+	}
+	shared->total = base;
+	shared->position = (a3f32*)a3demo_alloc((size_t)base.position * 3 * sizeof(a3f32) + 1);
+	shared->texcoord = (a3f32*)a3demo_alloc((size_t)base.texcoord * 2 * sizeof(a3f32) + 1);
+	shared->normal = (a3f32*)a3demo_alloc((size_t)base.normal * 3 * sizeof(a3f32) + 1);
+	if (!shared->position || !shared->texcoord || !shared->normal)
+		goto done;
+
+	// normal transform is cofactor matrix of upper 3x3, signed by determinant
+	if (transform_opt)
+	{
+		a3f32 const* const m = transform_opt;
+		a3f32* const c = shared->normalTransform;
+		shared->transform = transform_opt;
+		c[0] = m[5] * m[10] - m[6] * m[9];
+		c[1] = m[6] * m[8] - m[4] * m[10];
+		c[2] = m[4] * m[9] - m[5] * m[8];
+		c[3] = m[2] * m[9] - m[1] * m[10];
+		c[4] = m[0] * m[10] - m[2] * m[8];
+		c[5] = m[1] * m[8] - m[0] * m[9];
+		c[6] = m[1] * m[6] - m[2] * m[5];
+		c[7] = m[2] * m[4] - m[0] * m[6];
+		c[8] = m[0] * m[5] - m[1] * m[4];
+		if (m[0] * c[0] + m[1] * c[1] + m[2] * c[2] < 0.0f)
+			for (i = 0; i < 9; ++i)
+				c[i] = -c[i];
+	}
+
+	// step 2: parse
+	a3demo_objRunChunks(chunk, chunkCount, a3demo_objParseChunk);
+	for (i = 0; i < chunkCount; ++i)
+	{
+		if (chunk[i].error)
+		{
+			printf("\n A3 ERROR: malformed face or index out of range in OBJ file '%s' \n", filePath);
+			goto done;
+		}
+		stats.polygonCount += chunk[i].polygonCount;
+		stats.ngonCount += chunk[i].ngonCount;
+		triangleCount += chunk[i].triangleCount;
+	}
+	timeParse = a3demo_getTime();
+	if (!triangleCount)
+	{
+		printf("\n A3 ERROR: no faces in OBJ file '%s' \n", filePath);
+		goto done;
+	}
+
+	// resolve requested attributes against file contents
+	if (normalMode == normalLoad && !base.normal)
+		normalMode = normalVertex;
+	loadTangents = loadTangents && loadTexcoords && base.texcoord && normalMode != normalNone;
+
+	// step 3: weld corners in chunk order; key is position, texcoord if
+	//	used, then loaded normal or polygon (flat normals) if used
+	for (tableMask = 1; tableMask < triangleCount * 6; tableMask <<= 1);
+	key = (a3i32*)a3demo_alloc((size_t)triangleCount * 9 * sizeof(a3i32));
+	index = (a3ui32*)a3demo_alloc((size_t)triangleCount * 3 * sizeof(a3ui32));
+	table = (a3ui32*)a3demo_allocZero((size_t)tableMask-- * sizeof(a3ui32));
+	if (!key || !index || !table)
+		goto done;
+	for (i = 0; i < chunkCount; ++i)
+	{
+		for (t = 0; t < chunk[i].triangleCount; ++t)
+			for (j = 0; j < 3; ++j)
+			{
+				src = chunk[i].corner + (t * 3 + j) * 3;
+				corner[0] = src[0];
+				corner[1] = loadTexcoords ? src[1] : a3demo_objNone;
+				corner[2] = normalMode == normalLoad ? src[2]
+					: normalMode == normalFace ? (a3i32)(polygonCount + chunk[i].polygon[t]) : a3demo_objNone;
+				for (slot = a3demo_objHashKey(corner) & tableMask; table[slot]; slot = (slot + 1) & tableMask)
+				{
+					k = table[slot] - 1;
+					if (key[k * 3 + 0] == corner[0] && key[k * 3 + 1] == corner[1] && key[k * 3 + 2] == corner[2])
+						break;
+				}
+				if (!table[slot])
+				{
+					table[slot] = ++vertexCount;
+					memcpy(key + (vertexCount - 1) * 3, corner, sizeof(corner));
+				}
+				index[cornerCount++] = table[slot] - 1;
+			}
+		polygonCount += chunk[i].polygonCount;
+	}
+	a3demo_release(table);
+	table = 0;
+
+	// output format
+	attribs[attribCount++] = a3attrib_geomPosition;
+	if (normalMode != normalNone)
+		attribs[attribCount++] = a3attrib_geomNormal;
+	if (loadTexcoords)
+		attribs[attribCount++] = a3attrib_geomTexcoord;
+	if (loadTangents)
+		attribs[attribCount++] = a3attrib_geomTangent;
+	a3geometryCreateVertexFormat(geom_out->vertexFormat, attribs, attribCount);
+	a3geometryCreateIndexFormat(geom_out->indexFormat, vertexCount);
+	vertexStorage = a3vertexFormatGetStorageSpaceRequired(geom_out->vertexFormat, vertexCount);
+	indexStorage = a3indexFormatGetStorageSpaceRequired(geom_out->indexFormat, triangleCount * 3);
+
+	// one block for everything (released with free by a3geometryReleaseData)
+	offset = (size_t)vertexCount * (3 + (normalMode != normalNone) * 3 + loadTexcoords * 2 + loadTangents * 6) * sizeof(a3f32);
+	if (offset > vertexStorage || !(data = (a3byte*)malloc((size_t)vertexStorage + indexStorage)))
+		goto done;
+	position = (a3f32*)data;
+	offset = (size_t)vertexCount * 3 * sizeof(a3f32);
+	if (normalMode != normalNone)
+	{
+		normal = (a3f32*)(data + offset);
+		offset += (size_t)vertexCount * 3 * sizeof(a3f32);
+	}
+	if (loadTexcoords)
+	{
+		texcoord = (a3f32*)(data + offset);
+		offset += (size_t)vertexCount * 2 * sizeof(a3f32);
+	}
+	if (loadTangents)
+	{
+		tangent = (a3f32*)(data + offset);
+		bitangent = tangent + vertexCount * 3;
+	}
+	indexData = data + vertexStorage;
+
+	// positions and texcoords
+	for (i = 0; i < vertexCount; ++i)
+	{
+		memcpy(position + i * 3, shared->position + key[i * 3 + 0] * 3, 3 * sizeof(a3f32));
+		if (texcoord)
+		{
+			if (key[i * 3 + 1] >= 0)
+				memcpy(texcoord + i * 2, shared->texcoord + key[i * 3 + 1] * 2, 2 * sizeof(a3f32));
+			else
+				texcoord[i * 2 + 0] = texcoord[i * 2 + 1] = 0.0f;
+		}
+	}
+
+	// normals: loaded, or area-weighted sums of triangle normals per
+	//	polygon (flat) or per position (smooth, shared across seams)
+	if (normal)
+	{
+		if (normalMode == normalLoad)
+		{
+			for (i = 0; i < vertexCount; ++i)
+				if (key[i * 3 + 2] >= 0)
+					memcpy(normal + i * 3, shared->normal + key[i * 3 + 2] * 3, 3 * sizeof(a3f32));
+				else
+					normal[i * 3 + 0] = normal[i * 3 + 1] = normal[i * 3 + 2] = 0.0f;
+		}
+		else
+		{
+			k = normalMode == normalFace ? polygonCount : base.position;
+			if (!(normalAccum = (a3f32*)a3demo_allocZero(((size_t)k * 3 + 1) * sizeof(a3f32))))
+				goto fail;
+			for (t = 0; t < triangleCount; ++t)
+			{
+				for (j = 0; j < 3; ++j)
+					p[j] = position + index[t * 3 + j] * 3;
+				e1[0] = p[1][0] - p[0][0], e1[1] = p[1][1] - p[0][1], e1[2] = p[1][2] - p[0][2];
+				e2[0] = p[2][0] - p[0][0], e2[1] = p[2][1] - p[0][1], e2[2] = p[2][2] - p[0][2];
+				a3demo_internalCross(n, e1, e2);
+				for (j = 0; j < (normalMode == normalFace ? 1u : 3u); ++j)
+				{
+					k = key[index[t * 3 + j] * 3 + (normalMode == normalFace ? 2 : 0)];
+					normalAccum[k * 3 + 0] += n[0];
+					normalAccum[k * 3 + 1] += n[1];
+					normalAccum[k * 3 + 2] += n[2];
+				}
+			}
+			for (i = 0; i < vertexCount; ++i)
+			{
+				k = key[i * 3 + (normalMode == normalFace ? 2 : 0)];
+				memcpy(normal + i * 3, normalAccum + k * 3, 3 * sizeof(a3f32));
+				a3demo_internalNormalize(normal + i * 3);
+			}
+		}
+	}
+
+	// tangents: texture-space directions summed per welded vertex, then
+	//	orthonormalized against normal with handedness kept in bitangent
+	if (tangent)
+	{
+		if (a3demo_calculateTangentBasis(tangent, bitangent, position, normal, texcoord, vertexCount,
+			index, triangleCount, threadCount, tangentStats) <= 0)
+			goto fail;
+		stats.tangentTime = tangentStats->totalTime;
+	}
+
+	// indices in selected size
+	for (i = 0; i < triangleCount * 3; ++i)
+		switch (geom_out->indexFormat->indexSize)
+		{
+		case 1: ((a3ubyte*)indexData)[i] = (a3ubyte)index[i]; break;
+		case 2: ((a3ui16*)indexData)[i] = (a3ui16)index[i]; break;
+		default: ((a3ui32*)indexData)[i] = index[i]; break;
+		}
+
+	geom_out->primType = a3prim_triangles;
+	geom_out->numVertices = vertexCount;
+	geom_out->numIndices = triangleCount * 3;
+	geom_out->data = data;
+	memset(geom_out->attribData, 0, sizeof(geom_out->attribData));
+	geom_out->attribData[a3attrib_geomPosition] = position;
+	geom_out->attribData[a3attrib_geomNormal] = normal;
+	geom_out->attribData[a3attrib_geomTexcoord] = texcoord;
+	geom_out->attribData[a3attrib_geomTangent] = tangent;
+	geom_out->indexData = indexData;
+	data = 0;
+	result = 1;
+
+fail:
+	free(data);
+	stats.triangleCount = triangleCount;
+	stats.mergeTime = a3demo_getTime() - timeParse;
+	stats.parseTime = timeParse - timeStart;
+done:
+	if (chunk)
+		for (i = 0; i < chunkCount; ++i)
+		{
+			a3demo_release(chunk[i].corner);
+			a3demo_release(chunk[i].polygon);
+			a3demo_release(chunk[i].scratch);
+		}
+	a3demo_release(chunk);
+	a3demo_release(shared->position);
+	a3demo_release(shared->texcoord);
+	a3demo_release(shared->normal);
+	a3demo_release(key);
+	a3demo_release(index);
+	a3demo_release(table);
+	a3demo_release(normalAccum);
+
+	if (stats_out_opt)
+	{
+		stats.fileSize = map->size;
+		stats.totalTime = a3demo_getTime() - timeStart;
+		stats.megabytesPerSecond = stats.totalTime > 0.0 ? (a3f64)map->size / (1024.0 * 1024.0) / stats.totalTime : 0.0;
+		stats.threadCount = chunkCount;
+		stats.positionCount = base.position;
+		stats.texcoordCount = base.texcoord;
+		stats.normalCount = base.normal;
+		stats.vertexCount = vertexCount;
+		*stats_out_opt = stats;
+	}
+	a3demo_unmapFile(map);
+	return result;
+}
+
+
+void a3demo_printModelLoadStats(a3_DemoModelLoadStats const* stats, a3byte const* filePath)
+{
+	if (stats)
+		printf("\n A3 loaded '%s': %.2f MB in %.2f ms (%.1f MB/s, %u threads; parse %.2f ms, merge %.2f ms, tangents %.2f ms)"
+			"\n    %u positions, %u texcoords, %u normals; %u polygons (%u n-gons) -> %u triangles, %u vertices \n",
+			filePath ? filePath : (a3byte const*)"", (a3f64)stats->fileSize / (1024.0 * 1024.0), stats->totalTime * 1000.0,
+			stats->megabytesPerSecond, stats->threadCount, stats->parseTime * 1000.0, stats->mergeTime * 1000.0, stats->tangentTime * 1000.0,
+			stats->positionCount, stats->texcoordCount, stats->normalCount,
+			stats->polygonCount, stats->ngonCount, stats->triangleCount, stats->vertexCount);
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,531 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoMorphTarget.c
+	Morph target implementation.
+
+	Building a set runs in three steps:
+		1. scale: every target's largest position and normal difference
+			from the base picks the value of one 16-bit step
+		2. count: vertices with any nonzero quantized difference are
+			counted, so one block holds everything
+		3. store: base positions and normals are widened to four floats
+			each, base vertices are interleaved in the base's vertex
+			format, and the changed vertices of every target are listed
+			with their quantized differences
+	Blending splits vertices into ranges on worker threads; each range
+		finds the first changed vertex of every weighted target once,
+		then per chunk of vertices starts from the base, adds every
+		target's changed vertices in the chunk (eight differences per
+		SIMD step), renormalizes normals and writes the chunk's whole
+		vertices in one copy.
+*/
+
+#include "../a3_DemoMorphTarget.h"
+#include "../a3_DemoMemory.h"
+#include "../a3_DemoPlatform.h"
+
+#include "animal3D/a3/a3macros.h"
+#include "animal3D/a3utility/a3_Thread.h"
+#include "animal3D-A3DM/a3math/a3simd.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#ifdef _WIN32
+#include <gl/glew.h>
+#include <Windows.h>
+#include <GL/GL.h>
+#else	// !_WIN32
+#include <OpenGL/gl3.h>
+#endif	// _WIN32
+
+
+//-----------------------------------------------------------------------------
+
+// data shared by all ranges
+typedef struct a3_DemoMorphShared
+{
+	a3_DemoMorphSet const* set;
+	a3ubyte* vertex;						// output
+	a3ui32 target[a3demoMorph_targetMax];	// weighted targets
+	a3f32 weight[a3demoMorph_targetMax][2];	// weight times position and normal step
+	a3ui32 targetCount;
+} a3_DemoMorphShared;
+
+// one range of vertices
+typedef struct a3_DemoMorphRange
+{
+	a3_DemoMorphShared const* shared;
+	a3ui32 begin, end;
+	a3ui32 deltaCount;
+	a3boolean launched;						// ran on its own thread
+	a3_Thread thread[1];
+} a3_DemoMorphRange;
+
+
+//-----------------------------------------------------------------------------
+// utilities
+
+// float vec3 attribute
+static a3boolean a3demo_internalMorphFloat3(a3_VertexFormatDescriptor const* format, a3_VertexAttributeName const name)
+{
+	return format->attribElements[name] == 3 && format->attribSize[name] == 3 * sizeof(a3f32);
+}
+
+// nearest step of difference, clamped to 16 bits
+static a3i16 a3demo_internalMorphQuantize(a3f32 const delta, a3f32 const stepInv)
+{
+	a3f32 const q = floorf(delta * stepInv + 0.5f);
+	return (a3i16)(q > 32767.0f ? 32767 : q < -32767.0f ? -32767 : (a3i32)q);
+}
+
+// largest difference of three floats per vertex
+static a3f32 a3demo_internalMorphRange3(a3f32 const* a, a3f32 const* b, a3ui32 const count)
+{
+	a3f32 d, result = 0.0f;
+	a3ui32 i;
+	for (i = 0; i < count * 3; ++i)
+	{
+		d = fabsf(a[i] - b[i]);
+		result = d > result ? d : result;
+	}
+	return result;
+}
+
+static void a3demo_internalMorphNormalize(a3f32* v)
+{
+#if (A3_SIMD >= A3_SIMD_SSE2)
+	// last lane is zero, so the sum of all lanes is the squared length
+	__m128 n = _mm_loadu_ps(v), lenSq = _mm_mul_ps(n, n);
+	lenSq = _mm_add_ps(lenSq, _mm_shuffle_ps(lenSq, lenSq, _MM_SHUFFLE(2, 3, 0, 1)));
+	lenSq = _mm_add_ps(lenSq, _mm_movehl_ps(lenSq, lenSq));
+	if (_mm_cvtss_f32(lenSq) > 0.0f)
+	{
+		n = _mm_div_ps(n, _mm_sqrt_ps(_mm_shuffle_ps(lenSq, lenSq, 0)));
+		_mm_storeu_ps(v, n);
+	}
+#else	// !A3_SIMD
+	a3f32 const lenSq = v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+	a3f32 lenInv;
+	if (lenSq > 0.0f)
+	{
+		lenInv = 1.0f / sqrtf(lenSq);
+		v[0] *= lenInv;
+		v[1] *= lenInv;
+		v[2] *= lenInv;
+	}
+#endif	// A3_SIMD
+}
+
+
+//-----------------------------------------------------------------------------
+// ranges
+
+static a3ret a3demo_morphRange(a3_DemoMorphRange* range)
+{
+	a3_DemoMorphShared const* const shared = range->shared;
+	a3_DemoMorphSet const* const set = shared->set;
+	a3_DemoMorphTarget const* target;
+	a3ui32 const stride = set->vertexSize;
+	a3boolean const normals = set->normalOffset < stride;
+	a3f32 sum[a3demoMorph_chunkSize * 8];
+	a3ubyte chunk[a3demoMorph_chunkSize * a3demoMorph_vertexSizeMax];
+	a3ui32 cursor[a3demoMorph_targetMax];
+	a3ui32 c0, c1, v, i, k, lo, hi;
+	a3f32* out;
+	a3i16 const* delta;
+#if (A3_SIMD >= A3_SIMD_SSE2)
+	__m128i d;
+	__m128 wp, wn;
+#endif	// A3_SIMD
+
+	// first changed vertex in range of each target
+	for (k = 0; k < shared->targetCount; ++k)
+	{
+		target = set->target + shared->target[k];
+		for (lo = 0, hi = target->count; lo < hi; )
+			if (target->vertex[(lo + hi) / 2] < range->begin)
+				lo = (lo + hi) / 2 + 1;
+			else
+				hi = (lo + hi) / 2;
+		cursor[k] = lo;
+	}
+
+	for (c0 = range->begin; c0 < range->end; c0 = c1)
+	{
+		c1 = c0 + a3demoMorph_chunkSize < range->end ? c0 + a3demoMorph_chunkSize : range->end;
+
+		// start from base, add changed vertices of each target in order
+		memcpy(sum, set->base + (size_t)c0 * 8, (size_t)(c1 - c0) * 8 * sizeof(a3f32));
+		for (k = 0; k < shared->targetCount; ++k)
+		{
+			target = set->target + shared->target[k];
+#if (A3_SIMD >= A3_SIMD_SSE2)
+			wp = _mm_set1_ps(shared->weight[k][0]);
+			wn = _mm_set1_ps(shared->weight[k][1]);
+#endif	// A3_SIMD
+			for (i = cursor[k]; i < target->count && target->vertex[i] < c1; ++i)
+			{
+				out = sum + (target->vertex[i] - c0) * 8;
+				delta = target->delta + (size_t)i * 8;
+#if (A3_SIMD >= A3_SIMD_SSE2)
+				// sign-extend eight 16-bit steps into two float vectors
+				d = _mm_loadu_si128((__m128i const*)delta);
+				_mm_storeu_ps(out, _mm_add_ps(_mm_loadu_ps(out),
+					_mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(d, d), 16)), wp)));
+				_mm_storeu_ps(out + 4, _mm_add_ps(_mm_loadu_ps(out + 4),
+					_mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(d, d), 16)), wn)));
+#else	// !A3_SIMD
+				out[0] += (a3f32)delta[0] * shared->weight[k][0];
+				out[1] += (a3f32)delta[1] * shared->weight[k][0];
+				out[2] += (a3f32)delta[2] * shared->weight[k][0];
+				out[4] += (a3f32)delta[4] * shared->weight[k][1];
+				out[5] += (a3f32)delta[5] * shared->weight[k][1];
+				out[6] += (a3f32)delta[6] * shared->weight[k][1];
+#endif	// A3_SIMD
+			}
+			range->deltaCount += i - cursor[k];
+			cursor[k] = i;
+		}
+
+		// whole vertices are assembled here so output is written once,
+		//	in order (mapped memory may be slow to read or write randomly)
+		memcpy(chunk, set->vertexData + (size_t)c0 * stride, (size_t)(c1 - c0) * stride);
+		for (v = 0; v < c1 - c0; ++v)
+		{
+			memcpy(chunk + v * stride + set->positionOffset, sum + v * 8, 3 * sizeof(a3f32));
+			if (normals)
+			{
+				a3demo_internalMorphNormalize(sum + v * 8 + 4);
+				memcpy(chunk + v * stride + set->normalOffset, sum + v * 8 + 4, 3 * sizeof(a3f32));
+			}
+		}
+		memcpy(shared->vertex + (size_t)c0 * stride, chunk, (size_t)(c1 - c0) * stride);
+	}
+	return 1;
+}
+
+// split vertices into ranges and blend every range; first range runs on
+//	calling thread
+static void a3demo_internalMorphRun(a3_DemoMorphRange* range, a3ui32 const rangeCount, a3ui32 const count)
+{
+	a3ui32 i;
+	for (i = 0; i < rangeCount; ++i)
+	{
+		range[i].begin = i ? range[i - 1].end : 0;
+		range[i].end = i + 1 < rangeCount ? (a3ui32)((a3ui64)count * (i + 1) / rangeCount) : count;
+	}
+	for (i = 1; i < rangeCount; ++i)
+	{
+		memset(range[i].thread, 0, sizeof(a3_Thread));
+		range[i].launched = a3threadLaunch(range[i].thread, (a3_threadfunc)a3demo_morphRange, range + i, "a3demo_blendMorphTargets") > 0;
+	}
+	a3demo_morphRange(range);
+
+	// ranges whose thread did not start run here
+	for (i = 1; i < rangeCount; ++i)
+		if (range[i].launched)
+			a3threadWait(range[i].thread);
+		else
+			a3demo_morphRange(range + i);
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_createMorphSet(a3_DemoMorphSet* set_out, a3_GeometryData const* base,
+	a3_GeometryData const* targets, a3ui32 const targetCount, a3_DemoMorphStats* stats_out_opt)
+{
+	// geometry streams: one or two vertex attributes stored back to back
+	struct {
+		a3_GeometryVertexAttributeName geomName;
+		a3_VertexAttributeName name, nameSecond;
+	} const stream[] = {
+		{ a3attrib_geomPosition, a3attrib_position, a3attrib_position },
+		{ a3attrib_geomNormal, a3attrib_normal, a3attrib_normal },
+		{ a3attrib_geomColor, a3attrib_color, a3attrib_color },
+		{ a3attrib_geomTexcoord, a3attrib_texcoord, a3attrib_texcoord },
+		{ a3attrib_geomTangent, a3attrib_tangent, a3attrib_bitangent },
+		{ a3attrib_geomBlending, a3attrib_blendWeights, a3attrib_blendIndices },
+	};
+
+	a3_DemoMorphStats stats = { 0 };
+	a3_DemoMorphSet set = { 0 };
+	a3_DemoMorphTarget* target;
+	a3_VertexFormatDescriptor const* const format = base ? base->vertexFormat : 0;
+	a3f32 const* position, * normal, * basePosition = 0, * baseNormal = 0;
+	a3f32 stepInv[2], d, err;
+	a3i16 q[8] = { 0 };
+	a3ubyte const* src;
+	a3ubyte* dst;
+	a3size size;
+	a3ui32 n, v, i, j, k, attribSize;
+	a3boolean normals;
+	a3f64 const timeStart = a3demo_getTime();
+
+	if (!set_out || set_out->data || !base || !targets || !targetCount || targetCount > a3demoMorph_targetMax)
+		return -1;
+
+	// float positions and normals with matching vertices
+	n = base->numVertices;
+	normals = base->attribData[a3attrib_geomNormal] != 0;
+	if (!base->data || !n || !base->attribData[a3attrib_geomPosition] || !a3demo_internalMorphFloat3(format, a3attrib_position) ||
+		(normals && !a3demo_internalMorphFloat3(format, a3attrib_normal)) || format->vertexSize > a3demoMorph_vertexSizeMax)
+		return 0;
+	for (k = 0; k < targetCount; ++k)
+		if (!targets[k].data || targets[k].numVertices != n ||
+			!targets[k].attribData[a3attrib_geomPosition] || !a3demo_internalMorphFloat3(targets[k].vertexFormat, a3attrib_position) ||
+			(normals && (!targets[k].attribData[a3attrib_geomNormal] || !a3demo_internalMorphFloat3(targets[k].vertexFormat, a3attrib_normal))))
+			return 0;
+	basePosition = (a3f32 const*)base->attribData[a3attrib_geomPosition];
+	baseNormal = normals ? (a3f32 const*)base->attribData[a3attrib_geomNormal] : 0;
+
+	// step of each target from its largest difference, then count
+	//	vertices that still differ after quantizing
+	for (k = 0, target = set.target; k < targetCount; ++k, ++target)
+	{
+		position = (a3f32 const*)targets[k].attribData[a3attrib_geomPosition];
+		normal = normals ? (a3f32 const*)targets[k].attribData[a3attrib_geomNormal] : 0;
+		target->positionScale = a3demo_internalMorphRange3(position, basePosition, n) / 32767.0f;
+		target->normalScale = normals ? a3demo_internalMorphRange3(normal, baseNormal, n) / 32767.0f : 0.0f;
+		stepInv[0] = target->positionScale > 0.0f ? 1.0f / target->positionScale : 0.0f;
+		stepInv[1] = target->normalScale > 0.0f ? 1.0f / target->normalScale : 0.0f;
+		for (v = 0; v < n; ++v)
+			for (j = 0; j < 3; ++j)
+				if (a3demo_internalMorphQuantize(position[v * 3 + j] - basePosition[v * 3 + j], stepInv[0]) ||
+					(normals && a3demo_internalMorphQuantize(normal[v * 3 + j] - baseNormal[v * 3 + j], stepInv[1])))
+				{
+					++target->count;
+					break;
+				}
+		stats.changedCount[k] = target->count;
+		stats.deltaSize += (a3size)target->count * (8 * sizeof(a3i16) + sizeof(a3ui32));
+	}
+
+	// one block: base, deltas, indices, then base vertices
+	size = (a3size)n * 8 * sizeof(a3f32) + stats.deltaSize + (a3size)n * format->vertexSize;
+	if (!(set.data = a3demo_alloc(size)))
+		return 0;
+	set.base = (a3f32*)set.data;
+	dst = (a3ubyte*)(set.base + (size_t)n * 8);
+	for (k = 0, target = set.target; k < targetCount; ++k, ++target)
+	{
+		target->delta = (a3i16*)dst;
+		dst += (size_t)target->count * 8 * sizeof(a3i16);
+	}
+	for (k = 0, target = set.target; k < targetCount; ++k, ++target)
+	{
+		target->vertex = (a3ui32*)dst;
+		dst += (size_t)target->count * sizeof(a3ui32);
+	}
+	set.vertexData = dst;
+	set.targetCount = targetCount;
+	set.vertexCount = n;
+	set.vertexSize = format->vertexSize;
+	set.positionOffset = format->attribOffset[a3attrib_position];
+	set.normalOffset = normals ? format->attribOffset[a3attrib_normal] : format->vertexSize;
+
+	// base positions and normals padded to four
+	for (v = 0; v < n; ++v)
+	{
+		memcpy(set.base + v * 8, basePosition + v * 3, 3 * sizeof(a3f32));
+		set.base[v * 8 + 3] = 0.0f;
+		if (normals)
+			memcpy(set.base + v * 8 + 4, baseNormal + v * 3, 3 * sizeof(a3f32));
+		else
+			set.base[v * 8 + 4] = set.base[v * 8 + 5] = set.base[v * 8 + 6] = 0.0f;
+		set.base[v * 8 + 7] = 0.0f;
+	}
+
+	// base vertices interleaved as they are uploaded
+	for (k = 0; k < sizeof(stream) / sizeof(*stream); ++k)
+		if (base->attribData[stream[k].geomName])
+			for (j = 0; j < 1u + (stream[k].nameSecond != stream[k].name); ++j)
+			{
+				attribSize = format->attribSize[j ? stream[k].nameSecond : stream[k].name];
+				src = (a3ubyte const*)base->attribData[stream[k].geomName] + (j ? (size_t)n * format->attribSize[stream[k].name] : 0);
+				dst = set.vertexData + format->attribOffset[j ? stream[k].nameSecond : stream[k].name];
+				if (format->attribType[j ? stream[k].nameSecond : stream[k].name])
+					for (v = 0; v < n; ++v, src += attribSize, dst += set.vertexSize)
+						memcpy(dst, src, attribSize);
+			}
+
+	// changed vertices and their steps; error includes dropped vertices
+	for (k = 0, target = set.target; k < targetCount; ++k, ++target)
+	{
+		position = (a3f32 const*)targets[k].attribData[a3attrib_geomPosition];
+		normal = normals ? (a3f32 const*)targets[k].attribData[a3attrib_geomNormal] : 0;
+		stepInv[0] = target->positionScale > 0.0f ? 1.0f / target->positionScale : 0.0f;
+		stepInv[1] = target->normalScale > 0.0f ? 1.0f / target->normalScale : 0.0f;
+		for (v = i = 0; v < n; ++v)
+		{
+			for (j = 0; j < 3; ++j)
+			{
+				q[j] = a3demo_internalMorphQuantize(position[v * 3 + j] - basePosition[v * 3 + j], stepInv[0]);
+				q[j + 4] = normals ? a3demo_internalMorphQuantize(normal[v * 3 + j] - baseNormal[v * 3 + j], stepInv[1]) : 0;
+			}
+			if (q[0] || q[1] || q[2] || q[4] || q[5] || q[6])
+			{
+				target->vertex[i] = v;
+				memcpy(target->delta + (size_t)i * 8, q, sizeof(q));
+				++i;
+			}
+			for (j = 0; j < 3; ++j)
+			{
+				d = position[v * 3 + j] - basePosition[v * 3 + j];
+				err = fabsf((a3f32)q[j] * target->positionScale - d);
+				stats.positionError = err > stats.positionError ? err : stats.positionError;
+			}
+		}
+	}
+	*set_out = set;
+
+	if (stats_out_opt)
+	{
+		stats.vertexCount = n;
+		stats.targetCount = targetCount;
+		stats.denseSize = (a3size)targetCount * n * 6 * sizeof(a3f32);
+		stats.time = a3demo_getTime() - timeStart;
+		*stats_out_opt = stats;
+	}
+	return targetCount;
+}
+
+
+a3ret a3demo_releaseMorphSet(a3_DemoMorphSet* set)
+{
+	if (set)
+	{
+		if (set->data)
+		{
+			a3demo_release(set->data);
+			memset(set, 0, sizeof(a3_DemoMorphSet));
+			return 1;
+		}
+		return 0;
+	}
+	return -1;
+}
+
+
+a3ret a3demo_blendMorphTargets(void* vertex_out, a3_DemoMorphSet const* set, a3f32 const* weights,
+	a3ui32 const threadCount, a3_DemoMorphBlendStats* stats_out_opt)
+{
+	a3_DemoMorphShared shared[1] = { 0 };
+	a3_DemoMorphRange range[a3demoMorph_threadMax] = { 0 };
+	a3ui32 rangeCount, i, k;
+	a3f64 const timeStart = a3demo_getTime();
+
+	if (!vertex_out || !set || !set->data || !weights)
+		return -1;
+
+	// weighted targets with steps folded into weights
+	shared->set = set;
+	shared->vertex = (a3ubyte*)vertex_out;
+	for (k = 0; k < set->targetCount; ++k)
+		if (weights[k] != 0.0f && set->target[k].count)
+		{
+			shared->target[shared->targetCount] = k;
+			shared->weight[shared->targetCount][0] = weights[k] * set->target[k].positionScale;
+			shared->weight[shared->targetCount][1] = weights[k] * set->target[k].normalScale;
+			++shared->targetCount;
+		}
+
+	rangeCount = threadCount ? threadCount : a3demo_getHardwareThreadCount();
+	rangeCount = rangeCount < a3demoMorph_threadMax ? rangeCount : a3demoMorph_threadMax;
+	k = set->vertexCount / a3demoMorph_rangeMin;
+	rangeCount = rangeCount < k ? rangeCount : k;
+	rangeCount = rangeCount ? rangeCount : 1;
+	for (i = 0; i < rangeCount; ++i)
+		range[i].shared = shared;
+	a3demo_internalMorphRun(range, rangeCount, set->vertexCount);
+
+	if (stats_out_opt)
+	{
+		stats_out_opt->vertexCount = set->vertexCount;
+		stats_out_opt->targetCount = shared->targetCount;
+		stats_out_opt->threadCount = rangeCount;
+		for (i = 0, stats_out_opt->deltaCount = 0; i < rangeCount; ++i)
+			stats_out_opt->deltaCount += range[i].deltaCount;
+		stats_out_opt->time = a3demo_getTime() - timeStart;
+	}
+	return set->vertexCount;
+}
+
+
+a3ret a3demo_uploadMorphTargets(a3_VertexBuffer* vertexBuffer, a3ui32 const offset, a3_DemoMorphSet const* set, a3f32 const* weights,
+	a3ui32 const threadCount, a3_DemoMorphBlendStats* stats_out_opt)
+{
+	void* vertex;
+	a3ui32 size;
+	a3ret result = 0;
+
+	if (!vertexBuffer || !vertexBuffer->handle->handle || !set || !set->data || !weights)
+		return -1;
+	size = set->vertexCount * set->vertexSize;
+	if (offset + size > vertexBuffer->size)
+		return -1;
+
+	// old contents are dropped, so the driver need not wait for draws
+	//	still reading them or copy them back
+	a3bufferActivate(vertexBuffer);
+	vertex = glMapBufferRange(vertexBuffer->internalBinding, offset, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+	if (vertex)
+	{
+		result = a3demo_blendMorphTargets(vertex, set, weights, threadCount, stats_out_opt);
+
+		// contents may be lost (e.g. display mode change) and are
+		//	rewritten next time
+		if (!glUnmapBuffer(vertexBuffer->internalBinding))
+			result = 0;
+	}
+	a3bufferDeactivateType(vertexBuffer->type);
+	return result;
+}
+
+
+void a3demo_printMorphStats(a3_DemoMorphStats const* stats, a3byte const* name)
+{
+	a3ui32 k;
+	if (stats)
+	{
+		printf("\n A3 morph targets '%s': %u vertices, %u targets in %.2f ms; changed vertices",
+			name ? name : (a3byte const*)"", stats->vertexCount, stats->targetCount, stats->time * 1000.0);
+		for (k = 0; k < stats->targetCount; ++k)
+			printf(" %u", stats->changedCount[k]);
+		printf("; %.1f kB stored (%.1f kB dense float, %.2fx); largest position error %g \n",
+			(a3f64)stats->deltaSize / 1024.0, (a3f64)stats->denseSize / 1024.0,
+			stats->deltaSize ? (a3f64)stats->denseSize / (a3f64)stats->deltaSize : 0.0, stats->positionError);
+	}
+}
+
+void a3demo_printMorphBlendStats(a3_DemoMorphBlendStats const* stats, a3byte const* name)
+{
+	if (stats)
+		printf("\n A3 morph blend '%s': %u vertices, %u weighted targets, %u deltas in %.3f ms (%u threads) \n",
+			name ? name : (a3byte const*)"", stats->vertexCount, stats->targetCount, stats->deltaCount,
+			stats->time * 1000.0, stats->threadCount);
+}
+
+
+//-----------------------------------------------------------------------------
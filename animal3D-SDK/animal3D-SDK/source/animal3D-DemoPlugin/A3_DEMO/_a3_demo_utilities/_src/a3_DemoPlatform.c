@@ -0,0 +1,64 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoPlatform.c
+	Platform query implementation.
+*/
+
+#include "../a3_DemoPlatform.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else	// !_WIN32
+#include <time.h>
+#include <unistd.h>
+#endif	// _WIN32
+
+
+//-----------------------------------------------------------------------------
+
+a3f64 a3demo_getTime(void)
+{
+#ifdef _WIN32
+	LARGE_INTEGER t, f;
+	QueryPerformanceCounter(&t);
+	QueryPerformanceFrequency(&f);
+	return (a3f64)t.QuadPart / (a3f64)f.QuadPart;
+#else	// !_WIN32
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (a3f64)t.tv_sec + (a3f64)t.tv_nsec * 1.0e-9;
+#endif	// _WIN32
+}
+
+a3ui32 a3demo_getHardwareThreadCount(void)
+{
+#ifdef _WIN32
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return (a3ui32)info.dwNumberOfProcessors;
+#else	// !_WIN32
+	long const n = sysconf(_SC_NPROCESSORS_ONLN);
+	return n > 0 ? (a3ui32)n : 1;
+#endif	// _WIN32
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,643 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoProceduralGeometry.c
+	Procedural geometry generation service implementation.
+
+	High-resolution shapes are one grid of (slices + 1) x (stacks + 1)
+		vertices mapped onto the surface; seams repeat the first column
+		(and row for torus) so texture coordinates can reach 1. Shapes are
+		built around +Z and turned to their axis by a right-handed basis.
+	Jobs are handed to workers before any thread starts, largest first to
+		the least loaded worker, so no locking is needed and every shape is
+		generated the same way whatever the thread count.
+*/
+
+#include "../a3_DemoProceduralGeometry.h"
+#include "../a3_DemoMemory.h"
+#include "../a3_DemoPlatform.h"
+
+#include "animal3D/a3/a3macros.h"
+#include "animal3D/a3utility/a3_Thread.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+
+// one worker and the jobs handed to it
+typedef struct a3_DemoProceduralWorker
+{
+	a3_DemoProceduralService* service;
+	a3_DemoProceduralProcessFunc process;
+	a3ui32 job[a3demoProcedural_jobMax];
+	a3ui32 jobCount;
+	a3ui32 index;
+	a3ui64 load;							// summed job cost
+	a3boolean launched;						// runs on its own thread
+	a3_Thread thread[1];
+} a3_DemoProceduralWorker;
+
+
+//-----------------------------------------------------------------------------
+// utilities
+
+// continue hash (FNV-1a) with four bytes, low first
+static a3ui64 a3demo_procHash32(a3ui64 hash, a3ui32 const value)
+{
+	hash = (hash ^ (value & 0xffu)) * 0x100000001b3ull;
+	hash = (hash ^ (value >> 8 & 0xffu)) * 0x100000001b3ull;
+	hash = (hash ^ (value >> 16 & 0xffu)) * 0x100000001b3ull;
+	return (hash ^ (value >> 24)) * 0x100000001b3ull;
+}
+
+// continue hash with bits of float
+static a3ui64 a3demo_procHashFloat(a3ui64 const hash, a3f32 const value)
+{
+	a3ui32 bits;
+	memcpy(&bits, &value, sizeof(bits));
+	return a3demo_procHash32(hash, bits);
+}
+
+// descriptors have equal members
+static a3boolean a3demo_procEqual(a3_DemoProceduralDescriptor const* a, a3_DemoProceduralDescriptor const* b)
+{
+	return a->base->shape == b->base->shape &&
+		!memcmp(a->base->bParams, b->base->bParams, sizeof(a->base->bParams)) &&
+		!memcmp(a->base->fParams, b->base->fParams, sizeof(a->base->fParams)) &&
+		a->shape == b->shape && a->flags == b->flags && a->axis == b->axis &&
+		a->slices == b->slices && a->stacks == b->stacks &&
+		!memcmp(a->size, b->size, sizeof(a->size));
+}
+
+// estimated size of shape, for scheduling only
+static a3ui64 a3demo_procCost(a3_DemoProceduralDescriptor const* desc)
+{
+	a3ui64 cost = 1;
+	a3ui32 i;
+	if (desc->shape != a3geomShape_none)
+		return (a3ui64)(desc->slices + 1) * (a3ui64)(desc->stacks + 1);
+	for (i = 0; i < 4; ++i)
+		cost *= desc->base->bParams[i] ? (a3ui64)desc->base->bParams[i] + 1 : 1;
+	return cost;
+}
+
+// right-handed basis whose third vector is shape axis
+static void a3demo_procBasis(a3f32* u_out, a3f32* v_out, a3f32* w_out, a3ui32 const axis)
+{
+	a3ui32 const a = axis % 3;
+	a3f32 const s = axis >= a3geomAxis_x_negative ? -1.0f : +1.0f;
+	memset(u_out, 0, 3 * sizeof(a3f32));
+	memset(w_out, 0, 3 * sizeof(a3f32));
+	u_out[(a + 1) % 3] = 1.0f;
+	w_out[a] = s;
+
+	// v = w x u
+	v_out[0] = w_out[1] * u_out[2] - w_out[2] * u_out[1];
+	v_out[1] = w_out[2] * u_out[0] - w_out[0] * u_out[2];
+	v_out[2] = w_out[0] * u_out[1] - w_out[1] * u_out[0];
+}
+
+// vector in shape space to basis
+static void a3demo_procTurn(a3f32* v_out, a3f32 const* v, a3f32 const* u, a3f32 const* b, a3f32 const* w)
+{
+	v_out[0] = v[0] * u[0] + v[1] * b[0] + v[2] * w[0];
+	v_out[1] = v[0] * u[1] + v[1] * b[1] + v[2] * w[1];
+	v_out[2] = v[0] * u[2] + v[1] * b[2] + v[2] * w[2];
+}
+
+// write one index in selected size
+static void a3demo_procSetIndex(void* indexData, a3ui32 const indexSize, a3ui32 const at, a3ui32 const value)
+{
+	switch (indexSize)
+	{
+	case 1: ((a3ubyte*)indexData)[at] = (a3ubyte)value; break;
+	case 2: ((a3ui16*)indexData)[at] = (a3ui16)value; break;
+	default: ((a3ui32*)indexData)[at] = value; break;
+	}
+}
+
+
+//-----------------------------------------------------------------------------
+// high-resolution shapes
+
+static a3ret a3demo_procGenerateGrid(a3_GeometryData* geom_out, a3_DemoProceduralDescriptor const* desc)
+{
+	a3f64 const tau = 6.283185307179586;
+	a3ui32 const cols = desc->slices, rows = desc->stacks, stride = cols + 1;
+	a3ui32 const vertexCount = stride * (rows + 1);
+	a3boolean const sphere = desc->shape == a3geomShape_sphere, torus = desc->shape == a3geomShape_torus;
+	a3boolean const wireframe = (desc->flags & a3geomFlag_wireframe) != 0;
+	a3boolean const useNormals = !wireframe && (desc->flags & a3geomFlag_normals);
+	a3boolean const useTexcoords = !wireframe && (desc->flags & a3geomFlag_texcoords);
+	a3boolean const useTangents = !wireframe && (desc->flags & a3geomFlag_tangents) == a3geomFlag_tangents;
+
+	a3_GeometryVertexAttributeName attribs[4];
+	a3ui32 attribCount = 0, indexCount, indexSize, at;
+	a3ui32 i, j, hRows, vCols;
+	a3size vertexStorage, indexStorage, offset;
+	a3byte* data;
+	void* indexData;
+	a3f32* position, * normal = 0, * texcoord = 0, * tangent = 0, * bitangent = 0;
+	a3f32 u[3], v[3], w[3], p[3], n[3], t[3];
+	a3f64 psi, cp, sp, cq, sq;
+	a3f64* ring;
+
+	// line or triangle count; sphere rows at the poles are fans, and
+	//	wire seams that repeat another row or column are skipped
+	if (wireframe)
+	{
+		hRows = rows + 1 - (sphere ? 2 : torus ? 1 : 0);
+		vCols = cols + 1 - ((sphere || torus) ? 1 : 0);
+		indexCount = (hRows * cols + vCols * rows) * 2;
+	}
+	else
+		indexCount = (cols * rows * 2 - (sphere ? cols * 2 : 0)) * 3;
+
+	attribs[attribCount++] = a3attrib_geomPosition;
+	if (useNormals)
+		attribs[attribCount++] = a3attrib_geomNormal;
+	if (useTexcoords)
+		attribs[attribCount++] = a3attrib_geomTexcoord;
+	if (useTangents)
+		attribs[attribCount++] = a3attrib_geomTangent;
+	a3geometryCreateVertexFormat(geom_out->vertexFormat, attribs, attribCount);
+	a3geometryCreateIndexFormat(geom_out->indexFormat, vertexCount);
+	vertexStorage = a3vertexFormatGetStorageSpaceRequired(geom_out->vertexFormat, vertexCount);
+	indexStorage = a3indexFormatGetStorageSpaceRequired(geom_out->indexFormat, indexCount);
+	indexSize = geom_out->indexFormat->indexSize;
+
+	// one block for everything (released with free by a3geometryReleaseData)
+	offset = (a3size)vertexCount * (3 + useNormals * 3 + useTexcoords * 2 + useTangents * 6) * sizeof(a3f32);
+	if (offset > vertexStorage || !(data = (a3byte*)malloc((size_t)vertexStorage + indexStorage)))
+		return 0;
+
+	// angles around axis are the same for every row
+	if (!(ring = (a3f64*)a3demo_alloc((size_t)cols * 2 * sizeof(a3f64))))
+	{
+		free(data);
+		return 0;
+	}
+	for (i = 0; i < cols; ++i)
+	{
+		ring[i * 2 + 0] = cos((a3f64)i / (a3f64)cols * tau);
+		ring[i * 2 + 1] = sin((a3f64)i / (a3f64)cols * tau);
+	}
+
+	position = (a3f32*)data;
+	offset = (a3size)vertexCount * 3 * sizeof(a3f32);
+	if (useNormals)
+	{
+		normal = (a3f32*)(data + offset);
+		offset += (a3size)vertexCount * 3 * sizeof(a3f32);
+	}
+	if (useTexcoords)
+	{
+		texcoord = (a3f32*)(data + offset);
+		offset += (a3size)vertexCount * 2 * sizeof(a3f32);
+	}
+	if (useTangents)
+	{
+		tangent = (a3f32*)(data + offset);
+		bitangent = tangent + vertexCount * 3;
+	}
+	indexData = data + vertexStorage;
+
+	// vertices; seam angles come from the first column (and row) so
+	//	repeated vertices match exactly
+	a3demo_procBasis(u, v, w, desc->axis);
+	for (j = 0; j <= rows; ++j)
+	{
+		psi = sphere ? (a3f64)j / (a3f64)rows * 0.5 * tau : (a3f64)(j % rows) / (a3f64)rows * tau;
+		cq = cos(psi);
+		sq = sin(psi);
+		if (sphere && (j == 0 || j == rows))
+			cq = j ? -1.0 : +1.0, sq = 0.0;
+		for (i = 0; i <= cols; ++i)
+		{
+			a3ui32 const k = j * stride + i;
+			cp = ring[(i % cols) * 2 + 0];
+			sp = ring[(i % cols) * 2 + 1];
+			switch (desc->shape)
+			{
+			case a3geomShape_plane:
+				p[0] = ((a3f32)i / (a3f32)cols - 0.5f) * desc->size[0];
+				p[1] = ((a3f32)j / (a3f32)rows - 0.5f) * desc->size[1];
+				p[2] = 0.0f;
+				n[0] = n[1] = 0.0f, n[2] = 1.0f;
+				t[0] = 1.0f, t[1] = t[2] = 0.0f;
+				break;
+			case a3geomShape_sphere:
+				// bottom pole to top pole
+				n[0] = (a3f32)(sq * cp);
+				n[1] = (a3f32)(sq * sp);
+				n[2] = (a3f32)(-cq);
+				p[0] = n[0] * desc->size[0];
+				p[1] = n[1] * desc->size[0];
+				p[2] = n[2] * desc->size[0];
+				t[0] = (a3f32)(-sp), t[1] = (a3f32)cp, t[2] = 0.0f;
+				break;
+			default:
+				// around the axis, then around the tube
+				n[0] = (a3f32)(cq * cp);
+				n[1] = (a3f32)(cq * sp);
+				n[2] = (a3f32)sq;
+				p[0] = (a3f32)(cp * desc->size[0]) + n[0] * desc->size[1];
+				p[1] = (a3f32)(sp * desc->size[0]) + n[1] * desc->size[1];
+				p[2] = n[2] * desc->size[1];
+				t[0] = (a3f32)(-sp), t[1] = (a3f32)cp, t[2] = 0.0f;
+				break;
+			}
+			a3demo_procTurn(position + k * 3, p, u, v, w);
+			if (normal)
+				a3demo_procTurn(normal + k * 3, n, u, v, w);
+			if (texcoord)
+			{
+				texcoord[k * 2 + 0] = (a3f32)i / (a3f32)cols;
+				texcoord[k * 2 + 1] = (a3f32)j / (a3f32)rows;
+			}
+			if (tangent)
+			{
+				a3f32* const tv = tangent + k * 3, * const bv = bitangent + k * 3, * const nv = normal + k * 3;
+				a3demo_procTurn(tv, t, u, v, w);
+				bv[0] = nv[1] * tv[2] - nv[2] * tv[1];
+				bv[1] = nv[2] * tv[0] - nv[0] * tv[2];
+				bv[2] = nv[0] * tv[1] - nv[1] * tv[0];
+			}
+		}
+	}
+	a3demo_release(ring);
+
+	// indices
+	at = 0;
+	if (wireframe)
+	{
+		for (j = (sphere ? 1 : 0); j < (sphere ? rows : torus ? rows : rows + 1); ++j)
+			for (i = 0; i < cols; ++i)
+			{
+				a3demo_procSetIndex(indexData, indexSize, at++, j * stride + i);
+				a3demo_procSetIndex(indexData, indexSize, at++, j * stride + i + 1);
+			}
+		for (i = 0; i < vCols; ++i)
+			for (j = 0; j < rows; ++j)
+			{
+				a3demo_procSetIndex(indexData, indexSize, at++, j * stride + i);
+				a3demo_procSetIndex(indexData, indexSize, at++, j * stride + i + stride);
+			}
+	}
+	else
+	{
+		for (j = 0; j < rows; ++j)
+			for (i = 0; i < cols; ++i)
+			{
+				a3ui32 const a = j * stride + i, b = a + 1, c = b + stride, d = a + stride;
+				if (!sphere || j > 0)
+				{
+					a3demo_procSetIndex(indexData, indexSize, at++, a);
+					a3demo_procSetIndex(indexData, indexSize, at++, b);
+					a3demo_procSetIndex(indexData, indexSize, at++, c);
+				}
+				if (!sphere || j < rows - 1)
+				{
+					a3demo_procSetIndex(indexData, indexSize, at++, a);
+					a3demo_procSetIndex(indexData, indexSize, at++, c);
+					a3demo_procSetIndex(indexData, indexSize, at++, d);
+				}
+			}
+	}
+
+	geom_out->primType = wireframe ? a3prim_lines : a3prim_triangles;
+	geom_out->numVertices = vertexCount;
+	geom_out->numIndices = indexCount;
+	geom_out->data = data;
+	memset(geom_out->attribData, 0, sizeof(geom_out->attribData));
+	geom_out->attribData[a3attrib_geomPosition] = position;
+	geom_out->attribData[a3attrib_geomNormal] = normal;
+	geom_out->attribData[a3attrib_geomTexcoord] = texcoord;
+	geom_out->attribData[a3attrib_geomTangent] = tangent;
+	geom_out->indexData = indexData;
+	return 1;
+}
+
+// fill high-resolution descriptor, or library descriptor if counts fit
+static a3ret a3demo_procCreate(a3_DemoProceduralDescriptor* desc_out, a3_ProceduralGeometryShape const shape,
+	a3_ProceduralGeometryFlag const flags, a3_ProceduralGeometryAxis const axis,
+	a3f32 const size0, a3f32 const size1, a3ui32 const slices, a3ui32 const stacks, a3ui32 const slicesMin, a3ui32 const stacksMin)
+{
+	if (!desc_out)
+		return -1;
+	if (slices < slicesMin || stacks < stacksMin || slices > a3demoProcedural_countMax || stacks > a3demoProcedural_countMax ||
+		!(size0 > 0.0f) || !(size1 > 0.0f))
+		return 0;
+
+	memset(desc_out, 0, sizeof(a3_DemoProceduralDescriptor));
+	if (slices < 256 && stacks < 256)
+	{
+		switch (shape)
+		{
+		case a3geomShape_plane:
+			a3proceduralCreateDescriptorPlane(desc_out->base, flags, axis, size0, size1, (a3ubyte)slices, (a3ubyte)stacks);
+			break;
+		case a3geomShape_sphere:
+			a3proceduralCreateDescriptorSphere(desc_out->base, flags, axis, size0, (a3ubyte)slices, (a3ubyte)stacks);
+			break;
+		default:
+			a3proceduralCreateDescriptorTorus(desc_out->base, flags, axis, size0, size1, (a3ubyte)slices, (a3ubyte)stacks);
+			break;
+		}
+		return 1;
+	}
+	desc_out->base->shape = a3geomShape_none;
+	desc_out->shape = shape;
+	desc_out->flags = flags;
+	desc_out->axis = axis;
+	desc_out->slices = slices;
+	desc_out->stacks = stacks;
+	desc_out->size[0] = size0;
+	desc_out->size[1] = size1;
+	return 1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ui64 a3demo_hashProceduralDescriptor(a3ui64 const key, a3_DemoProceduralDescriptor const* desc)
+{
+	a3ui64 hash = key;
+	a3ui32 i;
+	if (desc)
+	{
+		hash = a3demo_procHash32(hash, (a3ui32)desc->base->shape);
+		for (i = 0; i < 4; ++i)
+			hash = (hash ^ desc->base->bParams[i]) * 0x100000001b3ull;
+		for (i = 0; i < 4; ++i)
+			hash = a3demo_procHashFloat(hash, desc->base->fParams[i]);
+		hash = a3demo_procHash32(hash, desc->shape);
+		hash = a3demo_procHash32(hash, desc->flags);
+		hash = a3demo_procHash32(hash, desc->axis);
+		hash = a3demo_procHash32(hash, desc->slices);
+		hash = a3demo_procHash32(hash, desc->stacks);
+		hash = a3demo_procHashFloat(hash, desc->size[0]);
+		hash = a3demo_procHashFloat(hash, desc->size[1]);
+	}
+	return hash;
+}
+
+a3ret a3demo_createProceduralDescriptor(a3_DemoProceduralDescriptor* desc_out, a3_ProceduralGeometryDescriptor const* base)
+{
+	if (desc_out && base)
+	{
+		memset(desc_out, 0, sizeof(a3_DemoProceduralDescriptor));
+		*desc_out->base = *base;
+		return 1;
+	}
+	return -1;
+}
+
+a3ret a3demo_createProceduralPlane(a3_DemoProceduralDescriptor* desc_out, a3_ProceduralGeometryFlag const flags, a3_ProceduralGeometryAxis const axis,
+	a3f32 const width, a3f32 const height, a3ui32 const subdivsW, a3ui32 const subdivsH)
+{
+	return a3demo_procCreate(desc_out, a3geomShape_plane, flags, axis, width, height, subdivsW, subdivsH, 1, 1);
+}
+
+a3ret a3demo_createProceduralSphere(a3_DemoProceduralDescriptor* desc_out, a3_ProceduralGeometryFlag const flags, a3_ProceduralGeometryAxis const axis,
+	a3f32 const radius, a3ui32 const slices, a3ui32 const stacks)
+{
+	return a3demo_procCreate(desc_out, a3geomShape_sphere, flags, axis, radius, radius, slices, stacks, 3, 2);
+}
+
+a3ret a3demo_createProceduralTorus(a3_DemoProceduralDescriptor* desc_out, a3_ProceduralGeometryFlag const flags, a3_ProceduralGeometryAxis const axis,
+	a3f32 const radiusMajor, a3f32 const radiusMinor, a3ui32 const slices, a3ui32 const subdivsR)
+{
+	return a3demo_procCreate(desc_out, a3geomShape_torus, flags, axis, radiusMajor, radiusMinor, slices, subdivsR, 3, 3);
+}
+
+a3ret a3demo_generateProceduralGeometry(a3_GeometryData* geom_out, a3_DemoProceduralDescriptor const* desc)
+{
+	if (geom_out && !geom_out->data && desc)
+	{
+		switch (desc->shape)
+		{
+		case a3geomShape_none:
+			return a3proceduralGenerateGeometryData(geom_out, desc->base, 0) > 0;
+		case a3geomShape_plane:
+		case a3geomShape_sphere:
+		case a3geomShape_torus:
+			if (desc->slices && desc->stacks && desc->slices <= a3demoProcedural_countMax && desc->stacks <= a3demoProcedural_countMax)
+				return a3demo_procGenerateGrid(geom_out, desc);
+			return 0;
+		default:
+			return 0;
+		}
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+// service
+
+// generate every job handed to worker
+static a3ret a3demo_procRunWorker(a3_DemoProceduralWorker* worker)
+{
+	a3ui32 i;
+	for (i = 0; i < worker->jobCount; ++i)
+	{
+		a3_DemoProceduralJob* const job = worker->service->job + worker->job[i];
+		a3f64 const timeStart = a3demo_getTime();
+		job->result = a3demo_generateProceduralGeometry(job->geom, job->desc);
+		if (job->result > 0 && worker->process)
+			worker->process(job->geom, job->user);
+		job->thread = worker->index;
+		job->time = a3demo_getTime() - timeStart;
+	}
+	return 1;
+}
+
+
+a3ret a3demo_initProceduralService(a3_DemoProceduralService* service)
+{
+	if (service)
+	{
+		memset(service, 0, sizeof(a3_DemoProceduralService));
+		return 1;
+	}
+	return -1;
+}
+
+a3ret a3demo_requestProceduralGeometry(a3_DemoProceduralService* service, a3_GeometryData* geom_out, a3_DemoProceduralDescriptor const* desc,
+	a3byte const* name_opt, void* user_opt)
+{
+	a3_DemoProceduralJob* job;
+	a3ui64 hash;
+	a3ui32 i;
+	if (service && geom_out && desc && service->requestCount < a3demoProcedural_requestMax)
+	{
+		// match earlier shape
+		hash = a3demo_hashProceduralDescriptor(0xcbf29ce484222325ull, desc);
+		for (i = 0; i < service->jobCount; ++i)
+			if (service->job[i].hash == hash && a3demo_procEqual(service->job[i].desc, desc))
+				break;
+		if (i == service->jobCount)
+		{
+			if (service->jobCount >= a3demoProcedural_jobMax)
+				return -1;
+			job = service->job + service->jobCount++;
+			memset(job, 0, sizeof(a3_DemoProceduralJob));
+			*job->desc = *desc;
+			job->hash = hash;
+			job->cost = a3demo_procCost(desc);
+			job->user = user_opt;
+			if (name_opt)
+				strncpy(job->name, name_opt, sizeof(job->name) - 1);
+		}
+		service->job[i].requestCount++;
+		service->request[service->requestCount].geom_out = geom_out;
+		service->request[service->requestCount].job = i;
+		service->requestCount++;
+		return (service->job[i].requestCount == 1);
+	}
+	return -1;
+}
+
+a3ret a3demo_runProceduralService(a3_DemoProceduralService* service, a3ui32 const threadCount,
+	a3_DemoProceduralProcessFunc process_opt)
+{
+	a3_DemoProceduralWorker worker[a3demoProcedural_threadMax];
+	a3ui32 pending[a3demoProcedural_jobMax];
+	a3ui32 pendingCount = 0, workerCount;
+	a3ui32 i, j, k;
+	a3f64 timeStart;
+	if (!service)
+		return -1;
+	timeStart = a3demo_getTime();
+
+	// shapes not generated yet, largest first (stable, so equal costs
+	//	keep request order)
+	for (i = 0; i < service->jobCount; ++i)
+		if (!service->job[i].done)
+		{
+			for (j = pendingCount; j > 0 && service->job[pending[j - 1]].cost < service->job[i].cost; --j)
+				pending[j] = pending[j - 1];
+			pending[j] = i;
+			++pendingCount;
+		}
+
+	workerCount = threadCount ? threadCount : a3demo_getHardwareThreadCount();
+	workerCount = workerCount < a3demoProcedural_threadMax ? workerCount : a3demoProcedural_threadMax;
+	workerCount = workerCount < pendingCount ? workerCount : pendingCount;
+	workerCount = workerCount ? workerCount : 1;
+
+	// hand each shape to least loaded worker
+	memset(worker, 0, sizeof(worker));
+	for (k = 0; k < workerCount; ++k)
+	{
+		worker[k].service = service;
+		worker[k].process = process_opt;
+		worker[k].index = k;
+	}
+	for (i = 0; i < pendingCount; ++i)
+	{
+		for (j = 0, k = 1; k < workerCount; ++k)
+			if (worker[k].load < worker[j].load)
+				j = k;
+		worker[j].job[worker[j].jobCount++] = pending[i];
+		worker[j].load += service->job[pending[i]].cost;
+	}
+
+	// first worker runs on calling thread; workers whose thread did not
+	//	start run here after it
+	for (k = 1; k < workerCount; ++k)
+		worker[k].launched = a3threadLaunch(worker[k].thread, (a3_threadfunc)a3demo_procRunWorker, worker + k, "a3demo_runProceduralService") > 0;
+	a3demo_procRunWorker(worker);
+	for (k = 1; k < workerCount; ++k)
+		if (worker[k].launched)
+			a3threadWait(worker[k].thread);
+		else
+			a3demo_procRunWorker(worker + k);
+	for (i = 0; i < pendingCount; ++i)
+		service->job[pending[i]].done = a3true;
+
+	// every request sees shared result
+	for (i = 0; i < service->requestCount; ++i)
+	{
+		a3_DemoProceduralJob const* const job = service->job + service->request[i].job;
+		if (job->result > 0)
+			*service->request[i].geom_out = *job->geom;
+		else
+			memset(service->request[i].geom_out, 0, sizeof(a3_GeometryData));
+	}
+
+	service->threadCount = workerCount;
+	service->generateCount = pendingCount;
+	service->time = a3demo_getTime() - timeStart;
+	return pendingCount;
+}
+
+a3ret a3demo_isGeometryProcedural(a3_DemoProceduralService const* service, a3_GeometryData const* geom)
+{
+	a3ui32 i;
+	if (service && geom)
+	{
+		if (geom->data)
+			for (i = 0; i < service->jobCount; ++i)
+				if (service->job[i].geom->data == geom->data)
+					return 1;
+		return 0;
+	}
+	return -1;
+}
+
+a3ret a3demo_releaseProceduralService(a3_DemoProceduralService* service)
+{
+	a3ui32 i;
+	if (service)
+	{
+		for (i = 0; i < service->jobCount; ++i)
+			if (service->job[i].geom->data)
+				a3geometryReleaseData(service->job[i].geom);
+		return a3demo_initProceduralService(service);
+	}
+	return -1;
+}
+
+void a3demo_printProceduralService(a3_DemoProceduralService const* service)
+{
+	a3ui32 i;
+	if (service)
+	{
+		printf("\n A3 procedural: %u requests, %u shapes (%u shared); %u generated on %u threads in %.2f ms \n",
+			service->requestCount, service->jobCount, service->requestCount - service->jobCount,
+			service->generateCount, service->threadCount, service->time * 1000.0);
+		for (i = 0; i < service->jobCount; ++i)
+			if (service->job[i].result > 0)
+				printf("    '%s': %u vertices, %u indices in %.2f ms (thread %u, %u requests) \n",
+					service->job[i].name, service->job[i].geom->numVertices, service->job[i].geom->numIndices,
+					service->job[i].time * 1000.0, service->job[i].thread, service->job[i].requestCount);
+			else
+				printf("    '%s': failed \n", service->job[i].name);
+	}
+}
+
+
+//-----------------------------------------------------------------------------
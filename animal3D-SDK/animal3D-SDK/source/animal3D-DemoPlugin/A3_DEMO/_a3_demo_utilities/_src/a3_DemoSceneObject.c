@@ -38,13 +38,18 @@ extern inline void a3demo_initSceneObject(a3_DemoSceneObject *sceneObject)
 	a3real3Set(sceneObject->position.v, a3real_zero, a3real_zero, a3real_zero);
 }
 
-extern inline void a3demo_updateSceneObject(a3_DemoSceneObject *sceneObject, const a3boolean useZYX)
+extern inline void a3demo_updateSceneObjectModelMat(a3_DemoSceneObject *sceneObject, const a3boolean useZYX)
 {
 	if (useZYX)
 		a3real4x4SetRotateZYX(sceneObject->modelMat.m, sceneObject->euler.x, sceneObject->euler.y, sceneObject->euler.z);
 	else
 		a3real4x4SetRotateXYZ(sceneObject->modelMat.m, sceneObject->euler.x, sceneObject->euler.y, sceneObject->euler.z);
 	sceneObject->modelMat.v3.xyz = sceneObject->position;
+}
+
+extern inline void a3demo_updateSceneObject(a3_DemoSceneObject *sceneObject, const a3boolean useZYX)
+{
+	a3demo_updateSceneObjectModelMat(sceneObject, useZYX);
 	a3real4x4TransformInverseIgnoreScale(sceneObject->modelMatInv.m, sceneObject->modelMat.m);
 }
 
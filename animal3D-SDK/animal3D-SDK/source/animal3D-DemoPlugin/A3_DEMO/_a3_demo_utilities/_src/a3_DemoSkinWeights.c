@@ -0,0 +1,610 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoSkinWeights.c
+	Streaming skin weight importer implementation.
+
+	Importing runs in two steps:
+		1. scan: the file is read into a fixed buffer and split into
+			elements, keeping an unfinished element at the front of the
+			buffer for the next read; each element goes to a handler:
+			'shape' gives the vertex count, 'weights' opens the list of
+			one influence (its name is looked up once per list) and each
+			'point' inside inserts its weight into the vertex's sorted
+			list of largest weights, pushing out the smallest
+		2. store: kept weights of every vertex are renormalized and
+			quantized; rounding error goes to the largest weight so that
+			quantized weights sum exactly to one
+*/
+
+#include "../a3_DemoSkinWeights.h"
+#include "../a3_DemoMemory.h"
+#include "../a3_DemoPlatform.h"
+
+#include "animal3D/a3/a3macros.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+
+// most attributes read per element; further ones overwrite the last
+#define a3demo_skinAttribMax	8
+
+// one attribute of scanned element; not terminated
+typedef struct a3_DemoSkinAttrib
+{
+	a3byte const* name;
+	a3byte const* value;
+	a3ui32 nameLength, valueLength;
+} a3_DemoSkinAttrib;
+
+// element callbacks; return 0 to stop scanning
+typedef struct a3_DemoSkinHandler
+{
+	void* user;
+	a3ret(*elementStart)(void* user, a3byte const* name, a3ui32 const nameLength, a3_DemoSkinAttrib const* attrib, a3ui32 const attribCount);
+	a3ret(*elementEnd)(void* user, a3byte const* name, a3ui32 const nameLength);
+} a3_DemoSkinHandler;
+
+// import in progress
+typedef struct a3_DemoSkinImport
+{
+	a3_Hierarchy const* hierarchy;
+	a3i32* nameSlot;						// node plus one per hash slot, zero if empty
+	a3ui32 nameMask;
+	a3f32* topWeight;						// kept weights per vertex, largest first
+	a3i32* topIndex;						// node of each kept weight
+	a3ui32* rawCount;						// weights seen per vertex
+	a3ui32 vertexCount, vertexCapacity;
+	a3ui32 shapeSize;						// points in shape, zero if not given
+	a3ui32 keepCount;
+	a3i32 current;							// node of open weight list, -1 if dropped
+	a3ui32 depth;							// open elements; file is cut short if not zero at end
+	a3boolean inWeights;
+	a3_DemoSkinWeightsStats stats;
+} a3_DemoSkinImport;
+
+
+// bytes per stored weight and largest value of each format
+static a3ui32 const a3demo_skinWeightSize[] = { 4, 2, 1 };
+static a3f32 const a3demo_skinWeightMax[] = { 1.0f, 65535.0f, 255.0f };
+
+
+//-----------------------------------------------------------------------------
+// utilities
+
+static a3boolean a3demo_internalSkinIsSpace(a3byte const c)
+{
+	return (c == ' ' || c == '\t' || c == '\n' || c == '\r');
+}
+
+static a3boolean a3demo_internalSkinIs(a3byte const* name, a3ui32 const nameLength, a3byte const* literal)
+{
+	return (strlen(literal) == nameLength && !memcmp(name, literal, nameLength));
+}
+
+static a3_DemoSkinAttrib const* a3demo_internalSkinAttrib(a3_DemoSkinAttrib const* attrib, a3ui32 const attribCount, a3byte const* name)
+{
+	a3ui32 i;
+	for (i = 0; i < attribCount; ++i)
+		if (a3demo_internalSkinIs(attrib[i].name, attrib[i].nameLength, name))
+			return (attrib + i);
+	return 0;
+}
+
+// unsigned integer filling whole value; returns 1 if read
+static a3boolean a3demo_internalSkinParseIndex(a3_DemoSkinAttrib const* attrib, a3ui32* value_out)
+{
+	a3byte const* c = attrib->value, * const end = c + attrib->valueLength;
+	a3ui64 value = 0;
+	a3ui32 d;
+	for (; c < end && a3demo_internalSkinIsSpace(*c); ++c);
+	if (c == end)
+		return a3false;
+	for (; c < end && (d = (a3ui32)(*c - '0')) < 10 && value <= 0xffffffffull; ++c)
+		value = value * 10 + d;
+	for (; c < end && a3demo_internalSkinIsSpace(*c); ++c);
+	*value_out = (a3ui32)value;
+	return (c == end && value < 0xffffffffull);
+}
+
+// decimal with optional sign, fraction and exponent filling whole value;
+//	returns 1 if read
+static a3boolean a3demo_internalSkinParseWeight(a3_DemoSkinAttrib const* attrib, a3f32* value_out)
+{
+	a3byte const* c = attrib->value, * const end = c + attrib->valueLength;
+	a3f64 value = 0.0, scale = 1.0;
+	a3i32 exponent = 0, digits = 0;
+	a3boolean negative = a3false, negativeExponent = a3false;
+	a3ui32 d;
+	for (; c < end && a3demo_internalSkinIsSpace(*c); ++c);
+	if (c < end && (*c == '-' || *c == '+'))
+		negative = (*c++ == '-');
+	for (; c < end && (d = (a3ui32)(*c - '0')) < 10; ++c, ++digits)
+		value = value * 10.0 + (a3f64)d;
+	if (c < end && *c == '.')
+		for (++c; c < end && (d = (a3ui32)(*c - '0')) < 10; ++c, ++digits)
+			value += (a3f64)d * (scale *= 0.1);
+	if (!digits)
+		return a3false;
+	if (c < end && (*c == 'e' || *c == 'E'))
+	{
+		if (++c < end && (*c == '-' || *c == '+'))
+			negativeExponent = (*c++ == '-');
+		if (c == end || (a3ui32)(*c - '0') >= 10)
+			return a3false;
+		for (; c < end && (d = (a3ui32)(*c - '0')) < 10; ++c)
+			if (exponent < 1000)
+				exponent = exponent * 10 + d;
+		value *= pow(10.0, negativeExponent ? -exponent : exponent);
+	}
+	for (; c < end && a3demo_internalSkinIsSpace(*c); ++c);
+	*value_out = (a3f32)(negative ? -value : value);
+	return (c == end);
+}
+
+
+//-----------------------------------------------------------------------------
+// names
+
+// FNV-1a over name as hierarchy stores it
+static a3ui32 a3demo_internalSkinHash(a3byte const* name, a3ui32 const nameLength)
+{
+	a3ui32 hash = 2166136261u, i;
+	for (i = 0; i < nameLength; ++i)
+		hash = (hash ^ (a3ubyte)name[i]) * 16777619u;
+	return hash;
+}
+
+// slot holding name or empty slot where it goes
+static a3i32* a3demo_internalSkinNameSlot(a3_DemoSkinImport const* import, a3byte const* name, a3ui32 nameLength)
+{
+	a3_HierarchyNode const* const node = import->hierarchy->nodes;
+	a3i32* slot;
+	a3ui32 i;
+	if (nameLength > a3node_nameSize - 1)
+		nameLength = a3node_nameSize - 1;
+	for (i = a3demo_internalSkinHash(name, nameLength); ; ++i)
+	{
+		slot = import->nameSlot + (i & import->nameMask);
+		if (!*slot || (!memcmp(node[*slot - 1].name, name, nameLength) && !node[*slot - 1].name[nameLength]))
+			return slot;
+	}
+}
+
+// hash node names; first of equal names wins, as in node lookup
+static a3boolean a3demo_internalSkinHashNames(a3_DemoSkinImport* import)
+{
+	a3_HierarchyNode const* const node = import->hierarchy->nodes;
+	a3ui32 const nodeCount = import->hierarchy->numNodes;
+	a3ui32 capacity = 16, i;
+	a3i32* slot;
+	while (capacity < nodeCount * 2)
+		capacity *= 2;
+	import->nameSlot = (a3i32*)a3demo_allocZero((size_t)capacity * sizeof(a3i32));
+	import->nameMask = capacity - 1;
+	if (!import->nameSlot)
+		return a3false;
+	for (i = 0; i < nodeCount; ++i)
+		if (*node[i].name)
+		{
+			slot = a3demo_internalSkinNameSlot(import, node[i].name, (a3ui32)strlen(node[i].name));
+			if (!*slot)
+				*slot = (a3i32)i + 1;
+		}
+	return a3true;
+}
+
+
+//-----------------------------------------------------------------------------
+// weights
+
+static a3boolean a3demo_internalSkinReserve(a3_DemoSkinImport* import, a3ui32 const vertexCount)
+{
+	a3ui32 capacity = import->vertexCapacity > 1024 ? import->vertexCapacity : 1024;
+	void* p;
+	if (vertexCount > import->vertexCapacity)
+	{
+		while (capacity < vertexCount)
+			capacity = capacity * 2 > capacity ? capacity * 2 : vertexCount;
+		if (!(p = a3demo_resize(import->topWeight, (size_t)capacity * import->keepCount * sizeof(a3f32))))
+			return a3false;
+		import->topWeight = (a3f32*)p;
+		if (!(p = a3demo_resize(import->topIndex, (size_t)capacity * import->keepCount * sizeof(a3i32))))
+			return a3false;
+		import->topIndex = (a3i32*)p;
+		if (!(p = a3demo_resize(import->rawCount, (size_t)capacity * sizeof(a3ui32))))
+			return a3false;
+		import->rawCount = (a3ui32*)p;
+		memset(import->rawCount + import->vertexCapacity, 0, (size_t)(capacity - import->vertexCapacity) * sizeof(a3ui32));
+		import->vertexCapacity = capacity;
+	}
+	if (vertexCount > import->vertexCount)
+		import->vertexCount = vertexCount;
+	return a3true;
+}
+
+// keep weight if it is among vertex's largest; equal weights stay in file order
+static void a3demo_internalSkinInsert(a3_DemoSkinImport* import, a3ui32 const vertex, a3i32 const node, a3f32 const weight)
+{
+	a3ui32 const n = import->keepCount;
+	a3f32* const w = import->topWeight + (size_t)vertex * n;
+	a3i32* const k = import->topIndex + (size_t)vertex * n;
+	a3ui32 j = import->rawCount[vertex]++;
+	if (j >= n)
+	{
+		if (weight <= w[n - 1])
+			return;
+		j = n - 1;
+	}
+	for (; j > 0 && w[j - 1] < weight; --j)
+	{
+		w[j] = w[j - 1];
+		k[j] = k[j - 1];
+	}
+	w[j] = weight;
+	k[j] = node;
+}
+
+
+//-----------------------------------------------------------------------------
+// handlers
+
+static a3ret a3demo_internalSkinElementStart(void* user, a3byte const* name, a3ui32 const nameLength, a3_DemoSkinAttrib const* attrib, a3ui32 const attribCount)
+{
+	a3_DemoSkinImport* const import = (a3_DemoSkinImport*)user;
+	a3_DemoSkinAttrib const* a, * b;
+	a3ui32 vertex;
+	a3f32 weight;
+	a3i32 const* slot;
+	++import->depth;
+
+	// one weight of open list
+	if (import->inWeights && a3demo_internalSkinIs(name, nameLength, "point"))
+	{
+		a = a3demo_internalSkinAttrib(attrib, attribCount, "index");
+		b = a3demo_internalSkinAttrib(attrib, attribCount, "value");
+		if (!a || !b || !a3demo_internalSkinParseIndex(a, &vertex) || !a3demo_internalSkinParseWeight(b, &weight))
+			return 0;
+
+		// index past shape would grow tables without bound
+		if (import->shapeSize && vertex >= import->shapeSize)
+			return 0;
+		if (!a3demo_internalSkinReserve(import, vertex + 1))
+			return 0;
+		if (weight > 0.0f)
+		{
+			++import->stats.pointCount;
+			if (import->current >= 0)
+				a3demo_internalSkinInsert(import, vertex, import->current, weight);
+		}
+	}
+
+	// open list of one influence
+	else if (a3demo_internalSkinIs(name, nameLength, "weights"))
+	{
+		import->inWeights = a3true;
+		import->current = (a3i32)import->stats.influenceCount++;
+		if (import->hierarchy)
+		{
+			a = a3demo_internalSkinAttrib(attrib, attribCount, "source");
+			slot = a ? a3demo_internalSkinNameSlot(import, a->value, a->valueLength) : 0;
+			import->current = slot ? *slot - 1 : -1;
+			import->stats.unmatchedCount += (import->current < 0);
+		}
+	}
+
+	// point count of shape
+	else if (a3demo_internalSkinIs(name, nameLength, "shape"))
+	{
+		a = a3demo_internalSkinAttrib(attrib, attribCount, "size");
+		if (a && a3demo_internalSkinParseIndex(a, &vertex))
+		{
+			if (!a3demo_internalSkinReserve(import, vertex))
+				return 0;
+			import->shapeSize = vertex;
+		}
+	}
+	return 1;
+}
+
+static a3ret a3demo_internalSkinElementEnd(void* user, a3byte const* name, a3ui32 const nameLength)
+{
+	a3_DemoSkinImport* const import = (a3_DemoSkinImport*)user;
+	if (!import->depth--)
+		return 0;
+	if (a3demo_internalSkinIs(name, nameLength, "weights"))
+	{
+		import->inWeights = a3false;
+		import->current = -1;
+	}
+	return 1;
+}
+
+
+//-----------------------------------------------------------------------------
+// scanner
+
+// split element between angle brackets into name and attributes and
+//	pass it on; returns 0 if malformed or handler stopped
+static a3ret a3demo_internalSkinElement(a3byte const* c, a3byte const* end, a3_DemoSkinHandler const* handler)
+{
+	a3_DemoSkinAttrib attrib[a3demo_skinAttribMax], * a = attrib;
+	a3byte const* name;
+	a3ui32 nameLength;
+	a3boolean empty = a3false;
+	a3byte quote;
+
+	// end element
+	if (*c == '/')
+	{
+		for (name = ++c; c < end && !a3demo_internalSkinIsSpace(*c); ++c);
+		return handler->elementEnd(handler->user, name, (a3ui32)(c - name));
+	}
+
+	// start or empty element: name, then attributes until end; extra
+	//	attributes overwrite the last slot
+	if (end > c && end[-1] == '/')
+	{
+		empty = a3true;
+		--end;
+	}
+	for (name = c; c < end && !a3demo_internalSkinIsSpace(*c); ++c);
+	nameLength = (a3ui32)(c - name);
+	if (!nameLength)
+		return 0;
+	for (;;)
+	{
+		for (; c < end && a3demo_internalSkinIsSpace(*c); ++c);
+		if (c == end)
+			break;
+		for (a->name = c; c < end && *c != '=' && !a3demo_internalSkinIsSpace(*c); ++c);
+		a->nameLength = (a3ui32)(c - a->name);
+		for (; c < end && a3demo_internalSkinIsSpace(*c); ++c);
+		if (c == end || *c != '=')
+			return 0;
+		for (++c; c < end && a3demo_internalSkinIsSpace(*c); ++c);
+		if (c == end || (*c != '"' && *c != '\''))
+			return 0;
+		quote = *c++;
+		a->value = c;
+		if (!(c = (a3byte const*)memchr(c, quote, end - c)))
+			return 0;
+		a->valueLength = (a3ui32)(c++ - a->value);
+		a += (a < attrib + a3demo_skinAttribMax - 1);
+	}
+	if (!handler->elementStart(handler->user, name, nameLength, attrib, (a3ui32)(a - attrib)))
+		return 0;
+	return (empty ? handler->elementEnd(handler->user, name, nameLength) : 1);
+}
+
+// read file through buffer and hand each element to handler; declarations,
+//	comments and text are skipped; returns 1 if whole file was read, 0 if
+//	malformed, an element did not fit the buffer or handler stopped
+static a3ret a3demo_internalSkinScan(FILE* fp, a3byte* const buffer, a3_DemoSkinHandler const* handler, a3size* fileSize_out)
+{
+	a3byte* c = buffer, * end = buffer, * close;
+	a3size keep, n;
+	a3boolean eof = a3false;
+
+	for (;;)
+	{
+		// next element and its end; comments may hold '>'
+		c = (a3byte*)memchr(c, '<', end - c);
+		close = 0;
+		if (c && end - c >= 4 && !memcmp(c, "<!--", 4))
+		{
+			for (close = c + 4; close + 2 < end && memcmp(close, "-->", 3); ++close);
+			close = close + 2 < end ? close + 2 : 0;
+		}
+		else if (c)
+			close = (a3byte*)memchr(c, '>', end - c);
+
+		// element complete: pass on anything but declarations and comments
+		if (close)
+		{
+			if (c[1] != '?' && c[1] != '!' && !a3demo_internalSkinElement(c + 1, close, handler))
+				return 0;
+			c = close + 1;
+			continue;
+		}
+
+		// move unfinished element to front and fill rest of buffer
+		if (eof)
+			return (c == 0);
+		keep = c ? (a3size)(end - c) : 0;
+		if (keep == a3demoSkinWeights_bufferSize)
+			return 0;
+		if (keep)
+			memmove(buffer, c, keep);
+		n = fread(buffer + keep, 1, a3demoSkinWeights_bufferSize - keep, fp);
+		*fileSize_out += n;
+		eof = (n == 0);
+		c = buffer;
+		end = buffer + keep + n;
+	}
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_importSkinWeights(a3_DemoSkinWeights* weights_out, a3byte const* filePath, a3_Hierarchy const* hierarchy_opt,
+	a3ui32 const influenceCount, a3_DemoSkinWeightFormat const format, a3_DemoSkinWeightsStats* stats_out_opt)
+{
+	a3_DemoSkinImport import[1] = { 0 };
+	a3_DemoSkinHandler handler[1] = { 0 };
+	a3_DemoSkinWeights weights[1] = { 0 };
+	FILE* fp = 0;
+	a3byte* buffer = 0;
+	a3f64 t0, t1;
+	a3ret result = 0;
+
+	a3f32 const* w;
+	a3i32 const* k;
+	a3f32 sum, value;
+	a3f32 const quantMax = a3demo_skinWeightMax[format > a3demoSkinWeight_unorm8 ? 0 : format];
+	a3i32 q[a3demoSkinWeights_influenceMax], total;
+	a3ui32 v, j, kept, weightBytes;
+
+	if (weights_out && filePath && *filePath && influenceCount && influenceCount <= a3demoSkinWeights_influenceMax &&
+		format <= a3demoSkinWeight_unorm8 && (!hierarchy_opt || (hierarchy_opt->nodes && hierarchy_opt->numNodes)))
+	{
+		t0 = a3demo_getTime();
+		import->hierarchy = hierarchy_opt;
+		import->keepCount = influenceCount;
+		import->current = -1;
+		import->stats.keepCount = influenceCount;
+		handler->user = import;
+		handler->elementStart = a3demo_internalSkinElementStart;
+		handler->elementEnd = a3demo_internalSkinElementEnd;
+
+		// 1. scan
+		buffer = (a3byte*)a3demo_alloc(a3demoSkinWeights_bufferSize);
+		fp = fopen(filePath, "rb");
+		if (buffer && fp && (!hierarchy_opt || a3demo_internalSkinHashNames(import)) &&
+			a3demo_internalSkinScan(fp, buffer, handler, &import->stats.fileSize) && !import->depth && import->vertexCount)
+		{
+			// 2. store: weights block first, then nodes
+			t1 = a3demo_getTime();
+			weights->vertexCount = import->vertexCount;
+			weights->influenceCount = influenceCount;
+			weights->format = format;
+			weights->weightSize = a3demo_skinWeightSize[format];
+			weightBytes = (weights->vertexCount * influenceCount * weights->weightSize + 15) & ~15u;
+			weights->data = a3demo_alloc((size_t)weightBytes + (size_t)weights->vertexCount * influenceCount * sizeof(a3i32));
+			if (weights->data)
+			{
+				weights->weight = weights->data;
+				weights->index = (a3i32*)((a3ubyte*)weights->data + weightBytes);
+				for (v = 0; v < weights->vertexCount; ++v)
+				{
+					w = import->topWeight + (size_t)v * influenceCount;
+					k = import->topIndex + (size_t)v * influenceCount;
+					kept = import->rawCount[v] < influenceCount ? import->rawCount[v] : influenceCount;
+					import->stats.rawMax = import->rawCount[v] > import->stats.rawMax ? import->rawCount[v] : import->stats.rawMax;
+					import->stats.truncatedCount += (import->rawCount[v] > influenceCount);
+					import->stats.unweightedCount += (kept == 0);
+					for (j = 0, sum = 0.0f; j < kept; ++j)
+						sum += w[j];
+					sum = sum > 0.0f ? quantMax / sum : 0.0f;
+					for (j = 0, total = 0; j < influenceCount; ++j)
+					{
+						value = j < kept ? w[j] * sum : 0.0f;
+						weights->index[v * influenceCount + j] = j < kept ? k[j] : 0;
+						if (format == a3demoSkinWeight_float)
+							((a3f32*)weights->weight)[v * influenceCount + j] = value;
+						else
+							total += (q[j] = (a3i32)(value + 0.5f));
+					}
+
+					// largest weight takes rounding error
+					if (format != a3demoSkinWeight_float)
+					{
+						if (kept)
+						{
+							q[0] += (a3i32)quantMax - total;
+							q[0] = q[0] < 0 ? 0 : q[0] > (a3i32)quantMax ? (a3i32)quantMax : q[0];
+						}
+						for (j = 0; j < influenceCount; ++j)
+							if (format == a3demoSkinWeight_unorm16)
+								((a3ui16*)weights->weight)[v * influenceCount + j] = (a3ui16)q[j];
+							else
+								((a3ubyte*)weights->weight)[v * influenceCount + j] = (a3ubyte)q[j];
+					}
+				}
+				*weights_out = *weights;
+				import->stats.vertexCount = weights->vertexCount;
+				import->stats.storeTime = a3demo_getTime() - t1;
+				import->stats.parseTime = t1 - t0;
+				result = (a3ret)weights->vertexCount;
+			}
+		}
+
+		// done
+		if (fp)
+			fclose(fp);
+		a3demo_release(buffer);
+		a3demo_release(import->nameSlot);
+		a3demo_release(import->topWeight);
+		a3demo_release(import->topIndex);
+		a3demo_release(import->rawCount);
+		if (stats_out_opt)
+		{
+			import->stats.totalTime = a3demo_getTime() - t0;
+			import->stats.megabytesPerSecond = import->stats.totalTime > 0.0 ?
+				(a3f64)import->stats.fileSize / (1024.0 * 1024.0) / import->stats.totalTime : 0.0;
+			*stats_out_opt = import->stats;
+		}
+		return result;
+	}
+	return -1;
+}
+
+
+a3ret a3demo_releaseSkinWeights(a3_DemoSkinWeights* weights)
+{
+	if (weights)
+	{
+		a3demo_release(weights->data);
+		memset(weights, 0, sizeof(a3_DemoSkinWeights));
+		return 1;
+	}
+	return -1;
+}
+
+
+a3ret a3demo_getSkinWeights(a3f32* weight_out, a3i32* index_out_opt, a3_DemoSkinWeights const* weights, a3ui32 const vertex)
+{
+	a3ui32 const n = weights ? weights->influenceCount : 0;
+	a3ui32 j;
+	if (weight_out && weights && weights->data && vertex < weights->vertexCount)
+	{
+		for (j = 0; j < n; ++j)
+			if (weights->format == a3demoSkinWeight_unorm16)
+				weight_out[j] = (a3f32)((a3ui16 const*)weights->weight)[vertex * n + j] / 65535.0f;
+			else if (weights->format == a3demoSkinWeight_unorm8)
+				weight_out[j] = (a3f32)((a3ubyte const*)weights->weight)[vertex * n + j] / 255.0f;
+			else
+				weight_out[j] = ((a3f32 const*)weights->weight)[vertex * n + j];
+		if (index_out_opt)
+			memcpy(index_out_opt, weights->index + vertex * n, n * sizeof(a3i32));
+		return n;
+	}
+	return -1;
+}
+
+
+void a3demo_printSkinWeightsStats(a3_DemoSkinWeightsStats const* stats, a3byte const* filePath)
+{
+	if (stats)
+		printf("\n A3 imported skin weights '%s': %.2f MB in %.2f ms (%.1f MB/s; parse %.2f ms, store %.2f ms)"
+			"\n    %u vertices, %u influences (%u unmatched), %u weights; up to %u per vertex, %u vertices cut to %u, %u unweighted \n",
+			filePath ? filePath : (a3byte const*)"", (a3f64)stats->fileSize / (1024.0 * 1024.0), stats->totalTime * 1000.0,
+			stats->megabytesPerSecond, stats->parseTime * 1000.0, stats->storeTime * 1000.0,
+			stats->vertexCount, stats->influenceCount, stats->unmatchedCount, stats->pointCount,
+			stats->rawMax, stats->truncatedCount, stats->keepCount, stats->unweightedCount);
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,203 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoSpriteBatch.c
+	Sprite batch implementation.
+*/
+
+#include "../a3_DemoSpriteBatch.h"
+#include "../a3_DemoMemory.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+
+// select cell within clip given number of cells elapsed
+static inline a3ui32 a3demo_spriteClipCell_internal(const a3_DemoSpriteClip* clip, const a3ui32 frame)
+{
+	a3ui32 period, f;
+	if (clip->cellCount <= 1)
+		return clip->firstCell;
+	switch (clip->mode)
+	{
+	case a3demoSpriteClip_pingPong:
+		period = (clip->cellCount - 1) * 2;
+		f = frame % period;
+		return clip->firstCell + (f < clip->cellCount ? f : period - f);
+	case a3demoSpriteClip_stop:
+		return clip->firstCell + (frame < clip->cellCount ? frame : clip->cellCount - 1);
+	default:
+		return clip->firstCell + frame % clip->cellCount;
+	}
+}
+
+// clip must play at least one cell, all within the uploaded table
+static inline a3boolean a3demo_spriteClipValid_internal(const a3_DemoSpriteClip* clip, const a3ui32 numCells)
+{
+	return clip->firstCell < numCells && clip->cellCount && clip->cellCount <= numCells - clip->firstCell;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3i32 a3demo_createSpriteBatch(a3_DemoSpriteBatch* batch_out, const a3ui32 capacity, const a3_TextureAtlas* atlas, const a3_DemoSpriteClip* clips, const a3ui32 clipCount)
+{
+	// two vec4 per cell: texture offset and size, local offset
+	a3f32 cellData[a3demoSprite_cellMax][8] = { 0 };
+	const a3_TextureAtlasCell* cell;
+	a3ui32 i, numCells;
+
+	if (batch_out && capacity && atlas && atlas->cells && clips && clipCount && !batch_out->instance)
+	{
+		// every clip must stay within the cells the table holds
+		numCells = atlas->numCells < a3demoSprite_cellMax ? atlas->numCells : a3demoSprite_cellMax;
+		for (i = 0; i < clipCount; ++i)
+			if (!a3demo_spriteClipValid_internal(clips + i, numCells))
+				return -1;
+
+		// CPU data in one allocation
+		batch_out->instance = (a3_DemoSpriteInstance*)a3demo_alloc((sizeof(a3_DemoSpriteInstance) + sizeof(a3f32) + sizeof(a3ui16)) * capacity);
+		if (!batch_out->instance)
+			return -1;
+		batch_out->clipTime = (a3f32*)(batch_out->instance + capacity);
+		batch_out->clipIndex = (a3ui16*)(batch_out->clipTime + capacity);
+
+		// pack atlas cells; local offsets become fractions of cell size
+		for (i = 0, cell = atlas->cells; i < numCells; ++i, ++cell)
+		{
+			cellData[i][0] = cell->relativeOffset[0];
+			cellData[i][1] = cell->relativeOffset[1];
+			cellData[i][2] = cell->relativeSize[0];
+			cellData[i][3] = cell->relativeSize[1];
+			cellData[i][4] = cell->pixelSize[0] ? (a3f32)cell->localOffset[0] / (a3f32)cell->pixelSize[0] : 0.0f;
+			cellData[i][5] = cell->pixelSize[1] ? (a3f32)cell->localOffset[1] / (a3f32)cell->pixelSize[1] : 0.0f;
+		}
+		a3bufferCreate(batch_out->cellBuffer, "ubo:sprite-cell", a3buffer_uniform, sizeof(cellData), cellData);
+
+		// instance storage is refilled every frame
+		a3bufferCreate(batch_out->instanceBuffer, "ssbo:sprite-inst", a3buffer_storage, sizeof(a3_DemoSpriteInstance) * capacity, 0);
+		batch_out->clip = clips;
+		batch_out->clipCount = clipCount;
+		batch_out->count = 0;
+		batch_out->capacity = capacity;
+		return capacity;
+	}
+	return -1;
+}
+
+a3i32 a3demo_releaseSpriteBatch(a3_DemoSpriteBatch* batch)
+{
+	if (batch && batch->instance)
+	{
+		a3bufferRelease(batch->instanceBuffer);
+		a3bufferRelease(batch->cellBuffer);
+		a3demo_release(batch->instance);
+		batch->instance = 0;
+		batch->clipTime = 0;
+		batch->clipIndex = 0;
+		batch->clip = 0;
+		batch->clipCount = batch->count = batch->capacity = 0;
+		return 1;
+	}
+	return -1;
+}
+
+a3i32 a3demo_addSprite(a3_DemoSpriteBatch* batch, a3real3p const position, const a3real rotation, const a3real width, const a3real height, const a3ui32 tint, const a3ui32 clipIndex, const a3real startTime)
+{
+	a3_DemoSpriteInstance* sprite;
+	if (batch && batch->instance && position && batch->count < batch->capacity && clipIndex < batch->clipCount &&
+		a3demo_spriteClipValid_internal(batch->clip + clipIndex, a3demoSprite_cellMax))
+	{
+		sprite = batch->instance + batch->count;
+		sprite->position[0] = (a3f32)position[0];
+		sprite->position[1] = (a3f32)position[1];
+		sprite->position[2] = (a3f32)position[2];
+		sprite->rotation = (a3f32)rotation;
+		sprite->size[0] = (a3f32)width;
+		sprite->size[1] = (a3f32)height;
+		sprite->cell = batch->clip[clipIndex].firstCell;
+		sprite->tint = tint;
+		batch->clipTime[batch->count] = (a3f32)startTime;
+		batch->clipIndex[batch->count] = (a3ui16)clipIndex;
+		return batch->count++;
+	}
+	return -1;
+}
+
+a3i32 a3demo_updateSpriteBatch(a3_DemoSpriteBatch* batch, const a3real dt)
+{
+	const a3_DemoSpriteClip* clip;
+	a3f32 t, duration;
+	a3ui32 i;
+	if (batch && batch->instance)
+	{
+		// one pass over playheads; time is kept within one cycle so that
+		//	precision does not degrade over long runs
+		for (i = 0; i < batch->count; ++i)
+		{
+			clip = batch->clip + batch->clipIndex[i];
+			t = batch->clipTime[i] + (a3f32)dt;
+			if (clip->cellDuration > 0.0f)
+			{
+				duration = clip->cellDuration * (a3f32)(clip->mode == a3demoSpriteClip_pingPong && clip->cellCount > 1 ? (clip->cellCount - 1) * 2 : clip->cellCount);
+				if (t >= duration && clip->mode != a3demoSpriteClip_stop)
+					t = fmodf(t, duration);
+				batch->instance[i].cell = a3demo_spriteClipCell_internal(clip, (a3ui32)(t / clip->cellDuration));
+			}
+			else
+				batch->instance[i].cell = clip->firstCell;
+			batch->clipTime[i] = t;
+		}
+		return batch->count;
+	}
+	return -1;
+}
+
+a3i32 a3demo_uploadSpriteBatch(a3_DemoSpriteBatch* batch)
+{
+	if (batch && batch->instance)
+	{
+		if (batch->count)
+			a3bufferRefill(batch->instanceBuffer, 0, sizeof(a3_DemoSpriteInstance) * batch->count, batch->instance);
+		return batch->count;
+	}
+	return -1;
+}
+
+a3i32 a3demo_renderSpriteBatch(a3_DemoSpriteBatch const* batch, a3_VertexDrawable const* quad)
+{
+	if (batch && batch->instance && quad)
+	{
+		if (batch->count)
+		{
+			a3shaderUniformBufferActivate(batch->cellBuffer, a3demoSprite_cellBinding);
+			a3shaderStorageBufferActivate(batch->instanceBuffer, a3demoSprite_instanceBinding);
+			a3vertexDrawableActivateAndRenderInstanced(quad, batch->count);
+		}
+		return batch->count;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,455 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoTangentBasis.c
+	Tangent basis generation implementation.
+
+	Generation runs in three steps:
+		1. weld: every vertex is matched by hash to the first vertex with
+			the same position, normal and texcoord, then the faces around
+			each welded vertex are listed in face order
+		2. faces: face ranges run on worker threads; each face's tangent
+			and bitangent directions are scaled by its area and signed by
+			its texture winding, four faces per SIMD step, and stored in
+			blocks of four so the stores need no shuffling
+		3. vertices: vertex ranges run on worker threads; each vertex sums
+			the directions of its welded vertex's faces in listed order,
+			so every sum is the same no matter which thread makes it
+	With one range the face lists are skipped: faces are found a chunk at
+		a time and added straight into their welded vertices, in the same
+		order the lists would give, so the result does not change.
+*/
+
+#include "../a3_DemoTangentBasis.h"
+#include "../a3_DemoMemory.h"
+#include "../a3_DemoPlatform.h"
+
+#include "animal3D/a3/a3macros.h"
+#include "animal3D/a3utility/a3_Thread.h"
+#include "animal3D-A3DM/a3math/a3simd.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+
+// data shared by all ranges
+typedef struct a3_DemoTangentShared
+{
+	a3f32* tangent;
+	a3f32* bitangent;
+	a3f32 const* position;
+	a3f32 const* normal;
+	a3f32 const* texcoord;
+	a3ui32 const* index;
+	a3ui32 const* weld;						// first vertex with same key
+	a3ui32 const* faceFirst;				// faces of welded vertex, per vertex + 1
+	a3ui32 const* faceList;
+	a3f32* faceBasis;						// blocks of 4 faces: tx, ty, tz, bx, by, bz
+	a3f32 const* weldSum;					// sums per welded vertex if already made
+} a3_DemoTangentShared;
+
+// one range of faces or vertices
+typedef struct a3_DemoTangentRange
+{
+	a3_DemoTangentShared const* shared;
+	a3ui32 begin, end;
+	a3f32* faceBasis;						// block holding first face of range
+	a3ui32 degenerateCount;
+	a3boolean launched;						// ran on its own thread
+	a3_Thread thread[1];
+} a3_DemoTangentRange;
+
+
+//-----------------------------------------------------------------------------
+// utilities
+
+static void a3demo_internalTangentCross(a3f32* v_out, a3f32 const* a, a3f32 const* b)
+{
+	v_out[0] = a[1] * b[2] - a[2] * b[1];
+	v_out[1] = a[2] * b[0] - a[0] * b[2];
+	v_out[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+static a3f32 a3demo_internalTangentNormalize(a3f32* v)
+{
+	a3f32 const lenSq = v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+	a3f32 lenInv;
+	if (lenSq > 0.0f)
+	{
+		lenInv = 1.0f / sqrtf(lenSq);
+		v[0] *= lenInv;
+		v[1] *= lenInv;
+		v[2] *= lenInv;
+	}
+	return lenSq;
+}
+
+// hash of position, normal and texcoord bits
+static a3ui32 a3demo_internalTangentHash(a3_DemoTangentShared const* shared, a3ui32 const v)
+{
+	a3ui32 const* const p = (a3ui32 const*)(shared->position + v * 3);
+	a3ui32 const* const n = (a3ui32 const*)(shared->normal + v * 3);
+	a3ui32 const* const t = (a3ui32 const*)(shared->texcoord + v * 2);
+	a3ui32 h = (p[0] * 0x9e3779b1u) ^ (p[1] * 0x85ebca77u) ^ (p[2] * 0xc2b2ae3du);
+	h ^= (n[0] * 0x27d4eb2fu) ^ (n[1] * 0x165667b1u) ^ (n[2] * 0xd3a2646cu);
+	h ^= (t[0] * 0xfd7046c5u) ^ (t[1] * 0xb55a4f09u);
+	return h ^ (h >> 15);
+}
+
+// vertices have same welding key
+static a3boolean a3demo_internalTangentEqual(a3_DemoTangentShared const* shared, a3ui32 const a, a3ui32 const b)
+{
+	return !memcmp(shared->position + a * 3, shared->position + b * 3, 3 * sizeof(a3f32)) &&
+		!memcmp(shared->normal + a * 3, shared->normal + b * 3, 3 * sizeof(a3f32)) &&
+		!memcmp(shared->texcoord + a * 2, shared->texcoord + b * 2, 2 * sizeof(a3f32));
+}
+
+
+//-----------------------------------------------------------------------------
+// ranges
+
+// face directions: area-weighted, signed by texture winding so mirrored
+//	halves of a model still add up instead of cancelling
+static a3ret a3demo_tangentFaceRange(a3_DemoTangentRange* range)
+{
+	a3ui32 const* const index = range->shared->index;
+	a3f32 const* const position = range->shared->position, * const texcoord = range->shared->texcoord;
+	a3f32* out;
+	a3f32 const* p0, * p1, * p2, * uv0, * uv1, * uv2;
+	a3f32 e1[3], e2[3], du1, dv1, du2, dv2, s;
+	a3ui32 f = range->begin, k;
+
+#if (A3_SIMD >= A3_SIMD_SSE2)
+	__m128 const signBit = _mm_set1_ps(-0.0f), one = _mm_set1_ps(1.0f);
+	__m128 v[3][3], t[3][2], a1[3], a2[3], d1[2], d2[2], sign;
+	a3ui32 c, l;
+	a3ui32 const* tri;
+
+	// ranges start on block boundaries, so blocks are whole until the last
+	for (; f + 4 <= range->end; f += 4)
+	{
+		tri = index + f * 3;
+		for (c = 0; c < 3; ++c)
+		{
+			for (k = 0; k < 3; ++k)
+				v[c][k] = _mm_setr_ps(position[tri[c] * 3 + k], position[tri[c + 3] * 3 + k],
+					position[tri[c + 6] * 3 + k], position[tri[c + 9] * 3 + k]);
+			for (l = 0; l < 2; ++l)
+				t[c][l] = _mm_setr_ps(texcoord[tri[c] * 2 + l], texcoord[tri[c + 3] * 2 + l],
+					texcoord[tri[c + 6] * 2 + l], texcoord[tri[c + 9] * 2 + l]);
+		}
+		for (k = 0; k < 3; ++k)
+		{
+			a1[k] = _mm_sub_ps(v[1][k], v[0][k]);
+			a2[k] = _mm_sub_ps(v[2][k], v[0][k]);
+		}
+		for (l = 0; l < 2; ++l)
+		{
+			d1[l] = _mm_sub_ps(t[1][l], t[0][l]);
+			d2[l] = _mm_sub_ps(t[2][l], t[0][l]);
+		}
+		sign = _mm_sub_ps(_mm_mul_ps(d1[0], d2[1]), _mm_mul_ps(d2[0], d1[1]));
+		sign = _mm_or_ps(one, _mm_and_ps(_mm_cmplt_ps(sign, _mm_setzero_ps()), signBit));
+		out = range->faceBasis + (f - range->begin) * 6;
+		for (k = 0; k < 3; ++k)
+		{
+			_mm_storeu_ps(out + k * 4, _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(a1[k], d2[1]), _mm_mul_ps(a2[k], d1[1])), sign));
+			_mm_storeu_ps(out + k * 4 + 12, _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(a2[k], d1[0]), _mm_mul_ps(a1[k], d2[0])), sign));
+		}
+	}
+#endif	// A3_SIMD
+
+	// remainder, or all faces without SIMD
+	for (; f < range->end; ++f)
+	{
+		p0 = position + index[f * 3 + 0] * 3, uv0 = texcoord + index[f * 3 + 0] * 2;
+		p1 = position + index[f * 3 + 1] * 3, uv1 = texcoord + index[f * 3 + 1] * 2;
+		p2 = position + index[f * 3 + 2] * 3, uv2 = texcoord + index[f * 3 + 2] * 2;
+		e1[0] = p1[0] - p0[0], e1[1] = p1[1] - p0[1], e1[2] = p1[2] - p0[2];
+		e2[0] = p2[0] - p0[0], e2[1] = p2[1] - p0[1], e2[2] = p2[2] - p0[2];
+		du1 = uv1[0] - uv0[0], dv1 = uv1[1] - uv0[1];
+		du2 = uv2[0] - uv0[0], dv2 = uv2[1] - uv0[1];
+		s = (du1 * dv2 - du2 * dv1) < 0.0f ? -1.0f : 1.0f;
+		out = range->faceBasis + ((f - range->begin) & ~3u) * 6 + (f & 3u);
+		for (k = 0; k < 3; ++k)
+		{
+			out[k * 4] = (e1[k] * dv2 - e2[k] * dv1) * s;
+			out[k * 4 + 12] = (e2[k] * du1 - e1[k] * du2) * s;
+		}
+	}
+	return 0;
+}
+
+// vertex basis: sum directions of welded vertex's faces, then remove
+//	normal part and keep handedness in bitangent
+static a3ret a3demo_tangentVertexRange(a3_DemoTangentRange* range)
+{
+	a3_DemoTangentShared const* const shared = range->shared;
+	a3f32 const residualSq = 1.0e-10f;		// normal part left after one pass, squared
+	a3f32 acc[6], e1[3], e2[3], d, lenSq;
+	a3f32 const* nv, * src;
+	a3f32* tv, * bv;
+	a3ui32 v, w, i, f, k;
+
+	for (v = range->begin; v < range->end; ++v)
+	{
+		w = shared->weld[v];
+		if (shared->weldSum)
+			memcpy(acc, shared->weldSum + w * 6, sizeof(acc));
+		else
+		{
+			memset(acc, 0, sizeof(acc));
+			for (i = shared->faceFirst[w]; i < shared->faceFirst[w + 1]; ++i)
+			{
+				f = shared->faceList[i];
+				src = shared->faceBasis + (f & ~3u) * 6 + (f & 3u);
+				for (k = 0; k < 6; ++k)
+					acc[k] += src[k * 4];
+			}
+		}
+
+		nv = shared->normal + v * 3;
+		tv = shared->tangent + v * 3;
+		bv = shared->bitangent + v * 3;
+		d = nv[0] * acc[0] + nv[1] * acc[1] + nv[2] * acc[2];
+		tv[0] = acc[0] - nv[0] * d;
+		tv[1] = acc[1] - nv[1] * d;
+		tv[2] = acc[2] - nv[2] * d;
+
+		// where faces nearly cancel (mirrored texture seams) what is left
+		//	is mostly rounding error; only there is the normal part removed 
+		//	once more, so every other vertex keeps the single pass result
+		lenSq = a3demo_internalTangentNormalize(tv);
+		if (lenSq > 0.0f)
+		{
+			d = nv[0] * tv[0] + nv[1] * tv[1] + nv[2] * tv[2];
+			if (d * d > residualSq)
+			{
+				tv[0] -= nv[0] * d;
+				tv[1] -= nv[1] * d;
+				tv[2] -= nv[2] * d;
+				lenSq = a3demo_internalTangentNormalize(tv);
+			}
+		}
+		if (lenSq <= 0.0f)
+		{
+			// degenerate mapping: any direction perpendicular to normal
+			e1[0] = e1[1] = e1[2] = 0.0f;
+			e1[(nv[0] * nv[0] < 0.5f) ? 0 : 1] = 1.0f;
+			a3demo_internalTangentCross(e2, nv, e1);
+			a3demo_internalTangentCross(tv, e2, nv);
+			a3demo_internalTangentNormalize(tv);
+			++range->degenerateCount;
+		}
+		a3demo_internalTangentCross(bv, nv, tv);
+		if (bv[0] * acc[3] + bv[1] * acc[4] + bv[2] * acc[5] < 0.0f)
+			bv[0] = -bv[0], bv[1] = -bv[1], bv[2] = -bv[2];
+	}
+	return 0;
+}
+
+// split count into ranges (multiples of 4 so face blocks are not shared)
+//	and run function on every range; first range runs on calling thread
+static void a3demo_internalTangentRun(a3_DemoTangentRange* range, a3ui32 const rangeCount, a3ui32 const count, a3ret(*func)(a3_DemoTangentRange*))
+{
+	a3ui32 i;
+	for (i = 0; i < rangeCount; ++i)
+	{
+		range[i].begin = i ? range[i - 1].end : 0;
+		range[i].end = i + 1 < rangeCount ? (a3ui32)((a3ui64)count * (i + 1) / rangeCount) & ~3u : count;
+		range[i].end = range[i].end > range[i].begin ? range[i].end : range[i].begin;
+		range[i].faceBasis = range->shared->faceBasis ? range->shared->faceBasis + range[i].begin * 6 : 0;
+	}
+	for (i = 1; i < rangeCount; ++i)
+	{
+		memset(range[i].thread, 0, sizeof(a3_Thread));
+		range[i].launched = a3threadLaunch(range[i].thread, (a3_threadfunc)func, range + i, "a3demo_calculateTangentBasis") > 0;
+	}
+	func(range);
+
+	// ranges whose thread did not start run here
+	for (i = 1; i < rangeCount; ++i)
+		if (range[i].launched)
+			a3threadWait(range[i].thread);
+		else
+			func(range + i);
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_calculateTangentBasis(a3f32* tangent_out, a3f32* bitangent_out,
+	a3f32 const* position, a3f32 const* normal, a3f32 const* texcoord, a3ui32 const vertexCount,
+	a3ui32 const* index, a3ui32 const triangleCount, a3ui32 const threadCount, a3_DemoTangentBasisStats* stats_out_opt)
+{
+	a3_DemoTangentShared shared[1] = { 0 };
+	a3_DemoTangentRange range[a3demoTangentBasis_threadMax] = { 0 };
+	a3_DemoTangentBasisStats stats = { 0 };
+	a3ui32* weld = 0, * table = 0, * faceFirst = 0, * faceList = 0;
+	a3f32* faceBasis = 0, * weldSum = 0;
+	a3f32 chunk[a3demoTangentBasis_chunkSize * 6];
+	a3f32 const* src;
+	a3ui32 tableMask, slot, rangeCount, v, f, i, k;
+	a3f64 timeStart, timeWeld, timeFace;
+	a3ret result = 0;
+
+	if (!tangent_out || !bitangent_out || !position || !normal || !texcoord || !index)
+		return -1;
+	timeStart = a3demo_getTime();
+	for (i = 0; i < triangleCount * 3; ++i)
+		if (index[i] >= vertexCount)
+			return -1;
+
+	for (tableMask = 1; tableMask < vertexCount * 2; tableMask <<= 1);
+	weld = (a3ui32*)a3demo_alloc((size_t)vertexCount * sizeof(a3ui32) + 1);
+	table = (a3ui32*)a3demo_allocZero((size_t)tableMask-- * sizeof(a3ui32));
+	if (!weld || !table)
+		goto done;
+	shared->tangent = tangent_out;
+	shared->bitangent = bitangent_out;
+	shared->position = position;
+	shared->normal = normal;
+	shared->texcoord = texcoord;
+	shared->index = index;
+	shared->weld = weld;
+
+	rangeCount = threadCount ? threadCount : a3demo_getHardwareThreadCount();
+	rangeCount = rangeCount < a3demoTangentBasis_threadMax ? rangeCount : a3demoTangentBasis_threadMax;
+	k = (triangleCount > vertexCount ? triangleCount : vertexCount) / a3demoTangentBasis_rangeMin;
+	rangeCount = rangeCount < k ? rangeCount : k;
+	rangeCount = rangeCount ? rangeCount : 1;
+
+	// step 1: weld in vertex order, then faces of each welded vertex
+	for (v = 0; v < vertexCount; ++v)
+	{
+		for (slot = a3demo_internalTangentHash(shared, v) & tableMask; table[slot]; slot = (slot + 1) & tableMask)
+			if (a3demo_internalTangentEqual(shared, v, table[slot] - 1))
+				break;
+		if (!table[slot])
+		{
+			table[slot] = v + 1;
+			++stats.weldedCount;
+		}
+		weld[v] = table[slot] - 1;
+	}
+	if (rangeCount > 1)
+	{
+		// face lists let vertex ranges sum without sharing accumulators
+		faceFirst = (a3ui32*)a3demo_allocZero(((size_t)vertexCount + 1) * sizeof(a3ui32));
+		faceList = (a3ui32*)a3demo_alloc((size_t)triangleCount * 3 * sizeof(a3ui32) + 1);
+		faceBasis = (a3f32*)a3demo_alloc(((size_t)triangleCount + 3) / 4 * 24 * sizeof(a3f32) + 1);
+		if (!faceFirst || !faceList || !faceBasis)
+			goto done;
+		for (i = 0; i < triangleCount * 3; ++i)
+			++faceFirst[weld[index[i]] + 1];
+		for (v = 0; v < vertexCount; ++v)
+			faceFirst[v + 1] += faceFirst[v];
+		for (i = 0; i < triangleCount * 3; ++i)
+			faceList[faceFirst[weld[index[i]]]++] = i / 3;
+		for (v = vertexCount; v > 0; --v)
+			faceFirst[v] = faceFirst[v - 1];
+		faceFirst[0] = 0;
+		shared->faceFirst = faceFirst;
+		shared->faceList = faceList;
+		shared->faceBasis = faceBasis;
+	}
+	else
+	{
+		// one range adds straight into welded vertices in the same order,
+		//	so sums match the listed ones without keeping every face
+		weldSum = (a3f32*)a3demo_allocZero(((size_t)vertexCount * 6 + 1) * sizeof(a3f32));
+		if (!weldSum)
+			goto done;
+	}
+	timeWeld = a3demo_getTime();
+
+	// step 2: faces
+	for (i = 0; i < rangeCount; ++i)
+		range[i].shared = shared;
+	if (weldSum)
+	{
+		// chunks stay in cache between finding and adding
+		range->faceBasis = chunk;
+		for (range->begin = 0; range->begin < triangleCount; range->begin = range->end)
+		{
+			range->end = range->begin + a3demoTangentBasis_chunkSize;
+			range->end = range->end < triangleCount ? range->end : triangleCount;
+			a3demo_tangentFaceRange(range);
+			for (f = range->begin; f < range->end; ++f)
+			{
+				src = chunk + ((f - range->begin) & ~3u) * 6 + (f & 3u);
+				for (i = 0; i < 3; ++i)
+				{
+					v = weld[index[f * 3 + i]] * 6;
+					for (k = 0; k < 6; ++k)
+						weldSum[v + k] += src[k * 4];
+				}
+			}
+		}
+		shared->weldSum = weldSum;
+	}
+	else
+		a3demo_internalTangentRun(range, rangeCount, triangleCount, a3demo_tangentFaceRange);
+	timeFace = a3demo_getTime();
+
+	// step 3: vertices
+	a3demo_internalTangentRun(range, rangeCount, vertexCount, a3demo_tangentVertexRange);
+	for (i = 0; i < rangeCount; ++i)
+		stats.degenerateCount += range[i].degenerateCount;
+
+	stats.vertexCount = vertexCount;
+	stats.triangleCount = triangleCount;
+	stats.threadCount = rangeCount;
+	stats.weldTime = timeWeld - timeStart;
+	stats.faceTime = timeFace - timeWeld;
+	stats.vertexTime = a3demo_getTime() - timeFace;
+	result = 1;
+
+done:
+	a3demo_release(weld);
+	a3demo_release(table);
+	a3demo_release(faceFirst);
+	a3demo_release(faceList);
+	a3demo_release(faceBasis);
+	a3demo_release(weldSum);
+	if (stats_out_opt)
+	{
+		stats.totalTime = a3demo_getTime() - timeStart;
+		*stats_out_opt = stats;
+	}
+	return result;
+}
+
+
+void a3demo_printTangentBasisStats(a3_DemoTangentBasisStats const* stats, a3byte const* name)
+{
+	if (stats)
+		printf("\n A3 tangent basis '%s': %u vertices (%u welded), %u triangles in %.2f ms (%u threads; weld %.2f ms, faces %.2f ms, vertices %.2f ms); %u degenerate \n",
+			name ? name : (a3byte const*)"", stats->vertexCount, stats->weldedCount, stats->triangleCount,
+			stats->totalTime * 1000.0, stats->threadCount, stats->weldTime * 1000.0, stats->faceTime * 1000.0, stats->vertexTime * 1000.0,
+			stats->degenerateCount);
+}
+
+
+//-----------------------------------------------------------------------------
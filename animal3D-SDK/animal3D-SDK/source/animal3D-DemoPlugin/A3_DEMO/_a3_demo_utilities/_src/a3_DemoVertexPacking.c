@@ -0,0 +1,506 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoVertexPacking.c
+	Vertex packing implementation.
+
+	Every encoder has an SSE2 path and a scalar path for the remainder;
+		both perform the same float operations in the same order, so the
+		output does not depend on which path produced it.
+*/
+
+#include "../a3_DemoVertexPacking.h"
+#include "../a3_DemoMemory.h"
+
+#include "animal3D/a3/a3macros.h"
+#include "animal3D-A3DM/a3math/a3simd.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+
+// largest signed normalized values
+#define a3demo_snorm16Max	32767.0f
+#define a3demo_snorm10Max	511.0f
+#define a3demo_unorm8Max	255.0f
+
+// float bit access
+typedef union a3_DemoFloatBits
+{
+	a3f32 f;
+	a3ui32 u;
+} a3_DemoFloatBits;
+
+
+//-----------------------------------------------------------------------------
+
+// float to half, round to nearest even; overflow becomes infinity
+static a3ui16 a3demo_internalHalf(a3f32 const f)
+{
+	a3_DemoFloatBits v, magic;
+	a3ui32 sign, h;
+	v.f = f;
+	sign = v.u & 0x80000000u;
+	v.u ^= sign;
+	if (v.u >= 0x47800000u)
+		h = v.u > 0x7f800000u ? 0x7e00u : 0x7c00u;
+	else if (v.u < 0x38800000u)
+	{
+		// subnormal: let float addition round into place
+		magic.u = 0x3f000000u;
+		v.f += magic.f;
+		h = v.u - magic.u;
+	}
+	else
+		h = (v.u + 0xc8000fffu + ((v.u >> 13) & 1u)) >> 13;
+	return (a3ui16)(h | (sign >> 16));
+}
+
+// clamp, scale and round half away from zero
+static a3i32 a3demo_internalQuantize(a3f32 v, a3f32 const lo, a3f32 const hi, a3f32 const scale)
+{
+	v = v > lo ? v : lo;
+	v = (v < hi ? v : hi) * scale;
+	return (a3i32)(v + (v < 0.0f ? -0.5f : 0.5f));
+}
+
+// fold unit vector onto octahedron and unfold lower half into corners
+static void a3demo_internalOctahedral(a3f32* e_out, a3f32 const x, a3f32 const y, a3f32 const z)
+{
+	a3f32 const s = (fabsf(x) + fabsf(y)) + fabsf(z);
+	a3f32 const ox = s > 0.0f ? x / s : 0.0f;
+	a3f32 const oy = s > 0.0f ? y / s : 0.0f;
+	if (z < 0.0f)
+	{
+		e_out[0] = (1.0f - fabsf(oy)) * (ox >= 0.0f ? 1.0f : -1.0f);
+		e_out[1] = (1.0f - fabsf(ox)) * (oy >= 0.0f ? 1.0f : -1.0f);
+	}
+	else
+	{
+		e_out[0] = ox;
+		e_out[1] = oy;
+	}
+}
+
+
+#if (A3_SIMD >= A3_SIMD_SSE2)
+
+// four floats to half, same steps as scalar
+static __m128i a3demo_internalHalf4(__m128 const f)
+{
+	__m128i const u = _mm_castps_si128(f);
+	__m128i const sign = _mm_and_si128(u, _mm_set1_epi32((a3i32)0x80000000u));
+	__m128i const a = _mm_xor_si128(u, sign);
+	__m128i const magic = _mm_set1_epi32(0x3f000000);
+	__m128i const isBig = _mm_cmpgt_epi32(a, _mm_set1_epi32(0x477fffff));
+	__m128i const isSmall = _mm_cmplt_epi32(a, _mm_set1_epi32(0x38800000));
+	__m128i const infNaN = _mm_or_si128(_mm_set1_epi32(0x7c00),
+		_mm_and_si128(_mm_cmpgt_epi32(a, _mm_set1_epi32(0x7f800000)), _mm_set1_epi32(0x0200)));
+	__m128i const subnormal = _mm_sub_epi32(_mm_castps_si128(
+		_mm_add_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(magic))), magic);
+	__m128i const normal = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(a, _mm_set1_epi32((a3i32)0xc8000fffu)),
+		_mm_and_si128(_mm_srli_epi32(a, 13), _mm_set1_epi32(1))), 13);
+	__m128i h = _mm_or_si128(_mm_and_si128(isSmall, subnormal), _mm_andnot_si128(isSmall, normal));
+	h = _mm_or_si128(_mm_and_si128(isBig, infNaN), _mm_andnot_si128(isBig, h));
+	h = _mm_or_si128(h, _mm_srli_epi32(sign, 16));
+
+	// sign-extend low halves so signed saturating pack keeps them intact
+	return _mm_srai_epi32(_mm_slli_epi32(h, 16), 16);
+}
+
+// four values: clamp, scale and round half away from zero
+static __m128i a3demo_internalQuantize4(__m128 v, __m128 const lo, __m128 const hi, __m128 const scale)
+{
+	__m128 const sign = _mm_castsi128_ps(_mm_set1_epi32((a3i32)0x80000000u));
+	v = _mm_mul_ps(_mm_min_ps(_mm_max_ps(v, lo), hi), scale);
+	return _mm_cvttps_epi32(_mm_add_ps(v, _mm_or_ps(_mm_and_ps(v, sign), _mm_set1_ps(0.5f))));
+}
+
+// gather one component of four strided vectors
+static __m128 a3demo_internalGather4(a3f32 const* in, a3ui32 const stride)
+{
+	return _mm_setr_ps(in[0], in[stride], in[stride * 2], in[stride * 3]);
+}
+
+#endif	// A3_SIMD
+
+
+//-----------------------------------------------------------------------------
+
+void a3demo_encodeHalf(a3ui16* out, a3f32 const* in, a3ui32 const count)
+{
+	a3ui32 i = 0;
+#if (A3_SIMD >= A3_SIMD_SSE2)
+	for (; i + 8 <= count; i += 8)
+		_mm_storeu_si128((__m128i*)(out + i), _mm_packs_epi32(
+			a3demo_internalHalf4(_mm_loadu_ps(in + i)),
+			a3demo_internalHalf4(_mm_loadu_ps(in + i + 4))));
+#endif	// A3_SIMD
+	for (; i < count; ++i)
+		out[i] = a3demo_internalHalf(in[i]);
+}
+
+void a3demo_encodeSnorm16(a3i16* out, a3f32 const* in, a3ui32 const count)
+{
+	a3ui32 i = 0;
+#if (A3_SIMD >= A3_SIMD_SSE2)
+	__m128 const lo = _mm_set1_ps(-1.0f), hi = _mm_set1_ps(+1.0f), scale = _mm_set1_ps(a3demo_snorm16Max);
+	for (; i + 8 <= count; i += 8)
+		_mm_storeu_si128((__m128i*)(out + i), _mm_packs_epi32(
+			a3demo_internalQuantize4(_mm_loadu_ps(in + i), lo, hi, scale),
+			a3demo_internalQuantize4(_mm_loadu_ps(in + i + 4), lo, hi, scale)));
+#endif	// A3_SIMD
+	for (; i < count; ++i)
+		out[i] = (a3i16)a3demo_internalQuantize(in[i], -1.0f, +1.0f, a3demo_snorm16Max);
+}
+
+void a3demo_encodeUnorm8(a3ubyte* out, a3f32 const* in, a3ui32 const count)
+{
+	a3ui32 i = 0;
+#if (A3_SIMD >= A3_SIMD_SSE2)
+	__m128 const lo = _mm_setzero_ps(), hi = _mm_set1_ps(1.0f), scale = _mm_set1_ps(a3demo_unorm8Max);
+	for (; i + 16 <= count; i += 16)
+		_mm_storeu_si128((__m128i*)(out + i), _mm_packus_epi16(
+			_mm_packs_epi32(
+				a3demo_internalQuantize4(_mm_loadu_ps(in + i), lo, hi, scale),
+				a3demo_internalQuantize4(_mm_loadu_ps(in + i + 4), lo, hi, scale)),
+			_mm_packs_epi32(
+				a3demo_internalQuantize4(_mm_loadu_ps(in + i + 8), lo, hi, scale),
+				a3demo_internalQuantize4(_mm_loadu_ps(in + i + 12), lo, hi, scale))));
+#endif	// A3_SIMD
+	for (; i < count; ++i)
+		out[i] = (a3ubyte)a3demo_internalQuantize(in[i], 0.0f, 1.0f, a3demo_unorm8Max);
+}
+
+void a3demo_encodeSnorm10x3(a3ui32* out, a3f32 const* in, a3ui32 const stride, a3i32 const w, a3ui32 const count)
+{
+	a3ui32 const wBits = ((a3ui32)w & 0x3u) << 30;
+	a3ui32 i = 0;
+#if (A3_SIMD >= A3_SIMD_SSE2)
+	__m128 const lo = _mm_set1_ps(-1.0f), hi = _mm_set1_ps(+1.0f), scale = _mm_set1_ps(a3demo_snorm10Max);
+	__m128i const mask = _mm_set1_epi32(0x3ff);
+	for (; i + 4 <= count; i += 4, in += stride * 4)
+	{
+		__m128i const x = _mm_and_si128(a3demo_internalQuantize4(a3demo_internalGather4(in + 0, stride), lo, hi, scale), mask);
+		__m128i const y = _mm_and_si128(a3demo_internalQuantize4(a3demo_internalGather4(in + 1, stride), lo, hi, scale), mask);
+		__m128i const z = _mm_and_si128(a3demo_internalQuantize4(a3demo_internalGather4(in + 2, stride), lo, hi, scale), mask);
+		_mm_storeu_si128((__m128i*)(out + i), _mm_or_si128(_mm_or_si128(x, _mm_slli_epi32(y, 10)),
+			_mm_or_si128(_mm_slli_epi32(z, 20), _mm_set1_epi32((a3i32)wBits))));
+	}
+#endif	// A3_SIMD
+	for (; i < count; ++i, in += stride)
+		out[i] = ((a3ui32)a3demo_internalQuantize(in[0], -1.0f, +1.0f, a3demo_snorm10Max) & 0x3ffu) |
+			(((a3ui32)a3demo_internalQuantize(in[1], -1.0f, +1.0f, a3demo_snorm10Max) & 0x3ffu) << 10) |
+			(((a3ui32)a3demo_internalQuantize(in[2], -1.0f, +1.0f, a3demo_snorm10Max) & 0x3ffu) << 20) | wBits;
+}
+
+void a3demo_encodeOctahedral(a3i16* out, a3f32 const* in, a3ui32 const stride, a3ui32 const count)
+{
+	a3f32 e[2];
+	a3ui32 i = 0;
+#if (A3_SIMD >= A3_SIMD_SSE2)
+	__m128 const lo = _mm_set1_ps(-1.0f), hi = _mm_set1_ps(+1.0f), scale = _mm_set1_ps(a3demo_snorm16Max);
+	__m128 const sign = _mm_castsi128_ps(_mm_set1_epi32((a3i32)0x80000000u));
+	__m128 const zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f);
+	for (; i + 4 <= count; i += 4, in += stride * 4)
+	{
+		__m128 const x = a3demo_internalGather4(in + 0, stride);
+		__m128 const y = a3demo_internalGather4(in + 1, stride);
+		__m128 const z = a3demo_internalGather4(in + 2, stride);
+		__m128 const s = _mm_add_ps(_mm_add_ps(_mm_andnot_ps(sign, x), _mm_andnot_ps(sign, y)), _mm_andnot_ps(sign, z));
+		__m128 const valid = _mm_cmpgt_ps(s, zero);
+		__m128 const ox = _mm_and_ps(_mm_div_ps(x, s), valid);
+		__m128 const oy = _mm_and_ps(_mm_div_ps(y, s), valid);
+		__m128 const wx = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(sign, oy)), _mm_or_ps(_mm_andnot_ps(_mm_cmpge_ps(ox, zero), sign), one));
+		__m128 const wy = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(sign, ox)), _mm_or_ps(_mm_andnot_ps(_mm_cmpge_ps(oy, zero), sign), one));
+		__m128 const lower = _mm_cmplt_ps(z, zero);
+		__m128i const ex = a3demo_internalQuantize4(_mm_or_ps(_mm_and_ps(lower, wx), _mm_andnot_ps(lower, ox)), lo, hi, scale);
+		__m128i const ey = a3demo_internalQuantize4(_mm_or_ps(_mm_and_ps(lower, wy), _mm_andnot_ps(lower, oy)), lo, hi, scale);
+		_mm_storeu_si128((__m128i*)(out + i * 2), _mm_packs_epi32(_mm_unpacklo_epi32(ex, ey), _mm_unpackhi_epi32(ex, ey)));
+	}
+#endif	// A3_SIMD
+	for (; i < count; ++i, in += stride)
+	{
+		a3demo_internalOctahedral(e, in[0], in[1], in[2]);
+		out[i * 2 + 0] = (a3i16)a3demo_internalQuantize(e[0], -1.0f, +1.0f, a3demo_snorm16Max);
+		out[i * 2 + 1] = (a3i16)a3demo_internalQuantize(e[1], -1.0f, +1.0f, a3demo_snorm16Max);
+	}
+}
+
+void a3demo_decodeOctahedral(a3f32* v_out, a3i16 const* in)
+{
+	a3f32 const ex = in[0] > -32767 ? (a3f32)in[0] / a3demo_snorm16Max : -1.0f;
+	a3f32 const ey = in[1] > -32767 ? (a3f32)in[1] / a3demo_snorm16Max : -1.0f;
+	a3f32 x = ex, y = ey, z = 1.0f - fabsf(ex) - fabsf(ey), len;
+	if (z < 0.0f)
+	{
+		x = (1.0f - fabsf(ey)) * (ex >= 0.0f ? 1.0f : -1.0f);
+		y = (1.0f - fabsf(ex)) * (ey >= 0.0f ? 1.0f : -1.0f);
+	}
+	len = sqrtf(x * x + y * y + z * z);
+	v_out[0] = x / len;
+	v_out[1] = y / len;
+	v_out[2] = z / len;
+}
+
+
+//-----------------------------------------------------------------------------
+
+// recover attribute type by matching format entry against probe formats
+static a3_VertexAttributeType a3demo_internalAttribType(a3_VertexFormatDescriptor const* format, a3_VertexAttributeName const name)
+{
+	a3_VertexAttributeDescriptor attrib[1];
+	a3_VertexFormatDescriptor probe[1];
+	a3ui32 type;
+	if (format->attribType[name])
+		for (type = a3attrib_int; type <= a3attrib_unorm8x4; ++type)
+		{
+			a3vertexAttribCreateDescriptor(attrib, name, (a3_VertexAttributeType)type);
+			a3vertexFormatCreateDescriptor(probe, attrib, 1);
+			if (probe->attribType[name] == format->attribType[name] && probe->attribSize[name] == format->attribSize[name])
+				return (a3_VertexAttributeType)type;
+		}
+	return a3attrib_disable;
+}
+
+// packed type for float attribute, or same type if not packed
+static a3_VertexAttributeType a3demo_internalPackedType(a3_VertexAttributeName const name, a3_VertexAttributeType const type, a3_DemoVertexPackFlag const flags)
+{
+	if (type >= a3attrib_float && type <= a3attrib_vec4)
+		switch (name)
+		{
+		case a3attrib_position:
+			if ((flags & a3demoVertexPack_position) && type >= a3attrib_vec3)
+				return a3attrib_half4;
+			break;
+		case a3attrib_normal:
+		case a3attrib_tangent:
+		case a3attrib_bitangent:
+			if (type >= a3attrib_vec3)
+			{
+				if (flags & a3demoVertexPack_octahedral)
+					return a3attrib_snorm16x2;
+				if (flags & a3demoVertexPack_normal16)
+					return a3attrib_snorm16x4;
+				if (flags & a3demoVertexPack_normal)
+					return a3attrib_snorm10x3;
+			}
+			break;
+		case a3attrib_texcoord:
+			if (flags & a3demoVertexPack_texcoord)
+				return type == a3attrib_vec2 ? a3attrib_half2 : type > a3attrib_vec2 ? a3attrib_half4 : type;
+			break;
+		case a3attrib_color:
+			if ((flags & a3demoVertexPack_color) && type >= a3attrib_vec3)
+				return a3attrib_unorm8x4;
+			break;
+		case a3attrib_blendWeights:
+			if ((flags & a3demoVertexPack_blendWeights) && type == a3attrib_vec4)
+				return a3attrib_unorm8x4;
+			break;
+		default:
+			break;
+		}
+	return type;
+}
+
+// copy float vectors into four-component buffer, missing components
+//	taken from (0, 0, 0, 1) as the vertex fetch would
+static a3f32 const* a3demo_internalWiden(a3f32* widen, a3f32 const* in, a3ui32 const elements, a3ui32 const count)
+{
+	a3f32 const fill[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+	a3ui32 i, j;
+	for (i = 0; i < count; ++i)
+		for (j = 0; j < 4; ++j)
+			widen[i * 4 + j] = j < elements ? in[i * elements + j] : fill[j];
+	return widen;
+}
+
+// keep each quantized weight set summing to exactly one by giving the
+//	rounding error to the largest weight
+static void a3demo_internalFixWeights(a3ubyte* weight, a3f32 const* in, a3ui32 const count)
+{
+	a3ui32 i, j, top;
+	a3i32 sum;
+	for (i = 0; i < count; ++i, weight += 4, in += 4)
+		if (fabsf(in[0] + in[1] + in[2] + in[3] - 1.0f) < 0.001f)
+		{
+			for (j = top = 0, sum = 0; j < 4; ++j)
+			{
+				sum += weight[j];
+				top = weight[j] > weight[top] ? j : top;
+			}
+			sum = (a3i32)weight[top] + 255 - sum;
+			weight[top] = (a3ubyte)(sum < 0 ? 0 : sum > 255 ? 255 : sum);
+		}
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_packGeometry(a3_GeometryData* geom, a3_DemoVertexPackFlag const flags, a3_DemoVertexPackStats* stats_out_opt)
+{
+	// geometry streams: one or two vertex attributes stored back to back
+	struct {
+		a3_GeometryVertexAttributeName geomName;
+		a3_VertexAttributeName name, nameSecond;
+	} const stream[] = {
+		{ a3attrib_geomPosition, a3attrib_position, a3attrib_position },
+		{ a3attrib_geomNormal, a3attrib_normal, a3attrib_normal },
+		{ a3attrib_geomColor, a3attrib_color, a3attrib_color },
+		{ a3attrib_geomTexcoord, a3attrib_texcoord, a3attrib_texcoord },
+		{ a3attrib_geomTangent, a3attrib_tangent, a3attrib_bitangent },
+		{ a3attrib_geomBlending, a3attrib_blendWeights, a3attrib_blendIndices },
+	};
+
+	a3_DemoVertexPackStats stats = { 0 };
+	a3_VertexAttributeDescriptor attrib[a3attrib_nameMax];
+	a3_VertexAttributeType typeBefore[a3attrib_nameMax], typeAfter[a3attrib_nameMax];
+	a3_VertexFormatDescriptor format[1];
+	a3ubyte const* src[a3attrib_nameMax] = { 0 };
+	void const* attribData[a3attrib_geomNameMax] = { 0 };
+	a3ubyte* data = 0, * dst;
+	a3f32* widen = 0;
+	a3f32 const* in;
+	a3ui32 i, j, k, n, attribCount, vertexBytes, indexBytes;
+	a3_VertexAttributeName name;
+	a3ret result = 0;
+
+	if (!geom)
+		return -1;
+	n = geom->numVertices;
+	if (!geom->data || !n)
+		goto done;
+
+	// locate every attribute and choose its packed type
+	for (k = 0; k < sizeof(stream) / sizeof(*stream); ++k)
+		if (geom->attribData[stream[k].geomName])
+		{
+			src[stream[k].name] = (a3ubyte const*)geom->attribData[stream[k].geomName];
+			if (stream[k].nameSecond != stream[k].name)
+				src[stream[k].nameSecond] = src[stream[k].name] + (size_t)n * geom->vertexFormat->attribSize[stream[k].name];
+		}
+	for (i = attribCount = 0; i < a3attrib_nameMax; ++i)
+	{
+		typeBefore[i] = a3demo_internalAttribType(geom->vertexFormat, (a3_VertexAttributeName)i);
+		typeAfter[i] = a3demo_internalPackedType((a3_VertexAttributeName)i, typeBefore[i], flags);
+		if (typeBefore[i])
+		{
+			if (!src[i])
+				goto done;
+			a3vertexAttribCreateDescriptor(attrib + attribCount++, (a3_VertexAttributeName)i, typeAfter[i]);
+			stats.attribCount += typeAfter[i] != typeBefore[i];
+		}
+	}
+	if (!stats.attribCount || a3vertexFormatCreateDescriptor(format, attrib, attribCount) <= 0)
+		goto done;
+
+	// one block holds all streams followed by indices (plain malloc, 
+	//	released with free by a3geometryReleaseData)
+	vertexBytes = (a3ui32)a3vertexFormatGetStorageSpaceRequired(format, n);
+	indexBytes = geom->indexData ? geom->indexFormat->indexSize * geom->numIndices : 0;
+	if (!(data = (a3ubyte*)malloc((size_t)vertexBytes + a3pad4(indexBytes))) ||
+		!(widen = (a3f32*)a3demo_alloc((size_t)n * 4 * sizeof(a3f32))))
+		goto done;
+
+	// convert streams in order
+	for (k = 0, dst = data; k < sizeof(stream) / sizeof(*stream); ++k)
+	{
+		if (!src[stream[k].name])
+			continue;
+		attribData[stream[k].geomName] = dst;
+		for (j = 0; j < (stream[k].nameSecond != stream[k].name ? 2u : 1u); ++j)
+		{
+			name = j ? stream[k].nameSecond : stream[k].name;
+			in = (a3f32 const*)src[name];
+			i = geom->vertexFormat->attribElements[name];
+			switch (typeAfter[name] == typeBefore[name] ? a3attrib_disable : typeAfter[name])
+			{
+			case a3attrib_half2:
+			case a3attrib_half4:
+				if (i != format->attribElements[name])
+					in = a3demo_internalWiden(widen, in, i, n);
+				a3demo_encodeHalf((a3ui16*)dst, in, n * format->attribElements[name]);
+				break;
+			case a3attrib_snorm16x2:
+				a3demo_encodeOctahedral((a3i16*)dst, in, i, n);
+				break;
+			case a3attrib_snorm16x4:
+				a3demo_encodeSnorm16((a3i16*)dst, a3demo_internalWiden(widen, in, i, n), n * 4);
+				break;
+			case a3attrib_snorm10x3:
+				a3demo_encodeSnorm10x3((a3ui32*)dst, in, i, 1, n);
+				break;
+			case a3attrib_unorm8x4:
+				if (i != 4)
+					in = a3demo_internalWiden(widen, in, i, n);
+				a3demo_encodeUnorm8(dst, in, n * 4);
+				if (name == a3attrib_blendWeights)
+					a3demo_internalFixWeights(dst, in, n);
+				break;
+			default:
+				memcpy(dst, in, (size_t)n * format->attribSize[name]);
+				break;
+			}
+			dst += (size_t)n * format->attribSize[name];
+		}
+	}
+	if (indexBytes)
+		memcpy(data + vertexBytes, geom->indexData, indexBytes);
+
+	// swap in packed data
+	stats.vertexSizeBefore = geom->vertexFormat->vertexSize;
+	stats.vertexSizeAfter = format->vertexSize;
+	stats.packed = a3true;
+	free(geom->data);
+	geom->data = data;
+	geom->indexData = indexBytes ? data + vertexBytes : 0;
+	memcpy(geom->attribData, attribData, sizeof(attribData));
+	*geom->vertexFormat = *format;
+	data = 0;
+	result = 1;
+
+done:
+	if (stats_out_opt)
+	{
+		stats.vertexCount = geom->numVertices;
+		*stats_out_opt = stats;
+	}
+	free(data);
+	a3demo_release(widen);
+	return result;
+}
+
+void a3demo_printVertexPackStats(a3_DemoVertexPackStats const* stats, a3byte const* name)
+{
+	if (stats && stats->packed)
+		printf("\n A3 packed '%s': %u vertices, %u attributes; %u -> %u bytes per vertex (%.2fx) \n",
+			name ? name : (a3byte const*)"", stats->vertexCount, stats->attribCount,
+			stats->vertexSizeBefore, stats->vertexSizeAfter, (a3f64)stats->vertexSizeBefore / (a3f64)stats->vertexSizeAfter);
+	else if (stats)
+		printf("\n A3 pack '%s': skipped (no float attributes to pack) \n", name ? name : (a3byte const*)"");
+}
+
+
+//-----------------------------------------------------------------------------
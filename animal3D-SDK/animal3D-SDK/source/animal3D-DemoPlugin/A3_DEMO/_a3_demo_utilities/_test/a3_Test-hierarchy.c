@@ -0,0 +1,397 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_Test-hierarchy.c
+	Test and benchmark of hierarchy reordering and forward kinematics.
+
+	Usage: animal3D-DemoPlugin-Test-hierarchy [repeats]
+	Each rig is built in a scattered import order (every node's parent
+		is any earlier node), sized like the Egnaro skeleton (70 joints)
+		or larger, with random key poses and a skin whose blend indices
+		name every node. Blending two key poses must reach each pose at
+		the ends and stay orthonormal between them; a masked blend of
+		zeros and ones must pick each node's pose exactly. Sampling and
+		FK restricted to a few required nodes must give the same matrices
+		for them and their ancestors as evaluating every node, and must
+		not touch other nodes. The rig is reordered depth-first and then
+		breadth-first; after each reorder the parent of every node must
+		come before it, FK on the remapped poses must give the same
+		matrices bit for bit as FK before the reorder, and the blend
+		indices must name the same nodes. Remapping the poses and blend
+		indices back must restore them exactly. Best FK time of 'repeats'
+		runs is printed per order. Exit code is the number of failed
+		checks.
+*/
+
+// one unit with the code under test, so each inline library function 
+//	has a single definition
+#include "../../_animation/_src/a3_Hierarchy.c"
+#include "../../_animation/_src/a3_HierarchyState.c"
+#include "../../_animation/_src/a3_HierarchyStateBlend.c"
+#include "../../_animation/_src/a3_Kinematics.c"
+
+#include "../a3_DemoPlatform.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+//-----------------------------------------------------------------------------
+
+// test rig: hierarchy, two key poses, state and skin blending stream
+typedef struct a3_TestHierarchyRig
+{
+	a3_Hierarchy hierarchy[1];
+	a3_HierarchyPoseGroup poseGroup[1];
+	a3_HierarchyState state[1];
+	a3_GeometryData skin[1];
+	a3f32* blending;
+} a3_TestHierarchyRig;
+
+
+// test skin vertex count, trig samples per degree as in the demo
+enum
+{
+	a3testHierarchy_vertexCount = 4096,
+	a3testHierarchy_trigSamplesPerDegree = 4,
+};
+
+
+// small repeatable random numbers
+a3ui32 a3testInternalRandom(a3ui32* seed)
+{
+	*seed = *seed * 1664525u + 1013904223u;
+	return *seed >> 8;
+}
+
+
+//-----------------------------------------------------------------------------
+
+// rig in scattered import order: each parent is any earlier node
+a3ret a3testInternalCreateRig(a3_TestHierarchyRig* rig_out, a3ui32 const nodeCount, a3ui32 seed)
+{
+	a3byte name[a3node_nameSize];
+	a3i32* index;
+	a3ui32 i, k;
+
+	if (a3hierarchyCreate(rig_out->hierarchy, nodeCount, 0) <= 0)
+		return 0;
+	for (i = 0; i < nodeCount; ++i)
+	{
+		sprintf(name, "node_%u", i);
+		a3hierarchySetNode(rig_out->hierarchy, i, i ? (a3i32)(a3testInternalRandom(&seed) % i) : -1, name);
+	}
+
+	// key poses are rotations about each axis with an offset
+	if (a3hierarchyPoseGroupCreate(rig_out->poseGroup, rig_out->hierarchy, 2) <= 0)
+		return 0;
+	for (k = 0; k < 2; ++k)
+		for (i = 0; i < nodeCount; ++i)
+		{
+			a3mat4* m = &rig_out->poseGroup->hpose[k].spatialPose[i].transform;
+			a3real4x4SetRotateXYZ(m->m,
+				(a3real)(a3testInternalRandom(&seed) % 360), (a3real)(a3testInternalRandom(&seed) % 360), (a3real)(a3testInternalRandom(&seed) % 360));
+			m->v3.x = (a3real)(a3testInternalRandom(&seed) % 100) * 0.01f;
+			m->v3.y = (a3real)(a3testInternalRandom(&seed) % 100) * 0.01f;
+			m->v3.z = (a3real)(a3testInternalRandom(&seed) % 100) * 0.01f;
+		}
+	if (a3hierarchyStateCreate(rig_out->state, rig_out->poseGroup) <= 0)
+		return 0;
+
+	// planar blending stream: all weights, then all indices
+	rig_out->blending = (a3f32*)malloc(a3testHierarchy_vertexCount * 8 * sizeof(a3f32));
+	if (!rig_out->blending)
+		return 0;
+	index = (a3i32*)(rig_out->blending + a3testHierarchy_vertexCount * 4);
+	for (i = 0; i < a3testHierarchy_vertexCount * 4; ++i)
+	{
+		rig_out->blending[i] = 0.25f;
+		index[i] = (a3i32)(i % 5 ? i % nodeCount : (a3ui32)-1);
+	}
+	rig_out->skin->data = rig_out->blending;
+	rig_out->skin->attribData[a3attrib_geomBlending] = rig_out->blending;
+	rig_out->skin->numVertices = a3testHierarchy_vertexCount;
+	return 1;
+}
+
+void a3testInternalReleaseRig(a3_TestHierarchyRig* rig)
+{
+	a3hierarchyStateRelease(rig->state);
+	a3hierarchyPoseGroupRelease(rig->poseGroup);
+	a3hierarchyRelease(rig->hierarchy);
+	free(rig->blending);
+}
+
+// best time of full FK on pose 0
+a3f64 a3testInternalTimeForward(a3_TestHierarchyRig const* rig, a3ui32 const repeats)
+{
+	a3f64 best = 1.0e9, time;
+	a3ui32 r;
+	a3hierarchyStateSamplePose(rig->state, 0);
+	for (r = 0; r < repeats; ++r)
+	{
+		time = a3demo_getTime();
+		a3kinematicsSolveForward(rig->state);
+		time = a3demo_getTime() - time;
+		best = time < best ? time : best;
+	}
+	return best;
+}
+
+
+// count matrices differing by more than a tolerance
+a3ui32 a3testInternalCountDiff(a3mat4 const* m0, a3mat4 const* m1, a3ui32 const count, a3real const tolerance)
+{
+	a3ui32 i, j, bad = 0;
+	for (i = 0; i < count; ++i)
+		for (j = 0; j < 16; ++j)
+			if (m0[i].m[j / 4][j % 4] - m1[i].m[j / 4][j % 4] > tolerance || m1[i].m[j / 4][j % 4] - m0[i].m[j / 4][j % 4] > tolerance)
+			{
+				++bad;
+				break;
+			}
+	return bad;
+}
+
+// blends: slerp ends at the key poses and stays orthonormal, a mask 
+//	of zeros and ones picks each node's key pose exactly
+a3ui32 a3testInternalCheckBlend(a3_TestHierarchyRig const* rig, a3mat4* scratch)
+{
+	a3_HierarchyState const* state = rig->state;
+	a3mat4 const* local = state->localSpace->transform;
+	a3ui32 const n = rig->hierarchy->numNodes;
+	a3real* nodeParam;
+	a3real const* c[3];
+	a3ui32 i, j, bad = 0;
+
+	a3hierarchyStateSampleLerp(state, 0, 1, 0.0f);
+	bad += a3testInternalCountDiff(local, &rig->poseGroup->hpose[0].spatialPose->transform, n, 1.0e-4f);
+	a3hierarchyStateSampleLerp(state, 0, 1, 1.0f);
+	bad += a3testInternalCountDiff(local, &rig->poseGroup->hpose[1].spatialPose->transform, n, 1.0e-4f);
+	a3hierarchyStateSampleLerp(state, 0, 1, 0.5f);
+	for (i = 0; i < n; ++i)
+	{
+		c[0] = local[i].v0.v, c[1] = local[i].v1.v, c[2] = local[i].v2.v;
+		for (j = 0; j < 3; ++j)
+			if (a3real3LengthSquared(c[j]) - 1.0f > 1.0e-4f || 1.0f - a3real3LengthSquared(c[j]) > 1.0e-4f ||
+				a3real3Dot(c[j], c[(j + 1) % 3]) > 1.0e-4f || -a3real3Dot(c[j], c[(j + 1) % 3]) > 1.0e-4f)
+			{
+				++bad;
+				break;
+			}
+	}
+
+	nodeParam = (a3real*)malloc(n * sizeof(a3real));
+	if (!nodeParam)
+		return bad + 1;
+	for (i = 0; i < n; ++i)
+	{
+		nodeParam[i] = (a3real)(i % 2);
+		scratch[i] = rig->poseGroup->hpose[i % 2].spatialPose[i].transform;
+	}
+	a3hierarchyStateSampleLerpMasked(state, 0, 1, nodeParam);
+	bad += a3testInternalCountDiff(local, scratch, n, 0.0f);
+	free(nodeParam);
+	return bad;
+}
+
+// partial evaluation: sampling and FK restricted to a few required nodes 
+//	must give the same matrices for them and their ancestors as evaluating 
+//	every node, and leave all other nodes alone; a bad required node is 
+//	rejected without changing the list
+a3ui32 a3testInternalCheckPartial(a3_TestHierarchyRig* rig, a3mat4* full, a3ui32 seed, a3ui32* evalCount_out)
+{
+	a3_HierarchyState* state = rig->state;
+	a3mat4* object = state->objectSpace->transform;
+	a3ui32 const n = rig->hierarchy->numNodes;
+	a3i32 required[4], node, badNode = (a3i32)n;
+	a3ui32 i, k, bad = 0;
+	a3i32 count;
+
+	a3hierarchyStateSetEvaluationNodes(state, 0, 0);
+	a3hierarchyStateSampleLerp(state, 0, 1, 0.3f);
+	a3kinematicsSolveForward(state);
+	memcpy(full, object, n * sizeof(a3mat4));
+
+	for (i = 0; i < 4; ++i)
+		required[i] = (a3i32)(a3testInternalRandom(&seed) % n);
+	count = a3hierarchyStateSetEvaluationNodes(state, required, 4);
+	if (count <= 0 || count > (a3i32)n)
+		return 1;
+	memset(state->localSpace->transform, 0, n * sizeof(a3mat4));
+	memset(object, 0, n * sizeof(a3mat4));
+	a3hierarchyStateSampleLerp(state, 0, 1, 0.3f);
+	a3kinematicsSolveForward(state);
+
+	// required nodes and ancestors match, the rest were not touched
+	for (i = 0; i < 4; ++i)
+		for (node = required[i]; node >= 0; node = rig->hierarchy->nodes[node].parentIndex)
+			bad += memcmp(object + node, full + node, sizeof(a3mat4)) != 0;
+	for (i = k = 0; i < n; ++i)
+		if (k < (a3ui32)count && state->evalNode[k] == (a3i32)i)
+			bad += memcmp(object + i, full + i, sizeof(a3mat4)) != 0, ++k;
+		else
+			bad += object[i].m33 != 0.0f;
+
+	if (a3hierarchyStateSetEvaluationNodes(state, &badNode, 1) != -1 || state->evalCount != (a3ui32)count)
+		++bad;
+	*evalCount_out = count;
+	a3hierarchyStateSetEvaluationNodes(state, 0, 0);
+	return bad;
+}
+
+
+//-----------------------------------------------------------------------------
+
+int main(int const argc, char const* const argv[])
+{
+	a3ui32 const nodeCounts[] = { 70, 1024, 16384 };
+	a3_HierarchyNodeOrder const orders[] = { a3hierarchyOrder_depthFirst, a3hierarchyOrder_breadthFirst };
+	a3byte const* const orderNames[] = { "depth-first", "breadth-first" };
+	a3ui32 const repeats = argc > 1 ? (a3ui32)atoi(argv[1]) : 100;
+	a3_DemoMemoryCounters const memoryStart = *a3demo_getMemoryCounters();
+	a3_TestHierarchyRig rig[1];
+	a3real* trigTable;
+	a3mat4* reference;
+	a3_SpatialPose* poses;
+	a3i32* oldToNew, * newToOld, * indices, * indicesInit;
+	a3ui32 m, o, i, n, bad, failed = 0;
+	a3f64 timeImport, timeOrder;
+
+	// trig table (A3DM) for pose rotations
+	trigTable = (a3real*)malloc(a3trigInitSamplesRequired(a3testHierarchy_trigSamplesPerDegree) * sizeof(a3real));
+	if (!trigTable)
+	{
+		printf(" out of memory \n");
+		return 1;
+	}
+	a3trigInit(a3testHierarchy_trigSamplesPerDegree, trigTable);
+
+	for (m = 0; m < sizeof(nodeCounts) / sizeof(*nodeCounts); ++m)
+	{
+		n = nodeCounts[m];
+		printf("\n %u nodes \n", n);
+		for (o = 0; o < sizeof(orders) / sizeof(*orders); ++o)
+		{
+			memset(rig, 0, sizeof(rig));
+			reference = (a3mat4*)malloc(n * sizeof(a3mat4));
+			poses = (a3_SpatialPose*)malloc(n * 2 * sizeof(a3_SpatialPose));
+			oldToNew = (a3i32*)malloc(n * 2 * sizeof(a3i32));
+			indicesInit = (a3i32*)malloc(a3testHierarchy_vertexCount * 4 * sizeof(a3i32));
+			if (!reference || !poses || !oldToNew || !indicesInit || !a3testInternalCreateRig(rig, n, 1 + m))
+			{
+				printf(" out of memory \n");
+				return (int)(failed + 1);
+			}
+			newToOld = oldToNew + n;
+			indices = (a3i32*)(rig->blending + a3testHierarchy_vertexCount * 4);
+
+			// blends and partial evaluation, in import order
+			if (o == 0)
+			{
+				bad = a3testInternalCheckBlend(rig, reference);
+				printf("  blends:        ");
+				if (bad)
+					printf("FAILED: %u nodes differ \n", bad), ++failed;
+				else
+					printf("slerp and masked blend match key poses \n");
+				bad = a3testInternalCheckPartial(rig, reference, 7 + m, &i);
+				printf("  partial:       FK on %u of %u nodes ", i, n);
+				if (bad)
+					printf("FAILED: %u nodes differ from full FK \n", bad), ++failed;
+				else
+					printf("matches full FK \n");
+			}
+
+			// reference FK in import order
+			timeImport = a3testInternalTimeForward(rig, repeats);
+			memcpy(reference, rig->state->objectSpace->transform, n * sizeof(a3mat4));
+			memcpy(poses, rig->poseGroup->spatialPosePool, n * 2 * sizeof(a3_SpatialPose));
+			memcpy(indicesInit, indices, a3testHierarchy_vertexCount * 4 * sizeof(a3i32));
+
+			// reorder and remap everything that refers to nodes
+			if (a3hierarchyReorder(rig->hierarchy, orders[o], oldToNew, newToOld) != (a3ret)n ||
+				a3hierarchyPoseGroupRemap(rig->poseGroup, newToOld) != 2 ||
+				a3hierarchyRemapGeometryBlendIndices(rig->skin, oldToNew, n) != a3testHierarchy_vertexCount * 4)
+			{
+				printf("  %s: FAILED: reorder or remap rejected \n", orderNames[o]), ++failed;
+				goto next;
+			}
+			timeOrder = a3testInternalTimeForward(rig, repeats);
+			printf("  %-14s FK %8.3f us in import order, %8.3f us reordered (%.2fx) ",
+				orderNames[o], timeImport * 1.0e6, timeOrder * 1.0e6, timeImport / timeOrder);
+
+			// parents first, same nodes, same FK bits, same skin nodes
+			for (i = 0, bad = 0; i < n; ++i)
+				bad += rig->hierarchy->nodes[i].parentIndex >= (a3i32)i ||
+					rig->hierarchy->nodes[i].index != (a3i32)i ||
+					oldToNew[newToOld[i]] != (a3i32)i;
+			if (bad)
+			{
+				printf("FAILED: %u nodes out of order \n", bad), ++failed;
+				goto next;
+			}
+			for (i = 0, bad = 0; i < n; ++i)
+				bad += memcmp(rig->state->objectSpace->transform + oldToNew[i], reference + i, sizeof(a3mat4)) != 0;
+			if (bad)
+			{
+				printf("FAILED: %u FK matrices differ \n", bad), ++failed;
+				goto next;
+			}
+			for (i = 0, bad = 0; i < a3testHierarchy_vertexCount * 4; ++i)
+				bad += indices[i] != (indicesInit[i] < 0 ? indicesInit[i] : oldToNew[indicesInit[i]]);
+			if (bad)
+			{
+				printf("FAILED: %u blend indices differ \n", bad), ++failed;
+				goto next;
+			}
+
+			// remapping back with the inverse tables round-trips
+			a3hierarchyRemapNodeData(rig->poseGroup->hpose[0].spatialPose, sizeof(a3_SpatialPose), n, oldToNew);
+			a3hierarchyRemapNodeData(rig->poseGroup->hpose[1].spatialPose, sizeof(a3_SpatialPose), n, oldToNew);
+			a3hierarchyRemapNodeIndices(indices, a3testHierarchy_vertexCount * 4, newToOld, n);
+			if (memcmp(rig->poseGroup->spatialPosePool, poses, n * 2 * sizeof(a3_SpatialPose)) ||
+				memcmp(indices, indicesInit, a3testHierarchy_vertexCount * 4 * sizeof(a3i32)))
+				printf("FAILED: remapping back does not restore \n"), ++failed;
+			else
+				printf("\n");
+
+		next:
+			a3testInternalReleaseRig(rig);
+			free(reference);
+			free(poses);
+			free(oldToNew);
+			free(indicesInit);
+		}
+	}
+
+	free(trigTable);
+
+	// every block was released
+	if (a3demo_getMemoryCounters()->bytesInUse != memoryStart.bytesInUse)
+		printf("\n FAILED: %lld bytes still in use \n", (long long)(a3demo_getMemoryCounters()->bytesInUse - memoryStart.bytesInUse)), ++failed;
+
+	printf("\n %u failed \n", failed);
+	return (int)failed;
+}
+
+
+//-----------------------------------------------------------------------------
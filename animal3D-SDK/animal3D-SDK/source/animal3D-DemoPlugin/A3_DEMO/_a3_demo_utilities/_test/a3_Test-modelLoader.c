@@ -0,0 +1,315 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_Test-modelLoader.c
+	Test and benchmark of the parallel OBJ loader.
+
+	Usage: animal3D-DemoPlugin-Test-modelLoader [repeats]
+	A small file checks the parser: polygons of three to eight corners
+		must be fan-triangulated in order (corners 0, i, i + 1), with
+		corners written as v, v/vt, v//vn or v/vt/vn, relative (negative)
+		indices, comments and CRLF line ends. Malformed faces and indices
+		out of range must fail the load. A height-field grid large enough
+		for every chunk is then loaded with one chunk, then with every
+		thread count up to the limit. Each row of faces refers to the
+		vertices of the rows before it, so corners in different chunks
+		must be welded in the merge. Vertex and triangle counts must match
+		the grid, triangles must match its quads, and output must match one
+		chunk bit for bit. Best time of 'repeats' runs is printed per
+		thread count. Test files are written to the working directory and
+		removed. Exit code is the number of failed checks.
+*/
+
+// one unit with the code under test, so each inline library function 
+//	has a single definition
+#include "../_src/a3_DemoModelLoader.c"
+#include "../_src/a3_DemoTangentBasis.c"
+#include "../_src/a3_DemoFileMap.c"
+
+// threads the loader launches and the vertex format it asks for, where 
+//	the animal3D library is not built
+#include "a3_TestLibrary-animal3D.c"
+
+#include "../a3_DemoMemory.h"
+#include "../a3_DemoPlatform.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+//-----------------------------------------------------------------------------
+
+// grid size for the chunk test: enough bytes for every chunk
+#define a3test_gridSize		160
+
+// parser test file: position k is (k, k + 10, k + 20) and texcoord k is
+//	(k / 8, 1 - k / 8), both 1-based; polygons listed below
+static a3byte const a3test_parseFile[] =
+	"# parser test\n"
+	"v 1 11 21\nv 2 12 22\nv 3 13 23\nv 4 14 24\r\n"
+	"v 5 15 25\nv 6 16 26\nv 7 17 27\nv 8 18 28\n"
+	"vt 0.125 0.875\nvt 0.25 0.75\nvt 0.375 0.625\nvt 0.5 0.5\n"
+	"vt 0.625 0.375\nvt 0.75 0.25\nvt 0.875 0.125\nvt 1 0\n"
+	"vn 0 0 1\n"
+	"f 1 2 3 # triangle\n"
+	"f 1/1 2/2 3/3 4/4\r\n"
+	"\tf -8//1 -7//1 -6//1 -5//1 -4//1\n"
+	"f 8/8/1 7/7/1 6/6/1 5/5/1 4/4/1 3/3/1\n"
+	"g ignored\n"
+	"f 1/1/1 2/2/1 3/3/1 4/4/1 5/5/1 6/6/1 7/7/1 8/8/1";
+
+// corners of each polygon above: position, texcoord (0 if none)
+static a3i32 const a3test_parsePolygon[][8][2] = {
+	{ { 1, 0 }, { 2, 0 }, { 3, 0 } },
+	{ { 1, 1 }, { 2, 2 }, { 3, 3 }, { 4, 4 } },
+	{ { 1, 0 }, { 2, 0 }, { 3, 0 }, { 4, 0 }, { 5, 0 } },
+	{ { 8, 8 }, { 7, 7 }, { 6, 6 }, { 5, 5 }, { 4, 4 }, { 3, 3 } },
+	{ { 1, 1 }, { 2, 2 }, { 3, 3 }, { 4, 4 }, { 5, 5 }, { 6, 6 }, { 7, 7 }, { 8, 8 } },
+};
+static a3ui32 const a3test_parseCorners[] = { 3, 4, 5, 6, 8 };
+
+// malformed files; each must fail the load
+static a3byte const* const a3test_malformedFile[] = {
+	"v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 4\n",
+	"v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 -4\n",
+	"v 0 0 0\nv 1 0 0\nv 0 1 0\nf 0 1 2\n",
+	"v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 x\n",
+	"v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3x\n",
+	"v 0 0 0\nv 1 0 0\nv 0 1 0\nvt 0 0\nf 1/2 2/1 3/1\n",
+	"v 0 0 0\nv 1 0 0\nv 0 1 0\n",
+};
+
+static a3byte const* const a3test_filePath = "a3_Test-modelLoader.obj";
+
+
+//-----------------------------------------------------------------------------
+
+// write file; false if it could not be written
+a3boolean a3testInternalWriteFile(a3byte const* filePath, a3byte const* text)
+{
+	FILE* fp = fopen(filePath, "wb");
+	a3boolean ok = fp && fputs(text, fp) >= 0;
+	return (fp && fclose(fp) == 0) && ok;
+}
+
+// write grid of heights; rows of faces follow the vertices they use, 
+//	even rows by absolute and odd rows by relative index
+a3boolean a3testInternalWriteGrid(a3byte const* filePath, a3ui32 const n)
+{
+	FILE* fp = fopen(filePath, "wb");
+	a3ui32 i, j;
+	a3i32 a, b, k;
+	a3boolean ok = fp != 0;
+	for (j = 0; ok && j < n; ++j)
+	{
+		for (i = 0; i < n; ++i)
+			fprintf(fp, "v %.2f %.2f %.2f\nvt %.6f %.6f\n",
+				(a3f64)i * 0.5, (a3f64)j * 0.5, (a3f64)((i * j) % 7) * 0.25, (a3f64)i / 64.0, (a3f64)j / 64.0);
+
+		// quads from previous row to this one; relative indices count 
+		//	back from one past the last position
+		k = (j % 2) ? (a3i32)((j + 1) * n + 1) : 0;
+		for (i = 0; j && i + 1 < n; ++i)
+		{
+			a = (a3i32)((j - 1) * n + i + 1) - k;
+			b = (a3i32)(j * n + i + 1) - k;
+			fprintf(fp, "f %d/%d %d/%d %d/%d %d/%d\n", a, a, a + 1, a + 1, b + 1, b + 1, b, b);
+		}
+		ok = !ferror(fp);
+	}
+	return (fp && fclose(fp) == 0) && ok;
+}
+
+// corner of output triangle
+a3ui32 a3testInternalIndex(a3_GeometryData const* geom, a3ui32 const i)
+{
+	switch (geom->indexFormat->indexSize)
+	{
+	case 1: return ((a3ubyte const*)geom->indexData)[i];
+	case 2: return ((a3ui16 const*)geom->indexData)[i];
+	}
+	return ((a3ui32 const*)geom->indexData)[i];
+}
+
+// bytes of vertex and index data in geometry's block
+a3ui32 a3testInternalDataSize(a3_GeometryData const* geom)
+{
+	return (a3ui32)(a3vertexFormatGetStorageSpaceRequired(geom->vertexFormat, geom->numVertices) +
+		a3indexFormatGetStorageSpaceRequired(geom->indexFormat, geom->numIndices));
+}
+
+// count output triangles whose corners differ from fan of parser polygons
+a3ui32 a3testInternalCountBadFan(a3_GeometryData const* geom)
+{
+	a3f32 const* const position = (a3f32 const*)geom->attribData[a3attrib_geomPosition];
+	a3f32 const* const texcoord = (a3f32 const*)geom->attribData[a3attrib_geomTexcoord];
+	a3ui32 p, i, j, t = 0, v, bad = 0;
+	a3i32 const* corner;
+	a3f32 pk, tk;
+	for (p = 0; p < sizeof(a3test_parseCorners) / sizeof(*a3test_parseCorners); ++p)
+		for (i = 1; i + 1 < a3test_parseCorners[p]; ++i, ++t)
+			for (j = 0; j < 3; ++j)
+			{
+				corner = a3test_parsePolygon[p][j ? i + j - 1 : 0];
+				v = a3testInternalIndex(geom, t * 3 + j);
+				pk = (a3f32)corner[0];
+				tk = (a3f32)corner[1] / 8.0f;
+				if (position[v * 3 + 0] != pk || position[v * 3 + 1] != pk + 10.0f || position[v * 3 + 2] != pk + 20.0f ||
+					texcoord[v * 2 + 0] != tk || texcoord[v * 2 + 1] != (corner[1] ? 1.0f - tk : 0.0f))
+				{
+					++bad;
+					break;
+				}
+			}
+	return bad;
+}
+
+// count grid quads whose triangles differ from their fan
+a3ui32 a3testInternalCountBadGrid(a3_GeometryData const* geom, a3ui32 const n)
+{
+	static a3ui32 const fan[6] = { 0, 1, 2, 0, 2, 3 };
+	a3f32 const* const position = (a3f32 const*)geom->attribData[a3attrib_geomPosition];
+	a3ui32 quad[4], i, j, k, t = 0, v, bad = 0;
+	for (j = 1; j < n; ++j)
+		for (i = 0; i + 1 < n; ++i, t += 2)
+		{
+			quad[0] = (j - 1) * n + i;
+			quad[1] = quad[0] + 1;
+			quad[2] = j * n + i + 1;
+			quad[3] = j * n + i;
+			for (k = 0; k < 6; ++k)
+			{
+				v = a3testInternalIndex(geom, t * 3 + k);
+				if (position[v * 3 + 0] != (a3f32)(quad[fan[k]] % n) * 0.5f ||
+					position[v * 3 + 1] != (a3f32)(quad[fan[k]] / n) * 0.5f)
+					break;
+			}
+			bad += (k < 6);
+		}
+	return bad;
+}
+
+
+//-----------------------------------------------------------------------------
+
+int main(int const argc, char const* const argv[])
+{
+	a3ui32 const repeats = argc > 1 ? (a3ui32)atoi(argv[1]) : 10;
+	a3_DemoMemoryCounters const memoryStart = *a3demo_getMemoryCounters();
+	a3_DemoModelLoadStats stats[1];
+	a3_GeometryData geom[1], reference[1];
+	a3byte* referenceData = 0;
+	a3f64 best, time;
+	a3ui32 i, threads, expect, r, bad, failed = 0;
+	a3ret result;
+
+	// parser
+	memset(geom, 0, sizeof(geom));
+	if (!a3testInternalWriteFile(a3test_filePath, a3test_parseFile))
+	{
+		printf(" could not write '%s' \n", a3test_filePath);
+		return (int)(failed + 1);
+	}
+	result = a3demo_loadModelOBJ(geom, a3test_filePath, a3model_loadNormals_loadTexcoords, 0, 1, stats);
+	printf("\n parser: %u polygons (%u n-gons) -> %u triangles, %u vertices ",
+		stats->polygonCount, stats->ngonCount, stats->triangleCount, stats->vertexCount);
+	if (result <= 0)
+		printf("FAILED: result %d \n", result), ++failed;
+	else if (stats->polygonCount != 5 || stats->ngonCount != 3 || stats->triangleCount != 16 || geom->numIndices != 16 * 3)
+		printf("FAILED: expected 5 polygons (3 n-gons), 16 triangles \n"), ++failed;
+	else if ((bad = a3testInternalCountBadFan(geom)))
+		printf("FAILED: %u triangles not fanned from their polygon \n", bad), ++failed;
+	else
+		printf("\n");
+	free((void*)geom->data);
+
+	// malformed files
+	for (i = 0; i < sizeof(a3test_malformedFile) / sizeof(*a3test_malformedFile); ++i)
+	{
+		memset(geom, 0, sizeof(geom));
+		a3testInternalWriteFile(a3test_filePath, a3test_malformedFile[i]);
+		result = a3demo_loadModelOBJ(geom, a3test_filePath, a3model_loadTexcoords, 0, 1, 0);
+		printf("\n malformed file %u: result %d ", i, result);
+		if (result != 0 || geom->data)
+			printf("FAILED: expected 0 \n"), ++failed, free((void*)geom->data);
+		else
+			printf("\n");
+	}
+
+	// chunks
+	if (!a3testInternalWriteGrid(a3test_filePath, a3test_gridSize))
+	{
+		printf(" could not write '%s' \n", a3test_filePath);
+		remove(a3test_filePath);
+		return (int)(failed + 1);
+	}
+	memset(reference, 0, sizeof(reference));
+	for (threads = 1; threads <= a3demoModelLoader_threadMax; ++threads)
+	{
+		for (r = 0, best = 1.0e9, result = 1; r < repeats && result > 0; ++r)
+		{
+			memset(geom, 0, sizeof(geom));
+			time = a3demo_getTime();
+			result = a3demo_loadModelOBJ(geom, a3test_filePath, a3model_calculateVertexTangents, 0, threads, stats);
+			time = a3demo_getTime() - time;
+			best = time < best ? time : best;
+			if (r + 1 < repeats && result > 0)
+				free((void*)geom->data);
+		}
+		if (threads == 1)
+		{
+			printf("\n %.2f MB, %u positions, %u triangles \n", (a3f64)stats->fileSize / (1024.0 * 1024.0), stats->positionCount, stats->triangleCount);
+			if (result > 0)
+				*reference = *geom, referenceData = (a3byte*)geom->data;
+		}
+		expect = (a3ui32)(stats->fileSize / a3demoModelLoader_chunkMin);
+		expect = threads < expect ? threads : expect ? expect : 1;
+		printf("  %2u threads: %2u chunks, %8.3f ms (%.1f MB/s) ", threads, stats->threadCount, best * 1000.0, stats->megabytesPerSecond);
+		if (result <= 0)
+			printf("FAILED: result %d \n", result), ++failed;
+		else if (stats->threadCount != expect)
+			printf("FAILED: expected %u chunks \n", expect), ++failed;
+		else if (geom->numVertices != a3test_gridSize * a3test_gridSize ||
+			geom->numIndices != (a3test_gridSize - 1) * (a3test_gridSize - 1) * 6)
+			printf("FAILED: %u vertices, %u indices \n", geom->numVertices, geom->numIndices), ++failed;
+		else if ((bad = a3testInternalCountBadGrid(geom, a3test_gridSize)))
+			printf("FAILED: %u quads not fanned from the grid \n", bad), ++failed;
+		else if (!referenceData || memcmp(geom->vertexFormat, reference->vertexFormat, sizeof(a3_VertexFormatDescriptor)) ||
+			memcmp(geom->data, referenceData, a3testInternalDataSize(reference)))
+			printf("FAILED: differs from one chunk \n"), ++failed;
+		else
+			printf("\n");
+		if (result > 0 && geom->data != referenceData)
+			free((void*)geom->data);
+	}
+	free(referenceData);
+	remove(a3test_filePath);
+
+	// every scratch block was released
+	if (a3demo_getMemoryCounters()->bytesInUse != memoryStart.bytesInUse)
+		printf("\n FAILED: %lld bytes still in use \n", (long long)(a3demo_getMemoryCounters()->bytesInUse - memoryStart.bytesInUse)), ++failed;
+
+	printf("\n %u failed \n", failed);
+	return (int)failed;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,159 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_Test-pathAnimation.c
+	Test of constant-speed path following.
+
+	Usage: animal3D-DemoPlugin-Test-pathAnimation
+	One path of each interpolation type is built through unevenly spaced
+		points, so equal parameter steps cover very different distances.
+		A scene object is driven along each path by a follower with
+		equal time steps (looping paths go around twice). The distance
+		covered by each step is measured independently by summing a fine
+		polyline over the path parameter between the two positions; it
+		must equal speed times time step within 0.2 percent, and the
+		scene object must sit on the path at the follower's distance.
+		Exit code is the number of failed checks.
+*/
+
+// one unit with the code under test, so each inline library function 
+//	has a single definition
+#include "../../_animation/_src/a3_PathAnimation.c"
+
+#include <stdio.h>
+#include <string.h>
+
+
+//-----------------------------------------------------------------------------
+
+// test sizes; the table is exact at bins and lerped between them, so 
+//	bins are kept well below one step (64 per segment is about one bin 
+//	per step here and misses the tolerance near kinks)
+enum
+{
+	a3testPath_stepCount = 200,					// follower steps per path
+	a3testPath_samplesPerSegment = 1024,		// distance bins per segment
+	a3testPath_polylineSamples = 256,			// reference samples per step
+};
+
+
+// arc length between two path parameters by fine polyline
+a3f64 a3testInternalArcLength(a3_Path const* path, a3real const param0, a3real const param1)
+{
+	a3real3 p0, p1;
+	a3f64 length = 0.0;
+	a3ui32 i;
+	a3pathEvaluate(path, p0, param0);
+	for (i = 1; i <= a3testPath_polylineSamples; ++i)
+	{
+		a3pathEvaluate(path, p1, param0 + (param1 - param0) * (a3real)i / (a3real)a3testPath_polylineSamples);
+		length += sqrt((a3f64)(p1[0] - p0[0]) * (p1[0] - p0[0]) + (a3f64)(p1[1] - p0[1]) * (p1[1] - p0[1]) + (a3f64)(p1[2] - p0[2]) * (p1[2] - p0[2]));
+		a3real3SetReal3(p0, p1);
+	}
+	return length;
+}
+
+
+//-----------------------------------------------------------------------------
+
+int main(int const argc, char const* const argv[])
+{
+	// uneven spacing: short hops then long runs
+	a3vec3 const points[] = {
+		{ { 0.0f, 0.0f, 0.0f } }, { { 0.2f, 0.1f, 0.0f } }, { { 4.0f, 0.5f, 1.0f } },
+		{ { 4.3f, 3.0f, 1.0f } }, { { 4.4f, 3.2f, 0.5f } }, { { -2.0f, 5.0f, 0.0f } },
+		{ { -2.5f, 1.0f, -1.0f } },
+	};
+	struct {
+		a3_PathInterpolation interp;
+		a3ui32 pointCount;
+		a3boolean loop;
+		a3byte const* name;
+	} const paths[] = {
+		{ a3path_linear, 7, 0, "linear" },
+		{ a3path_catmullRom, 7, 1, "Catmull-Rom loop" },
+		{ a3path_hermite, 6, 0, "Hermite" },
+		{ a3path_bezier, 7, 0, "Bezier" },
+	};
+	a3_DemoMemoryCounters const memoryStart = *a3demo_getMemoryCounters();
+	a3_Path path[1];
+	a3_PathFollower follower[1];
+	a3_DemoSceneObject sceneObject[1];
+	a3real3 position;
+	a3real param, paramPrev, speed, dt;
+	a3f64 step, stepMin, stepMax, paramStepMin, paramStepMax;
+	a3ui32 p, i, bad, failed = 0;
+
+	for (p = 0; p < sizeof(paths) / sizeof(*paths); ++p)
+	{
+		memset(path, 0, sizeof(path));
+		memset(sceneObject, 0, sizeof(sceneObject));
+		if (a3pathCreate(path, paths[p].interp, points, paths[p].pointCount, paths[p].loop, a3testPath_samplesPerSegment, 0) <= 0)
+		{
+			printf(" %-17s FAILED: not created \n", paths[p].name), ++failed;
+			continue;
+		}
+
+		// spread of distance per equal parameter step, for scale
+		for (i = 0, paramStepMin = 1.0e9, paramStepMax = 0.0; i < path->segmentCount * 8; ++i)
+		{
+			step = a3testInternalArcLength(path, (a3real)i / 8.0f, (a3real)(i + 1) / 8.0f);
+			paramStepMin = step < paramStepMin ? step : paramStepMin;
+			paramStepMax = step > paramStepMax ? step : paramStepMax;
+		}
+
+		// equal time steps; loops go around twice, open paths stop short
+		//	of the end so no step is clamped
+		speed = 1.5f;
+		dt = path->length * (paths[p].loop ? 2.0f : 0.999f) / (speed * (a3real)a3testPath_stepCount);
+		a3pathFollowerInit(follower, sceneObject, a3real_zero, speed);
+		paramPrev = a3real_zero;
+		for (i = 0, bad = 0, stepMin = 1.0e9, stepMax = 0.0; i < a3testPath_stepCount; ++i)
+		{
+			a3pathFollowerUpdate(path, follower, 1, dt);
+			param = a3pathGetParamAtDistance(path, follower->distance);
+			step = param >= paramPrev ? a3testInternalArcLength(path, paramPrev, param) :
+				a3testInternalArcLength(path, paramPrev, (a3real)path->segmentCount) + a3testInternalArcLength(path, a3real_zero, param);
+			stepMin = step < stepMin ? step : stepMin;
+			stepMax = step > stepMax ? step : stepMax;
+			a3pathEvaluate(path, position, param);
+			bad += fabs(step - speed * dt) > 0.002 * speed * dt ||
+				memcmp(position, sceneObject->position.v, sizeof(position)) != 0;
+			paramPrev = param;
+		}
+		printf(" %-17s length %7.3f, parameter steps %.3f to %.3f, time steps %.5f to %.5f (expect %.5f) ",
+			paths[p].name, path->length, paramStepMin, paramStepMax, stepMin, stepMax, speed * dt);
+		if (bad)
+			printf("FAILED: %u steps \n", bad), ++failed;
+		else
+			printf("\n");
+		a3pathRelease(path);
+	}
+
+	// every block was released
+	if (a3demo_getMemoryCounters()->bytesInUse != memoryStart.bytesInUse)
+		printf("\n FAILED: %lld bytes still in use \n", (long long)(a3demo_getMemoryCounters()->bytesInUse - memoryStart.bytesInUse)), ++failed;
+
+	printf("\n %u failed \n", failed);
+	return (int)failed;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,326 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_Test-skinWeights.c
+	Test of the streaming skin-weight importer against a reference.
+
+	Usage: animal3D-DemoPlugin-Test-skinWeights
+	The egnaro skin (one shape of 3398 points, 70 weight lists) is read
+		whole by a plain reference parser that keeps every weight, sorts
+		each vertex's weights largest first (equal weights in file order),
+		keeps the largest few and renormalizes in double. The importer
+		must give the same vertex and influence counts, the same nodes,
+		float weights within 1e-6 and quantized weights that sum exactly
+		to the format's one and round from the reference. This is done
+		with lists numbered in file order and with a hierarchy that names
+		the lists in reverse order and leaves some out. Small files check
+		that a point index past the shape size, an unclosed element and
+		an index without a shape are handled. Exit code is the number of
+		failed checks.
+*/
+
+// one unit with the code under test, so each inline library function 
+//	has a single definition
+#include "../_src/a3_DemoSkinWeights.c"
+#include "../../_animation/_src/a3_Hierarchy.c"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+
+#ifndef A3_TEST_RESOURCE_DIR
+#define A3_TEST_RESOURCE_DIR	"../../../resource/"
+#endif	// !A3_TEST_RESOURCE_DIR
+
+// test sizes
+enum
+{
+	a3testSkin_listMax = 128,				// weight lists in reference
+	a3testSkin_rawMax = 128,				// weights per vertex in reference
+	a3testSkin_vertexMax = 1 << 16,			// vertices in reference
+	a3testSkin_skipEvery = 10,				// hierarchy leaves out every nth list
+};
+
+// reference: every weight of every vertex, largest first
+typedef struct a3_TestSkinReference
+{
+	a3byte name[a3testSkin_listMax][a3node_nameSize];
+	a3f32* weight;
+	a3i32* list;
+	a3ui32* count;
+	a3ui32 listCount, vertexCount;
+} a3_TestSkinReference;
+
+
+// quoted attribute value inside element; zero if missing
+a3byte const* a3testInternalAttrib(a3byte const* element, a3byte const* end, a3byte const* name, a3ui32* length_out)
+{
+	a3ui32 const nameLength = (a3ui32)strlen(name);
+	a3byte const* c, * close;
+	for (c = element; c + nameLength + 2 < end; ++c)
+		if (c[-1] == ' ' && !memcmp(c, name, nameLength) && c[nameLength] == '=' && c[nameLength + 1] == '"')
+		{
+			c += nameLength + 2;
+			if (!(close = (a3byte const*)memchr(c, '"', end - c)))
+				return 0;
+			*length_out = (a3ui32)(close - c);
+			return c;
+		}
+	return 0;
+}
+
+// read whole file with string searches, no streaming
+a3ret a3testInternalReadReference(a3_TestSkinReference* ref_out, a3byte const* filePath)
+{
+	FILE* fp = fopen(filePath, "rb");
+	a3byte* text, * c, * listEnd, * elementEnd;
+	a3byte const* value;
+	a3ui32 length, vertex, n, j;
+	a3f32 weight;
+	long size;
+
+	memset(ref_out, 0, sizeof(*ref_out));
+	if (!fp)
+		return 0;
+	fseek(fp, 0, SEEK_END);
+	size = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+	text = (a3byte*)malloc((size_t)size + 1);
+	if (!text || fread(text, 1, (size_t)size, fp) != (size_t)size)
+	{
+		fclose(fp);
+		free(text);
+		return 0;
+	}
+	fclose(fp);
+	text[size] = 0;
+
+	// shape size gives vertex count
+	ref_out->weight = (a3f32*)malloc((size_t)a3testSkin_vertexMax * a3testSkin_rawMax * sizeof(a3f32));
+	ref_out->list = (a3i32*)malloc((size_t)a3testSkin_vertexMax * a3testSkin_rawMax * sizeof(a3i32));
+	ref_out->count = (a3ui32*)calloc(a3testSkin_vertexMax, sizeof(a3ui32));
+	if (!ref_out->weight || !ref_out->list || !ref_out->count || !(c = strstr(text, "<shape ")) ||
+		!(elementEnd = strchr(c, '>')) || !(value = a3testInternalAttrib(c, elementEnd, "size", &length)) ||
+		(ref_out->vertexCount = (a3ui32)atoi(value)) > a3testSkin_vertexMax)
+	{
+		free(text);
+		return 0;
+	}
+
+	// each list: name, then points until it closes; equal weights stay
+	//	in file order because insertion stops at the first larger one
+	for (c = text; (c = strstr(c, "<weights ")) && ref_out->listCount < a3testSkin_listMax; c = listEnd)
+	{
+		if (!(elementEnd = strchr(c, '>')) || !(listEnd = strstr(elementEnd, "</weights>")))
+			break;
+		value = a3testInternalAttrib(c, elementEnd, "source", &length);
+		length = value && length < a3node_nameSize ? length : 0;
+		memcpy(ref_out->name[ref_out->listCount], value, length);
+		ref_out->name[ref_out->listCount][length] = 0;
+		for (c = elementEnd; (c = strstr(c, "<point ")) && c < listEnd; c = elementEnd)
+		{
+			elementEnd = strchr(c, '>');
+			vertex = (a3ui32)atoi(a3testInternalAttrib(c, elementEnd, "index", &length));
+			weight = (a3f32)atof(a3testInternalAttrib(c, elementEnd, "value", &length));
+			if (weight <= 0.0f || vertex >= ref_out->vertexCount || ref_out->count[vertex] >= a3testSkin_rawMax)
+				continue;
+			n = ref_out->count[vertex]++;
+			for (j = n; j > 0 && ref_out->weight[vertex * a3testSkin_rawMax + j - 1] < weight; --j)
+			{
+				ref_out->weight[vertex * a3testSkin_rawMax + j] = ref_out->weight[vertex * a3testSkin_rawMax + j - 1];
+				ref_out->list[vertex * a3testSkin_rawMax + j] = ref_out->list[vertex * a3testSkin_rawMax + j - 1];
+			}
+			ref_out->weight[vertex * a3testSkin_rawMax + j] = weight;
+			ref_out->list[vertex * a3testSkin_rawMax + j] = (a3i32)ref_out->listCount;
+		}
+		++ref_out->listCount;
+	}
+	free(text);
+	return (ref_out->listCount > 0);
+}
+
+void a3testInternalReleaseReference(a3_TestSkinReference* ref)
+{
+	free(ref->weight);
+	free(ref->list);
+	free(ref->count);
+}
+
+// compare imported weights with reference; lists map to nodes through
+//	listNode (-1 drops the list); returns number of bad vertices
+a3ui32 a3testInternalCompare(a3_TestSkinReference const* ref, a3_DemoSkinWeights const* weights, a3i32 const* listNode)
+{
+	a3f64 expect[a3demoSkinWeights_influenceMax], sum;
+	a3i32 node[a3demoSkinWeights_influenceMax], index[a3demoSkinWeights_influenceMax];
+	a3f32 weight[a3demoSkinWeights_influenceMax];
+	a3f64 const tolerance = weights->format == a3demoSkinWeight_float ? 1.0e-6 :
+		(a3f64)weights->influenceCount / (weights->format == a3demoSkinWeight_unorm16 ? 65535.0 : 255.0);
+	a3ui32 const n = weights->influenceCount;
+	a3ui32 v, i, j, kept, total, bad = 0;
+	a3boolean wrong;
+
+	for (v = 0; v < ref->vertexCount; ++v)
+	{
+		// reference kept weights
+		for (i = 0, kept = 0, sum = 0.0; i < ref->count[v] && kept < n; ++i)
+			if (listNode[ref->list[v * a3testSkin_rawMax + i]] >= 0)
+			{
+				node[kept] = listNode[ref->list[v * a3testSkin_rawMax + i]];
+				sum += expect[kept++] = ref->weight[v * a3testSkin_rawMax + i];
+			}
+		for (j = 0; j < n; ++j)
+			expect[j] = j < kept ? expect[j] / sum : 0.0, node[j] = j < kept ? node[j] : 0;
+
+		// imported weights
+		a3demo_getSkinWeights(weight, index, weights, v);
+		wrong = a3false;
+		for (j = 0; j < n; ++j)
+			wrong |= index[j] != node[j] || fabs(weight[j] - expect[j]) > tolerance;
+
+		// quantized weights sum exactly to one
+		if (weights->format == a3demoSkinWeight_unorm16 && kept)
+		{
+			for (j = 0, total = 0; j < n; ++j)
+				total += ((a3ui16 const*)weights->weight)[v * n + j];
+			wrong |= total != 65535;
+		}
+		bad += wrong;
+	}
+	return bad;
+}
+
+// write small file
+a3boolean a3testInternalWriteFile(a3byte const* filePath, a3byte const* text)
+{
+	FILE* fp = fopen(filePath, "wb");
+	a3boolean ok;
+	if (!fp)
+		return a3false;
+	ok = fputs(text, fp) >= 0;
+	return (fclose(fp) == 0 && ok);
+}
+
+
+//-----------------------------------------------------------------------------
+
+int main(int const argc, char const* const argv[])
+{
+	a3byte const* const filePath = A3_TEST_RESOURCE_DIR"obj/egnaro/egnaro_skin.xml";
+	a3byte const* const tmpPath = "a3_Test-skinWeights.tmp.xml";
+
+	// small files: name, text, expected result
+	struct {
+		a3byte const* name;
+		a3byte const* text;
+		a3ret expect;
+	} const smallFiles[] = {
+		{ "index in shape", "<deformerWeight><shape size=\"4\"/><weights source=\"a\"><point index=\"3\" value=\"1\"/></weights></deformerWeight>", 4 },
+		{ "index past shape", "<deformerWeight><shape size=\"4\"/><weights source=\"a\"><point index=\"4\" value=\"1\"/></weights></deformerWeight>", 0 },
+		{ "huge index past shape", "<deformerWeight><shape size=\"4\"/><weights source=\"a\"><point index=\"4000000000\" value=\"1\"/></weights></deformerWeight>", 0 },
+		{ "unclosed list", "<deformerWeight><shape size=\"4\"/><weights source=\"a\"><point index=\"1\" value=\"1\"/></deformerWeight>", 0 },
+		{ "no shape", "<deformerWeight><weights source=\"a\"><point index=\"5\" value=\"1\"/></weights></deformerWeight>", 6 },
+	};
+
+	a3_DemoMemoryCounters const memoryStart = *a3demo_getMemoryCounters();
+	a3_TestSkinReference ref[1];
+	a3_DemoSkinWeights weights[1];
+	a3_DemoSkinWeightsStats stats[1];
+	a3_Hierarchy hierarchy[1];
+	a3byte const* names[a3testSkin_listMax];
+	a3i32 listNode[2][a3testSkin_listMax];
+	a3ui32 const formats[2] = { a3demoSkinWeight_float, a3demoSkinWeight_unorm16 };
+	a3ui32 i, h, f, nodeCount, skipped, bad, failed = 0;
+	a3ret result;
+
+	if (a3testInternalReadReference(ref, filePath) <= 0)
+	{
+		printf(" FAILED: could not read '%s' \n", filePath);
+		a3testInternalReleaseReference(ref);
+		return 1;
+	}
+	printf(" reference: %u vertices, %u weight lists \n", ref->vertexCount, ref->listCount);
+
+	// hierarchy names lists in reverse order, leaving every nth out
+	memset(hierarchy, 0, sizeof(hierarchy));
+	for (i = 0, nodeCount = 0, skipped = 0; i < ref->listCount; ++i)
+	{
+		listNode[0][i] = (a3i32)i;
+		listNode[1][i] = -1;
+	}
+	for (i = ref->listCount; i-- > 0; )
+		if (i % a3testSkin_skipEvery)
+		{
+			listNode[1][i] = (a3i32)nodeCount;
+			names[nodeCount++] = ref->name[i];
+		}
+		else
+			++skipped;
+	a3hierarchyCreate(hierarchy, nodeCount, names);
+
+	for (h = 0; h < 2; ++h)
+		for (f = 0; f < 2; ++f)
+		{
+			memset(weights, 0, sizeof(weights));
+			result = a3demo_importSkinWeights(weights, filePath, h ? hierarchy : 0, 4, formats[f], stats);
+			bad = result > 0 ? a3testInternalCompare(ref, weights, listNode[h]) : 0;
+			printf(" %-9s %-7s %u vertices, %u lists (%u unmatched), %8.3f ms ",
+				h ? "hierarchy" : "numbered", f ? "unorm16" : "float", stats->vertexCount, stats->influenceCount, stats->unmatchedCount, stats->totalTime * 1000.0);
+			if (result != (a3ret)ref->vertexCount || stats->influenceCount != ref->listCount)
+				printf("FAILED: result %d \n", result), ++failed;
+			else if (stats->unmatchedCount != (h ? skipped : 0))
+				printf("FAILED: expected %u unmatched \n", h ? skipped : 0), ++failed;
+			else if (bad)
+				printf("FAILED: %u vertices differ \n", bad), ++failed;
+			else
+				printf("\n");
+			a3demo_releaseSkinWeights(weights);
+		}
+	a3hierarchyRelease(hierarchy);
+	a3testInternalReleaseReference(ref);
+
+	// malformed and edge-case files
+	for (i = 0; i < sizeof(smallFiles) / sizeof(*smallFiles); ++i)
+	{
+		memset(weights, 0, sizeof(weights));
+		result = a3testInternalWriteFile(tmpPath, smallFiles[i].text) ?
+			a3demo_importSkinWeights(weights, tmpPath, 0, 4, a3demoSkinWeight_float, 0) : -2;
+		printf(" %-22s result %d ", smallFiles[i].name, result);
+		if (result != smallFiles[i].expect)
+			printf("FAILED: expected %d \n", smallFiles[i].expect), ++failed;
+		else
+			printf("\n");
+		a3demo_releaseSkinWeights(weights);
+	}
+	remove(tmpPath);
+
+	// every block was released
+	if (a3demo_getMemoryCounters()->bytesInUse != memoryStart.bytesInUse)
+		printf("\n FAILED: %lld bytes still in use \n", (long long)(a3demo_getMemoryCounters()->bytesInUse - memoryStart.bytesInUse)), ++failed;
+
+	printf("\n %u failed \n", failed);
+	return (int)failed;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,230 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_Test-tangentBasis.c
+	Test and benchmark of the threaded tangent basis generator.
+
+	Usage: animal3D-DemoPlugin-Test-tangentBasis [repeats]
+	Each mesh is a torus grid sized like a demo model (the egnaro and
+		teapot triangle counts) or larger; every other row has its own
+		copies of shared vertices so welding has work to do, texture
+		coordinates mirror halfway around so handedness flips, and the
+		last row has no texture area so degenerate faces are hit. Each
+		mesh is generated with one range, then with every thread count
+		up to the limit; the range count used must be the one asked for
+		(capped by the limit and mesh size) and the output must match
+		the single range bit for bit. Tangents must be unit length and
+		perpendicular to normals and bitangents. Best time of 'repeats'
+		runs is printed per thread count. Exit code is the number of
+		failed checks.
+*/
+
+// one unit with the code under test, so each inline library function 
+//	has a single definition
+#include "../_src/a3_DemoTangentBasis.c"
+
+// threads the generator launches, where the animal3D library is not built
+#include "a3_TestLibrary-animal3D.c"
+
+#include "../a3_DemoMemory.h"
+#include "../a3_DemoPlatform.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+
+// test mesh, tightly packed streams
+typedef struct a3_TestTangentMesh
+{
+	a3f32* position;
+	a3f32* normal;
+	a3f32* texcoord;
+	a3ui32* index;
+	a3ui32 vertexCount, triangleCount;
+} a3_TestTangentMesh;
+
+
+//-----------------------------------------------------------------------------
+
+// torus grid of about the given number of triangles
+a3ret a3testInternalCreateMesh(a3_TestTangentMesh* mesh_out, a3ui32 const triangleTarget)
+{
+	a3f64 const pi = 3.14159265358979323846;
+	a3ui32 const rows = (a3ui32)sqrt(triangleTarget / 4.0) + 1, cols = triangleTarget / (rows * 2) + 1;
+	a3ui32 const gridCount = (rows + 1) * (cols + 1);
+	a3ui32 r, c, i, k, v[4], * index;
+	a3f64 a, b, u;
+
+	// grid vertices, then copies of every corner of the odd rows
+	mesh_out->triangleCount = rows * cols * 2;
+	mesh_out->vertexCount = gridCount + rows / 2 * cols * 6;
+	mesh_out->position = (a3f32*)malloc(mesh_out->vertexCount * 3 * sizeof(a3f32));
+	mesh_out->normal = (a3f32*)malloc(mesh_out->vertexCount * 3 * sizeof(a3f32));
+	mesh_out->texcoord = (a3f32*)malloc(mesh_out->vertexCount * 2 * sizeof(a3f32));
+	mesh_out->index = index = (a3ui32*)malloc(mesh_out->triangleCount * 3 * sizeof(a3ui32));
+	if (!mesh_out->position || !mesh_out->normal || !mesh_out->texcoord || !index)
+		return 0;
+
+	for (r = 0, k = 0; r <= rows; ++r)
+		for (c = 0; c <= cols; ++c, ++k)
+		{
+			a = 2.0 * pi * r / rows;
+			b = 2.0 * pi * c / cols;
+			mesh_out->normal[k * 3 + 0] = (a3f32)(cos(a) * cos(b));
+			mesh_out->normal[k * 3 + 1] = (a3f32)(cos(a) * sin(b));
+			mesh_out->normal[k * 3 + 2] = (a3f32)(sin(a));
+			mesh_out->position[k * 3 + 0] = (a3f32)((1.0 + 0.25 * cos(a)) * cos(b));
+			mesh_out->position[k * 3 + 1] = (a3f32)((1.0 + 0.25 * cos(a)) * sin(b));
+			mesh_out->position[k * 3 + 2] = (a3f32)(0.25 * sin(a));
+			u = (a3f64)c / cols;
+			mesh_out->texcoord[k * 2 + 0] = (a3f32)(u < 0.5 ? u * 2.0 : 2.0 - u * 2.0);
+			mesh_out->texcoord[k * 2 + 1] = (a3f32)(r < rows ? (a3f64)r / rows : (a3f64)(rows - 1) / rows);
+		}
+
+	for (r = 0, i = 0; r < rows; ++r)
+		for (c = 0; c < cols; ++c)
+		{
+			v[0] = r * (cols + 1) + c;
+			v[1] = v[0] + 1;
+			v[2] = v[0] + cols + 1;
+			v[3] = v[2] + 1;
+			index[i++] = v[0], index[i++] = v[1], index[i++] = v[3];
+			index[i++] = v[0], index[i++] = v[3], index[i++] = v[2];
+		}
+
+	// odd rows get their own copies of the same vertices
+	for (r = 1, k = gridCount; r < rows; r += 2)
+		for (i = r * cols * 6; i < (r + 1) * cols * 6; ++i, ++k)
+		{
+			memcpy(mesh_out->position + k * 3, mesh_out->position + index[i] * 3, 3 * sizeof(a3f32));
+			memcpy(mesh_out->normal + k * 3, mesh_out->normal + index[i] * 3, 3 * sizeof(a3f32));
+			memcpy(mesh_out->texcoord + k * 2, mesh_out->texcoord + index[i] * 2, 2 * sizeof(a3f32));
+			index[i] = k;
+		}
+	mesh_out->vertexCount = k;
+	return 1;
+}
+
+void a3testInternalReleaseMesh(a3_TestTangentMesh* mesh)
+{
+	free(mesh->position);
+	free(mesh->normal);
+	free(mesh->texcoord);
+	free(mesh->index);
+}
+
+// count vertices whose basis is not orthonormal against the normal
+a3ui32 a3testInternalCountBadBasis(a3_TestTangentMesh const* mesh, a3f32 const* tangent, a3f32 const* bitangent)
+{
+	a3f32 const* t, * b, * n;
+	a3ui32 i, bad = 0;
+	for (i = 0; i < mesh->vertexCount; ++i)
+	{
+		t = tangent + i * 3;
+		b = bitangent + i * 3;
+		n = mesh->normal + i * 3;
+		if (fabs(t[0] * t[0] + t[1] * t[1] + t[2] * t[2] - 1.0) > 1.0e-4 ||
+			fabs(t[0] * n[0] + t[1] * n[1] + t[2] * n[2]) > 1.0e-4 ||
+			fabs(t[0] * b[0] + t[1] * b[1] + t[2] * b[2]) > 1.0e-4)
+			++bad;
+	}
+	return bad;
+}
+
+
+//-----------------------------------------------------------------------------
+
+int main(int const argc, char const* const argv[])
+{
+	// demo model sizes, then enough faces for every range to run
+	a3ui32 const triangleTargets[] = { 6792, 15704, a3demoTangentBasis_rangeMin * a3demoTangentBasis_threadMax };
+	a3ui32 const repeats = argc > 1 ? (a3ui32)atoi(argv[1]) : 10;
+	a3_DemoMemoryCounters const memoryStart = *a3demo_getMemoryCounters();
+	a3_TestTangentMesh mesh[1];
+	a3_DemoTangentBasisStats stats[1];
+	a3f32* tangent, * reference;
+	a3f64 best, time;
+	a3ui32 m, threads, expect, r, bad, failed = 0;
+	a3ret result;
+
+	for (m = 0; m < sizeof(triangleTargets) / sizeof(*triangleTargets); ++m)
+	{
+		memset(mesh, 0, sizeof(mesh));
+		tangent = reference = 0;
+		if (a3testInternalCreateMesh(mesh, triangleTargets[m]) <= 0 ||
+			!(tangent = (a3f32*)malloc(mesh->vertexCount * 6 * sizeof(a3f32))) ||
+			!(reference = (a3f32*)malloc(mesh->vertexCount * 6 * sizeof(a3f32))))
+		{
+			printf(" out of memory \n");
+			return (int)(failed + 1);
+		}
+		printf("\n %u vertices, %u triangles \n", mesh->vertexCount, mesh->triangleCount);
+
+		for (threads = 1; threads <= a3demoTangentBasis_threadMax; ++threads)
+		{
+			expect = (mesh->triangleCount > mesh->vertexCount ? mesh->triangleCount : mesh->vertexCount) / a3demoTangentBasis_rangeMin;
+			expect = threads < expect ? threads : expect ? expect : 1;
+			for (r = 0, best = 1.0e9, result = 1; r < repeats && result > 0; ++r)
+			{
+				memset(tangent, 0xff, mesh->vertexCount * 6 * sizeof(a3f32));
+				time = a3demo_getTime();
+				result = a3demo_calculateTangentBasis(tangent, tangent + mesh->vertexCount * 3,
+					mesh->position, mesh->normal, mesh->texcoord, mesh->vertexCount,
+					mesh->index, mesh->triangleCount, threads, stats);
+				time = a3demo_getTime() - time;
+				best = time < best ? time : best;
+			}
+
+			if (threads == 1)
+				memcpy(reference, tangent, mesh->vertexCount * 6 * sizeof(a3f32));
+			bad = a3testInternalCountBadBasis(mesh, tangent, tangent + mesh->vertexCount * 3);
+			printf("  %2u threads: %2u ranges, %8.3f ms (%u welded, %u degenerate) ",
+				threads, stats->threadCount, best * 1000.0, stats->weldedCount, stats->degenerateCount);
+			if (result <= 0)
+				printf("FAILED: result %d \n", result), ++failed;
+			else if (stats->threadCount != expect)
+				printf("FAILED: expected %u ranges \n", expect), ++failed;
+			else if (memcmp(tangent, reference, mesh->vertexCount * 6 * sizeof(a3f32)))
+				printf("FAILED: differs from one range \n"), ++failed;
+			else if (bad)
+				printf("FAILED: %u vertices not orthonormal \n", bad), ++failed;
+			else
+				printf("\n");
+		}
+
+		free(tangent);
+		free(reference);
+		a3testInternalReleaseMesh(mesh);
+	}
+
+	// every scratch block was released
+	if (a3demo_getMemoryCounters()->bytesInUse != memoryStart.bytesInUse)
+		printf("\n FAILED: %lld bytes still in use \n", (long long)(a3demo_getMemoryCounters()->bytesInUse - memoryStart.bytesInUse)), ++failed;
+
+	printf("\n %u failed \n", failed);
+	return (int)failed;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,41 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_TestLibrary-A3DM.c
+	A3DM for demo tests built where the prebuilt library is not available: 
+		one external definition of each closed-source A3DM function, 
+		taken from its implementation files.
+*/
+
+#include "animal3D-A3DM/animal3D-A3DM.h"
+
+#include "animal3D-A3DM/a3math/_inl/a3interpolation_impl.inl"
+#include "animal3D-A3DM/a3math/_inl/a3stats_impl.inl"
+#include "animal3D-A3DM/a3math/_inl/a3random_impl.inl"
+#include "animal3D-A3DM/a3math/_inl/a3sqrt_impl.inl"
+#include "animal3D-A3DM/a3math/_inl/a3trig_impl.inl"
+#include "animal3D-A3DM/a3math/_inl/a3vector2_impl.inl"
+#include "animal3D-A3DM/a3math/_inl/a3vector3_impl.inl"
+#include "animal3D-A3DM/a3math/_inl/a3vector4_impl.inl"
+#include "animal3D-A3DM/a3math/_inl/a3matrix2_impl.inl"
+#include "animal3D-A3DM/a3math/_inl/a3matrix3_impl.inl"
+#include "animal3D-A3DM/a3math/_inl/a3matrix4_impl.inl"
+#include "animal3D-A3DM/a3math/_inl/a3quaternion_impl.inl"
+#include "animal3D-A3DM/a3math/_inl/a3dualquaternion_impl.inl"
@@ -0,0 +1,158 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_TestLibrary-animal3D.c
+	animal3D functions for demo tests built where the prebuilt library is
+		not available: threads on pthreads and geometry formats with the
+		library's attribute types. Included by the test unit rather than
+		linked, because animal3D headers define their inline functions in
+		every unit that includes them.
+*/
+
+#ifndef _WIN32
+
+#include "animal3D/a3utility/a3_Thread.h"
+#include "animal3D/a3geometry/a3_GeometryData.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+
+//-----------------------------------------------------------------------------
+
+// threads run on pthreads
+static void* a3testInternalThreadEntry(void* args)
+{
+	a3_Thread* thread = (a3_Thread*)args;
+	thread->inThreadFunc = 1;
+	thread->result = thread->threadFunc(thread->threadArgs);
+	thread->inThreadFunc = 0;
+	return 0;
+}
+
+a3ret a3threadLaunch(a3_Thread* thread_out, a3_threadfunc func, void* args_opt, a3byte* name_opt)
+{
+	pthread_t* handle;
+	if (thread_out && func)
+	{
+		if (thread_out->threadID)
+			return 0;
+		if (!(handle = (pthread_t*)malloc(sizeof(pthread_t))))
+			return 0;
+		thread_out->handle[0] = handle;
+		thread_out->threadFunc = func;
+		thread_out->threadArgs = args_opt;
+		thread_out->threadName = name_opt;
+		thread_out->threadID = 1;
+		if (pthread_create(handle, 0, a3testInternalThreadEntry, thread_out) == 0)
+			return 1;
+		free(handle);
+		thread_out->handle[0] = 0;
+		thread_out->threadID = 0;
+		return 0;
+	}
+	return -1;
+}
+
+a3ret a3threadWait(a3_Thread* thread)
+{
+	if (thread && thread->handle[0])
+	{
+		pthread_join(*(pthread_t*)thread->handle[0], 0);
+		free(thread->handle[0]);
+		thread->handle[0] = 0;
+		thread->threadID = 0;
+		return 1;
+	}
+	return -1;
+}
+
+a3ret a3threadInternalGetID()
+{
+	return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+
+// geometry attributes are float vectors, except blend indices; tangents
+//	and blending add a second attribute
+a3ret a3geometryCreateVertexFormat(a3_VertexFormatDescriptor* vertexFormat_out, const a3_GeometryVertexAttributeName* attribNameList, a3ui32 attribNameCount)
+{
+	static const struct {
+		a3_VertexAttributeName name, nameSecond;
+		a3_VertexAttributeType type, typeSecond;
+	} attrib[a3attrib_geomNameMax] = {
+		{ a3attrib_position, a3attrib_position, a3attrib_vec3, a3attrib_disable },
+		{ a3attrib_normal, a3attrib_normal, a3attrib_vec3, a3attrib_disable },
+		{ a3attrib_color, a3attrib_color, a3attrib_vec4, a3attrib_disable },
+		{ a3attrib_texcoord, a3attrib_texcoord, a3attrib_vec2, a3attrib_disable },
+		{ a3attrib_tangent, a3attrib_bitangent, a3attrib_vec3, a3attrib_vec3 },
+		{ a3attrib_blendWeights, a3attrib_blendIndices, a3attrib_vec4, a3attrib_ivec4 },
+	};
+	a3_VertexAttributeName name;
+	a3_VertexAttributeType type;
+	a3ui32 i, k, size;
+	if (vertexFormat_out && attribNameList && attribNameCount && attribNameCount <= a3attrib_geomNameMax)
+	{
+		memset(vertexFormat_out, 0, sizeof(a3_VertexFormatDescriptor));
+		for (i = 0; i < attribNameCount; ++i)
+		{
+			if ((a3ui32)attribNameList[i] >= a3attrib_geomNameMax)
+				return -1;
+			for (k = 0; k < 2; ++k)
+			{
+				name = k ? attrib[attribNameList[i]].nameSecond : attrib[attribNameList[i]].name;
+				type = k ? attrib[attribNameList[i]].typeSecond : attrib[attribNameList[i]].type;
+				if (type == a3attrib_disable || vertexFormat_out->attribType[name] != a3attrib_disable)
+					continue;
+				size = a3vertexAttribGetElementsPerAttrib(type) * a3vertexAttribGetBytesPerElement(type);
+				vertexFormat_out->attribType[name] = (a3ui16)type;
+				vertexFormat_out->attribOffset[name] = vertexFormat_out->vertexSize;
+				vertexFormat_out->attribElements[name] = (a3ubyte)a3vertexAttribGetElementsPerAttrib(type);
+				vertexFormat_out->attribSize[name] = (a3ubyte)size;
+				vertexFormat_out->vertexSize += (a3ui16)size;
+				++vertexFormat_out->vertexNumAttribs;
+			}
+		}
+		return vertexFormat_out->vertexNumAttribs;
+	}
+	return -1;
+}
+
+// smallest index type that can refer to every vertex
+a3ret a3geometryCreateIndexFormat(a3_IndexFormatDescriptor* indexFormat_out, const a3ui32 vertexCount)
+{
+	a3_IndexType type;
+	if (indexFormat_out && vertexCount)
+	{
+		type = vertexCount <= a3index_countMaxByte ? a3index_byte : vertexCount <= a3index_countMaxShort ? a3index_short : a3index_int;
+		indexFormat_out->indexType = (a3ui16)type;
+		indexFormat_out->indexSize = (a3ui16)a3indexGetBytesPerIndex(type);
+		return type;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+#endif	// !_WIN32
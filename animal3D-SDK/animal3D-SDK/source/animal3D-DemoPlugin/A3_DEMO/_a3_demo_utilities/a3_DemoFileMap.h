@@ -0,0 +1,74 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoFileMap.h
+	Read-only file mapping; falls back to reading the whole file into a
+		heap block where mapping is unavailable.
+*/
+
+#ifndef __ANIMAL3D_DEMOFILEMAP_H
+#define __ANIMAL3D_DEMOFILEMAP_H
+
+
+#include "animal3D/a3/a3config.h"
+#include "animal3D/a3/a3types_integer.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef struct a3_DemoFileMap	a3_DemoFileMap;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// mapped view of file contents
+	struct a3_DemoFileMap
+	{
+		a3byte const* data;						// first byte of file; null if not mapped
+		a3size size;							// file size in bytes
+		void* handle[2];						// platform handles (file, mapping)
+		a3boolean mapped;						// data is a mapped view, not a heap copy
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// map whole file for reading; map_out must be zeroed or unmapped
+	//	returns 1 if mapped, 0 if file could not be opened or was empty, -1 if invalid
+	a3ret a3demo_mapFile(a3_DemoFileMap* map_out, a3byte const* filePath);
+
+	// release view and handles; resets map
+	a3ret a3demo_unmapFile(a3_DemoFileMap* map);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOFILEMAP_H
@@ -0,0 +1,175 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoGeometryCache.h
+	Versioned geometry cache file: a header, a table of contents with one
+		entry per named shape, then one aligned blob per shape holding its
+		vertex streams and indices, plus an optional caller-defined block
+		(such as a level of detail table) kept with the shape. The file is memory-mapped and cached
+		geometry points straight into the mapping, so it can be uploaded
+		without copying. Each entry carries a key hashed from everything
+		that produced it (source file contents, descriptors, settings);
+		entries whose key no longer matches are rebuilt by the caller and
+		only their blobs and the table of contents are written; the file
+		is rewritten whole when shapes are added or dropped.
+*/
+
+#ifndef __ANIMAL3D_DEMOGEOMETRYCACHE_H
+#define __ANIMAL3D_DEMOGEOMETRYCACHE_H
+
+
+#include "animal3D/a3/a3types_integer.h"
+#include "animal3D/a3/a3types_real.h"
+#include "animal3D/a3geometry/a3_GeometryData.h"
+
+#include "a3_DemoFileMap.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef struct a3_DemoGeometryCacheHeader	a3_DemoGeometryCacheHeader;
+	typedef struct a3_DemoGeometryCacheEntry	a3_DemoGeometryCacheEntry;
+	typedef struct a3_DemoGeometryCacheItem		a3_DemoGeometryCacheItem;
+	typedef struct a3_DemoGeometryCache			a3_DemoGeometryCache;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// cache limits
+	enum a3_DemoGeometryCacheLimit
+	{
+		a3demoGeometryCache_magic = 0x43473341,	// "A3GC"
+		a3demoGeometryCache_version = 2,		// bump when file layout or shape processing changes
+		a3demoGeometryCache_entryMax = 64,		// most shapes in one cache
+		a3demoGeometryCache_nameMax = 32,		// entry name length, including terminator
+		a3demoGeometryCache_align = 64,			// blob alignment in file (bytes)
+	};
+
+	// starting value for key hashing
+#define a3demoGeometryCache_keyStart	0xcbf29ce484222325ull
+
+	// file header
+	struct a3_DemoGeometryCacheHeader
+	{
+		a3ui32 magic, version;					// identify file and layout
+		a3ui32 entryCount, entrySize;			// table of contents follows header
+		a3ui64 fileSize;						// total bytes, catches truncation
+		a3ui64 tocHash;							// hash of table of contents
+	};
+
+	// table of contents entry; offsets of streams and extra block are
+	//	relative to blob, or ~0 if absent
+	struct a3_DemoGeometryCacheEntry
+	{
+		a3byte name[a3demoGeometryCache_nameMax];
+		a3ui64 key;								// hash of everything that produced blob
+		a3ui64 offset, size;					// blob location in file
+		a3_VertexFormatDescriptor vertexFormat[1];
+		a3_IndexFormatDescriptor indexFormat[1];
+		a3ui32 primType, numVertices, numIndices;
+		a3ui32 attribOffset[a3attrib_geomNameMax];
+		a3ui32 indexOffset;
+		a3ui32 extraOffset, extraSize;			// caller-defined block
+	};
+
+	// shape recorded for the next write
+	struct a3_DemoGeometryCacheItem
+	{
+		a3byte name[a3demoGeometryCache_nameMax];
+		a3ui64 key;
+		a3_GeometryData const* geom;
+		void const* extra;
+		a3ui32 extraSize;
+		a3boolean fetched;						// geometry points into mapping
+	};
+
+	// open cache
+	struct a3_DemoGeometryCache
+	{
+		a3byte filePath[256];
+		a3_DemoFileMap map[1];					// current file, if valid
+		a3_DemoGeometryCacheHeader const* header;
+		a3_DemoGeometryCacheEntry const* toc;
+		a3_DemoGeometryCacheItem item[a3demoGeometryCache_entryMax];
+		a3ui32 itemCount;						// shapes fetched or stored
+		a3ui32 fetchCount;						// shapes served from mapping
+		a3ui32 rebuildCount;					// shapes stored after rebuild
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// continue key hash with bytes (FNV-1a); start from keyStart
+	a3ui64 a3demo_hashGeometryKey(a3ui64 const key, void const* data, a3size const size);
+
+	// continue key hash with contents of source file; returns 1 if file
+	//	was read, 0 if it could not be read (key is still changed), -1 if
+	//	invalid
+	a3ret a3demo_hashGeometrySource(a3ui64* key_inout, a3byte const* filePath);
+
+	// open cache file and map it; a missing, old or damaged file leaves
+	//	an empty cache that will be rewritten; returns 1 if file mapped,
+	//	0 if empty, -1 if invalid
+	a3ret a3demo_openGeometryCache(a3_DemoGeometryCache* cache, a3byte const* filePath);
+
+	// get named shape if its key matches; geometry (data pointer too)
+	//	points into mapping, is read-only, stays valid until cache is
+	//	closed and must not be released (see below); extra block is copied
+	//	out and must have the size it was stored with (zero if none);
+	//	returns 1 if found, 0 if stale or missing (build it and store it),
+	//	-1 if invalid
+	a3ret a3demo_fetchGeometryCache(a3_DemoGeometryCache* cache, a3_GeometryData* geom_out, a3byte const* name, a3ui64 const key,
+		void* extra_out_opt, a3ui32 const extraSize);
+
+	// record rebuilt shape and optional extra block for writing; both
+	//	must stay valid until cache is closed; returns 1 if recorded, 0 if
+	//	cache is not open or full, -1 if invalid
+	a3ret a3demo_storeGeometryCache(a3_DemoGeometryCache* cache, a3_GeometryData const* geom, a3byte const* name, a3ui64 const key,
+		void const* extra_opt, a3ui32 const extraSize);
+
+	// check whether geometry was fetched from cache, so its data belongs
+	//	to the mapping and is not released; still answers after closing;
+	//	returns 1 if fetched, 0 if not, -1 if invalid
+	a3ret a3demo_isGeometryCached(a3_DemoGeometryCache const* cache, a3_GeometryData const* geom);
+
+	// write rebuilt shapes and contents, or whole file if shapes were 
+	//	added or dropped, then unmap; call after fetched geometry has 
+	//	been uploaded; returns 1 if written, 0 if unchanged or not open, 
+	//	-1 if invalid or write failed
+	a3ret a3demo_closeGeometryCache(a3_DemoGeometryCache* cache);
+
+	// print cache report to stdout
+	void a3demo_printGeometryCache(a3_DemoGeometryCache const* cache);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOGEOMETRYCACHE_H
@@ -0,0 +1,119 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoGeometryLOD.h
+	Level of detail chain for indexed triangle geometry: each level is a
+		simplified index list appended after the full-detail indices, so
+		all levels draw from the same vertices and differ only in index
+		range. Simplification collapses edges onto existing vertices in
+		order of quadric error (Garland and Heckbert 1997), with changes
+		in normal and texture coordinate added to the cost; borders only
+		collapse along themselves and seams stay fixed. Levels are picked
+		at draw time by how many pixels their error covers on screen.
+*/
+
+#ifndef __ANIMAL3D_DEMOGEOMETRYLOD_H
+#define __ANIMAL3D_DEMOGEOMETRYLOD_H
+
+
+#include "animal3D/a3/a3types_integer.h"
+#include "animal3D/a3/a3types_real.h"
+#include "animal3D/a3geometry/a3_GeometryData.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef struct a3_DemoGeometryLOD		a3_DemoGeometryLOD;
+	typedef struct a3_DemoGeometryLODStats	a3_DemoGeometryLODStats;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// LOD limits
+	enum a3_DemoGeometryLODLimit
+	{
+		a3demoGeometryLOD_max = 4,				// most levels, including full detail
+	};
+
+	// weight of normal and texcoord change against surface distance
+#define a3demoGeometryLOD_attribWeight	0.01f
+
+	// on-screen error allowed when selecting level (pixels)
+#define a3demoGeometryLOD_pixelError	1.0f
+
+	// level table; level 0 is full detail
+	struct a3_DemoGeometryLOD
+	{
+		a3ui32 levelCount;
+		a3ui32 first[a3demoGeometryLOD_max];	// first index of level
+		a3ui32 count[a3demoGeometryLOD_max];	// indices in level
+		a3f32 error[a3demoGeometryLOD_max];		// largest surface deviation (object units)
+	};
+
+	// simplification report
+	struct a3_DemoGeometryLODStats
+	{
+		a3ui32 levelCount;
+		a3ui32 triangleCount[a3demoGeometryLOD_max];
+		a3f32 error[a3demoGeometryLOD_max];
+		a3ui32 passCount;						// collapse passes over all levels
+		a3f64 time;								// seconds to build chain
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// append simplified levels to indexed triangle geometry; ratios are
+	//	triangle counts relative to full detail, decreasing; each level is
+	//	simplified from the one before it and stops early if no edge can
+	//	collapse; positions must be float and packed normals or texcoords
+	//	are left out of the cost (run before packing); returns number of
+	//	levels including full detail, 0 if geometry is not an indexed
+	//	triangle list or memory ran out, -1 if invalid
+	a3ret a3demo_generateGeometryLOD(a3_GeometryData* geom, a3_DemoGeometryLOD* lod_out, a3f32 const* ratios, a3ui32 const ratioCount,
+		a3f32 const attribWeight, a3_DemoGeometryLODStats* stats_out_opt);
+
+	// pixels covered by one object unit at object origin, from column-
+	//	major model-view-projection matrix and viewport size; returns zero
+	//	if origin is behind viewer
+	a3f32 a3demo_projectGeometryLODScale(a3real const* mvp, a3ui32 const viewportWidth, a3ui32 const viewportHeight);
+
+	// coarsest level whose error covers no more than pixel error at scale;
+	//	scale of zero selects full detail
+	a3ui32 a3demo_selectGeometryLOD(a3_DemoGeometryLOD const* lod, a3f32 const pixelScale, a3f32 const pixelError);
+
+	// print simplification report to stdout
+	void a3demo_printGeometryLODStats(a3_DemoGeometryLODStats const* stats, a3byte const* name);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOGEOMETRYLOD_H
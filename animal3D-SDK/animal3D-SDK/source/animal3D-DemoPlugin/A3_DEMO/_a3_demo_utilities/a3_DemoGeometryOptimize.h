@@ -0,0 +1,103 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoGeometryOptimize.h
+	Index and vertex order optimization for indexed triangle geometry
+		before it is uploaded:
+		1. post-transform vertex cache: triangles reordered by Tipsify
+			(Sander, Nehab and Barczak 2007)
+		2. overdraw: the cache-friendly order is cut into clusters whose
+			cache efficiency stays within a threshold of the whole, then
+			clusters are sorted so outward-facing ones on the outside of
+			the mesh draw first
+		3. vertex fetch: vertices renumbered in order of first use so
+			attribute reads walk memory forward
+	Geometry that is not an indexed triangle list is left untouched.
+*/
+
+#ifndef __ANIMAL3D_DEMOGEOMETRYOPTIMIZE_H
+#define __ANIMAL3D_DEMOGEOMETRYOPTIMIZE_H
+
+
+#include "animal3D/a3/a3types_integer.h"
+#include "animal3D/a3/a3types_real.h"
+#include "animal3D/a3geometry/a3_GeometryData.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef struct a3_DemoGeometryOptimizeStats	a3_DemoGeometryOptimizeStats;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// defaults
+	enum a3_DemoGeometryOptimizeDefault
+	{
+		a3demoGeometryOptimize_cacheSize = 16,	// post-transform cache entries (FIFO)
+	};
+
+	// cluster may be this much worse than whole order before it is cut
+#define a3demoGeometryOptimize_overdrawThreshold	1.05f
+
+	// optimization report; ACMR is cache misses per triangle (0.5 ideal
+	//	for large meshes, 3 worst), ATVR is misses per vertex (1 ideal)
+	struct a3_DemoGeometryOptimizeStats
+	{
+		a3ui32 vertexCount, triangleCount;		// sizes of geometry
+		a3ui32 clusterCount;					// clusters sorted for overdraw
+		a3f64 acmrBefore, acmrAfter;			// average cache miss ratio
+		a3f64 atvrBefore, atvrAfter;			// average transform to vertex ratio
+		a3boolean optimized;					// geometry was an indexed triangle list
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// measure FIFO cache misses of triangle list; outputs optional
+	//	returns number of misses
+	a3ui32 a3demo_measureVertexCache(a3ui32 const* index, a3ui32 const indexCount, a3ui32 const vertexCount, a3ui32 const cacheSize,
+		a3f64* acmr_out_opt, a3f64* atvr_out_opt);
+
+	// reorder indices and vertices of geometry in place; threshold of zero
+	//	keeps Tipsify order without overdraw sort; returns 1 if optimized,
+	//	0 if geometry is not an indexed triangle list or memory ran out,
+	//	-1 if invalid
+	a3ret a3demo_optimizeGeometry(a3_GeometryData* geom, a3ui32 const cacheSize, a3f32 const overdrawThreshold,
+		a3_DemoGeometryOptimizeStats* stats_out_opt);
+
+	// print optimization report to stdout
+	void a3demo_printGeometryOptimizeStats(a3_DemoGeometryOptimizeStats const* stats, a3byte const* name);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOGEOMETRYOPTIMIZE_H
@@ -0,0 +1,105 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoMemory.h
+	Block allocation with heap call counters; the counters see only the 
+		heap calls made through these functions (blocks from malloc, such 
+		as geometry data released by the library, are not counted).
+*/
+
+#ifndef __ANIMAL3D_DEMOMEMORY_H
+#define __ANIMAL3D_DEMOMEMORY_H
+
+
+#include "animal3D/a3/a3config.h"
+#include "animal3D/a3/a3types_integer.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef struct a3_DemoMemoryCounters	a3_DemoMemoryCounters;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// default block alignment (cache line)
+	enum a3_DemoMemoryAlignment
+	{
+		a3demoMemory_alignment = 64,
+	};
+
+	// running totals of heap calls made through demo allocators; kept 
+	//	exactly when blocks are allocated on worker threads too
+	struct a3_DemoMemoryCounters
+	{
+		a3i64 allocCount;						// number of blocks allocated
+		a3i64 releaseCount;						// number of blocks released
+		a3i64 bytesInUse;						// bytes currently requested
+		a3i64 bytesPeak;						// highest bytes in use
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// round size or offset up to multiple of alignment (power of two)
+#define a3demo_alignSize(size, alignment)	(((size) + (alignment) - 1) & ~((a3size)(alignment) - 1))
+
+	// allocate block with start aligned to power-of-two boundary
+	void* a3demo_allocAligned(a3size const size, a3size const alignment);
+
+	// release block from aligned allocator; returns -1 for null
+	a3i32 a3demo_releaseAligned(void* block);
+
+	// allocate block aligned like malloc; size zero still gets a block, 
+	//	so null always means out of memory
+	void* a3demo_alloc(a3size const size);
+
+	// allocate block as above, cleared to zero
+	void* a3demo_allocZero(a3size const size);
+
+	// resize block from a3demo_alloc, keeping contents up to the smaller 
+	//	size (null block allocates); old block is released only if the 
+	//	new one was allocated, so null leaves it valid
+	void* a3demo_resize(void* block, a3size const size);
+
+	// release block from either allocator; returns -1 for null
+	a3i32 a3demo_release(void* block);
+
+	// current counter values
+	a3_DemoMemoryCounters const* a3demo_getMemoryCounters(void);
+
+	// number of heap calls (allocations and releases) since counters were captured
+	a3i64 a3demo_getMemoryCallsSince(a3_DemoMemoryCounters const* snapshot);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOMEMORY_H
@@ -0,0 +1,159 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoMeshlet.h
+	Meshlets (small clusters of triangles) for CPU culling: triangles of
+		indexed geometry are ordered so each meshlet is a run of indices,
+		grown from neighboring triangles up to a vertex and triangle
+		limit. Every meshlet keeps its own vertex list with small local
+		indices, a bounding sphere and a cone holding its face normals.
+		Meshlets outside the view frustum or facing away from the viewer
+		are skipped and the rest are drawn as a few index ranges of the
+		original drawable.
+*/
+
+#ifndef __ANIMAL3D_DEMOMESHLET_H
+#define __ANIMAL3D_DEMOMESHLET_H
+
+
+#include "animal3D/a3/a3types_integer.h"
+#include "animal3D/a3/a3types_real.h"
+#include "animal3D/a3geometry/a3_GeometryData.h"
+
+#include "animal3D-A3DG/a3graphics/a3_VertexDrawable.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef struct a3_DemoMeshlet			a3_DemoMeshlet;
+	typedef struct a3_DemoMeshletSet		a3_DemoMeshletSet;
+	typedef struct a3_DemoMeshletStats		a3_DemoMeshletStats;
+	typedef struct a3_DemoMeshletCullStats	a3_DemoMeshletCullStats;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// meshlet limits
+	enum a3_DemoMeshletLimit
+	{
+		a3demoMeshlet_vertexMax = 64,			// vertices per meshlet (8-bit local indices)
+		a3demoMeshlet_triangleMax = 124,		// triangles per meshlet
+	};
+
+	// weight of normal change against new vertices when growing meshlets
+#define a3demoMeshlet_coneWeight	1.0f
+
+	// one cluster of consecutive triangles
+	struct a3_DemoMeshlet
+	{
+		a3ui32 vertexOffset, vertexCount;		// range in set's vertex list
+		a3ui32 triangleOffset, triangleCount;	// range in local indices and geometry's triangles
+		a3f32 center[3], radius;				// bounding sphere
+		a3f32 coneAxis[3], coneCutoff;			// average face normal and sine of widest angle from it; 1 if never culled
+		a3f32 coneApex[3];						// point behind every face on axis
+	};
+
+	// meshlets of one geometry
+	struct a3_DemoMeshletSet
+	{
+		a3_DemoMeshlet* meshlet;
+		a3ui32* vertex;							// geometry vertex of each meshlet vertex
+		void* localIndex;						// three per triangle into meshlet's vertices
+		a3ui32* range;							// visible index ranges from last cull: first, count
+		a3_IndexFormatDescriptor localIndexFormat[1];
+		a3ui32 meshletCount, vertexCount, triangleCount;
+		a3ui32 drawIndexSize;					// bytes per index of drawable
+		void* data;
+	};
+
+	// build report
+	struct a3_DemoMeshletStats
+	{
+		a3ui32 meshletCount, triangleCount;
+		a3ui32 vertexCount;						// meshlet vertices; shared vertices counted once per meshlet
+		a3ui32 localIndexSize;					// bytes per local index
+		a3f32 fillVertex, fillTriangle;			// average fraction of limits used
+		a3f64 time;								// seconds to describe
+	};
+
+	// cull report
+	struct a3_DemoMeshletCullStats
+	{
+		a3ui32 meshletCount;
+		a3ui32 frustumCount, coneCount;			// meshlets culled by each test
+		a3ui32 rangeCount;						// draw calls made for visible meshlets
+		a3ui32 triangleCount, triangleTotal;	// triangles submitted and in geometry
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// order first triangles of indexed triangle geometry (index count of
+	//	zero for all) so that runs of at most vertex and triangle limit
+	//	share vertices; each run is grown from triangles touching it that
+	//	add fewest vertices, with turning away from the run's normal
+	//	weighted by cone weight (tighter cones cull more), and falls back
+	//	to the next unused triangle in existing order; geometry must own
+	//	its data and have float positions; returns number of runs, 0 if
+	//	not an indexed triangle list or memory ran out, -1 if invalid
+	a3ret a3demo_orderGeometryMeshlets(a3_GeometryData* geom, a3ui32 const indexCount, a3ui32 const maxVertices, a3ui32 const maxTriangles, a3f32 const coneWeight);
+
+	// describe meshlets of ordered geometry (from cache too): consecutive
+	//	triangles are taken while they fit the limits; local index size
+	//	is picked from vertex limit like any index format; positions must
+	//	be float; draw index format is the one indices were uploaded with
+	//	if not geometry's own; returns meshlet count, 0 if geometry is not
+	//	an indexed triangle list or memory ran out, -1 if invalid
+	a3ret a3demo_createGeometryMeshlets(a3_DemoMeshletSet* set_out, a3_GeometryData const* geom, a3ui32 const indexCount,
+		a3ui32 const maxVertices, a3ui32 const maxTriangles, a3_IndexFormatDescriptor const* drawIndexFormat_opt, a3_DemoMeshletStats* stats_out_opt);
+
+	// release meshlets
+	a3ret a3demo_releaseGeometryMeshlets(a3_DemoMeshletSet* set);
+
+	// cull meshlets against frustum of column-major model-view-projection
+	//	matrix and against viewer position in object space, then store
+	//	index ranges of the rest in set, joining neighbors; returns range
+	//	count, -1 if invalid
+	a3ret a3demo_cullGeometryMeshlets(a3_DemoMeshletSet* set, a3real const* mvp, a3real const* viewPosition, a3_DemoMeshletCullStats* stats_out_opt);
+
+	// draw ranges from last cull with drawable made for whole geometry
+	//	(index ranges are relative to its first index); returns ranges
+	//	drawn, -1 if invalid
+	a3ret a3demo_renderGeometryMeshlets(a3_DemoMeshletSet const* set, a3_VertexDrawable const* drawable, a3ui32 const rangeCount);
+
+	// print reports to stdout
+	void a3demo_printMeshletStats(a3_DemoMeshletStats const* stats, a3byte const* name);
+	void a3demo_printMeshletCullStats(a3_DemoMeshletCullStats const* stats, a3byte const* name);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOMESHLET_H
@@ -0,0 +1,96 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoModelLoader.h
+	Parallel Wavefront OBJ loader: the file is mapped and split into
+		line-aligned chunks that are parsed on worker threads, then the
+		per-chunk streams are merged into one geometry data block.
+		Accepts the same flags and transform as a3modelLoadOBJ; polygons
+		with any number of sides are fan-triangulated.
+*/
+
+#ifndef __ANIMAL3D_DEMOMODELLOADER_H
+#define __ANIMAL3D_DEMOMODELLOADER_H
+
+
+#include "animal3D/a3/a3types_integer.h"
+#include "animal3D/a3/a3types_real.h"
+#include "animal3D/a3geometry/a3_GeometryData.h"
+#include "animal3D/a3geometry/a3_ModelLoader_WavefrontOBJ.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef struct a3_DemoModelLoadStats	a3_DemoModelLoadStats;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// loader limits
+	enum a3_DemoModelLoaderLimit
+	{
+		a3demoModelLoader_threadMax = 16,		// most chunks parsed at once
+		a3demoModelLoader_chunkMin = 1 << 16,	// smallest chunk worth a thread (bytes)
+	};
+
+	// load report
+	struct a3_DemoModelLoadStats
+	{
+		a3size fileSize;						// bytes parsed
+		a3f64 parseTime;						// seconds spent mapping and parsing chunks
+		a3f64 mergeTime;						// seconds spent merging and building vertices
+		a3f64 tangentTime;						// part of merge spent on tangent bases
+		a3f64 totalTime;						// seconds for whole load
+		a3f64 megabytesPerSecond;				// file size over total time
+		a3ui32 threadCount;						// chunks parsed in parallel
+		a3ui32 positionCount, texcoordCount, normalCount;	// 'v', 'vt', 'vn' records
+		a3ui32 polygonCount;					// 'f' records with at least three corners
+		a3ui32 ngonCount;						// polygons with more than four corners
+		a3ui32 triangleCount;					// triangles after fan triangulation
+		a3ui32 vertexCount;						// unique vertices after merge
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// load OBJ file into geometry data; flags and transform as a3modelLoadOBJ;
+	//	thread count zero uses all hardware threads; geometry is released with
+	//	a3geometryReleaseData; returns 1 if loaded, 0 if failed, -1 if invalid
+	a3ret a3demo_loadModelOBJ(a3_GeometryData* geom_out, a3byte const* filePath, a3_ModelLoaderFlag const flags, a3f32 const* transform_opt,
+		a3ui32 const threadCount, a3_DemoModelLoadStats* stats_out_opt);
+
+	// print load report to stdout
+	void a3demo_printModelLoadStats(a3_DemoModelLoadStats const* stats, a3byte const* filePath);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOMODELLOADER_H
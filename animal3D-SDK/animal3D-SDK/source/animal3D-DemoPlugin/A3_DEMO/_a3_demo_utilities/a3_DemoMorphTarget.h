@@ -0,0 +1,153 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoMorphTarget.h
+	CPU morph targets: each target keeps only the vertices whose position
+		or normal differs from the base, as 16-bit deltas scaled per
+		target. Weighted targets are added to the base a chunk of
+		vertices at a time with SIMD, on worker threads if asked, and
+		whole vertices in the base's vertex format are written straight
+		into a mapped vertex buffer, so nothing but the result is
+		uploaded.
+*/
+
+#ifndef __ANIMAL3D_DEMOMORPHTARGET_H
+#define __ANIMAL3D_DEMOMORPHTARGET_H
+
+
+#include "animal3D/a3/a3types_integer.h"
+#include "animal3D/a3/a3types_real.h"
+#include "animal3D/a3geometry/a3_GeometryData.h"
+
+#include "animal3D-A3DG/a3graphics/a3_VertexBuffer.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef struct a3_DemoMorphTarget		a3_DemoMorphTarget;
+	typedef struct a3_DemoMorphSet			a3_DemoMorphSet;
+	typedef struct a3_DemoMorphStats		a3_DemoMorphStats;
+	typedef struct a3_DemoMorphBlendStats	a3_DemoMorphBlendStats;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// morph limits
+	enum a3_DemoMorphLimit
+	{
+		a3demoMorph_targetMax = 8,				// most targets per set
+		a3demoMorph_threadMax = 16,				// most ranges blended at once
+		a3demoMorph_rangeMin = 1 << 14,			// fewest vertices worth a thread
+		a3demoMorph_chunkSize = 64,				// vertices blended before writing out
+		a3demoMorph_vertexSizeMax = 256,		// largest vertex in bytes
+	};
+
+	// one target: changed vertices in ascending order
+	struct a3_DemoMorphTarget
+	{
+		a3ui32* vertex;							// index of each changed vertex
+		a3i16* delta;							// eight per changed vertex: position xyz, 0, normal xyz, 0
+		a3f32 positionScale, normalScale;		// delta value of one step
+		a3ui32 count;							// changed vertices
+	};
+
+	// base and targets of one morphing geometry
+	struct a3_DemoMorphSet
+	{
+		a3_DemoMorphTarget target[a3demoMorph_targetMax];
+		a3f32* base;							// eight per vertex: position xyz, 0, normal xyz, 0
+		a3ubyte* vertexData;					// base vertices in base vertex format
+		a3ui32 targetCount, vertexCount;
+		a3ui32 vertexSize;						// bytes per vertex written
+		a3ui32 positionOffset, normalOffset;	// bytes into vertex; normal offset is vertex size if no normals
+		void* data;
+	};
+
+	// build report
+	struct a3_DemoMorphStats
+	{
+		a3ui32 vertexCount, targetCount;
+		a3ui32 changedCount[a3demoMorph_targetMax];	// vertices stored per target
+		a3size deltaSize;						// bytes of stored deltas and indices
+		a3size denseSize;						// bytes as float deltas of every vertex
+		a3f32 positionError;					// largest position difference from quantizing
+		a3f64 time;								// seconds to build
+	};
+
+	// blend report
+	struct a3_DemoMorphBlendStats
+	{
+		a3ui32 vertexCount;
+		a3ui32 targetCount;						// targets with nonzero weight
+		a3ui32 deltaCount;						// changed vertices added
+		a3ui32 threadCount;						// ranges run in parallel
+		a3f64 time;								// seconds to blend and write
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// build set from base geometry and targets with the same vertices in
+	//	the same order (e.g. loaded from matching files); positions and
+	//	normals (if base has them) must be float in every geometry, which
+	//	must own its data; targets only need positions and normals, other
+	//	attributes always come from base; returns target count, 0 if
+	//	geometries do not match or memory ran out, -1 if invalid
+	a3ret a3demo_createMorphSet(a3_DemoMorphSet* set_out, a3_GeometryData const* base,
+		a3_GeometryData const* targets, a3ui32 const targetCount, a3_DemoMorphStats* stats_out_opt);
+
+	// release set
+	a3ret a3demo_releaseMorphSet(a3_DemoMorphSet* set);
+
+	// blend base and targets with one weight per target into whole
+	//	vertices in base vertex format; targets with zero weight are
+	//	skipped and normals are renormalized; output is written in order
+	//	and never read, so it may be mapped buffer memory; thread count
+	//	zero uses all hardware threads; returns vertices written, -1 if
+	//	invalid
+	a3ret a3demo_blendMorphTargets(void* vertex_out, a3_DemoMorphSet const* set, a3f32 const* weights,
+		a3ui32 const threadCount, a3_DemoMorphBlendStats* stats_out_opt);
+
+	// map vertices of buffer (uploaded from base geometry, first vertex
+	//	at offset in bytes) for writing, blend into them and unmap; must
+	//	be called with a current rendering context; returns vertices
+	//	written, 0 if buffer could not be mapped, -1 if invalid
+	a3ret a3demo_uploadMorphTargets(a3_VertexBuffer* vertexBuffer, a3ui32 const offset, a3_DemoMorphSet const* set, a3f32 const* weights,
+		a3ui32 const threadCount, a3_DemoMorphBlendStats* stats_out_opt);
+
+	// print reports to stdout
+	void a3demo_printMorphStats(a3_DemoMorphStats const* stats, a3byte const* name);
+	void a3demo_printMorphBlendStats(a3_DemoMorphBlendStats const* stats, a3byte const* name);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOMORPHTARGET_H
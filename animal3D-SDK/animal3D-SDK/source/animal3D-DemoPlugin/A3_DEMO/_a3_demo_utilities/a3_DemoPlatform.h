@@ -0,0 +1,62 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoPlatform.h
+	Platform queries shared by demo utilities: a monotonic clock for 
+		timing reports and the number of hardware threads for sizing 
+		worker pools.
+*/
+
+#ifndef __ANIMAL3D_DEMOPLATFORM_H
+#define __ANIMAL3D_DEMOPLATFORM_H
+
+
+#include "animal3D/a3/a3types_integer.h"
+#include "animal3D/a3/a3types_real.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// seconds from arbitrary origin on monotonic high-resolution clock; 
+	//	only differences are meaningful (a3_Timer ticks at a set rate, 
+	//	this measures spans of work)
+	a3f64 a3demo_getTime(void);
+
+	// number of logical processors, at least 1
+	a3ui32 a3demo_getHardwareThreadCount(void);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOPLATFORM_H
@@ -0,0 +1,185 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoProceduralGeometry.h
+	Procedural geometry generation service: shapes are requested first,
+		identical descriptors are found by hash and share one result, then
+		all distinct shapes are generated (and optionally processed) on
+		worker threads at once. Descriptors wrap the library descriptor;
+		plane, sphere and torus may also be described with 32-bit counts
+		and are then built here, past the library's limit of 255.
+*/
+
+#ifndef __ANIMAL3D_DEMOPROCEDURALGEOMETRY_H
+#define __ANIMAL3D_DEMOPROCEDURALGEOMETRY_H
+
+
+#include "animal3D/a3/a3types_integer.h"
+#include "animal3D/a3/a3types_real.h"
+#include "animal3D/a3geometry/a3_ProceduralGeometry.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef struct a3_DemoProceduralDescriptor	a3_DemoProceduralDescriptor;
+	typedef struct a3_DemoProceduralJob			a3_DemoProceduralJob;
+	typedef struct a3_DemoProceduralRequest		a3_DemoProceduralRequest;
+	typedef struct a3_DemoProceduralService		a3_DemoProceduralService;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// service limits
+	enum a3_DemoProceduralLimit
+	{
+		a3demoProcedural_jobMax = 64,			// most distinct shapes in one service
+		a3demoProcedural_requestMax = 128,		// most requests in one service
+		a3demoProcedural_threadMax = 16,		// most shapes generated at once
+		a3demoProcedural_countMax = 4096,		// most divisions of high-resolution shape
+		a3demoProcedural_nameMax = 32,			// shape name length, including terminator
+	};
+
+	// processing run on worker thread after shape is generated, once per
+	//	distinct shape; user pointer is the one given with the first
+	//	request for the shape
+	typedef void(*a3_DemoProceduralProcessFunc)(a3_GeometryData* geom, void* user);
+
+	// shape descriptor; 'shape' is none to generate 'base' in the library,
+	//	otherwise one of plane, sphere or torus is built here with 32-bit
+	//	division counts; all members take part in the hash, so descriptors
+	//	should come from the create functions, which clear unused ones
+	struct a3_DemoProceduralDescriptor
+	{
+		a3_ProceduralGeometryDescriptor base[1];	// library descriptor
+		a3ui32 shape;							// high-resolution shape, or none
+		a3ui32 flags, axis;						// as library
+		a3ui32 slices, stacks;					// divisions around (or across) and along
+		a3f32 size[2];							// plane width and height, sphere radius,
+												//	torus major and minor radius
+	};
+
+	// one distinct shape
+	struct a3_DemoProceduralJob
+	{
+		a3_DemoProceduralDescriptor desc[1];
+		a3ui64 hash;							// descriptor hash for matching requests
+		a3ui64 cost;							// estimated vertices, for scheduling
+		a3_GeometryData geom[1];				// result, owned by service
+		a3byte name[a3demoProcedural_nameMax];	// name of first request
+		void* user;								// user pointer of first request
+		a3f64 time;								// seconds to generate and process
+		a3ui32 requestCount;					// requests sharing result
+		a3ui32 thread;							// worker that generated it
+		a3ret result;							// 1 if generated and processed
+		a3boolean done;							// generated in an earlier run
+	};
+
+	// one request, filled when service runs
+	struct a3_DemoProceduralRequest
+	{
+		a3_GeometryData* geom_out;
+		a3ui32 job;
+	};
+
+	// generation service
+	struct a3_DemoProceduralService
+	{
+		a3_DemoProceduralJob job[a3demoProcedural_jobMax];
+		a3_DemoProceduralRequest request[a3demoProcedural_requestMax];
+		a3ui32 jobCount, requestCount;
+		a3ui32 threadCount;						// workers used by last run
+		a3ui32 generateCount;					// shapes generated by last run
+		a3f64 time;								// seconds spent in last run
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// wrap library descriptor; returns 1 if wrapped, -1 if invalid
+	a3ret a3demo_createProceduralDescriptor(a3_DemoProceduralDescriptor* desc_out, a3_ProceduralGeometryDescriptor const* base);
+
+	// create plane descriptor; counts below 256 use the library plane,
+	//	others up to countMax are built here; returns 1 if created, 0 if
+	//	counts are out of range, -1 if invalid
+	a3ret a3demo_createProceduralPlane(a3_DemoProceduralDescriptor* desc_out, a3_ProceduralGeometryFlag const flags, a3_ProceduralGeometryAxis const axis,
+		a3f32 const width, a3f32 const height, a3ui32 const subdivsW, a3ui32 const subdivsH);
+
+	// create sphere descriptor; counts as plane
+	a3ret a3demo_createProceduralSphere(a3_DemoProceduralDescriptor* desc_out, a3_ProceduralGeometryFlag const flags, a3_ProceduralGeometryAxis const axis,
+		a3f32 const radius, a3ui32 const slices, a3ui32 const stacks);
+
+	// create torus descriptor; counts as plane
+	a3ret a3demo_createProceduralTorus(a3_DemoProceduralDescriptor* desc_out, a3_ProceduralGeometryFlag const flags, a3_ProceduralGeometryAxis const axis,
+		a3f32 const radiusMajor, a3f32 const radiusMinor, a3ui32 const slices, a3ui32 const subdivsR);
+
+	// continue key hash (FNV-1a) with every member of descriptor, one at
+	//	a time so padding never takes part
+	a3ui64 a3demo_hashProceduralDescriptor(a3ui64 const key, a3_DemoProceduralDescriptor const* desc);
+
+	// generate one shape on calling thread; geometry is released with
+	//	a3geometryReleaseData; returns 1 if generated, 0 if failed, -1 if
+	//	invalid
+	a3ret a3demo_generateProceduralGeometry(a3_GeometryData* geom_out, a3_DemoProceduralDescriptor const* desc);
+
+
+//-----------------------------------------------------------------------------
+
+	// clear service; returns 1 if cleared, -1 if invalid
+	a3ret a3demo_initProceduralService(a3_DemoProceduralService* service);
+
+	// request shape; output is filled when service runs and shares data
+	//	with service, so it stays valid until service is released and must
+	//	not be released itself (see below); returns 1 if shape is new, 0 if
+	//	it shares an earlier result, -1 if invalid or service is full
+	a3ret a3demo_requestProceduralGeometry(a3_DemoProceduralService* service, a3_GeometryData* geom_out, a3_DemoProceduralDescriptor const* desc,
+		a3byte const* name_opt, void* user_opt);
+
+	// generate shapes not generated yet, run process on each, then fill
+	//	every request; thread count zero uses all hardware threads; returns
+	//	number of shapes generated, -1 if invalid
+	a3ret a3demo_runProceduralService(a3_DemoProceduralService* service, a3ui32 const threadCount,
+		a3_DemoProceduralProcessFunc process_opt);
+
+	// check whether geometry shares data generated by service, so service
+	//	owns it; ask before releasing service; returns 1 if shared, 0 if
+	//	not, -1 if invalid
+	a3ret a3demo_isGeometryProcedural(a3_DemoProceduralService const* service, a3_GeometryData const* geom);
+
+	// release all generated geometry; returns 1 if released, -1 if invalid
+	a3ret a3demo_releaseProceduralService(a3_DemoProceduralService* service);
+
+	// print service report to stdout
+	void a3demo_printProceduralService(a3_DemoProceduralService const* service);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOPROCEDURALGEOMETRY_H
@@ -32,6 +32,7 @@
 #include "animal3D/animal3D.h"
 #include "animal3D-A3DG/animal3D-A3DG.h"
 #include "animal3D-A3DM/animal3D-A3DM.h"
+#include "animal3D-A3DM/a3math/a3simd.h"
 
 
 //-----------------------------------------------------------------------------
@@ -28,6 +28,8 @@
 
 // math library
 #include "animal3D-A3DM/animal3D-A3DM.h"
+#include "animal3D-A3DM/a3math/a3batch.h"
+#include "animal3D-A3DM/a3math/a3sincos.h"
 
 
 //-----------------------------------------------------------------------------
@@ -41,11 +43,20 @@ extern "C"
 	typedef struct a3_DemoSceneObject		a3_DemoSceneObject;
 	typedef struct a3_DemoProjector			a3_DemoProjector;
 	typedef struct a3_DemoPointLight		a3_DemoPointLight;
+	typedef enum a3_DemoTransformType		a3_DemoTransformType;
 #endif	// __cplusplus
 
 	
 //-----------------------------------------------------------------------------
 
+	// affine transform types, cheapest to invert first
+	enum a3_DemoTransformType
+	{
+		demoTransform_rigid,			// rotation and translation only
+		demoTransform_uniformScale,		// rigid with the same scale on every axis
+		demoTransform_general,			// non-uniform scale or shear
+	};
+
 	// matrix stack for a single object
 	struct a3_DemoModelMatrixStack
 	{
@@ -116,6 +127,7 @@ extern "C"
 
 	// scene object initializers and updates
 	inline void a3demo_initSceneObject(a3_DemoSceneObject *sceneObject);
+	inline void a3demo_updateSceneObjectModelMat(a3_DemoSceneObject *sceneObject, const a3boolean useZYX);
 	inline void a3demo_updateSceneObject(a3_DemoSceneObject *sceneObject, const a3boolean useZYX);
 	inline a3i32 a3demo_rotateSceneObject(a3_DemoSceneObject *sceneObject, const a3real speed, const a3real deltaX, const a3real deltaY, const a3real deltaZ);
 	inline a3i32 a3demo_moveSceneObject(a3_DemoSceneObject *sceneObject, const a3real speed, const a3real deltaX, const a3real deltaY, const a3real deltaZ);
@@ -130,6 +142,20 @@ extern "C"
 	inline void a3demo_updateModelMatrixStack(a3_DemoModelMatrixStack* model, a3real4x4p const projectionMat_viewer, a3real4x4p const modelMat_viewer, a3real4x4p const modelMatInv_viewer, a3real4x4p const modelMat, a3real4x4p const atlasMat);
 	inline void a3demo_updateViewerMatrixStack(a3_DemoViewerMatrixStack* viewer, a3real4x4p const modelMat_viewer, a3real4x4p const modelMatInv_viewer, a3real4x4p const projectionMat, a3real4x4p const projectionMatInv, a3real4x4p const biasMat, a3real4x4p const biasMatInv);
 
+	// classify transform by its basis; scale output is inverse squared 
+	//	scale, or zero if general
+	inline a3_DemoTransformType a3demo_getTransformType(a3real4x4p const m, a3real* scaleSqInv_out);
+
+	// fused model matrix stacks sharing one viewer: same results as 
+	//	a3demo_updateModelMatrixStack per object, but the viewer is 
+	//	classified once per batch and each object's transform type picks 
+	//	cheaper inverses; for rigid or uniform-scale objects seen by a rigid 
+	//	viewer, inverse-transposes are scaled copies and the model-view 
+	//	inverse skips a product; input matrices are read with strides in 
+	//	bytes (e.g. sizeof(a3_DemoSceneObject) to read scene objects' model 
+	//	matrices), zero stride repeats; pass count 1 for a single object
+	inline void a3demo_updateModelMatrixStackArray(a3_DemoModelMatrixStack* model, a3count const count, a3real4x4p const projectionMat_viewer, a3real4x4p const modelMat_viewer, a3real4x4p const modelMatInv_viewer, a3real4x4p const modelMat, a3size const modelMatStride, a3real4x4p const atlasMat, a3size const atlasMatStride);
+
 
 //-----------------------------------------------------------------------------
 
@@ -139,4 +165,7 @@ extern "C"
 #endif	// __cplusplus
 
 
+#include "_inl/a3_DemoSceneObject.inl"
+
+
 #endif	// !__ANIMAL3D_DEMOSCENEOBJECT_H
\ No newline at end of file
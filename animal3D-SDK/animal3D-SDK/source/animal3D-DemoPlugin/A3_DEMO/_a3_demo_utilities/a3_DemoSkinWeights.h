@@ -0,0 +1,133 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoSkinWeights.h
+	Streaming importer for skin weights exported from Maya as XML
+		(deformerWeight): the file is read through a fixed buffer and
+		elements are handled as they are scanned, with no document
+		tree. Every vertex keeps only its largest few weights while
+		reading, so memory does not grow with raw influence count; kept
+		weights are renormalized and stored as float, unorm16 or unorm8.
+		Influence names are matched to hierarchy nodes through a hash.
+*/
+
+#ifndef __ANIMAL3D_DEMOSKINWEIGHTS_H
+#define __ANIMAL3D_DEMOSKINWEIGHTS_H
+
+
+#include "animal3D/a3/a3types_integer.h"
+#include "animal3D/a3/a3types_real.h"
+
+#include "../_animation/a3_Hierarchy.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef struct a3_DemoSkinWeights		a3_DemoSkinWeights;
+	typedef struct a3_DemoSkinWeightsStats	a3_DemoSkinWeightsStats;
+	typedef enum a3_DemoSkinWeightFormat	a3_DemoSkinWeightFormat;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// importer limits
+	enum a3_DemoSkinWeightsLimit
+	{
+		a3demoSkinWeights_influenceMax = 8,		// most weights kept per vertex
+		a3demoSkinWeights_bufferSize = 1 << 16,	// bytes read at once; longest element that fits
+	};
+
+	// stored weight type
+	enum a3_DemoSkinWeightFormat
+	{
+		a3demoSkinWeight_float,					// a3f32, sum one
+		a3demoSkinWeight_unorm16,				// a3ui16, sum kept at 65535
+		a3demoSkinWeight_unorm8,				// a3ubyte, sum kept at 255
+	};
+
+	// kept weights of every vertex, largest first
+	struct a3_DemoSkinWeights
+	{
+		void* weight;							// influence count per vertex, in format
+		a3i32* index;							// node of each weight; 0 where weight is zero
+		a3ui32 vertexCount;						// shape size or highest point index plus one
+		a3ui32 influenceCount;					// weights per vertex
+		a3_DemoSkinWeightFormat format;
+		a3ui32 weightSize;						// bytes per weight
+		void* data;
+	};
+
+	// import report
+	struct a3_DemoSkinWeightsStats
+	{
+		a3size fileSize;						// bytes read
+		a3ui32 vertexCount;
+		a3ui32 influenceCount;					// weight lists in file
+		a3ui32 unmatchedCount;					// lists whose name is not a node; dropped
+		a3ui32 pointCount;						// nonzero weights read
+		a3ui32 rawMax;							// most weights on one vertex in file
+		a3ui32 keepCount;						// weights kept per vertex
+		a3ui32 truncatedCount;					// vertices with more weights than kept
+		a3ui32 unweightedCount;					// vertices with no weight
+		a3f64 parseTime;						// seconds reading and keeping largest
+		a3f64 storeTime;						// seconds renormalizing and quantizing
+		a3f64 totalTime;
+		a3f64 megabytesPerSecond;				// file size over total time
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// import weights file keeping influence count (at most limit) largest
+	//	weights per vertex; each weight list's source name is looked up in
+	//	hierarchy (names compared as stored, at most node name size), or
+	//	lists are numbered in file order if no hierarchy is given; vertex
+	//	numbers are the file's point indices (OBJ position order), and an
+	//	index at or past the shape size makes the file malformed; returns
+	//	vertex count, 0 if file could not be read or is malformed or memory
+	//	ran out, -1 if invalid
+	a3ret a3demo_importSkinWeights(a3_DemoSkinWeights* weights_out, a3byte const* filePath, a3_Hierarchy const* hierarchy_opt,
+		a3ui32 const influenceCount, a3_DemoSkinWeightFormat const format, a3_DemoSkinWeightsStats* stats_out_opt);
+
+	// release weights
+	a3ret a3demo_releaseSkinWeights(a3_DemoSkinWeights* weights);
+
+	// decode weights and nodes of one vertex (influence count each);
+	//	returns influence count, -1 if invalid
+	a3ret a3demo_getSkinWeights(a3f32* weight_out, a3i32* index_out_opt, a3_DemoSkinWeights const* weights, a3ui32 const vertex);
+
+	// print import report to stdout
+	void a3demo_printSkinWeightsStats(a3_DemoSkinWeightsStats const* stats, a3byte const* filePath);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOSKINWEIGHTS_H
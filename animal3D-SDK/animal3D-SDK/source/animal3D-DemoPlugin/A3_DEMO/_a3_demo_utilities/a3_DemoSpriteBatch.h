@@ -0,0 +1,136 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoSpriteBatch.h
+	Batched sprite animation: every sprite's cell, transform and tint are
+		packed into one storage buffer and drawn with a single instanced
+		call; atlas cells live in a uniform buffer.
+*/
+
+#ifndef __ANIMAL3D_DEMOSPRITEBATCH_H
+#define __ANIMAL3D_DEMOSPRITEBATCH_H
+
+
+// math library
+#include "animal3D-A3DM/animal3D-A3DM.h"
+
+// graphics library
+#include "animal3D-A3DG/a3graphics/a3_TextureAtlas.h"
+#include "animal3D-A3DG/a3graphics/a3_UniformBuffer.h"
+#include "animal3D-A3DG/a3graphics/a3_VertexDrawable.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef struct a3_DemoSpriteInstance	a3_DemoSpriteInstance;
+	typedef struct a3_DemoSpriteClip		a3_DemoSpriteClip;
+	typedef struct a3_DemoSpriteBatch		a3_DemoSpriteBatch;
+	typedef enum a3_DemoSpriteClipMode		a3_DemoSpriteClipMode;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// limits and bindings shared with sprite shaders
+	enum a3_DemoSpriteBatchLimit
+	{
+		a3demoSprite_cellMax = 256,				// cells in atlas block (two vec4 each)
+		a3demoSprite_cellBinding = 4,			// uniform block binding of cell table
+		a3demoSprite_instanceBinding = 0,		// storage block binding of instances
+	};
+
+	// how a sprite clip behaves when it reaches its last cell
+	enum a3_DemoSpriteClipMode
+	{
+		a3demoSpriteClip_loop,					// wrap to first cell
+		a3demoSpriteClip_pingPong,				// play back to first cell
+		a3demoSpriteClip_stop,					// hold last cell
+	};
+
+	// per-sprite data consumed by the instanced vertex shader
+	// layout matches std430 'sSpriteInstance' in shader (32 bytes)
+	struct a3_DemoSpriteInstance
+	{
+		a3f32 position[3];						// world-space center
+		a3f32 rotation;							// rotation about view axis (radians)
+		a3f32 size[2];							// world-space width and height
+		a3ui32 cell;							// atlas cell index
+		a3ui32 tint;							// packed RGBA8 color, red in low byte
+	};
+
+	// range of atlas cells played as an animation
+	struct a3_DemoSpriteClip
+	{
+		a3ui32 firstCell;						// first cell in atlas
+		a3ui32 cellCount;						// number of consecutive cells
+		a3f32 cellDuration;						// seconds per cell
+		a3_DemoSpriteClipMode mode;				// end behavior
+	};
+
+	// sprite batch: instance data and playheads for many sprites
+	struct a3_DemoSpriteBatch
+	{
+		a3_StorageBuffer instanceBuffer[1];		// GPU instance data
+		a3_UniformBuffer cellBuffer[1];			// GPU atlas cell table
+		a3_DemoSpriteInstance *instance;		// CPU instance data
+		a3f32 *clipTime;						// playhead time per sprite
+		a3ui16 *clipIndex;						// clip played by each sprite
+		const a3_DemoSpriteClip *clip;			// clip table (not owned)
+		a3ui32 clipCount;						// number of clips in table
+		a3ui32 count, capacity;					// sprites in use and maximum
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// create sprite batch and upload atlas cells; clips are referenced
+	//	fails if any clip plays no cells or cells past the atlas or table
+	a3i32 a3demo_createSpriteBatch(a3_DemoSpriteBatch* batch_out, const a3ui32 capacity, const a3_TextureAtlas* atlas, const a3_DemoSpriteClip* clips, const a3ui32 clipCount);
+
+	// release sprite batch
+	a3i32 a3demo_releaseSpriteBatch(a3_DemoSpriteBatch* batch);
+
+	// add a sprite playing a clip from a start time; returns sprite index
+	a3i32 a3demo_addSprite(a3_DemoSpriteBatch* batch, a3real3p const position, const a3real rotation, const a3real width, const a3real height, const a3ui32 tint, const a3ui32 clipIndex, const a3real startTime);
+
+	// advance all playheads and select cells
+	a3i32 a3demo_updateSpriteBatch(a3_DemoSpriteBatch* batch, const a3real dt);
+
+	// send instance data to GPU
+	a3i32 a3demo_uploadSpriteBatch(a3_DemoSpriteBatch* batch);
+
+	// bind batch buffers and draw all sprites with one instanced call
+	//	program and atlas texture must already be active
+	a3i32 a3demo_renderSpriteBatch(a3_DemoSpriteBatch const* batch, a3_VertexDrawable const* quad);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOSPRITEBATCH_H
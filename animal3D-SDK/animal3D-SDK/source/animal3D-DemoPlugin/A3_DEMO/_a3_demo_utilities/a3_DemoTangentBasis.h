@@ -0,0 +1,96 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoTangentBasis.h
+	Tangent basis generation for indexed triangles: vertices with equal
+		position, normal and texture coordinate are welded by hash so
+		they share one basis, texture-space directions of faces are found
+		four at a time with SIMD on worker threads, then summed per
+		welded vertex in face order and orthonormalized against each
+		vertex's normal. Sums never depend on how work was split, so the
+		result is the same for any number of threads.
+*/
+
+#ifndef __ANIMAL3D_DEMOTANGENTBASIS_H
+#define __ANIMAL3D_DEMOTANGENTBASIS_H
+
+
+#include "animal3D/a3/a3types_integer.h"
+#include "animal3D/a3/a3types_real.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef struct a3_DemoTangentBasisStats	a3_DemoTangentBasisStats;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// generator limits
+	enum a3_DemoTangentBasisLimit
+	{
+		a3demoTangentBasis_threadMax = 16,		// most ranges run at once
+		a3demoTangentBasis_rangeMin = 1 << 14,	// fewest faces or vertices worth a thread
+		a3demoTangentBasis_chunkSize = 256,		// faces found before adding on one thread
+	};
+
+	// generation report
+	struct a3_DemoTangentBasisStats
+	{
+		a3ui32 vertexCount, triangleCount;
+		a3ui32 weldedCount;						// distinct vertices after welding
+		a3ui32 degenerateCount;					// vertices without texture mapping, given any tangent
+		a3ui32 threadCount;						// ranges run in parallel
+		a3f64 weldTime;							// seconds to weld and list faces per vertex
+		a3f64 faceTime;							// seconds to find face directions
+		a3f64 vertexTime;						// seconds to sum and orthonormalize
+		a3f64 totalTime;
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// calculate unit tangent and bitangent per vertex from tightly packed
+	//	float positions (3), normals (3) and texcoords (2); bitangent is
+	//	normal cross tangent, negated where texture is mirrored; thread
+	//	count zero uses all hardware threads; returns 1 if calculated, 0 if
+	//	memory ran out, -1 if invalid
+	a3ret a3demo_calculateTangentBasis(a3f32* tangent_out, a3f32* bitangent_out,
+		a3f32 const* position, a3f32 const* normal, a3f32 const* texcoord, a3ui32 const vertexCount,
+		a3ui32 const* index, a3ui32 const triangleCount, a3ui32 const threadCount, a3_DemoTangentBasisStats* stats_out_opt);
+
+	// print generation report to stdout
+	void a3demo_printTangentBasisStats(a3_DemoTangentBasisStats const* stats, a3byte const* name);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOTANGENTBASIS_H
@@ -0,0 +1,124 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoVertexPacking.h
+	Compression of float vertex attributes into packed attribute types
+		before upload. The default set is converted back to float by the
+		vertex fetch, so existing shaders read it unchanged:
+			normal, tangent, bitangent:	snorm10x3 (12 -> 4 bytes)
+			texcoord:					half2 (8 -> 4 bytes)
+			color, blend weights:		unorm8x4 (16 -> 4 bytes)
+		Octahedral directions (snorm16x2) are smaller and more precise
+		than snorm10x3 but must be decoded in the shader with
+		decodeOctahedral from utilCommon_vs4x.glsl.
+*/
+
+#ifndef __ANIMAL3D_DEMOVERTEXPACKING_H
+#define __ANIMAL3D_DEMOVERTEXPACKING_H
+
+
+#include "animal3D/a3/a3types_integer.h"
+#include "animal3D/a3/a3types_real.h"
+#include "animal3D/a3geometry/a3_GeometryData.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef struct a3_DemoVertexPackStats	a3_DemoVertexPackStats;
+	typedef enum a3_DemoVertexPackFlag		a3_DemoVertexPackFlag;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// attributes to pack
+	enum a3_DemoVertexPackFlag
+	{
+		a3demoVertexPack_none,
+		a3demoVertexPack_position = 0x01,		// positions as half4 (w = 1); coarse, small models only
+		a3demoVertexPack_normal = 0x02,			// normals, tangents, bitangents as snorm10x3 (w = 1)
+		a3demoVertexPack_normal16 = 0x04,		// normals, tangents, bitangents as snorm16x4 (w = 1)
+		a3demoVertexPack_octahedral = 0x08,		// normals, tangents, bitangents as octahedral snorm16x2; needs decode
+		a3demoVertexPack_texcoord = 0x10,		// texcoords as half2
+		a3demoVertexPack_color = 0x20,			// colors as unorm8x4
+		a3demoVertexPack_blendWeights = 0x40,	// blend weights as unorm8x4, sum kept at one
+
+		// packing that needs no shader changes
+		a3demoVertexPack_default = a3demoVertexPack_normal | a3demoVertexPack_texcoord | a3demoVertexPack_color | a3demoVertexPack_blendWeights,
+	};
+
+	// packing report
+	struct a3_DemoVertexPackStats
+	{
+		a3ui32 vertexCount;						// vertices converted
+		a3ui32 attribCount;						// attribute streams converted
+		a3ui32 vertexSizeBefore, vertexSizeAfter;	// bytes per interleaved vertex
+		a3boolean packed;						// geometry had float attributes to pack
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// encode floats as half floats, round to nearest even
+	void a3demo_encodeHalf(a3ui16* out, a3f32 const* in, a3ui32 const count);
+
+	// encode floats clamped to [-1, 1] as signed normalized 16-bit values
+	void a3demo_encodeSnorm16(a3i16* out, a3f32 const* in, a3ui32 const count);
+
+	// encode floats clamped to [0, 1] as unsigned normalized 8-bit values
+	void a3demo_encodeUnorm8(a3ubyte* out, a3f32 const* in, a3ui32 const count);
+
+	// encode 3D vectors (first three of every 'stride' floats) as signed
+	//	normalized 10-bit components with 2-bit w (-1, 0 or 1) in each word
+	void a3demo_encodeSnorm10x3(a3ui32* out, a3f32 const* in, a3ui32 const stride, a3i32 const w, a3ui32 const count);
+
+	// encode unit 3D vectors (first three of every 'stride' floats) as
+	//	octahedral signed normalized 16-bit pairs
+	void a3demo_encodeOctahedral(a3i16* out, a3f32 const* in, a3ui32 const stride, a3ui32 const count);
+
+	// decode octahedral pair to unit vector (reference for shader decode)
+	void a3demo_decodeOctahedral(a3f32* v_out, a3i16 const* in);
+
+
+//-----------------------------------------------------------------------------
+
+	// replace float attributes of geometry with packed types, rebuilding
+	//	data block and vertex format; attributes that are not float are
+	//	kept as they are; returns 1 if packed, 0 if nothing to pack or
+	//	memory ran out, -1 if invalid
+	a3ret a3demo_packGeometry(a3_GeometryData* geom, a3_DemoVertexPackFlag const flags, a3_DemoVertexPackStats* stats_out_opt);
+
+	// print packing report to stdout
+	void a3demo_printVertexPackStats(a3_DemoVertexPackStats const* stats, a3byte const* name);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOVERTEXPACKING_H
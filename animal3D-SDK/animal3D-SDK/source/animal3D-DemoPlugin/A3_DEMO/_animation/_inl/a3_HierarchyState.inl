@@ -53,6 +53,41 @@ inline a3i32 a3hierarchyPoseGroupGetNodePoseOffsetIndex(const a3_HierarchyPoseGr
 
 //-----------------------------------------------------------------------------
 
+// get the range of evaluated node entries within node index range
+inline a3i32 a3hierarchyStateGetEvaluationRange(const a3_HierarchyState *state, const a3ui32 firstIndex, const a3ui32 nodeCount, a3ui32 *evalBegin_out, a3ui32 *evalEnd_out)
+{
+	if (state && state->poseGroup && evalBegin_out && evalEnd_out)
+	{
+		const a3ui32 numNodes = state->poseGroup->hierarchy->numNodes;
+		const a3ui32 lastIndex = (firstIndex + nodeCount < numNodes) ? (firstIndex + nodeCount) : numNodes;
+		a3ui32 lo, hi, mid;
+		if (state->evalCount == numNodes)
+		{
+			// all nodes: list is the identity
+			*evalBegin_out = firstIndex < numNodes ? firstIndex : numNodes;
+			*evalEnd_out = lastIndex;
+		}
+		else
+		{
+			// sorted subset: lower bound of each end
+			for (lo = 0, hi = state->evalCount; lo < hi; )
+				if ((a3ui32)state->evalNode[mid = (lo + hi) / 2] < firstIndex)
+					lo = mid + 1;
+				else
+					hi = mid;
+			*evalBegin_out = lo;
+			for (hi = state->evalCount; lo < hi; )
+				if ((a3ui32)state->evalNode[mid = (lo + hi) / 2] < lastIndex)
+					lo = mid + 1;
+				else
+					hi = mid;
+			*evalEnd_out = lo;
+		}
+		return (*evalEnd_out - *evalBegin_out);
+	}
+	return -1;
+}
+
 // update inverse object-space matrices
 inline a3i32 a3hierarchyStateUpdateObjectInverse(const a3_HierarchyState *state, const a3boolean usingScale)
 {
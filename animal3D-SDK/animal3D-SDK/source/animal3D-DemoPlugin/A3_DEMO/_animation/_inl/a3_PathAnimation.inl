@@ -0,0 +1,65 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_PathAnimation.inl
+	Implementation of inline path sampling.
+*/
+
+
+#ifdef __ANIMAL3D_PATHANIMATION_H
+#ifndef __ANIMAL3D_PATHANIMATION_INL
+#define __ANIMAL3D_PATHANIMATION_INL
+
+
+//-----------------------------------------------------------------------------
+
+inline a3real a3pathGetParamAtDistance(const a3_Path *path, const a3real distance)
+{
+	// locate bin directly, lerp between its ends
+	return a3sampleTableLerpUniform(path->binParam, path->binCount + 1, path->binsPerLength, distance);
+}
+
+inline a3real3r a3pathEvaluate(const a3_Path *path, a3real3p position_out, const a3real param)
+{
+	// split parameter into segment and local t, then Horner
+	a3ui32 segment = param > a3real_zero ? (a3ui32)param : 0;
+	a3real t;
+	const a3vec3 *c;
+	if (segment >= path->segmentCount)
+		segment = path->segmentCount - 1;
+	t = param - (a3real)segment;
+	c = path->coeff + segment * 4;
+	position_out[0] = ((c[3].x * t + c[2].x) * t + c[1].x) * t + c[0].x;
+	position_out[1] = ((c[3].y * t + c[2].y) * t + c[1].y) * t + c[0].y;
+	position_out[2] = ((c[3].z * t + c[2].z) * t + c[1].z) * t + c[0].z;
+	return position_out;
+}
+
+inline a3real3r a3pathEvaluateAtDistance(const a3_Path *path, a3real3p position_out, const a3real distance)
+{
+	return a3pathEvaluate(path, position_out, a3pathGetParamAtDistance(path, distance));
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+#endif	// !__ANIMAL3D_PATHANIMATION_INL
+#endif	// __ANIMAL3D_PATHANIMATION_H
@@ -26,6 +26,8 @@
 
 #include "../a3_Hierarchy.h"
 
+#include "../../_a3_demo_utilities/a3_DemoMemory.h"
+
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -63,7 +65,7 @@ a3ret a3hierarchyCreate(a3_Hierarchy *hierarchy_out, const a3ui32 numNodes, cons
 			const a3ui32 dataSize = sizeof(a3_HierarchyNode) * numNodes;
 			a3ui32 i;
 			const a3byte *tmpName;
-			hierarchy_out->nodes = (a3_HierarchyNode *)malloc(dataSize);
+			hierarchy_out->nodes = (a3_HierarchyNode *)a3demo_alloc(dataSize);
 			memset(hierarchy_out->nodes, 0, dataSize);
 			hierarchy_out->numNodes = numNodes;
 			if (names_opt)
@@ -131,6 +133,165 @@ a3ret a3hierarchyGetNodeNames(const a3byte *nameList_out[], const a3_Hierarchy *
 	return -1;
 }
 
+a3ret a3hierarchyReorder(a3_Hierarchy *hierarchy, const a3_HierarchyNodeOrder order, a3i32 *oldToNew_out_opt, a3i32 *newToOld_out_opt)
+{
+	a3_HierarchyNode *nodes, *tmpNodes;
+	a3i32 *childStart, *childList, *oldToNew, *newToOld, *pending;
+	a3i32 node, parent, head, tail;
+	a3ui32 i, j, n;
+	if (hierarchy && (order == a3hierarchyOrder_depthFirst || order == a3hierarchyOrder_breadthFirst))
+	{
+		if (hierarchy->nodes)
+		{
+			// scratch: child offsets, child lists, both remap tables, 
+			//	traversal stack/queue, and a copy of the original nodes
+			n = hierarchy->numNodes;
+			nodes = hierarchy->nodes;
+			childStart = (a3i32 *)a3demo_alloc(sizeof(a3i32) * (n * 5 + 1) + sizeof(a3_HierarchyNode) * n);
+			childList = childStart + n + 1;
+			oldToNew = childList + n;
+			newToOld = oldToNew + n;
+			pending = newToOld + n;
+			tmpNodes = (a3_HierarchyNode *)(pending + n);
+
+			// count children per node, then prefix sum into offsets
+			// roots are stored as children of a virtual node at the end
+			memset(childStart, 0, sizeof(a3i32) * (n + 1));
+			for (i = 0; i < n; ++i)
+			{
+				parent = nodes[i].parentIndex;
+				++childStart[parent >= 0 ? parent : (a3i32)n];
+			}
+			for (i = 0, head = 0; i <= n; ++i)
+			{
+				tail = childStart[i];
+				childStart[i] = head;
+				head += tail;
+			}
+
+			// fill child lists in ascending index order so siblings keep 
+			//	their original relative order; offsets end up shifted by one
+			for (i = 0; i < n; ++i)
+			{
+				parent = nodes[i].parentIndex;
+				childList[childStart[parent >= 0 ? parent : (a3i32)n]++] = i;
+			}
+			for (i = n; i > 0; --i)
+				childStart[i] = childStart[i - 1];
+			childStart[0] = 0;
+
+			// traverse, starting with roots
+			// children of node k are childList[childStart[k]..childStart[k+1])
+			//	except roots, which end at n
+			j = 0;
+			if (order == a3hierarchyOrder_depthFirst)
+			{
+				// explicit stack, children pushed in reverse
+				tail = 0;
+				for (head = n - 1; head >= childStart[n]; --head)
+					pending[tail++] = childList[head];
+				while (tail > 0)
+				{
+					node = pending[--tail];
+					newToOld[j++] = node;
+					for (head = childStart[node + 1] - 1; head >= childStart[node]; --head)
+						pending[tail++] = childList[head];
+				}
+			}
+			else
+			{
+				// queue is the output itself
+				for (head = childStart[n]; head < (a3i32)n; ++head)
+					newToOld[j++] = childList[head];
+				for (i = 0; i < j; ++i)
+				{
+					node = newToOld[i];
+					for (head = childStart[node]; head < childStart[node + 1]; ++head)
+						newToOld[j++] = childList[head];
+				}
+			}
+
+			// build inverse table and rewrite nodes
+			for (i = 0; i < n; ++i)
+				oldToNew[newToOld[i]] = i;
+			memcpy(tmpNodes, nodes, sizeof(a3_HierarchyNode) * n);
+			for (i = 0; i < n; ++i)
+			{
+				nodes[i] = tmpNodes[newToOld[i]];
+				nodes[i].index = i;
+				if (nodes[i].parentIndex >= 0)
+					nodes[i].parentIndex = oldToNew[nodes[i].parentIndex];
+			}
+
+			if (oldToNew_out_opt)
+				memcpy(oldToNew_out_opt, oldToNew, sizeof(a3i32) * n);
+			if (newToOld_out_opt)
+				memcpy(newToOld_out_opt, newToOld, sizeof(a3i32) * n);
+			a3demo_release(childStart);
+			return n;
+		}
+	}
+	return -1;
+}
+
+a3ret a3hierarchyRemapNodeData(void *data_inout, const a3ui32 elementSize, const a3ui32 numNodes, const a3i32 *newToOld)
+{
+	a3byte *data, *tmp;
+	a3ui32 i;
+	if (data_inout && elementSize && numNodes && newToOld)
+	{
+		data = (a3byte *)data_inout;
+		tmp = (a3byte *)a3demo_alloc(elementSize * numNodes);
+		memcpy(tmp, data, elementSize * numNodes);
+		for (i = 0; i < numNodes; ++i)
+			memcpy(data + elementSize * i, tmp + elementSize * newToOld[i], elementSize);
+		a3demo_release(tmp);
+		return numNodes;
+	}
+	return -1;
+}
+
+a3ret a3hierarchyRemapNodeIndices(a3i32 *indices_inout, const a3ui32 count, const a3i32 *oldToNew, const a3ui32 numNodes)
+{
+	a3ui32 i;
+	if (indices_inout && count && oldToNew && numNodes)
+	{
+		for (i = 0; i < count; ++i)
+			if (indices_inout[i] >= 0 && indices_inout[i] < (a3i32)numNodes)
+				indices_inout[i] = oldToNew[indices_inout[i]];
+		return count;
+	}
+	return -1;
+}
+
+a3ret a3hierarchyGetAncestorClosure(a3i32 *nodeList_out, const a3_Hierarchy *hierarchy, const a3i32 *requiredNodes, const a3ui32 requiredCount)
+{
+	a3i32 node;
+	a3ui32 i, count;
+	if (nodeList_out && hierarchy && requiredNodes && requiredCount)
+	{
+		if (hierarchy->nodes)
+		{
+			// use output as a mark array; walk up from each required node 
+			//	and stop at the first node that is already marked
+			memset(nodeList_out, 0, sizeof(a3i32) * hierarchy->numNodes);
+			for (i = 0; i < requiredCount; ++i)
+				for (node = requiredNodes[i];
+					node >= 0 && node < (a3i32)hierarchy->numNodes && !nodeList_out[node];
+					node = hierarchy->nodes[node].parentIndex)
+					nodeList_out[node] = 1;
+
+			// compact marks into sorted index list in place; write position 
+			//	never passes read position
+			for (i = count = 0; i < hierarchy->numNodes; ++i)
+				if (nodeList_out[i])
+					nodeList_out[count++] = i;
+			return count;
+		}
+	}
+	return -1;
+}
+
 a3ret a3hierarchySaveBinary(const a3_Hierarchy *hierarchy, const a3_FileStream *fileStream)
 {
 	FILE *fp;
@@ -166,7 +327,7 @@ a3ret a3hierarchyLoadBinary(a3_Hierarchy *hierarchy, const a3_FileStream *fileSt
 				ret += (a3ui32)fread(&hierarchy->numNodes, 1, sizeof(a3ui32), fp);
 
 				dataSize = sizeof(a3_HierarchyNode) * hierarchy->numNodes;
-				hierarchy->nodes = (a3_HierarchyNode *)malloc(dataSize);
+				hierarchy->nodes = (a3_HierarchyNode *)a3demo_alloc(dataSize);
 				ret += (a3ui32)fread(hierarchy->nodes, 1, dataSize, fp);
 			}
 			return ret;
@@ -204,7 +365,7 @@ a3ret a3hierarchyCopyFromString(a3_Hierarchy *hierarchy, const a3byte *str)
 			str += sizeof(a3ui32);
 
 			dataSize = sizeof(a3_HierarchyNode) * hierarchy->numNodes;
-			hierarchy->nodes = (a3_HierarchyNode *)malloc(dataSize);
+			hierarchy->nodes = (a3_HierarchyNode *)a3demo_alloc(dataSize);
 			memcpy(hierarchy->nodes, str, dataSize);
 			str += dataSize;
 
@@ -236,7 +397,7 @@ a3ret a3hierarchyRelease(a3_Hierarchy *hierarchy)
 	{
 		if (hierarchy->nodes)
 		{
-			free(hierarchy->nodes);
+			a3demo_release(hierarchy->nodes);
 			hierarchy->nodes = 0;
 			hierarchy->numNodes = 0;
 			return 1;
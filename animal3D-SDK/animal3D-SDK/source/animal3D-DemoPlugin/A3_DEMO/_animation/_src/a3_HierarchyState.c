@@ -24,6 +24,8 @@
 
 #include "../a3_HierarchyState.h"
 
+#include "../../_a3_demo_utilities/a3_DemoMemory.h"
+
 #include <stdlib.h>
 #include <string.h>
 
@@ -33,12 +35,72 @@
 // initialize pose set given an initialized hierarchy and key pose count
 a3i32 a3hierarchyPoseGroupCreate(a3_HierarchyPoseGroup *poseGroup_out, const a3_Hierarchy *hierarchy, const a3ui32 poseCount)
 {
+	// validate params and initialization states
+	if (poseGroup_out && hierarchy && !poseGroup_out->hierarchy && hierarchy->nodes && poseCount)
+	{
+		const a3ui32 spatialPoseCount = poseCount * hierarchy->numNodes;
+		const a3size hposeOffset = a3demo_alignSize(sizeof(a3_SpatialPose) * spatialPoseCount, a3demoMemory_alignment);
+		const a3size blockSize = hposeOffset + sizeof(a3_HierarchyPose) * poseCount;
+		a3ui32 i;
+
+		// one aligned block: spatial pose pool first, hierarchy poses after
+		poseGroup_out->spatialPosePool = (a3_SpatialPose *)a3demo_allocAligned(blockSize, a3demoMemory_alignment);
+		if (!poseGroup_out->spatialPosePool)
+			return -1;
+		poseGroup_out->hpose = (a3_HierarchyPose *)((a3byte *)poseGroup_out->spatialPosePool + hposeOffset);
+
+		// point each hierarchy pose at its range in the pool, set to identity
+		for (i = 0; i < poseCount; ++i)
+			poseGroup_out->hpose[i].spatialPose = poseGroup_out->spatialPosePool + i * hierarchy->numNodes;
+		for (i = 0; i < spatialPoseCount; ++i)
+			a3real4x4SetIdentity(poseGroup_out->spatialPosePool[i].transform.m);
+
+		// set hierarchy and count
+		poseGroup_out->hierarchy = hierarchy;
+		poseGroup_out->hposeCount = poseCount;
+
+		// done
+		return poseCount;
+	}
 	return -1;
 }
 
 // release pose set
 a3i32 a3hierarchyPoseGroupRelease(a3_HierarchyPoseGroup *poseGroup)
 {
+	// validate param exists and is initialized
+	if (poseGroup && poseGroup->hierarchy)
+	{
+		// release storage; pool is the start of the block
+		a3demo_releaseAligned(poseGroup->spatialPosePool);
+
+		// reset pointers
+		poseGroup->hierarchy = 0;
+		poseGroup->hpose = 0;
+		poseGroup->spatialPosePool = 0;
+		poseGroup->hposeCount = 0;
+
+		// done
+		return 1;
+	}
+	return -1;
+}
+
+// rearrange all poses after the hierarchy has been reordered
+a3i32 a3hierarchyPoseGroupRemap(a3_HierarchyPoseGroup *poseGroup, const a3i32 *newToOld)
+{
+	if (poseGroup && poseGroup->hierarchy && newToOld)
+	{
+		const a3ui32 numNodes = poseGroup->hierarchy->numNodes;
+		a3ui32 i;
+
+		// each hierarchy pose is a contiguous run of spatial poses
+		for (i = 0; i < poseGroup->hposeCount; ++i)
+			a3hierarchyRemapNodeData(poseGroup->hpose[i].spatialPose, sizeof(a3_SpatialPose), numNodes, newToOld);
+
+		// done
+		return poseGroup->hposeCount;
+	}
 	return -1;
 }
 
@@ -48,18 +110,120 @@ a3i32 a3hierarchyPoseGroupRelease(a3_HierarchyPoseGroup *poseGroup)
 // initialize hierarchy state given an initialized hierarchy
 a3i32 a3hierarchyStateCreate(a3_HierarchyState *state_out, const a3_HierarchyPoseGroup *poseGroup)
 {
+	// validate params and initialization states
+	if (state_out && poseGroup && !state_out->poseGroup && poseGroup->hierarchy)
+	{
+		const a3ui32 numNodes = poseGroup->hierarchy->numNodes;
+		const a3size transformSize = a3demo_alignSize(sizeof(a3mat4) * numNodes, a3demoMemory_alignment);
+		const a3size blockSize = transformSize * 4 + sizeof(a3i32) * numNodes;
+		a3byte *block;
+		a3ui32 i;
+
+		// one aligned block: four transform sets, each starting on a 
+		//	cache line, then the evaluation list
+		block = (a3byte *)a3demo_allocAligned(blockSize, a3demoMemory_alignment);
+		if (!block)
+			return -1;
+		state_out->localSpace->transform = (a3mat4 *)(block);
+		state_out->objectSpace->transform = (a3mat4 *)(block + transformSize);
+		state_out->objectSpaceInverse->transform = (a3mat4 *)(block + transformSize * 2);
+		state_out->objectSpaceBindToCurrent->transform = (a3mat4 *)(block + transformSize * 3);
+		state_out->evalNode = (a3i32 *)(block + transformSize * 4);
+
+		// reset all data, evaluate all nodes
+		for (i = 0; i < numNodes; ++i)
+		{
+			a3real4x4SetIdentity(state_out->localSpace->transform[i].m);
+			a3real4x4SetIdentity(state_out->objectSpace->transform[i].m);
+			a3real4x4SetIdentity(state_out->objectSpaceInverse->transform[i].m);
+			a3real4x4SetIdentity(state_out->objectSpaceBindToCurrent->transform[i].m);
+			state_out->evalNode[i] = i;
+		}
+		state_out->evalCount = numNodes;
+		state_out->poseGroup = poseGroup;
+
+		// done
+		return numNodes;
+	}
 	return -1;
 }
 
 // release hierarchy state
 a3i32 a3hierarchyStateRelease(a3_HierarchyState *state)
 {
+	// validate param exists and is initialized
+	if (state && state->poseGroup)
+	{
+		// release storage; local space is the start of the block
+		a3demo_releaseAligned(state->localSpace->transform);
+
+		// reset pointers
+		state->localSpace->transform = 0;
+		state->objectSpace->transform = 0;
+		state->objectSpaceInverse->transform = 0;
+		state->objectSpaceBindToCurrent->transform = 0;
+		state->evalNode = 0;
+		state->evalCount = 0;
+		state->poseGroup = 0;
+
+		// done
+		return 1;
+	}
+	return -1;
+}
+
+// restrict evaluation to the given nodes and their ancestors
+a3i32 a3hierarchyStateSetEvaluationNodes(a3_HierarchyState *state, const a3i32 *requiredNodes_opt, const a3ui32 requiredCount)
+{
+	a3i32 count;
+	a3ui32 i;
+	if (state && state->poseGroup)
+	{
+		const a3_Hierarchy *hierarchy = state->poseGroup->hierarchy;
+		if (requiredNodes_opt && requiredCount)
+		{
+			// the closure overwrites the list, so reject bad nodes first 
+			//	and keep the previous list on failure
+			for (i = 0; i < requiredCount; ++i)
+				if (requiredNodes_opt[i] < 0 || requiredNodes_opt[i] >= (a3i32)hierarchy->numNodes)
+					return -1;
+			count = a3hierarchyGetAncestorClosure(state->evalNode, hierarchy, requiredNodes_opt, requiredCount);
+			if (count < 0)
+				return -1;
+			state->evalCount = count;
+		}
+		else
+		{
+			for (i = 0; i < hierarchy->numNodes; ++i)
+				state->evalNode[i] = i;
+			state->evalCount = hierarchy->numNodes;
+		}
+		return state->evalCount;
+	}
 	return -1;
 }
 
 
 //-----------------------------------------------------------------------------
 
+// replace skin blend indices in geometry after the hierarchy has been reordered
+a3i32 a3hierarchyRemapGeometryBlendIndices(a3_GeometryData *geom, const a3i32 *oldToNew, const a3ui32 numNodes)
+{
+	a3i32 *indices;
+	if (geom && oldToNew && numNodes)
+	{
+		// the blending stream is every vertex's vec4 weights followed by 
+		//	every vertex's ivec4 indices; attribute pointers are read-only 
+		//	views into the block the geometry owns ('data'), and the caller 
+		//	passing mutable geometry is what makes dropping const here safe
+		if (geom->data && geom->attribData[a3attrib_geomBlending])
+		{
+			indices = (a3i32 *)((a3f32 *)geom->attribData[a3attrib_geomBlending] + geom->numVertices * 4);
+			return a3hierarchyRemapNodeIndices(indices, geom->numVertices * 4, oldToNew, numNodes);
+		}
+	}
+	return -1;
+}
 
 
 //-----------------------------------------------------------------------------
@@ -27,6 +27,119 @@
 
 //-----------------------------------------------------------------------------
 
+// sample a single key pose from the pose group into local space
+a3i32 a3hierarchyStateSamplePose(const a3_HierarchyState *state, const a3ui32 poseIndex)
+{
+	if (state && state->poseGroup && poseIndex < state->poseGroup->hposeCount)
+	{
+		const a3_SpatialPose *pose = state->poseGroup->hpose[poseIndex].spatialPose;
+		a3mat4 *localSpace = state->localSpace->transform;
+		a3ui32 k, i;
+
+		for (k = 0; k < state->evalCount; ++k)
+		{
+			i = state->evalNode[k];
+			a3real4x4SetReal4x4(localSpace[i].m, pose[i].transform.m);
+		}
+
+		// done
+		return state->evalCount;
+	}
+	return -1;
+}
+
+// blend one node pose: translation and per-axis scale are lerped, the 
+//	rotation left after removing scale is slerped along the short arc; 
+//	poses are assumed to be free of shear
+static void a3hierarchyStateInternalBlendNode(a3mat4 *m_out, const a3mat4 *m0, const a3mat4 *m1, const a3real u)
+{
+	a3mat3 r0, r1;
+	a3real4 q0, q1;
+	a3real3 s0, s1, t;
+
+	// scale is the length of each basis vector
+	a3real3x3SetReal4x4(r0.m, m0->m);
+	a3real3x3SetReal4x4(r1.m, m1->m);
+	s0[0] = a3real3Length(r0.v0.v);
+	s0[1] = a3real3Length(r0.v1.v);
+	s0[2] = a3real3Length(r0.v2.v);
+	s1[0] = a3real3Length(r1.v0.v);
+	s1[1] = a3real3Length(r1.v1.v);
+	s1[2] = a3real3Length(r1.v2.v);
+	a3real3DivS(r0.v0.v, s0[0]);
+	a3real3DivS(r0.v1.v, s0[1]);
+	a3real3DivS(r0.v2.v, s0[2]);
+	a3real3DivS(r1.v0.v, s1[0]);
+	a3real3DivS(r1.v1.v, s1[1]);
+	a3real3DivS(r1.v2.v, s1[2]);
+
+	// safe conversion handles half turns; flip to the same hemisphere 
+	//	so the blend takes the short arc
+	a3quatConvertFromMat3Safe(q0, r0.m);
+	a3quatConvertFromMat3Safe(q1, r1.m);
+	if (a3real4Dot(q0, q1) < a3real_zero)
+		a3real4Negate(q1);
+	a3quatSlerpUnit(q0, q0, q1, u);
+
+	// recompose rotation, scale and translation
+	a3real3Lerp(t, m0->v3.v, m1->v3.v, u);
+	a3real3Lerp(s0, s0, s1, u);
+	a3quatConvertToMat4Translate(m_out->m, q0, t);
+	a3real3MulS(m_out->v0.v, s0[0]);
+	a3real3MulS(m_out->v1.v, s0[1]);
+	a3real3MulS(m_out->v2.v, s0[2]);
+}
+
+
+// sample between two key poses from the pose group into local space
+a3i32 a3hierarchyStateSampleLerp(const a3_HierarchyState *state, const a3ui32 poseIndex0, const a3ui32 poseIndex1, const a3real u)
+{
+	if (state && state->poseGroup && poseIndex0 < state->poseGroup->hposeCount && poseIndex1 < state->poseGroup->hposeCount)
+	{
+		const a3_SpatialPose *pose0 = state->poseGroup->hpose[poseIndex0].spatialPose;
+		const a3_SpatialPose *pose1 = state->poseGroup->hpose[poseIndex1].spatialPose;
+		a3mat4 *localSpace = state->localSpace->transform;
+		a3ui32 k, i;
+
+		for (k = 0; k < state->evalCount; ++k)
+		{
+			i = state->evalNode[k];
+			a3hierarchyStateInternalBlendNode(localSpace + i, &pose0[i].transform, &pose1[i].transform, u);
+		}
+
+		// done
+		return state->evalCount;
+	}
+	return -1;
+}
+
+// masked blend between two key poses from the pose group into local space
+a3i32 a3hierarchyStateSampleLerpMasked(const a3_HierarchyState *state, const a3ui32 poseIndex0, const a3ui32 poseIndex1, const a3real *nodeParam)
+{
+	if (state && state->poseGroup && nodeParam && poseIndex0 < state->poseGroup->hposeCount && poseIndex1 < state->poseGroup->hposeCount)
+	{
+		const a3_SpatialPose *pose0 = state->poseGroup->hpose[poseIndex0].spatialPose;
+		const a3_SpatialPose *pose1 = state->poseGroup->hpose[poseIndex1].spatialPose;
+		a3mat4 *localSpace = state->localSpace->transform;
+		a3ui32 k, i;
+
+		// nodes fully on one side of the mask are copied
+		for (k = 0; k < state->evalCount; ++k)
+		{
+			i = state->evalNode[k];
+			if (nodeParam[i] <= a3real_zero)
+				a3real4x4SetReal4x4(localSpace[i].m, pose0[i].transform.m);
+			else if (nodeParam[i] >= a3real_one)
+				a3real4x4SetReal4x4(localSpace[i].m, pose1[i].transform.m);
+			else
+				a3hierarchyStateInternalBlendNode(localSpace + i, &pose0[i].transform, &pose1[i].transform, nodeParam[i]);
+		}
+
+		// done
+		return state->evalCount;
+	}
+	return -1;
+}
 
 
 //-----------------------------------------------------------------------------
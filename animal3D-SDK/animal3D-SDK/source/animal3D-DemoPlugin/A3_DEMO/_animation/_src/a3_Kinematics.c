@@ -33,12 +33,28 @@ a3i32 a3kinematicsSolveForwardPartial(const a3_HierarchyState *hierarchyState, c
 	if (hierarchyState && hierarchyState->poseGroup && 
 		firstIndex < hierarchyState->poseGroup->hierarchy->numNodes && nodeCount)
 	{
-		// ****TO-DO: implement forward kinematics algorithm
-		//	- for all nodes starting at first index
-		//		- if node is not root (has parent node)
-		//			- object matrix = parent object matrix * local matrix
-		//		- else
-		//			- copy local matrix to object matrix
+		const a3_HierarchyNode *node = hierarchyState->poseGroup->hierarchy->nodes;
+		const a3mat4 *localSpace = hierarchyState->localSpace->transform;
+		a3mat4 *objectSpace = hierarchyState->objectSpace->transform;
+		a3ui32 k, kEnd, i;
+		a3i32 p, count;
+
+		// only nodes in the state's evaluation set are solved; the set is 
+		//	closed under ancestors and sorted, so parents are always solved 
+		//	before their children
+		count = a3hierarchyStateGetEvaluationRange(hierarchyState, firstIndex, nodeCount, &k, &kEnd);
+		for (; k < kEnd; ++k)
+		{
+			i = hierarchyState->evalNode[k];
+			p = node[i].parentIndex;
+			if (p >= 0)
+				a3real4x4Product(objectSpace[i].m, objectSpace[p].m, localSpace[i].m);
+			else
+				a3real4x4SetReal4x4(objectSpace[i].m, localSpace[i].m);
+		}
+
+		// done
+		return count;
 	}
 	return -1;
 }
@@ -0,0 +1,256 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_PathAnimation.c
+	Implementation of path following.
+*/
+
+#include "../a3_PathAnimation.h"
+
+#include "../../_a3_demo_utilities/a3_DemoMemory.h"
+
+#include <stdlib.h>
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+
+// arc-length error allowed per unit of path chord length
+#define a3pathInternal_relativeTolerance	((a3real)1.0e-5)
+
+// get control point index, wrapping or clamping at ends
+inline a3ui32 a3pathInternalPointIndex(const a3i32 i, const a3ui32 count, const a3boolean loop)
+{
+	if (loop)
+		return (a3ui32)((i % (a3i32)count + (a3i32)count) % (a3i32)count);
+	return (a3ui32)(i < 0 ? 0 : i >= (a3i32)count ? (a3i32)count - 1 : i);
+}
+
+// path speed: length of derivative c1 + 2 c2 t + 3 c3 t^2 within segment
+a3real a3pathInternalSpeed(const void *data, const a3real param)
+{
+	const a3_Path *path = (const a3_Path *)data;
+	a3ui32 segment = param > a3real_zero ? (a3ui32)param : 0;
+	a3real3 d;
+	a3real t;
+	const a3vec3 *c;
+	if (segment >= path->segmentCount)
+		segment = path->segmentCount - 1;
+	t = param - (a3real)segment;
+	c = path->coeff + segment * 4;
+	d[0] = (c[3].x * 3 * t + c[2].x * 2) * t + c[1].x;
+	d[1] = (c[3].y * 3 * t + c[2].y * 2) * t + c[1].y;
+	d[2] = (c[3].z * 3 * t + c[2].z * 2) * t + c[1].z;
+	return (a3real)sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+}
+
+// set cubic coefficients from weights applied to four control values
+inline void a3pathInternalSetCoeff(a3vec3 *c, const a3vec3 *p0, const a3vec3 *p1, const a3vec3 *p2, const a3vec3 *p3, const a3real w[4][4])
+{
+	a3ui32 j;
+	for (j = 0; j < 4; ++j)
+	{
+		c[j].x = w[j][0] * p0->x + w[j][1] * p1->x + w[j][2] * p2->x + w[j][3] * p3->x;
+		c[j].y = w[j][0] * p0->y + w[j][1] * p1->y + w[j][2] * p2->y + w[j][3] * p3->y;
+		c[j].z = w[j][0] * p0->z + w[j][1] * p1->z + w[j][2] * p2->z + w[j][3] * p3->z;
+	}
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3i32 a3pathCreate(a3_Path *path_out, const a3_PathInterpolation interp, const a3vec3 *points, const a3ui32 pointCount, const a3boolean loop, const a3ui32 samplesPerSegment, const a3ui32 binCount)
+{
+	// basis matrices: row j gives weights of t^j
+	static const a3real basisLinear[4][4] = {
+		{ +1, +0, +0, +0 },
+		{ -1, +1, +0, +0 },
+		{ +0, +0, +0, +0 },
+		{ +0, +0, +0, +0 },
+	};
+	static const a3real basisCatmullRom[4][4] = {
+		{ +0.0f, +1.0f, +0.0f, +0.0f },
+		{ -0.5f, +0.0f, +0.5f, +0.0f },
+		{ +1.0f, -2.5f, +2.0f, -0.5f },
+		{ -0.5f, +1.5f, -1.5f, +0.5f },
+	};
+	static const a3real basisHermite[4][4] = {
+		{ +1, +0, +0, +0 },
+		{ +0, +1, +0, +0 },
+		{ -3, -2, +3, -1 },
+		{ +2, +1, -2, +1 },
+	};
+	static const a3real basisBezier[4][4] = {
+		{ +1, +0, +0, +0 },
+		{ -3, +3, +0, +0 },
+		{ +3, -6, +3, +0 },
+		{ -1, +3, -3, +1 },
+	};
+
+	a3ui32 segmentCount, bins, i;
+	a3real3 prev, curr;
+	a3real len, tolerance;
+	a3i32 k;
+
+	if (path_out && !path_out->coeff && points && samplesPerSegment)
+	{
+		// count segments; reject point counts the layout cannot use
+		switch (interp)
+		{
+		case a3path_linear:
+		case a3path_catmullRom:
+			if (pointCount < 2)
+				return -1;
+			segmentCount = loop ? pointCount : pointCount - 1;
+			break;
+		case a3path_hermite:
+			if (pointCount < 4 || pointCount % 2)
+				return -1;
+			segmentCount = loop ? pointCount / 2 : pointCount / 2 - 1;
+			break;
+		case a3path_bezier:
+			if (pointCount < 3 || (loop ? pointCount % 3 : (pointCount - 1) % 3))
+				return -1;
+			segmentCount = loop ? pointCount / 3 : (pointCount - 1) / 3;
+			break;
+		default:
+			return -1;
+		}
+		bins = binCount ? binCount : segmentCount * samplesPerSegment;
+
+		// coefficients and bins in one block
+		path_out->coeff = (a3vec3 *)a3demo_alloc(sizeof(a3vec3) * 4 * segmentCount + sizeof(a3real) * (bins + 1));
+		if (!path_out->coeff)
+			return -1;
+		path_out->binParam = (a3real *)(path_out->coeff + 4 * segmentCount);
+		path_out->segmentCount = segmentCount;
+		path_out->binCount = bins;
+		path_out->loop = loop;
+
+		for (i = 0; i < segmentCount; ++i)
+		{
+			k = (a3i32)i;
+			switch (interp)
+			{
+			case a3path_linear:
+				a3pathInternalSetCoeff(path_out->coeff + i * 4,
+					points + k, points + a3pathInternalPointIndex(k + 1, pointCount, loop),
+					points, points, basisLinear);
+				break;
+			case a3path_catmullRom:
+				a3pathInternalSetCoeff(path_out->coeff + i * 4,
+					points + a3pathInternalPointIndex(k - 1, pointCount, loop), points + k,
+					points + a3pathInternalPointIndex(k + 1, pointCount, loop), points + a3pathInternalPointIndex(k + 2, pointCount, loop),
+					basisCatmullRom);
+				break;
+			case a3path_hermite:
+				a3pathInternalSetCoeff(path_out->coeff + i * 4,
+					points + k * 2, points + k * 2 + 1,
+					points + a3pathInternalPointIndex(k * 2 + 2, pointCount, loop), points + a3pathInternalPointIndex(k * 2 + 3, pointCount, loop),
+					basisHermite);
+				break;
+			case a3path_bezier:
+				a3pathInternalSetCoeff(path_out->coeff + i * 4,
+					points + k * 3, points + k * 3 + 1,
+					points + k * 3 + 2, points + a3pathInternalPointIndex(k * 3 + 3, pointCount, loop),
+					basisBezier);
+				break;
+			}
+		}
+
+		// tolerance relative to the chord through segment ends
+		for (len = a3real_zero, i = 0; i < segmentCount; ++i)
+		{
+			a3pathEvaluate(path_out, prev, (a3real)i);
+			a3pathEvaluate(path_out, curr, (a3real)(i + 1));
+			len += a3real3Distance(prev, curr);
+		}
+		tolerance = len > a3real_zero ? len * a3pathInternal_relativeTolerance : a3pathInternal_relativeTolerance;
+
+		// adaptive quadrature with breaks at segment joins, then parameter
+		//	resampled at uniform distances
+		a3sampleTableGenerateArcLengthUniform(path_out->binParam, &path_out->length, bins + 1,
+			a3pathInternalSpeed, path_out, segmentCount, a3real_zero, (a3real)segmentCount, tolerance);
+		path_out->binsPerLength = a3sampleTableUniformScale(bins + 1, path_out->length);
+
+		return segmentCount;
+	}
+	return -1;
+}
+
+a3i32 a3pathRelease(a3_Path *path)
+{
+	if (path && path->coeff)
+	{
+		a3demo_release(path->coeff);
+		path->coeff = 0;
+		path->binParam = 0;
+		path->segmentCount = path->binCount = 0;
+		path->length = path->binsPerLength = a3real_zero;
+		return 1;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3i32 a3pathFollowerInit(a3_PathFollower *follower_out, a3_DemoSceneObject *sceneObject, const a3real distance, const a3real speed)
+{
+	if (follower_out && sceneObject)
+	{
+		follower_out->sceneObject = sceneObject;
+		follower_out->distance = distance;
+		follower_out->speed = speed;
+		return 1;
+	}
+	return -1;
+}
+
+a3i32 a3pathFollowerUpdate(const a3_Path *path, a3_PathFollower *followers, const a3ui32 followerCount, const a3real dt)
+{
+	const a3real length = path ? path->length : a3real_zero;
+	a3_PathFollower *follower, *const end = followers + followerCount;
+	a3real d;
+	if (path && path->coeff && followers)
+	{
+		// move, keep distance on path, then sample in constant time
+		for (follower = followers; follower < end; ++follower)
+		{
+			d = follower->distance + follower->speed * dt;
+			if (path->loop && length > a3real_zero)
+			{
+				if (d >= length || d < a3real_zero)
+					d -= length * (a3real)floor(d / length);
+			}
+			else if (d > length)
+				d = length;
+			else if (d < a3real_zero)
+				d = a3real_zero;
+			follower->distance = d;
+			a3pathEvaluateAtDistance(path, follower->sceneObject->position.v, d);
+		}
+		return followerCount;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -39,6 +39,7 @@ extern "C"
 #else	// !__cplusplus
 typedef struct a3_Hierarchy				a3_Hierarchy;
 typedef struct a3_HierarchyNode			a3_HierarchyNode;
+typedef enum a3_HierarchyNodeOrder		a3_HierarchyNodeOrder;
 #endif	// __cplusplus
 
 
@@ -51,6 +52,16 @@ enum a3_HierarchyNodeNameSize
 };
 
 
+// A3: Node traversal order used when reordering a hierarchy.
+//	depthFirst: each node is followed immediately by its whole subtree
+//	breadthFirst: nodes are grouped by depth; siblings are contiguous
+enum a3_HierarchyNodeOrder
+{
+	a3hierarchyOrder_depthFirst,
+	a3hierarchyOrder_breadthFirst,
+};
+
+
 // A3: Hierarchy node, a single link in a hierarchy tree.
 //	member name: name of node (defaults to a3node_[index])
 //	member index: index of node in hierarchy
@@ -109,6 +120,51 @@ a3ret a3hierarchyGetNodeIndex(const a3_Hierarchy *hierarchy, const a3byte name[a
 //	return: -1 if invalid params
 a3ret a3hierarchyGetNodeNames(const a3byte *nameList_out[], const a3_Hierarchy *hierarchy);
 
+// A3: Reorder hierarchy nodes in place so that related nodes are stored 
+//	contiguously; parent index remains less than node index, and siblings 
+//	keep their relative order.
+//	param hierarchy: non-null pointer to initialized hierarchy
+//	param order: traversal order describing the new layout
+//	param oldToNew_out_opt: optional array of at least as many indices as 
+//		there are nodes; receives the new index of each old node
+//	param newToOld_out_opt: optional array of at least as many indices as 
+//		there are nodes; receives the old index of each new node
+//	return: number of nodes if success
+//	return: -1 if invalid params
+a3ret a3hierarchyReorder(a3_Hierarchy *hierarchy, const a3_HierarchyNodeOrder order, a3i32 *oldToNew_out_opt, a3i32 *newToOld_out_opt);
+
+// A3: Utility to permute per-node data after a reorder.
+//	param data_inout: non-null pointer to array of per-node elements, 
+//		stored in old order; rearranged in place to new order
+//	param elementSize: non-zero size of each element in bytes
+//	param numNodes: non-zero number of elements
+//	param newToOld: non-null remap table produced by reorder
+//	return: numNodes if success
+//	return: -1 if invalid params
+a3ret a3hierarchyRemapNodeData(void *data_inout, const a3ui32 elementSize, const a3ui32 numNodes, const a3i32 *newToOld);
+
+// A3: Utility to replace stored node indices after a reorder.
+//	param indices_inout: non-null pointer to array of node indices; 
+//		negative values are treated as "no node" and left as-is
+//	param count: non-zero number of indices to remap
+//	param oldToNew: non-null remap table produced by reorder
+//	param numNodes: non-zero number of nodes in remap table
+//	return: count if success
+//	return: -1 if invalid params
+a3ret a3hierarchyRemapNodeIndices(a3i32 *indices_inout, const a3ui32 count, const a3i32 *oldToNew, const a3ui32 numNodes);
+
+// A3: Get the ancestor closure of a set of nodes: the nodes themselves and 
+//	every node on their paths to the root, sorted by index so that parents 
+//	always come before their children.
+//	param nodeList_out: non-null pointer to array of at least as many 
+//		indices as there are nodes in the hierarchy
+//	param hierarchy: non-null pointer to initialized hierarchy
+//	param requiredNodes: non-null pointer to array of node indices
+//	param requiredCount: non-zero number of required node indices
+//	return: number of nodes in closure if success
+//	return: -1 if invalid params
+a3ret a3hierarchyGetAncestorClosure(a3i32 *nodeList_out, const a3_Hierarchy *hierarchy, const a3i32 *requiredNodes, const a3ui32 requiredCount);
+
 // A3: Check if node is a parent of another.
 //	param hierarchy: non-null pointer to initialized hierarchy
 //	param parentIndex: non-negative possible parent node index
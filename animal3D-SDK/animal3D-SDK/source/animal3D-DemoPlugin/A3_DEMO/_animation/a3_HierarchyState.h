@@ -32,6 +32,9 @@
 // A3 spatial pose
 #include "a3_SpatialPose.h"
 
+// A3 geometry (for skin blend indices)
+#include "animal3D/a3geometry/a3_GeometryData.h"
+
 
 //-----------------------------------------------------------------------------
 
@@ -68,6 +71,15 @@ struct a3_HierarchyPoseGroup
 {
 	// pointer to hierarchy
 	const a3_Hierarchy *hierarchy;
+
+	// hierarchy poses, each referencing a contiguous range in the pool
+	a3_HierarchyPose *hpose;
+
+	// contiguous spatial pose pool, one per node per hierarchy pose
+	a3_SpatialPose *spatialPosePool;
+
+	// number of hierarchy poses
+	a3ui32 hposeCount;
 };
 
 
@@ -77,6 +89,18 @@ struct a3_HierarchyState
 {
 	// pointer to pose set that the poses come from
 	const a3_HierarchyPoseGroup *poseGroup;
+
+	// local-space transforms (sampled/blended), object-space transforms 
+	//	(FK result), their inverses and bind-to-current skinning transforms
+	a3_HierarchyTransform localSpace[1];
+	a3_HierarchyTransform objectSpace[1];
+	a3_HierarchyTransform objectSpaceInverse[1];
+	a3_HierarchyTransform objectSpaceBindToCurrent[1];
+
+	// nodes evaluated by sampling, blending and kinematics, sorted by index; 
+	//	all nodes by default, or the ancestor closure of a required set
+	a3i32 *evalNode;
+	a3ui32 evalCount;
 };
 	
 
@@ -88,6 +112,9 @@ a3i32 a3hierarchyPoseGroupCreate(a3_HierarchyPoseGroup *poseGroup_out, const a3_
 // release pose set
 a3i32 a3hierarchyPoseGroupRelease(a3_HierarchyPoseGroup *poseGroup);
 
+// rearrange all poses after the hierarchy has been reordered
+a3i32 a3hierarchyPoseGroupRemap(a3_HierarchyPoseGroup *poseGroup, const a3i32 *newToOld);
+
 // get offset to hierarchy pose in contiguous set
 a3i32 a3hierarchyPoseGroupGetPoseOffsetIndex(const a3_HierarchyPoseGroup *poseGroup, const a3ui32 poseIndex);
 
@@ -103,6 +130,15 @@ a3i32 a3hierarchyStateCreate(a3_HierarchyState *state_out, const a3_HierarchyPos
 // release hierarchy state
 a3i32 a3hierarchyStateRelease(a3_HierarchyState *state);
 
+// restrict evaluation to the given nodes and their ancestors; 
+//	pass null or zero count to evaluate all nodes again; returns -1 and 
+//	keeps the current list if any required node is out of range
+a3i32 a3hierarchyStateSetEvaluationNodes(a3_HierarchyState *state, const a3i32 *requiredNodes_opt, const a3ui32 requiredCount);
+
+// get the range of evaluated node entries whose node index lies in 
+//	[firstIndex, firstIndex + nodeCount); outputs index into evalNode
+a3i32 a3hierarchyStateGetEvaluationRange(const a3_HierarchyState *state, const a3ui32 firstIndex, const a3ui32 nodeCount, a3ui32 *evalBegin_out, a3ui32 *evalEnd_out);
+
 // update inverse object-space matrices
 a3i32 a3hierarchyStateUpdateObjectInverse(const a3_HierarchyState *state, const a3boolean usingScale);
 
@@ -112,6 +148,8 @@ a3i32 a3hierarchyStateUpdateObjectBindToCurrent(const a3_HierarchyState *state,
 
 //-----------------------------------------------------------------------------
 
+// replace skin blend indices in geometry after the hierarchy has been reordered
+a3i32 a3hierarchyRemapGeometryBlendIndices(a3_GeometryData *geom, const a3i32 *oldToNew, const a3ui32 numNodes);
 
 
 //-----------------------------------------------------------------------------
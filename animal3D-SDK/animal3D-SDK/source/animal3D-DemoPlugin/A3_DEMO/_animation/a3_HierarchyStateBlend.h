@@ -41,6 +41,23 @@ extern "C"
 
 //-----------------------------------------------------------------------------
 
+// sample a single key pose from the pose group into local space
+//	only the state's evaluation nodes are written
+a3i32 a3hierarchyStateSamplePose(const a3_HierarchyState *state, const a3ui32 poseIndex);
+
+// sample between two key poses from the pose group into local space
+//	rotation is slerped, translation and scale are lerped
+//	only the state's evaluation nodes are written
+a3i32 a3hierarchyStateSampleLerp(const a3_HierarchyState *state, const a3ui32 poseIndex0, const a3ui32 poseIndex1, const a3real u);
+
+// masked blend between two key poses from the pose group into local space
+//	nodeParam holds one blend parameter per node (0 is pose 0, 1 is pose 1)
+//	only the state's evaluation nodes are written
+a3i32 a3hierarchyStateSampleLerpMasked(const a3_HierarchyState *state, const a3ui32 poseIndex0, const a3ui32 poseIndex1, const a3real *nodeParam);
+
+// there is no clip sampler yet: keyframes and clips only hold indices 
+//	(see a3_KeyframeAnimation.h), so clip playback samples through the 
+//	calls above and gets partial evaluation from them
 
 
 //-----------------------------------------------------------------------------
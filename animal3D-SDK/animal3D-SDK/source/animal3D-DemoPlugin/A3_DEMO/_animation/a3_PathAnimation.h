@@ -0,0 +1,133 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_PathAnimation.h
+	Constant-speed path following along spline paths.
+*/
+
+#ifndef __ANIMAL3D_PATHANIMATION_H
+#define __ANIMAL3D_PATHANIMATION_H
+
+
+#include "animal3D-A3DM/a3math/a3vector.h"
+#include "animal3D-A3DM/a3math/a3arclength.h"
+
+#include "../_a3_demo_utilities/a3_DemoSceneObject.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+typedef struct a3_Path						a3_Path;
+typedef struct a3_PathFollower				a3_PathFollower;
+typedef enum a3_PathInterpolation			a3_PathInterpolation;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+// how path control points are interpreted
+enum a3_PathInterpolation
+{
+	a3path_linear,			// polyline through points
+	a3path_catmullRom,		// Catmull-Rom through points
+	a3path_hermite,			// Hermite; points are (position, tangent) pairs
+	a3path_bezier,			// cubic Bezier; points are 3n+1 with shared ends
+};
+
+
+// spline path with uniformly binned inverse arc-length table
+//	every segment is stored as cubic coefficients (c0 + c1 t + c2 t^2 + c3 t^3)
+//	bin i holds the path parameter (segment + t) at distance i * binSize
+struct a3_Path
+{
+	// cubic coefficients, four per segment
+	a3vec3 *coeff;
+
+	// parameter at uniform distance steps (binCount + 1)
+	a3real *binParam;
+
+	// number of segments and bins
+	a3ui32 segmentCount, binCount;
+
+	// total arc length and bins per unit length
+	a3real length, binsPerLength;
+
+	// path wraps around at end
+	a3boolean loop;
+};
+
+
+// object driven along a path at constant speed
+struct a3_PathFollower
+{
+	// scene object to position
+	a3_DemoSceneObject *sceneObject;
+
+	// distance travelled along path and speed in units per second
+	a3real distance, speed;
+};
+
+
+//-----------------------------------------------------------------------------
+
+// create path from control points and build arc-length tables
+//	samplesPerSegment: distance bins per segment when binCount is zero
+//	binCount: number of uniform distance bins
+a3i32 a3pathCreate(a3_Path *path_out, const a3_PathInterpolation interp, const a3vec3 *points, const a3ui32 pointCount, const a3boolean loop, const a3ui32 samplesPerSegment, const a3ui32 binCount);
+
+// release path
+a3i32 a3pathRelease(a3_Path *path);
+
+// get path parameter (segment + t) at distance along path in constant time
+a3real a3pathGetParamAtDistance(const a3_Path *path, const a3real distance);
+
+// evaluate position at path parameter
+a3real3r a3pathEvaluate(const a3_Path *path, a3real3p position_out, const a3real param);
+
+// evaluate position at distance along path
+a3real3r a3pathEvaluateAtDistance(const a3_Path *path, a3real3p position_out, const a3real distance);
+
+
+//-----------------------------------------------------------------------------
+
+// initialize follower
+a3i32 a3pathFollowerInit(a3_PathFollower *follower_out, a3_DemoSceneObject *sceneObject, const a3real distance, const a3real speed);
+
+// advance followers by time step and write scene object positions
+//	looping paths wrap distance, open paths clamp to ends
+a3i32 a3pathFollowerUpdate(const a3_Path *path, a3_PathFollower *followers, const a3ui32 followerCount, const a3real dt);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#include "_inl/a3_PathAnimation.inl"
+
+
+#endif	// !__ANIMAL3D_PATHANIMATION_H
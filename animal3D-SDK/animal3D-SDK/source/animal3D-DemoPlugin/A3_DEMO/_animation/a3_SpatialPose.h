@@ -28,6 +28,7 @@ Description of a spatial pose with rotation, translation and scale.
 
 // A3 math library
 #include "animal3D-A3DM/animal3D-A3DM.h"
+#include "animal3D-A3DM/a3math/a3simd.h"
 
 
 //-----------------------------------------------------------------------------
@@ -139,7 +139,7 @@ void a3starter_render(a3_DemoState const* demoState, a3_DemoMode0_Starter const*
 	const a3_Framebuffer* currentReadFBO, * currentDisplayFBO;
 
 	// indices
-	a3ui32 i, j;
+	a3ui32 i, j, k;
 
 	// RGB
 	const a3vec4 rgba4[] = {
@@ -361,10 +361,26 @@ void a3starter_render(a3_DemoState const* demoState, a3_DemoMode0_Starter const*
 				currentDrawable = drawable[currentSceneObject - demoMode->obj_skybox];
 				a3textureActivate(texture_dm[j], a3tex_unit00);
 				a3real4x4Product(modelViewProjectionMat.m, viewProjectionMat.m, currentSceneObject->modelMat.m);
+
+				// teapot: blended targets while morphing, otherwise coarsest 
+				//	level that stays within a pixel of full detail
+				if (currentSceneObject == demoMode->obj_teapot && demoState->morphTeapot && demoState->morph_teapot->targetCount)
+					currentDrawable = demoState->draw_teapot_morph;
+				else if (currentSceneObject == demoMode->obj_teapot)
+				{
+					k = a3demo_selectGeometryLOD(demoState->lod_teapot, a3demo_projectGeometryLODScale(modelViewProjectionMat.mm,
+						demoState->frameWidth, demoState->frameHeight), a3demoGeometryLOD_pixelError);
+					currentDrawable = k ? demoState->draw_teapot_lod + k - 1 : currentDrawable;
+				}
 				a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProgram->uMVP, 1, modelViewProjectionMat.mm);
 				a3shaderUniformSendFloat(a3unif_vec4, currentDemoProgram->uColor, 1, rgba4[i].v);
 				a3shaderUniformSendInt(a3unif_single, currentDemoProgram->uIndex, 1, &j);
-				a3vertexDrawableActivateAndRender(currentDrawable);
+
+				// full-detail teapot: only meshlets that survived culling
+				if (currentDrawable == demoState->draw_teapot && demoState->cullMeshlets && demoState->meshlet_teapot->meshletCount)
+					a3demo_renderGeometryMeshlets(demoState->meshlet_teapot, currentDrawable, demoState->meshletCull_teapot->rangeCount);
+				else
+					a3vertexDrawableActivateAndRender(currentDrawable);
 			}
 			break;
 		}
@@ -374,6 +390,18 @@ void a3starter_render(a3_DemoState const* demoState, a3_DemoMode0_Starter const*
 	}
 
 
+	// animated sprites: one instanced draw for the whole batch
+	if (demoState->displaySprites)
+	{
+		currentDemoProgram = demoState->prog_drawSprite_instanced;
+		a3shaderProgramActivate(currentDemoProgram->program);
+		a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProgram->uMV, 1, activeCameraObject->modelMatInv.mm);
+		a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProgram->uP, 1, activeCamera->projectionMat.mm);
+		a3textureActivate(demoState->tex_testsprite, a3tex_unit00);
+		a3demo_renderSpriteBatch(demoState->spriteBatch, demoState->draw_unit_plane_z);
+	}
+
+
 	// stop using stencil
 	if (demoState->stencilTest)
 		glDisable(GL_STENCIL_TEST);
@@ -541,6 +569,8 @@ void a3starter_render(a3_DemoState const* demoState, a3_DemoMode0_Starter const*
 					// calculate per-object uniforms
 					i = (j * 2 + 23) % hueCount;
 					currentDrawable = drawable[currentSceneObject - demoMode->obj_skybox];
+					if (currentSceneObject == demoMode->obj_teapot && demoState->morphTeapot && demoState->morph_teapot->targetCount)
+						currentDrawable = demoState->draw_teapot_morph;
 					a3real4x4Product(modelViewMat.m, activeCameraObject->modelMatInv.m, currentSceneObject->modelMat.m);
 					a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProgram->uMV, 1, modelViewMat.mm);
 					a3demo_quickInvertTranspose_internal(modelViewMat.m);
@@ -57,8 +57,9 @@ void a3starter_update(a3_DemoState* demoState, a3_DemoMode0_Starter* demoMode, a
 	a3_DemoProjector const* activeCamera = demoMode->projector + demoMode->activeCamera;
 	a3_DemoSceneObject const* activeCameraObject = activeCamera->sceneObject;
 
-	// temp scale mat
+	// temp scale mat, reused for teapot model-view-projection
 	a3mat4 scaleMat = a3mat4_identity;
+	a3vec4 viewPosition;
 
 	a3demo_update_objects(demoState, dt,
 		demoMode->object_scene, starterMaxCount_sceneObject, 0, 0);
@@ -76,7 +77,17 @@ void a3starter_update(a3_DemoState* demoState, a3_DemoMode0_Starter* demoMode, a
 	// update skybox
 	a3demo_update_bindSkybox(demoMode->obj_camera_main, demoMode->obj_skybox);
 
+	// cull teapot meshlets for this frame's camera, viewer moved into 
+	//	teapot's space; render draws the visible ranges
+	if (demoState->cullMeshlets)
+	{
+		a3real4x4Product(scaleMat.m, activeCamera->viewProjectionMat.m, demoMode->obj_teapot->modelMat.m);
+		a3real4Real4x4Product(viewPosition.v, demoMode->obj_teapot->modelMatInv.m, activeCameraObject->modelMat.v3.v);
+		a3demo_cullGeometryMeshlets(demoState->meshlet_teapot, scaleMat.mm, viewPosition.v, demoState->meshletCull_teapot);
+	}
+
 	// update matrix stack data
+	//	(a3demo_updateModelMatrixStackArray does the same for a batch)
 	for (i = 0; i < starterMaxCount_sceneObject; ++i)
 	{
 		a3demo_updateModelMatrixStack(matrixStack + i,
@@ -35,13 +35,19 @@
 
 #include "animal3D/animal3D.h"
 #include "animal3D-A3DG/animal3D-A3DG.h"
+#include "animal3D-A3DM/a3math/a3streamstats.h"
 
 
 //-----------------------------------------------------------------------------
 // other demo includes
 
+#include "_a3_demo_utilities/a3_DemoGeometryLOD.h"
+#include "_a3_demo_utilities/a3_DemoMeshlet.h"
+#include "_a3_demo_utilities/a3_DemoMorphTarget.h"
 #include "_a3_demo_utilities/a3_DemoSceneObject.h"
 #include "_a3_demo_utilities/a3_DemoShaderProgram.h"
+#include "_a3_demo_utilities/a3_DemoSkinWeights.h"
+#include "_a3_demo_utilities/a3_DemoSpriteBatch.h"
 
 #include "a3_DemoMode0_Starter.h"
 
@@ -90,7 +96,7 @@ enum a3_DemoState_ObjectMaxCount
 {
 	demoStateMaxCount_timer = 1,
 
-	demoStateMaxCount_drawDataBuffer = 1,
+	demoStateMaxCount_drawDataBuffer = 2,
 	demoStateMaxCount_vertexArray = 8,
 	demoStateMaxCount_drawable = 16,
 
@@ -99,6 +105,9 @@ enum a3_DemoState_ObjectMaxCount
 	demoStateMaxCount_texture = 8,
 
 	demoStateMaxCount_framebuffer = 2,
+
+	demoStateMaxCount_spriteClip = 8,
+	demoStateMaxCount_sprite = 100000,
 };
 
 	
@@ -132,6 +141,9 @@ struct a3_DemoState
 	// asset streaming between loads enabled (careful!)
 	a3boolean streaming;
 
+	// vertex attributes packed into smaller types on load
+	a3boolean packing;
+
 	// window and full-frame dimensions
 	a3ui32 windowWidth, windowHeight;
 	a3real windowWidthInv, windowHeightInv, windowAspect;
@@ -160,6 +172,20 @@ struct a3_DemoState
 	a3f64 t_timer, dt_timer, dt_timer_tot;
 	a3i64 n_timer;
 
+	// frame time distribution since tracking started (p50, p95, p99)
+	a3_StreamStats dt_timer_stats[1];
+	a3_StreamQuantile dt_timer_quantile[3];
+
+	// heap calls made through demo allocators during last frame, 
+	//	and number of frames that made any; no demo mode runs hierarchy 
+	//	states per frame, so pose group blocks are not part of this
+	a3i64 n_heap_frame, n_heap_frames;
+
+	// animated sprites: atlas cells, clips and batch drawn in one call
+	a3_TextureAtlas atlas_testsprite[1];
+	a3_DemoSpriteClip spriteClip[demoStateMaxCount_spriteClip];
+	a3_DemoSpriteBatch spriteBatch[1];
+
 
 	//-------------------------------------------------------------------------
 	// scene variables and objects
@@ -175,9 +201,12 @@ struct a3_DemoState
 	a3boolean displayGrid, displaySkybox, displayHiddenVolumes;
 	a3boolean displayWorldAxes, displayObjectAxes;
 	a3boolean displayTangentBases, displayWireframe;
+	a3boolean displaySprites;
 	a3boolean updateAnimation;
 	a3boolean stencilTest;
 	a3boolean skipIntermediatePasses;
+	a3boolean cullMeshlets;
+	a3boolean morphTeapot;
 
 
 	//-------------------------------------------------------------------------
@@ -202,7 +231,8 @@ struct a3_DemoState
 		a3_VertexBuffer drawDataBuffer[demoStateMaxCount_drawDataBuffer];
 		struct {
 			a3_VertexBuffer
-				vbo_staticSceneObjectDrawBuffer[1];			// buffer to hold all data for static scene objects (e.g. grid)
+				vbo_staticSceneObjectDrawBuffer[1],			// buffer to hold all data for static scene objects (e.g. grid)
+				vbo_teapot_morph[1];						// buffer rewritten with blended morphing teapot
 		};
 	};
 
@@ -214,6 +244,8 @@ struct a3_DemoState
 			//	vao_tangentbasis_texcoord_morph5[1],		// VAO for vertex format with partial tangent bases for 5-target morphing model, with texcoords
 			//	vao_tangentbasis_texcoord_skin[1],			// VAO for vertex format with complete tangent basis, with texcoords and skin weights
 				vao_tangentbasis_texcoord[1];				// VAO for vertex format with complete tangent basis, with texcoords
+			a3_VertexArrayDescriptor
+				vao_teapot_morph[1];						// VAO for morphing teapot's own buffer (complete tangent basis, texcoords)
 			a3_VertexArrayDescriptor
 				vao_position_color[1],						// VAO for vertex format with position and color
 				vao_position[1];							// VAO for vertex format with only position
@@ -239,11 +271,30 @@ struct a3_DemoState
 				draw_unit_plane_z[1];						// unit plane (width = height = 1) with Z normal
 			a3_VertexDrawable
 			//	draw_character_skin[1],						// can't not have a skinnable character
-			//	draw_teapot_morph[1],						// can't not have a morphing Utah teapot
-				draw_teapot[1];								// can't not have a Utah teapot
+				draw_teapot_morph[1],						// can't not have a morphing Utah teapot
+				draw_teapot[1],								// can't not have a Utah teapot
+				draw_teapot_lod[a3demoGeometryLOD_max - 1];	// simplified teapots sharing its vertices
 		};
 	};
 
+	// teapot level of detail table (level 0 is draw_teapot)
+	a3_DemoGeometryLOD lod_teapot[1];
+
+	// teapot full-detail meshlets and last cull result
+	a3_DemoMeshletSet meshlet_teapot[1];
+	a3_DemoMeshletCullStats meshletCull_teapot[1];
+
+	// teapot morph targets, weights and time they are animated by, and 
+	//	last blend
+	a3_DemoMorphSet morph_teapot[1];
+	a3f32 morphWeight_teapot[a3demoMorph_targetMax];
+	a3f64 morphTime_teapot;
+	a3_DemoMorphBlendStats morphBlend_teapot[1];
+
+	// egnaro skin weights, four per vertex in position order; no rig is 
+	//	loaded yet, so influences are numbered in file order
+	a3_DemoSkinWeights skin_egnaro[1];
+
 
 	// shader programs and uniforms
 	union {
@@ -264,6 +315,8 @@ struct a3_DemoState
 			//	prog_drawPhong[1],							// draw Phong shading model
 			//	prog_drawLambert[1],						// draw Lambert shading model
 				prog_drawTexture[1];						// draw texture
+			a3_DemoStateShaderProgram
+				prog_drawSprite_instanced[1];				// draw sprite batch with instancing
 			//a3_DemoStateShaderProgram
 			//	prog_drawPhong_skin_instanced[1],			// draw skinned model with instancing
 			//	prog_drawPhong_morph5_instanced[1],			// draw 5-target morphing model with instancing
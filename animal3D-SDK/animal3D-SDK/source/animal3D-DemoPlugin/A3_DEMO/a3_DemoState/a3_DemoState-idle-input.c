@@ -165,6 +165,9 @@ void a3demo_input_keyCharPress(a3_DemoState* demoState, a3i32 const asciiKey)
 		// toggle wireframe overlay
 		a3demoCtrlCaseToggle(demoState->displayWireframe, 'F');
 
+		// toggle sprite batch
+		a3demoCtrlCaseToggle(demoState->displaySprites, 'p');
+
 		// update animation
 		a3demoCtrlCaseToggle(demoState->updateAnimation, 'm');
 
@@ -173,6 +176,12 @@ void a3demo_input_keyCharPress(a3_DemoState* demoState, a3i32 const asciiKey)
 
 		// toggle stencil test
 		a3demoCtrlCaseToggle(demoState->skipIntermediatePasses, 'I');
+
+		// toggle meshlet culling
+		a3demoCtrlCaseToggle(demoState->cullMeshlets, 'u');
+
+		// toggle morphing teapot
+		a3demoCtrlCaseToggle(demoState->morphTeapot, 'M');
 	}
 
 
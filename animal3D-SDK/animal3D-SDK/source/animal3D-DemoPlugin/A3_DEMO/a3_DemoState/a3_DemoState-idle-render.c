@@ -104,13 +104,20 @@ void a3demo_render_controls_gen(a3_DemoState const* demoState,
 	a3textDraw(text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
 		"WORLD AXES (toggle 'x') %s | OBJECT AXES ('z') %s", boolText[demoState->displayWorldAxes], boolText[demoState->displayObjectAxes]);
 	a3textDraw(text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
-		"TANGENT BASES ('B') %s | WIREFRAME ('F') %s", boolText[demoState->displayTangentBases], boolText[demoState->displayWireframe]);
+		"TANGENT BASES ('B') %s | WIREFRAME ('F') %s | SPRITES ('p') %s", boolText[demoState->displayTangentBases], boolText[demoState->displayWireframe], boolText[demoState->displaySprites]);
 	a3textDraw(text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
 		"ANIMATION (toggle 'm') %s", boolText[demoState->updateAnimation]);
 	a3textDraw(text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
 		"STENCIL TEST (toggle 'i') %s", boolText[demoState->stencilTest]);
 	a3textDraw(text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
 		"SKIP INTERMEDIATE PASSES (toggle 'I') %s", boolText[demoState->skipIntermediatePasses]);
+	a3textDraw(text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"MESHLET CULLING (toggle 'u') %s: teapot %u of %u triangles", boolText[demoState->cullMeshlets],
+		demoState->meshletCull_teapot->triangleCount, demoState->meshletCull_teapot->triangleTotal);
+	a3textDraw(text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"MORPH TARGETS (toggle 'M') %s: teapot %u of %u targets, %u deltas in %.3f ms", boolText[demoState->morphTeapot],
+		demoState->morphBlend_teapot->targetCount, demoState->morph_teapot->targetCount,
+		demoState->morphBlend_teapot->deltaCount, demoState->morphBlend_teapot->time * 1000.0);
 
 	// global controls
 	textOffset = -0.8f;
@@ -152,8 +159,19 @@ void a3demo_render_data(const a3_DemoState* demoState,
 		"fps_average = %07.4lf F/s", (a3f64)demoState->n_timer / (demoState->dt_timer_tot));//(a3f64)demoState->n_timer / demoState->timer_display->totalTime);//(a3f64)demoState->timer_display->ticks / demoState->timer_display->totalTime);
 	a3textDraw(text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
 		"dt_render = %07.4lf ms", (demoState->dt_timer) * 1000.0);//demoState->timer_display->previousTick * 1000.0);
+	a3textDraw(text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"dt p50/p95/p99 = %07.4lf / %07.4lf / %07.4lf ms",
+		a3streamQuantileGet(demoState->dt_timer_quantile + 0) * 1000.0,
+		a3streamQuantileGet(demoState->dt_timer_quantile + 1) * 1000.0,
+		a3streamQuantileGet(demoState->dt_timer_quantile + 2) * 1000.0);
+	a3textDraw(text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"dt min/max/sd = %07.4lf / %07.4lf / %07.4lf ms",
+		demoState->dt_timer_stats->min * 1000.0, demoState->dt_timer_stats->max * 1000.0,
+		a3streamStatsStandardDeviation(demoState->dt_timer_stats, 1) * 1000.0);
 	a3textDraw(text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
 		"t_render = %07.4lf s | n_render = %lu", demoState->timer_display->totalTime, demoState->n_timer);//demoState->timer_display->totalTime, demoState->timer_display->ticks);
+	a3textDraw(text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"heap_frame = %lld | n_heap_frames = %lld (demo allocators only)", demoState->n_heap_frame, demoState->n_heap_frames);
 
 	// global controls
 	textOffset = -0.8f;
@@ -79,10 +79,15 @@ void a3demo_update_objects(a3_DemoState* demoState, a3f64 const dt,
 			a3demo_applyScale_internal(sceneObjectBase, scaleMat.m);
 		}
 	else
-		for (i = 0; i < count; ++i, ++sceneObjectBase)
-		{
-			a3demo_updateSceneObject(sceneObjectBase, useZYX);
-		}
+	{
+		a3_DemoSceneObject* sceneObject = sceneObjectBase;
+		for (i = 0; i < count; ++i, ++sceneObject)
+			a3demo_updateSceneObjectModelMat(sceneObject, useZYX);
+
+		// invert all rigid transforms in one strided pass
+		a3real4x4TransformInverseIgnoreScaleArray(sceneObjectBase->modelMatInv.m, sizeof(a3_DemoSceneObject),
+			sceneObjectBase->modelMat.m, sizeof(a3_DemoSceneObject), count);
+	}
 }
 
 void a3demo_update_defaultAnimation(a3_DemoState* demoState, a3f64 const dt,
@@ -133,8 +138,36 @@ void a3demo_update_pointLight(a3_DemoSceneObject* obj_camera, a3_DemoPointLight*
 
 void a3demo_update(a3_DemoState *demoState, a3f64 const dt)
 {
+	a3ui32 i;
+
 	demoState->demoModeCallbacksPtr->handleUpdate(demoState,
 		demoState->demoModeCallbacksPtr->demoMode, dt);
+
+	// morphing teapot: each target's weight rises and falls in turn, 
+	//	blended straight into its vertex buffer on this thread (one 
+	//	teapot is too small to be worth waking workers)
+	if (demoState->morphTeapot && demoState->morph_teapot->targetCount)
+	{
+		if (demoState->updateAnimation)
+		{
+			// one cycle every four seconds
+			demoState->morphTime_teapot += dt;
+			while (demoState->morphTime_teapot >= 4.0)
+				demoState->morphTime_teapot -= 4.0;
+		}
+		for (i = 0; i < demoState->morph_teapot->targetCount; ++i)
+			demoState->morphWeight_teapot[i] = a3maximum(a3real_zero,
+				a3sindv((a3real)(demoState->morphTime_teapot * 90.0) - (a3real)i * a3real_threesixty / (a3real)demoState->morph_teapot->targetCount));
+		a3demo_uploadMorphTargets(demoState->vbo_teapot_morph, 0, demoState->morph_teapot, demoState->morphWeight_teapot, 1, demoState->morphBlend_teapot);
+	}
+
+	// animate all sprites and send instance data once per frame
+	if (demoState->displaySprites)
+	{
+		if (demoState->updateAnimation)
+			a3demo_updateSpriteBatch(demoState->spriteBatch, (a3real)dt);
+		a3demo_uploadSpriteBatch(demoState->spriteBatch);
+	}
 }
 
 
@@ -76,6 +76,12 @@
 
 #include "../a3_DemoState.h"
 
+#include "../_a3_demo_utilities/a3_DemoModelLoader.h"
+#include "../_a3_demo_utilities/a3_DemoGeometryOptimize.h"
+#include "../_a3_demo_utilities/a3_DemoVertexPacking.h"
+#include "../_a3_demo_utilities/a3_DemoGeometryCache.h"
+#include "../_a3_demo_utilities/a3_DemoProceduralGeometry.h"
+
 #include <stdio.h>
 
 
@@ -144,11 +150,29 @@ inline void a3demo_initDummyDrawable_internal(a3_DemoState *demoState)
 //-----------------------------------------------------------------------------
 // LOADING
 
+// processing reports for one generated shape
+typedef struct a3_TAG_DEMOSTATEPROCESSREPORT {
+	a3_DemoGeometryOptimizeStats optimize[1];
+	a3_DemoVertexPackStats pack[1];
+	a3_DemoVertexPackFlag packFlags;
+	a3boolean processed;
+} a3_DemoStateProcessReport;
+
+// processing for generated shapes (runs on generation worker threads)
+void a3demo_processGeometry_internal(a3_GeometryData *geom, a3_DemoStateProcessReport *report)
+{
+	a3demo_optimizeGeometry(geom, a3demoGeometryOptimize_cacheSize, a3demoGeometryOptimize_overdrawThreshold, report->optimize);
+	if (report->packFlags)
+		a3demo_packGeometry(geom, report->packFlags, report->pack);
+	report->processed = a3true;
+}
+
 // utility to load geometry
 void a3demo_loadGeometry(a3_DemoState *demoState)
 {
 	// tmp descriptor for loaded model
 	typedef struct a3_TAG_DEMOSTATELOADEDMODEL {
+		const a3byte *name;
 		const a3byte *filePath;
 		const a3real *transform;
 		a3_ModelLoaderFlag flag;
@@ -172,9 +196,20 @@ void a3demo_loadGeometry(a3_DemoState *demoState)
 //	a3ui32 j;
 
 
-	// file streaming (if requested)
-	a3_FileStream fileStream[1] = { 0 };
-	const a3byte *const geometryStream = "./data/geom_data_gpro_coursebase.dat";
+	// geometry cache (if streaming): shapes whose source and settings are 
+	//	unchanged are mapped from the cache file and uploaded straight from 
+	//	the mapping; the rest are rebuilt and the file is rewritten
+	a3_DemoGeometryCache geometryCache[1] = { 0 };
+	const a3byte *const geometryCachePath = "./data/geom_cache_gpro_coursebase.a3gc";
+	a3ui64 settingsKey, key;
+
+	// shapes not in cache are generated together on worker threads; 
+	//	identical descriptors share one result owned by the service
+	a3_DemoProceduralService proceduralService[1];
+	a3_DemoProceduralDescriptor proceduralDesc[1];
+	a3_DemoStateProcessReport displayReports[2] = { 0 }, proceduralReports[6] = { 0 };
+	a3ui64 displayKeys[2], proceduralKeys[6];
+	a3boolean displayRebuilt[2] = { 0 }, proceduralRebuilt[6] = { 0 };
 
 	// geometry data
 	a3_GeometryData displayShapesData[2] = { 0 };
@@ -184,75 +219,155 @@ void a3demo_loadGeometry(a3_DemoState *demoState)
 	const a3ui32 proceduralShapesCount = sizeof(proceduralShapesData) / sizeof(a3_GeometryData);
 	const a3ui32 loadedModelsCount = sizeof(loadedModelsData) / sizeof(a3_GeometryData);
 
-	// common index format
-	a3_IndexFormatDescriptor sceneCommonIndexFormat[1] = { 0 };
-	a3ui32 bufferOffset, *const bufferOffsetPtr = &bufferOffset;
+	// shape descriptions; names identify cache entries
+	a3_ProceduralGeometryDescriptor displayShapes[2] = { a3geomShape_none };
+	a3_ProceduralGeometryDescriptor proceduralShapes[6] = { a3geomShape_none };
+	const a3byte *const displayShapeNames[2] = { "axes", "grid" };
+	const a3byte *const proceduralShapeNames[6] = { "plane", "box", "sphere", "cylinder", "capsule", "torus" };
+	const a3_DemoStateLoadedModel loadedShapes[1] = {
+		{ "teapot", A3_DEMO_OBJ"teapot/teapot.obj", downscale20x_y2z_x2y.mm, a3model_calculateVertexTangents },
+	};
 
+	// processing applied to every rebuilt shape, part of every cache key; 
+	//	vertex packing only if enabled
+	const a3_DemoVertexPackFlag packFlags = demoState->packing ? a3demoVertexPack_default : a3demoVertexPack_none;
+	const a3f32 processSettings[3] = {
+		(a3f32)a3demoGeometryOptimize_cacheSize, a3demoGeometryOptimize_overdrawThreshold, (a3f32)packFlags,
+	};
 
-	// procedural scene objects
-	// attempt to load stream if requested
-	if (demoState->streaming && a3fileStreamOpenRead(fileStream, geometryStream))
-	{
-		// read from stream
+	// simplified levels of loaded models as fractions of full detail, 
+	//	part of their cache keys; level tables are cached with them
+	const a3f32 lodSettings[a3demoGeometryLOD_max] = {
+		a3demoGeometryLOD_attribWeight, 0.5f, 0.25f, 0.125f,
+	};
+	a3_DemoGeometryLOD loadedModelsLOD[1] = { 0 };
+
+	// morphing model: base then targets with the same faces and texcoords, 
+	//	so every file gives the same vertices in the same order
+	a3_GeometryData morphModelsData[5] = { 0 };
+	const a3ui32 morphModelsCount = sizeof(morphModelsData) / sizeof(a3_GeometryData);
+	const a3byte *const morphModelPaths[5] = {
+		A3_DEMO_OBJ"teapot/morph/teapot_base.obj",
+		A3_DEMO_OBJ"teapot/morph/teapot_scale.obj",
+		A3_DEMO_OBJ"teapot/morph/teapot_scale_x.obj",
+		A3_DEMO_OBJ"teapot/morph/teapot_scale_y.obj",
+		A3_DEMO_OBJ"teapot/morph/teapot_scale_z.obj",
+	};
 
-		// static display objects
-		for (i = 0; i < displayShapesCount; ++i)
-			a3fileStreamReadObject(fileStream, displayShapesData + i, (a3_FileStreamReadFunc)a3geometryLoadDataBinary);
+	// skin weights exported with a skinned model
+	const a3byte *const skinWeightsPath = A3_DEMO_OBJ"egnaro/egnaro_skin.xml";
 
-		// procedurally-generated objects
-		for (i = 0; i < proceduralShapesCount; ++i)
-			a3fileStreamReadObject(fileStream, proceduralShapesData + i, (a3_FileStreamReadFunc)a3geometryLoadDataBinary);
+	// meshlet limits and growth weight of loaded models, part of their 
+	//	cache keys; triangles are cached in meshlet order
+	const a3f32 meshletSettings[3] = {
+		(a3f32)a3demoMeshlet_vertexMax, (a3f32)a3demoMeshlet_triangleMax, a3demoMeshlet_coneWeight,
+	};
 
-		// loaded model objects
-		for (i = 0; i < loadedModelsCount; ++i)
-			a3fileStreamReadObject(fileStream, loadedModelsData + i, (a3_FileStreamReadFunc)a3geometryLoadDataBinary);
+	// common index format
+	a3_IndexFormatDescriptor sceneCommonIndexFormat[1] = { 0 };
+	a3ui32 bufferOffset, *const bufferOffsetPtr = &bufferOffset;
 
-		// done
-		a3fileStreamClose(fileStream);
-	}
-	// not streaming or stream doesn't exist
-	else if (!demoState->streaming || a3fileStreamOpenWrite(fileStream, geometryStream))
+	// processing reports
+	a3_DemoModelLoadStats loadStats[1];
+	a3_DemoGeometryOptimizeStats optimizeStats[1];
+	a3_DemoVertexPackStats packStats[1];
+	a3_DemoGeometryLODStats lodStats[1];
+	a3_DemoMeshletStats meshletStats[1];
+	a3_DemoMorphStats morphStats[1];
+	a3_DemoSkinWeightsStats skinStats[1];
+	a3_DemoStateProcessReport *report;
+
+
+	// static scene procedural objects
+	//	(axes, grid)
+	a3proceduralCreateDescriptorAxes(displayShapes + 0, a3geomFlag_wireframe, 0.0f, 1);
+	a3proceduralCreateDescriptorPlane(displayShapes + 1, a3geomFlag_wireframe, a3geomAxis_default, 20.0f, 20.0f, 20, 20);
+
+	// other procedurally-generated objects
+	a3proceduralCreateDescriptorPlane(proceduralShapes + 0, a3geomFlag_tangents, a3geomAxis_default, 1.0f, 1.0f, 1, 1);
+	a3proceduralCreateDescriptorBox(proceduralShapes + 1, a3geomFlag_tangents, 1.0f, 1.0f, 1.0f, 1, 1, 1);
+	a3proceduralCreateDescriptorSphere(proceduralShapes + 2, a3geomFlag_tangents, a3geomAxis_default, 1.0f, 32, 24);
+	a3proceduralCreateDescriptorCylinder(proceduralShapes + 3, a3geomFlag_tangents, a3geomAxis_x, 1.0f, 1.0f, 32, 4, 4);
+	a3proceduralCreateDescriptorCapsule(proceduralShapes + 4, a3geomFlag_tangents, a3geomAxis_x, 1.0f, 1.0f, 32, 12, 4);
+	a3proceduralCreateDescriptorTorus(proceduralShapes + 5, a3geomFlag_tangents, a3geomAxis_x, 1.0f, 0.25f, 32, 24);
+
+
+	// every rebuilt shape goes through the optimizer (line shapes such as 
+	//	axes and grid pass through unchanged), then, if packing is enabled, 
+	//	float attributes are packed into smaller types that the vertex 
+	//	fetch converts back to float, so shaders are unaffected; cached 
+	//	shapes are stored after both steps and are ready to upload
+	if (demoState->streaming)
+		a3demo_openGeometryCache(geometryCache, geometryCachePath);
+	settingsKey = a3demo_hashGeometryKey(a3demoGeometryCache_keyStart, processSettings, sizeof(processSettings));
+
+	a3demo_initProceduralService(proceduralService);
+
+	for (i = 0; i < displayShapesCount; ++i)
 	{
-		// create new data
-		a3_ProceduralGeometryDescriptor displayShapes[2] = { a3geomShape_none };
-		a3_ProceduralGeometryDescriptor proceduralShapes[6] = { a3geomShape_none };
-		const a3_DemoStateLoadedModel loadedShapes[1] = {
-			{ A3_DEMO_OBJ"teapot/teapot.obj", downscale20x_y2z_x2y.mm, a3model_calculateVertexTangents },
-		};
+		a3demo_createProceduralDescriptor(proceduralDesc, displayShapes + i);
+		displayKeys[i] = a3demo_hashProceduralDescriptor(settingsKey, proceduralDesc);
+		displayReports[i].packFlags = packFlags;
+		if (!a3demo_fetchGeometryCache(geometryCache, displayShapesData + i, displayShapeNames[i], displayKeys[i], 0, 0))
+			displayRebuilt[i] = a3demo_requestProceduralGeometry(proceduralService, displayShapesData + i, proceduralDesc, displayShapeNames[i], displayReports + i) >= 0;
+	}
 
-		// static scene procedural objects
-		//	(axes, grid)
-		a3proceduralCreateDescriptorAxes(displayShapes + 0, a3geomFlag_wireframe, 0.0f, 1);
-		a3proceduralCreateDescriptorPlane(displayShapes + 1, a3geomFlag_wireframe, a3geomAxis_default, 20.0f, 20.0f, 20, 20);
-		for (i = 0; i < displayShapesCount; ++i)
-		{
-			a3proceduralGenerateGeometryData(displayShapesData + i, displayShapes + i, 0);
-			a3fileStreamWriteObject(fileStream, displayShapesData + i, (a3_FileStreamWriteFunc)a3geometrySaveDataBinary);
-		}
+	for (i = 0; i < proceduralShapesCount; ++i)
+	{
+		a3demo_createProceduralDescriptor(proceduralDesc, proceduralShapes + i);
+		proceduralKeys[i] = a3demo_hashProceduralDescriptor(settingsKey, proceduralDesc);
+		proceduralReports[i].packFlags = packFlags;
+		if (!a3demo_fetchGeometryCache(geometryCache, proceduralShapesData + i, proceduralShapeNames[i], proceduralKeys[i], 0, 0))
+			proceduralRebuilt[i] = a3demo_requestProceduralGeometry(proceduralService, proceduralShapesData + i, proceduralDesc, proceduralShapeNames[i], proceduralReports + i) >= 0;
+	}
 
-		// other procedurally-generated objects
-		a3proceduralCreateDescriptorPlane(proceduralShapes + 0, a3geomFlag_tangents, a3geomAxis_default, 1.0f, 1.0f, 1, 1);
-		a3proceduralCreateDescriptorBox(proceduralShapes + 1, a3geomFlag_tangents, 1.0f, 1.0f, 1.0f, 1, 1, 1);
-		a3proceduralCreateDescriptorSphere(proceduralShapes + 2, a3geomFlag_tangents, a3geomAxis_default, 1.0f, 32, 24);
-		a3proceduralCreateDescriptorCylinder(proceduralShapes + 3, a3geomFlag_tangents, a3geomAxis_x, 1.0f, 1.0f, 32, 4, 4);
-		a3proceduralCreateDescriptorCapsule(proceduralShapes + 4, a3geomFlag_tangents, a3geomAxis_x, 1.0f, 1.0f, 32, 12, 4);
-		a3proceduralCreateDescriptorTorus(proceduralShapes + 5, a3geomFlag_tangents, a3geomAxis_x, 1.0f, 0.25f, 32, 24);
-		for (i = 0; i < proceduralShapesCount; ++i)
+	// generate and process (all hardware threads), then store
+	if (a3demo_runProceduralService(proceduralService, 0, (a3_DemoProceduralProcessFunc)a3demo_processGeometry_internal) > 0)
+		a3demo_printProceduralService(proceduralService);
+	for (i = 0; i < displayShapesCount; ++i)
+		if (displayRebuilt[i])
+			a3demo_storeGeometryCache(geometryCache, displayShapesData + i, displayShapeNames[i], displayKeys[i], 0, 0);
+	for (i = 0, report = proceduralReports; i < proceduralShapesCount; ++i, ++report)
+		if (proceduralRebuilt[i])
 		{
-			a3proceduralGenerateGeometryData(proceduralShapesData + i, proceduralShapes + i, 0);
-			a3fileStreamWriteObject(fileStream, proceduralShapesData + i, (a3_FileStreamWriteFunc)a3geometrySaveDataBinary);
+			if (report->processed)
+			{
+				a3demo_printGeometryOptimizeStats(report->optimize, proceduralShapeNames[i]);
+				if (packFlags)
+					a3demo_printVertexPackStats(report->pack, proceduralShapeNames[i]);
+			}
+			a3demo_storeGeometryCache(geometryCache, proceduralShapesData + i, proceduralShapeNames[i], proceduralKeys[i], 0, 0);
 		}
 
-		// objects loaded from mesh files
-		for (i = 0; i < loadedModelsCount; ++i)
+	// objects loaded from mesh files (parallel loader, all hardware threads); 
+	//	key includes file contents; dense models are ordered into meshlets 
+	//	and get simplified levels (after optimizing, so meshlets start from 
+	//	cache-friendly order, before packing, which needs float attributes)
+	for (i = 0; i < loadedModelsCount; ++i)
+	{
+		key = a3demo_hashGeometryKey(settingsKey, loadedShapes[i].transform, sizeof(a3mat4));
+		key = a3demo_hashGeometryKey(key, &loadedShapes[i].flag, sizeof(a3_ModelLoaderFlag));
+		key = a3demo_hashGeometryKey(key, lodSettings, sizeof(lodSettings));
+		key = a3demo_hashGeometryKey(key, meshletSettings, sizeof(meshletSettings));
+		a3demo_hashGeometrySource(&key, loadedShapes[i].filePath);
+		if (!a3demo_fetchGeometryCache(geometryCache, loadedModelsData + i, loadedShapes[i].name, key, loadedModelsLOD + i, sizeof(a3_DemoGeometryLOD)))
 		{
-			a3modelLoadOBJ(loadedModelsData + i, loadedShapes[i].filePath, loadedShapes[i].flag, loadedShapes[i].transform);
-			a3fileStreamWriteObject(fileStream, loadedModelsData + i, (a3_FileStreamWriteFunc)a3geometrySaveDataBinary);
+			a3demo_loadModelOBJ(loadedModelsData + i, loadedShapes[i].filePath, loadedShapes[i].flag, loadedShapes[i].transform, 0, loadStats);
+			a3demo_printModelLoadStats(loadStats, loadedShapes[i].filePath);
+			a3demo_optimizeGeometry(loadedModelsData + i, a3demoGeometryOptimize_cacheSize, a3demoGeometryOptimize_overdrawThreshold, optimizeStats);
+			a3demo_printGeometryOptimizeStats(optimizeStats, loadedShapes[i].filePath);
+			a3demo_orderGeometryMeshlets(loadedModelsData + i, 0, (a3ui32)meshletSettings[0], (a3ui32)meshletSettings[1], meshletSettings[2]);
+			if (a3demo_generateGeometryLOD(loadedModelsData + i, loadedModelsLOD + i, lodSettings + 1, a3demoGeometryLOD_max - 1, lodSettings[0], lodStats) > 0)
+				a3demo_printGeometryLODStats(lodStats, loadedShapes[i].name);
+			if (packFlags)
+			{
+				a3demo_packGeometry(loadedModelsData + i, packFlags, packStats);
+				a3demo_printVertexPackStats(packStats, loadedShapes[i].name);
+			}
+			a3demo_storeGeometryCache(geometryCache, loadedModelsData + i, loadedShapes[i].name, key, loadedModelsLOD + i, sizeof(a3_DemoGeometryLOD));
 		}
-
-		// done
-		a3fileStreamClose(fileStream);
 	}
+	a3demo_printGeometryCache(geometryCache);
 
 
 	// GPU data upload process: 
@@ -328,15 +443,70 @@ void a3demo_loadGeometry(a3_DemoState *demoState)
 	
 	currentDrawable = demoState->draw_teapot;
 	sharedVertexStorage += a3geometryGenerateDrawable(currentDrawable, loadedModelsData + 0, vao, vbo_ibo, sceneCommonIndexFormat, 0, 0);
+
+	// teapot levels: full detail draws only its own range, the rest are 
+	//	ranges further along the same uploaded indices
+	*demoState->lod_teapot = loadedModelsLOD[0];
+	if (demoState->lod_teapot->levelCount > 1)
+	{
+		bufferOffset = (a3ui32)(a3size)currentDrawable->indexing;
+		currentDrawable->count = demoState->lod_teapot->count[0];
+		for (i = 1; i < demoState->lod_teapot->levelCount; ++i)
+			a3vertexDrawableCreateIndexed(demoState->draw_teapot_lod + i - 1, vao, vbo_ibo, sceneCommonIndexFormat, a3prim_triangles,
+				bufferOffset + demoState->lod_teapot->first[i] * sceneCommonIndexFormat->indexSize, demoState->lod_teapot->count[i]);
+	}
+
+	// teapot meshlets: described from full-detail range of ordered indices 
+	//	(cached or rebuilt), culled and drawn as ranges of its drawable
+	if (a3demo_createGeometryMeshlets(demoState->meshlet_teapot, loadedModelsData + 0, demoState->lod_teapot->levelCount ? demoState->lod_teapot->count[0] : 0,
+		(a3ui32)meshletSettings[0], (a3ui32)meshletSettings[1], sceneCommonIndexFormat, meshletStats) > 0)
+		a3demo_printMeshletStats(meshletStats, loadedShapes[0].name);
+
+	// morphing teapot: loaded as is (reordering or packing would have to 
+	//	match across files), targets only need positions and normals; the 
+	//	base is uploaded alone into its own buffer, vertices first, which 
+	//	is rewritten with blended vertices while morphing
+	for (i = 0; i < morphModelsCount; ++i)
+	{
+		a3demo_loadModelOBJ(morphModelsData + i, morphModelPaths[i], i ? a3model_calculateVertexNormals_loadTexcoords : loadedShapes[0].flag, loadedShapes[0].transform, 0, loadStats);
+		a3demo_printModelLoadStats(loadStats, morphModelPaths[i]);
+	}
+	if (a3demo_createMorphSet(demoState->morph_teapot, morphModelsData + 0, morphModelsData + 1, morphModelsCount - 1, morphStats) > 0)
+	{
+		a3demo_printMorphStats(morphStats, "teapot_morph");
+		vbo_ibo = demoState->vbo_teapot_morph;
+		a3bufferCreateSplit(vbo_ibo, "vbo/ibo:teapot_morph", a3buffer_vertex,
+			a3geometryGetVertexBufferSize(morphModelsData + 0), a3geometryGetIndexBufferSize(morphModelsData + 0), 0, 0);
+		vao = demoState->vao_teapot_morph;
+		a3geometryGenerateVertexArray(vao, "vao:tb+tc:morph", morphModelsData + 0, vbo_ibo, 0);
+		currentDrawable = demoState->draw_teapot_morph;
+		a3geometryGenerateDrawable(currentDrawable, morphModelsData + 0, vao, vbo_ibo, 0, 0, 0);
+	}
+
+	// egnaro skin weights: largest four per vertex, streamed from file
+	if (a3demo_importSkinWeights(demoState->skin_egnaro, skinWeightsPath, 0, 4, a3demoSkinWeight_unorm16, skinStats) > 0)
+		a3demo_printSkinWeightsStats(skinStats, skinWeightsPath);
 	
 
-	// release data when done
+	// write cache if anything was rebuilt, then release mapping and 
+	//	rebuilt data (cached shapes point into mapping, generated shapes 
+	//	are owned by service)
+	a3demo_closeGeometryCache(geometryCache);
 	for (i = 0; i < displayShapesCount; ++i)
-		a3geometryReleaseData(displayShapesData + i);
+		if (displayShapesData[i].data && !a3demo_isGeometryCached(geometryCache, displayShapesData + i)
+			&& !a3demo_isGeometryProcedural(proceduralService, displayShapesData + i))
+			a3geometryReleaseData(displayShapesData + i);
 	for (i = 0; i < proceduralShapesCount; ++i)
-		a3geometryReleaseData(proceduralShapesData + i);
+		if (proceduralShapesData[i].data && !a3demo_isGeometryCached(geometryCache, proceduralShapesData + i)
+			&& !a3demo_isGeometryProcedural(proceduralService, proceduralShapesData + i))
+			a3geometryReleaseData(proceduralShapesData + i);
+	a3demo_releaseProceduralService(proceduralService);
 	for (i = 0; i < loadedModelsCount; ++i)
-		a3geometryReleaseData(loadedModelsData + i);
+		if (loadedModelsData[i].data && !a3demo_isGeometryCached(geometryCache, loadedModelsData + i))
+			a3geometryReleaseData(loadedModelsData + i);
+	for (i = 0; i < morphModelsCount; ++i)
+		if (morphModelsData[i].data)
+			a3geometryReleaseData(morphModelsData + i);
 
 
 	// dummy
@@ -388,7 +558,8 @@ void a3demo_loadShaders(a3_DemoState *demoState)
 				passthru_transform_vs[1],
 				passColor_transform_vs[1],
 				passthru_transform_instanced_vs[1],
-				passColor_transform_instanced_vs[1];
+				passColor_transform_instanced_vs[1],
+				passSprite_transform_instanced_vs[1];
 			// 00-common
 			a3_DemoStateShader
 				passTexcoord_transform_vs[1],
@@ -409,7 +580,8 @@ void a3demo_loadShaders(a3_DemoState *demoState)
 			// base
 			a3_DemoStateShader
 				drawColorUnif_fs[1],
-				drawColorAttrib_fs[1];
+				drawColorAttrib_fs[1],
+				drawSprite_fs[1];
 			// 00-common
 			a3_DemoStateShader
 				drawTexture_fs[1];//,
@@ -428,6 +600,7 @@ void a3demo_loadShaders(a3_DemoState *demoState)
 			{ { { 0 },	"shdr-vs:pass-col-trans",			a3shader_vertex  ,	1,{ A3_DEMO_VS"e/passColor_transform_vs4x.glsl" } } },
 			{ { { 0 },	"shdr-vs:passthru-trans-inst",		a3shader_vertex  ,	1,{ A3_DEMO_VS"e/passthru_transform_instanced_vs4x.glsl" } } },
 			{ { { 0 },	"shdr-vs:pass-col-trans-inst",		a3shader_vertex  ,	1,{ A3_DEMO_VS"e/passColor_transform_instanced_vs4x.glsl" } } },
+			{ { { 0 },	"shdr-vs:pass-sprite-trans-inst",	a3shader_vertex  ,	1,{ A3_DEMO_VS"passSprite_transform_instanced_vs4x.glsl" } } },
 			// 00-common
 			{ { { 0 },	"shdr-vs:pass-tex-trans",			a3shader_vertex  ,	1,{ A3_DEMO_VS"00-common/e/passTexcoord_transform_vs4x.glsl" } } },
 			{ { { 0 },	"shdr-vs:pass-tb-trans",			a3shader_vertex  ,	1,{ A3_DEMO_VS"00-common/e/passTangentBasis_transform_vs4x.glsl" } } },
@@ -447,6 +620,7 @@ void a3demo_loadShaders(a3_DemoState *demoState)
 			// base
 			{ { { 0 },	"shdr-fs:draw-col-unif",			a3shader_fragment,	1,{ A3_DEMO_FS"e/drawColorUnif_fs4x.glsl" } } },
 			{ { { 0 },	"shdr-fs:draw-col-attr",			a3shader_fragment,	1,{ A3_DEMO_FS"e/drawColorAttrib_fs4x.glsl" } } },
+			{ { { 0 },	"shdr-fs:draw-sprite",				a3shader_fragment,	1,{ A3_DEMO_FS"drawSprite_fs4x.glsl" } } },
 			// 00-common
 			{ { { 0 },	"shdr-fs:draw-tex",					a3shader_fragment,	1,{ A3_DEMO_FS"00-common/e/drawTexture_fs4x.glsl" } } },
 		//	{ { { 0 },	"shdr-fs:draw-Lambert",				a3shader_fragment,	1,{ A3_DEMO_FS"00-common/e/drawLambert_fs4x.glsl" } } },
@@ -508,6 +682,11 @@ void a3demo_loadShaders(a3_DemoState *demoState)
 	a3shaderProgramCreate(currentDemoProg->program, "prog:draw-col-attr-inst");
 	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.passColor_transform_instanced_vs->shader);
 	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.drawColorAttrib_fs->shader);
+	// sprite batch program with instancing
+	currentDemoProg = demoState->prog_drawSprite_instanced;
+	a3shaderProgramCreate(currentDemoProg->program, "prog:draw-sprite-inst");
+	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.passSprite_transform_instanced_vs->shader);
+	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.drawSprite_fs->shader);
 
 	// 00-common programs: 
 	// texturing
@@ -691,6 +870,44 @@ void a3demo_loadTextures(a3_DemoState* demoState)
 }
 
 
+// utility to load sprite atlas, clips and batch; textures must be loaded
+void a3demo_loadSprites(a3_DemoState* demoState)
+{
+	// test sprite sheet is 8x8 evenly divided cells; each row is a clip
+	const a3ui32 columns = 8, rows = 8;
+	const a3ui32 spritesPerRow = 400;
+	const a3real spacing = a3real_quarter;
+	a3_DemoSpriteClip* clip;
+	a3vec3 position;
+	a3ui32 i, tint;
+
+	a3textureAtlasSetTexture(demoState->atlas_testsprite, demoState->tex_testsprite);
+	a3textureAtlasAllocateEvenCells(demoState->atlas_testsprite, columns, rows);
+
+	for (i = 0, clip = demoState->spriteClip; i < demoStateMaxCount_spriteClip; ++i, ++clip)
+	{
+		clip->firstCell = (i % rows) * columns;
+		clip->cellCount = columns;
+		clip->cellDuration = 0.08f + 0.02f * (a3f32)i;
+		clip->mode = (i % 2) ? a3demoSpriteClip_pingPong : a3demoSpriteClip_loop;
+	}
+	a3demo_createSpriteBatch(demoState->spriteBatch, demoStateMaxCount_sprite, demoState->atlas_testsprite,
+		demoState->spriteClip, demoStateMaxCount_spriteClip);
+
+	// field of sprites above the ground with random clip, phase and tint
+	a3randomSetSeed(0);
+	for (i = 0; i < demoStateMaxCount_sprite; ++i)
+	{
+		position.x = spacing * ((a3real)(i % spritesPerRow) - (a3real)(spritesPerRow / 2));
+		position.y = spacing * ((a3real)(i / spritesPerRow) - (a3real)(demoStateMaxCount_sprite / spritesPerRow / 2));
+		position.z = a3real_two + a3randomSymmetric();
+		tint = 0xff000000 | (a3ui32)a3randomMaxInt(0x00ffffff);
+		a3demo_addSprite(demoState->spriteBatch, position.v, a3randomSymmetric() * a3real_pi, spacing, spacing,
+			tint, i % demoStateMaxCount_spriteClip, a3random());
+	}
+}
+
+
 // utility to load framebuffers
 void a3demo_loadFramebuffers(a3_DemoState* demoState)
 {
@@ -779,6 +996,7 @@ void a3demo_loadValidate(a3_DemoState* demoState)
 		* const endTex = currentTex + demoStateMaxCount_texture;
 	a3_Framebuffer* currentFBO = demoState->framebuffer,
 		* const endFBO = currentFBO + demoStateMaxCount_framebuffer;
+	a3ui32 i;
 
 	// set pointers to appropriate release callback for different asset types
 	while (currentBuff < endBuff)
@@ -791,6 +1009,8 @@ void a3demo_loadValidate(a3_DemoState* demoState)
 		a3textureHandleUpdateReleaseCallback(currentTex++);
 	while (currentFBO < endFBO)
 		a3framebufferHandleUpdateReleaseCallback(currentFBO++);
+	a3bufferHandleUpdateReleaseCallback(demoState->spriteBatch->instanceBuffer);
+	a3bufferHandleUpdateReleaseCallback(demoState->spriteBatch->cellBuffer);
 
 	// re-link specific object pointers for different asset types
 	currentBuff = demoState->vbo_staticSceneObjectDrawBuffer;
@@ -813,6 +1033,14 @@ void a3demo_loadValidate(a3_DemoState* demoState)
 	a3_refreshDrawable_internal(demoState->draw_unit_torus, currentVAO, currentBuff);
 
 	a3_refreshDrawable_internal(demoState->draw_teapot, currentVAO, currentBuff);
+	for (i = 0; i + 1 < demoState->lod_teapot->levelCount; ++i)
+		a3_refreshDrawable_internal(demoState->draw_teapot_lod + i, currentVAO, currentBuff);
+
+	currentBuff = demoState->vbo_teapot_morph;
+	currentVAO = demoState->vao_teapot_morph;
+	currentVAO->vertexBuffer = currentBuff;
+	if (demoState->morph_teapot->targetCount)
+		a3_refreshDrawable_internal(demoState->draw_teapot_morph, currentVAO, currentBuff);
 
 	a3demo_initDummyDrawable_internal(demoState);
 }
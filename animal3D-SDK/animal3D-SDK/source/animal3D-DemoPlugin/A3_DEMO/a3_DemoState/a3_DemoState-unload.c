@@ -56,6 +56,9 @@ void a3demo_unloadGeometry(a3_DemoState* demoState)
 		a3vertexArrayReleaseDescriptor(currentVAO++);
 	while (currentDraw < endDraw)
 		a3vertexDrawableRelease(currentDraw++);
+	a3demo_releaseGeometryMeshlets(demoState->meshlet_teapot);
+	a3demo_releaseMorphSet(demoState->morph_teapot);
+	a3demo_releaseSkinWeights(demoState->skin_egnaro);
 }
 
 // utility to unload shaders
@@ -80,6 +83,14 @@ void a3demo_unloadTextures(a3_DemoState* demoState)
 }
 
 
+// utility to unload sprite batch and atlas
+void a3demo_unloadSprites(a3_DemoState* demoState)
+{
+	a3demo_releaseSpriteBatch(demoState->spriteBatch);
+	a3textureAtlasRelease(demoState->atlas_testsprite);
+}
+
+
 // utility to unload framebuffers
 void a3demo_unloadFramebuffers(a3_DemoState* demoState)
 {